@@ -762,15 +762,29 @@ def generate_v2_css_bundle(project_dir):
                f"{bundle_path.stat().st_size} bytes)")
 
 
-def build_filesystem(project_dir, config_file, target):
+def stage_filesystem_data(target):
+    """ADR-175: copy data/ to .tmp/fsdata-<target> with the web UI assets
+    gzipped (scripts/gzip_assets.py) and return the staging directory."""
+    sys.path.insert(0, str(config.PROJECT_DIR / "scripts"))
+    from gzip_assets import stage_data_dir, summarize
+
+    staging = config.TEMP_DIR / f"fsdata-{target}"
+    staged = stage_data_dir(config.DATA_DIR, staging)
+    print_info(f"Staged filesystem data: {summarize(staged)}")
+    return staging
+
+
+def build_filesystem(project_dir, config_file, target, gzip_assets=True):
     """Build filesystem using mklittlefs for the given target"""
     tcfg = TARGETS[target]
     print_step(f"Building filesystem [{tcfg['name']}]")
-    # Web UI assets ship as plain readable files: no gzip, no .gz siblings, no
-    # build-time archives (maintainer directive). Cache-busting is handled at
-    # serve time via ETag (ADR-139); the former prepare_gzip_assets step is
-    # removed entirely (it had been disabled under TASK-433 to kill a
-    # double-Content-Encoding bug, and gzip is no longer wanted at all).
+    # ADR-175 (amends ADR-139's no-gzip rule): the image is packed from a
+    # staged copy of data/ in which the large HTML/JS/CSS assets are stored as
+    # <name>.gz only; the firmware negotiates Accept-Encoding per request and
+    # inflates for clients that refuse gzip. The TASK-433 double
+    # Content-Encoding bug cannot recur: the server opens the .gz by its own
+    # name, never through the library's implicit .gz lookup. data/ itself
+    # stays plain and readable; --no-gzip-assets packs it as is.
 
     # Find mklittlefs under the target's tool path
     # e.g. arduino/packages/esp32/tools/mklittlefs/*/mklittlefs(.exe)
@@ -789,7 +803,7 @@ def build_filesystem(project_dir, config_file, target):
 
     print_info(f"Using mklittlefs: {mklittlefs_path}")
 
-    fs_dir = config.DATA_DIR
+    fs_dir = stage_filesystem_data(target) if gzip_assets else config.DATA_DIR
     output_file = config.BUILD_DIR / f"{config.PROJECT_NAME}-{asset_slug(target)}.littlefs.bin"
 
     # Ensure build dir exists
@@ -2013,17 +2027,19 @@ def build_firmware_pio(project_dir, target):
     print_success(f"Firmware build complete [{tcfg['name']}]")
 
 
-def build_filesystem_pio(project_dir, target):
+def build_filesystem_pio(project_dir, target, gzip_assets=True):
     """Build LittleFS filesystem using PlatformIO."""
     tcfg = TARGETS[target]
     env_name = PIO_ENV_MAP[target]
     print_step(f"Building filesystem [{tcfg['name']}] (PlatformIO)")
-    # Web UI assets ship as plain readable files (no gzip); see build_filesystem above.
+    # Web UI assets are staged gzipped by scripts/platformio_gzip_assets.py
+    # (ADR-175, see build_filesystem above); OTGW_FS_PLAIN=1 turns that off.
     _MSYS_KEYS = frozenset({
         "MSYSTEM", "MSYSTEM_PREFIX", "MSYSTEM_CHOST", "MSYSTEM_CARCH",
         "MINGW_PREFIX", "MINGW_CHOST", "MINGW_PACKAGE_PREFIX",
     })
     pio_env = {k: v for k, v in os.environ.items() if k not in _MSYS_KEYS}
+    pio_env["OTGW_FS_PLAIN"] = "0" if gzip_assets else "1"
     # `python -m platformio`, not bare `pio` (see _pio_in_path / build_firmware_pio).
     run_command([sys.executable, "-m", "platformio", "run", "-e", env_name, "-t", "buildfs"], cwd=project_dir, env=pio_env)
     # TASK-337: same fail-fast pattern as build_firmware_pio. The buildfs target
@@ -2358,6 +2374,7 @@ Examples:
   build --target esp32-classic               # S3-in-Classic-socket (PIC) only
   build --firmware                           # Build firmware only
   build --filesystem                         # Build filesystem only
+  build --filesystem --no-gzip-assets       # Filesystem with plain (not .gz) web UI assets
   build                                      # Default: full build, merged bins, distribution zip
   build --no-merged --no-zip                 # Faster dev build: skip merged + zip steps
   build --compress                           # Also produce gzip-compressed merged-full.bin
@@ -2448,6 +2465,13 @@ Examples:
         action="store_false",
         help="Skip per-target distribution zip creation"
     )
+    parser.add_argument(
+        "--no-gzip-assets",
+        dest="gzip_assets",
+        action="store_false",
+        default=True,
+        help="Pack the web UI assets into the filesystem as plain files instead of .gz (ADR-175)"
+    )
     parser.add_argument(
         "--target",
         choices=["esp32", "esp32-classic", "esp32-combo", "all"],
@@ -2594,22 +2618,22 @@ Examples:
                 build_firmware_pio(project_dir, target)
                 collect_pio_artifacts(project_dir, target, want_firmware=True, want_filesystem=False, want_elf=True)
             elif args.filesystem and not args.firmware:
-                build_filesystem_pio(project_dir, target)
+                build_filesystem_pio(project_dir, target, gzip_assets=args.gzip_assets)
                 collect_pio_artifacts(project_dir, target, want_firmware=False, want_filesystem=True, want_elf=False)
             else:
                 build_firmware_pio(project_dir, target)
                 collect_pio_artifacts(project_dir, target, want_firmware=True, want_filesystem=False, want_elf=True)
-                build_filesystem_pio(project_dir, target)
+                build_filesystem_pio(project_dir, target, gzip_assets=args.gzip_assets)
                 collect_pio_artifacts(project_dir, target, want_firmware=False, want_filesystem=True, want_elf=False)
         else:
             # Arduino-CLI build path
             if args.firmware and not args.filesystem:
                 build_firmware(project_dir, config_file, target)
             elif args.filesystem and not args.firmware:
-                build_filesystem(project_dir, config_file, target)
+                build_filesystem(project_dir, config_file, target, gzip_assets=args.gzip_assets)
             else:
                 build_firmware(project_dir, config_file, target)
-                build_filesystem(project_dir, config_file, target)
+                build_filesystem(project_dir, config_file, target, gzip_assets=args.gzip_assets)
 
             consolidate_build_artifacts(project_dir, target)
 
@@ -43,7 +43,7 @@ import config
 # Hot-path files per ADR-004: no String class allowed.
 # Matched as filename-prefix tuples (e.g. 'SAT' matches SATble.ino, SATcontrol.ino, ...).
 HOT_PATH_PREFIXES: Tuple[str, ...] = (
-    'SAT', 'MQTTstuff', 'restAPI', 'OTGW-Core', 'OTDirect',
+    'SAT', 'MQTTstuff', 'restAPI', 'OTGW-Core', 'OTDecode', 'OTDirect',
 )
 
 # String-class regex: declarations of the form "String name;", "String name = ...",
@@ -1990,7 +1990,7 @@ class WorkspaceEvaluator:
 
     def check_ps_summary_master_topic_gate(self):
         """ADR-066 amendment 2026-05-02 (TASK-483 ACs #8-#13):
-        ``publishPSSummaryFieldValue`` in ``OTGW-Core.ino`` must compute
+        ``publishPSSummaryFieldValue`` in ``OTDecode.h`` must compute
         ``validForMaster = is_msgid_valid_for_master_topic_in_ps_summary(...)``
         and gate every ``sendMQTTData(...)`` / ``publishPSSummarySplitBytes(...)``
         call plus every ``OTcurrentSystemState.X = ...`` assignment on it.
@@ -2005,11 +2005,11 @@ class WorkspaceEvaluator:
         """
         print(f"\n{Colors.BOLD}{Colors.OKBLUE}=== PS=1 Summary Master-Topic Gate ==={Colors.ENDC}")
 
-        core_ino = config.FIRMWARE_ROOT / "OTGW-Core.ino"
+        core_ino = config.FIRMWARE_ROOT / "OTDecode.h"
         if not core_ino.exists():
             self.add_result(EvaluationResult(
                 "ADR-066", "PS=1 master-topic gate", "WARN",
-                "OTGW-Core.ino not found"
+                "OTDecode.h not found"
             ))
             return
 
@@ -2018,7 +2018,7 @@ class WorkspaceEvaluator:
         except OSError as e:
             self.add_result(EvaluationResult(
                 "ADR-066", "PS=1 master-topic gate", "FAIL",
-                f"Could not read OTGW-Core.ino: {e}"
+                f"Could not read OTDecode.h: {e}"
             ))
             return
 
@@ -2027,7 +2027,7 @@ class WorkspaceEvaluator:
         if not m:
             self.add_result(EvaluationResult(
                 "ADR-066", "PS=1 master-topic gate", "FAIL",
-                "publishPSSummaryFieldValue function not found in OTGW-Core.ino"
+                "publishPSSummaryFieldValue function not found in OTDecode.h"
             ))
             return
 
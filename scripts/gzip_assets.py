@@ -0,0 +1,101 @@
+"""
+Stage the LittleFS data directory with the large web UI assets gzipped (ADR-175).
+
+The firmware negotiates Accept-Encoding per request (AssetEncoding.h,
+FSexplorer.ino): a browser gets "<name>.gz" as stored with
+Content-Encoding: gzip, a client that refuses gzip gets it inflated on the
+fly. The 1.5 MB filesystem partition cannot hold a plain and a gzipped copy
+of every asset, so a compressible file is staged as "<name>.gz" ONLY.
+
+Not compressed:
+  - anything that is not HTML/JS/CSS/SVG (images, woff2 fonts, PIC hex
+    files, settings, version.hash): already compressed or read by the
+    firmware itself;
+  - FSexplorer.html, the recovery page, served plain by its own handlers;
+  - a file whose .gz would not save at least MIN_SAVING of its size.
+
+Output is deterministic (mtime 0, no file name in the header), so the same
+sources give the same filesystem image.
+
+Used by build.py (build_filesystem, mklittlefs backend) and by
+scripts/platformio_gzip_assets.py (pio buildfs/uploadfs). Standalone:
+    python scripts/gzip_assets.py <data_dir> <staging_dir>
+"""
+
+import gzip
+import shutil
+import sys
+from pathlib import Path
+
+GZIP_SUFFIXES = (".html", ".htm", ".js", ".css", ".svg")
+KEEP_PLAIN = frozenset({"FSexplorer.html"})
+MIN_SAVING = 0.10
+
+
+def gzip_bytes(data):
+    """gzip member with a fixed header: same input, same bytes."""
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+
+def should_compress(rel_path, size):
+    """Policy for one file, by its path relative to the data directory."""
+    name = rel_path.name
+    if name in KEEP_PLAIN or size == 0:
+        return False
+    return rel_path.suffix.lower() in GZIP_SUFFIXES
+
+
+def stage_data_dir(src_dir, dst_dir, compress=True):
+    """Copy src_dir to dst_dir (replacing it), storing compressible assets as
+    <name>.gz only. Returns a list of (rel_path, plain_size, stored_name,
+    stored_size) for every file, in sorted order."""
+    src_dir = Path(src_dir)
+    dst_dir = Path(dst_dir)
+    if not src_dir.is_dir():
+        raise FileNotFoundError(f"data directory not found: {src_dir}")
+    if dst_dir.resolve() == src_dir.resolve():
+        raise ValueError("staging directory must differ from the data directory")
+    if dst_dir.exists():
+        shutil.rmtree(dst_dir)
+    dst_dir.mkdir(parents=True)
+
+    staged = []
+    for src in sorted(p for p in src_dir.rglob("*") if p.is_file()):
+        rel = src.relative_to(src_dir)
+        dst = dst_dir / rel
+        dst.parent.mkdir(parents=True, exist_ok=True)
+        data = src.read_bytes()
+        # A .gz already in the sources wins; do not write a second one.
+        has_own_gz = src.with_name(src.name + ".gz").exists()
+        if compress and not has_own_gz and should_compress(rel, len(data)):
+            packed = gzip_bytes(data)
+            if len(packed) <= len(data) * (1.0 - MIN_SAVING):
+                gz = dst.with_name(dst.name + ".gz")
+                gz.write_bytes(packed)
+                staged.append((rel, len(data), gz.name, len(packed)))
+                continue
+        shutil.copyfile(src, dst)
+        staged.append((rel, len(data), dst.name, len(data)))
+    return staged
+
+
+def summarize(staged):
+    """One line: files compressed and bytes before/after."""
+    packed = [s for s in staged if s[2] != s[0].name]
+    before = sum(s[1] for s in staged)
+    after = sum(s[3] for s in staged)
+    return (f"{len(packed)} of {len(staged)} files gzipped, "
+            f"{before} -> {after} bytes ({(before - after) // 1024} KB saved)")
+
+
+def main(argv):
+    if len(argv) != 3:
+        print(__doc__)
+        return 2
+    staged = stage_data_dir(argv[1], argv[2])
+    print(f"[gzip-assets] {summarize(staged)}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
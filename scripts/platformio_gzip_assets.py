@@ -0,0 +1,30 @@
+"""
+PlatformIO pre-build script: pack the filesystem from a gzip-staged data dir.
+
+For `pio run -t buildfs` / `-t uploadfs` this stages data_dir into
+.pio/fsdata/<env> with the large web UI assets stored as <name>.gz
+(scripts/gzip_assets.py, ADR-175) and points PROJECT_DATA_DIR at the
+staging copy, so mklittlefs packs that instead. Firmware-only builds are
+untouched. Set OTGW_FS_PLAIN=1 to pack the plain files (build.py
+--no-gzip-assets does).
+
+Note: PlatformIO executes extra_scripts via exec(), so __file__ is not available.
+"""
+
+Import("env")  # noqa: F821  (SCons variable injected by PlatformIO)
+import os
+import sys
+
+from SCons.Script import COMMAND_LINE_TARGETS  # noqa: E402
+
+FS_TARGETS = {"buildfs", "uploadfs", "uploadfsota"}
+
+if FS_TARGETS & set(COMMAND_LINE_TARGETS) and os.environ.get("OTGW_FS_PLAIN") != "1":
+    sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "scripts"))  # noqa: F821
+    from gzip_assets import stage_data_dir, summarize
+
+    data_dir = env.subst("$PROJECT_DATA_DIR")  # noqa: F821
+    staging = os.path.join(env.subst("$PROJECT_WORKSPACE_DIR"), "fsdata", env["PIOENV"])  # noqa: F821
+    staged = stage_data_dir(data_dir, staging)
+    env.Replace(PROJECT_DATA_DIR=staging)  # noqa: F821
+    print(f"platformio_gzip_assets: {summarize(staged)} -> {staging}")
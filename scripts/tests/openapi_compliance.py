@@ -34,7 +34,8 @@ ENDPOINTS = [
  "/v2/flash/status", "/v2/pic/flash-status", "/v2/pic/settings",
  "/v2/firmware/files", "/v2/filesystem/files",
  "/v2/otgw/otmonitor", "/v2/discovery", "/v2/otdirect/status",
- "/v2/otdirect/settings", "/v2/otdirect/overrides", "/v2/sat/status",
+ "/v2/otdirect/settings", "/v2/otdirect/overrides", "/v2/otdirect/schedule",
+ "/v2/sat/status",
  "/v2/sat/status?detail=full", "/v2/sat/weather",
 ]
 
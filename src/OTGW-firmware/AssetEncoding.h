@@ -0,0 +1,229 @@
+/*
+***************************************************************************
+**  Program  : AssetEncoding.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Content negotiation for the precompressed web UI assets (ADR-175).
+**  build.py / scripts/gzip_assets.py store the large HTML/JS/CSS files on
+**  LittleFS as "<name>.gz" only (the partition cannot hold both copies);
+**  the serving helpers in FSexplorer.ino pick the variant per request:
+**
+**    .gz stored, client accepts gzip  -> the .gz as is, Content-Encoding: gzip
+**    plain stored                     -> the plain file (an upload of the
+**                                        plain name removes its .gz)
+**    only .gz, client refuses gzip    -> inflated on the fly (ROM tinfl)
+**
+**  Every response for a path that has a .gz carries Vary: Accept-Encoding,
+**  and the two encodings have distinct ETags ("<fsHash>-<path>" and
+**  "<fsHash>-<path>-gz"), so a cache never answers one with the other.
+**
+**  No Arduino dependency: tests/test_asset_encoding.cpp includes this header
+**  directly.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef ASSETENCODING_H
+#define ASSETENCODING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+enum AssetCoding : uint8_t { ASSET_CODING_IDENTITY = 0, ASSET_CODING_GZIP };
+
+// What answers a request, from what LittleFS holds and what the client takes.
+enum AssetVariant : uint8_t {
+  ASSET_SEND_NONE = 0,                    // neither file: 404
+  ASSET_SEND_PLAIN,
+  ASSET_SEND_GZIP,
+  ASSET_SEND_INFLATE                      // only the .gz, client wants identity
+};
+
+inline AssetVariant assetChooseVariant(bool hasPlain, bool hasGz, bool acceptsGzip)
+{
+  if (hasGz && acceptsGzip) return ASSET_SEND_GZIP;
+  if (hasPlain) return ASSET_SEND_PLAIN;
+  if (hasGz) return ASSET_SEND_INFLATE;
+  return ASSET_SEND_NONE;
+}
+
+inline AssetCoding assetVariantCoding(AssetVariant v)
+{
+  return v == ASSET_SEND_GZIP ? ASSET_CODING_GZIP : ASSET_CODING_IDENTITY;
+}
+
+// "<path>.gz" into buf. False if it does not fit.
+inline bool assetGzPath(char *buf, size_t len, const char *path)
+{
+  const int n = snprintf(buf, len, "%s.gz", path);
+  return n > 0 && (size_t)n < len;
+}
+
+inline char assetLower(char c)
+{
+  return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+inline bool assetIsOws(char c)
+{
+  return c == ' ' || c == '\t';
+}
+
+// qvalue = "0" ["." 0*3DIGIT] / "1" ["." 0*3("0")]. True for q > 0; a
+// malformed value counts as 0, so a garbled preference never turns gzip on.
+inline bool assetQPositive(const char *s, size_t len)
+{
+  if (len == 0) return false;
+  if (s[0] == '1') {
+    if (len == 1) return true;
+    if (s[1] != '.' || len > 5) return false;
+    for (size_t i = 2; i < len; i++) if (s[i] != '0') return false;
+    return true;
+  }
+  if (s[0] != '0') return false;
+  if (len == 1) return false;
+  if (s[1] != '.' || len > 5) return false;
+  bool nonzero = false;
+  for (size_t i = 2; i < len; i++) {
+    if (s[i] < '0' || s[i] > '9') return false;
+    if (s[i] != '0') nonzero = true;
+  }
+  return nonzero;
+}
+
+// Accept-Encoding: may gzip be sent? "gzip" or "x-gzip" with q > 0, or "*"
+// with q > 0 when gzip is not listed. nullptr (no header) and "" are false:
+// a client that says nothing gets the identity body, so curl and wget see
+// a readable file without --compressed.
+inline bool assetAcceptsGzip(const char *ae)
+{
+  if (!ae) return false;
+  int gzip = -1, star = -1;               // -1 unlisted, 0 refused, 1 accepted
+  const char *p = ae;
+  while (*p) {
+    while (*p == ',' || assetIsOws(*p)) p++;
+    if (!*p) break;
+    const char *tok = p;
+    while (*p && *p != ',' && *p != ';' && !assetIsOws(*p)) p++;
+    const size_t tokLen = (size_t)(p - tok);
+    bool q = true;
+    // Parameters: only q matters.
+    while (true) {
+      while (assetIsOws(*p)) p++;
+      if (*p != ';') break;
+      p++;
+      while (assetIsOws(*p)) p++;
+      const char *name = p;
+      while (*p && *p != '=' && *p != ',' && *p != ';' && !assetIsOws(*p)) p++;
+      const size_t nameLen = (size_t)(p - name);
+      while (assetIsOws(*p)) p++;
+      if (*p != '=') continue;
+      p++;
+      while (assetIsOws(*p)) p++;
+      const char *val = p;
+      while (*p && *p != ',' && *p != ';' && !assetIsOws(*p)) p++;
+      if (nameLen == 1 && assetLower(name[0]) == 'q') q = assetQPositive(val, (size_t)(p - val));
+    }
+    // Anything else up to the next element is junk; skip it.
+    while (*p && *p != ',') p++;
+
+    auto is = [&](const char *name) {
+      const size_t n = strlen(name);
+      if (n != tokLen) return false;
+      for (size_t i = 0; i < n; i++) if (assetLower(tok[i]) != name[i]) return false;
+      return true;
+    };
+    if (is("gzip") || is("x-gzip")) {
+      if (gzip != 1) gzip = q ? 1 : 0;
+    } else if (is("*")) {
+      star = q ? 1 : 0;
+    }
+  }
+  if (gzip >= 0) return gzip == 1;
+  return star == 1;
+}
+
+// Quoted ETag for one encoding of a file: "<fsHash>-<path>" for the identity
+// body (what serveVersionedAsset() has always sent), "<fsHash>-<path>-gz" for
+// the gzip body. False if it does not fit.
+inline bool assetEtagFormat(char *buf, size_t len, const char *fsHash, const char *path, AssetCoding c)
+{
+  const int n = snprintf(buf, len, c == ASSET_CODING_GZIP ? "\"%s-%s-gz\"" : "\"%s-%s\"", fsHash, path);
+  return n > 0 && (size_t)n < len;
+}
+
+// If-None-Match against our (strong, quoted) etag: "*", or any entry of the
+// list equal to it with or without W/ (the weak comparison RFC 9110 asks
+// for here). A malformed entry ends the scan.
+inline bool assetEtagMatches(const char *inm, const char *etag)
+{
+  if (!inm || !etag) return false;
+  const size_t etagLen = strlen(etag);
+  const char *p = inm;
+  while (true) {
+    while (*p == ',' || assetIsOws(*p)) p++;
+    if (!*p) return false;
+    if (*p == '*') return true;
+    if (p[0] == 'W' && p[1] == '/') p += 2;
+    if (*p != '"') return false;
+    const char *close = strchr(p + 1, '"');
+    if (!close) return false;
+    const size_t len = (size_t)(close - p) + 1;
+    if (len == etagLen && strncmp(p, etag, len) == 0) return true;
+    p = close + 1;
+  }
+}
+
+// RFC 1952 member header: the number of bytes before the deflate data, or 0
+// if p[0..n) does not hold a complete header with method deflate (8).
+#define ASSET_GZ_FHCRC    0x02
+#define ASSET_GZ_FEXTRA   0x04
+#define ASSET_GZ_FNAME    0x08
+#define ASSET_GZ_FCOMMENT 0x10
+
+inline size_t assetGzipHeaderLen(const uint8_t *p, size_t n)
+{
+  if (n < 10 || p[0] != 0x1f || p[1] != 0x8b || p[2] != 8 || (p[3] & 0xe0)) return 0;
+  const uint8_t flg = p[3];
+  size_t i = 10;
+  if (flg & ASSET_GZ_FEXTRA) {
+    if (n < i + 2) return 0;
+    i += 2 + (size_t)(p[i] | (p[i + 1] << 8));
+    if (i > n) return 0;
+  }
+  if (flg & ASSET_GZ_FNAME) {
+    while (i < n && p[i]) i++;
+    if (i++ >= n) return 0;
+  }
+  if (flg & ASSET_GZ_FCOMMENT) {
+    while (i < n && p[i]) i++;
+    if (i++ >= n) return 0;
+  }
+  if (flg & ASSET_GZ_FHCRC) i += 2;
+  return i < n ? i : 0;                   // at least one byte of deflate data
+}
+
+#endif // ASSETENCODING_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
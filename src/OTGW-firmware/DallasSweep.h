@@ -0,0 +1,139 @@
+/*
+***************************************************************************
+**  Program  : DallasSweep.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Scratchpad checks and per-probe read counters for the 1-Wire sensor
+**  task (sensors_ext.ino).
+**
+**  The sensor task runs one sweep per poll interval: a single convert-all
+**  (skip ROM + 0x44) for every probe on the bus, a sleep for the conversion
+**  time, then one scratchpad read per probe. Each read is judged here
+**  instead of through DallasTemperature::getTempC(), which re-reads the
+**  scratchpad, folds every failure into DEVICE_DISCONNECTED_C and cannot
+**  tell a missing probe from a CRC error:
+**
+**    dallasCheckScratchpad()  no presence pulse, all ones (nobody drove the
+**                             bus) or all zeros => missing; bad CRC-8 =>
+**                             CRC error; otherwise good.
+**    dallasScratchpadRaw()    temperature in 1/128 °C, the same fixed point
+**                             (and DS18S20 COUNT_REMAIN extension) as
+**                             DallasTemperature::calculateTemperature().
+**    dallasConversionMs()     conversion time for the resolution in the
+**                             configuration register, so a bus of 9-bit
+**                             probes does not wait the 12-bit 750 ms.
+**    DallasReadStats          good reads, CRC errors, misses and the last
+**                             and worst read time of one probe (REST
+**                             /sensors).
+**
+**  No Arduino dependency: tests/test_dallas_sweep.cpp checks them against
+**  the library formulas and the datasheet CRC example.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef DALLASSWEEP_H
+#define DALLASSWEEP_H
+
+#include <stdint.h>
+
+#define DALLAS_SCRATCHPAD_SIZE  9
+#define DALLAS_FAMILY_DS18S20   0x10
+#define DALLAS_CONVERT_MAX_MS   750
+
+enum DallasReadResult : uint8_t {
+  DALLAS_READ_OK = 0,
+  DALLAS_READ_MISSING,                    // no presence pulse / all ones / all zeros
+  DALLAS_READ_CRC                         // answered, but the CRC-8 does not match
+};
+
+// Dallas/Maxim CRC-8 (x^8 + x^5 + x^4 + 1, LSB first), as OneWire::crc8().
+inline uint8_t dallasCrc8(const uint8_t *p, uint8_t len) {
+  uint8_t crc = 0;
+  while (len--) {
+    uint8_t b = *p++;
+    for (uint8_t i = 0; i < 8; i++) {
+      uint8_t mix = (crc ^ b) & 0x01;
+      crc >>= 1;
+      if (mix) crc ^= 0x8C;
+      b >>= 1;
+    }
+  }
+  return crc;
+}
+
+inline DallasReadResult dallasCheckScratchpad(bool presence,
+                                              const uint8_t sp[DALLAS_SCRATCHPAD_SIZE]) {
+  if (!presence) return DALLAS_READ_MISSING;
+  uint8_t all = 0xFF, any = 0;
+  for (uint8_t i = 0; i < DALLAS_SCRATCHPAD_SIZE; i++) { all &= sp[i]; any |= sp[i]; }
+  if (all == 0xFF || any == 0) return DALLAS_READ_MISSING;
+  if (dallasCrc8(sp, DALLAS_SCRATCHPAD_SIZE - 1) != sp[DALLAS_SCRATCHPAD_SIZE - 1]) {
+    return DALLAS_READ_CRC;
+  }
+  return DALLAS_READ_OK;
+}
+
+// Temperature of a good scratchpad in 1/128 °C. family is ROM byte 0.
+inline int32_t dallasScratchpadRaw(uint8_t family, const uint8_t sp[DALLAS_SCRATCHPAD_SIZE]) {
+  const int32_t neg = (sp[1] & 0x80) ? (int32_t)0xFFF80000 : 0;  // bit 15 is the sign
+  int32_t raw = ((int32_t)sp[1] << 11) | ((int32_t)sp[0] << 3) | neg;
+  // DS18S20: 0.5 °C register, extended with COUNT_REMAIN (sp[6]) / COUNT_PER_C (sp[7]).
+  if (family == DALLAS_FAMILY_DS18S20 && sp[7] != 0) {
+    raw = (((raw & 0xfff0) << 3) - 32 + (((sp[7] - sp[6]) << 7) / sp[7])) | neg;
+  }
+  return raw;
+}
+
+inline float dallasRawToCelsius(int32_t raw) { return (float)raw * 0.0078125f; }
+
+// Conversion time for the resolution in the configuration register (sp[4]);
+// the DS18S20 has none and always takes the full 750 ms.
+inline uint16_t dallasConversionMs(uint8_t family, const uint8_t sp[DALLAS_SCRATCHPAD_SIZE]) {
+  if (family == DALLAS_FAMILY_DS18S20) return DALLAS_CONVERT_MAX_MS;
+  switch ((sp[4] >> 5) & 0x03) {
+    case 0:  return 94;                   //  9 bit
+    case 1:  return 188;                  // 10 bit
+    case 2:  return 375;                  // 11 bit
+    default: return DALLAS_CONVERT_MAX_MS; // 12 bit
+  }
+}
+
+struct DallasReadStats {
+  uint32_t reads     = 0;                 // good scratchpads
+  uint32_t crcErrors = 0;                 // answered with a bad CRC-8
+  uint32_t missing   = 0;                 // did not answer
+  uint32_t lastUs    = 0;                 // duration of the last scratchpad read
+  uint32_t maxUs     = 0;                 // worst read since boot / bus init
+
+  void record(DallasReadResult r, uint32_t us) {
+    if (r == DALLAS_READ_OK)       reads++;
+    else if (r == DALLAS_READ_CRC) crcErrors++;
+    else                           missing++;
+    lastUs = us;
+    if (us > maxUs) maxUs = us;
+  }
+};
+
+#endif // DALLASSWEEP_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
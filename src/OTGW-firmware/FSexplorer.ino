@@ -39,6 +39,16 @@ const String &contentType(String& filename);
 // forward declaration — used in setupFSexplorer() before its definition below.
 static void sendFSexplorerRedirect();
 
+#include <memory>
+// The S3 mask ROM carries miniz's tinfl: the identity fallback for .gz-only
+// assets (sendInflatedAsset) costs no flash.
+#if __has_include(<rom/miniz.h>)
+#include <rom/miniz.h>
+#define ASSET_HAVE_TINFL 1
+#else
+#define ASSET_HAVE_TINFL 0
+#endif
+
 #define MAX_FILES_IN_LIST   40
 
 const char Helper[] PROGMEM =
@@ -58,6 +68,161 @@ const char Helper[] PROGMEM =
 const char Header[] PROGMEM = "HTTP/1.1 303 OK\r\nLocation:FSexplorer.html\r\nCache-Control: no-cache\r\n";
 
 
+// Precompressed assets (ADR-175): the build stores the large HTML/JS/CSS files
+// as "<name>.gz" only (AssetEncoding.h, scripts/gzip_assets.py). A file counts
+// as present when either the plain name or its .gz exists.
+static bool assetExists(const char* path) {
+  char gzPath[48];
+  return LittleFS.exists(path) || (assetGzPath(gzPath, sizeof(gzPath), path) && LittleFS.exists(gzPath));
+}
+
+// The stored file that answers one request (assetLocate), sent by assetSend.
+struct AssetFiles {
+  char         gzPath[48];
+  AssetVariant variant;
+};
+
+// Forward declarations — prevent the ESP32 auto-prototype conflict (AssetFiles not yet visible at sketch top)
+static bool assetLocate(const char* path, AssetFiles& a);
+static void assetSend(const AssetFiles& a, const char* path, const char* mime);
+static void assetSend(const AssetFiles& a, const char* path, const __FlashStringHelper* mime);
+
+// Which stored file answers this request. Stages Vary: Accept-Encoding when a
+// .gz exists (the response then depends on that header, 304s included).
+static bool assetLocate(const char* path, AssetFiles& a) {
+  const bool hasGz    = assetGzPath(a.gzPath, sizeof(a.gzPath), path) && LittleFS.exists(a.gzPath);
+  const bool hasPlain = LittleFS.exists(path);
+  const bool acceptsGzip = hasGz && hasHeaderCompat(F("Accept-Encoding")) &&
+                           assetAcceptsGzip(headerCompat(F("Accept-Encoding")));
+  a.variant = assetChooseVariant(hasPlain, hasGz, acceptsGzip);
+  if (a.variant == ASSET_SEND_NONE) return false;
+  if (hasGz) webPushHeader(F("Vary"), F("Accept-Encoding"));
+  return true;
+}
+
+#if ASSET_HAVE_TINFL
+// Identity body for a client that refuses gzip while only the .gz is stored
+// (curl/wget without --compressed; every browser takes gzip). One context per
+// response, owned by the chunked filler and freed with it: ~44 KB, in PSRAM
+// when present. The 32 KB dictionary is also tinfl's output buffer (wrapping
+// mode); produced bytes wait there until the response has taken them.
+struct AssetInflate {
+  tinfl_decompressor inflator;
+  uint8_t dict[TINFL_LZ_DICT_SIZE];
+  uint8_t in[512];
+  File    file;
+  size_t  inPos   = 0, inLen   = 0;
+  size_t  dictOfs = 0;                  // where tinfl writes next
+  size_t  pendOfs = 0, pendLen = 0;     // inflated, not yet handed out
+  bool    eof  = false;
+  bool    done = false;
+};
+
+// Forward declaration — prevents the ESP32 auto-prototype conflict (see AssetFiles)
+static size_t assetInflateFill(AssetInflate& z, uint8_t* buf, size_t maxLen);
+
+static size_t assetInflateFill(AssetInflate& z, uint8_t* buf, size_t maxLen) {
+  size_t n = 0;
+  while (n < maxLen) {
+    if (z.pendLen) {
+      const size_t k = (z.pendLen < maxLen - n) ? z.pendLen : maxLen - n;
+      memcpy(buf + n, z.dict + z.pendOfs, k);
+      n += k; z.pendOfs += k; z.pendLen -= k;
+      continue;
+    }
+    if (z.done) break;
+    if (z.inPos == z.inLen && !z.eof) {
+      z.inLen = z.file.read(z.in, sizeof(z.in));
+      z.inPos = 0;
+      if (z.inLen == 0) z.eof = true;
+    }
+    size_t inBytes  = z.inLen - z.inPos;
+    size_t outBytes = TINFL_LZ_DICT_SIZE - z.dictOfs;
+    const tinfl_status st = tinfl_decompress(&z.inflator, z.in + z.inPos, &inBytes,
+                                             z.dict, z.dict + z.dictOfs, &outBytes,
+                                             z.eof ? 0 : TINFL_FLAG_HAS_MORE_INPUT);
+    z.inPos  += inBytes;
+    z.pendOfs = z.dictOfs;
+    z.pendLen = outBytes;
+    z.dictOfs = (z.dictOfs + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+    if (st == TINFL_STATUS_DONE) {
+      z.done = true;
+    } else if (st < 0 || (z.eof && st == TINFL_STATUS_NEEDS_MORE_INPUT)) {
+      // Corrupt or truncated .gz: end the body early rather than loop.
+      DebugTf(PSTR("inflate: bad deflate stream (%d), body truncated\r\n"), (int)st);
+      z.done = true;
+    }
+  }
+  return n;
+}
+
+static void sendInflatedAsset(const char* gzPath, const char* mime) {
+  if (!currentRequest || g_responseSent) return;
+  const bool inPsram = psramFound();
+  // Same transient 503 as the file gate: without PSRAM the context must fit
+  // in one internal block with the gate's own floor to spare.
+  if ((!inPsram && platformMaxFreeBlock() < sizeof(AssetInflate) + 16000) || !webFileGateTryAdmit()) {
+    webPushHeader(F("Retry-After"), F("1"));
+    webSendStatus(503);
+    return;
+  }
+  currentRequest->onDisconnect([]() { webFileGateRelease(); });
+  void* mem = inPsram ? ps_malloc(sizeof(AssetInflate)) : malloc(sizeof(AssetInflate));
+  if (!mem) {
+    webPushHeader(F("Retry-After"), F("1"));
+    webSendStatus(503);
+    return;
+  }
+  std::shared_ptr<AssetInflate> z(new (mem) AssetInflate, [](AssetInflate* p) { p->~AssetInflate(); free(p); });
+  size_t hdrLen = 0;
+  z->file = LittleFS.open(gzPath, "r");
+  if (z->file) {
+    z->inLen = z->file.read(z->in, sizeof(z->in));
+    hdrLen = assetGzipHeaderLen(z->in, z->inLen);
+  }
+  if (!hdrLen) {
+    DebugTf(PSTR("inflate: %s is not a gzip file\r\n"), gzPath);
+    webSend(500, F("text/plain"), F("Corrupt asset"));
+    return;
+  }
+  z->inPos = hdrLen;
+  tinfl_init(&z->inflator);
+  AsyncWebServerResponse* resp = currentRequest->beginChunkedResponse(mime,
+      [z](uint8_t* buf, size_t maxLen, size_t) -> size_t { return assetInflateFill(*z, buf, maxLen); });
+  if (!resp) {
+    webPushHeader(F("Retry-After"), F("1"));
+    webSendStatus(503);
+    return;
+  }
+  webApplyHeaders(resp);
+  currentRequest->send(resp);
+  g_responseSent = true;
+}
+#else
+static void sendInflatedAsset(const char* gzPath, const char* mime) {
+  (void)gzPath; (void)mime;
+  webSend(406, F("text/plain"), F("Only a gzip encoding of this file is stored"));
+}
+#endif
+
+// Send the variant assetLocate() picked. The .gz goes out as stored with
+// Content-Encoding: gzip (webSendFile sets it once; the path passed is the .gz
+// itself, so the library's own plain-name-missing .gz lookup that doubled the
+// header under TASK-433 never runs).
+static void assetSend(const AssetFiles& a, const char* path, const char* mime) {
+  switch (a.variant) {
+    case ASSET_SEND_GZIP:    webSendFile(a.gzPath, mime, /*gzip=*/true);  break;
+    case ASSET_SEND_PLAIN:   webSendFile(path,     mime, /*gzip=*/false); break;
+    case ASSET_SEND_INFLATE: sendInflatedAsset(a.gzPath, mime);          break;
+    default:                 webSend(404, F("text/plain"), F("File not found")); break;
+  }
+}
+static void assetSend(const AssetFiles& a, const char* path, const __FlashStringHelper* mime) {
+  char ctbuf[48];
+  strlcpy_P(ctbuf, (PGM_P)mime, sizeof(ctbuf));
+  assetSend(a, path, ctbuf);
+}
+
 // Serve a static webui asset with ETag-based cache validation (ADR-139, amended
 // TASK-958). Stable URLs, no ?v= query versioning: the ETag is the filesystem
 // hash. Cache-Control: no-cache means the browser MAY store the asset but MUST
@@ -68,10 +233,11 @@ const char Header[] PROGMEM = "HTTP/1.1 303 OK\r\nLocation:FSexplorer.html\r\nCa
 // for up to 60s, so a filesystem OTA (which DOES replace the assets) still showed
 // the old UI on the immediate post-reboot reload (window.location.href='/' does
 // not bypass a fresh cache entry). no-cache costs one tiny 304 revalidation per
-// asset per load, negligible on the trusted LAN. Assets are
-// stored as plain readable files on LittleFS (no build-time gzip, maintainer
-// directive); streamed straight from flash via AsyncFileResponse, never buffered
-// whole on the fragmented S3 heap.
+// asset per load, negligible on the trusted LAN. Assets are streamed straight
+// from flash via AsyncFileResponse, never buffered whole on the fragmented S3
+// heap; ADR-175 stores the large ones gzipped and negotiates Accept-Encoding
+// (assetLocate), which cuts the bytes and the time each serve holds a file-gate
+// slot by 3-5x.
 static void serveVersionedAsset(const char* path, const __FlashStringHelper* mime) {
   // Existence first, before any ETag / max-age is staged and before the 304
   // short-circuit. A missing asset must NOT be cached: the ETag is the filesystem
@@ -80,7 +246,8 @@ static void serveVersionedAsset(const char* path, const __FlashStringHelper* mim
   // survive a manual FSexplorer re-upload of the file (an upload does not bump the
   // hash). So a miss returns a no-cache 404 with no validator, matching the
   // pre-ETag behaviour and refetching every time.
-  if (!LittleFS.exists(path)) {
+  AssetFiles a;
+  if (!assetLocate(path, a)) {
     webPushHeader(F("Cache-Control"), F("no-cache"));
     webSend(404, F("text/plain"), F("File not found"));
     return;
@@ -93,11 +260,12 @@ static void serveVersionedAsset(const char* path, const __FlashStringHelper* mim
     // bare fsHash ETag is identical for both shells. The browser then gets a
     // false 304 when the UI toggle flips and keeps showing the stale shell until
     // a hard reload (TASK-960: "need CTRL-R between UI switches"). Include the
-    // served path so each shell, and each asset, has a distinct validator.
-    char etag[64];
-    snprintf_P(etag, sizeof(etag), PSTR("\"%s-%s\""), fsHash, path);
+    // served path so each shell, and each asset, has a distinct validator; and
+    // the encoding (ADR-175), so a gzip body never validates an identity one.
+    char etag[72];
+    assetEtagFormat(etag, sizeof(etag), fsHash, path, assetVariantCoding(a.variant));
     if (hasHeaderCompat(F("If-None-Match")) &&
-        strcmp(headerCompat(F("If-None-Match")), etag) == 0) {
+        assetEtagMatches(headerCompat(F("If-None-Match")), etag)) {
       webPushHeader(F("Cache-Control"), F("no-cache"));
       webPushHeader(F("ETag"), etag);
       webSendStatus(304);
@@ -106,7 +274,7 @@ static void serveVersionedAsset(const char* path, const __FlashStringHelper* mim
     webPushHeader(F("ETag"), etag);
   }
   webPushHeader(F("Cache-Control"), F("no-cache"));
-  webSendFile(path, mime, /*gzip=*/false);
+  assetSend(a, path, mime);
 }
 
 // TASK-989: fonts are large immutable binaries referenced from ds-tokens.css
@@ -115,14 +283,17 @@ static void serveVersionedAsset(const char* path, const __FlashStringHelper* mim
 // never asks again (not even a 304 probe), removing three parallel connections
 // from every page load. They previously fell through to the onNotFound catch-all
 // (no cache headers -> refetched per load, plus String churn on the async task).
+// woff2 is already Brotli-compressed, so the build stores no .gz for it; the
+// negotiation still applies if one is uploaded.
 static void serveImmutableAsset(const char* path, const __FlashStringHelper* mime) {
-  if (!LittleFS.exists(path)) {
+  AssetFiles a;
+  if (!assetLocate(path, a)) {
     webPushHeader(F("Cache-Control"), F("no-cache"));
     webSend(404, F("text/plain"), F("File not found"));
     return;
   }
   webPushHeader(F("Cache-Control"), F("max-age=31536000, immutable"));
-  webSendFile(path, mime, /*gzip=*/false);
+  assetSend(a, path, mime);
 }
 
 // Serve /FSexplorer.html for the no-index fallback routes (/, /index, /index.html).
@@ -146,7 +317,7 @@ static void sendIndex(AsyncWebServerRequest *request) {
   // the root path serves the redesigned v2 shell; otherwise the classic UI.
   // Both shells stay individually reachable at /index.html and /v2.html so the
   // in-page toggle can always navigate explicitly regardless of the flag.
-  if (settings.ui.bUseV2 && LittleFS.exists("/v2.html")) {
+  if (settings.ui.bUseV2 && assetExists("/v2.html")) {
     serveVersionedAsset("/v2.html", F("text/html; charset=UTF-8"));
   } else {
     serveVersionedAsset("/index.html", F("text/html; charset=UTF-8"));
@@ -170,7 +341,7 @@ static void sendIndex(AsyncWebServerRequest *request) {
 void startWebserver(){
   // Versioned-asset helpers register one handler per asset; the lambda binds the
   // request context before delegating to serveVersionedAsset().
-  if (!LittleFS.exists("/index.html")) {
+  if (!assetExists("/index.html")) {
     server.on("/",           HTTP_GET, sendFSexplorerFallback);
     server.on("/index",      HTTP_GET, sendFSexplorerFallback);
     server.on("/index.html", HTTP_GET, sendFSexplorerFallback);
@@ -186,8 +357,8 @@ void startWebserver(){
   }
   server.serveStatic("/FSexplorer.png", LittleFS, "/FSexplorer.png");
 
-  // ETag + bounded max-age caching for every static webui asset (ADR-139). Plain
-  // readable files served from flash via AsyncFileResponse; no gzip, no ?v= query.
+  // ETag + no-cache revalidation for every static webui asset (ADR-139/163),
+  // served from flash via AsyncFileResponse; gzip-negotiated (ADR-175), no ?v= query.
   server.on("/index.js",         HTTP_GET, [](AsyncWebServerRequest *r){ webBeginRequest(r); serveVersionedAsset("/index.js",         F("application/javascript")); });
   server.on("/graph.js",         HTTP_GET, [](AsyncWebServerRequest *r){ webBeginRequest(r); serveVersionedAsset("/graph.js",         F("application/javascript")); });
   server.on("/sat.js",           HTTP_GET, [](AsyncWebServerRequest *r){ webBeginRequest(r); serveVersionedAsset("/sat.js",           F("application/javascript")); });
@@ -224,6 +395,9 @@ void startWebserver(){
   // dropped and every POST /api/v2/settings returned 400 "Invalid JSON" (the async
   // web UI's settings save was broken). Attach the same capture as this handler's
   // own onBody.
+  // GET /api/v2/events (sseStuff.ino) is a long-lived stream, not a REST call:
+  // its route must be registered before the /api prefix below takes it.
+  startEventStream();
   server.on("/api", HTTP_ANY, processAPI, nullptr,
     [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
       webCaptureBody(request, data, len, index, total);
@@ -533,12 +707,14 @@ bool handleFile(String&& path)
   }
   if (!LittleFS.exists("/FSexplorer.html")) { webSendP(200, PSTR("text/html; charset=UTF-8"), (PGM_P)Helper); return true; }
   if (path.endsWith("/")) path += F("index.html");
-  if (!LittleFS.exists(path)) return false;
-  // contentType() mutates its argument into the mime string, so snapshot the
-  // file path first, then derive the mime from a throwaway copy.
-  String filePath = path;
+  // Same variant choice as the routed assets (ADR-175), so design.html and any
+  // other unrouted file stored as .gz is still found by its plain name.
+  AssetFiles a;
+  if (!assetLocate(path.c_str(), a)) return false;
+  // contentType() mutates its argument into the mime string; derive the mime
+  // from a throwaway copy.
   String mime = path;            // contentType() rewrites this copy in place
-  webSendFile(filePath.c_str(), contentType(mime).c_str(), /*gzip=*/false);
+  assetSend(a, path.c_str(), contentType(mime).c_str());
   return true;
 
 } // handleFile()
@@ -555,6 +731,7 @@ void handleFileUpload(AsyncWebServerRequest *request, const String &filename,
 {
   static File fsUploadFile;
   static bool uploadAuthorized = true;
+  static char staleGz[48];
 
   if (index == 0)
   {
@@ -574,6 +751,11 @@ void handleFileUpload(AsyncWebServerRequest *request, const String &filename,
     if (fullname.startsWith("//")) fullname = fullname.substring(1);
 
     DebugT(F("FileUpload Name: ")); Debugln(fullname);
+    // A plain upload replaces the build's .gz of the same file (ADR-175);
+    // left in place, gzip clients would keep getting the old copy. Removed
+    // once the upload completes, so a failed upload loses neither.
+    staleGz[0] = '\0';
+    if (!fullname.endsWith(".gz") && !assetGzPath(staleGz, sizeof(staleGz), fullname.c_str())) staleGz[0] = '\0';
     fsUploadFile = LittleFS.open(fullname, "w");
   }
 
@@ -584,9 +766,14 @@ void handleFileUpload(AsyncWebServerRequest *request, const String &filename,
 
   if (final)
   {
+    const bool written = (bool)fsUploadFile;
     if (fsUploadFile) fsUploadFile.close();
     if (uploadAuthorized) {
       DebugT(F("FileUpload Size: ")); Debugln((String)(index + len));
+      if (written && staleGz[0] != '\0' && LittleFS.exists(staleGz)) {
+        DebugTf(PSTR("FileUpload: removing stale %s\r\n"), staleGz);
+        LittleFS.remove(staleGz);
+      }
     }
   }
 
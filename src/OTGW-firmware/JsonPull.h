@@ -0,0 +1,358 @@
+/*
+***************************************************************************
+**  Program  : JsonPull.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Buffered pull tokenizer for JSON arriving over a socket (the weather
+**  fetchers in SATweather.ino).
+**
+**  The weather parsers used to pull the HTTP body one byte at a time, each
+**  byte a wstreamGet() round trip (available() poll, millis() deadline,
+**  read()), and only stopped when the 5 s read timeout expired or the
+**  server closed the socket. HTTPClient keeps the connection alive by
+**  default, so every Open-Meteo fetch sat in that timeout after the last
+**  byte had arrived.
+**
+**  JsonPull reads the source in blocks of up to N bytes (one TCP segment,
+**  1460 bytes, in the firmware) into its own buffer and hands out one event
+**  per call to next():
+**
+**    JSON_PULL_OBJECT / _OBJECT_END / _ARRAY / _ARRAY_END   containers
+**    JSON_PULL_KEY                                          member name
+**    JSON_PULL_STRING / _NUMBER / _LITERAL                  values
+**    JSON_PULL_MORE                                         no bytes yet
+**    JSON_PULL_END                                          root value done
+**                                                           (or source gone)
+**
+**  Token text is not copied: text()/length() point into the buffer and stay
+**  valid until the next call. A token cut by a block boundary is moved to
+**  the front of the buffer before the next read, so N only has to exceed
+**  the longest token, not the document. Strings are raw (escapes kept).
+**
+**  path() is the chain of member names from the root, joined with '/'
+**  ("hourly/temperature_2m"); array elements carry the array's path plus
+**  index(). pathIs() compares it against a PROGMEM string, so a caller
+**  selects fields by path and skip()s subtrees it does not need.
+**
+**  The parser is deliberately forgiving, like the byte loop it replaces:
+**  stray bytes are ignored, not reported. It returns JSON_PULL_END as soon
+**  as the root value closes, without waiting for the source to end.
+**
+**  Source is any type with
+**      int read(uint8_t* dst, size_t max);
+**  returning the number of bytes stored (> 0), 0 when nothing is available
+**  yet (next() then returns JSON_PULL_MORE and can simply be called again),
+**  or < 0 when the stream has ended or failed.
+**
+**  No Arduino dependency: tests/bench_weather_json.cpp includes this header
+**  directly and checks it against the legacy byte parsers.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef JSONPULL_H
+#define JSONPULL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef pgm_read_byte
+#define pgm_read_byte(p) (*(const uint8_t *)(p))   // host build: flash is plain memory
+#endif
+
+enum JsonPullEvent : uint8_t {
+  JSON_PULL_MORE = 0,     // source has nothing yet; call next() again later
+  JSON_PULL_END,          // root value closed, or the source ended/failed
+  JSON_PULL_OBJECT,       // '{'
+  JSON_PULL_OBJECT_END,   // '}'
+  JSON_PULL_ARRAY,        // '['
+  JSON_PULL_ARRAY_END,    // ']'
+  JSON_PULL_KEY,          // object member name (text()); path() now ends in it
+  JSON_PULL_STRING,       // string value (text() without quotes, escapes raw)
+  JSON_PULL_NUMBER,       // number value (text(), number())
+  JSON_PULL_LITERAL       // true / false / null (text())
+};
+
+// N: read block and longest token; MaxDepth: nesting tracked for path();
+// PathMax: longest path (< 255). Deeper or longer paths never match pathIs().
+template <class Source, uint16_t N, uint8_t MaxDepth = 8, uint8_t PathMax = 64>
+class JsonPull {
+public:
+  explicit JsonPull(Source& src) : _src(src) { _path[0] = '\0'; }
+
+  JsonPullEvent next() {
+    for (;;) {
+      JsonPullEvent ev = step();
+      if (_skipTo < 0 || ev == JSON_PULL_MORE || ev == JSON_PULL_END) return ev;
+      if (_depth <= _skipTo) _skipTo = -1;   // the skipped container's own end
+    }
+  }
+
+  // After JSON_PULL_OBJECT / JSON_PULL_ARRAY: drop everything up to and
+  // including the matching end event. No-op after any other event.
+  void skip() {
+    if (_depth > 0 && (_last == JSON_PULL_OBJECT || _last == JSON_PULL_ARRAY)) _skipTo = (int16_t)(_depth - 1);
+  }
+
+  const char* text() const      { return _text; }
+  uint16_t    length() const    { return _textLen; }
+  bool        truncated() const { return _truncated; }   // token outgrew N; text() is empty
+  bool        isNull() const    { return _last == JSON_PULL_LITERAL && _textLen > 0 && _text[0] == 'n'; }
+  bool        isTrue() const    { return _last == JSON_PULL_LITERAL && _textLen > 0 && _text[0] == 't'; }
+
+  // Value of the current JSON_PULL_NUMBER token (0 for anything else).
+  float number() const {
+    if (_last != JSON_PULL_NUMBER || _textLen == 0) return 0.0f;
+    char num[24];
+    const uint16_t n = _textLen < sizeof(num) - 1 ? _textLen : (uint16_t)(sizeof(num) - 1);
+    memcpy(num, _text, n);
+    num[n] = '\0';
+    return (float)strtod(num, nullptr);
+  }
+
+  uint8_t  depth() const { return _depth; }
+  uint16_t index() const { return _index; }      // element index when the parent is an array
+  uint32_t bytes() const { return _bytes; }      // bytes taken from the source
+
+  // Member names from the root joined with '/'; "" at the root or when the
+  // path is too deep/long to track.
+  const char* path() const { return _pathLen == kPathInvalid ? "" : _path; }
+
+  // Exact match of path() against a PROGMEM (or RAM) string.
+  bool pathIs(const char* pgmPath) const {
+    if (_pathLen == kPathInvalid) return false;
+    for (uint8_t i = 0; ; i++) {
+      const char c = (char)pgm_read_byte(pgmPath + i);
+      if (i == _pathLen) return c == '\0';
+      if (c != _path[i]) return false;
+    }
+  }
+
+private:
+  static constexpr uint8_t kPathInvalid = 0xFF;
+  static_assert(PathMax < kPathInvalid, "JsonPull: PathMax must be below 255");
+  static_assert(N >= 32, "JsonPull: buffer too small for a number token");
+
+  enum TokKind : uint8_t { TOK_NONE = 0, TOK_STRING, TOK_BARE };
+
+  struct Frame {
+    uint8_t  base;      // _pathLen when the container opened (its own path)
+    bool     array;
+    bool     wantKey;   // object: next string is a member name
+    uint16_t count;     // array: elements seen
+  };
+
+  static bool isBare(uint8_t c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+' || c == '.' || c == 'E';
+  }
+
+  Frame* top() { return (_depth > 0 && _depth <= MaxDepth) ? &_frame[_depth - 1] : nullptr; }
+
+  // Read more bytes behind any partial token. Returns > 0, 0 (nothing yet)
+  // or < 0 (source ended).
+  int fill() {
+    if (_ended) return -1;
+    if (_tok == TOK_NONE) {
+      _pos = _len = 0;
+    } else if (_tokStart > 0) {
+      memmove(_buf, _buf + _tokStart, _len - _tokStart);
+      _len  = (uint16_t)(_len - _tokStart);
+      _scan = (uint16_t)(_scan - _tokStart);
+      _pos  = 0;
+      _tokStart = 0;
+    } else if (_len == N) {
+      // A token longer than the buffer: keep scanning for its end but drop
+      // the bytes; it is reported with truncated() and no text.
+      _truncated = true;
+      _len = _scan = 0;
+    }
+    const int r = _src.read(_buf + _len, (size_t)(N - _len));
+    if (r < 0) { _ended = true; return -1; }
+    _len = (uint16_t)(_len + r);
+    _bytes += (uint32_t)r;
+    return r;
+  }
+
+  // Value about to be reported at the current depth.
+  void valueStart() {
+    Frame* f = top();
+    if (f && f->array) _index = f->count++;
+    else               _index = 0;
+  }
+
+  void setKey(const char* k, uint16_t n) {
+    Frame* f = top();
+    if (!f) { _pathLen = kPathInvalid; return; }
+    f->wantKey = false;
+    if (_skipTo >= 0) return;                 // path is restored when the skip ends
+    if (f->base == kPathInvalid) { _pathLen = kPathInvalid; return; }
+    const uint16_t sep  = f->base ? 1 : 0;
+    if ((uint16_t)f->base + sep + n > PathMax) { _pathLen = kPathInvalid; return; }
+    uint8_t p = f->base;
+    if (sep) _path[p++] = '/';
+    memcpy(&_path[p], k, n);
+    _pathLen = (uint8_t)(p + n);
+    _path[_pathLen] = '\0';
+  }
+
+  JsonPullEvent open(bool array) {
+    _pos++;
+    valueStart();
+    if (_depth < MaxDepth) _frame[_depth] = Frame{ _pathLen, array, !array, 0 };
+    else                   _pathLen = kPathInvalid;
+    _depth++;
+    _textLen = 0;
+    return finish(array ? JSON_PULL_ARRAY : JSON_PULL_OBJECT);
+  }
+
+  JsonPullEvent close(bool array) {
+    _pos++;
+    if (_depth == 0) return JSON_PULL_MORE;   // stray close: ignore
+    Frame* f = top();
+    _pathLen = f ? f->base : kPathInvalid;
+    if (_pathLen != kPathInvalid) _path[_pathLen] = '\0';
+    _depth--;
+    _textLen = 0;
+    if (_depth == 0) _done = true;
+    return finish(array ? JSON_PULL_ARRAY_END : JSON_PULL_OBJECT_END);
+  }
+
+  JsonPullEvent finish(JsonPullEvent ev) { _last = ev; return ev; }
+
+  // Finish the token that ends at _buf[end] (exclusive); for strings the
+  // closing quote is at end and is consumed too.
+  JsonPullEvent emitToken(uint16_t end) {
+    const TokKind kind = _tok;
+    const uint16_t start = (uint16_t)(_tokStart + (kind == TOK_STRING ? 1 : 0));
+    _tok = TOK_NONE;
+    if (_truncated) { _text = (const char*)_buf; _textLen = 0; }
+    else            { _text = (const char*)_buf + start; _textLen = (uint16_t)(end - start); }
+    _pos = (uint16_t)(kind == TOK_STRING ? end + 1 : end);
+
+    if (kind == TOK_STRING) {
+      Frame* f = top();
+      if (f && !f->array && f->wantKey) {
+        setKey(_text, _truncated ? 0 : _textLen);
+        return finish(JSON_PULL_KEY);
+      }
+      valueStart();
+      if (_depth == 0) _done = true;
+      return finish(JSON_PULL_STRING);
+    }
+    valueStart();
+    if (_depth == 0) _done = true;
+    const uint8_t c0 = _textLen ? (uint8_t)_text[0] : '0';
+    return finish((c0 >= 'a' && c0 <= 'z') ? JSON_PULL_LITERAL : JSON_PULL_NUMBER);
+  }
+
+  // Scan the current token for its end; JSON_PULL_MORE when it is cut by
+  // the end of the buffer.
+  JsonPullEvent scanToken() {
+    for (;;) {
+      uint16_t i = _scan;
+      if (_tok == TOK_STRING) {
+        bool esc = _esc;
+        for (; i < _len; i++) {
+          const uint8_t c = _buf[i];
+          if (esc)            esc = false;
+          else if (c == '\\') esc = true;
+          else if (c == '"')  { _esc = false; return emitToken(i); }
+        }
+        _esc = esc;
+      } else {
+        for (; i < _len; i++) if (!isBare(_buf[i])) return emitToken(i);
+      }
+      _scan = i;
+      const int r = fill();
+      if (r == 0) return JSON_PULL_MORE;
+      if (r < 0)  return emitToken(_len);   // stream ended inside the token
+    }
+  }
+
+  JsonPullEvent step() {
+    if (_tok != TOK_NONE) return scanToken();
+    for (;;) {
+      if (_done) return finish(JSON_PULL_END);
+      if (_pos >= _len) {
+        const int r = fill();
+        if (r == 0) return JSON_PULL_MORE;
+        if (r < 0)  { _done = true; return finish(JSON_PULL_END); }
+      }
+      const uint8_t c = _buf[_pos];
+      switch (c) {
+        case '{': return open(false);
+        case '[': return open(true);
+        case '}': { const JsonPullEvent ev = close(false); if (ev != JSON_PULL_MORE) return ev; continue; }
+        case ']': { const JsonPullEvent ev = close(true);  if (ev != JSON_PULL_MORE) return ev; continue; }
+        case ',': {
+          Frame* f = top();
+          if (f && !f->array) f->wantKey = true;
+          _pos++;
+          continue;
+        }
+        case '"':
+          _tok = TOK_STRING;
+          _tokStart = _pos;
+          _scan = (uint16_t)(_pos + 1);
+          _esc = false;
+          _truncated = false;
+          return scanToken();
+        default:
+          if (isBare(c)) {
+            _tok = TOK_BARE;
+            _tokStart = _pos;
+            _scan = (uint16_t)(_pos + 1);
+            _truncated = false;
+            return scanToken();
+          }
+          _pos++;   // whitespace, ':' and stray bytes
+          continue;
+      }
+    }
+  }
+
+  Source&       _src;
+  uint8_t       _buf[N];
+  uint16_t      _pos = 0, _len = 0;          // unread bytes are _buf[_pos.._len)
+  uint16_t      _tokStart = 0, _scan = 0;    // token in progress
+  TokKind       _tok = TOK_NONE;
+  bool          _esc = false;
+  bool          _truncated = false;
+  bool          _ended = false;              // source returned < 0
+  bool          _done = false;               // root value complete
+  JsonPullEvent _last = JSON_PULL_MORE;
+  const char*   _text = "";
+  uint16_t      _textLen = 0;
+  uint16_t      _index = 0;
+  uint32_t      _bytes = 0;
+  int16_t       _skipTo = -1;                // skip() active: depth to return to
+  uint8_t       _depth = 0;
+  Frame         _frame[MaxDepth];
+  uint8_t       _pathLen = 0;
+  char          _path[PathMax + 1];
+};
+
+#endif // JSONPULL_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
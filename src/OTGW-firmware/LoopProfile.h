@@ -0,0 +1,184 @@
+/*
+***************************************************************************
+**  Program  : LoopProfile.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Per-section timing of the loop task: call count, total and worst time,
+**  and a log2 latency histogram for every service loop() and
+**  doBackgroundTasks() call out to.
+**
+**  The loop-stall detector (TASK-866/879) only keeps the longest gap
+**  between two loop() entries and logs gaps over 200 ms. That shows the
+**  budget was blown, not by whom. Each call site is now wrapped:
+**
+**    LOOP_PROFILED(LPS_MQTT, handleMQTT());
+**
+**  which reads the clock before and after the call and adds the difference
+**  to that section. One record is two clock reads, a count-leading-zeros and
+**  four adds; no locks, no heap. Everything runs on the loop task, so the
+**  counters need no atomics; the REST dump copies the table from the AsyncTCP
+**  task and may see one section mid-update, which is fine for a diagnostic.
+**
+**  Histogram bucket b holds durations in [2^b, 2^(b+1)) us; bucket 0 also
+**  holds 0 us and the last bucket everything from 2^(LOOP_PROF_BUCKETS-1) us
+**  (~0.5 s) up. Percentiles are read back as the upper edge of the bucket
+**  that holds them, capped at the section's worst time: at most 2x high.
+**
+**  Sections nest when doBackgroundTasks() is re-entered from a blocking
+**  helper (delayms(), doAutoConfigure()): the outer section then includes
+**  the inner one. LPS_LOOP is the whole loop() body.
+**
+**  The clock is loopProfNowUs(), defined by the includer (micros() in
+**  OTGW-firmware.ino), so tests/test_loop_profile.cpp can drive it.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef LOOPPROFILE_H
+#define LOOPPROFILE_H
+
+#include <stdint.h>
+#include <string.h>
+#if defined(ARDUINO)
+#include <Arduino.h>     // PROGMEM
+#endif
+#ifndef PROGMEM
+#define PROGMEM          // host builds: flash and RAM share one address space
+#endif
+
+#define LOOP_PROF_BUCKETS   20    // 1 us .. >=524 ms
+#define LOOP_PROF_NAME_LEN  16
+
+enum LoopProfSection : uint8_t {
+  LPS_LOOP = 0,          // whole loop() body
+  LPS_SETTINGS,          // flushSettings()
+  LPS_SENSORS,           // pollSensors()
+  LPS_S0,                // sendS0Counters()
+  LPS_TIMERS,            // do15min/5min/60s/3s/1s, minute/hour/day events
+  LPS_DISCOVERY,         // loopMQTTDiscovery() + runTopicCleanupStep()
+  LPS_OUTPUTS,           // evalOutputs() + evalWebhook()
+  LPS_SAT,               // satControlLoop()
+  LPS_SAT_BLE,           // satBLELoop()
+  LPS_WEATHER,           // weatherLoop()
+  LPS_PIC_UPGRADE,       // handlePendingUpgrade() + handlePendingPicHttp()
+  LPS_OLED,              // loopOLED()
+  LPS_NETWORK,           // loopWifi() + loopEthernet()
+  LPS_TELNET,            // handleDebug() + handleOTGWstream()
+  LPS_MQTT,              // handleMQTT()
+  LPS_PIC_SERIAL,        // handlePICSerial()
+  LPS_OTDIRECT,          // handleOTDirectBridgeStream() + loopOTDirect()
+  LPS_WEBSOCKET,         // handleWebSocket() housekeeping
+  LPS_EVENTS,            // handleEventStream()
+  LPS_NTP,               // loopNTP()
+  LPS_OT_DRAIN,          // drainOTFrameQueue()
+  LPS_COUNT
+};
+
+// REST / telnet key per section, in enum order.
+static const char kLoopProfNames[LPS_COUNT][LOOP_PROF_NAME_LEN] PROGMEM = {
+  "loop", "settings", "sensors", "s0", "timers", "discovery", "outputs",
+  "sat", "sat_ble", "weather", "pic_upgrade", "oled", "network", "telnet",
+  "mqtt", "pic_serial", "otdirect", "websocket", "events", "ntp", "ot_drain"
+};
+
+struct LoopProfStat {
+  uint32_t calls   = 0;
+  uint32_t maxUs   = 0;
+  uint64_t totalUs = 0;
+  uint32_t hist[LOOP_PROF_BUCKETS] = {};
+};
+
+struct LoopProfile {
+  LoopProfStat s[LPS_COUNT];
+  uint32_t     sinceMs = 0;       // millis() of boot or the last reset (telnet 'z')
+};
+
+inline uint8_t loopProfBucket(uint32_t us) {
+  if (us < 2) return 0;
+  const uint8_t b = (uint8_t)(31 - __builtin_clz(us));
+  return b < LOOP_PROF_BUCKETS - 1 ? b : LOOP_PROF_BUCKETS - 1;
+}
+
+// Smallest duration that lands in bucket b.
+inline uint32_t loopProfBucketLowUs(uint8_t b) { return b == 0 ? 0 : (1UL << b); }
+
+inline void loopProfRecord(LoopProfStat &st, uint32_t us) {
+  st.calls++;
+  st.totalUs += us;
+  if (us > st.maxUs) st.maxUs = us;
+  st.hist[loopProfBucket(us)]++;
+}
+
+// Upper bound of the pct-th percentile (0..100): the top of the bucket that
+// holds it, capped at the worst time seen. 0 when the section never ran.
+inline uint32_t loopProfPercentileUs(const LoopProfStat &st, uint8_t pct) {
+  if (st.calls == 0) return 0;
+  if (pct > 100) pct = 100;
+  // Rank of the sample, 1-based, rounded up: p50 of 3 calls is the 2nd.
+  const uint64_t rank = ((uint64_t)st.calls * pct + 99) / 100;
+  uint64_t seen = 0;
+  for (uint8_t b = 0; b < LOOP_PROF_BUCKETS; b++) {
+    seen += st.hist[b];
+    if (seen >= rank && seen > 0) {
+      if (b == LOOP_PROF_BUCKETS - 1) return st.maxUs;
+      const uint32_t top = (2UL << b) - 1;
+      return top < st.maxUs ? top : st.maxUs;
+    }
+  }
+  return st.maxUs;
+}
+
+inline uint32_t loopProfAvgUs(const LoopProfStat &st) {
+  return st.calls ? (uint32_t)(st.totalUs / st.calls) : 0;
+}
+
+inline void loopProfReset(LoopProfile &p, uint32_t nowMs) {
+  for (uint8_t i = 0; i < LPS_COUNT; i++) p.s[i] = LoopProfStat();
+  p.sinceMs = nowMs;
+}
+
+inline const char *loopProfSectionName(uint8_t i) {
+  return i < LPS_COUNT ? kLoopProfNames[i] : "";
+}
+
+// Clock in microseconds; wraps after ~71 min, the unsigned subtraction in
+// ~LoopProfScope() is wrap-safe for any section shorter than that.
+uint32_t loopProfNowUs();
+
+class LoopProfScope {
+public:
+  LoopProfScope(LoopProfile &p, LoopProfSection s) : _st(p.s[s]), _t0(loopProfNowUs()) {}
+  ~LoopProfScope() { loopProfRecord(_st, loopProfNowUs() - _t0); }
+  LoopProfScope(const LoopProfScope &) = delete;
+  LoopProfScope &operator=(const LoopProfScope &) = delete;
+private:
+  LoopProfStat  &_st;
+  const uint32_t _t0;
+};
+
+// Time one statement into a section of the global loopProfile.
+#define LOOP_PROFILED(section, stmt) \
+  do { LoopProfScope _loopProfScope(loopProfile, (section)); stmt; } while (0)
+
+#endif // LOOPPROFILE_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
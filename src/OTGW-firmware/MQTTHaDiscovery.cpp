@@ -2170,20 +2170,29 @@ extern void incPublishedTopicCount();   // ADR-062 / TASK-349: called after ever
 extern bool mqttIsConnected();
 
 // ---------------------------------------------------------------------------
-// measureMallocPublish() — TASK-865.7 / ADR-123 publish scaffold.
+// composeAndPublish() — discovery publish scaffold (TASK-865.7 / ADR-123).
 //
 // espMqttClient has no streaming (begin/write/end) publish API; it frames a
-// publish atomically from one buffer. So every discovery payload is composed
-// twice with the dual-mode MqttJsonWriter: MEASURE to learn the exact length,
-// then WRITE into a transient malloc'd heap buffer of that length, which is
-// handed to mqttPublishRaw() (the single publish chokepoint) and freed
-// immediately — espMqttClient copies it into its Outbox at publish() time, so
-// the buffer can go right away.
+// publish atomically from one buffer and copies it into its Outbox at
+// publish() time, so the buffer is free again as soon as mqttPublishRaw()
+// returns. Every discovery payload is therefore composed ONCE, in WRITE mode,
+// straight into sComposeArena, a static scratch buffer owned by this engine.
+// Table entities, climate, SAT and PIC configs all fit: the largest is 871 B
+// with typical settings and 1628 B with the longest, fully JSON-escaped
+// hostname/topic/device strings the settings allow plus the full dev block
+// (tests/bench_ha_discovery_compose.cpp reports the distribution), so a full
+// republish costs no heap.
 //
-// `compose` is invoked twice and MUST be deterministic between the two passes
-// (the MQTTstuff.h MqttJsonWriter guards every WRITE append against the measured
-// capacity, and the byteCount==len assertion below catches any drift). All
-// discovery payloads here are bounded (~900 B worst case), trivial on the S3.
+// Spill path: the arena writer is a spill writer (MqttJsonWriter), so a payload
+// that does not fit — device discovery slots, or anything a future row makes
+// bigger — still composes to the end and leaves its exact length in byteCount.
+// Only then is a transient buffer of that length malloc'd and the compose run
+// a second time into it (the old MEASURE + WRITE cost, paid by the rare large
+// payload only). `compose` must stay deterministic between those two runs; the
+// byteCount==len check catches drift.
+//
+// The arena is not reentrant: discovery runs on the loop task only (drip,
+// JIT, topology cleanup, configSensors()), and no compose lambda publishes.
 // Returns true only when the publish was queued. Always retained (HA configs).
 //
 // Deliberately does NOT call incPublishedTopicCount(): per ADR-062 (gated by
@@ -2193,12 +2202,14 @@ extern bool mqttIsConnected();
 // the count here would defeat that guard, so each caller increments on its own
 // success path right after this returns true.
 // ---------------------------------------------------------------------------
-template <typename ComposeFn>
-static bool measureMallocPublish(const char *topic, ComposeFn &&compose) {
-  MqttJsonWriter measure(MqttJsonWriter::MEASURE);
-  if (!compose(measure)) return false;
-  const size_t len = measure.byteCount;
+static constexpr size_t HA_DISCOVERY_ARENA_SIZE = 2048;
+static char     sComposeArena[HA_DISCOVERY_ARENA_SIZE];
+static size_t   sComposeArenaCap = sizeof(sComposeArena);  // 0 = every payload spills (the old MEASURE + malloc + WRITE; host bench baseline)
+static uint32_t sComposeCount = 0;   // payloads composed since boot
+static uint32_t sComposeSpills = 0;  // ... of which took the malloc'd spill path
 
+template <typename ComposeFn>
+static bool spillPublish(const char *topic, size_t len, ComposeFn &compose) {
   char *buf = static_cast<char *>(malloc(len ? len : 1));
   if (!buf) return false;
 
@@ -2207,6 +2218,23 @@ static bool measureMallocPublish(const char *topic, ComposeFn &&compose) {
   const bool published = composed &&
       mqttPublishRaw(topic, reinterpret_cast<const uint8_t *>(buf), len, /*retain=*/true);
   free(buf);
+  return published;
+}
+
+template <typename ComposeFn>
+static bool composeAndPublish(const char *topic, ComposeFn &&compose) {
+  MqttJsonWriter writer(sComposeArena, sComposeArenaCap, /*spillOnOverflow=*/true);
+  if (!compose(writer)) return false;
+  sComposeCount++;
+
+  bool published;
+  if (writer.ok) {
+    published = mqttPublishRaw(topic, reinterpret_cast<const uint8_t *>(sComposeArena),
+                               writer.byteCount, /*retain=*/true);
+  } else {
+    sComposeSpills++;
+    published = spillPublish(topic, writer.byteCount, compose);
+  }
 
   if (published) feedWatchDog();
   return published;
@@ -2366,11 +2394,26 @@ static void sanitizeHaObjectId(char *s) {
 }
 
 // ---------------------------------------------------------------------------
-// Sensor payload composer
+// Entity object id: "<sourcePrefix><idLabel>[<sourceSuffix>]"
+// The tail of uniq_id after "<nodeId>-", and the component key in a device
+// discovery payload, so both modes name an entity identically.
 // ---------------------------------------------------------------------------
-static bool composeSensorPayload(MqttJsonWriter &w,
-                                 const MqttHaSensorCfg &cfg,
-                                 HaDiscoveryContext &ctx)
+static bool writeEntityObjectId(MqttJsonWriter &w, const HaDiscoveryContext &ctx,
+                                const char *idLabel, bool hasSrc) {
+  if (!w.writeProgmem(haSourcePrefix(ctx.device, ctx))) return false;
+  if (!w.writeRam(idLabel)) return false;
+  if (hasSrc) { if (!w.writeRam(ctx.sourceSuffix)) return false; }
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// Sensor entity fields: uniq_id .. value_template, without the enclosing
+// braces, avty_t, dev and origin. composeSensorPayload() wraps them into a
+// per-entity config, writeDeviceComponent() into a device discovery component.
+// ---------------------------------------------------------------------------
+static bool writeSensorEntityFields(MqttJsonWriter &w,
+                                    const MqttHaSensorCfg &cfg,
+                                    HaDiscoveryContext &ctx)
 {
   char label[48];
   char idLabel[48];
@@ -2382,15 +2425,6 @@ static bool composeSensorPayload(MqttJsonWriter &w,
 
   bool hasSrc = (ctx.sourceSuffix && ctx.sourceSuffix[0] != '\0');
 
-  if (!writeJsonOpen(w)) return false;
-
-  // "avty_t":"<mqttPubTopic>"
-  if (!writeJsonKV(w, kAvtyT, ctx.mqttPubTopic)) return false;
-  if (!writeJsonComma(w)) return false;
-
-  if (!writeDeviceBlock(w, ctx)) return false;
-  if (!writeJsonComma(w)) return false;
-
   // "uniq_id":"<nodeId>-<sourcePrefix><label>[<sourceSuffix>]"
   // ADR-140: source prefix + label; idLabel sanitized for HA object_id restrictions.
   // Uses idLabel (sanitized) so HA-forbidden characters like '/' become '_'.
@@ -2399,9 +2433,7 @@ static bool composeSensorPayload(MqttJsonWriter &w,
   if (!w.writeProgmem(PSTR("\":\""))) return false;
   if (!w.writeRam(ctx.nodeId)) return false;
   if (!w.writeChar('-')) return false;
-  if (!w.writeProgmem(haSourcePrefix(ctx.device, ctx))) return false;
-  if (!w.writeRam(idLabel)) return false;
-  if (hasSrc) { if (!w.writeRam(ctx.sourceSuffix)) return false; }
+  if (!writeEntityObjectId(w, ctx, idLabel, hasSrc)) return false;
   if (!w.writeChar('"')) return false;
   if (!writeJsonComma(w)) return false;
 
@@ -2475,7 +2507,26 @@ static bool composeSensorPayload(MqttJsonWriter &w,
 
   // "value_template":"{{ value }}" (or a per-entity override for JSON/unit conversions)
   if (!writeJsonComma(w)) return false;
-  if (!writeJsonKV_P(w, kValTpl, cfg.valueTemplate ? cfg.valueTemplate : kValTplVal)) return false;
+  return writeJsonKV_P(w, kValTpl, cfg.valueTemplate ? cfg.valueTemplate : kValTplVal);
+}
+
+// ---------------------------------------------------------------------------
+// Sensor payload composer
+// ---------------------------------------------------------------------------
+static bool composeSensorPayload(MqttJsonWriter &w,
+                                 const MqttHaSensorCfg &cfg,
+                                 HaDiscoveryContext &ctx)
+{
+  if (!writeJsonOpen(w)) return false;
+
+  // "avty_t":"<mqttPubTopic>"
+  if (!writeJsonKV(w, kAvtyT, ctx.mqttPubTopic)) return false;
+  if (!writeJsonComma(w)) return false;
+
+  if (!writeDeviceBlock(w, ctx)) return false;
+  if (!writeJsonComma(w)) return false;
+
+  if (!writeSensorEntityFields(w, cfg, ctx)) return false;
 
   // origin block
   if (!writeJsonComma(w)) return false;
@@ -2485,11 +2536,12 @@ static bool composeSensorPayload(MqttJsonWriter &w,
 }
 
 // ---------------------------------------------------------------------------
-// Binary sensor payload composer
+// Binary sensor entity fields: uniq_id .. payload strings (see
+// writeSensorEntityFields for how they are wrapped).
 // ---------------------------------------------------------------------------
-static bool composeBinSensorPayload(MqttJsonWriter &w,
-                                    const MqttHaBinSensorCfg &cfg,
-                                    HaDiscoveryContext &ctx)
+static bool writeBinSensorEntityFields(MqttJsonWriter &w,
+                                       const MqttHaBinSensorCfg &cfg,
+                                       HaDiscoveryContext &ctx)
 {
   char label[48];
   char idLabel[48];
@@ -2499,14 +2551,6 @@ static bool composeBinSensorPayload(MqttJsonWriter &w,
   sanitizeHaObjectId(idLabel);
   strlcpy_P(friendlyName, cfg.friendlyName, sizeof(friendlyName));
 
-  if (!writeJsonOpen(w)) return false;
-
-  if (!writeJsonKV(w, kAvtyT, ctx.mqttPubTopic)) return false;
-  if (!writeJsonComma(w)) return false;
-
-  if (!writeDeviceBlock(w, ctx)) return false;
-  if (!writeJsonComma(w)) return false;
-
   // "uniq_id":"<nodeId>-<sourcePrefix><label>"
   // ADR-140: source prefix replaces per-device suffix.
   // TASK-872 AC#3: uniq_id uses idLabel (sanitized) for HA object_id restrictions,
@@ -2517,8 +2561,7 @@ static bool composeBinSensorPayload(MqttJsonWriter &w,
   if (!w.writeProgmem(PSTR("\":\""))) return false;
   if (!w.writeRam(ctx.nodeId)) return false;
   if (!w.writeChar('-')) return false;
-  if (!w.writeProgmem(haSourcePrefix(ctx.device, ctx))) return false;
-  if (!w.writeRam(idLabel)) return false;
+  if (!writeEntityObjectId(w, ctx, idLabel, /*hasSrc=*/false)) return false;
   if (!w.writeChar('"')) return false;
   if (!writeJsonComma(w)) return false;
 
@@ -2577,6 +2620,25 @@ static bool composeBinSensorPayload(MqttJsonWriter &w,
     default:
       break;
   }
+  return true;
+}
+
+// ---------------------------------------------------------------------------
+// Binary sensor payload composer
+// ---------------------------------------------------------------------------
+static bool composeBinSensorPayload(MqttJsonWriter &w,
+                                    const MqttHaBinSensorCfg &cfg,
+                                    HaDiscoveryContext &ctx)
+{
+  if (!writeJsonOpen(w)) return false;
+
+  if (!writeJsonKV(w, kAvtyT, ctx.mqttPubTopic)) return false;
+  if (!writeJsonComma(w)) return false;
+
+  if (!writeDeviceBlock(w, ctx)) return false;
+  if (!writeJsonComma(w)) return false;
+
+  if (!writeBinSensorEntityFields(w, cfg, ctx)) return false;
 
   if (!writeJsonComma(w)) return false;
   if (!writeOriginBlock(w, ctx)) return false;
@@ -2692,7 +2754,7 @@ bool streamSensorDiscovery(const MqttHaSensorCfg &cfg,
                                  devSeg))
     return false;
 
-  if (!measureMallocPublish(topic, [&](MqttJsonWriter &w) {
+  if (!composeAndPublish(topic, [&](MqttJsonWriter &w) {
         return composeSensorPayload(w, cfg, ctx);
       })) return false;
   incPublishedTopicCount();   // ADR-062 / TASK-349
@@ -2717,7 +2779,7 @@ bool streamBinarySensorDiscovery(const MqttHaBinSensorCfg &cfg,
                                     cfg.label, devSeg))
     return false;
 
-  if (!measureMallocPublish(topic, [&](MqttJsonWriter &w) {
+  if (!composeAndPublish(topic, [&](MqttJsonWriter &w) {
         return composeBinSensorPayload(w, cfg, ctx);
       })) return false;
   incPublishedTopicCount();   // ADR-062 / TASK-349
@@ -2818,7 +2880,7 @@ bool streamDallasSensorDiscovery(const char *sensorAddress,
     return writeJsonClose(w);
   };
 
-  if (!measureMallocPublish(topic, compose)) return false;
+  if (!composeAndPublish(topic, compose)) return false;
   incPublishedTopicCount();   // ADR-062 / TASK-349
   return true;
 }
@@ -3071,7 +3133,7 @@ bool streamClimateDiscovery(uint8_t climateIdx,
     return writeJsonClose(w);
   };
 
-  if (!measureMallocPublish(topic, compose)) return false;
+  if (!composeAndPublish(topic, compose)) return false;
   incPublishedTopicCount();   // ADR-062 / TASK-349
   return true;
 }
@@ -3144,7 +3206,7 @@ bool streamNumberDiscovery(HaDiscoveryContext &ctx)
     return writeJsonClose(w);
   };
 
-  if (!measureMallocPublish(topic, compose)) return false;
+  if (!composeAndPublish(topic, compose)) return false;
   incPublishedTopicCount();   // ADR-062 / TASK-349
   return true;
 }
@@ -3219,7 +3281,7 @@ bool streamOverrideSensorDiscovery(HaDiscoveryContext &ctx,
     return writeJsonClose(w);
   };
 
-  if (!measureMallocPublish(topic, compose)) return false;
+  if (!composeAndPublish(topic, compose)) return false;
   incPublishedTopicCount();   // ADR-062 / TASK-349
   return true;
 }
@@ -3323,7 +3385,7 @@ static bool streamSatBoolSwitch(HaDiscoveryContext &ctx,
   // No incPublishedTopicCount() here: streamSatBoolSwitch is a private helper
   // (not a stream*Discovery entry point), and its caller streamSatSwitchDiscovery
   // increments the published counter exactly once for the whole switch.
-  return measureMallocPublish(topic, compose);
+  return composeAndPublish(topic, compose);
 }
 
 bool streamSatSwitchDiscovery(uint8_t switchIdx,
@@ -3472,7 +3534,7 @@ bool streamSatSelectDiscovery(uint8_t selectIdx,
     return writeJsonClose(w);
   };
 
-  if (!measureMallocPublish(topic, compose)) return false;
+  if (!composeAndPublish(topic, compose)) return false;
   incPublishedTopicCount();   // ADR-062 / TASK-349
   return true;
 }
@@ -3537,7 +3599,7 @@ bool streamButtonDiscovery(HaDiscoveryContext &ctx)
     return writeJsonClose(w);
   };
 
-  if (!measureMallocPublish(topic, compose)) return false;
+  if (!composeAndPublish(topic, compose)) return false;
   incPublishedTopicCount();   // ADR-062 / TASK-349
   return true;
 }
@@ -3652,7 +3714,7 @@ bool streamSelectDiscovery(uint8_t selectIdx, HaDiscoveryContext &ctx)
     return writeJsonClose(w);
   };
 
-  if (!measureMallocPublish(topic, compose)) return false;
+  if (!composeAndPublish(topic, compose)) return false;
   incPublishedTopicCount();   // ADR-062 / TASK-349
   return true;
 }
@@ -3868,3 +3930,262 @@ uint8_t clearTopologyDiscoveryForOTId(uint8_t otId,
 
   return cleared;
 }
+
+// ---------------------------------------------------------------------------
+// Device-based discovery (settings.mqtt.bDeviceDiscovery)
+// ---------------------------------------------------------------------------
+// Per-entity discovery needs one retained publish per sensor/binary_sensor
+// row, dripped one OT ID per 2 s tick (10 s under heap pressure), so a fresh
+// broker or an HA restart waits minutes for full coverage. HA also accepts a
+// device discovery payload: dev + origin once, shared avty_t, and a "cmps"
+// map whose components carry the per-entity fields plus "p" (the platform).
+// The component key is the entity object id (the uniq_id tail), so an entity
+// gets the same uniq_id, name and stat_t in either mode.
+//
+// The table entities are split over slots (see MQTTstuff.h). A component list
+// is walked per OT ID in the same order as doAutoConfigureMsgid(); bilateral
+// Boiler/Thermostat passes collapse to one component because both passes emit
+// the same uniq_id (ADR-140: both route through the active OT engine prefix).
+// ---------------------------------------------------------------------------
+
+enum : uint8_t { HA_CMP_SENSOR = 0, HA_CMP_BINARY = 1 };
+
+struct HaDeviceComponent {
+  uint8_t  otId;
+  uint8_t  kind;     // HA_CMP_SENSOR / HA_CMP_BINARY
+  uint8_t  source;   // 0 = base, 1 = _thermostat, 2 = _boiler (source-template rows)
+  uint16_t row;      // index into mqttHaSensors[] / mqttHaBinSensors[]
+};
+
+// Source variants, same strings and order as expandAndStreamSensorSources().
+static const char kDevSrcSuffixThermostat[] PROGMEM = "_thermostat";
+static const char kDevSrcSuffixBoiler[]     PROGMEM = "_boiler";
+static const char kDevSrcNameThermostat[]   PROGMEM = "Thermostat";
+static const char kDevSrcNameBoiler[]       PROGMEM = "Boiler";
+static const char kDevSrcSegThermostat[]    PROGMEM = "thermostat";
+static const char kDevSrcSegBoiler[]        PROGMEM = "boiler";
+
+// Visit the table components of one OT ID. allVariants: include every row any
+// settings combination could publish (source variants, legacy-replaced rows
+// and the alias tail) -- used to size slots independently of the settings.
+template <typename Fn>
+static bool forEachDeviceComponent(uint8_t otId, const HaDiscoveryContext &ctx,
+                                   bool allVariants, Fn &&fn)
+{
+  const uint16_t sIdx = readSensorIndex(otId);
+  if (sIdx != MQTT_HA_INDEX_NONE) {
+    for (uint16_t i = sIdx; i < MQTT_HA_SENSOR_COUNT; i++) {
+      MqttHaSensorCfg cfg = readSensorCfg(i);
+      if (cfg.id != otId) break;
+      if (cfg.flags & MQTT_HA_FLAG_ANY_SOURCE) {
+        if (!allVariants && !ctx.separateSources) continue;
+        if (!fn(HaDeviceComponent{otId, HA_CMP_SENSOR, 1, i})) return false;
+        if (!fn(HaDeviceComponent{otId, HA_CMP_SENSOR, 2, i})) return false;
+      } else {
+        if (!fn(HaDeviceComponent{otId, HA_CMP_SENSOR, 0, i})) return false;
+      }
+    }
+  }
+  // ADR-106: legacy topic names publish the indexed rows only, new names skip
+  // the rows replaced by an alias and add the alias tail.
+  const uint16_t bIdx = readBinSensorIndex(otId);
+  if (bIdx != MQTT_HA_INDEX_NONE) {
+    for (uint16_t i = bIdx; i < MQTT_HA_BINSENSOR_INDEXED_COUNT; i++) {
+      MqttHaBinSensorCfg cfg = readBinSensorCfg(i);
+      if (cfg.id != otId) break;
+      if (!allVariants && !ctx.legacyOtTopics && (cfg.flags & MQTT_HA_FLAG_LEGACY_REPLACED_BY_ALIAS)) continue;
+      if (!fn(HaDeviceComponent{otId, HA_CMP_BINARY, 0, i})) return false;
+    }
+  }
+  if (allVariants || !ctx.legacyOtTopics) {
+    for (uint16_t i = MQTT_HA_BINSENSOR_INDEXED_COUNT; i < MQTT_HA_BINSENSOR_COUNT; i++) {
+      MqttHaBinSensorCfg cfg = readBinSensorCfg(i);
+      if (cfg.id != otId) continue;
+      if (!fn(HaDeviceComponent{otId, HA_CMP_BINARY, 0, i})) return false;
+    }
+  }
+  return true;
+}
+
+// "<objectId>":{"p":"sensor"|"binary_sensor",<entity fields>}
+static bool writeDeviceComponent(MqttJsonWriter &w, const HaDeviceComponent &c,
+                                 HaDiscoveryContext &ctx)
+{
+  ctx.device = (c.otId <= 127) ? HaDevice::Boiler : topoDeviceForPseudoId(c.otId);
+
+  char idLabel[48];
+  char suffixBuf[16], nameBuf[16], segBuf[16];
+  MqttHaSensorCfg scfg;
+  MqttHaBinSensorCfg bcfg;
+  if (c.kind == HA_CMP_SENSOR) {
+    scfg = readSensorCfg(c.row);
+    strlcpy_P(idLabel, scfg.label, sizeof(idLabel));
+  } else {
+    bcfg = readBinSensorCfg(c.row);
+    strlcpy_P(idLabel, bcfg.label, sizeof(idLabel));
+  }
+  sanitizeHaObjectId(idLabel);
+
+  const char *origSuffix = ctx.sourceSuffix;
+  const char *origName   = ctx.sourceName;
+  const char *origSeg    = ctx.sourceTopicSegment;
+  if (c.source != 0) {
+    const bool thermostat = (c.source == 1);
+    strlcpy_P(suffixBuf, thermostat ? kDevSrcSuffixThermostat : kDevSrcSuffixBoiler, sizeof(suffixBuf));
+    strlcpy_P(nameBuf,   thermostat ? kDevSrcNameThermostat   : kDevSrcNameBoiler,   sizeof(nameBuf));
+    strlcpy_P(segBuf,    thermostat ? kDevSrcSegThermostat    : kDevSrcSegBoiler,    sizeof(segBuf));
+    ctx.sourceSuffix = suffixBuf;
+    ctx.sourceName = nameBuf;
+    ctx.sourceTopicSegment = segBuf;
+  }
+
+  bool ok = w.writeChar('"')
+         && writeEntityObjectId(w, ctx, idLabel, c.source != 0)
+         && w.writeProgmem(PSTR("\":{\"p\":\""))
+         && w.writeProgmem(c.kind == HA_CMP_SENSOR ? PSTR("sensor") : PSTR("binary_sensor"))
+         && w.writeProgmem(PSTR("\","))
+         && (c.kind == HA_CMP_SENSOR ? writeSensorEntityFields(w, scfg, ctx)
+                                     : writeBinSensorEntityFields(w, bcfg, ctx))
+         && writeJsonClose(w);
+
+  ctx.sourceSuffix = origSuffix;
+  ctx.sourceName = origName;
+  ctx.sourceTopicSegment = origSeg;
+  return ok;
+}
+
+uint8_t buildHaDeviceSlots(const HaDiscoveryContext &ctx, uint8_t slotOf[256])
+{
+  // Size with the longest nodeId (sUniqueid[41]) and publish namespace
+  // ("<sTopTopic[41]>/value/<nodeId>") the settings allow, so the boundaries
+  // depend on the firmware tables only.
+  char nodeIdMax[41];
+  char pubTopicMax[88];
+  memset(nodeIdMax, 'x', sizeof(nodeIdMax) - 1);
+  nodeIdMax[sizeof(nodeIdMax) - 1] = '\0';
+  memset(pubTopicMax, 'x', sizeof(pubTopicMax) - 1);
+  pubTopicMax[sizeof(pubTopicMax) - 1] = '\0';
+  HaDiscoveryContext worst = ctx;
+  worst.nodeId = nodeIdMax;
+  worst.mqttPubTopic = pubTopicMax;
+  worst.sourceSuffix = "";
+  worst.sourceName = "";
+  worst.sourceTopicSegment = "";
+
+  const size_t budget = HA_DEVICE_DISCOVERY_CHUNK_MAX - HA_DEVICE_HEADER_RESERVE;
+  uint8_t slot = 0;
+  size_t used = 0;
+  bool any = false;
+  for (uint16_t id = 0; id < 256; id++) {
+    MqttJsonWriter m(MqttJsonWriter::MEASURE);
+    forEachDeviceComponent(static_cast<uint8_t>(id), worst, /*allVariants=*/true,
+                           [&](const HaDeviceComponent &c) {
+                             return writeDeviceComponent(m, c, worst) && writeJsonComma(m);
+                           });
+    if (m.byteCount == 0) { slotOf[id] = HA_DEVICE_SLOT_NONE; continue; }
+    if (any && used + m.byteCount > budget && slot + 1 < HA_DEVICE_SLOT_MAX) {
+      slot++;
+      used = 0;
+    }
+    used += m.byteCount;
+    slotOf[id] = slot;
+    any = true;
+  }
+  return any ? slot + 1 : 0;
+}
+
+static bool buildDeviceDiscoveryTopic(char *dest, size_t destSize, uint8_t slot,
+                                      const uint8_t slotOf[256],
+                                      const char *haPrefix, const char *nodeId)
+{
+  for (uint16_t id = 0; id < 256; id++) {
+    if (slotOf[id] != slot) continue;
+    // Named after the slot's first OT ID: stable across builds that do not
+    // move the boundaries, readable in an MQTT explorer.
+    int n = snprintf_P(dest, destSize, PSTR("%s/device/%s/ot_%u/config"),
+                       haPrefix, nodeId, (unsigned)id);
+    return (n > 0 && static_cast<size_t>(n) < destSize);
+  }
+  return false;
+}
+
+// ---------------------------------------------------------------------------
+// Public API: streamDeviceDiscovery
+// ---------------------------------------------------------------------------
+bool streamDeviceDiscovery(uint8_t slot,
+                           const uint8_t slotOf[256],
+                           const uint32_t knownIds[8],
+                           HaDiscoveryContext &ctx,
+                           bool countTopic)
+{
+  if (!mqttIsConnected()) return false;
+  if (!canPublishMQTT()) return false;
+  // The composed buffer and espMqttClient's Outbox copy coexist until the
+  // publish is handed over.
+  if (platformFreeHeap() < STREAM_HEAP_MIN + 2 * HA_DEVICE_DISCOVERY_CHUNK_MAX) return false;
+  if (platformMaxFreeBlock() < HA_DEVICE_DISCOVERY_CHUNK_MAX) return false;
+
+  char topic[STREAM_TOPIC_MAX];
+  if (!buildDeviceDiscoveryTopic(topic, sizeof(topic), slot, slotOf, ctx.haPrefix, ctx.nodeId))
+    return false;
+
+  auto isKnown = [&](uint16_t id) {
+    return slotOf[id] == slot && (knownIds[id >> 5] & (1UL << (id & 31))) != 0;
+  };
+  // An empty cmps map would tell HA to drop the slot's entities.
+  uint16_t components = 0;
+  for (uint16_t id = 0; id < 256; id++) {
+    if (!isKnown(id)) continue;
+    forEachDeviceComponent(static_cast<uint8_t>(id), ctx, /*allVariants=*/false,
+                           [&](const HaDeviceComponent &) { components++; return true; });
+  }
+  if (components == 0) return false;
+
+  // The full device block rides every slot: each is a self-contained config.
+  const bool origFirst = ctx.isFirstEntity;
+  const HaDevice origDevice = ctx.device;
+  ctx.isFirstEntity = true;
+
+  auto compose = [&](MqttJsonWriter &w) -> bool {
+    bool first = true;
+    if (!writeJsonOpen(w)) return false;
+    if (!writeJsonKV(w, kAvtyT, ctx.mqttPubTopic)) return false;
+    if (!writeJsonComma(w)) return false;
+    if (!writeDeviceBlock(w, ctx)) return false;
+    if (!writeJsonComma(w)) return false;
+    if (!writeOriginBlock(w, ctx)) return false;
+    if (!w.writeProgmem(PSTR(",\"cmps\":{"))) return false;
+    for (uint16_t id = 0; id < 256; id++) {
+      if (!isKnown(id)) continue;
+      if (!forEachDeviceComponent(static_cast<uint8_t>(id), ctx, /*allVariants=*/false,
+                                  [&](const HaDeviceComponent &c) {
+                                    if (!first && !writeJsonComma(w)) return false;
+                                    first = false;
+                                    return writeDeviceComponent(w, c, ctx);
+                                  }))
+        return false;
+    }
+    return w.writeChar('}') && writeJsonClose(w);
+  };
+
+  const bool ok = composeAndPublish(topic, compose);
+  ctx.isFirstEntity = origFirst;
+  ctx.device = origDevice;
+  if (!ok) return false;
+  if (countTopic) incPublishedTopicCount();   // ADR-062 / TASK-349: one retained topic per slot
+  return true;
+}
+
+uint8_t clearDeviceDiscovery(const uint8_t slotOf[256],
+                             const char *haPrefix,
+                             const char *nodeId)
+{
+  uint8_t cleared = 0;
+  char topic[STREAM_TOPIC_MAX];
+  for (uint8_t slot = 0; slot < HA_DEVICE_SLOT_MAX; slot++) {
+    if (!buildDeviceDiscoveryTopic(topic, sizeof(topic), slot, slotOf, haPrefix, nodeId)) break;
+    if (publishEmptyRetained(topic)) cleared++;
+    feedWatchDog();
+  }
+  return cleared;
+}
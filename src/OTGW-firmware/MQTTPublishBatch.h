@@ -0,0 +1,124 @@
+/*
+***************************************************************************
+**  Program  : MQTTPublishBatch.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Publish window around one decoded OT frame.
+**
+**  A Status frame fans out to status_master/status_slave, 7-8 bit topics,
+**  hvac_mode/hvac_action and the _thermostat/_boiler source variants: up to
+**  ~30 sendMQTTData() calls in one processOT() pass. Each of them used to run
+**  the full gate (settings.mqtt.bEnable, MQTTclient.connected(),
+**  isValidIP(), canPublishMQTT() -> getHeapHealth()) although none of those
+**  can change between two publishes of the same frame.
+**
+**  begin   mqttBatchBegin()       opens the window (nests; only the
+**                                 outermost begin/commit pair counts)
+**  append  mqttBatchLinkGate()    first call evaluates the link/heap gate
+**                                 and caches the verdict, later calls
+**                                 in the window reuse it
+**          mqttBatchAppend()      one publish queued in the window
+**  commit  mqttBatchCommit()      closes the window, folds the counters
+**
+**  The per-message mqttPublishAllowed interval gate (OTPublishGate) is NOT
+**  part of the cached verdict; it is decided per topic and stays per call.
+**  The verdict is evaluated lazily, so a frame that publishes nothing costs
+**  no gate check at all.
+**
+**  No Arduino dependency: tests/test_mqtt_publish_batch.cpp includes this
+**  header directly.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef MQTTPUBLISHBATCH_H
+#define MQTTPUBLISHBATCH_H
+
+#include <stdint.h>
+
+enum MqttBatchGate : uint8_t {
+  MQTT_BATCH_GATE_UNKNOWN = 0,   // not evaluated yet in this window
+  MQTT_BATCH_GATE_OPEN,          // link up, broker valid, heap OK
+  MQTT_BATCH_GATE_CLOSED,        // MQTT disabled / disconnected / bad broker IP
+  MQTT_BATCH_GATE_HEAP           // heap critical: every publish in the window is a drop
+};
+
+struct MqttPublishBatch {
+  uint8_t  depth      = 0;                        // 0 = no window open
+  uint8_t  gate       = MQTT_BATCH_GATE_UNKNOWN;  // cached verdict for this window
+  uint16_t messages   = 0;                        // publishes queued in this window
+  uint16_t gateChecks = 0;                        // gate consults in this window
+  // Totals over all windows (mirrored into state.mqtt by the firmware).
+  uint32_t batches         = 0;   // windows that queued at least one publish
+  uint32_t batchedMessages = 0;
+  uint32_t maxMessages     = 0;   // largest single window
+  uint32_t gateChecksSaved = 0;   // gate consults answered from the cache
+};
+
+inline void mqttBatchBegin(MqttPublishBatch &b)
+{
+  if (b.depth++ > 0) return;
+  b.gate = MQTT_BATCH_GATE_UNKNOWN;
+  b.messages = 0;
+  b.gateChecks = 0;
+}
+
+inline bool mqttBatchActive(const MqttPublishBatch &b)
+{
+  return b.depth > 0;
+}
+
+// Gate verdict for one publish. Outside a window evaluate() runs every time;
+// inside a window it runs once and the result is reused. evaluate() returns
+// an MqttBatchGate (never UNKNOWN).
+template <typename Evaluate>
+inline uint8_t mqttBatchLinkGate(MqttPublishBatch &b, Evaluate evaluate)
+{
+  if (b.depth == 0) return evaluate();
+  b.gateChecks++;
+  if (b.gate == MQTT_BATCH_GATE_UNKNOWN) b.gate = evaluate();
+  return b.gate;
+}
+
+inline void mqttBatchAppend(MqttPublishBatch &b)
+{
+  if (b.depth > 0 && b.messages < UINT16_MAX) b.messages++;
+}
+
+// Returns true when this closed the outermost window.
+inline bool mqttBatchCommit(MqttPublishBatch &b)
+{
+  if (b.depth == 0) return false;   // unbalanced commit: ignore
+  if (--b.depth > 0) return false;
+  if (b.gateChecks > 1) b.gateChecksSaved += (uint32_t)(b.gateChecks - 1);
+  if (b.messages > 0) {
+    b.batches++;
+    b.batchedMessages += b.messages;
+    if (b.messages > b.maxMessages) b.maxMessages = b.messages;
+  }
+  b.gate = MQTT_BATCH_GATE_UNKNOWN;
+  return true;
+}
+
+#endif // MQTTPUBLISHBATCH_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
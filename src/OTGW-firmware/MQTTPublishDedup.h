@@ -0,0 +1,187 @@
+/*
+***************************************************************************
+**  Program  : MQTTPublishDedup.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Per-topic duplicate-payload filter in front of the value publish path
+**  (mqttPublishFullTopic() in MQTTstuff.ino).
+**
+**  On-change publishing (shouldPublishMQTTForID(), ADR-006/ADR-116) only
+**  tracks the raw value of the primary OT msgId slots. The topics derived
+**  from a frame (status text, hvac_mode/hvac_action, the _thermostat /
+**  _boiler source variants, sat/..., Dallas sensors) went out on every frame
+**  or poll even when the payload was byte-for-byte what the broker already
+**  had. This cache remembers, per topic, a hash of the last payload sent and
+**  when it was sent, and drops a publish whose payload is unchanged until the
+**  MQTT heartbeat interval has passed:
+**
+**    check   mqttDedupCheck()    hash topic + payload, find the topic's slot;
+**                                send = new topic, changed payload, or the
+**                                heartbeat has expired
+**    commit  mqttDedupCommit()   after a successful publish only, so a
+**                                failed publish is retried next time
+**    clear   mqttDedupClear()    connect / HA birth / republish-all: every
+**                                topic is new again
+**
+**  Slots are a fixed open-addressed table (MQTT_DEDUP_SLOTS, 12 B each) with
+**  a short linear probe; a full probe window evicts its least recently sent
+**  topic, which only costs that topic one extra publish. Hashes are 32-bit
+**  FNV-1a, the payload hash mixed with its length. A payload-hash collision
+**  would hold back one changed value until the heartbeat, 1 in 2^32 per
+**  change. Topic hash 0 marks an empty slot, so a topic hashing to 0 is
+**  stored as 1.
+**
+**  No Arduino dependency: tests/test_mqtt_publish_dedup.cpp includes this
+**  header directly.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef MQTTPUBLISHDEDUP_H
+#define MQTTPUBLISHDEDUP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef MQTT_DEDUP_SLOTS
+#define MQTT_DEDUP_SLOTS 512              // power of two; ~2x the value topics of a full OT + SAT install
+#endif
+#define MQTT_DEDUP_PROBE 16
+
+static_assert((MQTT_DEDUP_SLOTS & (MQTT_DEDUP_SLOTS - 1)) == 0, "MQTT_DEDUP_SLOTS must be a power of two");
+static_assert(MQTT_DEDUP_PROBE <= MQTT_DEDUP_SLOTS, "probe window larger than the table");
+
+struct MqttDedupSlot {
+  uint32_t topicHash;                     // 0 = empty
+  uint32_t payloadHash;
+  uint32_t sentMs;                        // millis() of the last publish
+};
+
+struct MqttPublishDedup {
+  MqttDedupSlot slot[MQTT_DEDUP_SLOTS] = {};
+  uint16_t used      = 0;                 // slots holding a topic
+  // Totals since boot (mirrored into state.mqtt by the firmware).
+  uint32_t hits      = 0;                 // publishes dropped: same payload within the heartbeat
+  uint32_t misses    = 0;                 // publishes passed: new topic or changed payload
+  uint32_t refreshes = 0;                 // publishes passed: same payload, heartbeat expired
+  uint32_t evictions = 0;                 // topics pushed out of a full probe window
+};
+
+struct MqttDedupVerdict {
+  bool     send;
+  uint16_t slot;
+  uint32_t topicHash;
+  uint32_t payloadHash;
+};
+
+inline uint32_t mqttDedupFnv1a(uint32_t h, const uint8_t *p, size_t len)
+{
+  while (len--) {
+    h ^= *p++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+inline uint32_t mqttDedupTopicHash(const char *topic)
+{
+  const uint32_t h = mqttDedupFnv1a(2166136261u, reinterpret_cast<const uint8_t *>(topic), strlen(topic));
+  return h ? h : 1u;
+}
+
+inline uint32_t mqttDedupPayloadHash(const uint8_t *payload, size_t len)
+{
+  uint32_t h = mqttDedupFnv1a(2166136261u, payload, len);
+  h ^= (uint32_t)len;
+  return h * 16777619u;
+}
+
+// Decide whether (topic, payload) goes out. heartbeatMs 0 = never suppress.
+inline MqttDedupVerdict mqttDedupCheck(MqttPublishDedup &d, const char *topic,
+                                       const uint8_t *payload, size_t len,
+                                       uint32_t nowMs, uint32_t heartbeatMs)
+{
+  MqttDedupVerdict v;
+  v.send        = true;
+  v.topicHash   = mqttDedupTopicHash(topic);
+  v.payloadHash = mqttDedupPayloadHash(payload, len);
+
+  const uint16_t mask = MQTT_DEDUP_SLOTS - 1;
+  const uint16_t home = (uint16_t)(v.topicHash & mask);
+  uint16_t empty = UINT16_MAX;
+  uint16_t oldest = UINT16_MAX;
+  for (uint16_t i = 0; i < MQTT_DEDUP_PROBE; i++) {
+    const uint16_t idx = (uint16_t)((home + i) & mask);
+    const MqttDedupSlot &s = d.slot[idx];
+    if (s.topicHash == v.topicHash) {
+      v.slot = idx;
+      if (s.payloadHash != v.payloadHash) {
+        d.misses++;
+      } else if (heartbeatMs > 0 && (uint32_t)(nowMs - s.sentMs) < heartbeatMs) {
+        v.send = false;
+        d.hits++;
+      } else {
+        d.refreshes++;
+      }
+      return v;
+    }
+    if (s.topicHash == 0) {
+      // Slots only empty on mqttDedupClear(), so nothing past a hole can
+      // belong to this topic.
+      empty = idx;
+      break;
+    }
+    if (oldest == UINT16_MAX
+        || (uint32_t)(nowMs - s.sentMs) > (uint32_t)(nowMs - d.slot[oldest].sentMs)) {
+      oldest = idx;
+    }
+  }
+  v.slot = (empty != UINT16_MAX) ? empty : oldest;
+  d.misses++;
+  return v;
+}
+
+// Record a publish that was queued. Call only when v.send was true.
+inline void mqttDedupCommit(MqttPublishDedup &d, const MqttDedupVerdict &v, uint32_t nowMs)
+{
+  MqttDedupSlot &s = d.slot[v.slot];
+  if (s.topicHash == 0) {
+    d.used++;
+  } else if (s.topicHash != v.topicHash) {
+    d.evictions++;
+  }
+  s.topicHash   = v.topicHash;
+  s.payloadHash = v.payloadHash;
+  s.sentMs      = nowMs;
+}
+
+// Forget every topic; counters are kept.
+inline void mqttDedupClear(MqttPublishDedup &d)
+{
+  memset(d.slot, 0, sizeof(d.slot));
+  d.used = 0;
+}
+
+#endif // MQTTPUBLISHDEDUP_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
@@ -0,0 +1,231 @@
+/*
+***************************************************************************
+**  Program  : MQTTTopicIntern.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Pre-rendered MQTT topics for the OT value publishers.
+**
+**  Every decoded OT value used to compose its topic at publish time:
+**  print_s8s8() and friends strlcpy/strlcat the OTmap label plus a suffix
+**  into otTopic, sendMQTTData() snprintf's "<MQTTPubNamespace>/" and strlcat's
+**  the leaf, and publishToSourceTopic() snprintf's the _thermostat / _boiler
+**  variants on top of that. That is 3-6 string compositions of ~50 bytes per
+**  frame for topics that only change when the namespace does.
+**
+**  This table renders every "<namespace>/<label><suffix><variant>" once, at
+**  MQTT connect, into one heap block. The publish path then looks a topic up
+**  by (msgId, suffix, variant) and hands the pointer straight to
+**  mqttPublishRaw(). Which suffixes and variants exist per msgId follows the
+**  OTmap[] value type (mqttTopicShapeFor); anything outside that shape, or a
+**  table that could not be built, returns nullptr and the caller composes
+**  the topic the old way.
+**
+**  Layout of the block: uint16_t offset[slots] followed by the NUL-terminated
+**  topics. Slot order per msgId: suffix (ascending bit in the mask), then
+**  variant. first[]/mask[]/variants[] index into it without a search.
+**
+**  No Arduino dependency: tests/bench_ot_replay.cpp includes this header and
+**  checks every interned topic against the legacy composition.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef MQTTTOPICINTERN_H
+#define MQTTTOPICINTERN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "OTmap.h"
+
+enum MqttTopicSuffix : uint8_t {
+  MQTT_TOPIC_SFX_NONE = 0,    // "<label>"            print_f88/s16/u16, print_u8_single
+  MQTT_TOPIC_SFX_VALUE_HB,    // "<label>_value_hb"   print_s8s8
+  MQTT_TOPIC_SFX_VALUE_LB,    // "<label>_value_lb"
+  MQTT_TOPIC_SFX_HB_U8,       // "<label>_hb_u8"      print_u8u8, print_u8_single aliases
+  MQTT_TOPIC_SFX_LB_U8,       // "<label>_lb_u8"
+  MQTT_TOPIC_SFX_COUNT
+};
+
+// ADR-097 sibling-suffix source topics, see publishToSourceTopic().
+enum MqttTopicVariant : uint8_t {
+  MQTT_TOPIC_CANONICAL = 0,
+  MQTT_TOPIC_THERMOSTAT,      // "<topic>_thermostat"
+  MQTT_TOPIC_BOILER,          // "<topic>_boiler"
+  MQTT_TOPIC_VARIANT_COUNT
+};
+
+static const char * const kMqttTopicSuffixText[MQTT_TOPIC_SFX_COUNT] = {
+  "", "_value_hb", "_value_lb", "_hb_u8", "_lb_u8"
+};
+static const char * const kMqttTopicVariantText[MQTT_TOPIC_VARIANT_COUNT] = {
+  "", "_thermostat", "_boiler"
+};
+
+#define MQTT_TOPIC_BIT(sfx) ((uint8_t)(1u << (sfx)))
+
+struct MqttTopicShape {
+  uint8_t suffixMask;   // MQTT_TOPIC_BIT() of every suffix the decoder publishes
+  uint8_t variants;     // 1 = canonical only, 3 = canonical + _thermostat + _boiler
+};
+
+// Topics the print_* decoder for this OTmap value type publishes. Source
+// variants only for the decoders that call publishToSourceTopic().
+inline MqttTopicShape mqttTopicShapeFor(OTtype_t type)
+{
+  switch (type) {
+    case ot_f88:
+    case ot_s16:
+    case ot_u16:  return { MQTT_TOPIC_BIT(MQTT_TOPIC_SFX_NONE), MQTT_TOPIC_VARIANT_COUNT };
+    case ot_s8s8: return { (uint8_t)(MQTT_TOPIC_BIT(MQTT_TOPIC_SFX_VALUE_HB) | MQTT_TOPIC_BIT(MQTT_TOPIC_SFX_VALUE_LB)),
+                           MQTT_TOPIC_VARIANT_COUNT };
+    case ot_u8:   return { (uint8_t)(MQTT_TOPIC_BIT(MQTT_TOPIC_SFX_NONE) | MQTT_TOPIC_BIT(MQTT_TOPIC_SFX_HB_U8) |
+                                     MQTT_TOPIC_BIT(MQTT_TOPIC_SFX_LB_U8)),
+                           MQTT_TOPIC_VARIANT_COUNT };
+    case ot_u8u8: return { (uint8_t)(MQTT_TOPIC_BIT(MQTT_TOPIC_SFX_HB_U8) | MQTT_TOPIC_BIT(MQTT_TOPIC_SFX_LB_U8)), 1 };
+    default:      return { 0, 0 };
+  }
+}
+
+struct MqttTopicTable {
+  char     *block = nullptr;                 // offsets + topics, nullptr = not built
+  uint32_t  bytes = 0;                       // size of block
+  uint16_t  slots = 0;
+  uint16_t  first[OT_MSGID_MAX + 1] = {};    // first slot of each msgId
+  uint8_t   mask[OT_MSGID_MAX + 1] = {};     // MQTT_TOPIC_BIT() per suffix present
+  uint8_t   variants[OT_MSGID_MAX + 1] = {}; // variants per suffix (1 or 3)
+};
+
+inline void mqttTopicTableFree(MqttTopicTable &t)
+{
+  free(t.block);
+  t = MqttTopicTable();
+}
+
+inline uint8_t mqttTopicPopcount8(uint8_t v)
+{
+#if defined(__GNUC__)
+  return (uint8_t)__builtin_popcount(v);
+#else
+  uint8_t n = 0;
+  while (v) { n += v & 1u; v >>= 1; }
+  return n;
+#endif
+}
+
+// Walk OTmap[] once. With out == nullptr only counts; otherwise writes the
+// offsets and topics into out (sized by a previous counting pass). Each topic
+// is cut at maxTopicLen characters, the same place the legacy
+// snprintf/strlcat into a MQTT_TOPIC_MAX_LEN buffer cut it.
+inline size_t mqttTopicTableLayout(MqttTopicTable &t, const char *ns, bool sourceVariants,
+                                   size_t maxTopicLen, char *out)
+{
+  const size_t nsLen = strlen(ns);
+  uint16_t slot = 0;
+  for (int id = 0; id <= OT_MSGID_MAX; id++) {
+    const MqttTopicShape shape = mqttTopicShapeFor(OTmap[id].type);
+    const char *label = OTmap[id].label;
+    const bool hasLabel = label && label[0];
+    t.first[id] = slot;
+    t.mask[id] = hasLabel ? shape.suffixMask : 0;
+    t.variants[id] = hasLabel ? (sourceVariants ? shape.variants : (uint8_t)(shape.variants ? 1 : 0)) : 0;
+    slot = (uint16_t)(slot + mqttTopicPopcount8(t.mask[id]) * t.variants[id]);
+  }
+  t.slots = slot;
+
+  size_t pos = (size_t)slot * sizeof(uint16_t);
+  slot = 0;
+  for (int id = 0; id <= OT_MSGID_MAX; id++) {
+    if (!t.mask[id]) continue;
+    const char *label = OTmap[id].label;
+    const size_t labelLen = strlen(label);
+    for (uint8_t sfx = 0; sfx < MQTT_TOPIC_SFX_COUNT; sfx++) {
+      if (!(t.mask[id] & MQTT_TOPIC_BIT(sfx))) continue;
+      const size_t sfxLen = strlen(kMqttTopicSuffixText[sfx]);
+      for (uint8_t v = 0; v < t.variants[id]; v++) {
+        const size_t varLen = strlen(kMqttTopicVariantText[v]);
+        size_t len = nsLen + 1 + labelLen + sfxLen + varLen;
+        if (len > maxTopicLen) len = maxTopicLen;
+        if (out) {
+          if (pos > 0xFFFF) return 0;                  // offsets are 16 bit
+          const uint16_t off = (uint16_t)pos;
+          memcpy(out + (size_t)slot * sizeof(uint16_t), &off, sizeof(off));
+          char *p = out + pos;
+          size_t n = 0;
+          const char *parts[5] = { ns, "/", label, kMqttTopicSuffixText[sfx], kMqttTopicVariantText[v] };
+          for (const char *part : parts) {
+            for (; *part && n < len; part++) p[n++] = *part;
+          }
+          p[len] = '\0';
+        }
+        pos += len + 1;
+        slot++;
+      }
+    }
+  }
+  return pos;
+}
+
+// Bytes mqttTopicTableBuild() will allocate for this namespace.
+inline size_t mqttTopicTableMeasure(const char *ns, bool sourceVariants, size_t maxTopicLen)
+{
+  MqttTopicTable scratch;
+  return mqttTopicTableLayout(scratch, ns, sourceVariants, maxTopicLen, nullptr);
+}
+
+// (Re)build the table for namespace ns. On allocation failure or overflow the
+// table is left empty (every lookup misses) and false is returned.
+inline bool mqttTopicTableBuild(MqttTopicTable &t, const char *ns, bool sourceVariants, size_t maxTopicLen)
+{
+  mqttTopicTableFree(t);
+  const size_t bytes = mqttTopicTableLayout(t, ns, sourceVariants, maxTopicLen, nullptr);
+  char *block = bytes ? static_cast<char *>(malloc(bytes)) : nullptr;
+  if (!block || mqttTopicTableLayout(t, ns, sourceVariants, maxTopicLen, block) != bytes) {
+    free(block);
+    t = MqttTopicTable();
+    return false;
+  }
+  t.block = block;
+  t.bytes = (uint32_t)bytes;
+  return true;
+}
+
+// Fully qualified topic, or nullptr when (msgId, suffix, variant) is not in
+// the table.
+inline const char *mqttTopicLookup(const MqttTopicTable &t, uint8_t msgId, uint8_t sfx, uint8_t variant)
+{
+  if (!t.block || msgId > OT_MSGID_MAX || sfx >= MQTT_TOPIC_SFX_COUNT) return nullptr;
+  const uint8_t mask = t.mask[msgId];
+  if (!(mask & MQTT_TOPIC_BIT(sfx)) || variant >= t.variants[msgId]) return nullptr;
+  const uint16_t slot = (uint16_t)(t.first[msgId] +
+                                   mqttTopicPopcount8(mask & (uint8_t)(MQTT_TOPIC_BIT(sfx) - 1u)) * t.variants[msgId] +
+                                   variant);
+  uint16_t off;
+  memcpy(&off, t.block + (size_t)slot * sizeof(uint16_t), sizeof(off));
+  return t.block + off;
+}
+
+#endif // MQTTTOPICINTERN_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
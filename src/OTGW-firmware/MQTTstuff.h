@@ -42,6 +42,28 @@
 struct MQTTRuntimeSection {    // state.mqtt -- MQTT broker connection state
   bool bConnected        = false;  // was statusMQTTconnection
   uint32_t iLastConnectedMs = 0;   // millis() when MQTT was last connected (for fallback detection)
+  // Topic composition counters (MQTTTopicIntern.h). "formatted" = topic bytes
+  // built with snprintf/strlcat at publish time, "interned" = topic bytes served
+  // pre-rendered from the table. formatted + interned is what the publish path
+  // composed before the table existed. *Bps = last full second.
+  uint32_t iTopicFormattedBytes = 0;
+  uint32_t iTopicInternedBytes  = 0;
+  uint32_t iTopicFormattedBps   = 0;
+  uint32_t iTopicInternedBps    = 0;
+  uint32_t iTopicInternMisses   = 0;   // OT value topics not in the table (composed instead)
+  uint32_t iTopicTableBytes     = 0;   // heap held by the table, 0 = not built
+  // Publish windows (MQTTPublishBatch.h): one per decoded OT frame / PS line
+  // that queued at least one publish. messages / count = average fan-out.
+  uint32_t iBatchCount           = 0;
+  uint32_t iBatchMessages        = 0;
+  uint32_t iBatchMaxMessages     = 0;
+  uint32_t iBatchGateChecksSaved = 0;  // link/heap gate evaluations skipped
+  // Duplicate-payload filter on the value topics (MQTTPublishDedup.h).
+  uint32_t iDedupHits      = 0;        // publishes dropped: payload unchanged within the heartbeat
+  uint32_t iDedupMisses    = 0;        // publishes passed: new topic or changed payload
+  uint32_t iDedupRefreshes = 0;        // publishes passed: unchanged, heartbeat expired
+  uint32_t iDedupEvictions = 0;
+  uint32_t iDedupTopics    = 0;        // topics in the cache
 };
 
 // ADR-116: default heartbeat interval (s) used both as the fresh-install
@@ -50,6 +72,16 @@ struct MQTTRuntimeSection {    // state.mqtt -- MQTT broker connection state
 #define MQTT_DEFAULT_PUBLISH_INTERVAL_SEC 60
 #endif
 
+// TASK-400: Status-bit specific heartbeat interval. Hardcoded to 60 seconds
+// so the msgId 0 status_master / status_slave fan-out (and the msgId 70
+// Status VH equivalent) publishes at least once a minute as a state-snapshot
+// for HA reconnect recovery, INDEPENDENT of settings.mqtt.iInterval (which
+// governs all OTHER topic throttles). The 60s cadence is a compromise: long
+// enough to eliminate per-frame publish spam under steady-state boiler
+// conditions (drops 160 publishes/sec → ~0.27/sec), short enough that HA
+// regains full state within one minute after any MQTT broker reconnect.
+constexpr uint16_t STATUS_HEARTBEAT_INTERVAL_SEC = 60;
+
 struct MQTTSettingsSection {
   bool    bEnable          = true;
   bool    bSecure          = false;
@@ -84,6 +116,14 @@ struct MQTTSettingsSection {
   // erased with empty retained publishes so HA removes those entities.
   // Updated (and persisted) only after the stale-topic drain completes.
   bool    bLastPublishedLegacy = false;
+  // Device-based discovery: the sensor / binary_sensor table entities go out
+  // as a few "<haPrefix>/device/<nodeId>/ot_<id>/config" payloads instead of
+  // one config topic each (see HA_DEVICE_DISCOVERY_CHUNK_MAX below).
+  bool    bDeviceDiscovery = false;
+  // Same idea as bLastPublishedLegacy for the discovery format: stamped once
+  // the other format's table configs are erased, so a switch (runtime or by
+  // config edit) is detected on the next discovery cycle and survives reboot.
+  bool    bLastPublishedDevice = false;
 };
 
 // ---------------------------------------------------------------------------
@@ -411,6 +451,8 @@ struct HaDiscoveryContext {
     const char *model;             // Hardware model (from settings.device) — legacy only
     bool        isFirstEntity;
     bool        legacyMode = false;           // settings.mqtt.bLegacyMode, threaded in (the .cpp TU cannot see globals)
+    bool        separateSources = false;      // settings.mqtt.bSeparateSources, same reason (device discovery walk)
+    bool        legacyOtTopics = false;       // settings.mqtt.bUseLegacyOtTopics, same reason (device discovery walk)
     HaDevice    device = HaDevice::Esp;       // routing ordinal: selects the entity source prefix (ADR-140), not a device id
     // TASK-847: OtCore device suffix/name — set unconditionally in buildDiscoveryContext().
     // Fixed boards: compile-time HA_OTCORE_SUFFIX / HA_OTCORE_NAME.
@@ -446,11 +488,13 @@ bool mqttPublishRaw(const char* topic, const uint8_t* payload, size_t len, bool
 //
 // In MEASURE mode: no output; just accumulates byteCount so the caller can
 // size the publish buffer exactly.
-// In WRITE mode: appends bytes into a caller-supplied heap buffer (buf/cap).
+// In WRITE mode: appends bytes into a caller-supplied buffer (buf/cap).
 //
-// The same composition function runs twice — first MEASURE to learn the
-// length, then WRITE into a malloc'd buffer of that length — keeping the two
-// passes perfectly in sync without duplicating the JSON structure logic.
+// Discovery composes once, in WRITE mode, into the engine's scratch arena
+// (composeAndPublish() in MQTTHaDiscovery.cpp). That writer is a "spill"
+// writer: an append that does not fit clears ok and drops it to MEASURE, so
+// the composition still runs to the end and byteCount is the exact size for
+// the malloc'd second pass. A plain WRITE writer fails the append instead.
 // The filled buffer is then handed to mqttPublishRaw() as one atomic publish.
 //
 // Defined in the header so Arduino's auto-prototype generation knows the type
@@ -464,16 +508,26 @@ struct MqttJsonWriter {
   bool   ok;
   char  *buf;   // WRITE target (nullptr in MEASURE mode)
   size_t cap;   // capacity of buf (excluding the NUL we never need)
-
-  explicit MqttJsonWriter(Mode m) : mode(m), byteCount(0), ok(true), buf(nullptr), cap(0) {}
-  MqttJsonWriter(char *target, size_t capacity)
-    : mode(WRITE), byteCount(0), ok(true), buf(target), cap(capacity) {}
+  bool   spill; // on overflow: keep counting in MEASURE instead of failing
+
+  explicit MqttJsonWriter(Mode m) : mode(m), byteCount(0), ok(true), buf(nullptr), cap(0), spill(false) {}
+  MqttJsonWriter(char *target, size_t capacity, bool spillOnOverflow = false)
+    : mode(WRITE), byteCount(0), ok(true), buf(target), cap(capacity), spill(spillOnOverflow) {}
+
+  // An append did not fit: the output is unusable either way. A spill writer
+  // carries on counting; a plain writer fails the append.
+  bool overflow() {
+    ok = false;
+    if (!spill) return false;
+    mode = MEASURE;
+    return true;
+  }
 
   // Append len bytes from RAM source s into buf, guarding against overrun.
   bool appendRam(const char *s, size_t len) {
     if (mode == WRITE && len > 0) {
-      if (byteCount + len > cap) { ok = false; return false; }
-      memcpy(buf + byteCount, s, len);
+      if (byteCount + len <= cap) memcpy(buf + byteCount, s, len);
+      else if (!overflow()) return false;
     }
     byteCount += len;
     return true;
@@ -502,8 +556,8 @@ struct MqttJsonWriter {
     if (!s) return true;
     size_t len = strlen_P(s);
     if (mode == WRITE && len > 0) {
-      if (byteCount + len > cap) { ok = false; return false; }
-      memcpy_P(buf + byteCount, s, len);
+      if (byteCount + len <= cap) memcpy_P(buf + byteCount, s, len);
+      else if (!overflow()) return false;
     }
     byteCount += len;
     return true;
@@ -511,8 +565,8 @@ struct MqttJsonWriter {
 
   bool writeChar(char c) {
     if (mode == WRITE) {
-      if (byteCount + 1 > cap) { ok = false; return false; }
-      buf[byteCount] = c;
+      if (byteCount < cap) buf[byteCount] = c;
+      else if (!overflow()) return false;
     }
     byteCount += 1;
     return true;
@@ -527,8 +581,9 @@ struct MqttJsonWriter {
 // Streaming discovery functions (defined in MQTTHaDiscovery.cpp)
 //
 // TASK-865.7: the PubSubClient &client parameter is gone. Each function now
-// measures its payload, mallocs a transient buffer, fills it via MqttJsonWriter
-// WRITE mode, and hands it to mqttPublishRaw() (the single publish chokepoint).
+// composes its payload once into the discovery scratch arena (a malloc'd
+// buffer only for the rare payload that does not fit) and hands it to
+// mqttPublishRaw() (the single publish chokepoint).
 // ---------------------------------------------------------------------------
 bool streamSensorDiscovery(const MqttHaSensorCfg &cfg,
                            HaDiscoveryContext &ctx);
@@ -582,4 +637,46 @@ uint8_t clearTopologyDiscoveryForOTId(uint8_t otId,
                                       const char *nodeId,
                                       bool separateSources);
 
+// ---------------------------------------------------------------------------
+// Device-based discovery (settings.mqtt.bDeviceDiscovery, MQTTHaDiscovery.cpp)
+//
+// Instead of one retained config per sensor / binary_sensor table row, the
+// table entities go out as a few "<haPrefix>/device/<nodeId>/ot_<id>/config"
+// payloads: dev + origin + avty_t once, then a "cmps" map with one component
+// per entity ({"p":"sensor"|"binary_sensor", <same fields as per-entity>}).
+// Each payload is a "slot" covering a contiguous OT ID range; the slot
+// boundaries are derived from the tables with worst-case string lengths, so a
+// slot never exceeds HA_DEVICE_DISCOVERY_CHUNK_MAX and never moves when
+// settings change. A slot carries the OT IDs in knownIds[] (done | pending),
+// so a JIT ID republishes its slot as a superset of what HA already has.
+// Climate, number, override, SAT, button/select and Dallas entities stay
+// per-entity.
+//
+// 16 KB rather than 8: the heaviest single ID (pseudo-ID 252, the SAT
+// statistics, TASK-543) needs ~12.5 KB with the longest nodeId and topic,
+// and an ID never spans two slots. tests/test_ha_device_discovery.cpp checks
+// the bound with worst-case strings.
+// ---------------------------------------------------------------------------
+constexpr size_t  HA_DEVICE_DISCOVERY_CHUNK_MAX = 16384; // one publish: transient buffer + Outbox copy
+constexpr size_t  HA_DEVICE_HEADER_RESERVE      = 1024;  // dev + origin + avty_t + braces, worst case
+constexpr uint8_t HA_DEVICE_SLOT_MAX            = 32;
+constexpr uint8_t HA_DEVICE_SLOT_NONE           = 0xFF;
+
+// Fill slotOf[otId] with the slot of every OT ID that has table entities
+// (HA_DEVICE_SLOT_NONE otherwise). Returns the slot count.
+uint8_t buildHaDeviceSlots(const HaDiscoveryContext &ctx, uint8_t slotOf[256]);
+
+// Compose and publish one slot. countTopic: first publish of this slot since
+// clearMQTTConfigDone(), so it adds one retained topic to the ADR-062 count.
+bool streamDeviceDiscovery(uint8_t slot,
+                           const uint8_t slotOf[256],
+                           const uint32_t knownIds[8],
+                           HaDiscoveryContext &ctx,
+                           bool countTopic);
+
+// Empty-retained every slot topic (leaving device mode). Returns topics cleared.
+uint8_t clearDeviceDiscovery(const uint8_t slotOf[256],
+                             const char *haPrefix,
+                             const char *nodeId);
+
 // end of MQTTstuff.h
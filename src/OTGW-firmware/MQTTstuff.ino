@@ -44,6 +44,8 @@ void runTopicCleanupStep();
 // TASK-648 Task 6: device-topology migration cleanup
 static void armTopologyCleanup(bool staleIsLegacy);
 static void runTopologyCleanupStep();
+static bool topologyCleanupIdle();
+static HaDiscoveryContext buildDiscoveryContext(bool isFirst = false);
 
 // Declare some variables within global scope
 
@@ -231,6 +233,45 @@ static char       MQTTPubNamespace[MQTT_NAMESPACE_MAX_LEN];
 static char       MQTTSubNamespace[MQTT_NAMESPACE_MAX_LEN];
 static char       NodeId[MQTT_ID_MAX_LEN];
 
+// Pre-rendered "<MQTTPubNamespace>/<label><suffix>[_thermostat|_boiler]" for
+// the OT value publishers (MQTTTopicIntern.h). Built in onMqttConnect() from
+// the namespace of that connection, dropped in startMQTT() when the namespace
+// is rebuilt. Lookups on an empty table miss and the caller composes.
+static MqttTopicTable mqttTopicTable;
+
+// Keep this much contiguous heap free after the table allocation; the table
+// is an optimisation and must never be what starves a discovery publish.
+constexpr uint32_t MQTT_TOPIC_TABLE_HEAP_RESERVE = 16384;
+
+static void buildMQTTTopicTable()
+{
+  mqttTopicTableFree(mqttTopicTable);
+  state.mqtt.iTopicTableBytes = 0;
+  const bool sourceVariants = settings.mqtt.bSeparateSources;
+  const size_t need = mqttTopicTableMeasure(MQTTPubNamespace, sourceVariants, MQTT_TOPIC_MAX_LEN - 1);
+  if (platformMaxFreeBlock() < need + MQTT_TOPIC_TABLE_HEAP_RESERVE) {
+    DebugTf(PSTR("[MQTT] topic table skipped: need %u B, max_block=%u\r\n"), (unsigned)need, platformMaxFreeBlock());
+    return;
+  }
+  if (!mqttTopicTableBuild(mqttTopicTable, MQTTPubNamespace, sourceVariants, MQTT_TOPIC_MAX_LEN - 1)) {
+    DebugTf(PSTR("[MQTT] topic table build failed (%u B)\r\n"), (unsigned)need);
+    return;
+  }
+  state.mqtt.iTopicTableBytes = mqttTopicTable.bytes;
+  DebugTf(PSTR("[MQTT] topic table: %u topics, %u B\r\n"), (unsigned)mqttTopicTable.slots, (unsigned)mqttTopicTable.bytes);
+}
+
+// Roll the per-second topic byte rates. Called from handleMQTT() once a second.
+static void updateMQTTTopicRates()
+{
+  static uint32_t lastFormatted = 0;
+  static uint32_t lastInterned = 0;
+  state.mqtt.iTopicFormattedBps = state.mqtt.iTopicFormattedBytes - lastFormatted;
+  state.mqtt.iTopicInternedBps  = state.mqtt.iTopicInternedBytes - lastInterned;
+  lastFormatted = state.mqtt.iTopicFormattedBytes;
+  lastInterned  = state.mqtt.iTopicInternedBytes;
+}
+
 // =====================================================================
 // MQTT auto-discovery verification (ADR-062, TASK-349)
 // State machine extracted to mqtt_discovery_verify.cpp under TASK-363.
@@ -584,6 +625,9 @@ void startMQTT()
   strlcpy(NodeId, CSTR(settings.mqtt.sUniqueid), sizeof(NodeId));
   buildNamespace(MQTTPubNamespace, sizeof(MQTTPubNamespace), CSTR(settings.mqtt.sTopTopic), "value", NodeId);
   buildNamespace(MQTTSubNamespace, sizeof(MQTTSubNamespace), CSTR(settings.mqtt.sTopTopic), "set", NodeId);
+  // Topics pre-rendered for the old namespace are stale; rebuilt on connect.
+  mqttTopicTableFree(mqttTopicTable);
+  state.mqtt.iTopicTableBytes = 0;
   // Fresh start: clear done/pending bitmaps, then queue only non-OT configs.
   // OT ID configs publish JIT as each MsgID is received on the bus (ADR-100).
   clearMQTTConfigDone();
@@ -1067,6 +1111,7 @@ void handleMQTT()
   DECLARE_TIMER_SEC(timerMQTTdebugisconnected, 60);
   DECLARE_TIMER_SEC(timerMQTToverridepublish, 60);  // ADR-118: refresh retained <label>/override topics
   DECLARE_TIMER_SEC(timerMQTTbirthreassert, 300);   // F3 (TASK-874): re-assert retained availability "online"
+  DECLARE_TIMER_SEC(timerMQTTtopicrates, 1);        // per-second topic byte rates for /api/v2/debug
   
   // Pump the espMqttClient engine EVERY tick, unconditionally (TASK-865.7).
   // With UseInternalTask::NO, loop() is the SOLE driver of the connection state
@@ -1087,6 +1132,8 @@ void handleMQTT()
   // deliver traffic once the initial retained sweep is done.
   mqttV2MigrationTick();
 
+  if (DUE(timerMQTTtopicrates)) updateMQTTTopicRates();
+
   switch(stateMQTT) 
   {
     case MQTT_STATE_INIT:
@@ -1305,6 +1352,13 @@ static void onMqttConnect(bool sessionPresent) {
   Debugln(F("MQTT connected"));
   MQTTDebugTln(F("Next State: MQTT_STATE_IS_CONNECTED"));
 
+  // Pre-render the OT value topics for this namespace before the first
+  // republish runs through them (MQTTTopicIntern.h).
+  buildMQTTTopicTable();
+  // A new session may have missed anything sent while we were away, and the
+  // namespace may have changed: no payload counts as already delivered.
+  clearMQTTPublishDedup();
+
   // Birth message (retained "online" on the HA availability topic).
   // F3 (TASK-874): gate-bypassing publish so a low-heap CONNACK cannot drop the
   // birth and strand HA at the retained LWT "offline". A periodic re-assert in
@@ -1378,35 +1432,113 @@ static void onMqttDisconnect(espMqttClientTypes::DisconnectReason reason) {
 // their frame and commit the matching mqttPendingSlot accordingly.
 uint32_t mqttSendSuccessCount = 0;
 
-/*
-  topic:  <string> , sensor topic, will be automatically prefixed with <mqtt topic>/value/<node_id>
-  json:   <string> , payload to send
-  retain: <bool> , retain mqtt message
-*/
-bool sendMQTTData(const char* topic, const char *json, const bool retain)
+// Publish window around one decoded OT frame (MQTTPublishBatch.h). processOT()
+// and processPSSummary() open it via MQTTPublishBatchScope; every sendMQTTData()
+// inside reuses one link/heap verdict instead of re-running the gate.
+static MqttPublishBatch mqttBatch;
+
+// Last payload per value topic (MQTTPublishDedup.h). Consulted by
+// mqttPublishFullTopic() only: discovery, LWT/birth, deletes and commands go
+// to mqttPublishRaw() directly and are never filtered.
+static MqttPublishDedup mqttDedup;
+
+// Heartbeat for unchanged payloads: the on-change interval (ADR-116), capped
+// at the status-bit heartbeat so the TASK-400 once-a-minute status snapshot
+// still goes out when MQTTinterval is longer. One second shorter than the
+// gates it sits behind, which count in whole seconds, so a heartbeat they
+// let through is not dropped here. 0 when on-change publishing is off, so
+// every publish goes out as before.
+static uint32_t mqttDedupHeartbeatMs()
 {
-  if (!settings.mqtt.bEnable) return false;
-  if (!mqttPublishAllowed) return false;
-  if (!MQTTclient.connected()) { return false; }  // handleMQTT() logs disconnect and manages reconnect
-  if (!isValidIP(MQTTbrokerIP)) {DebugTln(F("Error: MQTT broker IP not valid.")); return false;}
+  if (!settings.mqtt.bOnChangePublishing || settings.mqtt.iInterval == 0) return 0;
+  const uint32_t sec = (settings.mqtt.iInterval < STATUS_HEARTBEAT_INTERVAL_SEC)
+                       ? settings.mqtt.iInterval : STATUS_HEARTBEAT_INTERVAL_SEC;
+  return (sec - 1) * 1000UL;
+}
+
+static void syncMQTTPublishDedupState()
+{
+  state.mqtt.iDedupHits      = mqttDedup.hits;
+  state.mqtt.iDedupMisses    = mqttDedup.misses;
+  state.mqtt.iDedupRefreshes = mqttDedup.refreshes;
+  state.mqtt.iDedupEvictions = mqttDedup.evictions;
+  state.mqtt.iDedupTopics    = mqttDedup.used;
+}
+
+// Every value topic counts as new again: after (re)connect and whenever the
+// OT publish gates are reset (requestMQTTRepublishAll()).
+void clearMQTTPublishDedup()
+{
+  mqttDedupClear(mqttDedup);
+  syncMQTTPublishDedupState();
+}
+
+void beginMQTTPublishBatch()
+{
+  mqttBatchBegin(mqttBatch);
+}
+
+void commitMQTTPublishBatch()
+{
+  if (!mqttBatchCommit(mqttBatch)) return;
+  state.mqtt.iBatchCount           = mqttBatch.batches;
+  state.mqtt.iBatchMessages        = mqttBatch.batchedMessages;
+  state.mqtt.iBatchMaxMessages     = mqttBatch.maxMessages;
+  state.mqtt.iBatchGateChecksSaved = mqttBatch.gateChecksSaved;
+}
+
+// Link + heap part of the publish gate. Everything here holds for a whole OT
+// frame, so inside a window it is evaluated once.
+static uint8_t mqttLinkGate()
+{
+  if (!settings.mqtt.bEnable) return MQTT_BATCH_GATE_CLOSED;
+  if (!MQTTclient.connected()) return MQTT_BATCH_GATE_CLOSED;  // handleMQTT() logs disconnect and manages reconnect
+  if (!isValidIP(MQTTbrokerIP)) {DebugTln(F("Error: MQTT broker IP not valid.")); return MQTT_BATCH_GATE_CLOSED;}
 
   // Check heap health before publishing
   if (!canPublishMQTT()) {
     // Message dropped due to low heap - canPublishMQTT() handles logging
-    return false;
+    return MQTT_BATCH_GATE_HEAP;
   }
+  return MQTT_BATCH_GATE_OPEN;
+}
 
-  char full_topic[MQTT_TOPIC_MAX_LEN];
-  snprintf_P(full_topic, sizeof(full_topic), PSTR("%s/"), MQTTPubNamespace);
-  strlcat(full_topic, topic, sizeof(full_topic));
-  MQTTDebugTf(PSTR("Sending MQTT: server %s:%d => TopicId [%s] --> Message [%s]\r\n"), settings.mqtt.sBroker, settings.mqtt.iBrokerPort, full_topic, json);
+// Every sendMQTTData() flavour checks the same gates before it spends any
+// time on the topic.
+static bool mqttPublishGatesOpen()
+{
+  if (!mqttPublishAllowed) return false;   // per-topic interval gate, never cached
+  const bool cached = mqttBatchActive(mqttBatch) && mqttBatch.gate != MQTT_BATCH_GATE_UNKNOWN;
+  const uint8_t gate = mqttBatchLinkGate(mqttBatch, mqttLinkGate);
+  // A cached heap verdict still counts every message it drops.
+  if (gate == MQTT_BATCH_GATE_HEAP && cached) state.heapdiag.iMqttDropsTotal++;
+  return gate == MQTT_BATCH_GATE_OPEN;
+}
+
+// Publish json to an already fully qualified topic.
+static bool mqttPublishFullTopic(const char* full_topic, const char *json, const bool retain)
+{
   const size_t payloadLen = strlen(json);
+  const uint32_t nowMs = millis();
+  const MqttDedupVerdict dedup = mqttDedupCheck(mqttDedup, full_topic, reinterpret_cast<const uint8_t*>(json),
+                                                payloadLen, nowMs, mqttDedupHeartbeatMs());
+  if (!dedup.send) {
+    // The broker already has this payload. Report success so bit/byte slot
+    // helpers commit, but do not count a send for the OTPublishGate delta.
+    state.mqtt.iDedupHits = mqttDedup.hits;
+    MQTTDebugTf(PSTR("MQTT dedup: TopicId [%s] unchanged, skipped\r\n"), full_topic);
+    return true;
+  }
+  MQTTDebugTf(PSTR("Sending MQTT: server %s:%d => TopicId [%s] --> Message [%s]\r\n"), settings.mqtt.sBroker, settings.mqtt.iBrokerPort, full_topic, json);
   // espMqttClient frames atomically (copies topic+payload into its Outbox); the
   // TASK-770 disconnect-on-truncated-write guard is obsolete.
   if (!mqttPublishRaw(full_topic, reinterpret_cast<const uint8_t*>(json), payloadLen, retain)) {
     PrintMQTTError();
     return false;
   }
+  mqttDedupCommit(mqttDedup, dedup, nowMs);
+  syncMQTTPublishDedupState();
+  mqttBatchAppend(mqttBatch);
   // ADR-104 Decision item 7: no auto-commit of pending slot updates inside
   // sendMQTTData. Bit/byte slots commit-or-discard in their per-helper publish
   // path; the normal-msgId mqttPendingSlot is committed-or-discarded by the
@@ -1418,23 +1550,61 @@ bool sendMQTTData(const char* topic, const char *json, const bool retain)
   // unchanged: a queued publish is the commit point.
   ++mqttSendSuccessCount;
   return true;
+}
+
+/*
+  topic:  <string> , sensor topic, will be automatically prefixed with <mqtt topic>/value/<node_id>
+  json:   <string> , payload to send
+  retain: <bool> , retain mqtt message
+*/
+bool sendMQTTData(const char* topic, const char *json, const bool retain)
+{
+  if (!mqttPublishGatesOpen()) return false;
+
+  char full_topic[MQTT_TOPIC_MAX_LEN];
+  snprintf_P(full_topic, sizeof(full_topic), PSTR("%s/"), MQTTPubNamespace);
+  const size_t topicLen = strlcat(full_topic, topic, sizeof(full_topic));
+  state.mqtt.iTopicFormattedBytes += (topicLen < sizeof(full_topic)) ? topicLen : sizeof(full_topic) - 1;
+  return mqttPublishFullTopic(full_topic, json, retain);
 } // sendMQTTData()
 
+// Compose "<OTmap label><suffix>" for msgId into dest: the fallback for
+// topics that are not in mqttTopicTable (table not built, or a msgId /
+// suffix outside its shape).
+static void composeOTValueLeaf(char *dest, size_t destSize, uint8_t msgId, uint8_t suffix)
+{
+  const char *label = (msgId <= OT_MSGID_MAX) ? OTmap[msgId].label : "Undefined";
+  strlcpy(dest, label, destSize);
+  if (suffix < MQTT_TOPIC_SFX_COUNT) strlcat(dest, kMqttTopicSuffixText[suffix], destSize);
+  state.mqtt.iTopicFormattedBytes += strlen(dest);
+}
+
+bool sendMQTTDataForId(uint8_t msgId, uint8_t suffix, const char* json, const bool retain)
+{
+  if (!mqttPublishGatesOpen()) return false;
+  const char *full_topic = mqttTopicLookup(mqttTopicTable, msgId, suffix, MQTT_TOPIC_CANONICAL);
+  if (full_topic) {
+    state.mqtt.iTopicInternedBytes += strlen(full_topic);
+    return mqttPublishFullTopic(full_topic, json, retain);
+  }
+  state.mqtt.iTopicInternMisses++;
+  char leaf[OT_TOPIC_LEN];
+  composeOTValueLeaf(leaf, sizeof(leaf), msgId, suffix);
+  return sendMQTTData(leaf, json, retain);
+}
+
 bool sendMQTTData(const __FlashStringHelper *topic, const char *json, const bool retain)
 {
   char topicBuf[MQTT_TOPIC_MAX_LEN];
   strncpy_P(topicBuf, reinterpret_cast<PGM_P>(topic), sizeof(topicBuf) - 1);
   topicBuf[sizeof(topicBuf) - 1] = '\0';
+  state.mqtt.iTopicFormattedBytes += strlen(topicBuf);
   return sendMQTTData(topicBuf, json, retain);
 }
 
 bool sendMQTTData(const __FlashStringHelper *topic, const __FlashStringHelper *json, const bool retain)
 {
-  if (!settings.mqtt.bEnable) return false;
-  if (!mqttPublishAllowed) return false;
-  if (!MQTTclient.connected()) { return false; }  // handleMQTT() logs disconnect and manages reconnect
-  if (!isValidIP(MQTTbrokerIP)) {DebugTln(F("Error: MQTT broker IP not valid.")); return false;}
-  if (!canPublishMQTT()) return false;
+  if (!mqttPublishGatesOpen()) return false;
 
   char topicBuf[MQTT_TOPIC_MAX_LEN];
   char full_topic[MQTT_TOPIC_MAX_LEN];
@@ -1442,13 +1612,7 @@ bool sendMQTTData(const __FlashStringHelper *topic, const __FlashStringHelper *j
   topicBuf[sizeof(topicBuf) - 1] = '\0';
   snprintf_P(full_topic, sizeof(full_topic), PSTR("%s/"), MQTTPubNamespace);
   strlcat(full_topic, topicBuf, sizeof(full_topic));
-
-  MQTTDebugTf(PSTR("Sending MQTT: server %s:%d => TopicId [%s] --> Message ["),
-              settings.mqtt.sBroker,
-              settings.mqtt.iBrokerPort,
-              full_topic);
-  MQTTDebug(json);
-  MQTTDebugln(F("]"));
+  state.mqtt.iTopicFormattedBytes += strlen(topicBuf) + strlen(full_topic);
 
   // espMqttClient::publish memcpys the payload from RAM, so stage the PROGMEM
   // value into a stack buffer first. These F()-literal payloads are short
@@ -1456,14 +1620,8 @@ bool sendMQTTData(const __FlashStringHelper *topic, const __FlashStringHelper *j
   PGM_P payload = reinterpret_cast<PGM_P>(json);
   char payloadBuf[MQTT_TOPIC_MAX_LEN];
   strlcpy_P(payloadBuf, payload, sizeof(payloadBuf));
-  const size_t payloadLen = strlen(payloadBuf);
-  if (!mqttPublishRaw(full_topic, reinterpret_cast<const uint8_t*>(payloadBuf), payloadLen, retain)) {
-    PrintMQTTError();
-    return false;
-  }
-  // ADR-104 Decision item 7: no auto-commit. See char* overload comment.
-  ++mqttSendSuccessCount;
-  return true;
+  // ADR-104: no auto-commit. See mqttPublishFullTopic().
+  return mqttPublishFullTopic(full_topic, payloadBuf, retain);
 }
 
 //===========================================================================================
@@ -1864,10 +2022,10 @@ void publishMQTTInt(const __FlashStringHelper* topic, int value) {
 //
 // The ADR-097 Write-Ack gate (bSlaveEchoesValue) suppresses real-boiler
 // Write-Ack frames whose data byte is per-spec undefined; see the gate
-// comment inside the function for the OTdata.type vs rsptype distinction.
-void publishToSourceTopic(const char* topic, const char* json, byte rsptype)
+// comment inside routeSourceTopics() for the OTdata.type vs rsptype
+// distinction. routeSourceTopics() returns false when nothing is published.
+static bool routeSourceTopics(byte rsptype, bool &toThermostat, bool &toBoiler)
 {
-  if (!settings.mqtt.bSeparateSources || !topic || !json) return;
   // ADR-097: skip the source subtopics for MsgIDs where the slave's Write-Ack
   // data byte is per-spec undefined. Without this gate, the _thermostat /
   // _boiler topics flap between the Write-Data value and the Ack's protocol-
@@ -1887,18 +2045,11 @@ void publishToSourceTopic(const char* topic, const char* json, byte rsptype)
   // and are valid here.
   if (OTdata.type == OT_WRITE_ACK
       && rsptype == OTGW_BOILER
-      && !OTlookupitem.bSlaveEchoesValue) return;
-  // Re-entrancy guard (precautionary). On ESP32 (ADR-128 dropped ESP8266)
-  // feedWatchDog() does not yield and doAutoConfigure runs async, so sendMQTTData
-  // no longer re-enters this path cooperatively — but the guard is kept cheap so a
-  // future yielding publish path cannot overwrite the static buffer mid-publish.
-  static bool inUse = false;
-  if (inUse) return;
-  inUse = true;
+      && !OTlookupitem.bSlaveEchoesValue) return false;
 
   // Worldview routing decision (ADR-096, refined by ADR-103 for proxy A).
-  bool toThermostat = false;
-  bool toBoiler = false;
+  toThermostat = false;
+  toBoiler = false;
   switch (rsptype) {
     case OTGW_THERMOSTAT:        // T: thermostat-sent write
       toThermostat = true;
@@ -1916,22 +2067,67 @@ void publishToSourceTopic(const char* topic, const char* json, byte rsptype)
       toBoiler = !OTdata.bAnswerOverride;  // ADR-103: proxy A (no B) → _boiler too; override A → _thermostat only
       break;
     default:                     // parity errors, unknown types
-      inUse = false;
-      return;
+      return false;
   }
+  return true;
+}
+
+void publishToSourceTopic(const char* topic, const char* json, byte rsptype)
+{
+  if (!settings.mqtt.bSeparateSources || !topic || !json) return;
+  bool toThermostat, toBoiler;
+  if (!routeSourceTopics(rsptype, toThermostat, toBoiler)) return;
+  // Re-entrancy guard (precautionary). On ESP32 (ADR-128 dropped ESP8266)
+  // feedWatchDog() does not yield and doAutoConfigure runs async, so sendMQTTData
+  // no longer re-enters this path cooperatively — but the guard is kept cheap so a
+  // future yielding publish path cannot overwrite the static buffer mid-publish.
+  static bool inUse = false;
+  if (inUse) return;
+  inUse = true;
 
   static char sourceTopic[MQTT_TOPIC_MAX_LEN];
   if (toThermostat) {
     snprintf_P(sourceTopic, sizeof(sourceTopic), PSTR("%s_thermostat"), topic);
+    state.mqtt.iTopicFormattedBytes += strlen(sourceTopic);
     sendMQTTData(sourceTopic, json, false);
   }
   if (toBoiler) {
     snprintf_P(sourceTopic, sizeof(sourceTopic), PSTR("%s_boiler"), topic);
+    state.mqtt.iTopicFormattedBytes += strlen(sourceTopic);
     sendMQTTData(sourceTopic, json, false);
   }
   inUse = false;
 }
 
+// publishToSourceTopic() for "<OTmap label><suffix>" of msgId. Both variant
+// topics come pre-rendered from mqttTopicTable; no static buffer, so no
+// re-entrancy guard. Falls back to the composing path as a whole when either
+// needed variant is missing, so the two sides never mix old and new topics.
+void publishToSourceTopicForId(uint8_t msgId, uint8_t suffix, const char* json, byte rsptype)
+{
+  if (!settings.mqtt.bSeparateSources || !json) return;
+  bool toThermostat, toBoiler;
+  if (!routeSourceTopics(rsptype, toThermostat, toBoiler)) return;
+
+  const char *thermostatTopic = toThermostat ? mqttTopicLookup(mqttTopicTable, msgId, suffix, MQTT_TOPIC_THERMOSTAT) : nullptr;
+  const char *boilerTopic = toBoiler ? mqttTopicLookup(mqttTopicTable, msgId, suffix, MQTT_TOPIC_BOILER) : nullptr;
+  if ((toThermostat && !thermostatTopic) || (toBoiler && !boilerTopic)) {
+    state.mqtt.iTopicInternMisses++;
+    char leaf[OT_TOPIC_LEN];
+    composeOTValueLeaf(leaf, sizeof(leaf), msgId, suffix);
+    publishToSourceTopic(leaf, json, rsptype);
+    return;
+  }
+  if (thermostatTopic && mqttPublishGatesOpen()) {
+    state.mqtt.iTopicInternedBytes += strlen(thermostatTopic);
+    mqttPublishFullTopic(thermostatTopic, json, false);
+  }
+  if (boilerTopic && mqttPublishGatesOpen()) {
+    state.mqtt.iTopicInternedBytes += strlen(boilerTopic);
+    mqttPublishFullTopic(boilerTopic, json, false);
+  }
+}
+
 //===========================================================================================
 bool getMQTTConfigDone(const uint8_t MSGid)
 {
@@ -1943,9 +2139,26 @@ void setMQTTConfigDone(const uint8_t MSGid)
   bitSet(MQTTautoConfigMap[MSGid >> 5], MSGid & 0x1F);
 }
 //===========================================================================================
+// Device-based discovery (settings.mqtt.bDeviceDiscovery). The sensor / binary_sensor table
+// entities of a pending OT ID go out inside its slot's "<prefix>/device/<nodeId>/ot_<id>/config"
+// payload (streamDeviceDiscovery() in MQTTHaDiscovery.cpp), together with every other known
+// ID of that slot; doAutoConfigureMsgid() then only publishes the per-entity extras.
+// MQTTdeviceCfgSentMap mirrors MQTTautoConfigMap: bit set = this ID's table entities are in
+// a slot published since clearMQTTConfigDone(). Slot boundaries depend on the firmware tables
+// only, so they are built once, on first use.
+//===========================================================================================
+static uint8_t  sDeviceSlotOf[256];
+static uint8_t  sDeviceSlotCount     = 0;      // 0 = not built yet
+static uint32_t MQTTdeviceCfgSentMap[8] = {0};
+static uint32_t sDeviceSlotCounted   = 0;      // slots already in iPublishedTopicCount (ADR-062)
+static bool     sDeviceClearPending  = false;  // leaving device mode: empty the slot topics first
+static_assert(HA_DEVICE_SLOT_MAX <= 32, "sDeviceSlotCounted is a 32-bit slot mask");
+//===========================================================================================
 void clearMQTTConfigDone()
 {
   memset(MQTTautoConfigMap, 0, sizeof(MQTTautoConfigMap));
+  memset(MQTTdeviceCfgSentMap, 0, sizeof(MQTTdeviceCfgSentMap));
+  sDeviceSlotCounted = 0;
   // Reset published-topic counter so it stays in sync with the bitmap (ADR-062).
   // Stream helpers re-increment on each successful endPublish.
   state.discovery.iPublishedTopicCount = 0;
@@ -1993,6 +2206,28 @@ static void queueNonOTDiscoveryIds()
   dripDeviceInfoPending = true;  // ADR-140: first drip entity carries the full single-device block
 }
 //===========================================================================================
+// Discovery-format migration (bDeviceDiscovery vs the bLastPublishedDevice stamp). Both
+// formats announce the same unique_ids, so the old format's table configs are erased
+// before the new one goes out (loopMQTTDiscovery() holds the drip until then):
+//  - per-entity -> device: the TASK-648 topology drain clears exactly the per-entity
+//    sensor / binary_sensor config topics of the last published scheme, and
+//    runTopologyCleanupStep() stamps bLastPublishedDevice when it completes.
+//  - device -> per-entity: loopMQTTDiscovery() empties the slot topics, then stamps.
+// Called from markAllMQTTConfigPending(), like the TASK-648 check.
+//===========================================================================================
+static void armDeviceDiscoveryMigration()
+{
+  if (settings.mqtt.bLastPublishedDevice == settings.mqtt.bDeviceDiscovery) return;
+  DebugTf(PSTR("[discovery] format migration: stamp=%s -> mode=%s\r\n"),
+          settings.mqtt.bLastPublishedDevice ? "device" : "per-entity",
+          settings.mqtt.bDeviceDiscovery ? "device" : "per-entity");
+  if (settings.mqtt.bDeviceDiscovery) {
+    armTopologyCleanup(settings.mqtt.bLastPublishedLegacy);
+  } else {
+    sDeviceClearPending = true;
+  }
+}
+//===========================================================================================
 // publishNonOTDiscoveryConfigs() — queue only the non-OT discovery configs for drip publish.
 // Called at boot, top-topic change, and broker restart.
 // OT ID configs are NOT queued here; they publish JIT as each MsgID arrives on the bus.
@@ -2000,6 +2235,12 @@ static void queueNonOTDiscoveryIds()
 void publishNonOTDiscoveryConfigs()
 {
   if (!settings.mqtt.bEnable) return;
+  // Discovery-format switch (settings.mqtt.bDeviceDiscovery): markAll arms the migration
+  // and republishes everything in the new format once the old one is gone.
+  if (settings.mqtt.bLastPublishedDevice != settings.mqtt.bDeviceDiscovery) {
+    markAllMQTTConfigPending();
+    return;
+  }
   // TASK-648 Task 6: detect topology migration (legacy<->modern scheme change).
   // Compare the stored stamp against the current effective mode. If different,
   // a scheme migration occurred (either via runtime toggle + reboot, or
@@ -2038,6 +2279,7 @@ void markAllMQTTConfigPending()
             (int)settings.mqtt.bLastPublishedLegacy, (int)settings.mqtt.bLegacyMode);
     armTopologyCleanup(settings.mqtt.bLastPublishedLegacy);
   }
+  armDeviceDiscoveryMigration();
   clearMQTTConfigDone();
   memset(MQTTautoCfgPendingMap, 0, sizeof(MQTTautoCfgPendingMap));
   for (uint16_t i = 0; i < 256; i++) {
@@ -2119,6 +2361,45 @@ static bool discoveryDripIsHeapHealthyForRestore() {
 // leave a stale literal behind in the auto-heal path.
 bool discoveryDripHeapHealthy() { return discoveryDripIsHeapHealthyForRestore(); }
 
+// Device-based discovery: publish the slot holding otId with every ID announced so far
+// (done | pending), so a JIT republish never drops components HA already has. Marks the
+// slot's announced IDs as sent. Dallas (246) keeps its own path (configSensors()).
+static bool publishDeviceDiscoverySlot(uint8_t otId)
+{
+  MQTTAutoConfigSessionLock sessionLock;
+  if (!sessionLock.locked) return false;
+  if (sDeviceSlotCount == 0) sDeviceSlotCount = buildHaDeviceSlots(buildDiscoveryContext(), sDeviceSlotOf);
+  const uint8_t slot = sDeviceSlotOf[otId];
+  if (slot == HA_DEVICE_SLOT_NONE) return false;
+
+  uint32_t known[8];
+  for (uint8_t g = 0; g < 8; g++) known[g] = MQTTautoConfigMap[g] | MQTTautoCfgPendingMap[g];
+  bitClear(known[OTGWdallasdataid >> 5], OTGWdallasdataid & 0x1F);
+
+  HaDiscoveryContext ctx = buildDiscoveryContext();
+  const uint32_t slotBit = 1UL << slot;
+  if (!streamDeviceDiscovery(slot, sDeviceSlotOf, known, ctx, (sDeviceSlotCounted & slotBit) == 0)) return false;
+  sDeviceSlotCounted |= slotBit;
+  for (uint16_t id = 0; id < 256; id++) {
+    if (sDeviceSlotOf[id] == slot && bitRead(known[id >> 5], id & 0x1F)) bitSet(MQTTdeviceCfgSentMap[id >> 5], id & 0x1F);
+  }
+  return true;
+}
+
+// Device -> per-entity: empty every slot topic, then stamp the format (retried next
+// tick when a publish fails). The per-entity republish was queued by markAll.
+static void runDeviceDiscoveryClear()
+{
+  if (!MQTTclient.connected() || !canPublishMQTT()) return;
+  if (sDeviceSlotCount == 0) sDeviceSlotCount = buildHaDeviceSlots(buildDiscoveryContext(), sDeviceSlotOf);
+  const uint8_t cleared = clearDeviceDiscovery(sDeviceSlotOf, CSTR(settings.mqtt.sHaprefix), NodeId);
+  if (cleared < sDeviceSlotCount) return;
+  DebugTf(PSTR("[discovery] %u device discovery topics cleared\r\n"), (unsigned)cleared);
+  sDeviceClearPending = false;
+  settings.mqtt.bLastPublishedDevice = settings.mqtt.bDeviceDiscovery;
+  writeSettings(false);
+}
+
 void loopMQTTDiscovery()
 {
   DECLARE_TIMER_SEC(timerDiscoveryDrip, DISCOVERY_INTERVAL_NORMAL, SKIP_MISSED_TICKS);
@@ -2174,6 +2455,13 @@ void loopMQTTDiscovery()
     return;
   }
 
+  // Leaving device-based discovery: empty the slot topics before any per-entity
+  // config with the same unique_id goes out (armDeviceDiscoveryMigration()).
+  if (sDeviceClearPending) {
+    runDeviceDiscoveryClear();
+    return;
+  }
+
   // Scan pending bitmap for the next set bit
   for (uint8_t group = 0; group < 8; group++) {
     if (MQTTautoCfgPendingMap[group] == 0) continue;
@@ -2196,6 +2484,21 @@ void loopMQTTDiscovery()
         return;  // one per tick
       }
 
+      // Device-based discovery: this ID's table entities ride its slot payload. Its
+      // extras (climate, number, override, ...) follow through doAutoConfigureMsgid()
+      // on a later tick, once the sent bit is set.
+      if (settings.mqtt.bDeviceDiscovery && !bitRead(MQTTdeviceCfgSentMap[group], bit) &&
+          (readSensorIndex(msgId) != MQTT_HA_INDEX_NONE || readBinSensorIndex(msgId) != MQTT_HA_INDEX_NONE)) {
+        // Per-entity configs with the same unique_ids may still be retained.
+        if (!topologyCleanupIdle()) return;
+        if (publishDeviceDiscoverySlot(msgId)) {
+          MQTTDebugTf(PSTR("[drip] OT ID %d published in device slot %u\r\n"), msgId, (unsigned)sDeviceSlotOf[msgId]);
+        } else {
+          MQTTDebugTf(PSTR("[drip] OT ID %d device slot publish failed, retaining pending\r\n"), msgId);
+        }
+        return;  // one publish per tick
+      }
+
       MQTTDebugTf(PSTR("[drip] publishing discovery for OT ID %d\r\n"), msgId);
       bool success = doAutoConfigureMsgid(msgId, dripDeviceInfoPending);
       if (success) {
@@ -2220,7 +2523,7 @@ void loopMQTTDiscovery()
 //===========================================================================================
 // Build a discovery context from the current MQTT state.
 // Caller sets ctx.isFirstEntity as appropriate.
-static HaDiscoveryContext buildDiscoveryContext(bool isFirst = false) {
+static HaDiscoveryContext buildDiscoveryContext(bool isFirst) {
   HaDiscoveryContext ctx;
   ctx.nodeId = NodeId;
   ctx.hostname = CSTR(settings.sHostname);
@@ -2232,6 +2535,8 @@ static HaDiscoveryContext buildDiscoveryContext(bool isFirst = false) {
   ctx.model = settings.device.sModel;
   ctx.isFirstEntity = isFirst;
   ctx.legacyMode = settings.mqtt.bLegacyMode;  // threaded for the .cpp TU (it cannot see globals); ADR-140: no longer branches the device block
+  ctx.separateSources = settings.mqtt.bSeparateSources;  // device-discovery component walk
+  ctx.legacyOtTopics = settings.mqtt.bUseLegacyOtTopics;
   ctx.device = HaDevice::Esp;          // default; deviceForOTId() routes per entity (selects source prefix, ADR-140)
   ctx.sourceSuffix = "";
   ctx.sourceName = "";
@@ -2610,9 +2915,14 @@ bool doAutoConfigureMsgid(byte OTid, bool isFirst)
   // The bilateral sensor loop overrides this per pass.
   ctx.device = deviceForOTId(OTid);
 
+  // Device-based discovery: the sensor / binary_sensor rows below already went out
+  // in this ID's slot payload (loopMQTTDiscovery() -> publishDeviceDiscoverySlot()).
+  const bool tableInDeviceSlot = settings.mqtt.bDeviceDiscovery;
+  if (tableInDeviceSlot && bitRead(MQTTdeviceCfgSentMap[OTid >> 5], OTid & 0x1F)) result = true;
+
   // Sensors — bilateral: run two passes (Boiler, Thermostat) in modern mode.
   uint16_t sIdx = readSensorIndex(OTid);
-  if (sIdx != MQTT_HA_INDEX_NONE) {
+  if (sIdx != MQTT_HA_INDEX_NONE && !tableInDeviceSlot) {
     const uint8_t passes = isBilateral ? 2 : 1;
     for (uint8_t pass = 0; pass < passes; pass++) {
       if (isBilateral) ctx.device = (pass == 0) ? HaDevice::Boiler : HaDevice::Thermostat;
@@ -2643,7 +2953,7 @@ bool doAutoConfigureMsgid(byte OTid, bool isFirst)
   // - new mode (default): SKIP rows flagged MQTT_HA_FLAG_LEGACY_REPLACED_BY_ALIAS.
   // - legacy mode: publish all indexed rows.
   // Bilateral: two passes (Boiler, Thermostat) in modern mode.
-  {
+  if (!tableInDeviceSlot) {
     const uint8_t passes = isBilateral ? 2 : 1;
     for (uint8_t pass = 0; pass < passes; pass++) {
       if (isBilateral) ctx.device = (pass == 0) ? HaDevice::Boiler : HaDevice::Thermostat;
@@ -3361,6 +3671,11 @@ static void armTopologyCleanup(bool staleIsLegacy) {
           staleIsLegacy ? "legacy" : "modern");
 }
 
+// Device-based discovery holds its slot publishes until this is true.
+static bool topologyCleanupIdle() {
+  return g_topoCleanup.mode == TOPO_CLEANUP_MODE_IDLE;
+}
+
 // Drain one OT ID per call. For each armed bit, calls the .cpp helper to
 // publish empty retained to all stale config topics for that ID.
 // On full drain: stamps bLastPublishedLegacy and persists via writeSettings().
@@ -3379,6 +3694,9 @@ static void runTopologyCleanupStep() {
     DebugTln(F("[TASK-648] topology cleanup complete; stamping bLastPublishedLegacy"));
     g_topoCleanup.mode = TOPO_CLEANUP_MODE_IDLE;
     settings.mqtt.bLastPublishedLegacy = settings.mqtt.bLegacyMode;
+    // The per-entity table configs are gone, which is also what entering
+    // device-based discovery waits for (armDeviceDiscoveryMigration()).
+    if (settings.mqtt.bDeviceDiscovery) settings.mqtt.bLastPublishedDevice = true;
     writeSettings(false);  // persist the stamp so reboot does not re-arm
     return;
   }
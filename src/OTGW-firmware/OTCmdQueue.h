@@ -0,0 +1,226 @@
+/*
+***************************************************************************
+**  Program  : OTCmdQueue.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Fixed-capacity PIC command scheduler behind addCommandToQueue(),
+**  handleCommandQueue(), checkCommandResponse() and the ser2net override
+**  path (ADR-016, ADR-059).
+**
+**  The queue used to be cmdqueue[CMDQUEUE_MAX] with a fill pointer: every
+**  add, PIC response and ser2net command scanned it by two-letter code,
+**  every handleCommandQueue() tick scanned it for due entries, and every
+**  removal left-shifted the tail. This keeps the same slots but never moves
+**  them:
+**
+**    code index   head[] has one entry per "AA".."ZZ" code (26x26, plus one
+**                 bucket for anything else) pointing at the first slot with
+**                 that code; next[] chains further slots with the same code
+**                 (only forced PR=x reads share a code) in insertion order.
+**    due heap     heap[] is a permutation of all slots. [0, size) is a
+**                 binary min-heap on (due, insertion order), [size, Capacity)
+**                 are the free slots. handleCommandQueue() pops only what
+**                 is due; add/remove/reschedule are O(log n).
+**
+**  Semantics are the ones the array had: dedup by two-letter code unless
+**  forced (first match in insertion order wins), PR responses match the
+**  register letter, due times compare wraparound-safe. Entries due in the
+**  same tick go out in due order instead of slot order.
+**
+**  Capacity comes from CMDQUEUE_MAX (build flag, 1..254).
+**
+**  No Arduino dependency: tests/bench_cmd_queue.cpp includes this header and
+**  checks it against the legacy array queue.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTCMDQUEUE_H
+#define OTCMDQUEUE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef CMDQUEUE_MAX
+#define CMDQUEUE_MAX 20
+#endif
+
+struct OT_cmd_t { // see all possible commands for PIC here: https://otgw.tclcode.com/firmware.html
+  char cmd[15];
+  int cmdlen;
+  int retrycnt;
+  uint32_t due;
+};
+
+#define OT_CMD_CODE_BUCKETS (26 * 26 + 1)   // "AA".."ZZ" + everything else
+#define OT_CMD_NO_SLOT      0xFF
+
+// Bucket for a two-letter command code. OTGW codes are upper case; anything
+// else shares the last bucket and is told apart by the full compare.
+inline uint16_t otCmdCodeBucket(char c0, char c1)
+{
+  if (c0 >= 'A' && c0 <= 'Z' && c1 >= 'A' && c1 <= 'Z') return (uint16_t)((c0 - 'A') * 26 + (c1 - 'A'));
+  return 26 * 26;
+}
+
+template <uint8_t Capacity>
+struct OTCmdQueue {
+  static_assert(Capacity >= 1 && Capacity < OT_CMD_NO_SLOT, "OTCmdQueue capacity must be 1..254");
+
+  OT_cmd_t entry[Capacity];
+  uint32_t order[Capacity];              // insertion order, tie-break on equal due
+  uint8_t  next[Capacity];               // next slot with the same code bucket
+  uint8_t  heapPos[Capacity];            // index of the slot in heap[]
+  uint8_t  heap[Capacity];               // [0, count) min-heap, [count, Capacity) free
+  uint8_t  head[OT_CMD_CODE_BUCKETS];    // first slot per code bucket
+  uint8_t  count;
+  uint8_t  highWater;
+  uint32_t nextOrder;
+
+  OTCmdQueue() { clear(); }
+
+  void clear()
+  {
+    memset(entry, 0, sizeof(entry));
+    memset(head, OT_CMD_NO_SLOT, sizeof(head));
+    for (uint8_t i = 0; i < Capacity; i++) {
+      heap[i] = i;
+      heapPos[i] = i;
+      next[i] = OT_CMD_NO_SLOT;
+      order[i] = 0;
+    }
+    count = 0;
+    highWater = 0;
+    nextOrder = 0;
+  }
+
+  uint8_t size() const { return count; }
+  bool full() const { return count >= Capacity; }
+
+  // First slot (insertion order) with this code. With matchReg, a PR entry
+  // that carries a register letter ("PR=S") must also have cmd[3] == reg.
+  int find(char c0, char c1, bool matchReg = false, char reg = 0) const
+  {
+    for (uint8_t s = head[otCmdCodeBucket(c0, c1)]; s != OT_CMD_NO_SLOT; s = next[s]) {
+      const OT_cmd_t &e = entry[s];
+      if (e.cmd[0] != c0 || e.cmd[1] != c1) continue;
+      if (matchReg && c0 == 'P' && c1 == 'R' && e.cmdlen >= 4 && e.cmd[3] != reg) continue;
+      return s;
+    }
+    return -1;
+  }
+
+  // Take a free slot for code (c0, c1), link it at the end of its code chain
+  // and into the heap with the given due time. -1 when full.
+  int insert(char c0, char c1, uint32_t due)
+  {
+    if (count >= Capacity) return -1;
+    const uint8_t s = heap[count];
+    entry[s].cmd[0] = c0;
+    entry[s].cmd[1] = c1;
+    entry[s].due = due;
+    order[s] = nextOrder++;
+    next[s] = OT_CMD_NO_SLOT;
+    uint8_t *link = &head[otCmdCodeBucket(c0, c1)];
+    while (*link != OT_CMD_NO_SLOT) link = &next[*link];
+    *link = s;
+    count++;
+    if (count > highWater) highWater = count;
+    siftUp(count - 1);
+    return s;
+  }
+
+  // Slot with the earliest due time, -1 when empty.
+  int top() const { return count ? heap[0] : -1; }
+
+  // entry[slot].due changed: restore heap order.
+  void reschedule(uint8_t slot)
+  {
+    if (slot >= Capacity || heapPos[slot] >= count) return;   // not live
+    siftUp(heapPos[slot]);
+    siftDown(heapPos[slot]);
+  }
+
+  void remove(uint8_t slot)
+  {
+    if (slot >= Capacity || heapPos[slot] >= count) return;   // not live
+    uint8_t *link = &head[otCmdCodeBucket(entry[slot].cmd[0], entry[slot].cmd[1])];
+    while (*link != OT_CMD_NO_SLOT && *link != slot) link = &next[*link];
+    if (*link == slot) *link = next[slot];
+    next[slot] = OT_CMD_NO_SLOT;
+
+    const uint8_t pos = heapPos[slot];
+    const uint8_t last = (uint8_t)(count - 1);
+    swap(pos, last);            // slot moves into the free region
+    count = last;
+    if (pos < count) {
+      const uint8_t moved = heap[pos];
+      siftUp(pos);
+      siftDown(heapPos[moved]);
+    }
+    memset(&entry[slot], 0, sizeof(entry[slot]));
+  }
+
+  // Live slot at heap position i (0 <= i < size()), for dumps.
+  uint8_t slotAt(uint8_t i) const { return heap[i]; }
+
+private:
+  bool before(uint8_t a, uint8_t b) const
+  {
+    const int32_t d = (int32_t)(entry[a].due - entry[b].due);
+    return d < 0 || (d == 0 && (int32_t)(order[a] - order[b]) < 0);
+  }
+
+  void swap(uint8_t i, uint8_t j)
+  {
+    const uint8_t a = heap[i], b = heap[j];
+    heap[i] = b; heapPos[b] = i;
+    heap[j] = a; heapPos[a] = j;
+  }
+
+  void siftUp(uint8_t i)
+  {
+    while (i > 0) {
+      const uint8_t parent = (uint8_t)((i - 1) / 2);
+      if (!before(heap[i], heap[parent])) break;
+      swap(i, parent);
+      i = parent;
+    }
+  }
+
+  void siftDown(uint8_t i)
+  {
+    for (;;) {
+      const unsigned l = 2u * i + 1, r = l + 1;
+      uint8_t m = i;
+      if (l < count && before(heap[l], heap[m])) m = (uint8_t)l;
+      if (r < count && before(heap[r], heap[m])) m = (uint8_t)r;
+      if (m == i) break;
+      swap(i, m);
+      i = m;
+    }
+  }
+};
+
+#endif // OTCMDQUEUE_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
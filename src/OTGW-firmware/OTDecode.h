@@ -0,0 +1,1939 @@
+/*
+***************************************************************************
+**  Program  : OTDecode.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  The OT frame decode + publish body, moved out of OTGW-Core.ino so the
+**  host replay benchmark (tests/bench_ot_replay.cpp) runs the firmware's own
+**  hot path instead of a copy of it:
+**
+**    is_value_valid*()       ADR-096/097/103 validity and worldview gates
+**    print_*()               one decoder per OTDecodeKind, MQTT fan-out
+**    processPSSummary()      PS=1 summary lines
+**    otDecoders[],
+**    decodeAndPublishOTValue()  OTDispatch[] lookup -> decoder -> state field
+**    processOTFrame()        the raw-frame branch of processOT()
+**
+**  Not a stand-alone header. OTGW-Core.ino includes it once, in the middle
+**  of the sketch translation unit, after everything it calls: OTdata and
+**  OTlookupitem, OTcurrentSystemState, state/settings, the MQTT throttle and
+**  status fan-out, sendMQTTData*() / publishToSourceTopic*(), the WebSocket
+**  and telnet sinks, enterPSMode()/leavePSMode(). The benchmark declares
+**  host versions of those before its #include. processOT() stays in the
+**  sketch: it takes the OTStateLock, publishes the snapshot and handles the
+**  non-frame PIC lines (command responses, banners, errors).
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTDECODE_H
+#define OTDECODE_H
+
+#include "OTDispatch.h"
+#include "OTF88.h"
+#include "OTFrameParse.h"
+
+/*
+  This determines if the value in the OpenTherm message is valid and can be used in the data object, MQTT or REST API.
+  Rules are:
+  - if the message is overriden (R and A messages override B and T messages), then the value is not valid for use.
+  - if the OT message is a READ message, and the received OT msg is being read and acknowledged, then the value is valid.
+  - if the OT message is a WRITE message, and the received OT msg is being written (OT_WRITE_DATA), then the value is valid.
+  - if the OT message is a READ/WRITE message, and receive OT msg is being read and ackownledge, or, is being written, then the value is valid.
+  - if the OT message is a status message (from Heating, HAVC or Solar), then the message is always valid.
+*/
+bool is_value_valid(OpenthermData_t OT, OTlookup_t OTlookup) {
+  if (OT.skipthis) return false;
+  if (isMsgIdReservedInActiveProfile(OT.id)) return false;
+  bool _valid = false;
+  _valid = _valid || (OTlookup.msgcmd==OT_READ && OT.type==OT_READ_ACK);
+  _valid = _valid || (OTlookup.msgcmd==OT_WRITE && (OT.type==OT_WRITE_DATA || OT.type==OT_WRITE_ACK));
+  _valid = _valid || (OTlookup.msgcmd==OT_RW && (OT.type==OT_READ_ACK || OT.type==OT_WRITE_DATA || OT.type==OT_WRITE_ACK));
+  _valid = _valid || (OT.id==OT_Statusflags) || (OT.id==OT_StatusVH) || (OT.id==OT_SolarStorageMaster);;
+  return _valid;
+}
+
+// ADR-097: Master-topic validity check. Mirrors is_value_valid but excludes
+// WRITE-ACK for OT_WRITE / OT_RW messages.
+//
+// ADR-096 refines the canonical interpretation from "thermostat-side intent"
+// to "boiler-side worldview" (= the value that was actually transmitted to
+// the boiler, including any gateway override). Two additional gates implement
+// that shift:
+//   - OTGW_ANSWER_THERMOSTAT (A) frames are gateway-faked answers TO the
+//     thermostat; they never reach the boiler-side. Suppress canonical for A.
+//   - OTGW_THERMOSTAT (T) frames flagged bGatewaySubstituted=true did not
+//     reach the boiler (R replaced them). Suppress canonical for those T's;
+//     the corresponding R frame will populate canonical.
+// B frames (boiler responses) always publish to canonical regardless of
+// answer-substitution: B IS the boiler-side reality even when the gateway
+// fakes a different answer to the thermostat.
+//
+// Source-separated subtopics still use the broader is_value_valid; routing
+// across /thermostat vs /boiler is decided inside publishToSourceTopic() per
+// the ADR-096 worldview rules.
+//
+// See ADR-097 + docs/api/MQTT-message-id-echo-audit.md for the per-MsgID
+// Write-Ack classification rationale (preserved by this ADR).
+bool is_value_valid_for_master_topic(OpenthermData_t OT, OTlookup_t OTlookup) {
+  if (OT.skipthis) return false;
+  if (isMsgIdReservedInActiveProfile(OT.id)) return false;
+  // ADR-096/ADR-103 canonical = boiler-side worldview gates:
+  // ADR-103: only an answer-override A (a genuine B owns canonical) is blocked. A proxy A
+  // (no preceding B — e.g. MaxTSet/57) IS the boiler-side value and reaches canonical.
+  if (OT.rsptype == OTGW_ANSWER_THERMOSTAT && OT.bAnswerOverride) return false;
+  if (OT.rsptype == OTGW_THERMOSTAT && OT.bGatewaySubstituted) return false;
+  bool _valid = false;
+  _valid = _valid || (OTlookup.msgcmd==OT_READ && OT.type==OT_READ_ACK);
+  _valid = _valid || (OTlookup.msgcmd==OT_WRITE && OT.type==OT_WRITE_DATA);
+  _valid = _valid || (OTlookup.msgcmd==OT_RW && (OT.type==OT_READ_ACK || OT.type==OT_WRITE_DATA));
+  _valid = _valid || (OT.id==OT_Statusflags) || (OT.id==OT_StatusVH) || (OT.id==OT_SolarStorageMaster);
+  return _valid;
+}
+
+// ADR-097 (PS=1 amendment, TASK-483 ACs #8-#13): The PS=1 summary stream emits
+// one value per MsgID, chosen by the PIC from its most recent observation.
+// For OT_WRITE / OT_RW MsgIDs whose slave Write-Ack data byte is per-spec
+// undefined (bSlaveEchoesValue=false in OTmap[]), the PIC may have captured
+// either the meaningful Write-Data or the undefined Write-Ack byte; the PS=1
+// stream cannot distinguish these at this layer. For those MsgIDs we suppress
+// base-topic publication and state-write so the master-topic invariant holds
+// across both the live OT-bus path and the PS=1 path. READ messages are
+// always meaningful (slave's Read-Ack carries the value). Status-flag MsgIDs
+// (Statusflags / StatusVH) are handled inside ot_flag8flag8 with their own
+// per-MsgID switch and are not gated here.
+static bool is_msgid_valid_for_master_topic_in_ps_summary(const OTlookup_t &lookup)
+{
+  if (lookup.msgcmd == OT_READ) return true;
+  return lookup.bSlaveEchoesValue;
+}
+
+//===================[ OT Message Field Formatters ]=========
+
+void print_f88(float& value)
+{
+  // Two decimals, like this: x.xx. Integer from the data bytes (OTF88.h);
+  // same text and stored value as roundf(f88 * 100) / 100 + dtostrf().
+  const int16_t _centi = otF88ToCenti(otF88FromBytes(OTdata.valueHB, OTdata.valueLB));
+  const float _value = (float)_centi / 100.0f;
+  char _msg[OT_F88_TEXT_LEN] {0};
+  otFormatCenti(_centi, _msg, sizeof(_msg));
+
+  // ADR-097: gate log decode + state write on master-topic validity. The protocol
+  // event stays visible (timestamp/source/msgid/type/indicator are added in processOT);
+  // only the per-spec-undefined Write-Ack data byte is suppressed from log + REST state.
+  const bool validForMaster = is_value_valid_for_master_topic(OTdata, OTlookupitem);
+  if (validForMaster) {
+    AddLogf("%s = %s %s", OTlookupitem.label, _msg, OTlookupitem.unit);
+  } else {
+    AddLogf("%s", OTlookupitem.label);
+  }
+
+  // ADR-118: capture gateway-injected override (additive; does NOT affect canonical).
+  // Gated on the explicit suppression flags only, NOT !validForMaster (which is also
+  // false for non-override reasons). Pure RAM write — no MQTT publish, no yield.
+  if ((OTdata.rsptype == OTGW_ANSWER_THERMOSTAT) && OTdata.bAnswerOverride) {
+    recordOTOverride(OTdata.id, OT_OVERRIDE_ANSWER, _value);
+  } else if ((OTdata.rsptype == OTGW_THERMOSTAT) && OTdata.bGatewaySubstituted) {
+    recordOTOverride(OTdata.id, OT_OVERRIDE_SUBSTITUTED, _value);
+  }
+
+  //SendMQTT
+  if (is_value_valid(OTdata, OTlookupitem)){
+    if (validForMaster) sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_NONE, _msg);
+    publishToSourceTopicForId(OTdata.id, MQTT_TOPIC_SFX_NONE, _msg, OTdata.rsptype);
+    if (validForMaster) value = _value;
+  }
+}
+
+
+void print_s16(int16_t& value)
+{
+  int16_t _value = OTdata.s16();
+  // AddLogf("%s = %5d %s", OTlookupitem.label, _value, OTlookupitem.unit);
+  //Build string for MQTT
+  char _msg[15] {0};
+  itoa(_value, _msg, 10);
+
+  // ADR-097: gate log decode + state write on master-topic validity (see print_f88).
+  const bool validForMaster = is_value_valid_for_master_topic(OTdata, OTlookupitem);
+  if (validForMaster) {
+    AddLogf("%s = %s %s", OTlookupitem.label, _msg, OTlookupitem.unit);
+  } else {
+    AddLogf("%s", OTlookupitem.label);
+  }
+
+  //SendMQTT
+  if (is_value_valid(OTdata, OTlookupitem)){
+    if (validForMaster) sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_NONE, _msg);
+    publishToSourceTopicForId(OTdata.id, MQTT_TOPIC_SFX_NONE, _msg, OTdata.rsptype);
+    if (validForMaster) value = _value;
+  }
+}
+
+void print_s8s8(uint16_t& value)
+{
+  // ADR-097: gate log decode + state write on master-topic validity (see print_f88).
+  const bool validForMaster = is_value_valid_for_master_topic(OTdata, OTlookupitem);
+  if (validForMaster) {
+    AddLogf("%s = %3d / %3d %s", OTlookupitem.label, (int8_t)OTdata.valueHB, (int8_t)OTdata.valueLB, OTlookupitem.unit);
+  } else {
+    AddLogf("%s", OTlookupitem.label);
+  }
+
+  //Build string for MQTT
+  char _msg[15] {0};
+  itoa((int8_t)OTdata.valueHB, _msg, 10);
+  //AddLogf("%s = %s %s", OTlookupitem.label, _msg, OTlookupitem.unit);
+  const bool _valid = is_value_valid(OTdata, OTlookupitem);
+  if (_valid){
+    if (validForMaster) sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_VALUE_HB, _msg);
+    publishToSourceTopicForId(OTdata.id, MQTT_TOPIC_SFX_VALUE_HB, _msg, OTdata.rsptype);
+  }
+  //Build string for MQTT
+  itoa((int8_t)OTdata.valueLB, _msg, 10);
+  //AddLogf("%s = %s %s", OTlookupitem.label, _msg, OTlookupitem.unit);
+  if (_valid){
+    if (validForMaster) sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_VALUE_LB, _msg);
+    publishToSourceTopicForId(OTdata.id, MQTT_TOPIC_SFX_VALUE_LB, _msg, OTdata.rsptype);
+    if (validForMaster) value = OTdata.u16();
+  }
+}
+
+void print_u16(uint16_t& value)
+{
+  uint16_t _value = OTdata.u16();
+  //Build string for MQTT
+  char _msg[15] {0};
+  utoa(_value, _msg, 10);
+
+  // ADR-097: gate log decode + state write on master-topic validity (see print_f88).
+  const bool validForMaster = is_value_valid_for_master_topic(OTdata, OTlookupitem);
+  if (validForMaster) {
+    AddLogf("%s = %s %s", OTlookupitem.label, _msg, OTlookupitem.unit);
+  } else {
+    AddLogf("%s", OTlookupitem.label);
+  }
+
+  //SendMQTT
+  if (is_value_valid(OTdata, OTlookupitem)){
+    if (validForMaster) sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_NONE, _msg);
+    publishToSourceTopicForId(OTdata.id, MQTT_TOPIC_SFX_NONE, _msg, OTdata.rsptype);
+    if (validForMaster) value = _value;
+  }
+}
+
+void print_status(uint16_t& value)
+{
+  char _flag8_master[9] {0};
+  char _flag8_slave[9] {0};
+  
+  if (OTdata.masterslave == 0) {
+    // Parse master bits
+    //bit: [clear/0, set/1]
+    //  0: CH enable [ CH is disabled, CH is enabled]
+    //  1: DHW enable [ DHW is disabled, DHW is enabled]
+    //  2: Cooling enable [ Cooling is disabled, Cooling is enabled]]
+    //  3: OTC active [OTC not active, OTC is active]
+    //  4: CH2 enable [CH2 is disabled, CH2 is enabled]
+    //  5: Summer/winter mode [Summertime, Wintertime]
+    //  6: DHW blocking [ DHW not blocking, DHW blocking ]
+    //  7: reserved
+    _flag8_master[0] = (((OTdata.valueHB) & 0x01) ? 'C' : '-');
+    _flag8_master[1] = (((OTdata.valueHB) & 0x02) ? 'D' : '-');
+    _flag8_master[2] = (((OTdata.valueHB) & 0x04) ? 'C' : '-'); 
+    _flag8_master[3] = (((OTdata.valueHB) & 0x08) ? 'O' : '-');
+    _flag8_master[4] = (((OTdata.valueHB) & 0x10) ? '2' : '-'); 
+    _flag8_master[5] = (((OTdata.valueHB) & 0x20) ? 'S' : 'W'); 
+    _flag8_master[6] = (((OTdata.valueHB) & 0x40) ? 'B' : '-'); 
+    _flag8_master[7] = (((OTdata.valueHB) & 0x80) ? '.' : '-');
+    _flag8_master[8] = '\0';
+
+    AddLog(" ");
+    AddLog(OTlookupitem.label);
+    AddLogf(" = Master [%s]", _flag8_master);
+
+    //Master Status — ADR-069 boiler-side worldview: suppress canonical for
+    //gateway-substituted T-frames so the HW override is reflected in dhw_enable.
+    if (is_value_valid_for_master_topic(OTdata, OTlookupitem)){
+      publishMasterStatusState(OTdata.valueHB, _flag8_master);
+    }
+  } else {
+    // Parse slave bits
+    //  0: fault indication [ no fault, fault ]
+    //  1: CH mode [CH not active, CH active]
+    //  2: DHW mode [ DHW not active, DHW active]
+    //  3: Flame status [ flame off, flame on ]
+    //  4: Cooling status [ cooling mode not active, cooling mode active ]
+    //  5: CH2 mode [CH2 not active, CH2 active]
+    //  6: diagnostic indication [no diagnostics, diagnostic event]
+    //  7: Electricity production [no electric production, electric production]
+    _flag8_slave[0] = (((OTdata.valueLB) & 0x01) ? 'E' : '-');
+    _flag8_slave[1] = (((OTdata.valueLB) & 0x02) ? 'C' : '-'); 
+    _flag8_slave[2] = (((OTdata.valueLB) & 0x04) ? 'W' : '-'); 
+    _flag8_slave[3] = (((OTdata.valueLB) & 0x08) ? 'F' : '-'); 
+    _flag8_slave[4] = (((OTdata.valueLB) & 0x10) ? 'C' : '-'); 
+    _flag8_slave[5] = (((OTdata.valueLB) & 0x20) ? '2' : '-'); 
+    _flag8_slave[6] = (((OTdata.valueLB) & 0x40) ? 'D' : '-'); 
+    _flag8_slave[7] = (((OTdata.valueLB) & 0x80) ? 'P' : '-');
+    _flag8_slave[8] = '\0';
+
+    AddLog(" ");
+    AddLog(OTlookupitem.label);
+    AddLogf(" = Slave  [%s]", _flag8_slave);
+    
+    //Slave Status — ADR-069 boiler-side worldview: suppress canonical for
+    //gateway-faked A-frames so the boiler's true DHW mode is what we publish.
+    if (is_value_valid_for_master_topic(OTdata, OTlookupitem)){
+      publishSlaveStatusState(OTdata.valueLB, _flag8_slave);
+    }
+  }
+
+  if (is_value_valid_for_master_topic(OTdata, OTlookupitem)){
+    // AddLogf("Status u16 [%04x] _value [%04x] hb [%02x] lb [%02x]", OTdata.u16(), _value, OTdata.valueHB, OTdata.valueLB);
+    value = (OTcurrentSystemState.MasterStatus<<8) | OTcurrentSystemState.SlaveStatus;
+  }
+}
+
+void print_solar_storage_status(uint16_t& value)
+{ 
+  char _msg[15] {0};
+
+  if (OTdata.masterslave == 0) {
+    // Master Solar Storage 
+    // ID101:HB012: Master Solar Storage: Solar mode
+    uint8_t MasterSolarMode = (OTdata.valueHB) & 0x7;
+    AddLogf("%s = Solar Storage Master Mode [%d] ", OTlookupitem.label, MasterSolarMode);
+    if (is_value_valid(OTdata, OTlookupitem)){
+      sendMQTTData(F("solar_storage_master_mode"), itoa(MasterSolarMode, _msg, 10));  //delayms(5);
+      OTcurrentSystemState.SolarMasterStatus = OTdata.valueHB;
+    }
+  } else { 
+    //Slave
+    // ID101:LB0: Slave Solar Storage: Fault indication
+    uint8_t SlaveSolarFaultIndicator =  (OTdata.valueLB) & 0x01;
+    // ID101:LB123: Slave Solar Storage: Solar mode status
+    uint8_t SlaveSolarModeStatus = (OTdata.valueLB>>1) & 0x07;
+    // ID101:LB45: Slave Solar Storage: Solar status
+    uint8_t SlaveSolarStatus = (OTdata.valueLB>>4)& 0x03;
+    AddLogf("\r\n%s = Slave Solar Fault Indicator [%d] ", OTlookupitem.label, SlaveSolarFaultIndicator);
+    AddLogf("\r\n%s = Slave Solar Mode Status [%d] ", OTlookupitem.label, SlaveSolarModeStatus);
+    AddLogf("\r\n%s = Slave Solar Status [%d] ", OTlookupitem.label, SlaveSolarStatus);
+    if (is_value_valid(OTdata, OTlookupitem)){
+      // ADR-106: pick legacy vs new label.
+      sendMQTTData(settings.mqtt.bUseLegacyOtTopics ? F("solar_storage_slave_fault_indicator")
+                                                    : F("solar_storage_fault"),
+                   ((SlaveSolarFaultIndicator) ? "ON" : "OFF"));
+      sendMQTTData(F("solar_storage_mode_status"), itoa(SlaveSolarModeStatus, _msg, 10));  
+      sendMQTTData(F("solar_storage_slave_status"), itoa(SlaveSolarStatus, _msg, 10));  
+      OTcurrentSystemState.SolarSlaveStatus = OTdata.valueLB;
+    }
+  }
+  if (is_value_valid(OTdata, OTlookupitem)){
+    //OTDebugTf(PSTR("Solar Storage Master / Slave Mode u16 [%04x] _value [%04x] hb [%02x] lb [%02x]"), OTdata.u16(), _value, OTdata.valueHB, OTdata.valueLB);
+    value = (OTcurrentSystemState.SolarMasterStatus<<8) | OTcurrentSystemState.SolarSlaveStatus;
+  }
+}
+
+void print_statusVH(uint16_t& value)
+{ 
+  char _flag8_master[9] {0};
+  char _flag8_slave[9] {0};
+
+  if (OTdata.masterslave == 0){
+      
+    // Parse master bits
+    //bit: [clear/0, set/1]
+    // ID70:HB0: Master status ventilation / heat-recovery: Ventilation enable
+    // ID70:HB1: Master status ventilation / heat-recovery: Bypass postion
+    // ID70:HB2: Master status ventilation / heat-recovery: Bypass mode
+    // ID70:HB3: Master status ventilation / heat-recovery: Free ventilation mode
+    //  4: reserved
+    //  5: reserved
+    //  6: reserved
+    //  7: reserved
+    _flag8_master[0] = (((OTdata.valueHB) & 0x01) ? 'V' : '-');
+    _flag8_master[1] = (((OTdata.valueHB) & 0x02) ? 'P' : '-');
+    _flag8_master[2] = (((OTdata.valueHB) & 0x04) ? 'M' : '-'); 
+    _flag8_master[3] = (((OTdata.valueHB) & 0x08) ? 'F' : '-');
+    _flag8_master[4] = (((OTdata.valueHB) & 0x10) ? '.' : '-'); 
+    _flag8_master[5] = (((OTdata.valueHB) & 0x20) ? '.' : '-'); 
+    _flag8_master[6] = (((OTdata.valueHB) & 0x40) ? '.' : '-'); 
+    _flag8_master[7] = (((OTdata.valueHB) & 0x80) ? '.' : '-');
+    _flag8_master[8] = '\0';
+
+    
+    AddLogf("%s = VH Master [%s]", OTlookupitem.label, _flag8_master);
+    //Master Status
+    if (is_value_valid(OTdata, OTlookupitem)){
+      publishMasterStatusVHState(OTdata.valueHB, _flag8_master);
+    }
+  } else {
+    // Parse slave bits
+    // ID70:LB0: Slave status ventilation / heat-recovery: Fault indication
+    // ID70:LB1: Slave status ventilation / heat-recovery: Ventilation mode
+    // ID70:LB2: Slave status ventilation / heat-recovery: Bypass status
+    // ID70:LB3: Slave status ventilation / heat-recovery: Bypass automatic status
+    // ID70:LB4: Slave status ventilation / heat-recovery: Free ventilation status
+    // ID70:LB6: Slave status ventilation / heat-recovery: Diagnostic indication
+    _flag8_slave[0] = (((OTdata.valueLB) & 0x01) ? 'F' : '-');
+    _flag8_slave[1] = (((OTdata.valueLB) & 0x02) ? 'V' : '-'); 
+    _flag8_slave[2] = (((OTdata.valueLB) & 0x04) ? 'P' : '-'); 
+    _flag8_slave[3] = (((OTdata.valueLB) & 0x08) ? 'A' : '-'); 
+    _flag8_slave[4] = (((OTdata.valueLB) & 0x10) ? 'F' : '-'); 
+    _flag8_slave[5] = (((OTdata.valueLB) & 0x20) ? '.' : '-');
+    _flag8_slave[6] = (((OTdata.valueLB) & 0x40) ? 'D' : '-'); 
+    _flag8_slave[7] = (((OTdata.valueLB) & 0x80) ? '.' : '-');
+    _flag8_slave[8] = '\0';
+
+    
+    AddLogf("%s = VH Slave  [%s]", OTlookupitem.label, _flag8_slave);
+
+    //Slave Status
+    if (is_value_valid(OTdata, OTlookupitem)){
+      publishSlaveStatusVHState(OTdata.valueLB, _flag8_slave);
+    }
+  }
+
+  if (is_value_valid(OTdata, OTlookupitem)){
+    //OTDebugTf(PSTR("Status u16 [%04x] _value [%04x] hb [%02x] lb [%02x]"), OTdata.u16(), _value, OTdata.valueHB, OTdata.valueLB);
+    value = (OTcurrentSystemState.MasterStatusVH<<8) | OTcurrentSystemState.SlaveStatusVH;
+  }
+}
+
+
+void print_ASFflags(uint16_t& value)
+{
+  AddLogf("%s = ASF flags[%s] OEM faultcode [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
+
+  if (is_value_valid(OTdata, OTlookupitem)){
+    // TASK-401: gate ASF_flags byte-topic + 6 bit-topics on first-seen + change + 60s heartbeat.
+    // Previous byte value lives in `value` (uint16_t& ref to OTcurrentSystemState.ASFflags).
+    const uint8_t prevHB = (uint8_t)((value >> 8) & 0xFF);
+    const uint8_t newHB  = OTdata.valueHB;
+    //Application Specific Fault (byte, gated)
+    publishGatedByteMQTT(mqttlastsentASFbyte, 0, F("ASF_flags"), byte_to_binary(newHB), newHB, prevHB);
+    //OEM fault code — numeric value, not a bit; left raw (low publish cost vs HA wants fresh code)
+    char _msg[15] {0};
+    utoa(OTdata.valueLB, _msg, 10);
+    sendMQTTData(F("OEMFaultCode"), _msg);
+
+    //bit: [clear/0, set/1]
+    //0: Service request [service not req’d, service required]
+    //1: Lockout-reset [ remote reset disabled, rr enabled]
+    //2: Low water press [ no WP fault, water pressure fault]
+    //3: Gas/flame fault [ no G/F fault, gas/flame fault ]
+    //4: Air press fault [ no AP fault, air pressure fault ]
+    //5: Water over-temp[ no OvT fault, over-temperat. Fault]
+    //6: reserved
+    //7: reserved
+    publishGatedBitMQTT(mqttlastsentASFbit, 0, F("service_request"),        (newHB & 0x01), (prevHB & 0x01), F("service_required"));
+    publishGatedBitMQTT(mqttlastsentASFbit, 1, F("lockout_reset"),          (newHB & 0x02), (prevHB & 0x02), F("supports_lockout_reset"));
+    publishGatedBitMQTT(mqttlastsentASFbit, 2, F("low_water_pressure"),     (newHB & 0x04), (prevHB & 0x04));
+    publishGatedBitMQTT(mqttlastsentASFbit, 3, F("gas_flame_fault"),        (newHB & 0x08), (prevHB & 0x08), F("gas_fault"));
+    publishGatedBitMQTT(mqttlastsentASFbit, 4, F("air_pressure_fault"),     (newHB & 0x10), (prevHB & 0x10));
+    publishGatedBitMQTT(mqttlastsentASFbit, 5, F("water_over_temperature"), (newHB & 0x20), (prevHB & 0x20), F("water_overtemperature"));
+    value = OTdata.u16();
+  }
+}
+
+void print_RBPflags(uint16_t& value)
+{
+  AddLogf("%s = M[%s] OEM fault code [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
+  if (is_value_valid(OTdata, OTlookupitem)){
+    // TASK-401: extract previous HB/LB so publishRBPFlagsState can gate per-bit vs last frame.
+    const uint8_t prevTransfer  = (uint8_t)((value >> 8) & 0xFF);
+    const uint8_t prevReadWrite = (uint8_t)(value & 0xFF);
+    value = publishRBPFlagsState(OTdata.valueHB, OTdata.valueLB, prevTransfer, prevReadWrite);
+  }
+}
+
+void print_slavememberid(uint16_t& value)
+{
+  AddLogf("%s = Slave Config[%s] MemberID code [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
+  if (is_value_valid(OTdata, OTlookupitem)){
+    //Build string for SendMQTT
+    sendMQTTData(F("slave_configuration"), byte_to_binary(OTdata.valueHB));
+    char _msg[15] {0};
+    utoa(OTdata.valueLB, _msg, 10);
+    sendMQTTData(F("slave_memberid_code"), _msg);
+
+    
+    // bit: description  [ clear/0, set/1] 
+    // 0:  DHW present  [ dhw not present, dhw is present ] 
+    // 1:  Control type  [ modulating, on/off ] 
+    // 2:  Cooling config  [ cooling not supported,  
+    //     cooling supported] 
+    // 3:  DHW config  [instantaneous or not-specified, 
+    //     storage tank] 
+    // 4:  Master low-off&pump control function [allowed, 
+    //     not allowed] 
+    // 5:  CH2 present  [CH2 not present, CH2 present]
+    // 6:  Remote water filling function
+    //     NOTE: pyotgw / HA core's opentherm_gw integration names this bit
+    //     DATA_SLAVE_REMOTE_RESET. The OpenTherm 2.2 spec and this firmware's
+    //     label call it "remote_water_filling_function". Both refer to the
+    //     same wire bit (MsgID 3, HB bit 6); HA-side discovery parity is
+    //     audited in docs/audits/2026-05-21-ha-capability-flags-feature-2.0.0.md (TASK-650).
+    // 7:  Heat/cool mode control
+
+    // ADR-106: pick legacy vs new label per bit. Heat_cool_mode_control (HB7) has no alias and always publishes its legacy name.
+    {
+      const bool useLegacy = settings.mqtt.bUseLegacyOtTopics;
+      sendMQTTData(useLegacy ? F("dhw_present")                          : F("supports_hot_water"),     (((OTdata.valueHB) & 0x01) ? "ON" : "OFF"));
+      sendMQTTData(useLegacy ? F("control_type_modulation")              : F("control_type"),           (((OTdata.valueHB) & 0x02) ? "ON" : "OFF"));
+      sendMQTTData(useLegacy ? F("cooling_config")                       : F("supports_cooling"),       (((OTdata.valueHB) & 0x04) ? "ON" : "OFF"));
+      sendMQTTData(useLegacy ? F("dhw_config")                           : F("hot_water_config"),       (((OTdata.valueHB) & 0x08) ? "ON" : "OFF"));
+      sendMQTTData(useLegacy ? F("master_low_off_pump_control_function") : F("supports_pump_control"),  (((OTdata.valueHB) & 0x10) ? "ON" : "OFF"));
+      sendMQTTData(useLegacy ? F("ch2_present")                          : F("supports_ch_2"),          (((OTdata.valueHB) & 0x20) ? "ON" : "OFF"));
+      sendMQTTData(useLegacy ? F("remote_water_filling_function")        : F("supports_remote_reset"),  (((OTdata.valueHB) & 0x40) ? "ON" : "OFF"));
+      sendMQTTData(F("heat_cool_mode_control"),                                                          (((OTdata.valueHB) & 0x80) ? "ON" : "OFF"));
+    }
+    // SAT heating-source detect (TASK-943): MsgID 3 HB bit2 = "cooling supported".
+    // NON-CONTROL telemetry hint only — surfaced as heating_source_detected for the UI.
+    // Control authority is the manual satsource setting; satGetEffectiveHeatingSource()
+    // resolves AUTO to a safe gas-boiler default. OpenTherm has no source-class field
+    // (spec v4.2:1606), so cooling-capable is a lossy proxy (heating-only heat pumps do
+    // not set it; hybrid is invisible on one OT bus) — never drive control off this bit.
+    state.sat.iDetectedHeatingSource = ((OTdata.valueHB) & 0x04) ? SAT_SRC_HEAT_PUMP : SAT_SRC_GAS_BOILER;
+    // SAT: auto-detect manufacturer from slave MemberID code
+    satDetectManufacturer(OTdata.valueLB);
+    value = OTdata.u16();
+  }
+}
+
+void print_mastermemberid(uint16_t& value)
+{
+  AddLogf("%s = Master Config[%s] MemberID code [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
+  if (is_value_valid(OTdata, OTlookupitem)){
+    //Build string for MQTT
+    char _msg[15] {0};
+    sendMQTTData(F("master_configuration"), byte_to_binary(OTdata.valueHB));
+    // ADR-106: pick legacy vs new label.
+    sendMQTTData(settings.mqtt.bUseLegacyOtTopics ? F("master_configuration_smart_power")
+                                                  : F("supports_master_smart_power"),
+                 (((OTdata.valueHB) & 0x01) ? "ON" : "OFF"));  
+    
+    utoa(OTdata.valueLB, _msg, 10);
+    sendMQTTData(F("master_memberid_code"), _msg);
+    value = OTdata.u16();
+  }
+}
+
+void print_vh_configmemberid(uint16_t& value)
+{
+  AddLogf("%s = VH Config[%s] MemberID code [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
+  if (is_value_valid(OTdata, OTlookupitem)){
+    //Build string for MQTT
+    char _msg[15] {0};
+    sendMQTTData(F("vh_configuration"), byte_to_binary(OTdata.valueHB)); 
+    // ADR-106: pick legacy vs new label per bit.
+    {
+      const bool useLegacy = settings.mqtt.bUseLegacyOtTopics;
+      sendMQTTData(useLegacy ? F("vh_configuration_system_type")   : F("ventilation_system_type"),         (((OTdata.valueHB) & 0x01) ? "ON" : "OFF"));
+      sendMQTTData(useLegacy ? F("vh_configuration_bypass")        : F("supports_ventilation_bypass"),     (((OTdata.valueHB) & 0x02) ? "ON" : "OFF"));
+      sendMQTTData(useLegacy ? F("vh_configuration_speed_control") : F("ventilation_speed_control_type"),  (((OTdata.valueHB) & 0x04) ? "ON" : "OFF"));
+    }
+    // NOTE (TASK-943): heating-source detection was previously (and wrongly) keyed off
+    // this MsgID 74 ventilation bit0. It now lives in the MsgID 3 slave-config handler
+    // (cooling bit2) as a non-control hint. This handler decodes ventilation config only.
+    utoa(OTdata.valueLB, _msg, 10);
+    sendMQTTData(F("vh_memberid_code"), _msg);
+    value = OTdata.u16();
+  }
+}
+
+void print_solarstorage_slavememberid(uint16_t& value)
+{
+  AddLogf("%s = Solar Storage Slave Config[%s] MemberID code [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
+  if (is_value_valid(OTdata, OTlookupitem)){
+     //Build string for SendMQTT
+    sendMQTTData(F("solar_storage_slave_configuration"), byte_to_binary(OTdata.valueHB));
+    char _msg[15] {0};
+    utoa(OTdata.valueLB, _msg, 10);
+    sendMQTTData(F("solar_storage_slave_memberid_code"), _msg);
+
+    //ID103:HB0: Slave Configuration Solar Storage: System type1
+    sendMQTTData(F("solar_storage_system_type"),    (((OTdata.valueHB) & 0x01) ? "ON" : "OFF"));  
+    value = OTdata.u16();
+  }
+}
+
+void print_remoteoverridefunction(uint16_t& value)
+{
+// MsdID 100 Remote override room setpoint 
+// LB: Remote override function 
+// bit: description  [ clear/0, set/1] 
+// 0:  Manual change priority [disable overruling remote 
+//     setpoint by manual setpoint change, enable overruling 
+//     remote setpoint by manual setpoint change ] 
+// 1:  Program change priority [disable overruling remote 
+//     setpoint by program setpoint change, enable overruling 
+//     remote setpoint by program setpoint change ] 
+// 2:  reserved  
+// 3:  reserved 
+// 4:  reserved 
+// 5:  reserved 
+// 6:  reserved 
+// 7:  reserved 
+// HB: reserved 
+  
+  AddLogf("%s = flag8 = [%s] - decimal = [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueLB), OTdata.valueLB);
+
+  if (is_value_valid(OTdata, OTlookupitem)){
+    // TASK-401: gate <msgid>_flag8 byte + 2 bit-topics. Remote Override msgId 100
+    // stores full u16 in `value`; LB holds the flag byte (HB is reserved).
+    const uint8_t prevLB = (uint8_t)(value & 0xFF);
+    const uint8_t newLB  = OTdata.valueLB;
+    //Build string for MQTT
+    otTopic[0] = '\0';
+    //flag8 value
+    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
+    strlcat(otTopic, "_flag8", sizeof(otTopic));
+    publishGatedByteMQTT(mqttlastsentRObyte, 0, otTopic, byte_to_binary(newLB), newLB, prevLB);
+    //report remote override flags to MQTT
+    publishGatedBitMQTT(mqttlastsentRObit, 0, F("remote_override_manual_change_priority"),
+                        (newLB & 0x01), (prevLB & 0x01),
+                        F("override_manual_change_prio"));
+    publishGatedBitMQTT(mqttlastsentRObit, 1, F("remote_override_program_change_priority"),
+                        (newLB & 0x02), (prevLB & 0x02),
+                        F("override_program_change_prio"));
+    value = OTdata.u16();
+  }
+}
+
+void print_flag8u8(uint16_t& value)
+{
+  AddLogf("%s = M[%s] - [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
+
+  if (is_value_valid(OTdata, OTlookupitem)){
+    //Build string for MQTT
+    otTopic[0] = '\0';
+    //flag8 value
+    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
+    strlcat(otTopic, "_flag8", sizeof(otTopic));
+    sendMQTTData(otTopic, byte_to_binary(OTdata.valueHB));
+    //u8 value
+    char _msg[15] {0};
+    utoa(OTdata.valueLB, _msg, 10);
+    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
+    strlcat(otTopic, "_code", sizeof(otTopic));
+    sendMQTTData(otTopic, _msg);
+    value = OTdata.u16(); 
+  }
+}
+
+void print_vh_remoteparametersetting(uint16_t& value)
+{ 
+  //Build string for MQTT
+  otTopic[0] = '\0';
+  //flag8 valueHB
+  
+  AddLogf("%s = HB flag8[%s] -[%3d] ", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueHB);
+  if (is_value_valid(OTdata, OTlookupitem)){
+    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
+    strlcat(otTopic, "_hb_flag8", sizeof(otTopic));
+    sendMQTTData(otTopic, byte_to_binary(OTdata.valueHB));
+    sendMQTTData(F("vh_transfer_enable_nominal_ventilation_value"),    (((OTdata.valueHB) & 0x01) ? "ON" : "OFF"));
+  }
+  //flag8 valueLB
+  AddLogf("%s = LB flag8[%s] - [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueLB), OTdata.valueLB);
+  if (is_value_valid(OTdata, OTlookupitem)){
+    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
+    strlcat(otTopic, "_lb_flag8", sizeof(otTopic));
+    sendMQTTData(otTopic, byte_to_binary(OTdata.valueLB));
+    sendMQTTData(F("vh_rw_nominal_ventilation_value"),    (((OTdata.valueLB) & 0x01) ? "ON" : "OFF"));
+    value = OTdata.u16();
+  }
+}
+
+void print_command(uint16_t& value)
+{ 
+  //Known Commands
+  // ID4 (HB=1): Remote Request Boiler Lockout-reset
+  // ID4 (HB=2): Remote Request Water filling
+  // ID4 (HB=10): Remote Request Service request reset
+  
+  AddLogf("%s = %3d / %3d %s", OTlookupitem.label, (uint8_t)OTdata.valueHB, (uint8_t)OTdata.valueLB, OTlookupitem.unit);
+  if (is_value_valid(OTdata, OTlookupitem)){
+    //Build string for MQTT
+    otTopic[0] = '\0';
+    char _msg[10] {0};
+    //flag8 valueHB
+    utoa((OTdata.valueHB), _msg, 10);
+    //AddLogf("%s = HB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueHB);
+    sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_HB_U8, _msg);
+    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
+    strlcat(otTopic, "_remote_command", sizeof(otTopic));
+    switch (OTdata.valueHB) {
+      case 1: sendMQTTData(otTopic, "Remote Request Boiler Lockout-reset");  AddLogf("\r\n%s = remote command [%s]", OTlookupitem.label, "Remote Request Boiler Lockout-reset"); break;
+      case 2: sendMQTTData(otTopic, "Remote Request Water filling"); AddLogf("\r\n%s = remote command [%s]", OTlookupitem.label, "Remote Request Water filling"); break;
+      case 10: sendMQTTData(otTopic, "Remote Request Service request reset");  AddLogf("\r\n%s = remote command [%s]", OTlookupitem.label, "Remote Request Service request reset");break;
+      default: sendMQTTData(otTopic, "Unknown command"); AddLogf("\r\n%s = remote command [%s]", OTlookupitem.label, "Unknown command");break;
+    } 
+
+    //flag8 valueLB
+    utoa((OTdata.valueLB), _msg, 10);
+    //AddLogf("%s = LB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueLB);
+    sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_LB_U8, _msg);
+    value = OTdata.u16();
+  }
+}
+
+void print_u8u8(uint16_t& value)
+{ 
+  
+  AddLogf("%s = %3d / %3d %s", OTlookupitem.label, (uint8_t)OTdata.valueHB, (uint8_t)OTdata.valueLB, OTlookupitem.unit);
+
+  if (is_value_valid(OTdata, OTlookupitem)){
+    //Build string for MQTT
+    char _msg[10] {0};
+    //flag8 valueHB
+    utoa((OTdata.valueHB), _msg, 10);
+    //AddLogf("%s = HB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueHB);
+    sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_HB_U8, _msg);
+    //flag8 valueLB
+    utoa((OTdata.valueLB), _msg, 10);
+    //AddLogf("%s = LB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueLB);
+    sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_LB_U8, _msg);
+    value = OTdata.u16();
+  }
+}
+
+static void publish_u8_alias_topics()
+{
+  char _msg[10] {0};
+  const bool validForMaster = is_value_valid_for_master_topic(OTdata, OTlookupitem);
+
+  utoa(OTdata.valueHB, _msg, 10);
+  if (validForMaster) sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_HB_U8, _msg);
+  publishToSourceTopicForId(OTdata.id, MQTT_TOPIC_SFX_HB_U8, _msg, OTdata.rsptype);
+
+  utoa(OTdata.valueLB, _msg, 10);
+  if (validForMaster) sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_LB_U8, _msg);
+  publishToSourceTopicForId(OTdata.id, MQTT_TOPIC_SFX_LB_U8, _msg, OTdata.rsptype);
+}
+
+static void print_u8_single(uint16_t& value, bool useHB)
+{
+  const uint8_t activeByte = useHB ? OTdata.valueHB : OTdata.valueLB;
+  const uint8_t reservedByte = useHB ? OTdata.valueLB : OTdata.valueHB;
+  const char activeByteName0 = useHB ? 'H' : 'L';
+  const char activeByteName1 = 'B';
+  const char reservedByteName0 = useHB ? 'L' : 'H';
+  const char reservedByteName1 = 'B';
+
+  AddLogf_P(PSTR("%s = %3u %s (%c%c used, %c%c=%u)"),
+            OTlookupitem.label,
+            activeByte,
+            OTlookupitem.unit,
+            activeByteName0, activeByteName1,
+            reservedByteName0, reservedByteName1,
+            reservedByte);
+
+  if (is_value_valid(OTdata, OTlookupitem)){
+    char _msg[10] {0};
+    utoa(activeByte, _msg, 10);
+    if (is_value_valid_for_master_topic(OTdata, OTlookupitem)) sendMQTTDataForId(OTdata.id, MQTT_TOPIC_SFX_NONE, _msg);
+    publishToSourceTopicForId(OTdata.id, MQTT_TOPIC_SFX_NONE, _msg, OTdata.rsptype);
+
+    // Backward compatibility for earlier generic u8u8 decoding.
+    publish_u8_alias_topics();
+    value = activeByte;
+  }
+}
+
+void print_u8_hb(uint16_t& value)
+{
+  print_u8_single(value, true);
+}
+
+void print_u8_lb(uint16_t& value)
+{
+  print_u8_single(value, false);
+}
+
+static PGM_P rfSensorTypeToString_P(uint8_t code)
+{
+  switch (code) {
+    case 0x0: return PSTR("room_temperature_controller");
+    case 0x1: return PSTR("room_temperature_sensor");
+    case 0x2: return PSTR("outside_temperature_sensor");
+    case 0xF: return PSTR("not_defined_type");
+    default:  return PSTR("reserved");
+  }
+}
+
+static PGM_P rfBatteryIndicationToString_P(uint8_t code)
+{
+  switch (code) {
+    case 0x0: return PSTR("no_indication");
+    case 0x1: return PSTR("low_battery");
+    case 0x2: return PSTR("nearly_low_battery");
+    case 0x3: return PSTR("battery_ok");
+    default:  return PSTR("reserved");
+  }
+}
+
+static PGM_P rfSignalStrengthToString_P(uint8_t code)
+{
+  switch (code) {
+    case 0x0: return PSTR("no_indication");
+    case 0x1: return PSTR("strength_1_weak");
+    case 0x2: return PSTR("strength_2");
+    case 0x3: return PSTR("strength_3");
+    case 0x4: return PSTR("strength_4");
+    case 0x5: return PSTR("strength_5_perfect");
+    default:  return PSTR("reserved");
+  }
+}
+
+static PGM_P heatingOverrideModeToString_P(uint8_t code)
+{
+  switch (code) {
+    case 0: return PSTR("no_override");
+    case 1: return PSTR("auto");
+    case 2: return PSTR("comfort");
+    case 3: return PSTR("precomfort");
+    case 4: return PSTR("reduced");
+    case 5: return PSTR("protection");
+    case 6: return PSTR("off");
+    default: return PSTR("reserved");
+  }
+}
+
+static PGM_P dhwOverrideModeToString_P(uint8_t code)
+{
+  switch (code) {
+    case 0: return PSTR("no_override");
+    case 1: return PSTR("auto");
+    case 2: return PSTR("anti_legionella");
+    case 3: return PSTR("comfort");
+    case 4: return PSTR("reduced");
+    case 5: return PSTR("protection");
+    case 6: return PSTR("off");
+    default: return PSTR("reserved");
+  }
+}
+
+static PGM_P onOffToString_P(bool isOn)
+{
+  return isOn ? PSTR("ON") : PSTR("OFF");
+}
+
+static void publish_current_message_u8_alias_topics()
+{
+  publish_u8_alias_topics();
+}
+
+static void publish_mqtt_u8_value_topic(const __FlashStringHelper *topic, uint8_t value)
+{
+  char msg[4] {0};
+  utoa(value, msg, 10);
+  sendMQTTData(topic, msg);
+}
+
+static void publish_mqtt_pgm_payload_topic(const __FlashStringHelper *topic, PGM_P payload)
+{
+  sendMQTTData(topic, toFlashStringHelper(payload));
+}
+
+static void publish_mqtt_u8_code_and_text_topics(const __FlashStringHelper *codeTopic,
+                                                 const __FlashStringHelper *textTopic,
+                                                 uint8_t code,
+                                                 PGM_P text)
+{
+  publish_mqtt_u8_value_topic(codeTopic, code);
+  publish_mqtt_pgm_payload_topic(textTopic, text);
+}
+
+void print_rf_sensor_status_information(uint16_t& value)
+{
+  const uint8_t sensorIndex = OTdata.valueHB & 0x0F;
+  const uint8_t sensorType = (OTdata.valueHB >> 4) & 0x0F;
+  const uint8_t batteryInd = OTdata.valueLB & 0x03;
+  const uint8_t signalStrength = (OTdata.valueLB >> 2) & 0x07;
+  char sensorTypeText[32] {0};
+  char signalStrengthText[24] {0};
+  char batteryIndText[24] {0};
+
+  copyProgmemString(sensorTypeText, sizeof(sensorTypeText), rfSensorTypeToString_P(sensorType));
+  copyProgmemString(signalStrengthText, sizeof(signalStrengthText), rfSignalStrengthToString_P(signalStrength));
+  copyProgmemString(batteryIndText, sizeof(batteryIndText), rfBatteryIndicationToString_P(batteryInd));
+
+  AddLogf_P(PSTR("%s = sensor_type[%u:%s] sensor_index[%u] signal[%u:%s] battery[%u:%s]"),
+            OTlookupitem.label,
+            sensorType, sensorTypeText,
+            sensorIndex,
+            signalStrength, signalStrengthText,
+            batteryInd, batteryIndText);
+
+  if (is_value_valid(OTdata, OTlookupitem)){
+    publish_current_message_u8_alias_topics();
+
+    publish_mqtt_u8_value_topic(F("RFSensorStatusInformation_sensor_index"), sensorIndex);
+    publish_mqtt_u8_code_and_text_topics(F("RFSensorStatusInformation_sensor_type_code"),
+                                         F("RFSensorStatusInformation_sensor_type"),
+                                         sensorType,
+                                         rfSensorTypeToString_P(sensorType));
+    publish_mqtt_u8_code_and_text_topics(F("RFSensorStatusInformation_signal_strength_code"),
+                                         F("RFSensorStatusInformation_signal_strength"),
+                                         signalStrength,
+                                         rfSignalStrengthToString_P(signalStrength));
+    publish_mqtt_u8_code_and_text_topics(F("RFSensorStatusInformation_battery_indication_code"),
+                                         F("RFSensorStatusInformation_battery_indication"),
+                                         batteryInd,
+                                         rfBatteryIndicationToString_P(batteryInd));
+
+    value = OTdata.u16();
+  }
+}
+
+void print_remote_override_operating_mode(uint16_t& value)
+{
+  const uint8_t hc1Mode = OTdata.valueLB & 0x0F;
+  const uint8_t hc2Mode = (OTdata.valueLB >> 4) & 0x0F;
+  const uint8_t dhwMode = OTdata.valueHB & 0x0F;
+  const bool manualDhwPush = (OTdata.valueHB & 0x10) != 0;
+  char dhwModeText[20] {0};
+  char hc1ModeText[16] {0};
+  char hc2ModeText[16] {0};
+  char manualDhwPushText[4] {0};
+
+  copyProgmemString(dhwModeText, sizeof(dhwModeText), dhwOverrideModeToString_P(dhwMode));
+  copyProgmemString(hc1ModeText, sizeof(hc1ModeText), heatingOverrideModeToString_P(hc1Mode));
+  copyProgmemString(hc2ModeText, sizeof(hc2ModeText), heatingOverrideModeToString_P(hc2Mode));
+  copyProgmemString(manualDhwPushText, sizeof(manualDhwPushText), onOffToString_P(manualDhwPush));
+
+  AddLogf_P(PSTR("%s = DHW[%u:%s push:%s] HC1[%u:%s] HC2[%u:%s]"),
+            OTlookupitem.label,
+            dhwMode, dhwModeText, manualDhwPushText,
+            hc1Mode, hc1ModeText,
+            hc2Mode, hc2ModeText);
+
+  if (is_value_valid(OTdata, OTlookupitem)){
+    publish_current_message_u8_alias_topics();
+
+    publish_mqtt_u8_code_and_text_topics(F("RemoteOverrideOperatingMode_dhw_mode_code"),
+                                         F("RemoteOverrideOperatingMode_dhw_mode"),
+                                         dhwMode,
+                                         dhwOverrideModeToString_P(dhwMode));
+    publish_mqtt_pgm_payload_topic(F("RemoteOverrideOperatingMode_manual_dhw_push"), onOffToString_P(manualDhwPush));
+
+    publish_mqtt_u8_code_and_text_topics(F("RemoteOverrideOperatingMode_hc1_mode_code"),
+                                         F("RemoteOverrideOperatingMode_hc1_mode"),
+                                         hc1Mode,
+                                         heatingOverrideModeToString_P(hc1Mode));
+    publish_mqtt_u8_code_and_text_topics(F("RemoteOverrideOperatingMode_hc2_mode_code"),
+                                         F("RemoteOverrideOperatingMode_hc2_mode"),
+                                         hc2Mode,
+                                         heatingOverrideModeToString_P(hc2Mode));
+
+    value = OTdata.u16();
+  }
+}
+
+void print_date(uint16_t& value)
+{ 
+  
+  AddLogf("%s = %3d / %3d %s", OTlookupitem.label, (uint8_t)OTdata.valueHB, (uint8_t)OTdata.valueLB, OTlookupitem.unit);
+  if (is_value_valid(OTdata, OTlookupitem)){
+    //Build string for MQTT
+    otTopic[0] = '\0';
+    char _msg[10] {0};
+    //flag8 valueHB
+    utoa((OTdata.valueHB), _msg, 10);
+    //AddLogf("%s = HB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueHB);
+    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
+    strlcat(otTopic, "_month", sizeof(otTopic));
+    sendMQTTData(otTopic, _msg);
+    //flag8 valueLB
+    utoa((OTdata.valueLB), _msg, 10);
+    //AddLogf("%s = LB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueLB);
+    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
+    strlcat(otTopic, "_day_of_month", sizeof(otTopic));
+    sendMQTTData(otTopic, _msg);
+    value = OTdata.u16();
+  }
+}
+
+void print_daytime(uint16_t& value)
+{
+  //function to print data
+  static const char str_unknown[] PROGMEM = "Unknown";
+  static const char str_monday[] PROGMEM = "Monday";
+  static const char str_tuesday[] PROGMEM = "Tuesday";
+  static const char str_wednesday[] PROGMEM = "Wednesday";
+  static const char str_thursday[] PROGMEM = "Thursday";
+  static const char str_friday[] PROGMEM = "Friday";
+  static const char str_saturday[] PROGMEM = "Saturday";
+  static const char str_sunday[] PROGMEM = "Sunday";
+  static const char* const dayOfWeekName[] PROGMEM = { str_unknown, str_monday, str_tuesday, str_wednesday, str_thursday, str_friday, str_saturday, str_sunday, str_unknown };
+  
+  uint8_t dayIdx = (OTdata.valueHB >> 5) & 0x7;
+  char dayName[15];
+  strcpy_P(dayName, (PGM_P)pgm_read_ptr(&dayOfWeekName[dayIdx]));
+  AddLogf("%s = %s - %.2d:%.2d", OTlookupitem.label, dayName, (OTdata.valueHB & 0x1F), OTdata.valueLB); 
+  if (is_value_valid(OTdata, OTlookupitem)){
+    //Build string for MQTT
+    otTopic[0] = '\0';
+    char _msg[10] {0};
+    //dayofweek
+    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
+    strlcat(otTopic, "_dayofweek", sizeof(otTopic));
+    sendMQTTData(otTopic, dayName); 
+    //hour
+    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
+    strlcat(otTopic, "_hour", sizeof(otTopic));
+    sendMQTTData(otTopic, itoa((OTdata.valueHB & 0x1F), _msg, 10)); 
+    //min
+    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
+    strlcat(otTopic, "_minutes", sizeof(otTopic));
+    sendMQTTData(otTopic, itoa((OTdata.valueLB), _msg, 10)); 
+    value = OTdata.u16();
+  }
+}
+
+//===================[ PS=1 Summary Parsing ]===============
+
+/*
+  PS=1 (Print Summary) mode field-to-MsgID mapping tables.
+  When in PS=1 mode, the OTGW PIC firmware outputs a single comma-separated summary
+  line per OpenTherm cycle. Two formats exist:
+    - Old firmware (< v5): 25 comma-separated fields (24 commas)
+    - New firmware (v5+) : 34 comma-separated fields (33 commas)
+  Each entry is the OpenTherm MsgID for the corresponding field position.
+*/
+static const uint8_t PSSUMMARY_MSGIDS_OLD[25] PROGMEM = {
+  /*  0 */ 0,   // Status flags         (flag8/flag8)
+  /*  1 */ 1,   // TSet                 (f88)
+  /*  2 */ 6,   // RBPflags             (flag8/flag8)
+  /*  3 */ 14,  // MaxRelModLevelSetting(f88)
+  /*  4 */ 15,  // MaxCapacityMinModLevel (u8/u8)
+  /*  5 */ 16,  // TrSet                (f88)
+  /*  6 */ 17,  // RelModLevel          (f88)
+  /*  7 */ 18,  // CHPressure           (f88)
+  /*  8 */ 24,  // Tr                   (f88)
+  /*  9 */ 25,  // Tboiler              (f88)
+  /* 10 */ 26,  // Tdhw                 (f88)
+  /* 11 */ 27,  // Toutside             (f88)
+  /* 12 */ 28,  // Tret                 (f88)
+  /* 13 */ 48,  // TdhwSetUBTdhwSetLB   (s8/s8)
+  /* 14 */ 49,  // MaxTSetUBMaxTSetLB   (s8/s8)
+  /* 15 */ 56,  // TdhwSet              (f88)
+  /* 16 */ 57,  // MaxTSet              (f88)
+  /* 17 */ 116, // BurnerStarts         (u16)
+  /* 18 */ 117, // CHPumpStarts         (u16)
+  /* 19 */ 118, // DHWPumpValveStarts   (u16)
+  /* 20 */ 119, // DHWBurnerStarts      (u16)
+  /* 21 */ 120, // BurnerOperationHours (u16)
+  /* 22 */ 121, // CHPumpOperationHours (u16)
+  /* 23 */ 122, // DHWPumpValveOperationHours (u16)
+  /* 24 */ 123  // DHWBurnerOperationHours    (u16)
+};
+
+static const uint8_t PSSUMMARY_MSGIDS_NEW[34] PROGMEM = {
+  /*  0 */ 0,   // Status flags              (flag8/flag8)
+  /*  1 */ 1,   // TSet                      (f88)
+  /*  2 */ 6,   // RBPflags                  (flag8/flag8)
+  /*  3 */ 7,   // CoolingControl            (f88)     [new in v5+]
+  /*  4 */ 8,   // TsetCH2                   (f88)     [new in v5+]
+  /*  5 */ 14,  // MaxRelModLevelSetting     (f88)
+  /*  6 */ 15,  // MaxCapacityMinModLevel    (u8/u8)
+  /*  7 */ 16,  // TrSet                     (f88)
+  /*  8 */ 17,  // RelModLevel               (f88)
+  /*  9 */ 18,  // CHPressure                (f88)
+  /* 10 */ 19,  // DHWFlowRate               (f88)     [new in v5+]
+  /* 11 */ 23,  // TrSetCH2                  (f88)     [new in v5+]
+  /* 12 */ 24,  // Tr                        (f88)
+  /* 13 */ 25,  // Tboiler                   (f88)
+  /* 14 */ 26,  // Tdhw                      (f88)
+  /* 15 */ 27,  // Toutside                  (f88)
+  /* 16 */ 28,  // Tret                      (f88)
+  /* 17 */ 31,  // TflowCH2                  (f88)     [new in v5+]
+  /* 18 */ 33,  // Texhaust                  (s16)     [new in v5+]
+  /* 19 */ 48,  // TdhwSetUBTdhwSetLB        (s8/s8)
+  /* 20 */ 49,  // MaxTSetUBMaxTSetLB        (s8/s8)
+  /* 21 */ 56,  // TdhwSet                   (f88)
+  /* 22 */ 57,  // MaxTSet                   (f88)
+  /* 23 */ 70,  // StatusVH                  (flag8/flag8) [new in v5+]
+  /* 24 */ 71,  // ControlSetpointVH         (u8)      [new in v5+]
+  /* 25 */ 77,  // RelativeVentilation       (u8)      [new in v5+]
+  /* 26 */ 116, // BurnerStarts              (u16)
+  /* 27 */ 117, // CHPumpStarts              (u16)
+  /* 28 */ 118, // DHWPumpValveStarts        (u16)
+  /* 29 */ 119, // DHWBurnerStarts           (u16)
+  /* 30 */ 120, // BurnerOperationHours      (u16)
+  /* 31 */ 121, // CHPumpOperationHours      (u16)
+  /* 32 */ 122, // DHWPumpValveOperationHours(u16)
+  /* 33 */ 123  // DHWBurnerOperationHours   (u16)
+};
+
+static bool parseStrictSignedLong(const char *text, long minValue, long maxValue, long &value)
+{
+  if (!text || *text == '\0') return false;
+
+  char *endPtr = nullptr;
+  long parsedValue = strtol(text, &endPtr, 10);
+  if ((endPtr == text) || (*endPtr != '\0') || (parsedValue < minValue) || (parsedValue > maxValue)) {
+    return false;
+  }
+
+  value = parsedValue;
+  return true;
+}
+
+static bool parseStrictUnsignedLong(const char *text, unsigned long maxValue, unsigned long &value)
+{
+  if (!text || *text == '\0' || *text == '-') return false;
+
+  char *endPtr = nullptr;
+  unsigned long parsedValue = strtoul(text, &endPtr, 10);
+  if ((endPtr == text) || (*endPtr != '\0') || (parsedValue > maxValue)) {
+    return false;
+  }
+
+  value = parsedValue;
+  return true;
+}
+
+static bool parseStrictFloat(const char *text, float &value)
+{
+  if (!text || *text == '\0') return false;
+
+  char *endPtr = nullptr;
+  double parsedValue = strtod(text, &endPtr);
+  if ((endPtr == text) || (*endPtr != '\0')) {
+    return false;
+  }
+
+  value = static_cast<float>(parsedValue);
+  return true;
+}
+
+static bool splitPSSummaryPair(const char *text, char separator,
+                               char *left, size_t leftSize,
+                               char *right, size_t rightSize)
+{
+  if (!text || !left || !right || leftSize == 0 || rightSize == 0) return false;
+
+  const char *separatorPos = strchr(text, separator);
+  if (!separatorPos || strchr(separatorPos + 1, separator)) return false;
+
+  const size_t leftLen = static_cast<size_t>(separatorPos - text);
+  const size_t rightLen = strlen(separatorPos + 1);
+  if (leftLen == 0 || rightLen == 0 || leftLen >= leftSize || rightLen >= rightSize) return false;
+
+  memcpy(left, text, leftLen);
+  left[leftLen] = '\0';
+  strlcpy(right, separatorPos + 1, rightSize);
+  return true;
+}
+
+static bool parsePSSummaryS8S8(const char *text, int8_t &upperByte, int8_t &lowerByte)
+{
+  char left[12] {0};
+  char right[12] {0};
+  long leftValue = 0;
+  long rightValue = 0;
+  if (!splitPSSummaryPair(text, '/', left, sizeof(left), right, sizeof(right))) return false;
+  if (!parseStrictSignedLong(left, -128, 127, leftValue)) return false;
+  if (!parseStrictSignedLong(right, -128, 127, rightValue)) return false;
+  upperByte = static_cast<int8_t>(leftValue);
+  lowerByte = static_cast<int8_t>(rightValue);
+  return true;
+}
+
+static bool parsePSSummaryU8U8(const char *text, uint8_t &upperByte, uint8_t &lowerByte)
+{
+  char left[12] {0};
+  char right[12] {0};
+  unsigned long leftValue = 0;
+  unsigned long rightValue = 0;
+  if (!splitPSSummaryPair(text, '/', left, sizeof(left), right, sizeof(right))) return false;
+  if (!parseStrictUnsignedLong(left, 255UL, leftValue)) return false;
+  if (!parseStrictUnsignedLong(right, 255UL, rightValue)) return false;
+  upperByte = static_cast<uint8_t>(leftValue);
+  lowerByte = static_cast<uint8_t>(rightValue);
+  return true;
+}
+
+static bool parseBinaryOctet(const char *text, uint8_t &value)
+{
+  if (!text || strlen(text) != 8) return false;
+
+  value = 0;
+  for (uint8_t i = 0; i < 8; i++) {
+    if (text[i] != '0' && text[i] != '1') return false;
+    value = static_cast<uint8_t>((value << 1) | (text[i] - '0'));
+  }
+  return true;
+}
+
+static bool parsePSSummaryFlag8Flag8(const char *text, uint8_t &upperByte, uint8_t &lowerByte)
+{
+  char left[9] {0};
+  char right[9] {0};
+  if (!splitPSSummaryPair(text, '/', left, sizeof(left), right, sizeof(right))) return false;
+  if (!parseBinaryOctet(left, upperByte)) return false;
+  if (!parseBinaryOctet(right, lowerByte)) return false;
+  return true;
+}
+
+static void updatePSSummaryFloatState(uint8_t msgid, float fval)
+{
+  switch (msgid) {
+    case  1: OTcurrentSystemState.TSet                  = fval; break;
+    case  7: OTcurrentSystemState.CoolingControl        = fval; break;
+    case  8: OTcurrentSystemState.TsetCH2               = fval; break;
+    case 14: OTcurrentSystemState.MaxRelModLevelSetting = fval; break;
+    case 16: OTcurrentSystemState.TrSet                 = fval; break;
+    case 17: OTcurrentSystemState.RelModLevel           = fval; break;
+    case 18: OTcurrentSystemState.CHPressure            = fval; break;
+    case 19: OTcurrentSystemState.DHWFlowRate           = fval; break;
+    case 23: OTcurrentSystemState.TrSetCH2              = fval; break;
+    case 24: OTcurrentSystemState.Tr                    = fval; break;
+    case 25: OTcurrentSystemState.Tboiler               = fval; break;
+    case 26: OTcurrentSystemState.Tdhw                  = fval; break;
+    case 27: OTcurrentSystemState.Toutside              = fval; break;
+    case 28: OTcurrentSystemState.Tret                  = fval; break;
+    case 31: OTcurrentSystemState.TflowCH2              = fval; break;
+    case 56: OTcurrentSystemState.TdhwSet               = fval; break;
+    case 57: OTcurrentSystemState.MaxTSet               = fval; break;
+    default: break;
+  }
+}
+
+static void updatePSSummaryU16State(uint8_t msgid, uint16_t value)
+{
+  switch (msgid) {
+    case 116: OTcurrentSystemState.BurnerStarts               = value; break;
+    case 117: OTcurrentSystemState.CHPumpStarts               = value; break;
+    case 118: OTcurrentSystemState.DHWPumpValveStarts         = value; break;
+    case 119: OTcurrentSystemState.DHWBurnerStarts            = value; break;
+    case 120: OTcurrentSystemState.BurnerOperationHours       = value; break;
+    case 121: OTcurrentSystemState.CHPumpOperationHours       = value; break;
+    case 122: OTcurrentSystemState.DHWPumpValveOperationHours = value; break;
+    case 123: OTcurrentSystemState.DHWBurnerOperationHours    = value; break;
+    default:  break;
+  }
+}
+
+static void publishPSSummarySplitBytes(const char *label, const char *hbSuffix, const char *lbSuffix,
+                                       const char *hbValue, const char *lbValue)
+{
+  char topicBuf[MQTT_TOPIC_MAX_LEN];
+  strlcpy(topicBuf, label, sizeof(topicBuf));
+  strlcat(topicBuf, hbSuffix, sizeof(topicBuf));
+  sendMQTTData(topicBuf, hbValue);
+  strlcpy(topicBuf, label, sizeof(topicBuf));
+  strlcat(topicBuf, lbSuffix, sizeof(topicBuf));
+  sendMQTTData(topicBuf, lbValue);
+}
+
+static void ensurePSSummaryDiscovery(uint8_t msgid)
+{
+  // Non-blocking: just mark pending; drainOnePendingDiscovery() publishes later.
+  if (settings.mqtt.bEnable && !getMQTTConfigDone(msgid)) {
+    setMQTTConfigPending(msgid);
+  }
+}
+
+static void logPSSummaryField(const char *label, const char *rawField)
+{
+  ClrLog();
+  AddLogf_P(PSTR("PS1 %-20s = %s"), label, rawField);
+  AddLogln();
+  sendLogToWebSocket(ot_log_buffer);
+  ClrLog();
+}
+
+static bool publishPSSummaryFieldValue(uint8_t msgid, uint8_t valueType, const char *label, const char *rawField)
+{
+  char valueBuf[12] {0};
+  const uint16_t trackedNow = currentTrackedSeconds();
+
+  // ADR-097 (PS=1 amendment): Caller already populated the global OTlookupitem
+  // via PROGMEM_readAnything(&OTmap[msgid], ...) before invoking us. Use it to
+  // gate base-topic publication and OTcurrentSystemState updates so the PS=1
+  // path matches the live OT-bus master-topic invariant. setMsgLastUpdated is
+  // intentionally left ungated (cosmetic epoch tick, consistent with
+  // OTGW-Core.ino:4034 in the live-bus path). The ot_flag8flag8 case keeps its
+  // own per-MsgID handling (status-flag semantics) and is not gated here.
+  const bool validForMaster = is_msgid_valid_for_master_topic_in_ps_summary(OTlookupitem);
+  if (!validForMaster) {
+    DebugTf(PSTR("PS=1 master-topic gate suppressed MsgID %u (%s): bSlaveEchoesValue=false\r\n"),
+            msgid, label);
+  }
+
+  switch (valueType) {
+    case ot_f88: {
+      float value = 0.0f;
+      if (!parseStrictFloat(rawField, value)) return false;
+      otFormatCenti(lroundf(value * 100.0f), valueBuf, sizeof(valueBuf));
+      if (validForMaster) sendMQTTData(label, valueBuf);
+      setMsgLastUpdated(msgid, trackedNow, static_cast<uint16_t>(lroundf(value * 256.0f)));
+      if (validForMaster) updatePSSummaryFloatState(msgid, value);
+      return true;
+    }
+
+    case ot_s16: {
+      long parsedValue = 0;
+      if (!parseStrictSignedLong(rawField, -32768L, 32767L, parsedValue)) return false;
+      itoa(static_cast<int16_t>(parsedValue), valueBuf, 10);
+      if (validForMaster) sendMQTTData(label, valueBuf);
+      setMsgLastUpdated(msgid, trackedNow, static_cast<uint16_t>(parsedValue));
+      if (validForMaster && msgid == 33) OTcurrentSystemState.Texhaust = static_cast<int16_t>(parsedValue);
+      return true;
+    }
+
+    case ot_u16: {
+      unsigned long parsedValue = 0;
+      if (!parseStrictUnsignedLong(rawField, 65535UL, parsedValue)) return false;
+      utoa(static_cast<uint16_t>(parsedValue), valueBuf, 10);
+      if (validForMaster) sendMQTTData(label, valueBuf);
+      setMsgLastUpdated(msgid, trackedNow, static_cast<uint16_t>(parsedValue));
+      if (validForMaster) updatePSSummaryU16State(msgid, static_cast<uint16_t>(parsedValue));
+      return true;
+    }
+
+    case ot_s8s8: {
+      int8_t upperByte = 0;
+      int8_t lowerByte = 0;
+      if (!parsePSSummaryS8S8(rawField, upperByte, lowerByte)) return false;
+      char lowerValueBuf[12] {0};
+      itoa(upperByte, valueBuf, 10);
+      itoa(lowerByte, lowerValueBuf, 10);
+      if (validForMaster) publishPSSummarySplitBytes(label, "_value_hb", "_value_lb", valueBuf, lowerValueBuf);
+      setMsgLastUpdated(msgid, trackedNow, ((uint8_t)upperByte << 8) | (uint8_t)lowerByte);
+      if (validForMaster) {
+        if (msgid == 48) OTcurrentSystemState.TdhwSetUBTdhwSetLB = ((uint8_t)upperByte << 8) | (uint8_t)lowerByte;
+        else if (msgid == 49) OTcurrentSystemState.MaxTSetUBMaxTSetLB = ((uint8_t)upperByte << 8) | (uint8_t)lowerByte;
+      }
+      return true;
+    }
+
+    case ot_u8u8: {
+      uint8_t upperByte = 0;
+      uint8_t lowerByte = 0;
+      if (!parsePSSummaryU8U8(rawField, upperByte, lowerByte)) return false;
+      char lowerValueBuf[12] {0};
+      utoa(upperByte, valueBuf, 10);
+      utoa(lowerByte, lowerValueBuf, 10);
+      if (validForMaster) publishPSSummarySplitBytes(label, "_value_hb", "_value_lb", valueBuf, lowerValueBuf);
+      setMsgLastUpdated(msgid, trackedNow, ((uint16_t)upperByte << 8) | lowerByte);
+      if (validForMaster && msgid == 15) OTcurrentSystemState.MaxCapacityMinModLevel = ((uint16_t)upperByte << 8) | lowerByte;
+      return true;
+    }
+
+    case ot_u8: {
+      unsigned long parsedValue = 0;
+      if (!parseStrictUnsignedLong(rawField, 255UL, parsedValue)) return false;
+      utoa(static_cast<uint8_t>(parsedValue), valueBuf, 10);
+      if (validForMaster) sendMQTTData(label, valueBuf);
+      setMsgLastUpdated(msgid, trackedNow, static_cast<uint8_t>(parsedValue));
+      if (validForMaster) {
+        if (msgid == 71) OTcurrentSystemState.ControlSetpointVH = static_cast<uint8_t>(parsedValue);
+        else if (msgid == 77) OTcurrentSystemState.RelativeVentilation = static_cast<uint8_t>(parsedValue);
+      }
+      return true;
+    }
+
+    case ot_flag8flag8: {
+      uint8_t upperByte = 0;
+      uint8_t lowerByte = 0;
+      if (!parsePSSummaryFlag8Flag8(rawField, upperByte, lowerByte)) return false;
+      setMsgLastUpdated(msgid, trackedNow, ((uint16_t)upperByte << 8) | lowerByte);
+      switch (msgid) {
+        case 0:
+          OTcurrentSystemState.Statusflags = publishCombinedStatusState(upperByte, lowerByte);
+          break;
+        case 6: {
+          // TASK-401: feed previous HB/LB into publishRBPFlagsState so per-bit gate works via PS summary path too.
+          const uint16_t prevCombined = OTcurrentSystemState.RBPflags;
+          const uint8_t  prevTransfer  = (uint8_t)((prevCombined >> 8) & 0xFF);
+          const uint8_t  prevReadWrite = (uint8_t)(prevCombined & 0xFF);
+          OTcurrentSystemState.RBPflags = publishRBPFlagsState(upperByte, lowerByte, prevTransfer, prevReadWrite);
+          break;
+        }
+        case 70:
+          OTcurrentSystemState.StatusVH = publishCombinedStatusVHState(upperByte, lowerByte);
+          break;
+        default:
+          sendMQTTData(label, rawField);
+          break;
+      }
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+/*
+  Process a PS=1 (Print Summary) comma-separated summary line from the OTGW PIC firmware.
+  Parses each field, updates OTcurrentSystemState, and publishes to MQTT.
+  Old firmware (< v5): 25 fields / 24 commas.
+  New firmware (v5+) : 34 fields / 33 commas.
+*/
+void processPSSummary(const char *buf, int len) {
+  int commaCount = 0;
+  for (int i = 0; i < len; i++) {
+    if (buf[i] == ',') commaCount++;
+  }
+
+  const bool bFW5 = (commaCount == 33);
+  if (commaCount != 24 && commaCount != 33) return;
+
+  enterPSMode(PSTR("PS mode auto-detected as ON (comma-separated summary)"), nullptr, false);
+
+  const uint8_t *msgIdTable = bFW5 ? PSSUMMARY_MSGIDS_NEW : PSSUMMARY_MSGIDS_OLD;
+  const uint8_t tableSize   = bFW5 ? 34 : 25;
+  const char *p = buf;
+  const char *end = buf + len;
+  int idx = 0;
+  char fBuf[22];
+  MQTTPublishBatchScope batch;   // one gate check for all 25/34 fields of the line
+
+  while (p <= end && idx < tableSize) {
+    const char *comma = (const char*)memchr(p, ',', end - p);
+    const int fieldLen = (comma != nullptr) ? (int)(comma - p) : (int)(end - p);
+
+    if (fieldLen > 0 && fieldLen < (int)sizeof(fBuf)) {
+      memcpy(fBuf, p, fieldLen);
+      fBuf[fieldLen] = '\0';
+
+      const uint8_t msgid = pgm_read_byte(&msgIdTable[idx]);
+      if (msgid <= OT_MSGID_MAX) {
+        PROGMEM_readAnything(&OTmap[msgid], OTlookupitem);
+        const char *label = OTlookupitem.label;
+        // ADR-104 Decision item 7: scope mqttPendingSlot commit to this frame.
+        // shouldPublishMQTTForPSField installs pending; capture the pre-publish
+        // success count, run the publish path, then commit if any sendMQTTData
+        // succeeded — else clear the pending so a later unrelated publish
+        // cannot silently commit it.
+        const uint32_t preSuccessCount = mqttSendSuccessCount;
+        OTPublishGate psGate(shouldPublishMQTTForPSField(msgid));
+
+        if (publishPSSummaryFieldValue(msgid, OTlookupitem.type, label, fBuf)) {
+          ensurePSSummaryDiscovery(msgid);
+          logPSSummaryField(label, fBuf);
+        }
+
+        if (mqttPendingSlot.pending) {
+          if (mqttSendSuccessCount > preSuccessCount) confirmMQTTPublishSlot();
+          else                                        mqttPendingSlot.pending = false;
+        }
+      }
+    }
+
+    if (comma == nullptr) break;
+    p = comma + 1;
+    idx++;
+  }
+
+  OTDebugTf(PSTR("PS=1 summary parsed: %d fields (%s firmware)\r\n"), idx + 1, bFW5 ? "v5+" : "<v5");
+}
+
+//===================[ OT Message Dispatch ]===============
+
+/*
+  Raw OT messages are 9 chars long and start with TBARE when talking to OTGW PIC.
+  A line is not an OT message if its length is not 9 OR its 3rd char is ':'
+  (= OTGW command response). Validation and hex decode are done in one pass
+  by otParseFrame() (OTFrameParse.h), which replaced isvalidotmsg() + sscanf.
+*/
+
+// Decoders indexed by OTDecodeKind; OTDispatch[] (OTDispatch.h) maps each
+// message id to one of these and to its OTcurrentSystemState field. The table
+// holds an index rather than the function pointer so OTDispatch.h stays
+// host-compilable without the print_* definitions.
+typedef void (*OTDecodeFn)(void *field);
+
+static void otDecF88(void *f)                 { print_f88(*static_cast<float *>(f)); }
+static void otDecS16(void *f)                 { print_s16(*static_cast<int16_t *>(f)); }
+static void otDecS8S8(void *f)                { print_s8s8(*static_cast<uint16_t *>(f)); }
+static void otDecU16(void *f)                 { print_u16(*static_cast<uint16_t *>(f)); }
+static void otDecU8U8(void *f)                { print_u8u8(*static_cast<uint16_t *>(f)); }
+static void otDecU8Hb(void *f)                { print_u8_hb(*static_cast<uint16_t *>(f)); }
+static void otDecU8Lb(void *f)                { print_u8_lb(*static_cast<uint16_t *>(f)); }
+static void otDecFlag8U8(void *f)             { print_flag8u8(*static_cast<uint16_t *>(f)); }
+static void otDecStatus(void *f)              { print_status(*static_cast<uint16_t *>(f)); }
+static void otDecStatusVH(void *f)            { print_statusVH(*static_cast<uint16_t *>(f)); }
+static void otDecASFflags(void *f)            { print_ASFflags(*static_cast<uint16_t *>(f)); }
+static void otDecRBPflags(void *f)            { print_RBPflags(*static_cast<uint16_t *>(f)); }
+static void otDecMasterMemberId(void *f)      { print_mastermemberid(*static_cast<uint16_t *>(f)); }
+static void otDecSlaveMemberId(void *f)       { print_slavememberid(*static_cast<uint16_t *>(f)); }
+static void otDecCommand(void *f)             { print_command(*static_cast<uint16_t *>(f)); }
+static void otDecDate(void *f)                { print_date(*static_cast<uint16_t *>(f)); }
+static void otDecDaytime(void *f)             { print_daytime(*static_cast<uint16_t *>(f)); }
+static void otDecRemoteOverrideFn(void *f)    { print_remoteoverridefunction(*static_cast<uint16_t *>(f)); }
+static void otDecVHConfigMemberId(void *f)    { print_vh_configmemberid(*static_cast<uint16_t *>(f)); }
+static void otDecVHRemoteParam(void *f)       { print_vh_remoteparametersetting(*static_cast<uint16_t *>(f)); }
+static void otDecRFSensor(void *f)            { print_rf_sensor_status_information(*static_cast<uint16_t *>(f)); }
+static void otDecOperatingMode(void *f)       { print_remote_override_operating_mode(*static_cast<uint16_t *>(f)); }
+static void otDecSolarStatus(void *f)         { print_solar_storage_status(*static_cast<uint16_t *>(f)); }
+static void otDecSolarSlaveMemberId(void *f)  { print_solarstorage_slavememberid(*static_cast<uint16_t *>(f)); }
+
+static const OTDecodeFn otDecoders[] = {
+  nullptr,                                // OTDEC_NONE
+  otDecF88,
+  otDecS16,
+  otDecS8S8,
+  otDecU16,
+  otDecU8U8,
+  otDecU8Hb,
+  otDecU8Lb,
+  otDecFlag8U8,
+  otDecStatus,
+  otDecStatusVH,
+  otDecASFflags,
+  otDecRBPflags,
+  otDecMasterMemberId,
+  otDecSlaveMemberId,
+  otDecCommand,
+  otDecDate,
+  otDecDaytime,
+  otDecRemoteOverrideFn,
+  otDecVHConfigMemberId,
+  otDecVHRemoteParam,
+  otDecRFSensor,
+  otDecOperatingMode,
+  otDecSolarStatus,
+  otDecSolarSlaveMemberId,
+};
+static_assert(sizeof(otDecoders) / sizeof(otDecoders[0]) == OTDEC_COUNT,
+              "otDecoders[] must have one entry per OTDecodeKind, in enum order");
+
+static inline void *otDispatchField(const OTDispatchEntry &d)
+{
+  return reinterpret_cast<uint8_t *>(&OTcurrentSystemState) + d.offset;
+}
+
+static void decodeAndPublishOTValue()
+{
+  if (isMsgIdReservedInActiveProfile(OTdata.id)) {
+    char activeProfileName[20] {0};
+    copyProgmemString(activeProfileName, sizeof(activeProfileName), activeOTSpecProfileName_P());
+    AddLogf_P(PSTR("Reserved in %s profile (legacy pre-v4.2 ID %u ignored)"),
+              activeProfileName,
+              (unsigned)OTdata.id);
+    return;
+  }
+
+  OTDispatchEntry d;
+  PROGMEM_readAnything(&OTDispatch.e[OTdata.id], d);
+  if (d.flags & OTD_FLAG_DEFINED) {
+    otDecoders[d.decoder](otDispatchField(d));
+    return;
+  }
+
+  AddLogf("Unknown message [%02d] value [%04X] f8.8 [%3.2f] u16 [%d] s16 [%d]",
+          OTdata.id,
+          OTdata.value,
+          OTdata.f88(),
+          OTdata.u16(),
+          OTdata.s16());
+}
+
+// TASK-691 / TASK-692 / TASK-693 port (dev TASK-685/686/688): per-msgID bitmaps
+// recording each side of the OT bus's observed capability. Populated in
+// processOT (idempotent set on every observation). File scope so REST/MQTT/
+// file-persistence layers can read them through the accessors below.
+//
+// Memory: 6 * 32 = 192 B bitmaps + 3 B dirty flags + 32 B scratch = 227 B.
+//
+// Persistence (TASK-693): the *FileDirty flags drive 15-min debounced atomic
+// writes to /ot-thermo.json and /ot-boiler.json (saveOtSupportFilesIfDirty).
+// boilerUnsupportedDirty stays independent because the MQTT republish has its
+// own (1-min) cadence and consumes only the unsupported subset.
+static uint8_t boilerLastMasterWasWrite[32] = {0};  // scratch — not persisted
+static uint8_t boilerUnsupportedRead[32]    = {0};
+static uint8_t boilerUnsupportedWrite[32]   = {0};
+static uint8_t boilerAckedRead[32]          = {0};
+static uint8_t boilerAckedWrite[32]         = {0};
+static uint8_t thermostatSentRead[32]       = {0};
+static uint8_t thermostatSentWrite[32]      = {0};
+static bool boilerUnsupportedDirty = false;  // MQTT CSV republish gate (1-min cadence)
+static bool boilerFileDirty        = false;  // /ot-boiler.json   write gate (15-min cadence)
+static bool thermostatFileDirty    = false;  // /ot-thermo.json   write gate (15-min cadence)
+
+bool isBoilerMsgIdUnsupportedRead(uint8_t id) {
+  return (boilerUnsupportedRead[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
+}
+bool isBoilerMsgIdUnsupportedWrite(uint8_t id) {
+  return (boilerUnsupportedWrite[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
+}
+bool isBoilerMsgIdAckedRead(uint8_t id) {
+  return (boilerAckedRead[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
+}
+bool isBoilerMsgIdAckedWrite(uint8_t id) {
+  return (boilerAckedWrite[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
+}
+bool isThermostatMsgIdSentRead(uint8_t id) {
+  return (thermostatSentRead[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
+}
+bool isThermostatMsgIdSentWrite(uint8_t id) {
+  return (thermostatSentWrite[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
+}
+bool getBoilerUnsupportedDirty()   { return boilerUnsupportedDirty; }
+void clearBoilerUnsupportedDirty() { boilerUnsupportedDirty = false; }
+
+// One raw OT frame from processOT() (otParseFrame() found TBARE + 8 chars):
+// the PS auto-leave, the boiler/thermostat connected state, the delayed
+// (T,R)/(B,A) pairing, the per-id capability bitmaps above, decode + publish
+// in one MQTT publish window, and the OT log line to telnet and WebSocket.
+// Runs under processOT()'s OTStateLock.
+static void processOTFrame(const char *buf, int len, OTFrameParseResult parsed,
+                           const OTRawFrame &frame, bool suppressOutput)
+{
+  // Per-link last-seen now lives in state.otBus (tBoilerLastSeen/tThermostatLastSeen)
+  // so /api/v2/health can emit per-link recency for the v2 connectivity degraded/stale
+  // state (ADR-155). Same single source of truth feeds the 30 s connected window below.
+  static bool bOTGWboilerpreviousstate = false;
+  static bool bOTGWthermostatpreviousstate = false;
+  static bool bOTGWpreviousstate = false;
+  time_t now = time(nullptr);
+
+  // Raw OT frames normally indicate PS=0 (streaming resumed). Skip this
+  // auto-leave path when the caller explicitly suppresses output: in
+  // OT-direct PS=1 we synthesise raw frames ourselves, so seeing them
+  // does not mean the PIC/firmware left PS mode.
+  if (state.otBus.bPSmode && !suppressOutput) {
+    leavePSMode(PSTR("PS mode auto-detected as OFF (raw OT stream resumed)"),
+                PSTR("PS=0 [auto-detected, raw mode resumed]"));
+  }
+
+  // Update LED heartbeat timestamp — resets the "no OT" warning
+  lastOTmsgMs = millis();
+
+  //OT protocol messages are 9 chars long
+  if (!suppressOutput && settings.mqtt.bOTmessage) sendMQTTData(F("otmessage"), buf);
+
+  // counter of number of OT messages processed
+  static int32_t cntOTmessagesprocessed = 0;
+  cntOTmessagesprocessed++;
+  // char _msg[15] {0};
+  // sendMQTTData(F("otmsg_count"), itoa(cntOTmessagesprocessed, _msg, 10)); 
+
+  // source of otmsg
+  if (buf[0]=='B'){
+    state.otBus.tBoilerLastSeen = now;
+    OTdata.rsptype = OTGW_BOILER;
+    // TASK-795 §4.2: a real boiler frame arrived on the PIC bus. If SAT
+    // simulation is active, trip the edge hook (deferred auto-disable).
+    satNotifyBoilerFrameSeen();
+  } else if (buf[0]=='T'){
+    state.otBus.tThermostatLastSeen = now;
+    OTdata.rsptype = OTGW_THERMOSTAT;
+  } else if (buf[0]=='R')    {
+    OTdata.rsptype = OTGW_REQUEST_BOILER;
+  } else if (buf[0]=='A')    {
+    OTdata.rsptype = OTGW_ANSWER_THERMOSTAT;
+  } else if (buf[0]=='E')    {
+    OTdata.rsptype = OTGW_PARITY_ERROR;
+  } 
+
+  //If the Boiler messages have not been seen for 30 seconds, then set the state to false.
+  state.otBus.bBoilerState = (now < (state.otBus.tBoilerLastSeen+30));
+  if ((state.otBus.bBoilerState != bOTGWboilerpreviousstate) || (cntOTmessagesprocessed==1)) {
+    publishBoilerConnectedState();
+    bOTGWboilerpreviousstate = state.otBus.bBoilerState;
+  }
+
+  //If the Thermostat messages have not been seen for 30 seconds, then set the state to false.
+  state.otBus.bThermostatState = (now < (state.otBus.tThermostatLastSeen+30));
+  if ((state.otBus.bThermostatState != bOTGWthermostatpreviousstate) || (cntOTmessagesprocessed==1)){
+    publishThermostatConnectedState();
+    publishHvacMode(false);    // GH #665: re-evaluate hvac_mode/action on thermostat connect/disconnect (off when gone)
+    publishHvacAction(false);
+    bOTGWthermostatpreviousstate = state.otBus.bThermostatState;
+  }
+
+  //OpenTherm is active when at least one side (boiler or thermostat) is communicating on the bus.
+  state.otBus.bOnline = state.otBus.bBoilerState || state.otBus.bThermostatState;
+  if ((state.otBus.bOnline != bOTGWpreviousstate) || (cntOTmessagesprocessed==1)){
+    publishOTGWConnectedState();
+    // nodeMCU online/offline zelf naar 'otgw-firmware/' pushen
+    bOTGWpreviousstate = state.otBus.bOnline; //remember state, so we can detect statechanges
+  }
+
+  //clear ot log buffer
+  ClrLog();
+  // The per-frame text line is read by telnet (OT trace) and text-mode WebSocket
+  // clients only; binary-mode clients decode the frame themselves (OTWsBinary.h).
+  // Nobody to read it: skip the snprintf work of the whole line.
+  if (!state.debug.bOTmsg && !hasWebSocketTextClients()) MuteLog();
+  // Start log with timestamp
+  AddLog(getOTLogTimestamp());
+  AddLog(" ");
+  
+  //process the OTGW message
+  memset(OTdata.buf, 0, sizeof(OTdata.buf));        // clear buffer
+  memcpy(OTdata.buf, buf, len);                     // copy the raw message to the buffer
+  OTdata.len = len;                                 // set the length of the message  
+  if (parsed != OT_FRAME_OK) return;                // payload not 8 hex digits, abort (was: sscanf failure)
+  //split 32bit value into the relevant OT protocol parts (decoded by otParseFrame)
+  OTdata.value = frame.value;                       // store the value
+  OTdata.type = frame.type;                         // byte 1 = take 3 bits that define msg msgType
+  OTdata.masterslave = frame.masterslave;           // MSB from type --> 0 = master and 1 = slave
+  OTdata.id = frame.id;                             // byte 2 = message id 8 bits 
+  OTdata.valueHB = frame.valueHB;                   // byte 3 = high byte
+  OTdata.valueLB = frame.valueLB;                   // byte 4 = low byte
+  if (!frame.parityOk && frame.source != OT_RAW_SRC_PARITY) {
+    // PIC and OT-direct only forward parity-checked frames as TBAR; a
+    // mismatch here means the line was mangled between UART and parser.
+    OTDebugTf(PSTR("OT frame %s fails parity check\r\n"), buf);
+  }
+  OTdata.time = millis();                           // time of reception    
+  OTdata.skipthis = false;                          // default: do not skip this message (parity errors only set this true)
+  OTdata.bGatewaySubstituted = false;               // default: not substituted by gateway (ADR-096)
+  OTdata.bAnswerOverride = false;                   // ADR-103: default proxy A (no preceding B)
+
+  if (cntOTmessagesprocessed == 1) {       //first message needs to be put in the buffer
+    // Boot-time one-shot: the very first OT frame has no prior delayed frame to pair
+    // against, so the (B,A) and (T,R) substitution-detection logic below cannot run.
+    // We store the raw frame with bAnswerOverride=false / bGatewaySubstituted=false
+    // initialised above. Worst case: if the first frame happens to be an A that was
+    // already an answer-override on the bus, it would reach _boiler/canonical once;
+    // the next (B,A) pair recomputes correctly and behaviour self-corrects. Bounded,
+    // intentional, one-shot drift — port from dev TASK-665.
+    delayedOTdata = OTdata;       //store current msg
+    OTDebugln(F("delaying first message!"));
+  } else {                              //any other message will be processed
+    // ADR-096 worldview semantics: when the gateway substitutes the bus traffic for an OT id
+    // (T → R on the master-side, or B → A on the slave-side response), the older (delayed)
+    // frame did not reach the *opposite* side. Earlier code marked the older frame as
+    // skipthis=true, which silently dropped the thermostat-side (or boiler-side) value
+    // entirely — the cause of the data-loss bug fixed by ADR-096. We now flag the older
+    // frame as bGatewaySubstituted=true; the publish-time worldview routing in
+    // publishToSourceTopic() then sends the value to the same-side subtopic only and
+    // suppresses canonical / opposite-side publication. The OT-bus log decoration ("<ignored>")
+    // is preserved as a diagnostic marker (see processOT log section).
+    // Pattern detection is unchanged from the original skipthis logic:
+    //   if T (master write) is followed within 500 ms by R (gateway-substituted write)
+    //     → T did not reach the boiler; R replaces it on canonical and /boiler.
+    //   if B (slave response) is followed within 500 ms by A (gateway-substituted answer)
+    //     → A reaches the thermostat instead of B; B still represents boiler-side reality.
+    bool bGatewaySubstituted = (delayedOTdata.id == OTdata.id) && (OTdata.time - delayedOTdata.time < 500) &&
+         (((OTdata.rsptype == OTGW_ANSWER_THERMOSTAT) && (delayedOTdata.rsptype == OTGW_BOILER)) ||
+          ((OTdata.rsptype == OTGW_REQUEST_BOILER) && (delayedOTdata.rsptype == OTGW_THERMOSTAT)));
+
+    //delay message processing by 1 message, to make sure detection of value decoding is done correctly with R and A message.
+    tmpOTdata = delayedOTdata;          //fetch delayed msg
+    delayedOTdata = OTdata;             //store current msg
+    // ADR-103: mark the incoming A (now the delayed frame) as an answer-override A iff a
+    // (B,A) pair was just detected. It rides the struct copy to the cycle that publishes
+    // it. A proxy A (no preceding B) keeps the init default 0 → reaches _boiler/canonical.
+    delayedOTdata.bAnswerOverride = bGatewaySubstituted && (delayedOTdata.rsptype == OTGW_ANSWER_THERMOSTAT);
+    OTdata = tmpOTdata;                 //then process delayed msg
+    OTdata.bGatewaySubstituted = bGatewaySubstituted;  //flag substitution if needed (ADR-096)
+
+    //when parity error in OTGW then skip data to MQTT nor store it local in data object
+    OTdata.skipthis = (OTdata.rsptype == OTGW_PARITY_ERROR);
+
+    //Read information from this OT message ready for use...
+    if (OTdata.id <= OT_MSGID_MAX) {
+      PROGMEM_readAnything (&OTmap[OTdata.id], OTlookupitem);
+    } else {
+      //unknown message id, set safe defaults to prevent OTmap OOB read
+      OTlookupitem.id = OTdata.id;
+      OTlookupitem.msgcmd = OT_UNDEF;
+      OTlookupitem.type = ot_undef;
+      OTlookupitem.label = "Unknown";
+      OTlookupitem.friendlyname = "Unknown";
+      OTlookupitem.unit = "";
+    }
+
+    // TASK-691 / TASK-692 / TASK-693 port (dev TASK-685/686/688): maintain
+    // the six per-msgID bitmaps that describe each side of the OT bus.
+    // Dirty flags fire only on 0->1 transitions so the periodic publishers
+    // (MQTT every minute, file every 15 min) do work exactly once per
+    // newly-discovered (id, direction).
+    {
+      const uint8_t idx  = OTdata.id >> 3;
+      const uint8_t mask = (uint8_t)(1u << (OTdata.id & 7));
+      if (OTdata.masterslave == 0) {
+        // Master frame — track thermostat-side requests.
+        if (OTdata.type == OT_WRITE_DATA) {
+          boilerLastMasterWasWrite[idx] |= mask;
+          if ((thermostatSentWrite[idx] & mask) == 0) {
+            thermostatSentWrite[idx] |= mask;
+            thermostatFileDirty = true;
+          }
+        } else if (OTdata.type == OT_READ_DATA) {
+          boilerLastMasterWasWrite[idx] &= ~mask;
+          if ((thermostatSentRead[idx] & mask) == 0) {
+            thermostatSentRead[idx] |= mask;
+            thermostatFileDirty = true;
+          }
+        }
+      } else {
+        // Slave frame — track boiler-side response classification.
+        if (OTdata.type == OT_READ_ACK) {
+          if ((boilerAckedRead[idx] & mask) == 0) {
+            boilerAckedRead[idx] |= mask;
+            boilerFileDirty = true;
+          }
+        } else if (OTdata.type == OT_WRITE_ACK) {
+          if ((boilerAckedWrite[idx] & mask) == 0) {
+            boilerAckedWrite[idx] |= mask;
+            boilerFileDirty = true;
+          }
+        } else if (OTdata.type == OT_UNKNOWN_DATA_ID) {
+          // Master direction is read from boilerLastMasterWasWrite (set on
+          // the preceding master frame). The slave's type-7 alone doesn't
+          // carry intent.
+          const bool isWriteCtx = (boilerLastMasterWasWrite[idx] & mask) != 0;
+          uint8_t * const bitmap = isWriteCtx ? boilerUnsupportedWrite : boilerUnsupportedRead;
+          if ((bitmap[idx] & mask) == 0) {
+            bitmap[idx] |= mask;
+            boilerUnsupportedDirty = true;  // MQTT republish (1-min cadence)
+            boilerFileDirty        = true;  // file write     (15-min cadence)
+          }
+        }
+      }
+    }
+
+    //keep track of last update time — only for valid responses
+    if (is_value_valid(OTdata, OTlookupitem)) {
+      setMsgLastUpdated(OTdata.id, currentTrackedSeconds(), OTdata.value);
+    }
+
+    // Queue MQTT HA discovery for this OT message ID if not yet published.
+    // Non-blocking: just sets the pending bit; drainOnePendingDiscovery()
+    // (3-second timer in main loop) handles the actual publish.
+    if (is_value_valid(OTdata, OTlookupitem) && settings.mqtt.bEnable) {
+      if (!getMQTTConfigDone(OTdata.id)) {
+        setMQTTConfigPending(OTdata.id);
+      }
+    }
+
+
+    // Decode and print OpenTherm Gateway Message
+    switch (OTdata.rsptype){
+      case OTGW_BOILER:
+        AddLog("Boiler            ");
+        break;
+      case OTGW_THERMOSTAT:
+        AddLog("Thermostat        ");
+        break;
+      case OTGW_REQUEST_BOILER:
+        AddLog("Request Boiler    ");
+        break;
+      case OTGW_ANSWER_THERMOSTAT:
+        AddLog("Answer Thermostat ");
+        break;
+      case OTGW_PARITY_ERROR:
+        AddLog("Parity Error      ");
+        break;
+      default:
+        AddLog("Unknown           ");
+        break;
+    }
+
+    //print message Type and ID
+    AddLogf(" %s %3d", OTdata.buf, OTdata.id);
+    AddLogf(" %-16s", messageTypeToString(static_cast<OTLibMessageType>(OTdata.type)));
+    //OTDebugf("[%-30s]", messageIDToString(static_cast<OTLibMessageID>(OTdata.id)));
+    //OTDebugf("[M=%d]",OTdata.master);
+
+    //Add indicators for parity error, gateway-substituted frame, or valid value (ADR-096)
+    if (OTdata.rsptype == OTGW_PARITY_ERROR) AddLog("P");
+    else if (OTdata.skipthis || OTdata.bGatewaySubstituted) AddLog("-");
+    else if (is_value_valid(OTdata, OTlookupitem)) AddLog(">");
+    else AddLog(" ");  //placeholder for alignment
+    
+    AddLog(" ");  // Space before payload for readability
+
+    //next step interpret the OT protocol
+    // OTPublishGate RAII: gate closes for this OT slot's throttle decision and
+    // is guaranteed to reopen (restore true) when the scope exits, even on early
+    // return. Non-OT sends (event_report, etc.) that follow are not affected. (ADR-006)
+    // ADR-104 Decision item 7: scope mqttPendingSlot commit to this OT frame.
+    // shouldPublishMQTTForID installs pending; capture the pre-publish success
+    // count, run decodeAndPublishOTValue, then commit if any sendMQTTData
+    // succeeded — else clear the pending so a later unrelated publish cannot
+    // silently commit it.
+    // MQTTPublishBatchScope: the whole fan-out of this frame (status bits,
+    // hvac_mode/action, source topics) shares one link/heap gate check.
+    {
+      MQTTPublishBatchScope batch;
+      const uint32_t preSuccessCount = mqttSendSuccessCount;
+      OTPublishGate gate(shouldPublishMQTTForID(OTdata.id, OTdata.masterslave, OTdata.value));
+      decodeAndPublishOTValue();
+      if (mqttPendingSlot.pending) {
+        if (mqttSendSuccessCount > preSuccessCount) confirmMQTTPublishSlot();
+        else                                        mqttPendingSlot.pending = false;
+      }
+    }
+
+    if (OTdata.skipthis || OTdata.bGatewaySubstituted) AddLog(" <ignored> ");
+    // TASK-691 / TASK-692 port (dev TASK-685/686): plain-English direction-
+    // aware suffix on slave Unknown-Data-Id. Emitted on every occurrence so
+    // a tester who opens telnet after the first such frame still sees the
+    // diagnostic context. The same suffix reaches the WebSocket OT Monitor
+    // via the shared ot_log_buffer.
+    if (OTdata.masterslave == 1 && OTdata.type == OT_UNKNOWN_DATA_ID) {
+      const uint8_t idx  = OTdata.id >> 3;
+      const uint8_t mask = (uint8_t)(1u << (OTdata.id & 7));
+      const bool isWriteCtx = (boilerLastMasterWasWrite[idx] & mask) != 0;
+      AddLog(isWriteCtx ? " (boiler rejected write)" : " (boiler does not implement)");
+    }
+    AddLogln();
+    OTDebugT(skipOTLogTimestamp(ot_log_buffer));
+
+    // Send log buffer directly to text-mode WebSocket clients (no JSON, no queue)
+    sendOTFrameLogToWebSocket(ot_log_buffer);
+
+    // Same frame as an 8-byte record for binary-mode clients, with the line's indicators as flags
+    if (hasWebSocketBinaryClients()) {
+      uint8_t flags = 0;
+      if (OTdata.rsptype != OTGW_PARITY_ERROR && !OTdata.skipthis && !OTdata.bGatewaySubstituted &&
+          is_value_valid(OTdata, OTlookupitem))                    flags |= OT_WS_BIN_F_VALID;
+      if (is_value_valid_for_master_topic(OTdata, OTlookupitem))  flags |= OT_WS_BIN_F_DECODED;
+      if (OTdata.skipthis || OTdata.bGatewaySubstituted)          flags |= OT_WS_BIN_F_IGNORED;
+      if (OTdata.bAnswerOverride)                                  flags |= OT_WS_BIN_F_ANSWER_OVR;
+      if (OTdata.masterslave == 1 && OTdata.type == OT_UNKNOWN_DATA_ID &&
+          (boilerLastMasterWasWrite[OTdata.id >> 3] & (uint8_t)(1u << (OTdata.id & 7))))
+                                                                   flags |= OT_WS_BIN_F_WRITE_CTX;
+      sendOTFrameToWebSocketBinary(OTdata.buf[0], flags, OTdata.value);
+    }
+
+    // Throttle TCP flush to once per second instead of per-message (~10/sec).
+    // debugTelnet (SimpleTelnet) buffers output; flushing just forces a TCP push.
+    // At 10 msg/sec the per-message flush was the single largest TCP cost.
+    { static unsigned long lastOTFlushMs = 0;
+      unsigned long now = millis();
+      if ((uint32_t)(now - lastOTFlushMs) >= 1000) {
+        OTDebugFlush();
+        lastOTFlushMs = now;
+      }
+    }
+    ClrLog();
+  } 
+}
+
+#endif // OTDECODE_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
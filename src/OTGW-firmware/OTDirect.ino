@@ -21,6 +21,7 @@
 #if HAS_DIRECT_OT
 
 #include <OpenTherm.h>
+#include "OTDirectSchedule.h"
 
 // ---------------------------------------------------------------------------
 // Per-module conditional debug — toggle with key '6' in telnet debug menu
@@ -50,13 +51,10 @@ static void clearRemoteOverride();
 static void onThermostatMsgID16(uint8_t msgType, uint16_t f88);
 
 // ---------------------------------------------------------------------------
-// Master request scheduler — periodic polls and writes to the boiler
+// Master request scheduler — periodic polls and writes to the boiler.
+// Poll intervals, OTScheduleEntry and the deadline scheduler live in
+// OTDirectSchedule.h.
 // ---------------------------------------------------------------------------
-static constexpr uint32_t OT_STATUS_INTERVAL_MS   = 800;    // MsgID 0 (status) every 800ms (OT-Thing parity)
-static constexpr uint32_t OT_OFFLINE_RETRY_MS     = 5000;   // When bus is offline: retry MsgID 0 every 5s, skip rest
-static constexpr uint32_t OT_TEMP_INTERVAL_MS     = 10000;  // Temperature reads every 10s
-static constexpr uint32_t OT_SLOW_INTERVAL_MS     = 60000;  // Slow-poll items every 60s
-static constexpr uint32_t OT_WRITE_INTERVAL_MS    = 15000;  // Periodic writes every 15s (keep boiler values alive)
 
 // Status flags to send in MsgID 0 (master status byte)
 static uint8_t otMasterStatusFlags = 0x01;  // bit0=CH enable (default on)
@@ -106,19 +104,10 @@ static bool otSummaryMode     = false;      // PS=1 active
 static bool otHideReports     = false;      // suppress T/B/R/A frame output
 static bool otSummaryPending  = false;      // summary line ready to emit
 
-// Schedule table: supports both reads and periodic writes.
-// Write entries periodically re-send a cached value to keep the boiler in sync.
-// Entries with `disabled = true` are skipped (auto-set on UNKNOWN_DATA_ID response).
-struct OTScheduleEntry {
-  uint8_t  msgId;
-  uint32_t intervalMs;
-  uint32_t lastSentMs;
-  bool     disabled;     // self-disabling: set true when boiler returns UNKNOWN_DATA_ID
-  bool     isWrite;      // true = send WRITE_DATA with cachedValue instead of READ_DATA
-  bool     valueSet;     // true = cachedValue has been set at least once
-  uint16_t cachedValue;  // f8.8 or raw value for writes
-};
-
+// Schedule table (OTScheduleEntry, see OTDirectSchedule.h).
+// Code that changes disabled/valueSet/lastSentMs of an entry after boot must
+// call otScheduleTouch(i), or otScheduleChanged() for bulk changes, so the
+// deadline scheduler re-keys it.
 // R = read-only entry, W = periodic write entry (inactive until value set by command)
 #define R_ENTRY(id, interval) { id, interval, 0, false, false, false, 0 }
 #define W_ENTRY(id, interval) { id, interval, 0, false, true,  false, 0 }
@@ -254,14 +243,42 @@ static OTScheduleEntry otSchedule[] = {
 #undef W_ENTRY
 
 static constexpr uint8_t OT_SCHEDULE_SIZE = sizeof(otSchedule) / sizeof(otSchedule[0]);
-static uint8_t otScheduleIdx = 0;
 
-// TASK-583: fast ventilation poll interval — 10s when slave app is vent/HRV.
+// Deadline scheduler over otSchedule[], and how long scheduleMasterRequest()
+// has nothing to do (otScheduleSleepMs counted from otScheduleSleepStartMs).
+// Anything that creates work earlier (command queued, entry touched) ends
+// the sleep.
+static OTDeadlineScheduler<OT_SCHEDULE_SIZE> otScheduler;
+static uint32_t otScheduleSleepStartMs = 0;
+static uint32_t otScheduleSleepMs = 0;
+
+static inline void otScheduleSleep(uint32_t now, uint32_t ms) {
+  otScheduleSleepStartMs = now;
+  otScheduleSleepMs = ms;
+}
+
+static inline void otScheduleWake() { otScheduleSleepMs = 0; }
+
+static inline bool otScheduleAwake() {
+  return (millis() - otScheduleSleepStartMs) >= otScheduleSleepMs;
+}
+
+static void otScheduleTouch(uint8_t i) {
+  otScheduler.touch(otSchedule, i, millis());
+  otScheduleWake();
+}
+
+static void otScheduleChanged() {
+  otScheduler.markDirty();
+  otScheduleWake();
+}
+
+// TASK-583: fast ventilation poll interval (OT_VENT_FAST_INTERVAL_MS, 10s)
+// when slave app is vent/HRV.
 // Only MsgIDs 70 (V/H status) and 71 (V/H setpoint) move to this tier;
 // diagnostic MsgIDs 72-76 remain in the 60s slow-poll tier.
 // See OT spec: slave config HB bits 6-7 = 0b10 indicates ventilation/HRV.
 // We also accept the cached MsgID 3 HB as a fallback if explicit bits differ.
-static constexpr uint32_t OT_VENT_FAST_INTERVAL_MS = 10000;  // 10s fast vent poll
 
 // Raw boiler response cache — forward-declared here so otIsVentSlave() can use
 // them; defined with initializers further below.
@@ -348,6 +365,7 @@ static bool otCmdEnqueue(uint32_t frame) {
     uint8_t existingMsgId = (otCmdQueue[i] >> 16) & 0xFF;
     if (existingMsgId == newMsgId) {
       otCmdQueue[i] = frame;
+      otScheduleWake();
       OTDDebugTf(PSTR("OTD: queue coalesced MsgID %u -> 0x%08lX\r\n"),
                  (unsigned)newMsgId, (unsigned long)frame);
       return true;
@@ -358,6 +376,7 @@ static bool otCmdEnqueue(uint32_t frame) {
   if (otCmdQueueFull()) return false;
   otCmdQueue[otCmdHead] = frame;
   otCmdHead = (otCmdHead + 1) % OT_CMD_QUEUE_SIZE;
+  otScheduleWake();
 
   // Track peak depth for diagnostic visibility. Normal operation should
   // keep this well below OT_CMD_QUEUE_SIZE; if it climbs, the producer
@@ -430,6 +449,8 @@ static constexpr uint8_t  OT_OVERRIDE_HONOR_THRESHOLD   = 3;   // cycles before
 // float to int16_t outside `[-128, 127]` is C/C++ undefined behaviour.
 // Every OTDirect call site that emits an f8.8 value to the bus must
 // route through this helper so the contract is checked exactly once.
+// Rounds to the nearest 1/256 (otF88FromFloat(), OTF88.h); the old
+// truncating cast sent 20.3 as 20.296875.
 //
 // -40..127 covers all realistic OT v4.2 setpoints (room, flow, DHW)
 // including the negative outliers a frost-protect or freezer-room
@@ -437,7 +458,7 @@ static constexpr uint8_t  OT_OVERRIDE_HONOR_THRESHOLD   = 3;   // cycles before
 static inline uint16_t floatToF88(float celsius) {
   if (celsius < -40.0f) celsius = -40.0f;
   if (celsius > 127.0f) celsius = 127.0f;
-  return (uint16_t)((int16_t)(celsius * 256.0f));
+  return (uint16_t)otF88FromFloat(celsius);
 }
 
 // TASK-442: PIC parity for CS/C2 heartbeat-driven expiry.
@@ -584,7 +605,10 @@ static void updateWriteCache(uint8_t msgId, uint16_t value) {
   for (uint8_t i = 0; i < OT_SCHEDULE_SIZE; i++) {
     if (otSchedule[i].isWrite && otSchedule[i].msgId == msgId) {
       otSchedule[i].cachedValue = value;
-      otSchedule[i].valueSet = true;
+      if (!otSchedule[i].valueSet) {
+        otSchedule[i].valueSet = true;
+        otScheduleTouch(i);
+      }
       return;
     }
   }
@@ -1056,6 +1080,57 @@ void sendOTDirectOverridesJSON() {
   restFinalize();
 }
 
+// ---------------------------------------------------------------------------
+// sendOTDirectScheduleJSON — requested vs achieved poll rate per schedule entry.
+// "requested_ms" is the interval the deadline scheduler is aiming for under
+// the current bus conditions (offline retry, vent fast-poll), "achieved_ms"
+// the smoothed interval between the sends that actually went out. Called from
+// restAPI.ino; caller sets CORS headers.
+// ---------------------------------------------------------------------------
+static const __FlashStringHelper* otScheduleClassName(uint8_t k) {
+  switch (k) {
+    case OT_SCHED_STATUS:    return F("status");
+    case OT_SCHED_WRITE:     return F("write");
+    case OT_SCHED_VENT_FAST: return F("vent_fast");
+    case OT_SCHED_POLL:      return F("poll");
+    case OT_SCHED_SLOW:      return F("slow");
+    default:                 return F("idle");
+  }
+}
+
+void sendOTDirectScheduleJSON() {
+  AsyncResponseStream* strm = restBeginStream("application/json");
+  if (strm) {
+    const uint32_t now = millis();
+    JsonEmit je(*strm);
+    je.beginObject();                  // root {
+    je.beginObject(F("schedule"));     // "schedule":{
+    je.field(F("bus_offline"), otScheduler.ctx.busOffline);
+    je.field(F("vent_fast"),   otScheduler.ctx.ventFast);
+    je.field(F("next_due_ms"), otScheduler.msUntilDue(now));
+    je.field(F("rebuilds"),    otScheduler.rebuilds);
+    je.beginArray(F("entries"));
+    for (uint8_t i = 0; i < OT_SCHEDULE_SIZE; i++) {
+      const OTScheduleEntry &e = otSchedule[i];
+      const OTScheduleStats &st = otScheduler.stats[i];
+      je.beginObject();
+      je.field(F("msgid"),        (uint32_t)e.msgId);
+      je.field(F("class"),        otScheduleClassName(otScheduler.queued(i) ? otScheduler.cls[i] : OT_SCHED_NOT_QUEUED));
+      je.field(F("write"),        e.isWrite);
+      je.field(F("disabled"),     e.disabled);
+      je.field(F("requested_ms"), otScheduleInterval(e, otScheduler.ctx));
+      je.field(F("achieved_ms"),  st.achievedMs);
+      je.field(F("sent"),         st.sent);
+      je.field(F("max_late_ms"),  st.maxLateMs);
+      je.endObject();
+    }
+    je.endArray();
+    je.endObject();                    // close "schedule"
+    je.endObject();                    // close root
+  }
+  restFinalize();
+}
+
 // ---------------------------------------------------------------------------
 // Loopback test mode — simulated boiler data table
 // Provides realistic OT values so the full stack (parser, MQTT, WebSocket,
@@ -1304,6 +1379,7 @@ static void handleMasterResponse() {
           for (uint8_t i = 0; i < OT_SCHEDULE_SIZE; i++) {
             if (otSchedule[i].msgId == respMsgId && !otSchedule[i].disabled) {
               otSchedule[i].disabled = true;
+              otScheduleTouch(i);
               OTDDebugTf(PSTR("OTD: MsgID %u disabled (3x UNKNOWN_DATA_ID)\r\n"), respMsgId);
               break;
             }
@@ -1386,7 +1462,9 @@ static void handleMasterResponse() {
 }
 
 // ---------------------------------------------------------------------------
-// scheduleMasterRequest — pick next scheduled message and send async
+// scheduleMasterRequest — pick next scheduled message and send async.
+// Earliest deadline first within priority classes (OTDirectSchedule.h); sets
+// the scheduler to sleep until the next time there can be something to send.
 // ---------------------------------------------------------------------------
 static void scheduleMasterRequest() {
   // Don't schedule if master is already busy (collision avoidance)
@@ -1395,7 +1473,10 @@ static void scheduleMasterRequest() {
   uint32_t now = millis();
 
   // MI= global minimum inter-message gap
-  if ((now - otLastAnySendMs) < otMinIntervalMs) return;
+  if ((now - otLastAnySendMs) < otMinIntervalMs) {
+    otScheduleSleep(now, otMinIntervalMs - (now - otLastAnySendMs));
+    return;
+  }
 
   // Pending commands from the ring buffer take priority.
   // Peek first — only dequeue after successful async send (Codex P1 fix).
@@ -1403,62 +1484,52 @@ static void scheduleMasterRequest() {
     uint32_t cmdFrame = otCmdQueue[otCmdTail];
     if (sendMasterRequestAsync(cmdFrame, OT_DIRECT_ORIGIN_GATEWAY)) {
       otCmdTail = (otCmdTail + 1) % OT_CMD_QUEUE_SIZE;  // consume on success
+      otScheduleWake();
+    } else {
+      otScheduleSleep(now, OT_SCHEDULE_RETRY_MS);
     }
     return;
   }
 
-  // When the bus is offline: only probe MsgID 0 at a slow rate — no point
-  // cycling through the full schedule if nobody is home.
-  bool busOffline = !state.otBus.bOnline;
+  // When the bus is offline only MsgID 0 is eligible, at OT_OFFLINE_RETRY_MS —
+  // no point cycling through the full schedule if nobody is home.
+  // TASK-583: MsgID 70 (V/H status) and 71 (V/H setpoint) move to the fast-poll
+  // class when the slave configuration (MsgID 3 HB bits 6-7 == 0b11) indicates
+  // a ventilation/HRV application. MsgIDs 72-76 remain in the slow-poll tier.
+  OTScheduleContext ctx = { !state.otBus.bOnline, otIsVentSlave() };
 
-  // Round-robin through the schedule table, skipping disabled entries
-  uint8_t startIdx = otScheduleIdx;
-  do {
-    OTScheduleEntry &entry = otSchedule[otScheduleIdx];
-    otScheduleIdx = (otScheduleIdx + 1) % OT_SCHEDULE_SIZE;
-
-    if (entry.disabled) continue;  // boiler doesn't support this MsgID
-
-    // Offline: skip everything except MsgID 0 (the online/offline probe)
-    if (busOffline && entry.msgId != 0) continue;
-
-    // Write entries only fire when a value has been set by a command
-    if (entry.isWrite && !entry.valueSet) continue;
-
-    // Offline: use slow retry interval for MsgID 0 to avoid hammering a dead bus
-    uint32_t interval = (busOffline && entry.msgId == 0) ? OT_OFFLINE_RETRY_MS : entry.intervalMs;
-    // TASK-583: promote MsgID 70 (V/H status) and 71 (V/H setpoint) to fast-poll
-    // when the slave configuration (MsgID 3 HB bits 6-7 == 0b11) indicates a
-    // ventilation/HRV application.  MsgIDs 72-76 remain in the slow-poll tier.
-    if ((entry.msgId == 70 || entry.msgId == 71) && otIsVentSlave()) {
-      interval = OT_VENT_FAST_INTERVAL_MS;
-    }
+  int idx = otScheduler.pick(otSchedule, OT_SCHEDULE_SIZE, ctx, now);
+  if (idx < 0) {
+    otScheduleSleep(now, otScheduler.msUntilDue(now));
+    return;
+  }
 
-    if ((now - entry.lastSentMs) >= interval) {
-      unsigned long request;
-      if (entry.msgId == 0) {
-        request = buildStatusRequest();
-      } else if (entry.isWrite) {
-        // Periodic write: send WRITE_DATA with cached value
-        request = OpenTherm::buildRequest(
-          OpenThermMessageType::WRITE_DATA,
-          static_cast<OpenThermMessageID>(entry.msgId),
-          entry.cachedValue
-        );
-      } else {
-        request = OpenTherm::buildRequest(
-          OpenThermMessageType::READ_DATA,
-          static_cast<OpenThermMessageID>(entry.msgId),
-          0
-        );
-      }
+  OTScheduleEntry &entry = otSchedule[idx];
+  unsigned long request;
+  if (entry.msgId == 0) {
+    request = buildStatusRequest();
+  } else if (entry.isWrite) {
+    // Periodic write: send WRITE_DATA with cached value
+    request = OpenTherm::buildRequest(
+      OpenThermMessageType::WRITE_DATA,
+      static_cast<OpenThermMessageID>(entry.msgId),
+      entry.cachedValue
+    );
+  } else {
+    request = OpenTherm::buildRequest(
+      OpenThermMessageType::READ_DATA,
+      static_cast<OpenThermMessageID>(entry.msgId),
+      0
+    );
+  }
 
-      if (sendMasterRequestAsync(request, OT_DIRECT_ORIGIN_GATEWAY)) {
-        entry.lastSentMs = now;  // Only advance timer on successful send
-      }
-      return;  // One request per call
-    }
-  } while (otScheduleIdx != startIdx);
+  if (sendMasterRequestAsync(request, OT_DIRECT_ORIGIN_GATEWAY)) {
+    otScheduler.sent(otSchedule, (uint8_t)idx, now);  // Only advance timer on successful send
+    otScheduleSleep(now, otScheduler.msUntilDue(now));
+  } else {
+    otScheduleSleep(now, OT_SCHEDULE_RETRY_MS);       // bus busy or TX blocked: one legacy tick
+  }
+  // One request per call
 }
 
 // ---------------------------------------------------------------------------
@@ -1637,6 +1708,7 @@ static void loopPiCtrl() {
   for (uint8_t i = 0; i < OT_SCHEDULE_SIZE; i++) {
     if (otSchedule[i].msgId == 1 && otSchedule[i].isWrite) {
       otSchedule[i].lastSentMs = 0;  // force immediate send
+      otScheduleTouch(i);
       break;
     }
   }
@@ -1990,10 +2062,11 @@ void loopOTDirect() {
     }
   }
 
-  // Schedule periodic master requests (non-blocking, skips if bus busy)
+  // Schedule periodic master requests (non-blocking, skips if bus busy).
+  // Only consulted once the previous pass said there is work: a deadline
+  // passed, the MI= gap ran out, or a command/entry change woke it early.
   // In monitor mode the gateway must not inject its own frames — transparent pass-through only.
-  DECLARE_TIMER_MS(timerOTSchedule, 100, SKIP_MISSED_TICKS);
-  if (DUE(timerOTSchedule) && !IS_MONITOR_MODE()) {
+  if (!IS_MONITOR_MODE() && !otMasterRequestActive && otScheduleAwake()) {
     scheduleMasterRequest();
   }
 
@@ -2151,6 +2224,7 @@ static void clearWriteOverride(uint8_t msgId) {
   for (uint8_t i = 0; i < OT_SCHEDULE_SIZE; i++) {
     if (otSchedule[i].isWrite && otSchedule[i].msgId == msgId) {
       otSchedule[i].valueSet = false;
+      otScheduleTouch(i);
       break;
     }
   }
@@ -2330,6 +2404,7 @@ static void resetTransientState() {
   for (uint8_t i = 0; i < OT_SCHEDULE_SIZE; i++) {
     otSchedule[i].valueSet = false;
   }
+  otScheduleChanged();
   // Clear repeater overrides
   for (uint8_t i = 0; i < OT_OVERRIDE_COUNT; i++) {
     otOverrides[i].active = false;
@@ -3056,10 +3131,10 @@ void handleOTDirectCommand(const char* buf, int len) {
         // Falls back to CS (boiler control setpoint) if no TT/TC is active
         // and a CS override is in force.
         if (otRemoteOverride.mode == OT_OVERRIDE_TEMPORARY) {
-          dtostrf((int16_t)otRemoteOverride.f88Value / 256.0f, 1, 2, rspBuf);
+          otF88Format((int16_t)otRemoteOverride.f88Value, rspBuf, sizeof(rspBuf));
           snprintf_P(prBuf, sizeof(prBuf), PSTR("PR: O=T%s"), rspBuf);
         } else if (otRemoteOverride.mode == OT_OVERRIDE_CONSTANT) {
-          dtostrf((int16_t)otRemoteOverride.f88Value / 256.0f, 1, 2, rspBuf);
+          otF88Format((int16_t)otRemoteOverride.f88Value, rspBuf, sizeof(rspBuf));
           snprintf_P(prBuf, sizeof(prBuf), PSTR("PR: O=C%s"), rspBuf);
         } else {
           // No TT/TC: check for a CS (MsgID 1) flow setpoint override.
@@ -3071,7 +3146,7 @@ void handleOTDirectCommand(const char* buf, int len) {
             }
           }
           if (csActive) {
-            dtostrf((int16_t)csVal / 256.0f, 1, 2, rspBuf);
+            otF88Format((int16_t)csVal, rspBuf, sizeof(rspBuf));
             snprintf_P(prBuf, sizeof(prBuf), PSTR("PR: O=C%s"), rspBuf);
           } else {
             snprintf_P(prBuf, sizeof(prBuf), PSTR("PR: O=N"));
@@ -3189,6 +3264,7 @@ void handleOTDirectCommand(const char* buf, int len) {
     for (uint8_t i = 0; i < OT_SCHEDULE_SIZE; i++) {
       if (otSchedule[i].msgId == msgId) {
         otSchedule[i].disabled = false;
+        otScheduleTouch(i);
         found = true; break;
       }
     }
@@ -3209,6 +3285,7 @@ void handleOTDirectCommand(const char* buf, int len) {
     for (uint8_t i = 0; i < OT_SCHEDULE_SIZE; i++) {
       if (otSchedule[i].msgId == msgId) {
         otSchedule[i].disabled = true;
+        otScheduleTouch(i);
         found = true; break;
       }
     }
@@ -3227,6 +3304,7 @@ void handleOTDirectCommand(const char* buf, int len) {
       if (otSchedule[i].msgId == msgId) {
         otSchedule[i].lastSentMs = 0;  // force immediate on next cycle
         otSchedule[i].disabled = false; // re-enable if it was disabled
+        otScheduleTouch(i);
         found = true; break;
       }
     }
@@ -3328,7 +3406,7 @@ void handleOTDirectCommand(const char* buf, int len) {
     }
     // Also disable from schedule so we stop polling it
     for (uint8_t i = 0; i < OT_SCHEDULE_SIZE; i++) {
-      if (otSchedule[i].msgId == msgId) { otSchedule[i].disabled = true; break; }
+      if (otSchedule[i].msgId == msgId) { otSchedule[i].disabled = true; otScheduleTouch(i); break; }
     }
     snprintf_P(rspBuf, sizeof(rspBuf), PSTR("%d"), msgId);
     synthesizeResponse(buf, rspBuf);
@@ -3346,7 +3424,7 @@ void handleOTDirectCommand(const char* buf, int len) {
     clearUnknownCount(msgId);  // Reset 3-strike counter
     // Re-enable in schedule
     for (uint8_t i = 0; i < OT_SCHEDULE_SIZE; i++) {
-      if (otSchedule[i].msgId == msgId) { otSchedule[i].disabled = false; break; }
+      if (otSchedule[i].msgId == msgId) { otSchedule[i].disabled = false; otScheduleTouch(i); break; }
     }
     snprintf_P(rspBuf, sizeof(rspBuf), PSTR("%d"), msgId);
     synthesizeResponse(buf, rspBuf);
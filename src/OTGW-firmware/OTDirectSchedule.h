@@ -0,0 +1,341 @@
+/*
+***************************************************************************
+**  Program  : OTDirectSchedule.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Deadline-driven master request scheduler for OTDirect (OTGW32).
+**
+**  scheduleMasterRequest() used to run from a fixed 100 ms timer and walk
+**  otSchedule[] round-robin, testing (now - lastSentMs) >= interval per entry
+**  until it found one to send. That costs a table scan per tick even when
+**  nothing is due, and it serves overdue entries in table order: when the
+**  ~80 slow-poll reads all come due in the same second, the status poll
+**  (MsgID 0, mandatory at least once per second) waits for the whole run.
+**
+**  This keeps otSchedule[] as the single source of truth and adds an index
+**  over it:
+**
+**    classes   every eligible entry is in exactly one priority class:
+**              status (MsgID 0) > writes > ventilation fast-poll (TASK-583)
+**              > temperature poll > slow poll. The highest class with a due
+**              entry is served first.
+**    heaps     one binary min-heap per class on the entry's deadline
+**              (lastSentMs + interval, most overdue first, then table order).
+**              Picking, re-keying after a send and the next wake time are
+**              O(log n) / O(classes) instead of a table scan.
+**    eligible  disabled entries, write entries without a value and, while
+**              the bus is offline, everything but MsgID 0 are not in any
+**              heap. Code that changes those flags (or lastSentMs) calls
+**              touch() for one entry or markDirty() for a bulk change.
+**
+**  Due-ness is still the legacy (now - lastSentMs) >= interval compare, so
+**  the force-immediate idiom (lastSentMs = 0) and millis() wraparound behave
+**  exactly as before; the heap only decides the order.
+**
+**  Per entry the scheduler also records what the bus actually delivered
+**  (sends, smoothed achieved interval, worst lateness) for the REST
+**  /api/v2/otdirect/schedule endpoint.
+**
+**  No Arduino dependency: tests/bench_otdirect_schedule.cpp includes this
+**  header and replays it against the legacy round-robin on a simulated bus.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTDIRECTSCHEDULE_H
+#define OTDIRECTSCHEDULE_H
+
+#include <stdint.h>
+#include <string.h>
+
+static constexpr uint32_t OT_STATUS_INTERVAL_MS    = 800;    // MsgID 0 (status) every 800ms (OT-Thing parity)
+static constexpr uint32_t OT_OFFLINE_RETRY_MS      = 5000;   // When bus is offline: retry MsgID 0 every 5s, skip rest
+static constexpr uint32_t OT_TEMP_INTERVAL_MS      = 10000;  // Temperature reads every 10s
+static constexpr uint32_t OT_SLOW_INTERVAL_MS      = 60000;  // Slow-poll items every 60s
+static constexpr uint32_t OT_WRITE_INTERVAL_MS     = 15000;  // Periodic writes every 15s (keep boiler values alive)
+static constexpr uint32_t OT_VENT_FAST_INTERVAL_MS = 10000;  // TASK-583: MsgID 70/71 on a vent/HRV slave
+static constexpr uint32_t OT_SCHEDULE_RETRY_MS     = 100;    // bus refused a send: try again after one legacy tick
+static constexpr uint32_t OT_SCHEDULE_IDLE_MS      = 1000;   // nothing eligible: look again after this
+static constexpr uint32_t OT_SCHEDULE_STALE_MS     = 3600000UL; // scheduler not consulted for 1h: re-key all
+
+// Schedule table: supports both reads and periodic writes.
+// Write entries periodically re-send a cached value to keep the boiler in sync.
+// Entries with `disabled = true` are skipped (auto-set on UNKNOWN_DATA_ID response).
+struct OTScheduleEntry {
+  uint8_t  msgId;
+  uint32_t intervalMs;
+  uint32_t lastSentMs;
+  bool     disabled;     // self-disabling: set true when boiler returns UNKNOWN_DATA_ID
+  bool     isWrite;      // true = send WRITE_DATA with cachedValue instead of READ_DATA
+  bool     valueSet;     // true = cachedValue has been set at least once
+  uint16_t cachedValue;  // f8.8 or raw value for writes
+};
+
+enum OTScheduleClass : uint8_t {
+  OT_SCHED_STATUS = 0,   // MsgID 0
+  OT_SCHED_WRITE,        // periodic writes with a value set
+  OT_SCHED_VENT_FAST,    // MsgID 70/71 while the slave is a vent/HRV unit
+  OT_SCHED_POLL,         // reads at OT_TEMP_INTERVAL_MS or faster
+  OT_SCHED_SLOW,         // everything else
+  OT_SCHED_CLASS_COUNT
+};
+
+#define OT_SCHED_NOT_QUEUED 0xFF
+
+// Bus conditions that change which entries are eligible and at what rate.
+struct OTScheduleContext {
+  bool busOffline;   // !state.otBus.bOnline
+  bool ventFast;     // otIsVentSlave()
+};
+
+inline bool otScheduleEligible(const OTScheduleEntry &e, const OTScheduleContext &ctx)
+{
+  if (e.disabled) return false;                        // boiler doesn't support this MsgID
+  if (ctx.busOffline && e.msgId != 0) return false;    // offline: only probe MsgID 0
+  if (e.isWrite && !e.valueSet) return false;          // writes fire once a command set a value
+  return true;
+}
+
+// Requested interval for an entry under the current bus conditions.
+inline uint32_t otScheduleInterval(const OTScheduleEntry &e, const OTScheduleContext &ctx)
+{
+  if (ctx.busOffline && e.msgId == 0) return OT_OFFLINE_RETRY_MS;
+  if (ctx.ventFast && (e.msgId == 70 || e.msgId == 71)) return OT_VENT_FAST_INTERVAL_MS;
+  return e.intervalMs;
+}
+
+inline uint8_t otScheduleClassOf(const OTScheduleEntry &e, const OTScheduleContext &ctx)
+{
+  if (e.msgId == 0) return OT_SCHED_STATUS;
+  if (e.isWrite) return OT_SCHED_WRITE;
+  if (ctx.ventFast && (e.msgId == 70 || e.msgId == 71)) return OT_SCHED_VENT_FAST;
+  if (e.intervalMs <= OT_TEMP_INTERVAL_MS) return OT_SCHED_POLL;
+  return OT_SCHED_SLOW;
+}
+
+// What the bus delivered for one entry.
+struct OTScheduleStats {
+  uint32_t sent;         // requests put on the bus
+  uint32_t achievedMs;   // smoothed interval between sends (EWMA 1/8), 0 before the 2nd send
+  uint32_t maxLateMs;    // worst gap between two sends beyond the requested interval
+  uint32_t lastTxMs;     // millis() of the last send (lastSentMs can be reset to force a poll)
+};
+
+template <uint8_t Capacity>
+struct OTDeadlineScheduler {
+  static_assert(Capacity >= 1 && Capacity < OT_SCHED_NOT_QUEUED, "OTDeadlineScheduler capacity must be 1..254");
+
+  uint32_t due[Capacity];                          // deadline key per entry
+  uint8_t  cls[Capacity];                          // class per entry, OT_SCHED_NOT_QUEUED if ineligible
+  uint8_t  heapPos[Capacity];                      // position within heap[cls[i]]
+  uint8_t  heap[OT_SCHED_CLASS_COUNT][Capacity];
+  uint8_t  count[OT_SCHED_CLASS_COUNT];
+  OTScheduleStats stats[Capacity];
+  OTScheduleContext ctx;
+  uint8_t  size;                                   // entries in the table
+  bool     dirty;
+  uint32_t lastUsedMs;
+  uint32_t rebuilds;
+
+  OTDeadlineScheduler() { clear(); }
+
+  void clear()
+  {
+    memset(due, 0, sizeof(due));
+    memset(cls, OT_SCHED_NOT_QUEUED, sizeof(cls));
+    memset(heapPos, 0, sizeof(heapPos));
+    memset(count, 0, sizeof(count));
+    memset(stats, 0, sizeof(stats));
+    ctx = OTScheduleContext{ false, false };
+    size = 0;
+    dirty = true;
+    lastUsedMs = 0;
+    rebuilds = 0;
+  }
+
+  // Bulk change to otSchedule[] (reset, several entries at once): re-key
+  // everything on the next pick.
+  void markDirty() { dirty = true; }
+
+  // Re-key all n entries of tab under ctx.
+  void rebuild(const OTScheduleEntry *tab, uint8_t n, const OTScheduleContext &c, uint32_t now)
+  {
+    if (n > Capacity) n = Capacity;
+    size = n;
+    ctx = c;
+    memset(count, 0, sizeof(count));
+    memset(cls, OT_SCHED_NOT_QUEUED, sizeof(cls));
+    for (uint8_t i = 0; i < n; i++) {
+      if (!otScheduleEligible(tab[i], ctx)) continue;
+      const uint8_t k = otScheduleClassOf(tab[i], ctx);
+      due[i] = deadline(tab[i], now);
+      cls[i] = k;
+      heapPos[i] = count[k];
+      heap[k][count[k]++] = i;
+    }
+    for (uint8_t k = 0; k < OT_SCHED_CLASS_COUNT; k++) {
+      for (int p = (int)count[k] / 2 - 1; p >= 0; p--) siftDown(k, (uint8_t)p);
+    }
+    dirty = false;
+    lastUsedMs = now;
+    rebuilds++;
+  }
+
+  // Entry i changed (disabled, valueSet, lastSentMs): re-key just that entry.
+  void touch(const OTScheduleEntry *tab, uint8_t i, uint32_t now)
+  {
+    if (dirty || i >= size) return;   // a rebuild is pending anyway
+    unlink(i);
+    if (!otScheduleEligible(tab[i], ctx)) return;
+    const uint8_t k = otScheduleClassOf(tab[i], ctx);
+    due[i] = deadline(tab[i], now);
+    cls[i] = k;
+    heapPos[i] = count[k];
+    heap[k][count[k]++] = i;
+    siftUp(k, heapPos[i]);
+  }
+
+  // Entry to send now: the most overdue entry of the highest class that has
+  // one due, or -1. Rebuilds first when marked dirty, when the bus
+  // conditions changed or when the keys went stale.
+  int pick(const OTScheduleEntry *tab, uint8_t n, const OTScheduleContext &c, uint32_t now)
+  {
+    if (dirty || n != size || c.busOffline != ctx.busOffline || c.ventFast != ctx.ventFast ||
+        (uint32_t)(now - lastUsedMs) >= OT_SCHEDULE_STALE_MS) {
+      rebuild(tab, n, c, now);
+    }
+    lastUsedMs = now;
+    for (uint8_t k = 0; k < OT_SCHED_CLASS_COUNT; k++) {
+      if (!count[k]) continue;
+      const uint8_t i = heap[k][0];
+      if ((uint32_t)(now - tab[i].lastSentMs) >= otScheduleInterval(tab[i], ctx)) return i;
+    }
+    return -1;
+  }
+
+  // Entry i went out on the bus at now: update its stats, advance lastSentMs
+  // and re-key it.
+  void sent(OTScheduleEntry *tab, uint8_t i, uint32_t now)
+  {
+    if (i >= size) return;
+    OTScheduleStats &s = stats[i];
+    if (s.sent > 0) {
+      const uint32_t gap = now - s.lastTxMs;
+      const uint32_t interval = otScheduleInterval(tab[i], ctx);
+      if (gap > interval && gap - interval > s.maxLateMs) s.maxLateMs = gap - interval;
+      if (s.achievedMs == 0) s.achievedMs = gap;
+      else s.achievedMs = (uint32_t)((int32_t)s.achievedMs + ((int32_t)(gap - s.achievedMs) >> 3));
+    }
+    s.sent++;
+    s.lastTxMs = now;
+    tab[i].lastSentMs = now;
+    touch(tab, i, now);
+  }
+
+  // Time from now until the earliest deadline over all classes (0 when
+  // something is overdue), for sleeping until there is work.
+  // OT_SCHEDULE_IDLE_MS when nothing is eligible.
+  uint32_t msUntilDue(uint32_t now) const
+  {
+    bool any = false;
+    int32_t best = 0;
+    for (uint8_t k = 0; k < OT_SCHED_CLASS_COUNT; k++) {
+      if (!count[k]) continue;
+      const int32_t d = (int32_t)(due[heap[k][0]] - now);
+      if (!any || d < best) best = d;
+      any = true;
+    }
+    if (!any) return OT_SCHEDULE_IDLE_MS;
+    return best > 0 ? (uint32_t)best : 0;
+  }
+
+  bool queued(uint8_t i) const { return i < size && cls[i] != OT_SCHED_NOT_QUEUED; }
+
+private:
+  // Deadline key. Overdue entries are keyed by how late they are (clamped),
+  // so the key stays within int32 range of now however long the entry sat.
+  uint32_t deadline(const OTScheduleEntry &e, uint32_t now) const
+  {
+    const uint32_t interval = otScheduleInterval(e, ctx);
+    const uint32_t elapsed = now - e.lastSentMs;
+    if (elapsed < interval) return e.lastSentMs + interval;
+    uint32_t late = elapsed - interval;
+    if (late > 0x3FFFFFFFUL) late = 0x3FFFFFFFUL;
+    return now - late;
+  }
+
+  bool before(uint8_t a, uint8_t b) const
+  {
+    const int32_t d = (int32_t)(due[a] - due[b]);
+    return d < 0 || (d == 0 && a < b);
+  }
+
+  void unlink(uint8_t i)
+  {
+    const uint8_t k = cls[i];
+    if (k == OT_SCHED_NOT_QUEUED) return;
+    const uint8_t pos = heapPos[i];
+    const uint8_t last = (uint8_t)(count[k] - 1);
+    cls[i] = OT_SCHED_NOT_QUEUED;
+    count[k] = last;
+    if (pos == last) return;
+    const uint8_t moved = heap[k][last];
+    heap[k][pos] = moved;
+    heapPos[moved] = pos;
+    siftUp(k, pos);
+    siftDown(k, heapPos[moved]);
+  }
+
+  void swap(uint8_t k, uint8_t p, uint8_t q)
+  {
+    const uint8_t a = heap[k][p], b = heap[k][q];
+    heap[k][p] = b; heapPos[b] = p;
+    heap[k][q] = a; heapPos[a] = q;
+  }
+
+  void siftUp(uint8_t k, uint8_t p)
+  {
+    while (p > 0) {
+      const uint8_t parent = (uint8_t)((p - 1) / 2);
+      if (!before(heap[k][p], heap[k][parent])) break;
+      swap(k, p, parent);
+      p = parent;
+    }
+  }
+
+  void siftDown(uint8_t k, uint8_t p)
+  {
+    for (;;) {
+      const unsigned l = 2u * p + 1, r = l + 1;
+      uint8_t m = p;
+      if (l < count[k] && before(heap[k][l], heap[k][m])) m = (uint8_t)l;
+      if (r < count[k] && before(heap[k][r], heap[k][m])) m = (uint8_t)r;
+      if (m == p) break;
+      swap(k, p, m);
+      p = m;
+    }
+  }
+};
+
+#endif // OTDIRECTSCHEDULE_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
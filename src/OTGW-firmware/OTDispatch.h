@@ -0,0 +1,363 @@
+/*
+***************************************************************************
+**  Program  : OTDispatch.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  OTDispatch[]: one descriptor per OpenTherm message id (0-255), built at
+**  compile time from the OTD_ROW list below and OTmap[]. Replaces the six
+**  decodeAndPublish*Value() switches and the getOTGWValue() switch in
+**  OTGW-Core.ino, which had to be kept in step by hand:
+**
+**    decoder    OTDecodeKind, an index into otDecoders[] in OTGW-Core.ino
+**               (print_f88, print_status, ...); OTDEC_NONE = unknown id.
+**    type       OTmap[id].type (ot_undef past OT_MSGID_MAX).
+**    flags      OTD_FLAG_DEFINED     the id has a decoder and a state field
+**               OTD_FLAG_STATUS_GATE MQTT uses the status byte/bit gates
+**               OTD_FLAG_UNTRACKED   id > 127, no MQTT throttle slot
+**    fieldKind  float / int16_t / uint16_t, from the declared field type.
+**    offset     offsetof(OTdataStruct, field) of the decoded value.
+**
+**  The label is not stored: OTmap[] row i is message id i (asserted below),
+**  so OTmap[id] stays the label lookup.
+**
+**  The static_asserts below turn a row that names the wrong decoder for the
+**  OTmap[] type, a decoder that takes a different field type, a duplicate id
+**  or an OTmap[] row out of order into a build error. No Arduino dependency:
+**  tests/bench_ot_dispatch.cpp checks the table against the old switches and
+**  times the lookup.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTDISPATCH_H
+#define OTDISPATCH_H
+
+#include <stddef.h>      // offsetof
+#include <stdint.h>
+#include "OTmap.h"
+#include "OTdataStruct.h"
+
+// One per print_* decoder in OTGW-Core.ino; otDecoders[] is indexed by it.
+enum OTDecodeKind : uint8_t {
+  OTDEC_NONE = 0,
+  OTDEC_F88,                              // print_f88(float&)
+  OTDEC_S16,                              // print_s16(int16_t&)
+  OTDEC_S8S8,                             // the rest take uint16_t&
+  OTDEC_U16,
+  OTDEC_U8U8,
+  OTDEC_U8_HB,
+  OTDEC_U8_LB,
+  OTDEC_FLAG8U8,
+  OTDEC_STATUS,
+  OTDEC_STATUS_VH,
+  OTDEC_ASF_FLAGS,
+  OTDEC_RBP_FLAGS,
+  OTDEC_MASTER_MEMBERID,
+  OTDEC_SLAVE_MEMBERID,
+  OTDEC_COMMAND,
+  OTDEC_DATE,
+  OTDEC_DAYTIME,
+  OTDEC_REMOTE_OVERRIDE_FN,
+  OTDEC_VH_CONFIG_MEMBERID,
+  OTDEC_VH_REMOTE_PARAM,
+  OTDEC_RF_SENSOR,
+  OTDEC_OPERATING_MODE,
+  OTDEC_SOLAR_STATUS,
+  OTDEC_SOLAR_SLAVE_MEMBERID,
+  OTDEC_COUNT
+};
+
+enum OTFieldKind : uint8_t {
+  OTFIELD_NONE = 0,
+  OTFIELD_FLOAT,
+  OTFIELD_S16,
+  OTFIELD_U16
+};
+
+#define OTD_FLAG_DEFINED      0x01
+#define OTD_FLAG_STATUS_GATE  0x02
+#define OTD_FLAG_UNTRACKED    0x04
+
+#define OTD_TABLE_SIZE        256        // every value of the 8-bit id byte
+
+struct OTDispatchEntry {
+  uint8_t  decoder;                       // OTDecodeKind
+  uint8_t  type;                          // OTtype_t
+  uint8_t  flags;                         // OTD_FLAG_*
+  uint8_t  fieldKind;                     // OTFieldKind
+  uint16_t offset;                        // into OTdataStruct
+};
+
+template <typename T> struct OTFieldKindOf          { static constexpr uint8_t value = OTFIELD_NONE; };
+template <>           struct OTFieldKindOf<float>    { static constexpr uint8_t value = OTFIELD_FLOAT; };
+template <>           struct OTFieldKindOf<int16_t>  { static constexpr uint8_t value = OTFIELD_S16; };
+template <>           struct OTFieldKindOf<uint16_t> { static constexpr uint8_t value = OTFIELD_U16; };
+
+struct OTDispatchRow {
+  uint8_t  id;
+  uint8_t  decoder;
+  uint8_t  fieldKind;
+  uint16_t offset;
+};
+
+#define OTD_ROW(id, dec, field) \
+  { (uint8_t)(id), (dec), OTFieldKindOf<decltype(OTdataStruct::field)>::value, (uint16_t)offsetof(OTdataStruct, field) }
+
+// Message id -> decoder -> OTcurrentSystemState field, in id order.
+// OT_SolarStorageMaster decodes into SolarStorageStatus (there is no
+// separate master field).
+constexpr OTDispatchRow OTDispatchRows[] = {
+  OTD_ROW(OT_Statusflags,                         OTDEC_STATUS,               Statusflags),
+  OTD_ROW(OT_TSet,                                OTDEC_F88,                  TSet),
+  OTD_ROW(OT_MasterConfigMemberIDcode,            OTDEC_MASTER_MEMBERID,      MasterConfigMemberIDcode),
+  OTD_ROW(OT_SlaveConfigMemberIDcode,             OTDEC_SLAVE_MEMBERID,       SlaveConfigMemberIDcode),
+  OTD_ROW(OT_Command,                             OTDEC_COMMAND,              Command),
+  OTD_ROW(OT_ASFflags,                            OTDEC_ASF_FLAGS,            ASFflags),
+  OTD_ROW(OT_RBPflags,                            OTDEC_RBP_FLAGS,            RBPflags),
+  OTD_ROW(OT_CoolingControl,                      OTDEC_F88,                  CoolingControl),
+  OTD_ROW(OT_TsetCH2,                             OTDEC_F88,                  TsetCH2),
+  OTD_ROW(OT_TrOverride,                          OTDEC_F88,                  TrOverride),
+  OTD_ROW(OT_TSP,                                 OTDEC_U8U8,                 TSP),
+  OTD_ROW(OT_TSPindexTSPvalue,                    OTDEC_U8U8,                 TSPindexTSPvalue),
+  OTD_ROW(OT_FHBsize,                             OTDEC_U8U8,                 FHBsize),
+  OTD_ROW(OT_FHBindexFHBvalue,                    OTDEC_U8U8,                 FHBindexFHBvalue),
+  OTD_ROW(OT_MaxRelModLevelSetting,               OTDEC_F88,                  MaxRelModLevelSetting),
+  OTD_ROW(OT_MaxCapacityMinModLevel,              OTDEC_U8U8,                 MaxCapacityMinModLevel),
+  OTD_ROW(OT_TrSet,                               OTDEC_F88,                  TrSet),
+  OTD_ROW(OT_RelModLevel,                         OTDEC_F88,                  RelModLevel),
+  OTD_ROW(OT_CHPressure,                          OTDEC_F88,                  CHPressure),
+  OTD_ROW(OT_DHWFlowRate,                         OTDEC_F88,                  DHWFlowRate),
+  OTD_ROW(OT_DayTime,                             OTDEC_DAYTIME,              DayTime),
+  OTD_ROW(OT_Date,                                OTDEC_DATE,                 Date),
+  OTD_ROW(OT_Year,                                OTDEC_U16,                  Year),
+  OTD_ROW(OT_TrSetCH2,                            OTDEC_F88,                  TrSetCH2),
+  OTD_ROW(OT_Tr,                                  OTDEC_F88,                  Tr),
+  OTD_ROW(OT_Tboiler,                             OTDEC_F88,                  Tboiler),
+  OTD_ROW(OT_Tdhw,                                OTDEC_F88,                  Tdhw),
+  OTD_ROW(OT_Toutside,                            OTDEC_F88,                  Toutside),
+  OTD_ROW(OT_Tret,                                OTDEC_F88,                  Tret),
+  OTD_ROW(OT_Tsolarstorage,                       OTDEC_F88,                  Tsolarstorage),
+  OTD_ROW(OT_Tsolarcollector,                     OTDEC_S16,                  Tsolarcollector),
+  OTD_ROW(OT_TflowCH2,                            OTDEC_F88,                  TflowCH2),
+  OTD_ROW(OT_Tdhw2,                               OTDEC_F88,                  Tdhw2),
+  OTD_ROW(OT_Texhaust,                            OTDEC_S16,                  Texhaust),
+  OTD_ROW(OT_Theatexchanger,                      OTDEC_F88,                  Theatexchanger),
+  OTD_ROW(OT_FanSpeed,                            OTDEC_U8U8,                 FanSpeed),
+  OTD_ROW(OT_ElectricalCurrentBurnerFlame,        OTDEC_F88,                  ElectricalCurrentBurnerFlame),
+  OTD_ROW(OT_TRoomCH2,                            OTDEC_F88,                  TRoomCH2),
+  OTD_ROW(OT_RelativeHumidity,                    OTDEC_F88,                  RelativeHumidity),
+  OTD_ROW(OT_TrOverride2,                         OTDEC_F88,                  TrOverride2),
+  OTD_ROW(OT_TdhwSetUBTdhwSetLB,                  OTDEC_S8S8,                 TdhwSetUBTdhwSetLB),
+  OTD_ROW(OT_MaxTSetUBMaxTSetLB,                  OTDEC_S8S8,                 MaxTSetUBMaxTSetLB),
+  OTD_ROW(OT_HcratioUBHcratioLB,                  OTDEC_S8S8,                 HcratioUBHcratioLB),
+  OTD_ROW(OT_Remoteparameter4boundaries,          OTDEC_S8S8,                 Remoteparameter4boundaries),
+  OTD_ROW(OT_Remoteparameter5boundaries,          OTDEC_S8S8,                 Remoteparameter5boundaries),
+  OTD_ROW(OT_Remoteparameter6boundaries,          OTDEC_S8S8,                 Remoteparameter6boundaries),
+  OTD_ROW(OT_Remoteparameter7boundaries,          OTDEC_S8S8,                 Remoteparameter7boundaries),
+  OTD_ROW(OT_Remoteparameter8boundaries,          OTDEC_S8S8,                 Remoteparameter8boundaries),
+  OTD_ROW(OT_TdhwSet,                             OTDEC_F88,                  TdhwSet),
+  OTD_ROW(OT_MaxTSet,                             OTDEC_F88,                  MaxTSet),
+  OTD_ROW(OT_Hcratio,                             OTDEC_F88,                  Hcratio),
+  OTD_ROW(OT_Remoteparameter4,                    OTDEC_F88,                  Remoteparameter4),
+  OTD_ROW(OT_Remoteparameter5,                    OTDEC_F88,                  Remoteparameter5),
+  OTD_ROW(OT_Remoteparameter6,                    OTDEC_F88,                  Remoteparameter6),
+  OTD_ROW(OT_Remoteparameter7,                    OTDEC_F88,                  Remoteparameter7),
+  OTD_ROW(OT_Remoteparameter8,                    OTDEC_F88,                  Remoteparameter8),
+  OTD_ROW(OT_StatusVH,                            OTDEC_STATUS_VH,            StatusVH),
+  OTD_ROW(OT_ControlSetpointVH,                   OTDEC_U8_LB,                ControlSetpointVH),
+  OTD_ROW(OT_ASFFaultCodeVH,                      OTDEC_FLAG8U8,              ASFFaultCodeVH),
+  OTD_ROW(OT_DiagnosticCodeVH,                    OTDEC_U16,                  DiagnosticCodeVH),
+  OTD_ROW(OT_ConfigMemberIDVH,                    OTDEC_VH_CONFIG_MEMBERID,   ConfigMemberIDVH),
+  OTD_ROW(OT_OpenthermVersionVH,                  OTDEC_F88,                  OpenthermVersionVH),
+  OTD_ROW(OT_VersionTypeVH,                       OTDEC_U8U8,                 VersionTypeVH),
+  OTD_ROW(OT_RelativeVentilation,                 OTDEC_U8_LB,                RelativeVentilation),
+  OTD_ROW(OT_RelativeHumidityExhaustAir,          OTDEC_U8_LB,                RelativeHumidityExhaustAir),
+  OTD_ROW(OT_CO2LevelExhaustAir,                  OTDEC_U16,                  CO2LevelExhaustAir),
+  OTD_ROW(OT_SupplyInletTemperature,              OTDEC_F88,                  SupplyInletTemperature),
+  OTD_ROW(OT_SupplyOutletTemperature,             OTDEC_F88,                  SupplyOutletTemperature),
+  OTD_ROW(OT_ExhaustInletTemperature,             OTDEC_F88,                  ExhaustInletTemperature),
+  OTD_ROW(OT_ExhaustOutletTemperature,            OTDEC_F88,                  ExhaustOutletTemperature),
+  OTD_ROW(OT_ActualExhaustFanSpeed,               OTDEC_U16,                  ActualExhaustFanSpeed),
+  OTD_ROW(OT_ActualSupplyFanSpeed,                OTDEC_U16,                  ActualSupplyFanSpeed),
+  OTD_ROW(OT_RemoteParameterSettingVH,            OTDEC_VH_REMOTE_PARAM,      RemoteParameterSettingVH),
+  OTD_ROW(OT_NominalVentilationValue,             OTDEC_U8_HB,                NominalVentilationValue),
+  OTD_ROW(OT_TSPNumberVH,                         OTDEC_U8U8,                 TSPNumberVH),
+  OTD_ROW(OT_TSPEntryVH,                          OTDEC_U8U8,                 TSPEntryVH),
+  OTD_ROW(OT_FaultBufferSizeVH,                   OTDEC_U8U8,                 FaultBufferSizeVH),
+  OTD_ROW(OT_FaultBufferEntryVH,                  OTDEC_U8U8,                 FaultBufferEntryVH),
+  OTD_ROW(OT_Brand,                               OTDEC_U8U8,                 Brand),
+  OTD_ROW(OT_BrandVersion,                        OTDEC_U8U8,                 BrandVersion),
+  OTD_ROW(OT_BrandSerialNumber,                   OTDEC_U8U8,                 BrandSerialNumber),
+  OTD_ROW(OT_CoolingOperationHours,               OTDEC_U16,                  CoolingOperationHours),
+  OTD_ROW(OT_PowerCycles,                         OTDEC_U16,                  PowerCycles),
+  OTD_ROW(OT_RFstrengthbatterylevel,              OTDEC_RF_SENSOR,            RFstrengthbatterylevel),
+  OTD_ROW(OT_OperatingMode_HC1_HC2_DHW,           OTDEC_OPERATING_MODE,       OperatingMode_HC1_HC2_DHW),
+  OTD_ROW(OT_RemoteOverrideFunction,              OTDEC_REMOTE_OVERRIDE_FN,   RemoteOverrideFunction),
+  OTD_ROW(OT_SolarStorageMaster,                  OTDEC_SOLAR_STATUS,         SolarStorageStatus),
+  OTD_ROW(OT_SolarStorageASFflags,                OTDEC_FLAG8U8,              SolarStorageASFflags),
+  OTD_ROW(OT_SolarStorageSlaveConfigMemberIDcode, OTDEC_SOLAR_SLAVE_MEMBERID, SolarStorageSlaveConfigMemberIDcode),
+  OTD_ROW(OT_SolarStorageVersionType,             OTDEC_U8U8,                 SolarStorageVersionType),
+  OTD_ROW(OT_SolarStorageTSP,                     OTDEC_U8U8,                 SolarStorageTSP),
+  OTD_ROW(OT_SolarStorageTSPindexTSPvalue,        OTDEC_U8U8,                 SolarStorageTSPindexTSPvalue),
+  OTD_ROW(OT_SolarStorageFHBsize,                 OTDEC_U8U8,                 SolarStorageFHBsize),
+  OTD_ROW(OT_SolarStorageFHBindexFHBvalue,        OTDEC_U8U8,                 SolarStorageFHBindexFHBvalue),
+  OTD_ROW(OT_ElectricityProducerStarts,           OTDEC_U16,                  ElectricityProducerStarts),
+  OTD_ROW(OT_ElectricityProducerHours,            OTDEC_U16,                  ElectricityProducerHours),
+  OTD_ROW(OT_ElectricityProduction,               OTDEC_U16,                  ElectricityProduction),
+  OTD_ROW(OT_CumulativeElectricityProduction,     OTDEC_U16,                  CumulativeElectricityProduction),
+  OTD_ROW(OT_BurnerUnsuccessfulStarts,            OTDEC_U16,                  BurnerUnsuccessfulStarts),
+  OTD_ROW(OT_FlameSignalTooLow,                   OTDEC_U16,                  FlameSignalTooLow),
+  OTD_ROW(OT_OEMDiagnosticCode,                   OTDEC_U16,                  OEMDiagnosticCode),
+  OTD_ROW(OT_BurnerStarts,                        OTDEC_U16,                  BurnerStarts),
+  OTD_ROW(OT_CHPumpStarts,                        OTDEC_U16,                  CHPumpStarts),
+  OTD_ROW(OT_DHWPumpValveStarts,                  OTDEC_U16,                  DHWPumpValveStarts),
+  OTD_ROW(OT_DHWBurnerStarts,                     OTDEC_U16,                  DHWBurnerStarts),
+  OTD_ROW(OT_BurnerOperationHours,                OTDEC_U16,                  BurnerOperationHours),
+  OTD_ROW(OT_CHPumpOperationHours,                OTDEC_U16,                  CHPumpOperationHours),
+  OTD_ROW(OT_DHWPumpValveOperationHours,          OTDEC_U16,                  DHWPumpValveOperationHours),
+  OTD_ROW(OT_DHWBurnerOperationHours,             OTDEC_U16,                  DHWBurnerOperationHours),
+  OTD_ROW(OT_OpenThermVersionMaster,              OTDEC_F88,                  OpenThermVersionMaster),
+  OTD_ROW(OT_OpenThermVersionSlave,               OTDEC_F88,                  OpenThermVersionSlave),
+  OTD_ROW(OT_MasterVersion,                       OTDEC_U8U8,                 MasterVersion),
+  OTD_ROW(OT_SlaveVersion,                        OTDEC_U8U8,                 SlaveVersion),
+  OTD_ROW(OT_RemehadFdUcodes,                     OTDEC_U8U8,                 RemehadFdUcodes),
+  OTD_ROW(OT_RemehaServicemessage,                OTDEC_U8U8,                 RemehaServicemessage),
+  OTD_ROW(OT_RemehaDetectionConnectedSCU,         OTDEC_U8U8,                 RemehaDetectionConnectedSCU),
+};
+
+#undef OTD_ROW
+
+struct OTDispatchTable {
+  OTDispatchEntry e[OTD_TABLE_SIZE];
+};
+
+constexpr OTDispatchTable otBuildDispatchTable() {
+  OTDispatchTable t {};
+  for (int id = 0; id < OTD_TABLE_SIZE; id++) {
+    OTDispatchEntry &d = t.e[id];
+    d.type  = (id <= OT_MSGID_MAX) ? (uint8_t)OTmap[id].type : (uint8_t)ot_undef;
+    d.flags = 0;
+    if (id == OT_Statusflags || id == OT_StatusVH) d.flags |= OTD_FLAG_STATUS_GATE;
+    if (id > 127)                                  d.flags |= OTD_FLAG_UNTRACKED;   // ADR-006
+  }
+  for (const OTDispatchRow &r : OTDispatchRows) {
+    OTDispatchEntry &d = t.e[r.id];
+    d.decoder   = r.decoder;
+    d.fieldKind = r.fieldKind;
+    d.offset    = r.offset;
+    d.flags    |= OTD_FLAG_DEFINED;
+  }
+  return t;
+}
+
+constexpr OTDispatchTable OTDispatch PROGMEM = otBuildDispatchTable();
+
+//=====================[ compile-time consistency checks ]=====================
+
+// Field type each decoder takes by reference.
+constexpr uint8_t otDecoderFieldKind(uint8_t dec) {
+  return dec == OTDEC_NONE ? (uint8_t)OTFIELD_NONE
+       : dec == OTDEC_F88  ? (uint8_t)OTFIELD_FLOAT
+       : dec == OTDEC_S16  ? (uint8_t)OTFIELD_S16
+       :                     (uint8_t)OTFIELD_U16;
+}
+
+// OTmap[] types a decoder can render.
+constexpr bool otDecoderAcceptsType(uint8_t dec, uint8_t type) {
+  switch (dec) {
+    case OTDEC_F88:                  return type == ot_f88;
+    case OTDEC_S16:                  return type == ot_s16;
+    case OTDEC_S8S8:                 return type == ot_s8s8;
+    case OTDEC_U16:                  return type == ot_u16;
+    case OTDEC_U8U8:                 return type == ot_u8u8;
+    case OTDEC_U8_HB:
+    case OTDEC_U8_LB:                return type == ot_u8;
+    case OTDEC_FLAG8U8:
+    case OTDEC_ASF_FLAGS:
+    case OTDEC_MASTER_MEMBERID:
+    case OTDEC_SLAVE_MEMBERID:
+    case OTDEC_VH_CONFIG_MEMBERID:
+    case OTDEC_SOLAR_SLAVE_MEMBERID: return type == ot_flag8u8;
+    case OTDEC_STATUS:
+    case OTDEC_STATUS_VH:
+    case OTDEC_RBP_FLAGS:
+    case OTDEC_VH_REMOTE_PARAM:
+    case OTDEC_SOLAR_STATUS:         return type == ot_flag8flag8;
+    case OTDEC_COMMAND:
+    case OTDEC_DATE:                 return type == ot_u8u8;
+    case OTDEC_REMOTE_OVERRIDE_FN:   return type == ot_flag8;
+    case OTDEC_DAYTIME:
+    case OTDEC_RF_SENSOR:
+    case OTDEC_OPERATING_MODE:       return type == ot_special;
+    default:                         return false;
+  }
+}
+
+constexpr bool otMapRowsInIdOrder() {
+  for (int i = 0; i <= OT_MSGID_MAX; i++) {
+    if (OTmap[i].id != i) return false;
+  }
+  return true;
+}
+
+constexpr bool otDispatchRowsValid() {
+  for (const OTDispatchRow &r : OTDispatchRows) {
+    if (r.id > OT_MSGID_MAX) return false;
+    if (r.decoder == OTDEC_NONE || r.decoder >= OTDEC_COUNT) return false;
+    if (r.fieldKind != otDecoderFieldKind(r.decoder)) return false;
+    if (!otDecoderAcceptsType(r.decoder, OTmap[r.id].type)) return false;
+  }
+  return true;
+}
+
+constexpr bool otDispatchRowsUnique() {
+  const size_t n = sizeof(OTDispatchRows) / sizeof(OTDispatchRows[0]);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = i + 1; j < n; j++) {
+      if (OTDispatchRows[i].id == OTDispatchRows[j].id) return false;
+    }
+  }
+  return true;
+}
+
+constexpr bool otDispatchTableConsistent() {
+  for (int id = 0; id < OTD_TABLE_SIZE; id++) {
+    const OTDispatchEntry &d = OTDispatch.e[id];
+    const bool defined = (d.flags & OTD_FLAG_DEFINED) != 0;
+    if (defined != (d.decoder != OTDEC_NONE)) return false;
+    if (id > OT_MSGID_MAX && defined) return false;
+  }
+  return true;
+}
+
+static_assert(sizeof(OTmap) / sizeof(OTmap[0]) == OT_MSGID_MAX + 1,
+              "OTmap[] must have exactly one row per message id 0..OT_MSGID_MAX");
+static_assert(otMapRowsInIdOrder(), "OTmap[] row i must describe message id i");
+static_assert(otDispatchRowsValid(),
+              "OTD_ROW: unknown id, or decoder does not match the OTmap[] type / field type");
+static_assert(otDispatchRowsUnique(), "OTD_ROW: message id listed twice");
+static_assert(otDispatchTableConsistent(), "OTDispatch: DEFINED flag out of step with the decoder");
+static_assert(OT_MSGID_MAX < OTD_TABLE_SIZE, "message id must fit the 8-bit id byte");
+
+#endif // OTDISPATCH_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
@@ -0,0 +1,115 @@
+/*
+***************************************************************************
+**  Program  : OTF88.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  OpenTherm f8.8 (signed Q8.8, int16_t) helpers in integer arithmetic.
+**
+**  An f8.8 data value is a signed 16-bit count of 1/256 units. The decode
+**  path used to turn it into a float (OpenthermData_t::f88()), round that to
+**  two decimals with roundf() and format it with dtostrf() for the MQTT
+**  payload and the log line, once per f8.8 frame. OTDirect went the other
+**  way with a truncating float cast. Here both directions stay integer:
+**
+**    otF88ToCenti()     Q8.8 -> hundredths, rounded half away from zero,
+**                       exactly what roundf(f88 * 100) gives (the product
+**                       has at most 23 significant bits, so it is exact in
+**                       a float)
+**    otFormatCenti()    hundredths -> "-12.34" / "0.00", no float, no
+**                       printf; a value that rounds to zero has no sign
+**    otF88Format()      both of the above (the print_f88() payload)
+**    otF88ToFloat()     exact: every Q8.8 value is a float
+**    otF88FromFloat()   float -> nearest Q8.8, ties away from zero,
+**                       saturating at the int16_t range instead of the
+**                       undefined out-of-range float->int conversion
+**
+**  The decoded state keeps its float fields: a float holds any Q8.8 value
+**  and any two-decimal rounding of one exactly, and the REST, SAT and
+**  webhook readers take floats.
+**
+**  No Arduino dependency: tests/test_ot_f88.cpp checks all 65536 values.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTF88_H
+#define OTF88_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define OT_F88_TEXT_LEN 8                 // "-128.00" + NUL
+
+// Signed value of the two data bytes.
+inline int16_t otF88FromBytes(uint8_t hb, uint8_t lb)
+{
+  return (int16_t)(uint16_t)(((uint16_t)hb << 8) | lb);
+}
+
+inline float otF88ToFloat(int16_t q)
+{
+  return (float)q * (1.0f / 256.0f);
+}
+
+inline int16_t otF88FromFloat(float v)
+{
+  if (!(v == v)) return 0;                // NaN
+  const float scaled = v * 256.0f;
+  if (scaled >= 32767.0f)  return INT16_MAX;
+  if (scaled <= -32768.0f) return INT16_MIN;
+  return (int16_t)roundf(scaled);         // half away from zero
+}
+
+// Q8.8 -> hundredths: q * 100 / 256 = q * 25 / 64, half away from zero.
+inline int16_t otF88ToCenti(int16_t q)
+{
+  const int32_t n = (int32_t)q * 25;
+  return (int16_t)(n < 0 ? -((-n + 32) >> 6) : ((n + 32) >> 6));
+}
+
+// Hundredths as fixed two-decimal text. Returns the length, 0 when the
+// buffer is too small (buf is then "").
+inline size_t otFormatCenti(int32_t centi, char *buf, size_t size)
+{
+  char tmp[16];
+  size_t n = 0;
+  uint32_t mag = (centi < 0) ? (uint32_t)(-(int64_t)centi) : (uint32_t)centi;
+  for (uint8_t i = 0; i < 2; i++) { tmp[n++] = (char)('0' + mag % 10); mag /= 10; }
+  tmp[n++] = '.';
+  do { tmp[n++] = (char)('0' + mag % 10); mag /= 10; } while (mag);
+  if (centi < 0) tmp[n++] = '-';
+  if (size == 0) return 0;
+  if (n + 1 > size) { buf[0] = '\0'; return 0; }
+  for (size_t i = 0; i < n; i++) buf[i] = tmp[n - 1 - i];
+  buf[n] = '\0';
+  return n;
+}
+
+inline size_t otF88Format(int16_t q, char *buf, size_t size)
+{
+  return otFormatCenti(otF88ToCenti(q), buf, size);
+}
+
+#endif // OTF88_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
@@ -0,0 +1,151 @@
+/*
+***************************************************************************
+**  Program  : OTFrameParse.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Single-pass parser for raw OT frames as printed by the PIC / OT-direct
+**  bridge: one source letter (T, B, R, A, E) followed by 8 hex digits,
+**  e.g. "T00000100".
+**
+**  processOT() used to run isvalidotmsg() and then sscanf(buf+1, "%8x"),
+**  i.e. a varargs call into the scanf state machine for every frame, and
+**  sscanf accepted a partial hex prefix ("T1234zzzz" -> 0x00001234). Here
+**  shape check, source decode, hex decode and the OT parity check are done
+**  in one pass over the 9 bytes with two 256-entry lookup tables and no
+**  data-dependent branches in the digit loop.
+**
+**  No Arduino dependency: tests/bench_ot_frame_parse.cpp includes this
+**  header directly and fuzzes it against the legacy sscanf path.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTFRAMEPARSE_H
+#define OTFRAMEPARSE_H
+
+#include <stdint.h>
+
+#define OT_FRAME_LEN 9   // "T" + 8 hex digits
+
+// Source letter classes. Values match the OTGW_response_type order used by
+// processOT() (OTGW-Core.h) so the caller can assign them directly.
+enum OTRawFrameSource : uint8_t {
+  OT_RAW_SRC_BOILER     = 0,   // 'B'
+  OT_RAW_SRC_THERMOSTAT = 1,   // 'T'
+  OT_RAW_SRC_ANSWER     = 2,   // 'A'  answer to thermostat (gateway)
+  OT_RAW_SRC_REQUEST    = 3,   // 'R'  request to boiler (gateway)
+  OT_RAW_SRC_PARITY     = 4,   // 'E'  PIC-reported parity error
+  OT_RAW_SRC_NONE       = 0xFF
+};
+
+enum OTFrameParseResult : uint8_t {
+  OT_FRAME_NOT_FRAME = 0,   // not a raw OT frame (PIC command response, banner, ...)
+  OT_FRAME_BAD_HEX,         // frame shape (len 9, TBARE prefix) but payload is not 8 hex digits
+  OT_FRAME_OK
+};
+
+struct OTRawFrame {
+  uint32_t value;        // 32-bit OT frame as printed
+  uint8_t  source;       // OTRawFrameSource
+  uint8_t  type;         // bits 30..28: message type
+  uint8_t  masterslave;  // MSB of type: 0 = master, 1 = slave
+  uint8_t  id;           // bits 23..16: data-id
+  uint8_t  valueHB;      // bits 15..8
+  uint8_t  valueLB;      // bits 7..0
+  bool     parityOk;     // even parity over all 32 bits (bit 31 is the parity bit)
+};
+
+// Lookup tables, built at compile time.
+//   hex:    '0'-'9','A'-'F','a'-'f' -> 0..15, anything else -> 0x10 (error bit)
+//   source: 'B','T','A','R','E'     -> OTRawFrameSource, anything else -> OT_RAW_SRC_NONE
+struct OTFrameParseTables {
+  uint8_t hex[256];
+  uint8_t source[256];
+  constexpr OTFrameParseTables() : hex(), source() {
+    for (int c = 0; c < 256; c++) {
+      hex[c] = (c >= '0' && c <= '9') ? (uint8_t)(c - '0')
+             : (c >= 'A' && c <= 'F') ? (uint8_t)(c - 'A' + 10)
+             : (c >= 'a' && c <= 'f') ? (uint8_t)(c - 'a' + 10)
+             : (uint8_t)0x10;
+      source[c] = OT_RAW_SRC_NONE;
+    }
+    source['B'] = OT_RAW_SRC_BOILER;
+    source['T'] = OT_RAW_SRC_THERMOSTAT;
+    source['A'] = OT_RAW_SRC_ANSWER;
+    source['R'] = OT_RAW_SRC_REQUEST;
+    source['E'] = OT_RAW_SRC_PARITY;
+  }
+};
+
+static constexpr OTFrameParseTables kOTFrameParseTables {};
+
+static_assert(kOTFrameParseTables.hex['f'] == 15 && kOTFrameParseTables.hex['G'] == 0x10,
+              "OTFrameParse hex table");
+static_assert(kOTFrameParseTables.source['R'] == OT_RAW_SRC_REQUEST,
+              "OTFrameParse source table");
+
+// Even parity over 32 bits; OT sets bit 31 so the whole frame has an even
+// number of ones.
+inline bool otFrameParityOk(uint32_t v)
+{
+#if defined(__GNUC__)
+  return __builtin_parity(v) == 0;
+#else
+  v ^= v >> 16; v ^= v >> 8; v ^= v >> 4; v ^= v >> 2; v ^= v >> 1;
+  return (v & 1u) == 0;
+#endif
+}
+
+// Validate + decode one line. Accepts exactly what isvalidotmsg() accepted
+// (len 9, TBARE prefix, third char not ':') and additionally requires all 8
+// payload characters to be hex digits. out is only filled on OT_FRAME_OK.
+inline OTFrameParseResult otParseFrame(const char *buf, int len, OTRawFrame &out)
+{
+  if (len != OT_FRAME_LEN) return OT_FRAME_NOT_FRAME;
+  const uint8_t src = kOTFrameParseTables.source[(uint8_t)buf[0]];
+  if (src == OT_RAW_SRC_NONE || buf[2] == ':') return OT_FRAME_NOT_FRAME;
+
+  const uint8_t *h = kOTFrameParseTables.hex;
+  const uint8_t *p = (const uint8_t *)buf + 1;
+  uint32_t v = 0;
+  uint8_t bad = 0;
+  for (int i = 0; i < 8; i++) {
+    const uint8_t n = h[p[i]];
+    bad |= n;
+    v = (v << 4) | (n & 0x0F);
+  }
+  if (bad & 0x10) return OT_FRAME_BAD_HEX;
+
+  out.value = v;
+  out.source = src;
+  out.type = (uint8_t)((v >> 28) & 0x7);
+  out.masterslave = (uint8_t)((out.type >> 2) & 0x1);
+  out.id = (uint8_t)((v >> 16) & 0xFF);
+  out.valueHB = (uint8_t)((v >> 8) & 0xFF);
+  out.valueLB = (uint8_t)(v & 0xFF);
+  out.parityOk = otFrameParityOk(v);
+  return OT_FRAME_OK;
+}
+
+#endif // OTFRAMEPARSE_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
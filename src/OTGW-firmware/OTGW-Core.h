@@ -14,8 +14,9 @@
 #ifndef OTGWCore_h
 #define OTGWCore_h
 
-#include <type_traits>   // std::is_trivially_copyable for OTFrameMsg static_assert (TASK-865.5)
-#include <platform.h>    // PlatformQueue/PlatformMutex + platformQueue*/platformMutex* shims (TASK-865.5)
+#include <type_traits>   // std::is_trivially_copyable for OTTxMsg static_assert (TASK-865.5)
+#include <platform.h>    // PlatformQueue/PlatformMutex/PlatformSpscRing + shims (TASK-865.5)
+#include "OTStateSnapshot.h" // seqlock copy of OTcurrentSystemState for cross-task readers
 
 // OTGW Serial 2 network port
 // AsyncSimpleTelnet<2> in streaming mode — AsyncTCP transport (non-blocking writes).
@@ -30,10 +31,10 @@ AsyncSimpleTelnet<2> OTGWstream(OTGW_SERIAL_PORT);
 #define OTGW_COMMAND_TOPIC "command"
 
 // PIC serial line buffer sizes. Hoisted here (TASK-865.5) from inside
-// handlePICSerial() so the OT-frame producer/consumer queue (OTFrameMsg.line)
+// handlePICSerial() so the OT-frame producer/consumer ring (otFrameRing)
 // and the serial read loop share ONE source of truth. MAX_BUFFER_READ is 512
 // because a PS=1 summary line (and some banners) can exceed 256 bytes; the
-// frame queue must carry the full line, not just a 9-char OT frame, because
+// frame ring must carry the full line, not just a 9-char OT frame, because
 // processOT() also handles banners, '='-echoes and PS=1 summaries.
 #ifndef MAX_BUFFER_READ
 #define MAX_BUFFER_READ 512       //PS=1 summary lines can exceed 256 bytes
@@ -42,154 +43,8 @@ AsyncSimpleTelnet<2> OTGWstream(OTGW_SERIAL_PORT);
 #define MAX_BUFFER_WRITE 128
 #endif
 
-typedef struct {
-	uint16_t 	Statusflags = 0; // flag8 / flag8  Master and Slave Status flags. 
-	uint8_t 	MasterStatus = 0; 
-	uint8_t 	SlaveStatus = 0;
-	float 		TSet = 0.0f; // f8.8  Control setpoint  ie CH  water temperature setpoint (°C)
-	uint16_t	MasterConfigMemberIDcode = 0; 	// flag8 / u8  Master Configuration Flags /  Master MemberID Code 
-	uint16_t	SlaveConfigMemberIDcode = 0; // flag8 / u8  Slave Configuration Flags /  Slave MemberID Code 
-	uint16_t 	Command = 0; // u8 / u8  Remote Command 
-	uint16_t 	ASFflags = 0; // / OEM-fault-code  flag8 / u8  Application-specific fault flags and OEM fault code 
-	uint16_t 	RBPflags = 0; // flag8 / flag8  Remote boiler parameter transfer-enable & read/write flags 
-	float 		CoolingControl = 0.0f; // f8.8  Cooling control signal (%) 
-	float 		TsetCH2 = 0.0f; // f8.8  Control setpoint for 2e CH circuit (°C)
-	float 		TrOverride = 0.0f; // f8.8  Remote override room setpoint 
-	float 		TrOverride2 = 0.0f; // f8.8  Remote override room setpoint 2 (°C)
-	uint16_t 	TSP = 0; // u8 / u8  Number of Transparent-Slave-Parameters supported by slave 
-	uint16_t 	TSPindexTSPvalue = 0; // u8 / u8  Index number / Value of referred-to transparent slave parameter. 
-	uint16_t 	FHBsize = 0; // u8 / u8  Size of Fault-History-Buffer supported by slave 
-	uint16_t 	FHBindexFHBvalue = 0; // u8 / u8  Index number / Value of referred-to fault-history buffer entry. 
-	float 		MaxRelModLevelSetting = 0.0f; // f8.8  Maximum relative modulation level setting (%) 
-	uint16_t 	MaxCapacityMinModLevel = 0; // u8 / u8  Maximum boiler capacity (kW) / Minimum boiler modulation level(%) 
-	float 		TrSet = 0.0f; // f8.8  Room Setpoint (°C)
-	float 		RelModLevel = 0.0f; // f8.8  Relative Modulation Level (%) 
-	float 		CHPressure = 0.0f; // f8.8  Water pressure in CH circuit  (bar) 
-	float 		DHWFlowRate = 0.0f; // f8.8  Water flow rate in DHW circuit. (litres/minute) 
-	uint16_t 	DayTime = 0; // special / u8  Day of Week and Time of Day 
-	uint16_t 	Date = 0; // u8 / u8  Calendar date 
-	uint16_t 	Year = 0; // u16  Calendar year 
-	float 		TrSetCH2 = 0.0f; // f8.8  Room Setpoint for 2nd CH circuit (°C)
-	float 		Tr = NAN; // f8.8  Room temperature (°C). NAN-init per TASK-522: distinguishes "never observed" from a real 0 °C reading. Consumers must isnan()-guard before arithmetic or display.
-	float 		Tboiler = 0.0f; // f8.8  Boiler flow water temperature (°C)
-	float 		Tdhw = 0.0f; // f8.8  DHW temperature (°C)
-	float 		Toutside = 0.0f; // f8.8  Outside temperature (°C)
-	float 		Tret = 0.0f; // f8.8  Return water temperature (°C)
-	float 		Tsolarstorage = 0.0f; // f8.8  Solar storage temperature (°C)
-	int16_t 	Tsolarcollector = 0; // s16  Solar collector temperature (°C)
-	float 		TflowCH2 = 0.0f; // f8.8  Flow water temperature CH2 circuit (°C)
-	float 		Tdhw2 = 0.0f; // f8.8  Domestic hot water temperature 2 (°C)
-	int16_t 	Texhaust = 0; // s16  Boiler exhaust temperature (°C)
-	float 		Theatexchanger = 0.0f; // f8.8  Heat Exchanger (°C)
-	uint16_t	FanSpeed = 0; // u8 / u8  Fan Speed setpoint / actual (Hz)
-	float 		ElectricalCurrentBurnerFlame = 0.0f; // f88 Electrical current through burner flame (µA)
-	float 		TRoomCH2= 0.0f; // f88  Room Temperature for 2nd CH circuit ("°C)
-	float 		RelativeHumidity = 0.0f; // f8.8 Relative Humidity (%)
-	uint16_t 	TdhwSetUBTdhwSetLB = 0 ; // s8 / s8  DHW setpoint upper & lower bounds for adjustment  (°C)
-	uint16_t 	MaxTSetUBMaxTSetLB = 0; // s8 / s8  Max CH water setpoint upper & lower bounds for adjustment  (°C)
-	uint16_t	HcratioUBHcratioLB = 0; // s8 / s8  OTC heat curve ratio upper & lower bounds for adjustment  
-	uint16_t	Remoteparameter4boundaries = 0; // s8 / s8  Remote parameter 4 upper & lower bounds for adjustment
-	uint16_t	Remoteparameter5boundaries = 0; // s8 / s8  Remote parameter 5 upper & lower bounds for adjustment
-	uint16_t	Remoteparameter6boundaries = 0; // s8 / s8  Remote parameter 6 upper & lower bounds for adjustment
-	uint16_t	Remoteparameter7boundaries = 0; // s8 / s8  Remote parameter 7 upper & lower bounds for adjustment
-	uint16_t	Remoteparameter8boundaries = 0; // s8 / s8  Remote parameter 8 upper & lower bounds for adjustment
-	float 		TdhwSet = 0.0f; // f8.8  DHW setpoint (°C)    (Remote parameter 1)
-	float 		MaxTSet = 0.0f; // f8.8  Max CH water setpoint (°C)  (Remote parameters 2)
-	float 		Hcratio = 0.0f; // f8.8  OTC heat curve ratio (°C)  (Remote parameter 3)
-	float 		Remoteparameter4 = 0.0f; // f8.8  Remote parameter 4
-	float 		Remoteparameter5 = 0.0f; // f8.8  Remote parameter 5
-	float 		Remoteparameter6 = 0.0f; // f8.8  Remote parameter 6
-	float 		Remoteparameter7 = 0.0f; // f8.8  Remote parameter 7
-	float 		Remoteparameter8 = 0.0f; // f8.8  Remote parameter 8
-
-	//RF
-	uint16_t	RFstrengthbatterylevel = 0; // u8/ u8 RF strength and battery level
-	uint16_t 	OperatingMode_HC1_HC2_DHW = 0; // u8 / u8 Operating Mode HC1, HC2/ DHW
-
-	//Brand identification (mandatory since v4.1)
-	uint16_t	Brand = 0; // u8 / u8 Brand name index / character
-	uint16_t	BrandVersion = 0; // u8 / u8 Brand version index / character
-	uint16_t	BrandSerialNumber = 0; // u8 / u8 Brand serial number index / character
-
-	//Counters
-	uint16_t	CoolingOperationHours = 0; // u16 Cooling operation hours
-	uint16_t	PowerCycles = 0; // u16 Power cycles
-
-	//Electric Producer
-	uint16_t 	ElectricityProducerStarts = 0; // u16 Electricity producer starts 
-	uint16_t 	ElectricityProducerHours = 0; // u16 Electricity producer hours
-	uint16_t 	ElectricityProduction = 0; // u16 Electricity production
-	uint16_t 	CumulativeElectricityProduction = 0; // u16 Cumulative Electricity production
-	
-	//Solar Storage
-	uint16_t 	SolarStorageStatus = 0;
-	uint8_t 	SolarMasterStatus = 0;
-	uint8_t 	SolarSlaveStatus = 0;	
-	uint16_t	SolarStorageASFflags = 0;
-	uint16_t	SolarStorageSlaveConfigMemberIDcode = 0;
-	uint16_t	SolarStorageVersionType = 0;
-	uint16_t 	SolarStorageTSP = 0;
-	uint16_t	SolarStorageTSPindexTSPvalue = 0;
-	uint16_t	SolarStorageFHBsize = 0;
-	uint16_t	SolarStorageFHBindexFHBvalue = 0;
-
-	//Ventilation/HeatRecovery Msgids
-	uint16_t	StatusVH = 0;
-	uint8_t 	MasterStatusVH = 0;
-	uint8_t 	SlaveStatusVH = 0;
-	uint16_t	ControlSetpointVH = 0;  //should be uint8_t
-	uint16_t	ASFFaultCodeVH = 0;
-	uint16_t	DiagnosticCodeVH = 0;
-	uint16_t	ConfigMemberIDVH = 0;
-	float		OpenthermVersionVH = 0.0f;
-	uint16_t	VersionTypeVH = 0;
-	uint16_t	RelativeVentilation = 0;
-	uint16_t	RelativeHumidityExhaustAir = 0;
-	uint16_t	CO2LevelExhaustAir = 0;
-	float		SupplyInletTemperature = 0.0f;
-	float		SupplyOutletTemperature = 0.0f;
-	float		ExhaustInletTemperature = 0.0f;
-	float		ExhaustOutletTemperature = 0.0f;
-	uint16_t	ActualExhaustFanSpeed = 0;
-	uint16_t 	ActualSupplyFanSpeed = 0;
-	uint16_t	RemoteParameterSettingVH = 0;
-	uint16_t	NominalVentilationValue = 0;
-	uint16_t	TSPNumberVH = 0;
-	uint16_t	TSPEntryVH = 0;
-	uint16_t	FaultBufferSizeVH = 0;
-	uint16_t	FaultBufferEntryVH = 0;
-
-	//Statitics
-	uint16_t 	BurnerUnsuccessfulStarts = 0;
-	uint16_t	FlameSignalTooLow = 0;
-	uint16_t 	RemoteOverrideFunction = 0; // flag8 / -  Function of manual and program changes in master and remote room setpoint. 
-	uint16_t 	OEMDiagnosticCode = 0; // u16  OEM-specific diagnostic/service code 
-	uint16_t 	BurnerStarts = 0; // u16  Number of starts burner 
-	uint16_t 	CHPumpStarts = 0; // u16  Number of starts CH pump 
-	uint16_t 	DHWPumpValveStarts = 0; // u16  Number of starts DHW pump/valve 
-	uint16_t 	DHWBurnerStarts = 0; // u16  Number of starts burner during DHW mode 
-	uint16_t 	BurnerOperationHours = 0; // u16  Number of hours that burner is in operation (i.e. flame on) 
-	uint16_t 	CHPumpOperationHours = 0; // u16  Number of hours that CH pump has been running 
-	uint16_t 	DHWPumpValveOperationHours = 0; // u16  Number of hours that DHW pump has been running or DHW valve has been opened 
-	uint16_t 	DHWBurnerOperationHours = 0; // u16  Number of hours that burner is in operation during DHW mode 
-	float 		OpenThermVersionMaster = 0.0f; // f8.8  The implemented version of the OpenTherm Protocol Specification in the master. 
-	float 		OpenThermVersionSlave = 0.0f; // f8.8  The implemented version of the OpenTherm Protocol Specification in the slave. 
-	uint16_t 	MasterVersion = 0; // u8 / u8  Master product version number and type 
-	uint16_t 	SlaveVersion = 0; // u8 / u8  Slave product version number and type
-
-	//Rehmea
-	uint16_t	RemehadFdUcodes = 0; // u16 Remeha dF-/dU-codes
-	uint16_t 	RemehaServicemessage = 0; // u16 Remeha Servicemessage
-	uint16_t    RemehaDetectionConnectedSCU =0; // u16 Remeha detection connected SCU’s
-
-	//errors
-	uint16_t	error01 = 0;
-	uint16_t	error02 = 0;
-	uint16_t	error03 = 0;
-	uint16_t	error04 = 0;
-	uint16_t	errorBufferOverflow = 0;
-
-} OTdataStruct;
+// Decoded OpenTherm state (host-compilable; see OTdataStruct.h).
+#include "OTdataStruct.h"
 
 static OTdataStruct OTcurrentSystemState;
 
@@ -197,315 +52,18 @@ static OTdataStruct OTcurrentSystemState;
 inline bool isFlameOn()   { return (OTcurrentSystemState.Statusflags & 0x08) != 0; }  // Slave bit 3
 inline bool isDHWActive() { return (OTcurrentSystemState.SlaveStatus  & 0x04) != 0; }  // Slave bit 2
 
-// Value type enum for OTlogStruct
-enum OTValueType {
-	OT_VALTYPE_NONE = 0,
-	OT_VALTYPE_F88,      // float (f8.8)
-	OT_VALTYPE_S16,      // signed 16-bit
-	OT_VALTYPE_U16,      // unsigned 16-bit
-	OT_VALTYPE_U8U8,     // two unsigned 8-bit values
-	OT_VALTYPE_S8S8,     // two signed 8-bit values
-	OT_VALTYPE_FLAG8,    // 8-bit flags
-	OT_VALTYPE_FLAG8FLAG8, // two 8-bit flags
-	OT_VALTYPE_STATUS,   // status flags (master/slave)
-	OT_VALTYPE_DATETIME, // date or time
-	OT_VALTYPE_SPECIAL   // special formatting
-};
+// OpenTherm enums + OTmap[] lookup table (host-compilable; see OTmap.h).
+#include "OTmap.h"
+// Compile-time message-id -> decoder/state-field table (host-compilable).
+#include "OTDispatch.h"
+// Integer f8.8 conversion and two-decimal formatting (host-compilable).
+#include "OTF88.h"
+// Single-pass raw frame parser used by processOT() (host-compilable).
+#include "OTFrameParse.h"
+// PIC command queue slots, code index and due heap (host-compilable).
+#include "OTCmdQueue.h"
 
-enum OTLibMessageType {
-	/*  Master to Slave */
-	OT_READ_DATA       = 0b000,
-	OT_WRITE_DATA      = 0b001,
-	OT_INVALID_DATA    = 0b010,
-	OT_RESERVED        = 0b011,
-	/* Slave to Master */
-	OT_READ_ACK        = 0b100,
-	OT_WRITE_ACK       = 0b101,
-	OT_DATA_INVALID    = 0b110,
-	OT_UNKNOWN_DATA_ID = 0b111
-};
-
-enum OTLibMessageID {
-	OT_Statusflags, // flag8 / flag8  Master and Slave Status flags. 
-	OT_TSet, // f8.8  Control setpoint  ie CH  water temperature setpoint (°C)
-	OT_MasterConfigMemberIDcode, // flag8 / u8  Master Configuration Flags /  Master MemberID Code 
-	OT_SlaveConfigMemberIDcode, // flag8 / u8  Slave Configuration Flags /  Slave MemberID Code 
-	OT_Command, // u8 / u8  Remote Command 
-	OT_ASFflags, // / OEM-fault-code  flag8 / u8  Application-specific fault flags and OEM fault code 
-	OT_RBPflags, // flag8 / flag8  Remote boiler parameter transfer-enable & read/write flags 
-	OT_CoolingControl, // f8.8  Cooling control signal (%) 
-	OT_TsetCH2, // f8.8  Control setpoint for 2e CH circuit (°C)
-	OT_TrOverride, // f8.8  Remote override room setpoint 
-	OT_TSP, // u8 / u8  Number of Transparent-Slave-Parameters supported by slave 
-	OT_TSPindexTSPvalue, // u8 / u8  Index number / Value of referred-to transparent slave parameter. 
-	OT_FHBsize, // u8 / u8  Size of Fault-History-Buffer supported by slave 
-	OT_FHBindexFHBvalue, // u8 / u8  Index number / Value of referred-to fault-history buffer entry. 
-	OT_MaxRelModLevelSetting, // f8.8  Maximum relative modulation level setting (%) 
-	OT_MaxCapacityMinModLevel, // u8 / u8  Maximum boiler capacity (kW) / Minimum boiler modulation level(%) 
-	OT_TrSet, // f8.8  Room Setpoint (°C)
-	OT_RelModLevel, // f8.8  Relative Modulation Level (%) 
-	OT_CHPressure, // f8.8  Water pressure in CH circuit  (bar) 
-	OT_DHWFlowRate, // f8.8  Water flow rate in DHW circuit. (litres/minute) 
-	OT_DayTime, // special / u8  Day of Week and Time of Day 
-	OT_Date, // u8 / u8  Calendar date 
-	OT_Year, // u16  Calendar year 
-	OT_TrSetCH2, // f8.8  Room Setpoint for 2nd CH circuit (°C)
-	OT_Tr, // f8.8  Room temperature (°C)
-	OT_Tboiler, // f8.8  Boiler flow water temperature (°C)
-	OT_Tdhw, // f8.8  DHW temperature (°C)
-	OT_Toutside, // f8.8  Outside temperature (°C)
-	OT_Tret, // f8.8  Return water temperature (°C)
-	OT_Tsolarstorage, // f8.8  Solar storage temperature (°C)
-	OT_Tsolarcollector, // s16  Solar collector temperature (°C)
-	OT_TflowCH2, // f8.8  Flow water temperature CH2 circuit (°C)
-	OT_Tdhw2, // f8.8  Domestic hot water temperature 2 (°C)
-	OT_Texhaust, // s16  Boiler exhaust temperature (°C)
-	OT_Theatexchanger, // f8.8 Heat exchanger temperature (°C)
-	OT_FanSpeed = 35, // u8 / u8  Fan Speed setpoint / actual (Hz)
-	OT_ElectricalCurrentBurnerFlame, // f88 Electrical current through burner flame (µA)
-	OT_TRoomCH2, // f88  Room Temperature for 2nd CH circuit ("°C)
-	OT_RelativeHumidity, // f8.8 Relative Humidity (%)
-	OT_TrOverride2 = 39, // f8.8  Remote override room setpoint 2 (°C)
-	OT_TdhwSetUBTdhwSetLB = 48, // s8 / s8  DHW setpoint upper & lower bounds for adjustment  (°C)
-	OT_MaxTSetUBMaxTSetLB, // s8 / s8  Max CH water setpoint upper & lower bounds for adjustment  (°C)
-	OT_HcratioUBHcratioLB, // s8 / s8  OTC heat curve ratio upper & lower bounds for adjustment  
-	OT_Remoteparameter4boundaries, // s8 / s8  Remote Parameter ratio upper & lower bounds for adjustment
-	OT_Remoteparameter5boundaries, // s8 / s8  Remote Parameter upper & lower bounds for adjustment
-	OT_Remoteparameter6boundaries, // s8 / s8  Remote Parameter upper & lower bounds for adjustment
-	OT_Remoteparameter7boundaries, // s8 / s8  Remote Parameter upper & lower bounds for adjustment
-	OT_Remoteparameter8boundaries, // s8 / s8  Remote Parameter upper & lower bounds for adjustment
-	OT_TdhwSet = 56, // f8.8  DHW setpoint (°C)    (Remote parameter 1)
-	OT_MaxTSet, // f8.8  Max CH water setpoint (°C)  (Remote parameters 2)
-	OT_Hcratio, // f8.8  OTC heat curve ratio (°C)  (Remote parameter 3)
-	OT_Remoteparameter4, // f8.8  Remote parameter 4 (°C)  (Remote parameter 4)
-	OT_Remoteparameter5, // f8.8  Remote parameter 5 (°C)  (Remote parameter 5)
-	OT_Remoteparameter6, // f8.8  Remote parameter 6 (°C)  (Remote parameter 6)
-	OT_Remoteparameter7, // f8.8  Remote parameter 7 (°C)  (Remote parameter 7)
-	OT_Remoteparameter8, // f8.8  Remote parameter 8 (°C)  (Remote parameter 8)
-	OT_StatusVH = 70, // flag8 / flag8 Status Ventilation/Heat recovery
-	OT_ControlSetpointVH, // u8 Control setpoint V/H
-	OT_ASFFaultCodeVH, // flag8 / u8 Aplication Specific Fault Flags/Code V/H
-	OT_DiagnosticCodeVH, // u16 Diagnostic Code V/H
-	OT_ConfigMemberIDVH, // flag8 / u8 Config/Member ID V/H
-	OT_OpenthermVersionVH, // f8.8 OpenTherm Version V/H
-	OT_VersionTypeVH,	// u8 / u8 Version & Type V/H
-	OT_RelativeVentilation, // u8 Relative Ventilation (%)
-	OT_RelativeHumidityExhaustAir, // LB u8 Relative Humidity Exhaust Air (%), HB reserved
-	OT_CO2LevelExhaustAir, // u16 CO2 Level (ppm)
- 	OT_SupplyInletTemperature,	// f8.8 Supply Inlet Temperature (°C)
- 	OT_SupplyOutletTemperature, // f8.8 Supply Outlet Temperature(°C)
- 	OT_ExhaustInletTemperature, // f8.8 Exhaust Inlet Temperature (°C)
- 	OT_ExhaustOutletTemperature, // f8.8 Exhaust Outlet Temperature (°C)
-	OT_ActualExhaustFanSpeed, // u16 Actual Exhaust Fan Speed (rpm)
-	OT_ActualSupplyFanSpeed, // u16 Actual Supply Fan Speed (rpm) 
-	OT_RemoteParameterSettingVH, // flag8 / flag8 Remote Parameter Setting V/H
-	OT_NominalVentilationValue, // u8 Nominal Ventilation Value
-	OT_TSPNumberVH, // u8 / u8 TSP Number V/H
-	OT_TSPEntryVH,	// u8 / u8 TSP Entry V/H
-	OT_FaultBufferSizeVH, // u8 / u8 Fault Buffer Size V/H
-	OT_FaultBufferEntryVH,	// u8 / u8 Fault Buffer Entry V/H
-	OT_Brand = 93, // u8 / u8 Brand name (index/char)
-	OT_BrandVersion, // u8 / u8 Brand version (index/char)
-	OT_BrandSerialNumber, // u8 / u8 Brand serial number (index/char)
-	OT_CoolingOperationHours, // u16 Cooling operation hours
-	OT_PowerCycles, // u16 Power cycles
-	OT_RFstrengthbatterylevel=98, // special RF sensor status information
-	OT_OperatingMode_HC1_HC2_DHW, // special Remote Override Operating Mode (Heating/DHW)
-	OT_RemoteOverrideFunction, // flag8 / -  Function of manual and program changes in master and remote room setpoint. 
-	OT_SolarStorageMaster,	// flag8 / flag8  Solar Storage  Master flags.
-	OT_SolarStorageASFflags, // flag8 / u8 / Solar Storage OEM-fault-code  flag8 / u8  Application-specific fault flags and OEM fault code 
-	OT_SolarStorageSlaveConfigMemberIDcode, // flag8 / u8  Solar Storage Master Configuration Flags /  Master MemberID Code 
-	OT_SolarStorageVersionType, // u8 / u8 / Solar Storage product version number and type
-	OT_SolarStorageTSP,	// u8 / u8 / Solar Storage Number of Transparent-Slave-Parameters supported
-	OT_SolarStorageTSPindexTSPvalue, // u8 / u8 / Solar Storage Index number / Value of referred-to transparent slave parameter
-	OT_SolarStorageFHBsize, // u8 /u8 / Solar Storage Size of Fault-History-Buffer supported by slave
-	OT_SolarStorageFHBindexFHBvalue, // u8 /u8 / Solar Storage Index number / Value of referred-to fault-history buffer entry
-	OT_ElectricityProducerStarts, // u16 Electricity producer starts
-	OT_ElectricityProducerHours, //u16 Electricity producer hours
-	OT_ElectricityProduction, //u16 Electricity production
-	OT_CumulativeElectricityProduction, // u16 Cumulative Electricity production
-	OT_BurnerUnsuccessfulStarts, // u16 Number of Un-successful burner starts 
-	OT_FlameSignalTooLow, //u16 Number of times flame signal too low
-	OT_OEMDiagnosticCode, // u16  OEM-specific diagnostic/service code 
-	OT_BurnerStarts, // u16  Number of starts burner 
-	OT_CHPumpStarts, // u16  Number of starts CH pump 
-	OT_DHWPumpValveStarts, // u16  Number of starts DHW pump/valve 
-	OT_DHWBurnerStarts, // u16  Number of starts burner during DHW mode 
-	OT_BurnerOperationHours, // u16  Number of hours that burner is in operation (i.e. flame on) 
-	OT_CHPumpOperationHours, // u16  Number of hours that CH pump has been running 
-	OT_DHWPumpValveOperationHours, // u16  Number of hours that DHW pump has been running or DHW valve has been opened 
-	OT_DHWBurnerOperationHours, // u16  Number of hours that burner is in operation during DHW mode 
-	OT_OpenThermVersionMaster, // f8.8  The implemented version of the OpenTherm Protocol Specification in the master. 
-	OT_OpenThermVersionSlave, // f8.8  The implemented version of the OpenTherm Protocol Specification in the slave. 
-	OT_MasterVersion, // u8 / u8  Master product version number and type 
-	OT_SlaveVersion, // u8 / u8  Slave product version number and type
-	// Explicit: ids 128-130 are unassigned OEM space (OTmap[] holds empty
-	// placeholders there). Without the =131 these three would fall on 128/129/130,
-	// three below their real ids, so MsgIDs 131-133 decoded as "Unknown message"
-	// while 128-130 produced label-less output. Numbering per
-	// docs/opentherm specification/New OT data-ids.txt. (TASK-1068)
-	OT_RemehadFdUcodes = 131, // u8 / u8 Remeha dF-/dU-codes
-	OT_RemehaServicemessage, // u8 / u8 Remeha Servicemessage
-	OT_RemehaDetectionConnectedSCU, // u8 / u8 Remeha detection connected SCU’s
-};
-	enum OTtype_t { ot_f88, ot_s16, ot_s8s8, ot_u16, ot_u8u8, ot_flag8, ot_flag8flag8, ot_special, ot_flag8u8, ot_u8, ot_undef}; 
- 	enum OTmsgcmd_t { OT_READ, OT_WRITE, OT_RW, OT_UNDEF };
-	
-	struct OTlookup_t
-    {
-        int id;
-        OTmsgcmd_t msgcmd;
-        OTtype_t type;
-        const char* label;
-        const char* friendlyname;
-        const char* unit;
-        bool bSlaveEchoesValue;  // ADR-097: false = slave Write-Ack data byte is per-spec undefined; suppress /boiler publication. Default true.
-    };
-
-	OTlookup_t OTlookupitem;
-
-    const OTlookup_t OTmap[] PROGMEM = {
-        {   0, OT_READ  , ot_flag8flag8,	"Status", "Master and Slave status", "" , true },
-        {   1, OT_WRITE , ot_f88,        	"TSet", "Control setpoint", "°C" , false},
-        {   2, OT_WRITE , ot_flag8u8,    	"MasterConfigMemberIDcode", "Master Config / Member ID", "" , true },
-        {   3, OT_READ  , ot_flag8u8,    	"SlaveConfigMemberIDcode", "Slave Config / Member ID", "" , true },
-        {   4, OT_WRITE , ot_u8u8,       	"Command", "Command-Code", "" , true },
-		{   5, OT_READ  , ot_flag8u8,    	"ASFflags", "Application-specific fault", "" , true },
-		{   6, OT_READ  , ot_flag8flag8,    "RBPflags", "Remote-parameter flags", "" , true },
-		{   7, OT_WRITE , ot_f88,        	"CoolingControl", "Cooling control signal", "%" , false},
-		{   8, OT_WRITE , ot_f88,        	"TsetCH2", "Control setpoint for 2e CH circuit", "°C" , false},
-		{   9, OT_READ  , ot_f88,        	"TrOverride", "Remote override room setpoint", "°C" , true },
-		{  10, OT_READ  , ot_u8u8,       	"TSP", "Number of TSPs", "" , true },
-		{  11, OT_RW    , ot_u8u8,       	"TSPindexTSPvalue", "Index number / Value of referred-to transparent slave parameter", "" , true },
-		{  12, OT_READ  , ot_u8u8,       	"FHBsize", "Size of Fault-History-Buffer supported by slave", "" , true },
-		{  13, OT_READ  , ot_u8u8,       	"FHBindexFHBvalue", "Index number / Value of referred-to fault-history buffer entry", "" , true },
-		{  14, OT_WRITE , ot_f88,        	"MaxRelModLevelSetting", "Maximum relative modulation level setting", "%" , false},
-		{  15, OT_READ  , ot_u8u8,       	"MaxCapacityMinModLevel", "Maximum boiler capacity (kW) / Minimum boiler modulation level(%)", "kW/%" , true },
-		{  16, OT_WRITE , ot_f88,        	"TrSet", "Room Setpoint", "°C" , false},
-		{  17, OT_READ  , ot_f88,        	"RelModLevel", "Relative Modulation Level", "%" , true },
-		{  18, OT_READ  , ot_f88,        	"CHPressure", "CH water pressure", "bar" , true },
-		{  19, OT_READ  , ot_f88,        	"DHWFlowRate", "DHW flow rate", "l/min" , true },
-		{  20, OT_RW    , ot_special,    	"DayTime", "Day of Week and Time of Day", "" , true },
-		{  21, OT_RW    , ot_u8u8,       	"Date", "Calendar date ", "" , true },
-		{  22, OT_RW    , ot_u16,        	"Year", "Calendar year", "" , true },
-		{  23, OT_WRITE , ot_f88,        	"TrSetCH2", "Room Setpoint CH2", "°C" , false},
-		{  24, OT_WRITE , ot_f88,        	"Tr", "Room Temperature", "°C" , false},
-		{  25, OT_READ  , ot_f88,        	"Tboiler", "Boiler water temperature", "°C" , true },
-		{  26, OT_READ  , ot_f88,        	"Tdhw", "DHW temperature", "°C" , true },
-		{  27, OT_RW    , ot_f88,        	"Toutside", "Outside temperature", "°C" , true },
-		{  28, OT_READ  , ot_f88,        	"Tret", "Return water temperature", "°C" , true },
-		{  29, OT_READ  , ot_f88,        	"Tsolarstorage", "Solar storage temperature", "°C" , true },
-		{  30, OT_READ  , ot_s16,        	"Tsolarcollector", "Solar collector temperature", "°C" , true },
-		{  31, OT_READ  , ot_f88,        	"TflowCH2", "Flow water temperature CH2", "°C" , true },
-		{  32, OT_READ  , ot_f88,        	"Tdhw2", "DHW2 temperature", "°C" , true },
-		{  33, OT_READ  , ot_s16,        	"Texhaust", "Exhaust temperature", "°C" , true },
-		{  34, OT_READ  , ot_f88, 	 	 	"Theatexchanger", "Boiler heat exchanger temperature", "°C" , true },
-		{  35, OT_READ  , ot_u8u8,	 	 	"FanSpeed", "Boiler fan speed and setpoint", "Hz" , true },
-		{  36, OT_READ  , ot_f88, 			"ElectricalCurrentBurnerFlame", "Electrical current through burner flame", "µA" , true },
-		{  37, OT_WRITE , ot_f88, 			"TRoomCH2", "Room temperature for 2nd CH circuit", "°C" , false},
-		{  38, OT_RW    , ot_f88, 			"RelativeHumidity", "Relative Humidity", "%" }, // OTv4.2 spec §5.3: f8.8 combined (−128.00–+127.996 %); some early Remeha docs described this as u8/u8 but the authoritative v4.2 spec uses f8.8
-		{  39, OT_READ  , ot_f88, 			"TrOverride2", "Remote override room setpoint 2", "°C" , true },
-		{  40, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  41, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  42, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  43, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  44, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  45, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  46, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  47, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  48, OT_READ  , ot_s8s8,        	"TdhwSetUBTdhwSetLB", "DHW setpoint upper & lower bounds for adjustment", "°C" , true },
-		{  49, OT_READ  , ot_s8s8,        	"MaxTSetUBMaxTSetLB", "Max CH water setpoint upper & lower bounds for adjustment", "°C" , true },
-		{  50, OT_READ  , ot_s8s8,        	"HcratioUBHcratioLB", "OTC heat curve ratio upper & lower bounds for adjustment", "°C" , true },
-		{  51, OT_READ  , ot_s8s8, 		  	"Remoteparameter4boundaries", "Remote parameter 4 boundaries", "" , true },
-		{  52, OT_READ  , ot_s8s8, 		  	"Remoteparameter5boundaries", "Remote parameter 5 boundaries", "" , true },
-		{  53, OT_READ  , ot_s8s8, 		  	"Remoteparameter6boundaries", "Remote parameter 6 boundaries", "" , true },
-		{  54, OT_READ  , ot_s8s8, 		  	"Remoteparameter7boundaries", "Remote parameter 7 boundaries", "" , true },
-		{  55, OT_READ  , ot_s8s8, 		  	"Remoteparameter8boundaries", "Remote parameter 8 boundaries", "" , true },
-		{  56, OT_RW    , ot_f88,         	"TdhwSet", "DHW setpoint", "°C" , true },
-		{  57, OT_RW    , ot_f88,         	"MaxTSet", "Max CH water setpoint", "°C" , true },
-		{  58, OT_RW    , ot_f88,         	"Hcratio", "OTC heat curve ratio", "°C" , true },
-		{  59, OT_RW 	, ot_f88, 		  	"Remoteparameter4", "Remote parameter 4", "" , true },
-		{  60, OT_RW 	, ot_f88,         	"Remoteparameter5", "Remote parameter 5", "" , true },
-		{  61, OT_RW 	, ot_f88,         	"Remoteparameter6", "Remote parameter 6", "" , true },
-		{  62, OT_RW 	, ot_f88,         	"Remoteparameter7", "Remote parameter 7", "" , true },
-		{  63, OT_RW 	, ot_f88,         	"Remoteparameter8", "Remote parameter 8", "" , true },
-		{  64, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  65, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  66, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  67, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  68, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  69, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  70, OT_READ  , ot_flag8flag8,  	"StatusVH", "Status Ventilation/Heat recovery", "" , true },
-		{  71, OT_WRITE , ot_u8, 			"ControlSetpointVH", "Control setpoint V/H", "%" , false},
-		{  72, OT_READ  , ot_flag8u8, 		"ASFFaultCodeVH", "Application-specific Fault Flags/Code V/H", "" , true },
-		{  73, OT_READ  , ot_u16,		 	"DiagnosticCodeVH", "Diagnostic code V/H", "" , true },
-		{  74, OT_READ  , ot_flag8u8,		"ConfigMemberIDVH", "Config/Member ID V/H", "" , true },
-		{  75, OT_READ  , ot_f88, 			"OpenthermVersionVH", "OpenTherm version V/H", "" , true },
-		{  76, OT_READ  , ot_u8u8, 			"VersionTypeVH", "Product version & type V/H", "" , true },
-		{  77, OT_READ  , ot_u8, 			"RelativeVentilation", "Relative ventilation", "%" , true },
-		{  78, OT_RW    , ot_u8, 			"RelativeHumidityExhaustAir", "Relative humidity exhaust air", "%" , true },
-		{  79, OT_RW    , ot_u16, 			"CO2LevelExhaustAir", "CO2 level exhaust air", "ppm" , true },
- 		{  80, OT_READ  , ot_f88, 			"SupplyInletTemperature", "Supply inlet temperature", "°C" , true },
- 		{  81, OT_READ  , ot_f88, 			"SupplyOutletTemperature", "Supply outlet temperature", "°C" , true },
- 		{  82, OT_READ  , ot_f88, 			"ExhaustInletTemperature", "Exhaust inlet temperature", "°C" , true },
- 		{  83, OT_READ  , ot_f88, 			"ExhaustOutletTemperature", "Exhaust outlet temperature", "°C" , true },
-		{  84, OT_READ  , ot_u16, 			"ActualExhaustFanSpeed", "Actual exhaust fan speed", "rpm" , true },
-		{  85, OT_READ  , ot_u16, 			"ActualSupplyFanSpeed", "Actual supply fan speed", "rpm" , true },
-		{  86, OT_READ  , ot_flag8flag8, 	"RemoteParameterSettingVH", "Remote Parameter Setting V/H", "" , true },
-		{  87, OT_RW 	, ot_u8, 			"NominalVentilationValue", "Nominal Ventilation Value", "%" , true },
-		{  88, OT_READ  , ot_u8u8, 			"TSPNumberVH", "TSP Number V/H", "" , true },
-		{  89, OT_RW    , ot_u8u8, 			"TSPEntryVH", "TSP setting V/H", "" , true },
-		{  90, OT_READ  , ot_u8u8, 			"FaultBufferSizeVH", "Fault Buffer Size V/H", "" , true },
-		{  91, OT_READ  , ot_u8u8, 			"FaultBufferEntryVH", "Fault Buffer Entry V/H", "" , true },
-		{  92, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{  93, OT_READ  , ot_u8u8, 			"Brand", "Boiler brand name (index/char)", "" , true },
-		{  94, OT_READ  , ot_u8u8, 			"BrandVersion", "Boiler brand version (index/char)", "" , true },
-		{  95, OT_READ  , ot_u8u8, 			"BrandSerialNumber", "Boiler brand serial number (index/char)", "" , true },
-		{  96, OT_RW    , ot_u16, 			"CoolingOperationHours", "Cooling operation hours", "hrs" , true },
-		{  97, OT_RW    , ot_u16, 			"PowerCycles", "Power cycles", "" , true },
-		{  98, OT_WRITE , ot_special, 		"RFstrengthbatterylevel", "RF sensor status information", "" , false},
-		{  99, OT_RW    , ot_special, 		"OperatingMode_HC1_HC2_DHW", "Remote Override Operating Mode (Heating/DHW)", "" , true },
-		{ 100, OT_READ  , ot_flag8,       	"RoomRemoteOverrideFunction", "Function of manual and program changes in master and remote room setpoint.", "" , true },
-		{ 101, OT_READ  , ot_flag8flag8, 	"SolarStorageMaster", "Solar Storage Master mode", "" , true },
-		{ 102, OT_READ  , ot_flag8u8,    	"SolarStorageASFflags", "Solar Storage Application-specific flags and OEM fault", "" , true },
-        { 103, OT_READ  , ot_flag8u8,    	"SolarStorageSlaveConfigMemberIDcode", "Solar Storage Slave Config / Member ID", "" , true },
-		{ 104, OT_READ  , ot_u8u8,        	"SolarStorageVersionType", "Solar Storage product version number and type", "" , true },
-		{ 105, OT_READ  , ot_u8u8,       	"SolarStorageTSP", "Solar Storage Number of Transparent-Slave-Parameters supported", "" , true },
-		{ 106, OT_RW    , ot_u8u8,       	"SolarStorageTSPindexTSPvalue", "Solar Storage Index number / Value of referred-to transparent slave parameter", "" , true },
-		{ 107, OT_READ  , ot_u8u8,       	"SolarStorageFHBsize", "Solar Storage Size of Fault-History-Buffer supported by slave", "" , true },
-		{ 108, OT_READ  , ot_u8u8,       	"SolarStorageFHBindexFHBvalue", "Solar Storage Index number / Value of referred-to fault-history buffer entry", "" , true },
-		{ 109, OT_RW    , ot_u16, 			"ElectricityProducerStarts", "Electricity producer starts", "" , true },
-		{ 110, OT_RW    , ot_u16, 			"ElectricityProducerHours", "Electricity producer hours", "" , true },
-		{ 111, OT_READ  , ot_u16, 			"ElectricityProduction", "Electricity production", "" , true },
-		{ 112, OT_RW    , ot_u16, 			"CumulativeElectricityProduction", "Cumulative Electricity production", "" , true },
-		{ 113, OT_RW    , ot_u16,         	"BurnerUnsuccessfulStarts", "Unsuccessful burner starts", "" , true },
-		{ 114, OT_RW    , ot_u16,         	"FlameSignalTooLow", "Flame signal too low count", "" , true },
-		{ 115, OT_READ  , ot_u16,         	"OEMDiagnosticCode", "OEM-specific diagnostic/service code", "" , true },
-		{ 116, OT_RW    , ot_u16,         	"BurnerStarts", "Burner starts", "" , true },
-		{ 117, OT_RW    , ot_u16,         	"CHPumpStarts", "CH pump starts", "" , true },
-		{ 118, OT_RW    , ot_u16,         	"DHWPumpValveStarts", "DHW pump/valve starts", "" , true },
-		{ 119, OT_RW    , ot_u16,         	"DHWBurnerStarts", "DHW burner starts", "" , true },
-		{ 120, OT_RW    , ot_u16,         	"BurnerOperationHours", "Burner operation hours", "hrs" , true },
-		{ 121, OT_RW    , ot_u16,         	"CHPumpOperationHours", "CH pump operation hours", "hrs" , true },
-		{ 122, OT_RW    , ot_u16,         	"DHWPumpValveOperationHours", "DHW pump/valve operation hours", "hrs" , true },
-		{ 123, OT_RW    , ot_u16,         	"DHWBurnerOperationHours", "DHW burner operation hours", "hrs" , true },
-		{ 124, OT_WRITE , ot_f88,			"OpenThermVersionMaster", "Master Version OpenTherm Protocol Specification", "" , true },
-		{ 125, OT_READ  , ot_f88,			"OpenThermVersionSlave", "Slave Version OpenTherm Protocol Specification", "" , true },
-		{ 126, OT_WRITE , ot_u8u8,			"MasterVersion", "Master product version number and type", "" , true },
-		{ 127, OT_READ  , ot_u8u8,			"SlaveVersion", "Slave product version number and type", "" , true },
-		{ 128, OT_UNDEF , ot_undef,			"", "", "" , true },
-		{ 129, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{ 130, OT_UNDEF , ot_undef, 		"", "", "" , true },
-		{ 131, OT_RW 	, ot_u8u8, 			"RemehadFdUcodes", "Remeha dF-/dU-codes", "" , true },
-		{ 132, OT_READ 	, ot_u8u8, 			"RemehaServicemessage", "Remeha Servicemessage", "" , true },
-		{ 133, OT_READ 	, ot_u8u8, 			"RemehaDetectionConnectedSCU", "Remeha detection connected SCU’s", "" , true },
-		// all data ids are not defined above are resevered for future use
-		// A foney id is used for sensors on GPIO ports, 
- 		// 245 for counter and 
- 		// 246 for Dallas temperature sensors
-	};
-
-#define OT_MSGID_MAX 133
+OTlookup_t OTlookupitem;
 
 // Global arrays defined in OTGW-Core.ino (extern declarations here to avoid ODR violations).
 // Definitions in headers cause duplicate-symbol linker errors in any multi-TU build.
@@ -515,6 +73,9 @@ extern uint32_t mqttlastsent[];            // packed throttle state for OT msgid
 extern uint16_t mqttlastsentstatusbit[16]; // per-bit publish timers for OT_Statusflags (slots 0-7=master, 8-15=slave)
 extern bool     mqttPublishAllowed;        // MQTT interval gate — managed via OTPublishGate, checked in sendMQTTData
 uint16_t getMsgLastUpdated(uint8_t msgId); // rolling seconds-since-boot for REST last-updated fields (0 when unseen)
+uint16_t getMsgAgeSeconds(uint8_t msgId);  // seconds since the last update, 0xFFFF when unseen or untracked
+uint32_t getMsgGen(const OTdataStruct &ot, uint8_t msgId); // generation of msgId's last value change in ot (OTmonDelta.h)
+void clearMQTTPublishDedup();              // forget the last payload per value topic (MQTTPublishDedup.h)
 void requestMQTTRepublishAll();            // reset MQTT publish eligibility so next observed values publish as first-seen again
 void requestMQTTStatusRepublish();         // force the next observed master/slave status frames to republish
 void confirmMQTTPublishSlot();             // confirm pending throttle slot update after successful MQTT publish
@@ -529,25 +90,30 @@ void processOT(const char *buf, int len, bool suppressOutput = false);
 
 // ===== ADR-123 Phase-1 concurrency foundation (TASK-865.5) ================
 //
-// 1) OT-frame producer/consumer queue. The two frame sources (PIC serial via
-//    dispatchOTGWInputLine(), and OTDirect via bridgeFrameToParser()) no longer
-//    call processOT() inline; instead they enqueue the raw line as an OTFrameMsg
-//    and a single consumer in loop() dequeues + calls processOT(). The queue
-//    copies by value (FreeRTOS), so no mutex is needed for the frame flow and
-//    FIFO order is preserved (byte-identical OT-log/MQTT output).
+// 1) OT-frame producer/consumer ring. The frame sources (PIC serial via the
+//    PIC task / dispatchOTGWInputLine(), and OTDirect via bridgeFrameToParser())
+//    no longer call processOT() inline; instead they append the raw line to
+//    otFrameRing and a single consumer in loop() parses it in place. FIFO order
+//    is preserved (byte-identical OT-log/MQTT output).
 //
-//    Why line[MAX_BUFFER_READ] and not [10]: processOT() is fed the FULL PIC
-//    line, not only 9-char OT frames — banners, '='-command-echoes and PS=1
-//    summaries (>256 bytes) all route through its else-if branches and produce
+//    Why MAX_BUFFER_READ and not 10: processOT() is fed the FULL PIC line, not
+//    only 9-char OT frames — banners, '='-command-echoes and PS=1 summaries
+//    (>256 bytes) all route through its else-if branches and produce
 //    observable output. A 9-char item would truncate them and break
-//    byte-identical replay. (Spec said line[10]; primary-source evidence at
-//    OTGW-Core.ino dispatchOTGWInputLine/processOT overrides it. Documented in
-//    the TASK-865.5 single-writer-map appendix.)
+//    byte-identical replay. (Documented in the TASK-865.5 single-writer-map
+//    appendix.)
+//
+//    The ring (PlatformSpscRing, platform.h) stores variable-length records,
+//    so a 9-char frame costs 16 bytes instead of a 516-byte queue item, and the
+//    line is copied once (producer buffer -> ring) instead of twice (into the
+//    item, then through xQueueSend/xQueueReceive). Each record is the line plus
+//    its NUL terminator: processOT()'s non-OT branches use strstr/strchr/
+//    strcasecmp_P, which read until a terminator.
 //
-//    POD by contract (static_assert trivially_copyable) so xQueueSend can copy
-//    it byte-for-byte. The producer MUST null-terminate line[len] before
-//    enqueue: processOT()'s non-OT branches use strstr/strchr/strcasecmp_P,
-//    which read until a terminator.
+//    Single producer context: the PIC task parks whenever OTDirect or the replay
+//    simulation is active (picSerialTaskShouldPark), and the loop-side producers
+//    only append once the park is acknowledged (otFrameLoopProducerReady), so
+//    the PIC task and loop never append at the same time.
 // Frame source: which producer enqueued the line. The consumer applies
 // PIC-specific loop-side side-effects (LED blink + ser2net 25238 mirror) ONLY
 // for PIC-sourced frames — OTDirect already mirrors producer-side via
@@ -558,51 +124,56 @@ enum OTFrameSource : uint8_t {
   OTFRAME_SRC_OTDIRECT = 1,   // OTDirect bridged frame (bridgeFrameToParser)
 };
 
-struct OTFrameMsg {
-  char     line[MAX_BUFFER_READ];  // null-terminated raw PIC/OTDirect line
-  uint16_t len;                    // payload length (excludes terminator); up to 511
-  bool     suppressOutput;         // PIC path: false; OTDirect path: otHideReports
-  uint8_t  source;                 // OTFrameSource: who produced this line
-};
-static_assert(std::is_trivially_copyable<OTFrameMsg>::value,
-              "OTFrameMsg must be trivially copyable for value-copy FreeRTOS queue");
+// Record tag: low byte OTFrameSource, bit 8 suppressOutput.
+#define OT_FRAME_TAG(source, suppress)  ((uint16_t)((uint8_t)(source) | ((suppress) ? 0x100u : 0u)))
+#define OT_FRAME_TAG_SOURCE(tag)        ((uint8_t)((tag) & 0xFFu))
+#define OT_FRAME_TAG_SUPPRESS(tag)      (((tag) & 0x100u) != 0)
 
-// Created once in setup() (ADR-044). Depth 16 of 512-byte items (~8 KB SRAM):
-// the producer and consumer are co-resident in one loop iteration in Phase 1,
-// so the queue is effectively pass-through and cannot accumulate beyond a
-// single drain cycle. Sized so it never fills under the per-poll burst.
+// Sized for one full MAX_BUFFER_READ line at any ring position plus a backlog
+// of 16 short frames (16 bytes each) — the depth the old queue had — in ~1.3 KB
+// instead of 16 x 516 bytes. Statically allocated: no create step, never null.
 #define OT_FRAME_QUEUE_DEPTH 16
-extern PlatformQueue otFrameQueue;      // OTFrameMsg producer->consumer queue
+#define OT_FRAME_RING_BYTES  (2 * (MAX_BUFFER_READ + 2 * PLATFORM_SPSC_HDR) + OT_FRAME_QUEUE_DEPTH * 16)
+typedef PlatformSpscRing<OT_FRAME_RING_BYTES> OTFrameRing;
+static_assert(OTFrameRing::kMaxPayload >= MAX_BUFFER_READ,
+              "otFrameRing must hold a full PIC line plus terminator");
+extern OTFrameRing otFrameRing;         // OT line producer->consumer ring
 extern PlatformMutex otStateMutex;      // guards the decoded OTGWState snapshot
 
-// enqueueOTFrame — producer-side helper. Copies up to MAX_BUFFER_READ-1 bytes,
-// null-terminates, and sends by value. Returns false on a full queue (counted
-// as a diagnostic drop; never falls back to inline processOT, which would
-// reorder the FIFO). source tags the producer so the consumer can apply
-// PIC-only side-effects. The ONLY call sites are the frame producers
-// (the PIC task / dispatchOTGWInputLine, bridgeFrameToParser) — enforced by evaluate.py.
+// enqueueOTFrame — producer-side helper. Copies up to MAX_BUFFER_READ-1 bytes
+// into the ring and null-terminates. Returns false on a full ring, or for a
+// loop-side producer while the PIC task is not yet parked (counted as a
+// diagnostic drop; never falls back to inline processOT, which would reorder
+// the FIFO). source tags the producer so the consumer can apply PIC-only
+// side-effects. The ONLY call sites are the frame producers (the PIC task /
+// dispatchOTGWInputLine, bridgeFrameToParser) — enforced by evaluate.py.
 bool enqueueOTFrame(const char *buf, size_t len, bool suppressOutput,
                     uint8_t source = OTFRAME_SRC_PIC);
 
-// drainOTFrameQueue — consumer-side. Dequeues every pending OTFrameMsg and
-// calls processOT() under the OTStateLock (writer side). Runs in loop()
-// context (NOT inside doBackgroundTasks(), which re-enters via doAutoConfigure's
-// file-reading loop). seq6 lifts the producer into a FreeRTOS task; the consumer
-// stays here.
+// otFrameLoopProducerReady — true when a loop-side producer may append to
+// otFrameRing: no PIC task, or the PIC task has acknowledged its park.
+bool otFrameLoopProducerReady();
+
+// drainOTFrameQueue — consumer-side. Parses every pending record in place via
+// processOT() (which takes the OTStateLock writer side) and releases it. Runs
+// in loop() context (NOT inside doBackgroundTasks(), which re-enters via
+// doAutoConfigure's file-reading loop). The producer side runs in the PIC task;
+// the consumer stays here.
 void drainOTFrameQueue();
 
-// 2) OTGWState snapshot mutex + RAII lock. processOT() (the cross-task writer)
-//    and restAPI.ino readers acquire OTStateLock around their access to the
-//    decoded snapshot (OTcurrentSystemState, state.otBus.*, state.sat.*). The
-//    lock is NON-RECURSIVE: a single call chain must never take it twice. It is
-//    held at exactly one writer site (the consumer's processOT() call) and at
-//    reader sites in restAPI.ino — never nested. Mirrors
-//    MQTTAutoConfigSessionLock (MQTTstuff.ino). A null mutex (failed create)
-//    degrades to no-op (unprotected) rather than deadlocked.
-// TASK-879: request-thread (async_tcp) readers MUST pass a bounded timeout, never
-// the default 0 (== portMAX_DELAY, wait forever). The loop-task writer (processOT)
-// holds otStateMutex across per-frame I/O, so an unbounded wait on the async_tcp
-// task can wedge the WDT-subscribed service task and stall every HTTP request.
+// 2) OTGWState snapshot mutex + RAII lock. processOT() (the writer) acquires
+//    OTStateLock around its update of the decoded state (OTcurrentSystemState,
+//    state.otBus.*, state.sat.*), serialising the frame consumer against the
+//    OTDirect synthesis sites. The lock is NON-RECURSIVE: a single call chain
+//    must never take it twice. Mirrors MQTTAutoConfigSessionLock
+//    (MQTTstuff.ino). A null mutex (failed create) degrades to no-op
+//    (unprotected) rather than deadlocked. Cross-task readers of
+//    OTcurrentSystemState use otStateSnapshot (3) instead of this lock.
+// TASK-879: a request-thread (async_tcp) reader that still needs the lock MUST
+// pass a bounded timeout, never the default 0 (== portMAX_DELAY, wait forever).
+// The loop-task writer (processOT) holds otStateMutex across per-frame I/O, so
+// an unbounded wait on the async_tcp task can wedge the WDT-subscribed service
+// task and stall every HTTP request.
 #define OT_STATE_READ_LOCK_MS 100   // bounded acquire for async REST readers
 struct OTStateLock {
   bool locked = false;
@@ -616,6 +187,24 @@ struct OTStateLock {
   OTStateLock& operator=(const OTStateLock&) = delete;
 };
 
+// 3) Published copy of OTcurrentSystemState (OTStateSnapshot.h, seqlock over
+//    two buffers). processOT() publishes it on the way out, still under the
+//    writer's OTStateLock; readers on other tasks (sendOTmonitorV2, the
+//    webhook payload) call otStateSnapshot.read() and get the state as of the
+//    last completed frame — never torn, and without ever blocking the writer.
+//    Loop-side readers (MQTT, SAT, OLED, webhook edge detection) run on the
+//    writer's own task and keep reading OTcurrentSystemState directly.
+static OTStateSnapshot<OTdataStruct> otStateSnapshot;
+
+// RAII: publish OTcurrentSystemState when processOT() returns, whichever
+// return path it takes. Declare it AFTER the OTStateLock so it runs first.
+struct OTStatePublishOnExit {
+  OTStatePublishOnExit() = default;
+  ~OTStatePublishOnExit() { otStateSnapshot.publish(OTcurrentSystemState); }
+  OTStatePublishOnExit(const OTStatePublishOnExit&) = delete;
+  OTStatePublishOnExit& operator=(const OTStatePublishOnExit&) = delete;
+};
+
 // ===== ADR-123 Phase-1 PIC-UART dedicated task (TASK-865.6) ================
 //
 // The PIC UART (OTGWSerial) moves onto a dedicated FreeRTOS task pinned to the
@@ -629,9 +218,9 @@ struct OTStateLock {
 //
 // Split of responsibilities (keeps OTGWState single-writer, no hot-path mutex):
 //   - RX: the task reads bytes, assembles CR/LF lines, and pushes each line onto
-//     the OTFrameMsg queue via dispatchOTGWInputLine (the seq5 enqueue helper).
+//     otFrameRing (enqueueOTFrame, the seq5 enqueue helper).
 //     The consumer (drainOTFrameQueue, loop() context) still parses via processOT.
-//   - TX: handleCommandQueue()/checkCommandResponse()/cmdqueue[] stay loop-side;
+//   - TX: handleCommandQueue()/checkCommandResponse()/cmdQueue stay loop-side;
 //     sendPICSerial() and the ser2net net->serial relay no longer call
 //     OTGWSerial.write() directly — they enqueue raw bytes onto otTxQueue, and
 //     the task pops + writes them.
@@ -689,16 +278,23 @@ struct OTPublishGate {
   OTPublishGate& operator=(const OTPublishGate&) = delete;
 };
 
-struct OT_cmd_t { // see all possible commands for PIC here: https://otgw.tclcode.com/firmware.html
-	char cmd[15];
-	int cmdlen;
-	int retrycnt;
-	unsigned long due;
+// MQTT publish window around one decoded OT frame (MQTTPublishBatch.h,
+// MQTTstuff.ino). Inside the window the link/heap gate of sendMQTTData() is
+// evaluated once and reused; mqttPublishAllowed stays per topic. Nests.
+void beginMQTTPublishBatch();
+void commitMQTTPublishBatch();
+
+// Usage:  { MQTTPublishBatchScope batch; OTPublishGate gate(...); decodeAndPublishOTValue(); }
+struct MQTTPublishBatchScope {
+  MQTTPublishBatchScope() { beginMQTTPublishBatch(); }
+  ~MQTTPublishBatchScope() { commitMQTTPublishBatch(); }
+  MQTTPublishBatchScope(const MQTTPublishBatchScope&) = delete;
+  MQTTPublishBatchScope& operator=(const MQTTPublishBatchScope&) = delete;
 };
 
-#define CMDQUEUE_MAX 20
-extern struct OT_cmd_t cmdqueue[CMDQUEUE_MAX];
-extern int cmdQueueSize;  // fill-pointer: number of active entries (0..CMDQUEUE_MAX)
+// PIC command queue (ADR-016): OT_cmd_t slots with a 26x26 code index and a
+// due-time min-heap, see OTCmdQueue.h. CMDQUEUE_MAX can be set as a build flag.
+extern OTCmdQueue<CMDQUEUE_MAX> cmdQueue;
 
 /**
  * Structure to hold Opentherm data packet content.
@@ -717,6 +313,10 @@ enum OTGW_response_type {
 	OTGW_PARITY_ERROR,
 	OTGW_UNDEF	
 };
+// otParseFrame() (OTFrameParse.h) reports the source letter in this order.
+static_assert(OTGW_BOILER == OT_RAW_SRC_BOILER && OTGW_THERMOSTAT == OT_RAW_SRC_THERMOSTAT &&
+              OTGW_ANSWER_THERMOSTAT == OT_RAW_SRC_ANSWER && OTGW_REQUEST_BOILER == OT_RAW_SRC_REQUEST &&
+              OTGW_PARITY_ERROR == OT_RAW_SRC_PARITY, "OTRawFrameSource must mirror OTGW_response_type");
 #define OT_MSGTYPE_REQUEST  0  // masterslave: 0=master (thermostat → boiler request)
 #define OT_MSGTYPE_RESPONSE 1  // masterslave: 1=slave  (boiler → thermostat response)
 
@@ -735,7 +335,7 @@ struct OpenthermData_t {
                             //  - on T: gateway sent R instead → suppresses canonical and /boiler for this T (R wins them)
                             //  - on B: gateway sent A instead → suppresses /thermostat for this B (A wins it)
                             //Worldview routing decisions consult this flag; see publishToSourceTopic() and
-                            //is_value_valid_for_master_topic() in OTGW-Core.ino.
+                            //is_value_valid_for_master_topic() in OTDecode.h.
   byte bAnswerOverride;     //ADR-103: 1 only on an answer-override A (a (B,A) pair was detected); 0 (default)
                             //on a proxy A (no preceding B — e.g. MaxTSet/57). Proxy A reaches _thermostat,
                             //_boiler and canonical; answer-override A reaches _thermostat only (ADR-096 invariant).
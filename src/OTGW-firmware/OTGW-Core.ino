@@ -30,17 +30,19 @@
 **  OpenTherm Data Types             ~ line  598
 **  Status Bit Query Helpers         ~ line  681
 **  MQTT throttle helpers            ~ line  820
-**  OT Message Field Formatters      ~ line 1037
 **  Command Queue implementation      ~ line 1902
 **  Send buffer to OTGW              ~ line 2095
-**  PS=1 Summary Parsing             ~ line 2281
+**  PS=1 Mode                        ~ line 2281
 **  OT Message Processing            ~ line 2725
+**    (decode + publish: OTDecode.h)
 **  HandleOTGW                       ~ line 3256
 **  functions for REST API           ~ line 3403
 **  Upgrade PIC firmware             ~ line 3537
 ***************************************************************************
 */
 
+#include <atomic>
+
 #define OTDebugTln(...) ({ if (state.debug.bOTmsg) DebugTln(__VA_ARGS__);    })
 #define OTDebugln(...)  ({ if (state.debug.bOTmsg) Debugln(__VA_ARGS__);    })
 #define OTDebugTf(...)  ({ if (state.debug.bOTmsg) DebugTf(__VA_ARGS__);    })
@@ -225,15 +227,7 @@ OTOverrideEntry_t otOverrideStore[OVERRIDE_STORE_MAX] = {};
 static constexpr uint8_t MQTT_TRACKED_RESPONSE_ID_COUNT = 128; // linear msgid slots for IDs 0-127
 static constexpr uint16_t MQTT_TRACKED_SLOT_COUNT = MQTT_TRACKED_RESPONSE_ID_COUNT * 2; // response + request view
 
-// TASK-400: Status-bit specific heartbeat interval. Hardcoded to 60 seconds
-// so the msgId 0 status_master / status_slave fan-out (and the msgId 70
-// Status VH equivalent) publishes at least once a minute as a state-snapshot
-// for HA reconnect recovery, INDEPENDENT of settings.mqtt.iInterval (which
-// governs all OTHER topic throttles). The 60s cadence is a compromise: long
-// enough to eliminate per-frame publish spam under steady-state boiler
-// conditions (drops 160 publishes/sec → ~0.27/sec), short enough that HA
-// regains full state within one minute after any MQTT broker reconnect.
-static constexpr uint16_t STATUS_HEARTBEAT_INTERVAL_SEC = 60;
+// TASK-400: status-bit heartbeat, STATUS_HEARTBEAT_INTERVAL_SEC (MQTTstuff.h).
 
 // Global state arrays — defined here (one definition rule), declared extern in OTGW-Core.h. (ADR-044)
 uint32_t mqttlastsent[MQTT_TRACKED_SLOT_COUNT] = {0}; // packed throttle for msgids 0-127: bits31-16=last published u16, bits15-0=seconds-since-boot
@@ -333,6 +327,13 @@ static uint16_t elapsedTrackedSeconds(uint16_t now, uint16_t lastTime)
            : static_cast<uint16_t>((TRACKED_TIME_MODULUS - lastTime) + now);
 }
 
+static_assert(REST_UPDATED_COUNT == OT_GEN_SLOTS, "OTdataStruct::genSlot[] must cover every REST-tracked message");
+
+// Last raw value per tracked slot, for the otmonitor change generations
+// (OTmonDelta.h): a frame only takes a new generation when its value moved.
+static uint16_t restLastValue[REST_UPDATED_COUNT] = {};
+static bool     restValueSeen[REST_UPDATED_COUNT] = {};
+
 static int8_t restLastUpdatedSlotForMsgId(uint8_t msgId)
 {
   switch (msgId) {
@@ -360,7 +361,9 @@ static void clearMsgLastUpdated()
 {
   for (uint8_t i = 0; i < REST_UPDATED_COUNT; i++) {
     restLastUpdated[i] = TRACKED_TIME_UNSEEN;
+    restValueSeen[i] = false;
   }
+  otmonGenReset(OTcurrentSystemState.gen, OTcurrentSystemState.genReset);
 }
 
 uint16_t getMsgLastUpdated(uint8_t msgId)
@@ -371,14 +374,37 @@ uint16_t getMsgLastUpdated(uint8_t msgId)
   return (tracked == TRACKED_TIME_UNSEEN) ? 0 : tracked;
 }
 
-static void setMsgLastUpdated(uint8_t msgId, uint16_t trackedNow)
+// Seconds since msgId last updated its value, 0xFFFF when never seen or not
+// tracked. The rolling counter wraps at ~18 h, so ages near that are not
+// meaningful; callers use this for "fresh within minutes" checks (history).
+uint16_t getMsgAgeSeconds(uint8_t msgId)
+{
+  int8_t slot = restLastUpdatedSlotForMsgId(msgId);
+  if (slot < 0) return TRACKED_TIME_UNSEEN;
+  uint16_t tracked = restLastUpdated[slot];
+  if (tracked == TRACKED_TIME_UNSEEN) return TRACKED_TIME_UNSEEN;
+  return elapsedTrackedSeconds(currentTrackedSeconds(), tracked);
+}
+
+// raw is the frame's 16-bit value; a changed (or first) value takes a new
+// otmonitor generation in OTcurrentSystemState, published with the values.
+static void setMsgLastUpdated(uint8_t msgId, uint16_t trackedNow, uint16_t raw)
 {
   int8_t slot = restLastUpdatedSlotForMsgId(msgId);
   if (slot >= 0) {
     restLastUpdated[slot] = trackedNow;
+    otmonGenNote(OTcurrentSystemState.gen, OTcurrentSystemState.genSlot[slot],
+                 restLastValue[slot], restValueSeen[slot], raw);
   }
 }
 
+// Generation of msgId's last value change in ot (a snapshot), 0 when untracked.
+uint32_t getMsgGen(const OTdataStruct &ot, uint8_t msgId)
+{
+  int8_t slot = restLastUpdatedSlotForMsgId(msgId);
+  return (slot < 0) ? 0 : ot.genSlot[slot];
+}
+
 static bool tryGetTrackedSlotIndex(uint8_t id, byte masterslave, uint8_t &trackedSlot)
 {
   if (id > 127) return false;
@@ -421,52 +447,53 @@ struct TrackingStateInitializer {
 };
 
 static TrackingStateInitializer gTrackingStateInitializer;
-struct OT_cmd_t cmdqueue[CMDQUEUE_MAX];
-int cmdQueueSize = 0;  // fill-pointer: entries are 0..cmdQueueSize-1, left-shift on deletion
+OTCmdQueue<CMDQUEUE_MAX> cmdQueue;  // slots never move; code index + due heap (OTCmdQueue.h)
 
 // ===== ADR-123 Phase-1 concurrency foundation (TASK-865.5) ================
-// Definitions for the OT-frame producer/consumer queue and the OTGWState mutex
-// declared in OTGW-Core.h. Both handles are created ONCE in setupOTConcurrency()
-// (called from setup(), ADR-044). Until then they are nullptr and the shims
-// degrade gracefully (enqueue drops, lock is a no-op).
-PlatformQueue otFrameQueue = nullptr;   // OTFrameMsg producer->consumer queue
+// Definitions for the OT-frame producer/consumer ring and the OTGWState mutex
+// declared in OTGW-Core.h. The ring is a static object; the mutex is created
+// ONCE in setupOTConcurrency() (called from setup(), ADR-044). Until then it is
+// nullptr and the lock shim degrades to a no-op.
+OTFrameRing   otFrameRing;              // OT line producer->consumer ring
 PlatformMutex otStateMutex = nullptr;   // guards the decoded OTGWState snapshot
 
-// Diagnostic counter: OTFrameMsg producers that hit a full queue. Should stay 0
-// in Phase 1 (producer+consumer co-resident per loop iteration). A non-zero
-// value means the depth/drain assumption broke and frames were lost — surfaced
-// for the field-soak AC, never used as a fall-back trigger.
-static uint32_t otFrameQueueDrops = 0;
+// Diagnostic counter: OT lines a producer could not append (full ring, or a
+// loop-side producer before the PIC task parked). Should stay 0; a non-zero
+// value means frames were lost — surfaced for the field-soak AC, never used as
+// a fall-back trigger. Bumped from the PIC task (full ring) and from loop
+// (OTDirect, replay), hence atomic.
+static std::atomic<uint32_t> otFrameQueueDrops{0};
 
-// setupOTConcurrency — create the mutex and frame queue exactly once (ADR-044).
+// setupOTConcurrency — create the mutex and TX queue exactly once (ADR-044).
 // Safe to call before WiFi/MQTT are up; pure FreeRTOS object allocation.
 void setupOTConcurrency() {
   if (otStateMutex == nullptr) otStateMutex = platformMutexCreate();
-  if (otFrameQueue == nullptr) {
-    otFrameQueue = platformQueueCreate(OT_FRAME_QUEUE_DEPTH, sizeof(OTFrameMsg));
-  }
   // TASK-865.6: PIC-UART TX queue (loop-side producers -> dedicated task writer).
   if (otTxQueue == nullptr) {
     otTxQueue = platformQueueCreate(OT_TX_QUEUE_DEPTH, sizeof(OTTxMsg));
   }
 }
 
-// enqueueOTFrame — producer-side. Copy the line (null-terminated), enqueue by
-// value. The ONLY two callers are the frame producers (dispatchOTGWInputLine,
-// bridgeFrameToParser). Returns false on a full queue (diagnostic drop).
+// enqueueOTFrame — producer-side. Copy the line straight into the ring and
+// null-terminate it in place. The ONLY callers are the frame producers (PIC
+// task, dispatchOTGWInputLine, bridgeFrameToParser). Returns false when the
+// line was dropped (diagnostic drop).
 bool enqueueOTFrame(const char *buf, size_t len, bool suppressOutput, uint8_t source) {
-  if (otFrameQueue == nullptr || buf == nullptr || len == 0) return false;
-  OTFrameMsg msg;
-  if (len > sizeof(msg.line) - 1) len = sizeof(msg.line) - 1;  // clamp (defensive)
-  memcpy(msg.line, buf, len);
-  msg.line[len] = '\0';                       // processOT's non-OT branches need a terminator
-  msg.len = (uint16_t)len;
-  msg.suppressOutput = suppressOutput;
-  msg.source = source;
-  if (!platformQueueSend(otFrameQueue, &msg)) {
-    otFrameQueueDrops++;
+  if (buf == nullptr || len == 0) return false;
+  // OTDirect runs loop-side: hold it off until the PIC task stopped appending.
+  if (source == OTFRAME_SRC_OTDIRECT && !otFrameLoopProducerReady()) {
+    otFrameQueueDrops.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  if (len > MAX_BUFFER_READ - 1) len = MAX_BUFFER_READ - 1;  // clamp (defensive)
+  uint8_t *rec = otFrameRing.reserve((uint16_t)(len + 1));
+  if (rec == nullptr) {
+    otFrameQueueDrops.fetch_add(1, std::memory_order_relaxed);
     return false;
   }
+  memcpy(rec, buf, len);
+  rec[len] = '\0';                            // processOT's non-OT branches need a terminator
+  otFrameRing.commit((uint16_t)(len + 1), OT_FRAME_TAG(source, suppressOutput));
   return true;
 }
 
@@ -489,25 +516,29 @@ void drainOTFrameQueue() {
   // single (loop) thread.
   reportPendingPICRxErrors();
 #endif
-  if (otFrameQueue == nullptr) return;
-  OTFrameMsg msg;
-  while (platformQueueReceive(otFrameQueue, &msg, 0)) {
+  uint16_t recLen, tag;
+  const uint8_t *rec;
+  while ((rec = otFrameRing.peek(recLen, tag)) != nullptr) {
+    const char *line = reinterpret_cast<const char*>(rec);
+    const uint16_t len = (uint16_t)(recLen - 1);   // record carries the NUL
     // PIC-only loop-side side-effects (moved off the PIC task, TASK-865.6):
     // the LED blink and the ser2net 25238 mirror used to run producer-side in
     // dispatchOTGWInputLine. OTDirect mirrors producer-side itself, so gate on
     // source to avoid double-emitting OTDirect frames to 25238.
-    if (msg.source == OTFRAME_SRC_PIC) {
+    if (OT_FRAME_TAG_SOURCE(tag) == OTFRAME_SRC_PIC) {
       blinkLEDnow(LED2);
       if (settings.mqtt.bLegacyPort25238Enabled) {
-        OTGWstream.write(reinterpret_cast<const uint8_t*>(msg.line), msg.len);
+        OTGWstream.write(rec, len);
         OTGWstream.write('\r');
         OTGWstream.write('\n');
       }
     }
     // processOT() acquires OTStateLock internally (writer side), covering all
     // five processOT call sites uniformly — not just this consumer. Do NOT wrap
-    // here too: the lock is non-recursive and would self-deadlock.
-    processOT(msg.line, msg.len, msg.suppressOutput);
+    // here too: the lock is non-recursive and would self-deadlock. The line is
+    // parsed in place; the slot goes back to the producer only afterwards.
+    processOT(line, len, OT_FRAME_TAG_SUPPRESS(tag));
+    otFrameRing.release();
     feedWatchDog();                            // bound worst-case drain time
   }
 }
@@ -625,7 +656,7 @@ void picSerialDrainOnce() {
 
       if (!discardCurrentReadLine) {
         sRead[bytes_read] = '\0';
-        // Pure byte->frame seam: enqueue directly (value-copy queue, thread-safe).
+        // Pure byte->frame seam: append to otFrameRing (SPSC, this task is the producer).
         // LED + 25238 mirror are applied loop-side by the consumer (source=PIC).
         enqueueOTFrame(sRead, bytes_read, false, OTFRAME_SRC_PIC);
       }
@@ -705,6 +736,14 @@ static void reportPendingPICRxErrors() {
 // poll would starve the core and trip the Task Watchdog. While parked it raises
 // the ack flag and sleeps longer; the loop-side flash FSM waits on that ack
 // before driving the UART (waitForPICTaskParked).
+//
+// Leaving the park clears the ack FIRST and only then re-checks the condition:
+// the loop may re-arm the park between the first check and the clear (e.g. a
+// simulation/OTDirect toggle inside one 20 ms park tick) and, still seeing the
+// old ack, start appending to otFrameRing (otFrameLoopProducerReady). The
+// fences order the ack store against the condition load here, and the
+// condition stores against the ack load loop-side, so either the loop sees the
+// cleared ack or this re-check sees the new park — never neither.
 static void picSerialTaskBody(void *arg) {
   (void)arg;
   for (;;) {
@@ -714,6 +753,11 @@ static void picSerialTaskBody(void *arg) {
       continue;
     }
     g_picTaskParked = false;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (picSerialTaskShouldPark()) {    // re-armed while unparking: stay parked
+      g_picTaskParked = true;
+      continue;
+    }
     picSerialDrainOnce();
     platformTaskDelay(2);               // yield ~1 tick; FIFO refills meanwhile
   }
@@ -751,6 +795,22 @@ void startPICSerialTask() {
 #endif
 }
 
+// otFrameLoopProducerReady — see header. The ack alone can be stale: the task
+// may have read shouldPark()==false just before the loop re-armed the park and
+// not yet cleared g_picTaskParked. That task re-checks shouldPark() after
+// clearing the ack (picSerialTaskBody) and backs off, so a true result here
+// means the task is not draining, and every input to shouldPark() is changed
+// loop-side, so it stays parked while the loop appends.
+bool otFrameLoopProducerReady() {
+#if HAS_PIC
+  if (g_picSerialTask == nullptr) return true;   // task never created => no other producer
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return g_picTaskParked && picSerialTaskShouldPark();
+#else
+  return true;
+#endif
+}
+
 // waitForPICTaskParked — loop-side handshake before the flash FSM drives the UART.
 void waitForPICTaskParked() {
 #if HAS_PIC
@@ -824,14 +884,6 @@ static inline const __FlashStringHelper* toFlashStringHelper(PGM_P p)
   return reinterpret_cast<const __FlashStringHelper*>(p);
 }
 
-static void appendProgmemSuffix(char *dst, size_t dstSize, PGM_P suffix)
-{
-  if (dst == nullptr || dstSize == 0 || suffix == nullptr) return;
-  size_t len = strlen(dst);
-  if (len >= (dstSize - 1)) return;
-  strncat_P(dst, suffix, dstSize - len - 1);
-}
-
 //===================[ Reset OTGW ]===============================
 #if HAS_PIC
 void resetOTGW() {
@@ -1395,13 +1447,12 @@ void feedWatchDog() {
 
 //===================[ OpenTherm Data Types & Protocol Helpers ]=========
 float OpenthermData_t::f88() {
-  float value = (int8_t) valueHB;
-  return value + (float)valueLB / 256.0f;
+  return otF88ToFloat(otF88FromBytes(valueHB, valueLB));
 }
 
 void OpenthermData_t::f88(float value) {
   // f8.8 format: signed high byte + unsigned fractional low byte (two's complement)
-  int16_t fixed = (int16_t)(value * 256.0f);
+  int16_t fixed = otF88FromFloat(value);
   valueHB = (uint8_t)((fixed >> 8) & 0xFF);
   valueLB = (uint8_t)(fixed & 0xFF);
 }
@@ -1578,81 +1629,6 @@ const char *byte_to_binary(int x)
 }  //byte_to_binary
 
 
-/*
-  This determines if the value in the OpenTherm message is valid and can be used in the data object, MQTT or REST API.
-  Rules are:
-  - if the message is overriden (R and A messages override B and T messages), then the value is not valid for use.
-  - if the OT message is a READ message, and the received OT msg is being read and acknowledged, then the value is valid.
-  - if the OT message is a WRITE message, and the received OT msg is being written (OT_WRITE_DATA), then the value is valid.
-  - if the OT message is a READ/WRITE message, and receive OT msg is being read and ackownledge, or, is being written, then the value is valid.
-  - if the OT message is a status message (from Heating, HAVC or Solar), then the message is always valid.
-*/
-bool is_value_valid(OpenthermData_t OT, OTlookup_t OTlookup) {
-  if (OT.skipthis) return false;
-  if (isMsgIdReservedInActiveProfile(OT.id)) return false;
-  bool _valid = false;
-  _valid = _valid || (OTlookup.msgcmd==OT_READ && OT.type==OT_READ_ACK);
-  _valid = _valid || (OTlookup.msgcmd==OT_WRITE && (OT.type==OT_WRITE_DATA || OT.type==OT_WRITE_ACK));
-  _valid = _valid || (OTlookup.msgcmd==OT_RW && (OT.type==OT_READ_ACK || OT.type==OT_WRITE_DATA || OT.type==OT_WRITE_ACK));
-  _valid = _valid || (OT.id==OT_Statusflags) || (OT.id==OT_StatusVH) || (OT.id==OT_SolarStorageMaster);;
-  return _valid;
-}
-
-// ADR-097: Master-topic validity check. Mirrors is_value_valid but excludes
-// WRITE-ACK for OT_WRITE / OT_RW messages.
-//
-// ADR-096 refines the canonical interpretation from "thermostat-side intent"
-// to "boiler-side worldview" (= the value that was actually transmitted to
-// the boiler, including any gateway override). Two additional gates implement
-// that shift:
-//   - OTGW_ANSWER_THERMOSTAT (A) frames are gateway-faked answers TO the
-//     thermostat; they never reach the boiler-side. Suppress canonical for A.
-//   - OTGW_THERMOSTAT (T) frames flagged bGatewaySubstituted=true did not
-//     reach the boiler (R replaced them). Suppress canonical for those T's;
-//     the corresponding R frame will populate canonical.
-// B frames (boiler responses) always publish to canonical regardless of
-// answer-substitution: B IS the boiler-side reality even when the gateway
-// fakes a different answer to the thermostat.
-//
-// Source-separated subtopics still use the broader is_value_valid; routing
-// across /thermostat vs /boiler is decided inside publishToSourceTopic() per
-// the ADR-096 worldview rules.
-//
-// See ADR-097 + docs/api/MQTT-message-id-echo-audit.md for the per-MsgID
-// Write-Ack classification rationale (preserved by this ADR).
-bool is_value_valid_for_master_topic(OpenthermData_t OT, OTlookup_t OTlookup) {
-  if (OT.skipthis) return false;
-  if (isMsgIdReservedInActiveProfile(OT.id)) return false;
-  // ADR-096/ADR-103 canonical = boiler-side worldview gates:
-  // ADR-103: only an answer-override A (a genuine B owns canonical) is blocked. A proxy A
-  // (no preceding B — e.g. MaxTSet/57) IS the boiler-side value and reaches canonical.
-  if (OT.rsptype == OTGW_ANSWER_THERMOSTAT && OT.bAnswerOverride) return false;
-  if (OT.rsptype == OTGW_THERMOSTAT && OT.bGatewaySubstituted) return false;
-  bool _valid = false;
-  _valid = _valid || (OTlookup.msgcmd==OT_READ && OT.type==OT_READ_ACK);
-  _valid = _valid || (OTlookup.msgcmd==OT_WRITE && OT.type==OT_WRITE_DATA);
-  _valid = _valid || (OTlookup.msgcmd==OT_RW && (OT.type==OT_READ_ACK || OT.type==OT_WRITE_DATA));
-  _valid = _valid || (OT.id==OT_Statusflags) || (OT.id==OT_StatusVH) || (OT.id==OT_SolarStorageMaster);
-  return _valid;
-}
-
-// ADR-097 (PS=1 amendment, TASK-483 ACs #8-#13): The PS=1 summary stream emits
-// one value per MsgID, chosen by the PIC from its most recent observation.
-// For OT_WRITE / OT_RW MsgIDs whose slave Write-Ack data byte is per-spec
-// undefined (bSlaveEchoesValue=false in OTmap[]), the PIC may have captured
-// either the meaningful Write-Data or the undefined Write-Ack byte; the PS=1
-// stream cannot distinguish these at this layer. For those MsgIDs we suppress
-// base-topic publication and state-write so the master-topic invariant holds
-// across both the live OT-bus path and the PS=1 path. READ messages are
-// always meaningful (slave's Read-Ack carries the value). Status-flag MsgIDs
-// (Statusflags / StatusVH) are handled inside ot_flag8flag8 with their own
-// per-MsgID switch and are not gated here.
-static bool is_msgid_valid_for_master_topic_in_ps_summary(const OTlookup_t &lookup)
-{
-  if (lookup.msgcmd == OT_READ) return true;
-  return lookup.bSlaveEchoesValue;
-}
-
 // =====================[ MQTT throttle helpers ]==================
 #define CoreMQTTDebugTf(...) ({ if (state.debug.bMQTTGate) DebugTf(__VA_ARGS__); })
 
@@ -1788,6 +1764,7 @@ void confirmMQTTPublishByteSlot()
 void requestMQTTRepublishAll()
 {
   resetMqttTrackedState();
+  clearMQTTPublishDedup();
   requestMQTTStatusRepublish();
 }
 
@@ -1804,7 +1781,8 @@ void requestMQTTStatusRepublish()
 // so the caller controls which value is compared — normal OT mode passes
 // OTdata.value; PS=1 mode passes 0 to rely on interval-only gating. (ADR-006)
 bool shouldPublishMQTTForID(byte id, byte masterslave, uint16_t rawValue) {
-  if (id == OT_Statusflags || id == OT_StatusVH) {
+  const uint8_t gateFlags = OTDispatch.e[id].flags;
+  if (gateFlags & OTD_FLAG_STATUS_GATE) {
     CoreMQTTDebugTf(PSTR("MQTT gate id=%u src=%c curr=0x%04X => publish [delegated to status-byte/bit gates]\r\n"),
                     id,
                     mqttPublishSourceTag(masterslave),
@@ -1814,7 +1792,7 @@ bool shouldPublishMQTTForID(byte id, byte masterslave, uint16_t rawValue) {
   // IDs 128-255 (manufacturer-specific/Remeha) wrap when offset +128, aliasing
   // with critical RESPONSE slots (Status flags, TSet…). Always publish to avoid
   // cross-slot throttle contamination. (ADR-006)
-  if (id > 127) {
+  if (gateFlags & OTD_FLAG_UNTRACKED) {
     CoreMQTTDebugTf(PSTR("MQTT gate id=%u src=%c prev=%s curr=0x%04X => publish [passthrough id>127]\r\n"),
                     id,
                     mqttPublishSourceTag(masterslave),
@@ -2463,911 +2441,6 @@ void publishActiveOverrides() {
   }
 }
 
-//===================[ OT Message Field Formatters ]=========
-
-void print_f88(float& value)
-{
-  //function to print data
-  float _value = roundf(OTdata.f88()*100.0f) / 100.0f; // round float 2 digits, like this: x.xx
-  // AddLog("%s = %3.2f %s", OTlookupitem.label, _value , OTlookupitem.unit);
-  char _msg[15] {0};
-  dtostrf(_value, 3, 2, _msg);
-
-  // ADR-097: gate log decode + state write on master-topic validity. The protocol
-  // event stays visible (timestamp/source/msgid/type/indicator are added in processOT);
-  // only the per-spec-undefined Write-Ack data byte is suppressed from log + REST state.
-  const bool validForMaster = is_value_valid_for_master_topic(OTdata, OTlookupitem);
-  if (validForMaster) {
-    AddLogf("%s = %s %s", OTlookupitem.label, _msg, OTlookupitem.unit);
-  } else {
-    AddLogf("%s", OTlookupitem.label);
-  }
-
-  // ADR-118: capture gateway-injected override (additive; does NOT affect canonical).
-  // Gated on the explicit suppression flags only, NOT !validForMaster (which is also
-  // false for non-override reasons). Pure RAM write — no MQTT publish, no yield.
-  if ((OTdata.rsptype == OTGW_ANSWER_THERMOSTAT) && OTdata.bAnswerOverride) {
-    recordOTOverride(OTdata.id, OT_OVERRIDE_ANSWER, _value);
-  } else if ((OTdata.rsptype == OTGW_THERMOSTAT) && OTdata.bGatewaySubstituted) {
-    recordOTOverride(OTdata.id, OT_OVERRIDE_SUBSTITUTED, _value);
-  }
-
-  //SendMQTT
-  if (is_value_valid(OTdata, OTlookupitem)){
-    const char* topic = messageIDToString(static_cast<OTLibMessageID>(OTdata.id));
-    if (validForMaster) sendMQTTData(topic, _msg);
-    publishToSourceTopic(topic, _msg, OTdata.rsptype);
-    if (validForMaster) value = _value;
-  }
-}
-
-
-void print_s16(int16_t& value)
-{
-  int16_t _value = OTdata.s16();
-  // AddLogf("%s = %5d %s", OTlookupitem.label, _value, OTlookupitem.unit);
-  //Build string for MQTT
-  char _msg[15] {0};
-  itoa(_value, _msg, 10);
-
-  // ADR-097: gate log decode + state write on master-topic validity (see print_f88).
-  const bool validForMaster = is_value_valid_for_master_topic(OTdata, OTlookupitem);
-  if (validForMaster) {
-    AddLogf("%s = %s %s", OTlookupitem.label, _msg, OTlookupitem.unit);
-  } else {
-    AddLogf("%s", OTlookupitem.label);
-  }
-
-  //SendMQTT
-  if (is_value_valid(OTdata, OTlookupitem)){
-    const char* topic = messageIDToString(static_cast<OTLibMessageID>(OTdata.id));
-    if (validForMaster) sendMQTTData(topic, _msg);
-    publishToSourceTopic(topic, _msg, OTdata.rsptype);
-    if (validForMaster) value = _value;
-  }
-}
-
-void print_s8s8(uint16_t& value)
-{
-  // ADR-097: gate log decode + state write on master-topic validity (see print_f88).
-  const bool validForMaster = is_value_valid_for_master_topic(OTdata, OTlookupitem);
-  if (validForMaster) {
-    AddLogf("%s = %3d / %3d %s", OTlookupitem.label, (int8_t)OTdata.valueHB, (int8_t)OTdata.valueLB, OTlookupitem.unit);
-  } else {
-    AddLogf("%s", OTlookupitem.label);
-  }
-
-  //Build string for MQTT
-  char _msg[15] {0};
-  otTopic[0] = '\0';
-  itoa((int8_t)OTdata.valueHB, _msg, 10);
-  strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-  strlcat(otTopic, "_value_hb", sizeof(otTopic));
-  //AddLogf("%s = %s %s", OTlookupitem.label, _msg, OTlookupitem.unit);
-  const bool _valid = is_value_valid(OTdata, OTlookupitem);
-  if (_valid){
-    if (validForMaster) sendMQTTData(otTopic, _msg);
-    publishToSourceTopic(otTopic, _msg, OTdata.rsptype);
-  }
-  //Build string for MQTT
-  itoa((int8_t)OTdata.valueLB, _msg, 10);
-  strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-  strlcat(otTopic, "_value_lb", sizeof(otTopic));
-  //AddLogf("%s = %s %s", OTlookupitem.label, _msg, OTlookupitem.unit);
-  if (_valid){
-    if (validForMaster) sendMQTTData(otTopic, _msg);
-    publishToSourceTopic(otTopic, _msg, OTdata.rsptype);
-    if (validForMaster) value = OTdata.u16();
-  }
-}
-
-void print_u16(uint16_t& value)
-{
-  uint16_t _value = OTdata.u16();
-  //Build string for MQTT
-  char _msg[15] {0};
-  utoa(_value, _msg, 10);
-
-  // ADR-097: gate log decode + state write on master-topic validity (see print_f88).
-  const bool validForMaster = is_value_valid_for_master_topic(OTdata, OTlookupitem);
-  if (validForMaster) {
-    AddLogf("%s = %s %s", OTlookupitem.label, _msg, OTlookupitem.unit);
-  } else {
-    AddLogf("%s", OTlookupitem.label);
-  }
-
-  //SendMQTT
-  if (is_value_valid(OTdata, OTlookupitem)){
-    const char* topic = messageIDToString(static_cast<OTLibMessageID>(OTdata.id));
-    if (validForMaster) sendMQTTData(topic, _msg);
-    publishToSourceTopic(topic, _msg, OTdata.rsptype);
-    if (validForMaster) value = _value;
-  }
-}
-
-void print_status(uint16_t& value)
-{
-  char _flag8_master[9] {0};
-  char _flag8_slave[9] {0};
-  
-  if (OTdata.masterslave == 0) {
-    // Parse master bits
-    //bit: [clear/0, set/1]
-    //  0: CH enable [ CH is disabled, CH is enabled]
-    //  1: DHW enable [ DHW is disabled, DHW is enabled]
-    //  2: Cooling enable [ Cooling is disabled, Cooling is enabled]]
-    //  3: OTC active [OTC not active, OTC is active]
-    //  4: CH2 enable [CH2 is disabled, CH2 is enabled]
-    //  5: Summer/winter mode [Summertime, Wintertime]
-    //  6: DHW blocking [ DHW not blocking, DHW blocking ]
-    //  7: reserved
-    _flag8_master[0] = (((OTdata.valueHB) & 0x01) ? 'C' : '-');
-    _flag8_master[1] = (((OTdata.valueHB) & 0x02) ? 'D' : '-');
-    _flag8_master[2] = (((OTdata.valueHB) & 0x04) ? 'C' : '-'); 
-    _flag8_master[3] = (((OTdata.valueHB) & 0x08) ? 'O' : '-');
-    _flag8_master[4] = (((OTdata.valueHB) & 0x10) ? '2' : '-'); 
-    _flag8_master[5] = (((OTdata.valueHB) & 0x20) ? 'S' : 'W'); 
-    _flag8_master[6] = (((OTdata.valueHB) & 0x40) ? 'B' : '-'); 
-    _flag8_master[7] = (((OTdata.valueHB) & 0x80) ? '.' : '-');
-    _flag8_master[8] = '\0';
-
-    AddLog(" ");
-    AddLog(OTlookupitem.label);
-    AddLogf(" = Master [%s]", _flag8_master);
-
-    //Master Status — ADR-069 boiler-side worldview: suppress canonical for
-    //gateway-substituted T-frames so the HW override is reflected in dhw_enable.
-    if (is_value_valid_for_master_topic(OTdata, OTlookupitem)){
-      publishMasterStatusState(OTdata.valueHB, _flag8_master);
-    }
-  } else {
-    // Parse slave bits
-    //  0: fault indication [ no fault, fault ]
-    //  1: CH mode [CH not active, CH active]
-    //  2: DHW mode [ DHW not active, DHW active]
-    //  3: Flame status [ flame off, flame on ]
-    //  4: Cooling status [ cooling mode not active, cooling mode active ]
-    //  5: CH2 mode [CH2 not active, CH2 active]
-    //  6: diagnostic indication [no diagnostics, diagnostic event]
-    //  7: Electricity production [no electric production, electric production]
-    _flag8_slave[0] = (((OTdata.valueLB) & 0x01) ? 'E' : '-');
-    _flag8_slave[1] = (((OTdata.valueLB) & 0x02) ? 'C' : '-'); 
-    _flag8_slave[2] = (((OTdata.valueLB) & 0x04) ? 'W' : '-'); 
-    _flag8_slave[3] = (((OTdata.valueLB) & 0x08) ? 'F' : '-'); 
-    _flag8_slave[4] = (((OTdata.valueLB) & 0x10) ? 'C' : '-'); 
-    _flag8_slave[5] = (((OTdata.valueLB) & 0x20) ? '2' : '-'); 
-    _flag8_slave[6] = (((OTdata.valueLB) & 0x40) ? 'D' : '-'); 
-    _flag8_slave[7] = (((OTdata.valueLB) & 0x80) ? 'P' : '-');
-    _flag8_slave[8] = '\0';
-
-    AddLog(" ");
-    AddLog(OTlookupitem.label);
-    AddLogf(" = Slave  [%s]", _flag8_slave);
-    
-    //Slave Status — ADR-069 boiler-side worldview: suppress canonical for
-    //gateway-faked A-frames so the boiler's true DHW mode is what we publish.
-    if (is_value_valid_for_master_topic(OTdata, OTlookupitem)){
-      publishSlaveStatusState(OTdata.valueLB, _flag8_slave);
-    }
-  }
-
-  if (is_value_valid_for_master_topic(OTdata, OTlookupitem)){
-    // AddLogf("Status u16 [%04x] _value [%04x] hb [%02x] lb [%02x]", OTdata.u16(), _value, OTdata.valueHB, OTdata.valueLB);
-    value = (OTcurrentSystemState.MasterStatus<<8) | OTcurrentSystemState.SlaveStatus;
-  }
-}
-
-void print_solar_storage_status(uint16_t& value)
-{ 
-  char _msg[15] {0};
-
-  if (OTdata.masterslave == 0) {
-    // Master Solar Storage 
-    // ID101:HB012: Master Solar Storage: Solar mode
-    uint8_t MasterSolarMode = (OTdata.valueHB) & 0x7;
-    AddLogf("%s = Solar Storage Master Mode [%d] ", OTlookupitem.label, MasterSolarMode);
-    if (is_value_valid(OTdata, OTlookupitem)){
-      sendMQTTData(F("solar_storage_master_mode"), itoa(MasterSolarMode, _msg, 10));  //delayms(5);
-      OTcurrentSystemState.SolarMasterStatus = OTdata.valueHB;
-    }
-  } else { 
-    //Slave
-    // ID101:LB0: Slave Solar Storage: Fault indication
-    uint8_t SlaveSolarFaultIndicator =  (OTdata.valueLB) & 0x01;
-    // ID101:LB123: Slave Solar Storage: Solar mode status
-    uint8_t SlaveSolarModeStatus = (OTdata.valueLB>>1) & 0x07;
-    // ID101:LB45: Slave Solar Storage: Solar status
-    uint8_t SlaveSolarStatus = (OTdata.valueLB>>4)& 0x03;
-    AddLogf("\r\n%s = Slave Solar Fault Indicator [%d] ", OTlookupitem.label, SlaveSolarFaultIndicator);
-    AddLogf("\r\n%s = Slave Solar Mode Status [%d] ", OTlookupitem.label, SlaveSolarModeStatus);
-    AddLogf("\r\n%s = Slave Solar Status [%d] ", OTlookupitem.label, SlaveSolarStatus);
-    if (is_value_valid(OTdata, OTlookupitem)){
-      // ADR-106: pick legacy vs new label.
-      sendMQTTData(settings.mqtt.bUseLegacyOtTopics ? F("solar_storage_slave_fault_indicator")
-                                                    : F("solar_storage_fault"),
-                   ((SlaveSolarFaultIndicator) ? "ON" : "OFF"));
-      sendMQTTData(F("solar_storage_mode_status"), itoa(SlaveSolarModeStatus, _msg, 10));  
-      sendMQTTData(F("solar_storage_slave_status"), itoa(SlaveSolarStatus, _msg, 10));  
-      OTcurrentSystemState.SolarSlaveStatus = OTdata.valueLB;
-    }
-  }
-  if (is_value_valid(OTdata, OTlookupitem)){
-    //OTDebugTf(PSTR("Solar Storage Master / Slave Mode u16 [%04x] _value [%04x] hb [%02x] lb [%02x]"), OTdata.u16(), _value, OTdata.valueHB, OTdata.valueLB);
-    value = (OTcurrentSystemState.SolarMasterStatus<<8) | OTcurrentSystemState.SolarSlaveStatus;
-  }
-}
-
-void print_statusVH(uint16_t& value)
-{ 
-  char _flag8_master[9] {0};
-  char _flag8_slave[9] {0};
-
-  if (OTdata.masterslave == 0){
-      
-    // Parse master bits
-    //bit: [clear/0, set/1]
-    // ID70:HB0: Master status ventilation / heat-recovery: Ventilation enable
-    // ID70:HB1: Master status ventilation / heat-recovery: Bypass postion
-    // ID70:HB2: Master status ventilation / heat-recovery: Bypass mode
-    // ID70:HB3: Master status ventilation / heat-recovery: Free ventilation mode
-    //  4: reserved
-    //  5: reserved
-    //  6: reserved
-    //  7: reserved
-    _flag8_master[0] = (((OTdata.valueHB) & 0x01) ? 'V' : '-');
-    _flag8_master[1] = (((OTdata.valueHB) & 0x02) ? 'P' : '-');
-    _flag8_master[2] = (((OTdata.valueHB) & 0x04) ? 'M' : '-'); 
-    _flag8_master[3] = (((OTdata.valueHB) & 0x08) ? 'F' : '-');
-    _flag8_master[4] = (((OTdata.valueHB) & 0x10) ? '.' : '-'); 
-    _flag8_master[5] = (((OTdata.valueHB) & 0x20) ? '.' : '-'); 
-    _flag8_master[6] = (((OTdata.valueHB) & 0x40) ? '.' : '-'); 
-    _flag8_master[7] = (((OTdata.valueHB) & 0x80) ? '.' : '-');
-    _flag8_master[8] = '\0';
-
-    
-    AddLogf("%s = VH Master [%s]", OTlookupitem.label, _flag8_master);
-    //Master Status
-    if (is_value_valid(OTdata, OTlookupitem)){
-      publishMasterStatusVHState(OTdata.valueHB, _flag8_master);
-    }
-  } else {
-    // Parse slave bits
-    // ID70:LB0: Slave status ventilation / heat-recovery: Fault indication
-    // ID70:LB1: Slave status ventilation / heat-recovery: Ventilation mode
-    // ID70:LB2: Slave status ventilation / heat-recovery: Bypass status
-    // ID70:LB3: Slave status ventilation / heat-recovery: Bypass automatic status
-    // ID70:LB4: Slave status ventilation / heat-recovery: Free ventilation status
-    // ID70:LB6: Slave status ventilation / heat-recovery: Diagnostic indication
-    _flag8_slave[0] = (((OTdata.valueLB) & 0x01) ? 'F' : '-');
-    _flag8_slave[1] = (((OTdata.valueLB) & 0x02) ? 'V' : '-'); 
-    _flag8_slave[2] = (((OTdata.valueLB) & 0x04) ? 'P' : '-'); 
-    _flag8_slave[3] = (((OTdata.valueLB) & 0x08) ? 'A' : '-'); 
-    _flag8_slave[4] = (((OTdata.valueLB) & 0x10) ? 'F' : '-'); 
-    _flag8_slave[5] = (((OTdata.valueLB) & 0x20) ? '.' : '-');
-    _flag8_slave[6] = (((OTdata.valueLB) & 0x40) ? 'D' : '-'); 
-    _flag8_slave[7] = (((OTdata.valueLB) & 0x80) ? '.' : '-');
-    _flag8_slave[8] = '\0';
-
-    
-    AddLogf("%s = VH Slave  [%s]", OTlookupitem.label, _flag8_slave);
-
-    //Slave Status
-    if (is_value_valid(OTdata, OTlookupitem)){
-      publishSlaveStatusVHState(OTdata.valueLB, _flag8_slave);
-    }
-  }
-
-  if (is_value_valid(OTdata, OTlookupitem)){
-    //OTDebugTf(PSTR("Status u16 [%04x] _value [%04x] hb [%02x] lb [%02x]"), OTdata.u16(), _value, OTdata.valueHB, OTdata.valueLB);
-    value = (OTcurrentSystemState.MasterStatusVH<<8) | OTcurrentSystemState.SlaveStatusVH;
-  }
-}
-
-
-void print_ASFflags(uint16_t& value)
-{
-  AddLogf("%s = ASF flags[%s] OEM faultcode [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
-
-  if (is_value_valid(OTdata, OTlookupitem)){
-    // TASK-401: gate ASF_flags byte-topic + 6 bit-topics on first-seen + change + 60s heartbeat.
-    // Previous byte value lives in `value` (uint16_t& ref to OTcurrentSystemState.ASFflags).
-    const uint8_t prevHB = (uint8_t)((value >> 8) & 0xFF);
-    const uint8_t newHB  = OTdata.valueHB;
-    //Application Specific Fault (byte, gated)
-    publishGatedByteMQTT(mqttlastsentASFbyte, 0, F("ASF_flags"), byte_to_binary(newHB), newHB, prevHB);
-    //OEM fault code — numeric value, not a bit; left raw (low publish cost vs HA wants fresh code)
-    char _msg[15] {0};
-    utoa(OTdata.valueLB, _msg, 10);
-    sendMQTTData(F("OEMFaultCode"), _msg);
-
-    //bit: [clear/0, set/1]
-    //0: Service request [service not req’d, service required]
-    //1: Lockout-reset [ remote reset disabled, rr enabled]
-    //2: Low water press [ no WP fault, water pressure fault]
-    //3: Gas/flame fault [ no G/F fault, gas/flame fault ]
-    //4: Air press fault [ no AP fault, air pressure fault ]
-    //5: Water over-temp[ no OvT fault, over-temperat. Fault]
-    //6: reserved
-    //7: reserved
-    publishGatedBitMQTT(mqttlastsentASFbit, 0, F("service_request"),        (newHB & 0x01), (prevHB & 0x01), F("service_required"));
-    publishGatedBitMQTT(mqttlastsentASFbit, 1, F("lockout_reset"),          (newHB & 0x02), (prevHB & 0x02), F("supports_lockout_reset"));
-    publishGatedBitMQTT(mqttlastsentASFbit, 2, F("low_water_pressure"),     (newHB & 0x04), (prevHB & 0x04));
-    publishGatedBitMQTT(mqttlastsentASFbit, 3, F("gas_flame_fault"),        (newHB & 0x08), (prevHB & 0x08), F("gas_fault"));
-    publishGatedBitMQTT(mqttlastsentASFbit, 4, F("air_pressure_fault"),     (newHB & 0x10), (prevHB & 0x10));
-    publishGatedBitMQTT(mqttlastsentASFbit, 5, F("water_over_temperature"), (newHB & 0x20), (prevHB & 0x20), F("water_overtemperature"));
-    value = OTdata.u16();
-  }
-}
-
-void print_RBPflags(uint16_t& value)
-{
-  AddLogf("%s = M[%s] OEM fault code [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
-  if (is_value_valid(OTdata, OTlookupitem)){
-    // TASK-401: extract previous HB/LB so publishRBPFlagsState can gate per-bit vs last frame.
-    const uint8_t prevTransfer  = (uint8_t)((value >> 8) & 0xFF);
-    const uint8_t prevReadWrite = (uint8_t)(value & 0xFF);
-    value = publishRBPFlagsState(OTdata.valueHB, OTdata.valueLB, prevTransfer, prevReadWrite);
-  }
-}
-
-void print_slavememberid(uint16_t& value)
-{
-  AddLogf("%s = Slave Config[%s] MemberID code [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
-  if (is_value_valid(OTdata, OTlookupitem)){
-    //Build string for SendMQTT
-    sendMQTTData(F("slave_configuration"), byte_to_binary(OTdata.valueHB));
-    char _msg[15] {0};
-    utoa(OTdata.valueLB, _msg, 10);
-    sendMQTTData(F("slave_memberid_code"), _msg);
-
-    
-    // bit: description  [ clear/0, set/1] 
-    // 0:  DHW present  [ dhw not present, dhw is present ] 
-    // 1:  Control type  [ modulating, on/off ] 
-    // 2:  Cooling config  [ cooling not supported,  
-    //     cooling supported] 
-    // 3:  DHW config  [instantaneous or not-specified, 
-    //     storage tank] 
-    // 4:  Master low-off&pump control function [allowed, 
-    //     not allowed] 
-    // 5:  CH2 present  [CH2 not present, CH2 present]
-    // 6:  Remote water filling function
-    //     NOTE: pyotgw / HA core's opentherm_gw integration names this bit
-    //     DATA_SLAVE_REMOTE_RESET. The OpenTherm 2.2 spec and this firmware's
-    //     label call it "remote_water_filling_function". Both refer to the
-    //     same wire bit (MsgID 3, HB bit 6); HA-side discovery parity is
-    //     audited in docs/audits/2026-05-21-ha-capability-flags-feature-2.0.0.md (TASK-650).
-    // 7:  Heat/cool mode control
-
-    // ADR-106: pick legacy vs new label per bit. Heat_cool_mode_control (HB7) has no alias and always publishes its legacy name.
-    {
-      const bool useLegacy = settings.mqtt.bUseLegacyOtTopics;
-      sendMQTTData(useLegacy ? F("dhw_present")                          : F("supports_hot_water"),     (((OTdata.valueHB) & 0x01) ? "ON" : "OFF"));
-      sendMQTTData(useLegacy ? F("control_type_modulation")              : F("control_type"),           (((OTdata.valueHB) & 0x02) ? "ON" : "OFF"));
-      sendMQTTData(useLegacy ? F("cooling_config")                       : F("supports_cooling"),       (((OTdata.valueHB) & 0x04) ? "ON" : "OFF"));
-      sendMQTTData(useLegacy ? F("dhw_config")                           : F("hot_water_config"),       (((OTdata.valueHB) & 0x08) ? "ON" : "OFF"));
-      sendMQTTData(useLegacy ? F("master_low_off_pump_control_function") : F("supports_pump_control"),  (((OTdata.valueHB) & 0x10) ? "ON" : "OFF"));
-      sendMQTTData(useLegacy ? F("ch2_present")                          : F("supports_ch_2"),          (((OTdata.valueHB) & 0x20) ? "ON" : "OFF"));
-      sendMQTTData(useLegacy ? F("remote_water_filling_function")        : F("supports_remote_reset"),  (((OTdata.valueHB) & 0x40) ? "ON" : "OFF"));
-      sendMQTTData(F("heat_cool_mode_control"),                                                          (((OTdata.valueHB) & 0x80) ? "ON" : "OFF"));
-    }
-    // SAT heating-source detect (TASK-943): MsgID 3 HB bit2 = "cooling supported".
-    // NON-CONTROL telemetry hint only — surfaced as heating_source_detected for the UI.
-    // Control authority is the manual satsource setting; satGetEffectiveHeatingSource()
-    // resolves AUTO to a safe gas-boiler default. OpenTherm has no source-class field
-    // (spec v4.2:1606), so cooling-capable is a lossy proxy (heating-only heat pumps do
-    // not set it; hybrid is invisible on one OT bus) — never drive control off this bit.
-    state.sat.iDetectedHeatingSource = ((OTdata.valueHB) & 0x04) ? SAT_SRC_HEAT_PUMP : SAT_SRC_GAS_BOILER;
-    // SAT: auto-detect manufacturer from slave MemberID code
-    satDetectManufacturer(OTdata.valueLB);
-    value = OTdata.u16();
-  }
-}
-
-void print_mastermemberid(uint16_t& value)
-{
-  AddLogf("%s = Master Config[%s] MemberID code [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
-  if (is_value_valid(OTdata, OTlookupitem)){
-    //Build string for MQTT
-    char _msg[15] {0};
-    sendMQTTData(F("master_configuration"), byte_to_binary(OTdata.valueHB));
-    // ADR-106: pick legacy vs new label.
-    sendMQTTData(settings.mqtt.bUseLegacyOtTopics ? F("master_configuration_smart_power")
-                                                  : F("supports_master_smart_power"),
-                 (((OTdata.valueHB) & 0x01) ? "ON" : "OFF"));  
-    
-    utoa(OTdata.valueLB, _msg, 10);
-    sendMQTTData(F("master_memberid_code"), _msg);
-    value = OTdata.u16();
-  }
-}
-
-void print_vh_configmemberid(uint16_t& value)
-{
-  AddLogf("%s = VH Config[%s] MemberID code [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
-  if (is_value_valid(OTdata, OTlookupitem)){
-    //Build string for MQTT
-    char _msg[15] {0};
-    sendMQTTData(F("vh_configuration"), byte_to_binary(OTdata.valueHB)); 
-    // ADR-106: pick legacy vs new label per bit.
-    {
-      const bool useLegacy = settings.mqtt.bUseLegacyOtTopics;
-      sendMQTTData(useLegacy ? F("vh_configuration_system_type")   : F("ventilation_system_type"),         (((OTdata.valueHB) & 0x01) ? "ON" : "OFF"));
-      sendMQTTData(useLegacy ? F("vh_configuration_bypass")        : F("supports_ventilation_bypass"),     (((OTdata.valueHB) & 0x02) ? "ON" : "OFF"));
-      sendMQTTData(useLegacy ? F("vh_configuration_speed_control") : F("ventilation_speed_control_type"),  (((OTdata.valueHB) & 0x04) ? "ON" : "OFF"));
-    }
-    // NOTE (TASK-943): heating-source detection was previously (and wrongly) keyed off
-    // this MsgID 74 ventilation bit0. It now lives in the MsgID 3 slave-config handler
-    // (cooling bit2) as a non-control hint. This handler decodes ventilation config only.
-    utoa(OTdata.valueLB, _msg, 10);
-    sendMQTTData(F("vh_memberid_code"), _msg);
-    value = OTdata.u16();
-  }
-}
-
-void print_solarstorage_slavememberid(uint16_t& value)
-{
-  AddLogf("%s = Solar Storage Slave Config[%s] MemberID code [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
-  if (is_value_valid(OTdata, OTlookupitem)){
-     //Build string for SendMQTT
-    sendMQTTData(F("solar_storage_slave_configuration"), byte_to_binary(OTdata.valueHB));
-    char _msg[15] {0};
-    utoa(OTdata.valueLB, _msg, 10);
-    sendMQTTData(F("solar_storage_slave_memberid_code"), _msg);
-
-    //ID103:HB0: Slave Configuration Solar Storage: System type1
-    sendMQTTData(F("solar_storage_system_type"),    (((OTdata.valueHB) & 0x01) ? "ON" : "OFF"));  
-    value = OTdata.u16();
-  }
-}
-
-void print_remoteoverridefunction(uint16_t& value)
-{
-// MsdID 100 Remote override room setpoint 
-// LB: Remote override function 
-// bit: description  [ clear/0, set/1] 
-// 0:  Manual change priority [disable overruling remote 
-//     setpoint by manual setpoint change, enable overruling 
-//     remote setpoint by manual setpoint change ] 
-// 1:  Program change priority [disable overruling remote 
-//     setpoint by program setpoint change, enable overruling 
-//     remote setpoint by program setpoint change ] 
-// 2:  reserved  
-// 3:  reserved 
-// 4:  reserved 
-// 5:  reserved 
-// 6:  reserved 
-// 7:  reserved 
-// HB: reserved 
-  
-  AddLogf("%s = flag8 = [%s] - decimal = [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueLB), OTdata.valueLB);
-
-  if (is_value_valid(OTdata, OTlookupitem)){
-    // TASK-401: gate <msgid>_flag8 byte + 2 bit-topics. Remote Override msgId 100
-    // stores full u16 in `value`; LB holds the flag byte (HB is reserved).
-    const uint8_t prevLB = (uint8_t)(value & 0xFF);
-    const uint8_t newLB  = OTdata.valueLB;
-    //Build string for MQTT
-    otTopic[0] = '\0';
-    //flag8 value
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_flag8", sizeof(otTopic));
-    publishGatedByteMQTT(mqttlastsentRObyte, 0, otTopic, byte_to_binary(newLB), newLB, prevLB);
-    //report remote override flags to MQTT
-    publishGatedBitMQTT(mqttlastsentRObit, 0, F("remote_override_manual_change_priority"),
-                        (newLB & 0x01), (prevLB & 0x01),
-                        F("override_manual_change_prio"));
-    publishGatedBitMQTT(mqttlastsentRObit, 1, F("remote_override_program_change_priority"),
-                        (newLB & 0x02), (prevLB & 0x02),
-                        F("override_program_change_prio"));
-    value = OTdata.u16();
-  }
-}
-
-void print_flag8u8(uint16_t& value)
-{
-  AddLogf("%s = M[%s] - [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueLB);
-
-  if (is_value_valid(OTdata, OTlookupitem)){
-    //Build string for MQTT
-    otTopic[0] = '\0';
-    //flag8 value
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_flag8", sizeof(otTopic));
-    sendMQTTData(otTopic, byte_to_binary(OTdata.valueHB));
-    //u8 value
-    char _msg[15] {0};
-    utoa(OTdata.valueLB, _msg, 10);
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_code", sizeof(otTopic));
-    sendMQTTData(otTopic, _msg);
-    value = OTdata.u16(); 
-  }
-}
-
-void print_vh_remoteparametersetting(uint16_t& value)
-{ 
-  //Build string for MQTT
-  otTopic[0] = '\0';
-  //flag8 valueHB
-  
-  AddLogf("%s = HB flag8[%s] -[%3d] ", OTlookupitem.label, byte_to_binary(OTdata.valueHB), OTdata.valueHB);
-  if (is_value_valid(OTdata, OTlookupitem)){
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_hb_flag8", sizeof(otTopic));
-    sendMQTTData(otTopic, byte_to_binary(OTdata.valueHB));
-    sendMQTTData(F("vh_transfer_enable_nominal_ventilation_value"),    (((OTdata.valueHB) & 0x01) ? "ON" : "OFF"));
-  }
-  //flag8 valueLB
-  AddLogf("%s = LB flag8[%s] - [%3d]", OTlookupitem.label, byte_to_binary(OTdata.valueLB), OTdata.valueLB);
-  if (is_value_valid(OTdata, OTlookupitem)){
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_lb_flag8", sizeof(otTopic));
-    sendMQTTData(otTopic, byte_to_binary(OTdata.valueLB));
-    sendMQTTData(F("vh_rw_nominal_ventilation_value"),    (((OTdata.valueLB) & 0x01) ? "ON" : "OFF"));
-    value = OTdata.u16();
-  }
-}
-
-void print_command(uint16_t& value)
-{ 
-  //Known Commands
-  // ID4 (HB=1): Remote Request Boiler Lockout-reset
-  // ID4 (HB=2): Remote Request Water filling
-  // ID4 (HB=10): Remote Request Service request reset
-  
-  AddLogf("%s = %3d / %3d %s", OTlookupitem.label, (uint8_t)OTdata.valueHB, (uint8_t)OTdata.valueLB, OTlookupitem.unit);
-  if (is_value_valid(OTdata, OTlookupitem)){
-    //Build string for MQTT
-    otTopic[0] = '\0';
-    char _msg[10] {0};
-    //flag8 valueHB
-    utoa((OTdata.valueHB), _msg, 10);
-    //AddLogf("%s = HB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueHB);
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_hb_u8", sizeof(otTopic));
-    sendMQTTData(otTopic, _msg);
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_remote_command", sizeof(otTopic));
-    switch (OTdata.valueHB) {
-      case 1: sendMQTTData(otTopic, "Remote Request Boiler Lockout-reset");  AddLogf("\r\n%s = remote command [%s]", OTlookupitem.label, "Remote Request Boiler Lockout-reset"); break;
-      case 2: sendMQTTData(otTopic, "Remote Request Water filling"); AddLogf("\r\n%s = remote command [%s]", OTlookupitem.label, "Remote Request Water filling"); break;
-      case 10: sendMQTTData(otTopic, "Remote Request Service request reset");  AddLogf("\r\n%s = remote command [%s]", OTlookupitem.label, "Remote Request Service request reset");break;
-      default: sendMQTTData(otTopic, "Unknown command"); AddLogf("\r\n%s = remote command [%s]", OTlookupitem.label, "Unknown command");break;
-    } 
-
-    //flag8 valueLB
-    utoa((OTdata.valueLB), _msg, 10);
-    //AddLogf("%s = LB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueLB);
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_lb_u8", sizeof(otTopic));
-    sendMQTTData(otTopic, _msg);
-    value = OTdata.u16();
-  }
-}
-
-void print_u8u8(uint16_t& value)
-{ 
-  
-  AddLogf("%s = %3d / %3d %s", OTlookupitem.label, (uint8_t)OTdata.valueHB, (uint8_t)OTdata.valueLB, OTlookupitem.unit);
-
-  if (is_value_valid(OTdata, OTlookupitem)){
-    //Build string for MQTT
-    otTopic[0] = '\0';
-    char _msg[10] {0};
-    //flag8 valueHB
-    utoa((OTdata.valueHB), _msg, 10);
-    //AddLogf("%s = HB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueHB);
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_hb_u8", sizeof(otTopic));
-    sendMQTTData(otTopic, _msg);
-    //flag8 valueLB
-    utoa((OTdata.valueLB), _msg, 10);
-    //AddLogf("%s = LB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueLB);
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_lb_u8", sizeof(otTopic));
-    sendMQTTData(otTopic, _msg);
-    value = OTdata.u16();
-  }
-}
-
-static void publish_u8_alias_topics(const char* baseTopic)
-{
-  char _msg[10] {0};
-
-  utoa(OTdata.valueHB, _msg, 10);
-  strlcpy(otTopic, baseTopic, sizeof(otTopic));
-  appendProgmemSuffix(otTopic, sizeof(otTopic), PSTR("_hb_u8"));
-  if (is_value_valid_for_master_topic(OTdata, OTlookupitem)) sendMQTTData(otTopic, _msg);
-  publishToSourceTopic(otTopic, _msg, OTdata.rsptype);
-
-  utoa(OTdata.valueLB, _msg, 10);
-  strlcpy(otTopic, baseTopic, sizeof(otTopic));
-  appendProgmemSuffix(otTopic, sizeof(otTopic), PSTR("_lb_u8"));
-  if (is_value_valid_for_master_topic(OTdata, OTlookupitem)) sendMQTTData(otTopic, _msg);
-  publishToSourceTopic(otTopic, _msg, OTdata.rsptype);
-}
-
-static void print_u8_single(uint16_t& value, bool useHB)
-{
-  const uint8_t activeByte = useHB ? OTdata.valueHB : OTdata.valueLB;
-  const uint8_t reservedByte = useHB ? OTdata.valueLB : OTdata.valueHB;
-  const char activeByteName0 = useHB ? 'H' : 'L';
-  const char activeByteName1 = 'B';
-  const char reservedByteName0 = useHB ? 'L' : 'H';
-  const char reservedByteName1 = 'B';
-
-  AddLogf_P(PSTR("%s = %3u %s (%c%c used, %c%c=%u)"),
-            OTlookupitem.label,
-            activeByte,
-            OTlookupitem.unit,
-            activeByteName0, activeByteName1,
-            reservedByteName0, reservedByteName1,
-            reservedByte);
-
-  if (is_value_valid(OTdata, OTlookupitem)){
-    char _msg[10] {0};
-    const char* baseTopic = messageIDToString(static_cast<OTLibMessageID>(OTdata.id));
-    utoa(activeByte, _msg, 10);
-    if (is_value_valid_for_master_topic(OTdata, OTlookupitem)) sendMQTTData(baseTopic, _msg);
-    publishToSourceTopic(baseTopic, _msg, OTdata.rsptype);
-
-    // Backward compatibility for earlier generic u8u8 decoding.
-    publish_u8_alias_topics(baseTopic);
-    value = activeByte;
-  }
-}
-
-void print_u8_hb(uint16_t& value)
-{
-  print_u8_single(value, true);
-}
-
-void print_u8_lb(uint16_t& value)
-{
-  print_u8_single(value, false);
-}
-
-static PGM_P rfSensorTypeToString_P(uint8_t code)
-{
-  switch (code) {
-    case 0x0: return PSTR("room_temperature_controller");
-    case 0x1: return PSTR("room_temperature_sensor");
-    case 0x2: return PSTR("outside_temperature_sensor");
-    case 0xF: return PSTR("not_defined_type");
-    default:  return PSTR("reserved");
-  }
-}
-
-static PGM_P rfBatteryIndicationToString_P(uint8_t code)
-{
-  switch (code) {
-    case 0x0: return PSTR("no_indication");
-    case 0x1: return PSTR("low_battery");
-    case 0x2: return PSTR("nearly_low_battery");
-    case 0x3: return PSTR("battery_ok");
-    default:  return PSTR("reserved");
-  }
-}
-
-static PGM_P rfSignalStrengthToString_P(uint8_t code)
-{
-  switch (code) {
-    case 0x0: return PSTR("no_indication");
-    case 0x1: return PSTR("strength_1_weak");
-    case 0x2: return PSTR("strength_2");
-    case 0x3: return PSTR("strength_3");
-    case 0x4: return PSTR("strength_4");
-    case 0x5: return PSTR("strength_5_perfect");
-    default:  return PSTR("reserved");
-  }
-}
-
-static PGM_P heatingOverrideModeToString_P(uint8_t code)
-{
-  switch (code) {
-    case 0: return PSTR("no_override");
-    case 1: return PSTR("auto");
-    case 2: return PSTR("comfort");
-    case 3: return PSTR("precomfort");
-    case 4: return PSTR("reduced");
-    case 5: return PSTR("protection");
-    case 6: return PSTR("off");
-    default: return PSTR("reserved");
-  }
-}
-
-static PGM_P dhwOverrideModeToString_P(uint8_t code)
-{
-  switch (code) {
-    case 0: return PSTR("no_override");
-    case 1: return PSTR("auto");
-    case 2: return PSTR("anti_legionella");
-    case 3: return PSTR("comfort");
-    case 4: return PSTR("reduced");
-    case 5: return PSTR("protection");
-    case 6: return PSTR("off");
-    default: return PSTR("reserved");
-  }
-}
-
-static PGM_P onOffToString_P(bool isOn)
-{
-  return isOn ? PSTR("ON") : PSTR("OFF");
-}
-
-static void publish_current_message_u8_alias_topics()
-{
-  publish_u8_alias_topics(messageIDToString(static_cast<OTLibMessageID>(OTdata.id)));
-}
-
-static void publish_mqtt_u8_value_topic(const __FlashStringHelper *topic, uint8_t value)
-{
-  char msg[4] {0};
-  utoa(value, msg, 10);
-  sendMQTTData(topic, msg);
-}
-
-static void publish_mqtt_pgm_payload_topic(const __FlashStringHelper *topic, PGM_P payload)
-{
-  sendMQTTData(topic, toFlashStringHelper(payload));
-}
-
-static void publish_mqtt_u8_code_and_text_topics(const __FlashStringHelper *codeTopic,
-                                                 const __FlashStringHelper *textTopic,
-                                                 uint8_t code,
-                                                 PGM_P text)
-{
-  publish_mqtt_u8_value_topic(codeTopic, code);
-  publish_mqtt_pgm_payload_topic(textTopic, text);
-}
-
-void print_rf_sensor_status_information(uint16_t& value)
-{
-  const uint8_t sensorIndex = OTdata.valueHB & 0x0F;
-  const uint8_t sensorType = (OTdata.valueHB >> 4) & 0x0F;
-  const uint8_t batteryInd = OTdata.valueLB & 0x03;
-  const uint8_t signalStrength = (OTdata.valueLB >> 2) & 0x07;
-  char sensorTypeText[32] {0};
-  char signalStrengthText[24] {0};
-  char batteryIndText[24] {0};
-
-  copyProgmemString(sensorTypeText, sizeof(sensorTypeText), rfSensorTypeToString_P(sensorType));
-  copyProgmemString(signalStrengthText, sizeof(signalStrengthText), rfSignalStrengthToString_P(signalStrength));
-  copyProgmemString(batteryIndText, sizeof(batteryIndText), rfBatteryIndicationToString_P(batteryInd));
-
-  AddLogf_P(PSTR("%s = sensor_type[%u:%s] sensor_index[%u] signal[%u:%s] battery[%u:%s]"),
-            OTlookupitem.label,
-            sensorType, sensorTypeText,
-            sensorIndex,
-            signalStrength, signalStrengthText,
-            batteryInd, batteryIndText);
-
-  if (is_value_valid(OTdata, OTlookupitem)){
-    publish_current_message_u8_alias_topics();
-
-    publish_mqtt_u8_value_topic(F("RFSensorStatusInformation_sensor_index"), sensorIndex);
-    publish_mqtt_u8_code_and_text_topics(F("RFSensorStatusInformation_sensor_type_code"),
-                                         F("RFSensorStatusInformation_sensor_type"),
-                                         sensorType,
-                                         rfSensorTypeToString_P(sensorType));
-    publish_mqtt_u8_code_and_text_topics(F("RFSensorStatusInformation_signal_strength_code"),
-                                         F("RFSensorStatusInformation_signal_strength"),
-                                         signalStrength,
-                                         rfSignalStrengthToString_P(signalStrength));
-    publish_mqtt_u8_code_and_text_topics(F("RFSensorStatusInformation_battery_indication_code"),
-                                         F("RFSensorStatusInformation_battery_indication"),
-                                         batteryInd,
-                                         rfBatteryIndicationToString_P(batteryInd));
-
-    value = OTdata.u16();
-  }
-}
-
-void print_remote_override_operating_mode(uint16_t& value)
-{
-  const uint8_t hc1Mode = OTdata.valueLB & 0x0F;
-  const uint8_t hc2Mode = (OTdata.valueLB >> 4) & 0x0F;
-  const uint8_t dhwMode = OTdata.valueHB & 0x0F;
-  const bool manualDhwPush = (OTdata.valueHB & 0x10) != 0;
-  char dhwModeText[20] {0};
-  char hc1ModeText[16] {0};
-  char hc2ModeText[16] {0};
-  char manualDhwPushText[4] {0};
-
-  copyProgmemString(dhwModeText, sizeof(dhwModeText), dhwOverrideModeToString_P(dhwMode));
-  copyProgmemString(hc1ModeText, sizeof(hc1ModeText), heatingOverrideModeToString_P(hc1Mode));
-  copyProgmemString(hc2ModeText, sizeof(hc2ModeText), heatingOverrideModeToString_P(hc2Mode));
-  copyProgmemString(manualDhwPushText, sizeof(manualDhwPushText), onOffToString_P(manualDhwPush));
-
-  AddLogf_P(PSTR("%s = DHW[%u:%s push:%s] HC1[%u:%s] HC2[%u:%s]"),
-            OTlookupitem.label,
-            dhwMode, dhwModeText, manualDhwPushText,
-            hc1Mode, hc1ModeText,
-            hc2Mode, hc2ModeText);
-
-  if (is_value_valid(OTdata, OTlookupitem)){
-    publish_current_message_u8_alias_topics();
-
-    publish_mqtt_u8_code_and_text_topics(F("RemoteOverrideOperatingMode_dhw_mode_code"),
-                                         F("RemoteOverrideOperatingMode_dhw_mode"),
-                                         dhwMode,
-                                         dhwOverrideModeToString_P(dhwMode));
-    publish_mqtt_pgm_payload_topic(F("RemoteOverrideOperatingMode_manual_dhw_push"), onOffToString_P(manualDhwPush));
-
-    publish_mqtt_u8_code_and_text_topics(F("RemoteOverrideOperatingMode_hc1_mode_code"),
-                                         F("RemoteOverrideOperatingMode_hc1_mode"),
-                                         hc1Mode,
-                                         heatingOverrideModeToString_P(hc1Mode));
-    publish_mqtt_u8_code_and_text_topics(F("RemoteOverrideOperatingMode_hc2_mode_code"),
-                                         F("RemoteOverrideOperatingMode_hc2_mode"),
-                                         hc2Mode,
-                                         heatingOverrideModeToString_P(hc2Mode));
-
-    value = OTdata.u16();
-  }
-}
-
-void print_date(uint16_t& value)
-{ 
-  
-  AddLogf("%s = %3d / %3d %s", OTlookupitem.label, (uint8_t)OTdata.valueHB, (uint8_t)OTdata.valueLB, OTlookupitem.unit);
-  if (is_value_valid(OTdata, OTlookupitem)){
-    //Build string for MQTT
-    otTopic[0] = '\0';
-    char _msg[10] {0};
-    //flag8 valueHB
-    utoa((OTdata.valueHB), _msg, 10);
-    //AddLogf("%s = HB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueHB);
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_month", sizeof(otTopic));
-    sendMQTTData(otTopic, _msg);
-    //flag8 valueLB
-    utoa((OTdata.valueLB), _msg, 10);
-    //AddLogf("%s = LB u8[%s] [%3d]", OTlookupitem.label, _msg, OTdata.valueLB);
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_day_of_month", sizeof(otTopic));
-    sendMQTTData(otTopic, _msg);
-    value = OTdata.u16();
-  }
-}
-
-void print_daytime(uint16_t& value)
-{
-  //function to print data
-  static const char str_unknown[] PROGMEM = "Unknown";
-  static const char str_monday[] PROGMEM = "Monday";
-  static const char str_tuesday[] PROGMEM = "Tuesday";
-  static const char str_wednesday[] PROGMEM = "Wednesday";
-  static const char str_thursday[] PROGMEM = "Thursday";
-  static const char str_friday[] PROGMEM = "Friday";
-  static const char str_saturday[] PROGMEM = "Saturday";
-  static const char str_sunday[] PROGMEM = "Sunday";
-  static const char* const dayOfWeekName[] PROGMEM = { str_unknown, str_monday, str_tuesday, str_wednesday, str_thursday, str_friday, str_saturday, str_sunday, str_unknown };
-  
-  uint8_t dayIdx = (OTdata.valueHB >> 5) & 0x7;
-  char dayName[15];
-  strcpy_P(dayName, (PGM_P)pgm_read_ptr(&dayOfWeekName[dayIdx]));
-  AddLogf("%s = %s - %.2d:%.2d", OTlookupitem.label, dayName, (OTdata.valueHB & 0x1F), OTdata.valueLB); 
-  if (is_value_valid(OTdata, OTlookupitem)){
-    //Build string for MQTT
-    otTopic[0] = '\0';
-    char _msg[10] {0};
-    //dayofweek
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_dayofweek", sizeof(otTopic));
-    sendMQTTData(otTopic, dayName); 
-    //hour
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_hour", sizeof(otTopic));
-    sendMQTTData(otTopic, itoa((OTdata.valueHB & 0x1F), _msg, 10)); 
-    //min
-    strlcpy(otTopic, messageIDToString(static_cast<OTLibMessageID>(OTdata.id)), sizeof(otTopic));
-    strlcat(otTopic, "_minutes", sizeof(otTopic));
-    sendMQTTData(otTopic, itoa((OTdata.valueLB), _msg, 10)); 
-    value = OTdata.u16();
-  }
-}
 
 //===================[ Command Queue implementation ]============================
 
@@ -3378,19 +2451,14 @@ static uint32_t lastSer2netCmdMs = 0 - SER2NET_QUIET_MS;  // expired at boot
 #define OTGW_DELAY_SEND_MS 1000
 #define MAX_QUEUE_MSGSIZE 127
 
-// Remove entry at index from the command queue, shifting remaining entries down.
-static void removeFromCmdQueue(int index) {
-  for (int j = index; j < (cmdQueueSize - 1); j++) {
-    strlcpy(cmdqueue[j].cmd, cmdqueue[j+1].cmd, sizeof(cmdqueue[j].cmd));
-    cmdqueue[j].cmdlen = cmdqueue[j+1].cmdlen;
-    cmdqueue[j].retrycnt = cmdqueue[j+1].retrycnt;
-    cmdqueue[j].due = cmdqueue[j+1].due;
-  }
-  cmdQueueSize--;
-  cmdqueue[cmdQueueSize].cmd[0] = '\0';
-  cmdqueue[cmdQueueSize].cmdlen = 0;
-  cmdqueue[cmdQueueSize].retrycnt = 0;
-  cmdqueue[cmdQueueSize].due = 0;
+// Remove the first queued command with this code (with matchReg, PR=x entries
+// must also match the register letter). Returns true when one was removed.
+static bool removeCmdFromQueue(char c0, char c1, bool matchReg, char reg) {
+  const int slot = cmdQueue.find(c0, c1, matchReg, reg);
+  if (slot < 0) return false;
+  OTDebugTf(PSTR("CmdQueue: Remove [%d]:[%s] from queue\r\n"), slot, cmdQueue.entry[slot].cmd);
+  cmdQueue.remove((uint8_t)slot);
+  return true;
 }
 
 /*
@@ -3413,7 +2481,7 @@ void addCommandToQueue(const char* buf, const int len, const bool forceQueue, co
     return;
   }
 
-  constexpr int kMaxCmdLen = (int)(sizeof(cmdqueue[0].cmd) - 1);
+  constexpr int kMaxCmdLen = (int)(sizeof(OT_cmd_t::cmd) - 1);
 
   if (buf == nullptr) {
     OTDebugTln(F("CmdQueue: Error: null command"));
@@ -3434,29 +2502,21 @@ void addCommandToQueue(const char* buf, const int len, const bool forceQueue, co
     return;
   }
 
-  //check to see if the cmd is in queue
-  bool foundcmd = false;
-  int8_t insertptr = cmdQueueSize; //set insertptr to next empty slot
-  if (!forceQueue){
-    char cmd[3];
-    memset(cmd, 0, sizeof(cmd));
-    memcpy(cmd, buf, 2);
-    for (int i=0; i<cmdQueueSize; i++){
-      if (cmdqueue[i].cmd[0] == cmd[0] && cmdqueue[i].cmd[1] == cmd[1]) {
-        //found cmd exists, set the inertptr to found slot
-        foundcmd = true;
-        insertptr = i;
-        break;
-      }
-    } 
-  } 
-  if (foundcmd) OTDebugTf(PSTR("CmdQueue: Found cmd exists in slot [%d]\r\n"), insertptr);
-  else OTDebugTf(PSTR("CmdQueue: Adding cmd end of queue, slot [%d]\r\n"), insertptr);
-
-  if (!foundcmd && cmdQueueSize >= CMDQUEUE_MAX) {
-    OTDebugTln(F("CmdQueue: Error: Reached max queue"));
-    OTDebugFlush();
-    return;
+  //check to see if the cmd is in queue (code index, no scan)
+  const uint32_t safeDelay = (delay <= 0) ? 0u : (uint32_t)delay;
+  const uint32_t due = millis() + safeDelay;
+  int insertptr = forceQueue ? -1 : cmdQueue.find(buf[0], buf[1]);
+  const bool foundcmd = (insertptr >= 0);
+  if (foundcmd) {
+    OTDebugTf(PSTR("CmdQueue: Found cmd exists in slot [%d]\r\n"), insertptr);
+  } else {
+    if (cmdQueue.full()) {
+      OTDebugTln(F("CmdQueue: Error: Reached max queue"));
+      OTDebugFlush();
+      return;
+    }
+    insertptr = cmdQueue.insert(buf[0], buf[1], due);
+    OTDebugTf(PSTR("CmdQueue: Adding cmd to queue, slot [%d]\r\n"), insertptr);
   }
   if (insertptr < 0 || insertptr >= CMDQUEUE_MAX) {
     OTDebugTf(PSTR("CmdQueue: Error: Invalid insert slot [%d]\r\n"), insertptr);
@@ -3473,25 +2533,17 @@ void addCommandToQueue(const char* buf, const int len, const bool forceQueue, co
   OTDebugf(PSTR("] (%d)\r\n"), len); 
 
   //copy the command into the queue
-  int cmdlen = min((int)len , (int)(sizeof(cmdqueue[insertptr].cmd)-1));
-  memset(cmdqueue[insertptr].cmd, 0, cmdlen+1);
-  memcpy(cmdqueue[insertptr].cmd, buf, cmdlen);
-  cmdqueue[insertptr].cmdlen = cmdlen;
-  cmdqueue[insertptr].retrycnt = 0;
-  const uint32_t safeDelay = (delay <= 0) ? 0u : (uint32_t)delay;
-  cmdqueue[insertptr].due = millis() + safeDelay;
-
-  //if not found
-  if (!foundcmd) {
-    //if not reached max of queue
-    if (cmdQueueSize < CMDQUEUE_MAX) {
-      cmdQueueSize++; //next free slot
-      OTDebugTf(PSTR("CmdQueue: Next free queue slot: [%d]\r\n"), cmdQueueSize);
-    } else {
-      // Should be prevented above; keep as defensive fallback.
-      OTDebugTln(F("CmdQueue: Error: Reached max queue"));
-    }
-  } else OTDebugTf(PSTR("CmdQueue: Found command at: [%d] - [%d]\r\n"), insertptr, cmdQueueSize);
+  OT_cmd_t &entry = cmdQueue.entry[insertptr];
+  int cmdlen = min((int)len , (int)(sizeof(entry.cmd)-1));
+  memset(entry.cmd, 0, sizeof(entry.cmd));
+  memcpy(entry.cmd, buf, cmdlen);
+  entry.cmdlen = cmdlen;
+  entry.retrycnt = 0;
+  if (foundcmd) {
+    entry.due = due;
+    cmdQueue.reschedule((uint8_t)insertptr);
+  }
+  OTDebugTf(PSTR("CmdQueue: Queue size: [%d]\r\n"), cmdQueue.size());
 
   // Trigger PIC settings re-read only for commands that modify readable PIC settings (PR=).
   // GW→PR=M, SB→PR=S, VR→PR=V, TS→PR=D, IT/OH→PR=T, GA/GB→PR=G, LA-LF→PR=L
@@ -3515,23 +2567,23 @@ void handleCommandQueue(){
   // Pause queue processing briefly after ser2net activity to avoid collisions
   if ((millis() - lastSer2netCmdMs) < SER2NET_QUIET_MS) return;
   const uint32_t now = millis();
-  for (int i = 0; i < cmdQueueSize; i++) {
-    // OTDebugTf(PSTR("CmdQueue: Checking due in queue slot[%d]:[%lu]=>[%lu]\r\n"), (int)i, (unsigned long)millis(), (unsigned long)cmdqueue[i].due);
-    if ((int32_t)(now - cmdqueue[i].due) >= 0) {
-      OTDebugTf(PSTR("CmdQueue: Queue slot [%d] due\r\n"), i);
-      sendPICSerial(cmdqueue[i].cmd, cmdqueue[i].cmdlen);
-      cmdqueue[i].retrycnt++;
-      cmdqueue[i].due = now + OTGW_CMD_INTERVAL_MS;
-      if (cmdqueue[i].retrycnt >= OTGW_CMD_RETRY){
-        //max retry reached, so delete command from queue
-        OTDebugTf(PSTR("CmdQueue: Delete [%d] from queue\r\n"), i);
-        snprintf_P(cMsg, sizeof(cMsg), PSTR("%s [dropped]"), cmdqueue[i].cmd);
-        sendEventToWebSocket('!', cMsg);
-        removeFromCmdQueue(i);
-        i--; // re-check current index after shift
-      }
-      // //exit queue handling, after 1 command
-      // return;
+  // Pop only what is due: the heap top is the earliest due entry. A sent
+  // entry is re-armed OTGW_CMD_INTERVAL_MS ahead, so each goes out once.
+  int slot;
+  while ((slot = cmdQueue.top()) >= 0 && (int32_t)(now - cmdQueue.entry[slot].due) >= 0) {
+    OT_cmd_t &entry = cmdQueue.entry[slot];
+    OTDebugTf(PSTR("CmdQueue: Queue slot [%d] due\r\n"), slot);
+    sendPICSerial(entry.cmd, entry.cmdlen);
+    entry.retrycnt++;
+    entry.due = now + OTGW_CMD_INTERVAL_MS;
+    if (entry.retrycnt >= OTGW_CMD_RETRY){
+      //max retry reached, so delete command from queue
+      OTDebugTf(PSTR("CmdQueue: Delete [%d] from queue\r\n"), slot);
+      snprintf_P(cMsg, sizeof(cMsg), PSTR("%s [dropped]"), entry.cmd);
+      sendEventToWebSocket('!', cMsg);
+      cmdQueue.remove((uint8_t)slot);
+    } else {
+      cmdQueue.reschedule((uint8_t)slot);
     }
   }
   OTDebugFlush();
@@ -3564,26 +2616,14 @@ void checkCommandResponse(const char *buf, unsigned int len){
   char value[11]; memset( value, 0, sizeof(value));
   memcpy(cmd, buf, 2);
   memcpy(value, buf+3, ((len-3)<(sizeof(value)-1))?(len-3):(sizeof(value)-1));
-  for (int i=0; i<cmdQueueSize; i++){
-      OTDebugTf(PSTR("CmdQueue: Checking [%2s]==>[%d]:[%s] from queue\r\n"), cmd, i, cmdqueue[i].cmd);
-    if (cmdqueue[i].cmd[0] == cmd[0] && cmdqueue[i].cmd[1] == cmd[1]){
-      // For PR commands, also match the register letter
-      // (e.g., response "PR: S=16.00" must match "PR=S" in queue, not "PR=O")
-      // value starts at buf+3, which may have a leading space (e.g., " S=16.00")
-      if (cmd[0] == 'P' && cmd[1] == 'R' && cmdqueue[i].cmdlen >= 4) {
-        const char* reg = value;
-        while (*reg == ' ') reg++;
-        if (cmdqueue[i].cmd[3] != *reg) continue;
-      }
-      //command found
-      OTDebugTf(PSTR("CmdQueue: Found cmd [%2s]==>[%d]:[%s]\r\n"), cmd, i, cmdqueue[i].cmd);
-        OTDebugTf(PSTR("CmdQueue: Found value [%s]==>[%d]:[%s]\r\n"), value, i, cmdqueue[i].cmd);
-        OTDebugTf(PSTR("CmdQueue: Remove from queue [%d]:[%s] from queue\r\n"), i, cmdqueue[i].cmd);
-        removeFromCmdQueue(i);
-        break;
-      // } else OTDebugTf(PSTR("Error: Did not find value [%s]==>[%d]:[%s]\r\n"), value, i, cmdqueue[i].cmd); 
-    }
-  }
+  // For PR commands, also match the register letter
+  // (e.g., response "PR: S=16.00" must match "PR=S" in queue, not "PR=O")
+  // value starts at buf+3, which may have a leading space (e.g., " S=16.00")
+  const char* reg = value;
+  while (*reg == ' ') reg++;
+  const bool isPR = (cmd[0] == 'P' && cmd[1] == 'R');
+  OTDebugTf(PSTR("CmdQueue: Checking [%2s] value [%s] in queue\r\n"), cmd, value);
+  removeCmdFromQueue(cmd[0], cmd[1], isPR, *reg);
   OTDebugFlush();
 }
 
@@ -3656,6 +2696,13 @@ void sendPICSerial(const char* buf, int len)
 static void dispatchOTGWInputLine(const char* buf, size_t len)
 {
   if (len == 0) return;
+  // Replay runs loop-side while the PIC task may still be finishing its last
+  // drain; the ring takes one producer context at a time. Counted like the
+  // OTDirect hold-off in enqueueOTFrame().
+  if (!otFrameLoopProducerReady()) {
+    otFrameQueueDrops.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
   enqueueOTFrame(buf, len, false, OTFRAME_SRC_PIC);
 }
 
@@ -3805,80 +2852,8 @@ static bool handlePICSerialSimulation(File& otgwSimulationFile,
   return false;
 }
 
-//===================[ PS=1 Summary Parsing ]===============
 
-/*
-  PS=1 (Print Summary) mode field-to-MsgID mapping tables.
-  When in PS=1 mode, the OTGW PIC firmware outputs a single comma-separated summary
-  line per OpenTherm cycle. Two formats exist:
-    - Old firmware (< v5): 25 comma-separated fields (24 commas)
-    - New firmware (v5+) : 34 comma-separated fields (33 commas)
-  Each entry is the OpenTherm MsgID for the corresponding field position.
-*/
-static const uint8_t PSSUMMARY_MSGIDS_OLD[25] PROGMEM = {
-  /*  0 */ 0,   // Status flags         (flag8/flag8)
-  /*  1 */ 1,   // TSet                 (f88)
-  /*  2 */ 6,   // RBPflags             (flag8/flag8)
-  /*  3 */ 14,  // MaxRelModLevelSetting(f88)
-  /*  4 */ 15,  // MaxCapacityMinModLevel (u8/u8)
-  /*  5 */ 16,  // TrSet                (f88)
-  /*  6 */ 17,  // RelModLevel          (f88)
-  /*  7 */ 18,  // CHPressure           (f88)
-  /*  8 */ 24,  // Tr                   (f88)
-  /*  9 */ 25,  // Tboiler              (f88)
-  /* 10 */ 26,  // Tdhw                 (f88)
-  /* 11 */ 27,  // Toutside             (f88)
-  /* 12 */ 28,  // Tret                 (f88)
-  /* 13 */ 48,  // TdhwSetUBTdhwSetLB   (s8/s8)
-  /* 14 */ 49,  // MaxTSetUBMaxTSetLB   (s8/s8)
-  /* 15 */ 56,  // TdhwSet              (f88)
-  /* 16 */ 57,  // MaxTSet              (f88)
-  /* 17 */ 116, // BurnerStarts         (u16)
-  /* 18 */ 117, // CHPumpStarts         (u16)
-  /* 19 */ 118, // DHWPumpValveStarts   (u16)
-  /* 20 */ 119, // DHWBurnerStarts      (u16)
-  /* 21 */ 120, // BurnerOperationHours (u16)
-  /* 22 */ 121, // CHPumpOperationHours (u16)
-  /* 23 */ 122, // DHWPumpValveOperationHours (u16)
-  /* 24 */ 123  // DHWBurnerOperationHours    (u16)
-};
-
-static const uint8_t PSSUMMARY_MSGIDS_NEW[34] PROGMEM = {
-  /*  0 */ 0,   // Status flags              (flag8/flag8)
-  /*  1 */ 1,   // TSet                      (f88)
-  /*  2 */ 6,   // RBPflags                  (flag8/flag8)
-  /*  3 */ 7,   // CoolingControl            (f88)     [new in v5+]
-  /*  4 */ 8,   // TsetCH2                   (f88)     [new in v5+]
-  /*  5 */ 14,  // MaxRelModLevelSetting     (f88)
-  /*  6 */ 15,  // MaxCapacityMinModLevel    (u8/u8)
-  /*  7 */ 16,  // TrSet                     (f88)
-  /*  8 */ 17,  // RelModLevel               (f88)
-  /*  9 */ 18,  // CHPressure                (f88)
-  /* 10 */ 19,  // DHWFlowRate               (f88)     [new in v5+]
-  /* 11 */ 23,  // TrSetCH2                  (f88)     [new in v5+]
-  /* 12 */ 24,  // Tr                        (f88)
-  /* 13 */ 25,  // Tboiler                   (f88)
-  /* 14 */ 26,  // Tdhw                      (f88)
-  /* 15 */ 27,  // Toutside                  (f88)
-  /* 16 */ 28,  // Tret                      (f88)
-  /* 17 */ 31,  // TflowCH2                  (f88)     [new in v5+]
-  /* 18 */ 33,  // Texhaust                  (s16)     [new in v5+]
-  /* 19 */ 48,  // TdhwSetUBTdhwSetLB        (s8/s8)
-  /* 20 */ 49,  // MaxTSetUBMaxTSetLB        (s8/s8)
-  /* 21 */ 56,  // TdhwSet                   (f88)
-  /* 22 */ 57,  // MaxTSet                   (f88)
-  /* 23 */ 70,  // StatusVH                  (flag8/flag8) [new in v5+]
-  /* 24 */ 71,  // ControlSetpointVH         (u8)      [new in v5+]
-  /* 25 */ 77,  // RelativeVentilation       (u8)      [new in v5+]
-  /* 26 */ 116, // BurnerStarts              (u16)
-  /* 27 */ 117, // CHPumpStarts              (u16)
-  /* 28 */ 118, // DHWPumpValveStarts        (u16)
-  /* 29 */ 119, // DHWBurnerStarts           (u16)
-  /* 30 */ 120, // BurnerOperationHours      (u16)
-  /* 31 */ 121, // CHPumpOperationHours      (u16)
-  /* 32 */ 122, // DHWPumpValveOperationHours(u16)
-  /* 33 */ 123  // DHWBurnerOperationHours   (u16)
-};
+//===================[ PS=1 Mode ]===============
 
 static void enterPSMode(PGM_P debugMessage, PGM_P eventMessage, bool resetMsgLastUpdated)
 {
@@ -3914,577 +2889,14 @@ static void leavePSMode(PGM_P debugMessage, PGM_P eventMessage)
   }
 }
 
-static bool parseStrictSignedLong(const char *text, long minValue, long maxValue, long &value)
-{
-  if (!text || *text == '\0') return false;
-
-  char *endPtr = nullptr;
-  long parsedValue = strtol(text, &endPtr, 10);
-  if ((endPtr == text) || (*endPtr != '\0') || (parsedValue < minValue) || (parsedValue > maxValue)) {
-    return false;
-  }
-
-  value = parsedValue;
-  return true;
-}
-
-static bool parseStrictUnsignedLong(const char *text, unsigned long maxValue, unsigned long &value)
-{
-  if (!text || *text == '\0' || *text == '-') return false;
-
-  char *endPtr = nullptr;
-  unsigned long parsedValue = strtoul(text, &endPtr, 10);
-  if ((endPtr == text) || (*endPtr != '\0') || (parsedValue > maxValue)) {
-    return false;
-  }
-
-  value = parsedValue;
-  return true;
-}
-
-static bool parseStrictFloat(const char *text, float &value)
-{
-  if (!text || *text == '\0') return false;
-
-  char *endPtr = nullptr;
-  double parsedValue = strtod(text, &endPtr);
-  if ((endPtr == text) || (*endPtr != '\0')) {
-    return false;
-  }
-
-  value = static_cast<float>(parsedValue);
-  return true;
-}
-
-static bool splitPSSummaryPair(const char *text, char separator,
-                               char *left, size_t leftSize,
-                               char *right, size_t rightSize)
-{
-  if (!text || !left || !right || leftSize == 0 || rightSize == 0) return false;
-
-  const char *separatorPos = strchr(text, separator);
-  if (!separatorPos || strchr(separatorPos + 1, separator)) return false;
-
-  const size_t leftLen = static_cast<size_t>(separatorPos - text);
-  const size_t rightLen = strlen(separatorPos + 1);
-  if (leftLen == 0 || rightLen == 0 || leftLen >= leftSize || rightLen >= rightSize) return false;
-
-  memcpy(left, text, leftLen);
-  left[leftLen] = '\0';
-  strlcpy(right, separatorPos + 1, rightSize);
-  return true;
-}
-
-static bool parsePSSummaryS8S8(const char *text, int8_t &upperByte, int8_t &lowerByte)
-{
-  char left[12] {0};
-  char right[12] {0};
-  long leftValue = 0;
-  long rightValue = 0;
-  if (!splitPSSummaryPair(text, '/', left, sizeof(left), right, sizeof(right))) return false;
-  if (!parseStrictSignedLong(left, -128, 127, leftValue)) return false;
-  if (!parseStrictSignedLong(right, -128, 127, rightValue)) return false;
-  upperByte = static_cast<int8_t>(leftValue);
-  lowerByte = static_cast<int8_t>(rightValue);
-  return true;
-}
-
-static bool parsePSSummaryU8U8(const char *text, uint8_t &upperByte, uint8_t &lowerByte)
-{
-  char left[12] {0};
-  char right[12] {0};
-  unsigned long leftValue = 0;
-  unsigned long rightValue = 0;
-  if (!splitPSSummaryPair(text, '/', left, sizeof(left), right, sizeof(right))) return false;
-  if (!parseStrictUnsignedLong(left, 255UL, leftValue)) return false;
-  if (!parseStrictUnsignedLong(right, 255UL, rightValue)) return false;
-  upperByte = static_cast<uint8_t>(leftValue);
-  lowerByte = static_cast<uint8_t>(rightValue);
-  return true;
-}
-
-static bool parseBinaryOctet(const char *text, uint8_t &value)
-{
-  if (!text || strlen(text) != 8) return false;
-
-  value = 0;
-  for (uint8_t i = 0; i < 8; i++) {
-    if (text[i] != '0' && text[i] != '1') return false;
-    value = static_cast<uint8_t>((value << 1) | (text[i] - '0'));
-  }
-  return true;
-}
-
-static bool parsePSSummaryFlag8Flag8(const char *text, uint8_t &upperByte, uint8_t &lowerByte)
-{
-  char left[9] {0};
-  char right[9] {0};
-  if (!splitPSSummaryPair(text, '/', left, sizeof(left), right, sizeof(right))) return false;
-  if (!parseBinaryOctet(left, upperByte)) return false;
-  if (!parseBinaryOctet(right, lowerByte)) return false;
-  return true;
-}
-
-static void updatePSSummaryFloatState(uint8_t msgid, float fval)
-{
-  switch (msgid) {
-    case  1: OTcurrentSystemState.TSet                  = fval; break;
-    case  7: OTcurrentSystemState.CoolingControl        = fval; break;
-    case  8: OTcurrentSystemState.TsetCH2               = fval; break;
-    case 14: OTcurrentSystemState.MaxRelModLevelSetting = fval; break;
-    case 16: OTcurrentSystemState.TrSet                 = fval; break;
-    case 17: OTcurrentSystemState.RelModLevel           = fval; break;
-    case 18: OTcurrentSystemState.CHPressure            = fval; break;
-    case 19: OTcurrentSystemState.DHWFlowRate           = fval; break;
-    case 23: OTcurrentSystemState.TrSetCH2              = fval; break;
-    case 24: OTcurrentSystemState.Tr                    = fval; break;
-    case 25: OTcurrentSystemState.Tboiler               = fval; break;
-    case 26: OTcurrentSystemState.Tdhw                  = fval; break;
-    case 27: OTcurrentSystemState.Toutside              = fval; break;
-    case 28: OTcurrentSystemState.Tret                  = fval; break;
-    case 31: OTcurrentSystemState.TflowCH2              = fval; break;
-    case 56: OTcurrentSystemState.TdhwSet               = fval; break;
-    case 57: OTcurrentSystemState.MaxTSet               = fval; break;
-    default: break;
-  }
-}
-
-static void updatePSSummaryU16State(uint8_t msgid, uint16_t value)
-{
-  switch (msgid) {
-    case 116: OTcurrentSystemState.BurnerStarts               = value; break;
-    case 117: OTcurrentSystemState.CHPumpStarts               = value; break;
-    case 118: OTcurrentSystemState.DHWPumpValveStarts         = value; break;
-    case 119: OTcurrentSystemState.DHWBurnerStarts            = value; break;
-    case 120: OTcurrentSystemState.BurnerOperationHours       = value; break;
-    case 121: OTcurrentSystemState.CHPumpOperationHours       = value; break;
-    case 122: OTcurrentSystemState.DHWPumpValveOperationHours = value; break;
-    case 123: OTcurrentSystemState.DHWBurnerOperationHours    = value; break;
-    default:  break;
-  }
-}
-
-static void publishPSSummarySplitBytes(const char *label, const char *hbSuffix, const char *lbSuffix,
-                                       const char *hbValue, const char *lbValue)
-{
-  char topicBuf[MQTT_TOPIC_MAX_LEN];
-  strlcpy(topicBuf, label, sizeof(topicBuf));
-  strlcat(topicBuf, hbSuffix, sizeof(topicBuf));
-  sendMQTTData(topicBuf, hbValue);
-  strlcpy(topicBuf, label, sizeof(topicBuf));
-  strlcat(topicBuf, lbSuffix, sizeof(topicBuf));
-  sendMQTTData(topicBuf, lbValue);
-}
-
-static void ensurePSSummaryDiscovery(uint8_t msgid)
-{
-  // Non-blocking: just mark pending; drainOnePendingDiscovery() publishes later.
-  if (settings.mqtt.bEnable && !getMQTTConfigDone(msgid)) {
-    setMQTTConfigPending(msgid);
-  }
-}
-
-static void logPSSummaryField(const char *label, const char *rawField)
-{
-  ClrLog();
-  AddLogf_P(PSTR("PS1 %-20s = %s"), label, rawField);
-  AddLogln();
-  sendLogToWebSocket(ot_log_buffer);
-  ClrLog();
-}
-
-static bool publishPSSummaryFieldValue(uint8_t msgid, uint8_t valueType, const char *label, const char *rawField)
-{
-  char valueBuf[12] {0};
-  const uint16_t trackedNow = currentTrackedSeconds();
-
-  // ADR-097 (PS=1 amendment): Caller already populated the global OTlookupitem
-  // via PROGMEM_readAnything(&OTmap[msgid], ...) before invoking us. Use it to
-  // gate base-topic publication and OTcurrentSystemState updates so the PS=1
-  // path matches the live OT-bus master-topic invariant. setMsgLastUpdated is
-  // intentionally left ungated (cosmetic epoch tick, consistent with
-  // OTGW-Core.ino:4034 in the live-bus path). The ot_flag8flag8 case keeps its
-  // own per-MsgID handling (status-flag semantics) and is not gated here.
-  const bool validForMaster = is_msgid_valid_for_master_topic_in_ps_summary(OTlookupitem);
-  if (!validForMaster) {
-    DebugTf(PSTR("PS=1 master-topic gate suppressed MsgID %u (%s): bSlaveEchoesValue=false\r\n"),
-            msgid, label);
-  }
-
-  switch (valueType) {
-    case ot_f88: {
-      float value = 0.0f;
-      if (!parseStrictFloat(rawField, value)) return false;
-      dtostrf(value, 3, 2, valueBuf);
-      if (validForMaster) sendMQTTData(label, valueBuf);
-      setMsgLastUpdated(msgid, trackedNow);
-      if (validForMaster) updatePSSummaryFloatState(msgid, value);
-      return true;
-    }
-
-    case ot_s16: {
-      long parsedValue = 0;
-      if (!parseStrictSignedLong(rawField, -32768L, 32767L, parsedValue)) return false;
-      itoa(static_cast<int16_t>(parsedValue), valueBuf, 10);
-      if (validForMaster) sendMQTTData(label, valueBuf);
-      setMsgLastUpdated(msgid, trackedNow);
-      if (validForMaster && msgid == 33) OTcurrentSystemState.Texhaust = static_cast<int16_t>(parsedValue);
-      return true;
-    }
-
-    case ot_u16: {
-      unsigned long parsedValue = 0;
-      if (!parseStrictUnsignedLong(rawField, 65535UL, parsedValue)) return false;
-      utoa(static_cast<uint16_t>(parsedValue), valueBuf, 10);
-      if (validForMaster) sendMQTTData(label, valueBuf);
-      setMsgLastUpdated(msgid, trackedNow);
-      if (validForMaster) updatePSSummaryU16State(msgid, static_cast<uint16_t>(parsedValue));
-      return true;
-    }
-
-    case ot_s8s8: {
-      int8_t upperByte = 0;
-      int8_t lowerByte = 0;
-      if (!parsePSSummaryS8S8(rawField, upperByte, lowerByte)) return false;
-      char lowerValueBuf[12] {0};
-      itoa(upperByte, valueBuf, 10);
-      itoa(lowerByte, lowerValueBuf, 10);
-      if (validForMaster) publishPSSummarySplitBytes(label, "_value_hb", "_value_lb", valueBuf, lowerValueBuf);
-      setMsgLastUpdated(msgid, trackedNow);
-      if (validForMaster) {
-        if (msgid == 48) OTcurrentSystemState.TdhwSetUBTdhwSetLB = ((uint8_t)upperByte << 8) | (uint8_t)lowerByte;
-        else if (msgid == 49) OTcurrentSystemState.MaxTSetUBMaxTSetLB = ((uint8_t)upperByte << 8) | (uint8_t)lowerByte;
-      }
-      return true;
-    }
-
-    case ot_u8u8: {
-      uint8_t upperByte = 0;
-      uint8_t lowerByte = 0;
-      if (!parsePSSummaryU8U8(rawField, upperByte, lowerByte)) return false;
-      char lowerValueBuf[12] {0};
-      utoa(upperByte, valueBuf, 10);
-      utoa(lowerByte, lowerValueBuf, 10);
-      if (validForMaster) publishPSSummarySplitBytes(label, "_value_hb", "_value_lb", valueBuf, lowerValueBuf);
-      setMsgLastUpdated(msgid, trackedNow);
-      if (validForMaster && msgid == 15) OTcurrentSystemState.MaxCapacityMinModLevel = ((uint16_t)upperByte << 8) | lowerByte;
-      return true;
-    }
-
-    case ot_u8: {
-      unsigned long parsedValue = 0;
-      if (!parseStrictUnsignedLong(rawField, 255UL, parsedValue)) return false;
-      utoa(static_cast<uint8_t>(parsedValue), valueBuf, 10);
-      if (validForMaster) sendMQTTData(label, valueBuf);
-      setMsgLastUpdated(msgid, trackedNow);
-      if (validForMaster) {
-        if (msgid == 71) OTcurrentSystemState.ControlSetpointVH = static_cast<uint8_t>(parsedValue);
-        else if (msgid == 77) OTcurrentSystemState.RelativeVentilation = static_cast<uint8_t>(parsedValue);
-      }
-      return true;
-    }
-
-    case ot_flag8flag8: {
-      uint8_t upperByte = 0;
-      uint8_t lowerByte = 0;
-      if (!parsePSSummaryFlag8Flag8(rawField, upperByte, lowerByte)) return false;
-      setMsgLastUpdated(msgid, trackedNow);
-      switch (msgid) {
-        case 0:
-          OTcurrentSystemState.Statusflags = publishCombinedStatusState(upperByte, lowerByte);
-          break;
-        case 6: {
-          // TASK-401: feed previous HB/LB into publishRBPFlagsState so per-bit gate works via PS summary path too.
-          const uint16_t prevCombined = OTcurrentSystemState.RBPflags;
-          const uint8_t  prevTransfer  = (uint8_t)((prevCombined >> 8) & 0xFF);
-          const uint8_t  prevReadWrite = (uint8_t)(prevCombined & 0xFF);
-          OTcurrentSystemState.RBPflags = publishRBPFlagsState(upperByte, lowerByte, prevTransfer, prevReadWrite);
-          break;
-        }
-        case 70:
-          OTcurrentSystemState.StatusVH = publishCombinedStatusVHState(upperByte, lowerByte);
-          break;
-        default:
-          sendMQTTData(label, rawField);
-          break;
-      }
-      return true;
-    }
-
-    default:
-      return false;
-  }
-}
-
-/*
-  Process a PS=1 (Print Summary) comma-separated summary line from the OTGW PIC firmware.
-  Parses each field, updates OTcurrentSystemState, and publishes to MQTT.
-  Old firmware (< v5): 25 fields / 24 commas.
-  New firmware (v5+) : 34 fields / 33 commas.
-*/
-void processPSSummary(const char *buf, int len) {
-  int commaCount = 0;
-  for (int i = 0; i < len; i++) {
-    if (buf[i] == ',') commaCount++;
-  }
-
-  const bool bFW5 = (commaCount == 33);
-  if (commaCount != 24 && commaCount != 33) return;
-
-  enterPSMode(PSTR("PS mode auto-detected as ON (comma-separated summary)"), nullptr, false);
-
-  const uint8_t *msgIdTable = bFW5 ? PSSUMMARY_MSGIDS_NEW : PSSUMMARY_MSGIDS_OLD;
-  const uint8_t tableSize   = bFW5 ? 34 : 25;
-  const char *p = buf;
-  const char *end = buf + len;
-  int idx = 0;
-  char fBuf[22];
-
-  while (p <= end && idx < tableSize) {
-    const char *comma = (const char*)memchr(p, ',', end - p);
-    const int fieldLen = (comma != nullptr) ? (int)(comma - p) : (int)(end - p);
-
-    if (fieldLen > 0 && fieldLen < (int)sizeof(fBuf)) {
-      memcpy(fBuf, p, fieldLen);
-      fBuf[fieldLen] = '\0';
-
-      const uint8_t msgid = pgm_read_byte(&msgIdTable[idx]);
-      if (msgid <= OT_MSGID_MAX) {
-        PROGMEM_readAnything(&OTmap[msgid], OTlookupitem);
-        const char *label = OTlookupitem.label;
-        // ADR-104 Decision item 7: scope mqttPendingSlot commit to this frame.
-        // shouldPublishMQTTForPSField installs pending; capture the pre-publish
-        // success count, run the publish path, then commit if any sendMQTTData
-        // succeeded — else clear the pending so a later unrelated publish
-        // cannot silently commit it.
-        const uint32_t preSuccessCount = mqttSendSuccessCount;
-        OTPublishGate psGate(shouldPublishMQTTForPSField(msgid));
-
-        if (publishPSSummaryFieldValue(msgid, OTlookupitem.type, label, fBuf)) {
-          ensurePSSummaryDiscovery(msgid);
-          logPSSummaryField(label, fBuf);
-        }
-
-        if (mqttPendingSlot.pending) {
-          if (mqttSendSuccessCount > preSuccessCount) confirmMQTTPublishSlot();
-          else                                        mqttPendingSlot.pending = false;
-        }
-      }
-    }
-
-    if (comma == nullptr) break;
-    p = comma + 1;
-    idx++;
-  }
-
-  OTDebugTf(PSTR("PS=1 summary parsed: %d fields (%s firmware)\r\n"), idx + 1, bFW5 ? "v5+" : "<v5");
-}
-
 //===================[ OT Message Processing ]===============
 
-/*
-  This function checks if the string received is a valid "raw OT message".
-  Raw OTmessages are 9 chars long and start with TBARE when talking to OTGW PIC.
-  Message is not an OTmessage if length is not 9 long OR 3th char is ':' (= OTGW command response)
-*/
-bool isvalidotmsg(const char *buf, int len){
-  bool _ret =  (len==9);    //check 9 chars long
-  _ret &= (buf[2]!=':');    //not a otgw command response 
-  char c = buf[0];
-  _ret &= (c=='T' || c=='B' || c=='A' || c=='R' || c=='E'); //1 char matches any of 'B', 'T', 'A', 'R' or 'E'
-  return _ret;
-}
-
-static bool decodeAndPublishStatusAndConfigValue(OTLibMessageID msgId)
-{
-  switch (msgId) {
-    case OT_Statusflags:                            print_status(OTcurrentSystemState.Statusflags); return true;
-    case OT_ASFflags:                               print_ASFflags(OTcurrentSystemState.ASFflags); return true;
-    case OT_MasterConfigMemberIDcode:               print_mastermemberid(OTcurrentSystemState.MasterConfigMemberIDcode); return true;
-    case OT_SlaveConfigMemberIDcode:                print_slavememberid(OTcurrentSystemState.SlaveConfigMemberIDcode); return true;
-    case OT_Command:                                print_command(OTcurrentSystemState.Command );  return true;
-    case OT_RBPflags:                               print_RBPflags(OTcurrentSystemState.RBPflags); return true;
-    case OT_TSP:                                    print_u8u8(OTcurrentSystemState.TSP); return true;
-    case OT_TSPindexTSPvalue:                       print_u8u8(OTcurrentSystemState.TSPindexTSPvalue); return true;
-    case OT_FHBsize:                                print_u8u8(OTcurrentSystemState.FHBsize); return true;
-    case OT_FHBindexFHBvalue:                       print_u8u8(OTcurrentSystemState.FHBindexFHBvalue); return true;
-    case OT_MaxCapacityMinModLevel:                 print_u8u8(OTcurrentSystemState.MaxCapacityMinModLevel); return true;
-    case OT_Date:                                   print_date(OTcurrentSystemState.Date); return true;
-    case OT_Year:                                   print_u16(OTcurrentSystemState.Year); return true;
-    case OT_TdhwSetUBTdhwSetLB:                     print_s8s8(OTcurrentSystemState.TdhwSetUBTdhwSetLB ); return true;
-    case OT_MaxTSetUBMaxTSetLB:                     print_s8s8(OTcurrentSystemState.MaxTSetUBMaxTSetLB); return true;
-    case OT_HcratioUBHcratioLB:                     print_s8s8(OTcurrentSystemState.HcratioUBHcratioLB); return true;
-    case OT_Remoteparameter4boundaries:             print_s8s8(OTcurrentSystemState.Remoteparameter4boundaries); return true;
-    case OT_Remoteparameter5boundaries:             print_s8s8(OTcurrentSystemState.Remoteparameter5boundaries); return true;
-    case OT_Remoteparameter6boundaries:             print_s8s8(OTcurrentSystemState.Remoteparameter6boundaries); return true;
-    case OT_Remoteparameter7boundaries:             print_s8s8(OTcurrentSystemState.Remoteparameter7boundaries); return true;
-    case OT_Remoteparameter8boundaries:             print_s8s8(OTcurrentSystemState.Remoteparameter8boundaries); return true;
-    case OT_RemoteOverrideFunction:                 print_remoteoverridefunction(OTcurrentSystemState.RemoteOverrideFunction); return true;
-    case OT_OEMDiagnosticCode:                      print_u16(OTcurrentSystemState.OEMDiagnosticCode); return true;
-    case OT_OpenThermVersionMaster:                 print_f88(OTcurrentSystemState.OpenThermVersionMaster); return true;
-    case OT_OpenThermVersionSlave:                  print_f88(OTcurrentSystemState.OpenThermVersionSlave); return true;
-    case OT_MasterVersion:                          print_u8u8(OTcurrentSystemState.MasterVersion ); return true;
-    case OT_SlaveVersion:                           print_u8u8(OTcurrentSystemState.SlaveVersion); return true;
-    case OT_Brand:                                  print_u8u8(OTcurrentSystemState.Brand); return true;
-    case OT_BrandVersion:                           print_u8u8(OTcurrentSystemState.BrandVersion); return true;
-    case OT_BrandSerialNumber:                      print_u8u8(OTcurrentSystemState.BrandSerialNumber); return true;
-    default:
-      return false;
-  }
-}
-
-static bool decodeAndPublishTemperatureAndSensorValue(OTLibMessageID msgId)
-{
-  switch (msgId) {
-    case OT_TSet:                                   print_f88(OTcurrentSystemState.TSet); return true;
-    case OT_CoolingControl:                         print_f88(OTcurrentSystemState.CoolingControl); return true;
-    case OT_TsetCH2:                                print_f88(OTcurrentSystemState.TsetCH2); return true;
-    case OT_TrOverride:                             print_f88(OTcurrentSystemState.TrOverride); return true;
-    case OT_MaxRelModLevelSetting:                  print_f88(OTcurrentSystemState.MaxRelModLevelSetting); return true;
-    case OT_TrSet:                                  print_f88(OTcurrentSystemState.TrSet); return true;
-    case OT_TrSetCH2:                               print_f88(OTcurrentSystemState.TrSetCH2); return true;
-    case OT_RelModLevel:                            print_f88(OTcurrentSystemState.RelModLevel); return true;
-    case OT_CHPressure:                             print_f88(OTcurrentSystemState.CHPressure); return true;
-    case OT_DHWFlowRate:                            print_f88(OTcurrentSystemState.DHWFlowRate); return true;
-    case OT_Tr:                                     print_f88(OTcurrentSystemState.Tr); return true;
-    case OT_Tboiler:                                print_f88(OTcurrentSystemState.Tboiler);return true;
-    case OT_Tdhw:                                   print_f88(OTcurrentSystemState.Tdhw); return true;
-    case OT_Toutside:                               print_f88(OTcurrentSystemState.Toutside); return true;
-    case OT_Tret:                                   print_f88(OTcurrentSystemState.Tret); return true;
-    case OT_Tsolarstorage:                          print_f88(OTcurrentSystemState.Tsolarstorage); return true;
-    case OT_Tsolarcollector:                        print_s16(OTcurrentSystemState.Tsolarcollector); return true;
-    case OT_TflowCH2:                               print_f88(OTcurrentSystemState.TflowCH2); return true;
-    case OT_Tdhw2:                                  print_f88(OTcurrentSystemState.Tdhw2 ); return true;
-    case OT_Texhaust:                               print_s16(OTcurrentSystemState.Texhaust); return true;
-    case OT_Theatexchanger:                         print_f88(OTcurrentSystemState.Theatexchanger); return true;
-    case OT_TdhwSet:                                print_f88(OTcurrentSystemState.TdhwSet); return true;
-    case OT_MaxTSet:                                print_f88(OTcurrentSystemState.MaxTSet); return true;
-    case OT_Hcratio:                                print_f88(OTcurrentSystemState.Hcratio); return true;
-    case OT_Remoteparameter4:                       print_f88(OTcurrentSystemState.Remoteparameter4); return true;
-    case OT_Remoteparameter5:                       print_f88(OTcurrentSystemState.Remoteparameter5); return true;
-    case OT_Remoteparameter6:                       print_f88(OTcurrentSystemState.Remoteparameter6); return true;
-    case OT_Remoteparameter7:                       print_f88(OTcurrentSystemState.Remoteparameter7); return true;
-    case OT_Remoteparameter8:                       print_f88(OTcurrentSystemState.Remoteparameter8); return true;
-    case OT_BurnerStarts:                           print_u16(OTcurrentSystemState.BurnerStarts); return true;
-    case OT_CHPumpStarts:                           print_u16(OTcurrentSystemState.CHPumpStarts); return true;
-    case OT_DHWPumpValveStarts:                     print_u16(OTcurrentSystemState.DHWPumpValveStarts); return true;
-    case OT_DHWBurnerStarts:                        print_u16(OTcurrentSystemState.DHWBurnerStarts); return true;
-    case OT_BurnerOperationHours:                   print_u16(OTcurrentSystemState.BurnerOperationHours); return true;
-    case OT_CHPumpOperationHours:                   print_u16(OTcurrentSystemState.CHPumpOperationHours); return true;
-    case OT_DHWPumpValveOperationHours:             print_u16(OTcurrentSystemState.DHWPumpValveOperationHours); return true;
-    case OT_DHWBurnerOperationHours:                print_u16(OTcurrentSystemState.DHWBurnerOperationHours); return true;
-    case OT_FanSpeed:                               print_u8u8(OTcurrentSystemState.FanSpeed); return true;
-    case OT_ElectricalCurrentBurnerFlame:           print_f88(OTcurrentSystemState.ElectricalCurrentBurnerFlame); return true;
-    case OT_TRoomCH2:                               print_f88(OTcurrentSystemState.TRoomCH2); return true;
-    case OT_RelativeHumidity:                       print_f88(OTcurrentSystemState.RelativeHumidity); return true;
-    case OT_TrOverride2:                            print_f88(OTcurrentSystemState.TrOverride2); return true;
-    case OT_CoolingOperationHours:                  print_u16(OTcurrentSystemState.CoolingOperationHours); return true;
-    case OT_PowerCycles:                            print_u16(OTcurrentSystemState.PowerCycles); return true;
-    case OT_ElectricityProducerStarts:              print_u16(OTcurrentSystemState.ElectricityProducerStarts); return true;
-    case OT_ElectricityProducerHours:               print_u16(OTcurrentSystemState.ElectricityProducerHours); return true;
-    case OT_ElectricityProduction:                  print_u16(OTcurrentSystemState.ElectricityProduction); return true;
-    case OT_CumulativeElectricityProduction:        print_u16(OTcurrentSystemState.CumulativeElectricityProduction); return true;
-    case OT_BurnerUnsuccessfulStarts:               print_u16(OTcurrentSystemState.BurnerUnsuccessfulStarts); return true;
-    case OT_FlameSignalTooLow:                      print_u16(OTcurrentSystemState.FlameSignalTooLow); return true;
-    default:
-      return false;
-  }
-}
-
-static bool decodeAndPublishVentilationValue(OTLibMessageID msgId)
-{
-  switch (msgId) {
-    case OT_StatusVH:                               print_statusVH(OTcurrentSystemState.StatusVH); return true;
-    case OT_ControlSetpointVH:                      print_u8_lb(OTcurrentSystemState.ControlSetpointVH); return true;
-    case OT_ASFFaultCodeVH:                         print_flag8u8(OTcurrentSystemState.ASFFaultCodeVH); return true;
-    case OT_DiagnosticCodeVH:                       print_u16(OTcurrentSystemState.DiagnosticCodeVH); return true;
-    case OT_ConfigMemberIDVH:                       print_vh_configmemberid(OTcurrentSystemState.ConfigMemberIDVH); return true;
-    case OT_OpenthermVersionVH:                     print_f88(OTcurrentSystemState.OpenthermVersionVH); return true;
-    case OT_VersionTypeVH:                          print_u8u8(OTcurrentSystemState.VersionTypeVH ); return true;
-    case OT_RelativeVentilation:                    print_u8_lb(OTcurrentSystemState.RelativeVentilation); return true;
-    case OT_RelativeHumidityExhaustAir:             print_u8_lb(OTcurrentSystemState.RelativeHumidityExhaustAir); return true;
-    case OT_CO2LevelExhaustAir:                     print_u16(OTcurrentSystemState.CO2LevelExhaustAir); return true;
-    case OT_SupplyInletTemperature:                 print_f88(OTcurrentSystemState.SupplyInletTemperature); return true;
-    case OT_SupplyOutletTemperature:                print_f88(OTcurrentSystemState.SupplyOutletTemperature); return true;
-    case OT_ExhaustInletTemperature:                print_f88(OTcurrentSystemState.ExhaustInletTemperature); return true;
-    case OT_ExhaustOutletTemperature:               print_f88(OTcurrentSystemState.ExhaustOutletTemperature); return true;
-    case OT_ActualExhaustFanSpeed:                  print_u16(OTcurrentSystemState.ActualExhaustFanSpeed); return true;
-    case OT_ActualSupplyFanSpeed:                   print_u16(OTcurrentSystemState.ActualSupplyFanSpeed); return true;
-    case OT_RemoteParameterSettingVH:               print_vh_remoteparametersetting(OTcurrentSystemState.RemoteParameterSettingVH); return true;
-    case OT_NominalVentilationValue:                print_u8_hb(OTcurrentSystemState.NominalVentilationValue); return true;
-    case OT_TSPNumberVH:                            print_u8u8(OTcurrentSystemState.TSPNumberVH); return true;
-    case OT_TSPEntryVH:                             print_u8u8(OTcurrentSystemState.TSPEntryVH); return true;
-    case OT_FaultBufferSizeVH:                      print_u8u8(OTcurrentSystemState.FaultBufferSizeVH); return true;
-    case OT_FaultBufferEntryVH:                     print_u8u8(OTcurrentSystemState.FaultBufferEntryVH); return true;
-    default:
-      return false;
-  }
-}
-
-static bool decodeAndPublishSpecialValue(OTLibMessageID msgId)
-{
-  switch (msgId) {
-    case OT_DayTime:                                print_daytime(OTcurrentSystemState.DayTime); return true;
-    case OT_RFstrengthbatterylevel:                 print_rf_sensor_status_information(OTcurrentSystemState.RFstrengthbatterylevel); return true;
-    case OT_OperatingMode_HC1_HC2_DHW:              print_remote_override_operating_mode(OTcurrentSystemState.OperatingMode_HC1_HC2_DHW ); return true;
-    default:
-      return false;
-  }
-}
-
-static bool decodeAndPublishSolarStorageValue(OTLibMessageID msgId)
-{
-  switch (msgId) {
-    case OT_SolarStorageMaster:                     print_solar_storage_status(OTcurrentSystemState.SolarStorageStatus ); return true;
-    case OT_SolarStorageASFflags:                   print_flag8u8(OTcurrentSystemState.SolarStorageASFflags); return true;
-    case OT_SolarStorageSlaveConfigMemberIDcode:    print_solarstorage_slavememberid(OTcurrentSystemState.SolarStorageSlaveConfigMemberIDcode); return true;
-    case OT_SolarStorageVersionType:                print_u8u8(OTcurrentSystemState.SolarStorageVersionType); return true;
-    case OT_SolarStorageTSP:                        print_u8u8(OTcurrentSystemState.SolarStorageTSP ); return true;
-    case OT_SolarStorageTSPindexTSPvalue:           print_u8u8(OTcurrentSystemState.SolarStorageTSPindexTSPvalue ); return true;
-    case OT_SolarStorageFHBsize:                    print_u8u8(OTcurrentSystemState.SolarStorageFHBsize ); return true;
-    case OT_SolarStorageFHBindexFHBvalue:           print_u8u8(OTcurrentSystemState.SolarStorageFHBindexFHBvalue ); return true;
-    default:
-      return false;
-  }
-}
-
-static bool decodeAndPublishVendorValue(OTLibMessageID msgId)
-{
-  switch (msgId) {
-    case OT_RemehadFdUcodes:                        print_u8u8(OTcurrentSystemState.RemehadFdUcodes); return true;
-    case OT_RemehaServicemessage:                   print_u8u8(OTcurrentSystemState.RemehaServicemessage); return true;
-    case OT_RemehaDetectionConnectedSCU:            print_u8u8(OTcurrentSystemState.RemehaDetectionConnectedSCU); return true;
-    default:
-      return false;
-  }
-}
-static void decodeAndPublishOTValue()
-{
-  if (isMsgIdReservedInActiveProfile(OTdata.id)) {
-    char activeProfileName[20] {0};
-    copyProgmemString(activeProfileName, sizeof(activeProfileName), activeOTSpecProfileName_P());
-    AddLogf_P(PSTR("Reserved in %s profile (legacy pre-v4.2 ID %u ignored)"),
-              activeProfileName,
-              (unsigned)OTdata.id);
-    return;
-  }
-
-  const OTLibMessageID msgId = static_cast<OTLibMessageID>(OTdata.id);
-
-  if (decodeAndPublishStatusAndConfigValue(msgId)) return;
-  if (decodeAndPublishTemperatureAndSensorValue(msgId)) return;
-  if (decodeAndPublishVentilationValue(msgId)) return;
-  if (decodeAndPublishSpecialValue(msgId)) return;
-  if (decodeAndPublishSolarStorageValue(msgId)) return;
-  if (decodeAndPublishVendorValue(msgId)) return;
-
-  AddLogf("Unknown message [%02d] value [%04X] f8.8 [%3.2f] u16 [%d] s16 [%d]",
-          OTdata.id,
-          OTdata.value,
-          OTdata.f88(),
-          OTdata.u16(),
-          OTdata.s16());
-}
+// The decode + publish body (is_value_valid*, the print_* decoders,
+// processPSSummary, decodeAndPublishOTValue and processOTFrame, the raw-frame
+// branch of processOT) lives in OTDecode.h so the host replay benchmark
+// compiles the firmware's own hot path. Included here, after everything it
+// calls.
+#include "OTDecode.h"
 
 // PIC status / error tokens emitted by OTGW firmware as bare lines on the
 // serial bus. Each entry collapses an "else if (strcmp_P) { Debugln + report }"
@@ -4558,49 +2970,6 @@ static bool handlePICStatusToken(const char *buf) {
   - error format
   - ...
 */
-// TASK-691 / TASK-692 / TASK-693 port (dev TASK-685/686/688): per-msgID bitmaps
-// recording each side of the OT bus's observed capability. Populated in
-// processOT (idempotent set on every observation). File scope so REST/MQTT/
-// file-persistence layers can read them through the accessors below.
-//
-// Memory: 6 * 32 = 192 B bitmaps + 3 B dirty flags + 32 B scratch = 227 B.
-//
-// Persistence (TASK-693): the *FileDirty flags drive 15-min debounced atomic
-// writes to /ot-thermo.json and /ot-boiler.json (saveOtSupportFilesIfDirty).
-// boilerUnsupportedDirty stays independent because the MQTT republish has its
-// own (1-min) cadence and consumes only the unsupported subset.
-static uint8_t boilerLastMasterWasWrite[32] = {0};  // scratch — not persisted
-static uint8_t boilerUnsupportedRead[32]    = {0};
-static uint8_t boilerUnsupportedWrite[32]   = {0};
-static uint8_t boilerAckedRead[32]          = {0};
-static uint8_t boilerAckedWrite[32]         = {0};
-static uint8_t thermostatSentRead[32]       = {0};
-static uint8_t thermostatSentWrite[32]      = {0};
-static bool boilerUnsupportedDirty = false;  // MQTT CSV republish gate (1-min cadence)
-static bool boilerFileDirty        = false;  // /ot-boiler.json   write gate (15-min cadence)
-static bool thermostatFileDirty    = false;  // /ot-thermo.json   write gate (15-min cadence)
-
-bool isBoilerMsgIdUnsupportedRead(uint8_t id) {
-  return (boilerUnsupportedRead[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
-}
-bool isBoilerMsgIdUnsupportedWrite(uint8_t id) {
-  return (boilerUnsupportedWrite[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
-}
-bool isBoilerMsgIdAckedRead(uint8_t id) {
-  return (boilerAckedRead[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
-}
-bool isBoilerMsgIdAckedWrite(uint8_t id) {
-  return (boilerAckedWrite[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
-}
-bool isThermostatMsgIdSentRead(uint8_t id) {
-  return (thermostatSentRead[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
-}
-bool isThermostatMsgIdSentWrite(uint8_t id) {
-  return (thermostatSentWrite[id >> 3] & (uint8_t)(1u << (id & 7))) != 0;
-}
-bool getBoilerUnsupportedDirty()   { return boilerUnsupportedDirty; }
-void clearBoilerUnsupportedDirty() { boilerUnsupportedDirty = false; }
-
 void processOT(const char *buf, int len, bool suppressOutput){
   // TASK-865.5 (ADR-123 Phase-1): processOT() is THE writer of the decoded
   // OTGWState snapshot (OTcurrentSystemState.*, state.otBus.*). Acquire the
@@ -4610,318 +2979,24 @@ void processOT(const char *buf, int len, bool suppressOutput){
   // synthesizeResponse, otDirectBridgeProcessPRResponse) that call processOT()
   // directly. In seq6 the consumer runs on the PIC task while those synthesis
   // calls run on the loop task, so processOT executes from two tasks — the lock
-  // serialises them against each other and against the restAPI reader.
-  // Non-recursive: processOT's callees must NOT re-take OTStateLock (verified:
-  // only sendOTmonitorV2 acquires it, and processOT does not call it).
+  // serialises them against each other. REST readers no longer take it; they
+  // read otStateSnapshot. Non-recursive: processOT's callees must NOT re-take
+  // OTStateLock.
   OTStateLock stateLock;
+  // Cross-task readers get the result through otStateSnapshot, published when
+  // this returns (destroyed before stateLock, so still under the lock).
+  OTStatePublishOnExit publishState;
 
   // suppressOutput (TASK-293): when true, skip per-frame output paths and the
   // auto-leave-PS-mode heuristic. State updates, decoded value publishing,
   // and OT state flag writes still run so MQTT/SAT/WebUI values stay fresh.
   // Set by bridgeFrameToParser() on ESP32 OT-direct when PS=1 is active; the
   // PIC does the equivalent internally on ESP8266.
-  // Per-link last-seen now lives in state.otBus (tBoilerLastSeen/tThermostatLastSeen)
-  // so /api/v2/health can emit per-link recency for the v2 connectivity degraded/stale
-  // state (ADR-155). Same single source of truth feeds the 30 s connected window below.
-  static bool bOTGWboilerpreviousstate = false;
-  static bool bOTGWthermostatpreviousstate = false;
-  static bool bOTGWpreviousstate = false;
-  time_t now = time(nullptr);
-
-  if (isvalidotmsg(buf, len)) {
-    // Raw OT frames normally indicate PS=0 (streaming resumed). Skip this
-    // auto-leave path when the caller explicitly suppresses output: in
-    // OT-direct PS=1 we synthesise raw frames ourselves, so seeing them
-    // does not mean the PIC/firmware left PS mode.
-    if (state.otBus.bPSmode && !suppressOutput) {
-      leavePSMode(PSTR("PS mode auto-detected as OFF (raw OT stream resumed)"),
-                  PSTR("PS=0 [auto-detected, raw mode resumed]"));
-    }
-
-    // Update LED heartbeat timestamp — resets the "no OT" warning
-    lastOTmsgMs = millis();
-
-    //OT protocol messages are 9 chars long
-    if (!suppressOutput && settings.mqtt.bOTmessage) sendMQTTData(F("otmessage"), buf);
-
-    // counter of number of OT messages processed
-    static int32_t cntOTmessagesprocessed = 0;
-    cntOTmessagesprocessed++;
-    // char _msg[15] {0};
-    // sendMQTTData(F("otmsg_count"), itoa(cntOTmessagesprocessed, _msg, 10)); 
-
-    // source of otmsg
-    if (buf[0]=='B'){
-      state.otBus.tBoilerLastSeen = now;
-      OTdata.rsptype = OTGW_BOILER;
-      // TASK-795 §4.2: a real boiler frame arrived on the PIC bus. If SAT
-      // simulation is active, trip the edge hook (deferred auto-disable).
-      satNotifyBoilerFrameSeen();
-    } else if (buf[0]=='T'){
-      state.otBus.tThermostatLastSeen = now;
-      OTdata.rsptype = OTGW_THERMOSTAT;
-    } else if (buf[0]=='R')    {
-      OTdata.rsptype = OTGW_REQUEST_BOILER;
-    } else if (buf[0]=='A')    {
-      OTdata.rsptype = OTGW_ANSWER_THERMOSTAT;
-    } else if (buf[0]=='E')    {
-      OTdata.rsptype = OTGW_PARITY_ERROR;
-    } 
-
-    //If the Boiler messages have not been seen for 30 seconds, then set the state to false.
-    state.otBus.bBoilerState = (now < (state.otBus.tBoilerLastSeen+30));
-    if ((state.otBus.bBoilerState != bOTGWboilerpreviousstate) || (cntOTmessagesprocessed==1)) {
-      publishBoilerConnectedState();
-      bOTGWboilerpreviousstate = state.otBus.bBoilerState;
-    }
-
-    //If the Thermostat messages have not been seen for 30 seconds, then set the state to false.
-    state.otBus.bThermostatState = (now < (state.otBus.tThermostatLastSeen+30));
-    if ((state.otBus.bThermostatState != bOTGWthermostatpreviousstate) || (cntOTmessagesprocessed==1)){
-      publishThermostatConnectedState();
-      publishHvacMode(false);    // GH #665: re-evaluate hvac_mode/action on thermostat connect/disconnect (off when gone)
-      publishHvacAction(false);
-      bOTGWthermostatpreviousstate = state.otBus.bThermostatState;
-    }
-
-    //OpenTherm is active when at least one side (boiler or thermostat) is communicating on the bus.
-    state.otBus.bOnline = state.otBus.bBoilerState || state.otBus.bThermostatState;
-    if ((state.otBus.bOnline != bOTGWpreviousstate) || (cntOTmessagesprocessed==1)){
-      publishOTGWConnectedState();
-      // nodeMCU online/offline zelf naar 'otgw-firmware/' pushen
-      bOTGWpreviousstate = state.otBus.bOnline; //remember state, so we can detect statechanges
-    }
 
-    //clear ot log buffer
-    ClrLog();
-    // Start log with timestamp
-    AddLog(getOTLogTimestamp());
-    AddLog(" ");
-    
-    //process the OTGW message
-    const char *bufval = buf + 1; //skip the first char
-    uint32_t value = 0;
-    //split 32bit value into the relevant OT protocol parts
-    memset(OTdata.buf, 0, sizeof(OTdata.buf));        // clear buffer
-    memcpy(OTdata.buf, buf, len);                     // copy the raw message to the buffer
-    OTdata.len = len;                                 // set the length of the message  
-    if (sscanf(bufval, "%8x", &value) != 1) return;    // extract the value, abort on parse failure
-    OTdata.value = value;                             // store the value
-    OTdata.type = (value >> 28) & 0x7;                // byte 1 = take 3 bits that define msg msgType
-    OTdata.masterslave = (OTdata.type >> 2) & 0x1;    // MSB from type --> 0 = master and 1 = slave
-    OTdata.id = (value >> 16) & 0xFF;                 // byte 2 = message id 8 bits 
-    OTdata.valueHB = (value >> 8) & 0xFF;             // byte 3 = high byte
-    OTdata.valueLB = value & 0xFF;                    // byte 4 = low byte
-    OTdata.time = millis();                           // time of reception    
-    OTdata.skipthis = false;                          // default: do not skip this message (parity errors only set this true)
-    OTdata.bGatewaySubstituted = false;               // default: not substituted by gateway (ADR-096)
-    OTdata.bAnswerOverride = false;                   // ADR-103: default proxy A (no preceding B)
-
-    if (cntOTmessagesprocessed == 1) {       //first message needs to be put in the buffer
-      // Boot-time one-shot: the very first OT frame has no prior delayed frame to pair
-      // against, so the (B,A) and (T,R) substitution-detection logic below cannot run.
-      // We store the raw frame with bAnswerOverride=false / bGatewaySubstituted=false
-      // initialised above. Worst case: if the first frame happens to be an A that was
-      // already an answer-override on the bus, it would reach _boiler/canonical once;
-      // the next (B,A) pair recomputes correctly and behaviour self-corrects. Bounded,
-      // intentional, one-shot drift — port from dev TASK-665.
-      delayedOTdata = OTdata;       //store current msg
-      OTDebugln(F("delaying first message!"));
-    } else {                              //any other message will be processed
-      // ADR-096 worldview semantics: when the gateway substitutes the bus traffic for an OT id
-      // (T → R on the master-side, or B → A on the slave-side response), the older (delayed)
-      // frame did not reach the *opposite* side. Earlier code marked the older frame as
-      // skipthis=true, which silently dropped the thermostat-side (or boiler-side) value
-      // entirely — the cause of the data-loss bug fixed by ADR-096. We now flag the older
-      // frame as bGatewaySubstituted=true; the publish-time worldview routing in
-      // publishToSourceTopic() then sends the value to the same-side subtopic only and
-      // suppresses canonical / opposite-side publication. The OT-bus log decoration ("<ignored>")
-      // is preserved as a diagnostic marker (see processOT log section).
-      // Pattern detection is unchanged from the original skipthis logic:
-      //   if T (master write) is followed within 500 ms by R (gateway-substituted write)
-      //     → T did not reach the boiler; R replaces it on canonical and /boiler.
-      //   if B (slave response) is followed within 500 ms by A (gateway-substituted answer)
-      //     → A reaches the thermostat instead of B; B still represents boiler-side reality.
-      bool bGatewaySubstituted = (delayedOTdata.id == OTdata.id) && (OTdata.time - delayedOTdata.time < 500) &&
-           (((OTdata.rsptype == OTGW_ANSWER_THERMOSTAT) && (delayedOTdata.rsptype == OTGW_BOILER)) ||
-            ((OTdata.rsptype == OTGW_REQUEST_BOILER) && (delayedOTdata.rsptype == OTGW_THERMOSTAT)));
-
-      //delay message processing by 1 message, to make sure detection of value decoding is done correctly with R and A message.
-      tmpOTdata = delayedOTdata;          //fetch delayed msg
-      delayedOTdata = OTdata;             //store current msg
-      // ADR-103: mark the incoming A (now the delayed frame) as an answer-override A iff a
-      // (B,A) pair was just detected. It rides the struct copy to the cycle that publishes
-      // it. A proxy A (no preceding B) keeps the init default 0 → reaches _boiler/canonical.
-      delayedOTdata.bAnswerOverride = bGatewaySubstituted && (delayedOTdata.rsptype == OTGW_ANSWER_THERMOSTAT);
-      OTdata = tmpOTdata;                 //then process delayed msg
-      OTdata.bGatewaySubstituted = bGatewaySubstituted;  //flag substitution if needed (ADR-096)
-
-      //when parity error in OTGW then skip data to MQTT nor store it local in data object
-      OTdata.skipthis = (OTdata.rsptype == OTGW_PARITY_ERROR);
-
-      //Read information from this OT message ready for use...
-      if (OTdata.id <= OT_MSGID_MAX) {
-        PROGMEM_readAnything (&OTmap[OTdata.id], OTlookupitem);
-      } else {
-        //unknown message id, set safe defaults to prevent OTmap OOB read
-        OTlookupitem.id = OTdata.id;
-        OTlookupitem.msgcmd = OT_UNDEF;
-        OTlookupitem.type = ot_undef;
-        OTlookupitem.label = "Unknown";
-        OTlookupitem.friendlyname = "Unknown";
-        OTlookupitem.unit = "";
-      }
-
-      // TASK-691 / TASK-692 / TASK-693 port (dev TASK-685/686/688): maintain
-      // the six per-msgID bitmaps that describe each side of the OT bus.
-      // Dirty flags fire only on 0->1 transitions so the periodic publishers
-      // (MQTT every minute, file every 15 min) do work exactly once per
-      // newly-discovered (id, direction).
-      {
-        const uint8_t idx  = OTdata.id >> 3;
-        const uint8_t mask = (uint8_t)(1u << (OTdata.id & 7));
-        if (OTdata.masterslave == 0) {
-          // Master frame — track thermostat-side requests.
-          if (OTdata.type == OT_WRITE_DATA) {
-            boilerLastMasterWasWrite[idx] |= mask;
-            if ((thermostatSentWrite[idx] & mask) == 0) {
-              thermostatSentWrite[idx] |= mask;
-              thermostatFileDirty = true;
-            }
-          } else if (OTdata.type == OT_READ_DATA) {
-            boilerLastMasterWasWrite[idx] &= ~mask;
-            if ((thermostatSentRead[idx] & mask) == 0) {
-              thermostatSentRead[idx] |= mask;
-              thermostatFileDirty = true;
-            }
-          }
-        } else {
-          // Slave frame — track boiler-side response classification.
-          if (OTdata.type == OT_READ_ACK) {
-            if ((boilerAckedRead[idx] & mask) == 0) {
-              boilerAckedRead[idx] |= mask;
-              boilerFileDirty = true;
-            }
-          } else if (OTdata.type == OT_WRITE_ACK) {
-            if ((boilerAckedWrite[idx] & mask) == 0) {
-              boilerAckedWrite[idx] |= mask;
-              boilerFileDirty = true;
-            }
-          } else if (OTdata.type == OT_UNKNOWN_DATA_ID) {
-            // Master direction is read from boilerLastMasterWasWrite (set on
-            // the preceding master frame). The slave's type-7 alone doesn't
-            // carry intent.
-            const bool isWriteCtx = (boilerLastMasterWasWrite[idx] & mask) != 0;
-            uint8_t * const bitmap = isWriteCtx ? boilerUnsupportedWrite : boilerUnsupportedRead;
-            if ((bitmap[idx] & mask) == 0) {
-              bitmap[idx] |= mask;
-              boilerUnsupportedDirty = true;  // MQTT republish (1-min cadence)
-              boilerFileDirty        = true;  // file write     (15-min cadence)
-            }
-          }
-        }
-      }
-
-      //keep track of last update time — only for valid responses
-      if (is_value_valid(OTdata, OTlookupitem)) {
-        setMsgLastUpdated(OTdata.id, currentTrackedSeconds());
-      }
-
-      // Queue MQTT HA discovery for this OT message ID if not yet published.
-      // Non-blocking: just sets the pending bit; drainOnePendingDiscovery()
-      // (3-second timer in main loop) handles the actual publish.
-      if (is_value_valid(OTdata, OTlookupitem) && settings.mqtt.bEnable) {
-        if (!getMQTTConfigDone(OTdata.id)) {
-          setMQTTConfigPending(OTdata.id);
-        }
-      }
-
-
-      // Decode and print OpenTherm Gateway Message
-      switch (OTdata.rsptype){
-        case OTGW_BOILER:
-          AddLog("Boiler            ");
-          break;
-        case OTGW_THERMOSTAT:
-          AddLog("Thermostat        ");
-          break;
-        case OTGW_REQUEST_BOILER:
-          AddLog("Request Boiler    ");
-          break;
-        case OTGW_ANSWER_THERMOSTAT:
-          AddLog("Answer Thermostat ");
-          break;
-        case OTGW_PARITY_ERROR:
-          AddLog("Parity Error      ");
-          break;
-        default:
-          AddLog("Unknown           ");
-          break;
-      }
-
-      //print message Type and ID
-      AddLogf(" %s %3d", OTdata.buf, OTdata.id);
-      AddLogf(" %-16s", messageTypeToString(static_cast<OTLibMessageType>(OTdata.type)));
-      //OTDebugf("[%-30s]", messageIDToString(static_cast<OTLibMessageID>(OTdata.id)));
-      //OTDebugf("[M=%d]",OTdata.master);
-
-      //Add indicators for parity error, gateway-substituted frame, or valid value (ADR-096)
-      if (OTdata.rsptype == OTGW_PARITY_ERROR) AddLog("P");
-      else if (OTdata.skipthis || OTdata.bGatewaySubstituted) AddLog("-");
-      else if (is_value_valid(OTdata, OTlookupitem)) AddLog(">");
-      else AddLog(" ");  //placeholder for alignment
-      
-      AddLog(" ");  // Space before payload for readability
-
-      //next step interpret the OT protocol
-      // OTPublishGate RAII: gate closes for this OT slot's throttle decision and
-      // is guaranteed to reopen (restore true) when the scope exits, even on early
-      // return. Non-OT sends (event_report, etc.) that follow are not affected. (ADR-006)
-      // ADR-104 Decision item 7: scope mqttPendingSlot commit to this OT frame.
-      // shouldPublishMQTTForID installs pending; capture the pre-publish success
-      // count, run decodeAndPublishOTValue, then commit if any sendMQTTData
-      // succeeded — else clear the pending so a later unrelated publish cannot
-      // silently commit it.
-      {
-        const uint32_t preSuccessCount = mqttSendSuccessCount;
-        OTPublishGate gate(shouldPublishMQTTForID(OTdata.id, OTdata.masterslave, OTdata.value));
-        decodeAndPublishOTValue();
-        if (mqttPendingSlot.pending) {
-          if (mqttSendSuccessCount > preSuccessCount) confirmMQTTPublishSlot();
-          else                                        mqttPendingSlot.pending = false;
-        }
-      }
-
-      if (OTdata.skipthis || OTdata.bGatewaySubstituted) AddLog(" <ignored> ");
-      // TASK-691 / TASK-692 port (dev TASK-685/686): plain-English direction-
-      // aware suffix on slave Unknown-Data-Id. Emitted on every occurrence so
-      // a tester who opens telnet after the first such frame still sees the
-      // diagnostic context. The same suffix reaches the WebSocket OT Monitor
-      // via the shared ot_log_buffer.
-      if (OTdata.masterslave == 1 && OTdata.type == OT_UNKNOWN_DATA_ID) {
-        const uint8_t idx  = OTdata.id >> 3;
-        const uint8_t mask = (uint8_t)(1u << (OTdata.id & 7));
-        const bool isWriteCtx = (boilerLastMasterWasWrite[idx] & mask) != 0;
-        AddLog(isWriteCtx ? " (boiler rejected write)" : " (boiler does not implement)");
-      }
-      AddLogln();
-      OTDebugT(skipOTLogTimestamp(ot_log_buffer));
-
-      // Send log buffer directly to WebSocket (no JSON, no queue)
-      sendLogToWebSocket(ot_log_buffer);
-
-      // Throttle TCP flush to once per second instead of per-message (~10/sec).
-      // debugTelnet (SimpleTelnet) buffers output; flushing just forces a TCP push.
-      // At 10 msg/sec the per-message flush was the single largest TCP cost.
-      { static unsigned long lastOTFlushMs = 0;
-        unsigned long now = millis();
-        if ((uint32_t)(now - lastOTFlushMs) >= 1000) {
-          OTDebugFlush();
-          lastOTFlushMs = now;
-        }
-      }
-      ClrLog();
-    } 
+  OTRawFrame frame;
+  const OTFrameParseResult parsed = otParseFrame(buf, len, frame);
+  if (parsed != OT_FRAME_NOT_FRAME) {
+    processOTFrame(buf, len, parsed, frame, suppressOutput);
   } else if (buf[2]==':') { //seems to be a response to a command, so check to verify if it was
     checkCommandResponse(buf, len);
     if (buf[0] == 'P' && buf[1] == 'R') {
@@ -4995,13 +3070,7 @@ void processOT(const char *buf, int len, bool suppressOutput){
     OTDebugTf(PSTR("Current firmware type: %s\r\n"), state.pic.sType);
     sendMQTTversioninfo();
     // Banner is the response to PR=A — remove it directly from the command queue
-    for (int qi = 0; qi < cmdQueueSize; qi++) {
-      if (cmdqueue[qi].cmd[0] == 'P' && cmdqueue[qi].cmd[1] == 'R' &&
-          cmdqueue[qi].cmdlen >= 4 && cmdqueue[qi].cmd[3] == 'A') {
-        removeFromCmdQueue(qi);
-        break;
-      }
-    }
+    removeCmdFromQueue('P', 'R', true, 'A');
     { char evtBuf[60]; snprintf_P(evtBuf, sizeof(evtBuf), PSTR("OTGW PIC restarted [%s]"), state.pic.sFwversion); reportOTGWEvent(evtBuf, '*', true); }
 #endif
   } else if (strchr(buf, ',') != nullptr) {
@@ -5110,16 +3179,10 @@ void handlePICSerial()
           if (bytes_write >= 3 && sWrite[2] == '=') {
             lastSer2netCmdMs = millis();
             // Remove matching command from queue to prevent override
-            for (int qi = 0; qi < cmdQueueSize; qi++) {
-              if (cmdqueue[qi].cmd[0] == sWrite[0] && cmdqueue[qi].cmd[1] == sWrite[1]) {
-                // For PR commands, also match the register letter (e.g., ser2net PR=S must not remove PR=O)
-                if (sWrite[0] == 'P' && sWrite[1] == 'R' && bytes_write >= 4 && cmdqueue[qi].cmdlen >= 4) {
-                  if (cmdqueue[qi].cmd[3] != sWrite[3]) continue;
-                }
-                OTDebugTf(PSTR("Ser2net: Removing [%s] from queue (overridden by ser2net)\r\n"), cmdqueue[qi].cmd);
-                removeFromCmdQueue(qi);
-                break;
-              }
+            // For PR commands, also match the register letter (e.g., ser2net PR=S must not remove PR=O)
+            const bool matchReg = (bytes_write >= 4);
+            if (removeCmdFromQueue(sWrite[0], sWrite[1], matchReg, matchReg ? sWrite[3] : 0)) {
+              OTDebugTf(PSTR("Ser2net: Removed [%.2s] from queue (overridden by ser2net)\r\n"), sWrite);
             }
           }
           //check for reset command
@@ -5155,129 +3218,25 @@ void handlePICSerial()
 const char* getOTGWValue(int msgid)
 {
   static char buffer[32];
-  
-  switch (static_cast<OTLibMessageID>(msgid)) { 
-    case OT_TSet:                              dtostrf(OTcurrentSystemState.TSet, 0, 2, buffer); return buffer;
-    case OT_CoolingControl:                    dtostrf(OTcurrentSystemState.CoolingControl, 0, 2, buffer); return buffer;
-    case OT_TsetCH2:                           dtostrf(OTcurrentSystemState.TsetCH2, 0, 2, buffer); return buffer;
-    case OT_TrOverride:                        dtostrf(OTcurrentSystemState.TrOverride, 0, 2, buffer); return buffer;
-    case OT_TrOverride2:                       dtostrf(OTcurrentSystemState.TrOverride2, 0, 2, buffer); return buffer;
-    case OT_MaxRelModLevelSetting:             dtostrf(OTcurrentSystemState.MaxRelModLevelSetting, 0, 2, buffer); return buffer;
-    case OT_TrSet:                             dtostrf(OTcurrentSystemState.TrSet, 0, 2, buffer); return buffer;
-    case OT_TrSetCH2:                          dtostrf(OTcurrentSystemState.TrSetCH2, 0, 2, buffer); return buffer;
-    case OT_RelModLevel:                       dtostrf(OTcurrentSystemState.RelModLevel, 0, 2, buffer); return buffer;
-    case OT_CHPressure:                        dtostrf(OTcurrentSystemState.CHPressure, 0, 2, buffer); return buffer;
-    case OT_DHWFlowRate:                       dtostrf(OTcurrentSystemState.DHWFlowRate, 0, 2, buffer); return buffer;
-    case OT_Tr:                                dtostrf(OTcurrentSystemState.Tr, 0, 2, buffer); return buffer;
-    case OT_Tboiler:                           dtostrf(OTcurrentSystemState.Tboiler, 0, 2, buffer); return buffer;
-    case OT_Tdhw:                              dtostrf(OTcurrentSystemState.Tdhw, 0, 2, buffer); return buffer;
-    case OT_Toutside:                          dtostrf(OTcurrentSystemState.Toutside, 0, 2, buffer); return buffer;
-    case OT_Tret:                              dtostrf(OTcurrentSystemState.Tret, 0, 2, buffer); return buffer;
-    case OT_Tsolarstorage:                     dtostrf(OTcurrentSystemState.Tsolarstorage, 0, 2, buffer); return buffer;
-    case OT_Tsolarcollector:                   dtostrf(OTcurrentSystemState.Tsolarcollector, 0, 2, buffer); return buffer;
-    case OT_TflowCH2:                          dtostrf(OTcurrentSystemState.TflowCH2, 0, 2, buffer); return buffer;
-    case OT_Tdhw2:                             dtostrf(OTcurrentSystemState.Tdhw2, 0, 2, buffer); return buffer;
-    case OT_Texhaust:                          dtostrf(OTcurrentSystemState.Texhaust, 0, 2, buffer); return buffer;
-    case OT_Theatexchanger:                    dtostrf(OTcurrentSystemState.Theatexchanger, 0, 2, buffer); return buffer;
-    case OT_TdhwSet:                           dtostrf(OTcurrentSystemState.TdhwSet, 0, 2, buffer); return buffer;
-    case OT_MaxTSet:                           dtostrf(OTcurrentSystemState.MaxTSet, 0, 2, buffer); return buffer;
-    case OT_Hcratio:                           dtostrf(OTcurrentSystemState.Hcratio, 0, 2, buffer); return buffer;
-    case OT_Remoteparameter4:                  dtostrf(OTcurrentSystemState.Remoteparameter4, 0, 2, buffer); return buffer;
-    case OT_Remoteparameter5:                  dtostrf(OTcurrentSystemState.Remoteparameter5, 0, 2, buffer); return buffer;
-    case OT_Remoteparameter6:                  dtostrf(OTcurrentSystemState.Remoteparameter6, 0, 2, buffer); return buffer;
-    case OT_Remoteparameter7:                  dtostrf(OTcurrentSystemState.Remoteparameter7, 0, 2, buffer); return buffer;
-    case OT_Remoteparameter8:                  dtostrf(OTcurrentSystemState.Remoteparameter8, 0, 2, buffer); return buffer;
-    case OT_OpenThermVersionMaster:            dtostrf(OTcurrentSystemState.OpenThermVersionMaster, 0, 2, buffer); return buffer;
-    case OT_OpenThermVersionSlave:             dtostrf(OTcurrentSystemState.OpenThermVersionSlave, 0, 2, buffer); return buffer;
-    case OT_Statusflags:                       dtostrf(OTcurrentSystemState.Statusflags, 0, 2, buffer); return buffer;
-    case OT_ASFflags:                          dtostrf(OTcurrentSystemState.ASFflags, 0, 2, buffer); return buffer;
-    case OT_MasterConfigMemberIDcode:          dtostrf(OTcurrentSystemState.MasterConfigMemberIDcode, 0, 2, buffer); return buffer;
-    case OT_SlaveConfigMemberIDcode:           dtostrf(OTcurrentSystemState.SlaveConfigMemberIDcode, 0, 2, buffer); return buffer;
-    case OT_Command:                           dtostrf(OTcurrentSystemState.Command, 0, 2, buffer); return buffer;
-    case OT_RBPflags:                          dtostrf(OTcurrentSystemState.RBPflags, 0, 2, buffer); return buffer;
-    case OT_TSP:                               dtostrf(OTcurrentSystemState.TSP, 0, 2, buffer); return buffer;
-    case OT_TSPindexTSPvalue:                  dtostrf(OTcurrentSystemState.TSPindexTSPvalue, 0, 2, buffer); return buffer;
-    case OT_FHBsize:                           dtostrf(OTcurrentSystemState.FHBsize, 0, 2, buffer); return buffer;
-    case OT_FHBindexFHBvalue:                  dtostrf(OTcurrentSystemState.FHBindexFHBvalue, 0, 2, buffer); return buffer;
-    case OT_MaxCapacityMinModLevel:            dtostrf(OTcurrentSystemState.MaxCapacityMinModLevel, 0, 2, buffer); return buffer;
-    case OT_DayTime:                           dtostrf(OTcurrentSystemState.DayTime, 0, 2, buffer); return buffer;
-    case OT_Date:                              dtostrf(OTcurrentSystemState.Date, 0, 2, buffer); return buffer;
-    case OT_Year:                              dtostrf(OTcurrentSystemState.Year, 0, 2, buffer); return buffer;
-    case OT_TdhwSetUBTdhwSetLB:                dtostrf(OTcurrentSystemState.TdhwSetUBTdhwSetLB, 0, 2, buffer); return buffer;
-    case OT_MaxTSetUBMaxTSetLB:                dtostrf(OTcurrentSystemState.MaxTSetUBMaxTSetLB, 0, 2, buffer); return buffer;
-    case OT_HcratioUBHcratioLB:                dtostrf(OTcurrentSystemState.HcratioUBHcratioLB, 0, 2, buffer); return buffer;
-    case OT_Remoteparameter4boundaries:        dtostrf(OTcurrentSystemState.Remoteparameter4boundaries, 0, 2, buffer); return buffer;
-    case OT_Remoteparameter5boundaries:        dtostrf(OTcurrentSystemState.Remoteparameter5boundaries, 0, 2, buffer); return buffer;
-    case OT_Remoteparameter6boundaries:        dtostrf(OTcurrentSystemState.Remoteparameter6boundaries, 0, 2, buffer); return buffer;
-    case OT_Remoteparameter7boundaries:        dtostrf(OTcurrentSystemState.Remoteparameter7boundaries, 0, 2, buffer); return buffer;
-    case OT_Remoteparameter8boundaries:        dtostrf(OTcurrentSystemState.Remoteparameter8boundaries, 0, 2, buffer); return buffer;
-    case OT_RemoteOverrideFunction:            dtostrf(OTcurrentSystemState.RemoteOverrideFunction, 0, 2, buffer); return buffer;
-    case OT_OEMDiagnosticCode:                 dtostrf(OTcurrentSystemState.OEMDiagnosticCode, 0, 2, buffer); return buffer;
-    case OT_BurnerStarts:                      dtostrf(OTcurrentSystemState.BurnerStarts, 0, 2, buffer); return buffer;
-    case OT_CHPumpStarts:                      dtostrf(OTcurrentSystemState.CHPumpStarts, 0, 2, buffer); return buffer;
-    case OT_DHWPumpValveStarts:                dtostrf(OTcurrentSystemState.DHWPumpValveStarts, 0, 2, buffer); return buffer;
-    case OT_DHWBurnerStarts:                   dtostrf(OTcurrentSystemState.DHWBurnerStarts, 0, 2, buffer); return buffer;
-    case OT_BurnerOperationHours:              dtostrf(OTcurrentSystemState.BurnerOperationHours, 0, 2, buffer); return buffer;
-    case OT_CHPumpOperationHours:              dtostrf(OTcurrentSystemState.CHPumpOperationHours, 0, 2, buffer); return buffer;
-    case OT_DHWPumpValveOperationHours:        dtostrf(OTcurrentSystemState.DHWPumpValveOperationHours, 0, 2, buffer); return buffer;
-    case OT_DHWBurnerOperationHours:           dtostrf(OTcurrentSystemState.DHWBurnerOperationHours, 0, 2, buffer); return buffer;
-    case OT_Brand:                             dtostrf(OTcurrentSystemState.Brand, 0, 2, buffer); return buffer;
-    case OT_BrandVersion:                      dtostrf(OTcurrentSystemState.BrandVersion, 0, 2, buffer); return buffer;
-    case OT_BrandSerialNumber:                 dtostrf(OTcurrentSystemState.BrandSerialNumber, 0, 2, buffer); return buffer;
-    case OT_CoolingOperationHours:             dtostrf(OTcurrentSystemState.CoolingOperationHours, 0, 2, buffer); return buffer;
-    case OT_PowerCycles:                       dtostrf(OTcurrentSystemState.PowerCycles, 0, 2, buffer); return buffer;
-    case OT_MasterVersion:                     dtostrf(OTcurrentSystemState.MasterVersion, 0, 2, buffer); return buffer;
-    case OT_SlaveVersion:                      dtostrf(OTcurrentSystemState.SlaveVersion, 0, 2, buffer); return buffer;
-    case OT_StatusVH:                          dtostrf(OTcurrentSystemState.StatusVH, 0, 2, buffer); return buffer;
-    case OT_ControlSetpointVH:                 dtostrf(OTcurrentSystemState.ControlSetpointVH, 0, 2, buffer); return buffer;
-    case OT_ASFFaultCodeVH:                    dtostrf(OTcurrentSystemState.ASFFaultCodeVH, 0, 2, buffer); return buffer;
-    case OT_DiagnosticCodeVH:                  dtostrf(OTcurrentSystemState.DiagnosticCodeVH, 0, 2, buffer); return buffer;
-    case OT_ConfigMemberIDVH:                  dtostrf(OTcurrentSystemState.ConfigMemberIDVH, 0, 2, buffer); return buffer;
-    case OT_OpenthermVersionVH:                dtostrf(OTcurrentSystemState.OpenthermVersionVH, 0, 2, buffer); return buffer;
-    case OT_VersionTypeVH:                     dtostrf(OTcurrentSystemState.VersionTypeVH, 0, 2, buffer); return buffer;
-    case OT_RelativeVentilation:               dtostrf(OTcurrentSystemState.RelativeVentilation, 0, 2, buffer); return buffer;
-    case OT_RelativeHumidityExhaustAir:        dtostrf(OTcurrentSystemState.RelativeHumidityExhaustAir, 0, 2, buffer); return buffer;
-    case OT_CO2LevelExhaustAir:                dtostrf(OTcurrentSystemState.CO2LevelExhaustAir, 0, 2, buffer); return buffer;
-    case OT_SupplyInletTemperature:            dtostrf(OTcurrentSystemState.SupplyInletTemperature, 0, 2, buffer); return buffer;
-    case OT_SupplyOutletTemperature:           dtostrf(OTcurrentSystemState.SupplyOutletTemperature, 0, 2, buffer); return buffer;
-    case OT_ExhaustInletTemperature:           dtostrf(OTcurrentSystemState.ExhaustInletTemperature, 0, 2, buffer); return buffer;
-    case OT_ExhaustOutletTemperature:          dtostrf(OTcurrentSystemState.ExhaustOutletTemperature, 0, 2, buffer); return buffer;
-    case OT_ActualExhaustFanSpeed:             dtostrf(OTcurrentSystemState.ActualExhaustFanSpeed, 0, 2, buffer); return buffer;
-    case OT_ActualSupplyFanSpeed:              dtostrf(OTcurrentSystemState.ActualSupplyFanSpeed, 0, 2, buffer); return buffer;
-    case OT_RemoteParameterSettingVH:          dtostrf(OTcurrentSystemState.RemoteParameterSettingVH, 0, 2, buffer); return buffer;
-    case OT_NominalVentilationValue:           dtostrf(OTcurrentSystemState.NominalVentilationValue, 0, 2, buffer); return buffer;
-    case OT_TSPNumberVH:                       dtostrf(OTcurrentSystemState.TSPNumberVH, 0, 2, buffer); return buffer;
-    case OT_TSPEntryVH:                        dtostrf(OTcurrentSystemState.TSPEntryVH, 0, 2, buffer); return buffer;
-    case OT_FaultBufferSizeVH:                 dtostrf(OTcurrentSystemState.FaultBufferSizeVH, 0, 2, buffer); return buffer;
-    case OT_FaultBufferEntryVH:                dtostrf(OTcurrentSystemState.FaultBufferEntryVH, 0, 2, buffer); return buffer;
-    case OT_FanSpeed:                          dtostrf(OTcurrentSystemState.FanSpeed, 0, 2, buffer); return buffer;
-    case OT_ElectricalCurrentBurnerFlame:      dtostrf(OTcurrentSystemState.ElectricalCurrentBurnerFlame, 0, 2, buffer); return buffer;
-    case OT_TRoomCH2:                          dtostrf(OTcurrentSystemState.TRoomCH2, 0, 2, buffer); return buffer;
-    case OT_RelativeHumidity:                  dtostrf(OTcurrentSystemState.RelativeHumidity, 0, 2, buffer); return buffer;
-    case OT_RFstrengthbatterylevel:            dtostrf(OTcurrentSystemState.RFstrengthbatterylevel, 0, 2, buffer); return buffer;
-    case OT_OperatingMode_HC1_HC2_DHW:         dtostrf(OTcurrentSystemState.OperatingMode_HC1_HC2_DHW, 0, 2, buffer); return buffer;
-    case OT_ElectricityProducerStarts:         dtostrf(OTcurrentSystemState.ElectricityProducerStarts, 0, 2, buffer); return buffer;
-    case OT_ElectricityProducerHours:          dtostrf(OTcurrentSystemState.ElectricityProducerHours, 0, 2, buffer); return buffer;
-    case OT_ElectricityProduction:             dtostrf(OTcurrentSystemState.ElectricityProduction, 0, 2, buffer); return buffer;
-    case OT_CumulativeElectricityProduction:   dtostrf(OTcurrentSystemState.CumulativeElectricityProduction, 0, 2, buffer); return buffer;
-    case OT_BurnerUnsuccessfulStarts:          dtostrf(OTcurrentSystemState.BurnerUnsuccessfulStarts, 0, 2, buffer); return buffer;
-    case OT_FlameSignalTooLow:                 dtostrf(OTcurrentSystemState.FlameSignalTooLow, 0, 2, buffer); return buffer;
-    case OT_RemehadFdUcodes:                   dtostrf(OTcurrentSystemState.RemehadFdUcodes, 0, 2, buffer); return buffer;
-    case OT_RemehaServicemessage:              dtostrf(OTcurrentSystemState.RemehaServicemessage, 0, 2, buffer); return buffer;
-    case OT_RemehaDetectionConnectedSCU:       dtostrf(OTcurrentSystemState.RemehaDetectionConnectedSCU, 0, 2, buffer); return buffer;
-    case OT_SolarStorageMaster:                dtostrf(OTcurrentSystemState.SolarStorageStatus, 0, 2, buffer); return buffer;
-    case OT_SolarStorageASFflags:              dtostrf(OTcurrentSystemState.SolarStorageASFflags, 0, 2, buffer); return buffer;
-    case OT_SolarStorageSlaveConfigMemberIDcode:  dtostrf(OTcurrentSystemState.SolarStorageSlaveConfigMemberIDcode, 0, 2, buffer); return buffer;
-    case OT_SolarStorageVersionType:           dtostrf(OTcurrentSystemState.SolarStorageVersionType, 0, 2, buffer); return buffer;
-    case OT_SolarStorageTSP:                   dtostrf(OTcurrentSystemState.SolarStorageTSP, 0, 2, buffer); return buffer;
-    case OT_SolarStorageTSPindexTSPvalue:      dtostrf(OTcurrentSystemState.SolarStorageTSPindexTSPvalue, 0, 2, buffer); return buffer;
-    case OT_SolarStorageFHBsize:               dtostrf(OTcurrentSystemState.SolarStorageFHBsize, 0, 2, buffer); return buffer;
-    case OT_SolarStorageFHBindexFHBvalue:      dtostrf(OTcurrentSystemState.SolarStorageFHBindexFHBvalue, 0, 2, buffer); return buffer;
-    default: 
-      strncpy_P(buffer, PSTR("Error: not implemented yet!\r\n"), sizeof(buffer) - 1);
-      buffer[sizeof(buffer) - 1] = '\0';
+
+  if (msgid >= 0 && msgid < OTD_TABLE_SIZE) {
+    OTDispatchEntry d;
+    PROGMEM_readAnything(&OTDispatch.e[msgid], d);
+    if (d.flags & OTD_FLAG_DEFINED) {
+      const void *field = otDispatchField(d);
+      double v;
+      switch (d.fieldKind) {
+        case OTFIELD_FLOAT: v = *static_cast<const float *>(field);    break;
+        case OTFIELD_S16:   v = *static_cast<const int16_t *>(field);  break;
+        default:            v = *static_cast<const uint16_t *>(field); break;
+      }
+      dtostrf(v, 0, 2, buffer);
       return buffer;
-  } // switch
+    }
+  }
+  strncpy_P(buffer, PSTR("Error: not implemented yet!\r\n"), sizeof(buffer) - 1);
+  buffer[sizeof(buffer) - 1] = '\0';
+  return buffer;
 } // getOTGWValue
 
 void startPICStream()
@@ -5706,6 +3665,11 @@ void refreshpic(String filename, String version) {
             f.close();
             OTDebugTln(F("Update successful"));
           }
+          // The row image of the previous download no longer matches; the
+          // next upgrade compiles a new one (OTGWSerial would reject it anyway)
+          String imgfile = hexpath;
+          imgfile.replace(".hex", ".img");
+          LittleFS.remove(imgfile);
         }
       }
     }
@@ -5874,6 +3838,8 @@ void upgradepic(AsyncWebServerRequest *request) {
     if (ext) {
       strlcpy(ext, ".ver", sizeof(path) - (ext - path));
       LittleFS.remove(path);
+      strlcpy(ext, ".img", sizeof(path) - (ext - path));
+      LittleFS.remove(path);
     }
   }
   webPushHeader(F("Location"), F("index.html#tabPICflash"));
@@ -36,12 +36,23 @@ extern AsyncSimpleTelnet<1> debugTelnet;   // defined in networkStuff.ino
 // OTDirecttypes.h must follow boards.h because its contents are gated on HAS_DIRECT_OT (ADR-079).
 #include "OTDirecttypes.h"
 #include "OTGWLogMacros.h"
+#include "OTLogTimestamp.h"      // cached-offset HH:MM:SS.uuuuuu formatter for getOTLogTimestamp()
 #if HAS_PIC
 #include <OTGWSerial.h>         // Schelte Bron's Serial class - it upgrades and more
 #endif
 #include "OTGW-Core.h"          // Core code for this firmware
+#include "MQTTTopicIntern.h"    // pre-rendered OT value topics, built at MQTT connect
+#include "MQTTPublishBatch.h"   // one gate check per decoded OT frame (publish window)
+#include "MQTTPublishDedup.h"   // drop unchanged value payloads until the heartbeat
 #include <OneWire.h>            // required for Dallas sensor library
 #include <DallasTemperature.h>  // Miles Burton's - Arduino Dallas library
+#include "DallasSweep.h"        // scratchpad checks + per-probe read counters for the sensor task
+#include "LoopProfile.h"        // per-section loop-task timing histograms (REST /debug, telnet 'L')
+#include "OTWsBinary.h"         // compact binary OT frame records for /ws binary-mode clients
+#include "OTHistory.h"          // compressed 1s/1m/15m graph history (historyStuff.ino, /api/v2/history)
+#include "OTmonDelta.h"         // change generations + ETag token for /api/v2/otgw/otmonitor?since=
+#include "SseEvents.h"          // topics + send gates for the /api/v2/events stream (sseStuff.ino)
+#include "AssetEncoding.h"      // Accept-Encoding / ETag negotiation for the .gz web assets (FSexplorer.ino)
 
 // Legacy pin aliases — map old names to boards.h constants so existing code
 // (and any user forks) keeps compiling without search-and-replace churn.
@@ -105,6 +116,7 @@ void loopOTDirect();
 void handleOTDirectBridgeStream();
 void handleOTDirectCommand(const char* buf, int len);
 void sendOTDirectOverridesJSON();
+void sendOTDirectScheduleJSON();
 void sendPICSerial(const char* buf, int len);
 bool otDirectBoilerPresent();  // TASK-795 §4.2: real boiler answered MsgID 3 (excludes loopback)
 // TASK-183: PI room compensation
@@ -193,6 +205,11 @@ bool canSendWebSocket();
 bool canPublishMQTT();
 void logHeapStats();
 void emergencyHeapRecovery();
+// OT log timestamp (helperStuff.ino): drop the cached UTC offset after the
+// timezone setting changes so the next frame re-resolves the zone.
+const char* getOTLogTimestamp();
+uint32_t getOTLogMsOfDay();        // same clock, local ms since midnight (binary WS stream)
+void invalidateOTLogTimestampZone();
 // Status-frame burst quiesce (TASK-342): suppress MQTT discovery drip during
 // Status sub-topic fanout so allocation peaks do not stack.
 // Post-burst cooldown (TASK-347): hold drip for STATUS_BURST_COOLDOWN_MS after
@@ -230,6 +247,11 @@ extern uint32_t mqttSendSuccessCount;
 void sendMQTTDataPic(const __FlashStringHelper* label, const char* value);
 void sendMQTTDataPic(const __FlashStringHelper* label, const __FlashStringHelper* value);
 void publishToSourceTopic(const char*, const char*, byte);
+// OT value publishers: same contract as sendMQTTData()/publishToSourceTopic(),
+// but the topic is "<OTmap label><suffix>" for msgId and comes pre-rendered
+// from the MQTTTopicIntern.h table. Topics outside the table are composed.
+bool sendMQTTDataForId(uint8_t msgId, uint8_t suffix, const char* json, const bool = false);
+void publishToSourceTopicForId(uint8_t msgId, uint8_t suffix, const char* json, byte rsptype);
 void loopMQTTDiscovery();
 // ADR-106: topic-naming-mode cleanup helpers (defined in MQTTstuff.ino).
 void armTopicCleanupOnLegacyToggle(bool newUseLegacy);
@@ -255,6 +277,7 @@ void loadOtSupportFiles();                 // read /ot-thermo.json and /ot-boile
 void saveOtSupportFilesIfDirty();          // 15-min debounced atomic write
 void doMqttDisconnect();                 // graceful disconnect for reboot path (MQTTclient is file-static)
 void doWebSocketClose();                 // close all WS clients before reboot (otLogWs not extern'd in any header)
+bool doEventStreamClose();               // close all /api/v2/events clients (sources live in sseStuff.ino)
 void doRestart(const char* reason);      // canonical reboot path: flushSettings + prepareForReboot + ESP.restart
 // MQTT discovery verification (ADR-062, TASK-349): state machine lives in
 // mqtt_discovery_verify.cpp as of TASK-363; public API in that file's header.
@@ -268,6 +291,19 @@ uint16_t countPendingDiscoveryIds();
 bool     discoveryDripHeapHealthy();   // ADR-170: drip's own restore predicate, reused by the daily auto-heal
 void     incPublishedTopicCount();    // called by streaming helpers in MQTTHaDiscovery.cpp (ADR-044 shim)
 void sendLogToWebSocket(const char* logMessage);
+// Per-frame OT log (webSocketStuff.ino): text line to text-mode clients,
+// OTWsBinary.h record to clients that asked for the binary stream.
+bool hasWebSocketTextClients();
+bool hasWebSocketBinaryClients();
+void sendOTFrameLogToWebSocket(const char* logLine);
+void sendOTFrameToWebSocketBinary(char source, uint8_t flags, uint32_t frame);
+// Graph history (historyStuff.ino).
+void     startHistory();
+void     historySample();
+void     historySpillHourly();
+void     historySpillAll();
+bool     historySnapshot(OTHistSnap &snap, bool pickTier);
+uint32_t historyTierBytes(uint8_t tier);
 
 // Forward declarations for functions defined in later .ino files
 // (Arduino auto-prototype generation can fail for these)
@@ -292,6 +328,8 @@ void escapeJsonStringTo(const char* src, char* dest, size_t destSize);
 void GetVersion(const char* hexfile, char* version, size_t destSize);
 void startWebSocket();
 void handleWebSocket();
+void startEventStream();
+void handleEventStream();
 void handleDebug();
 void startPICStream();
 void stopPICStream();
@@ -374,6 +412,7 @@ bool satBoilerHardwarePresent();  // TASK-795 plan §4.2: real boiler on bus (RE
 void satSetDebugForceBoilerPresent(bool on);  // TASK-802 F7-A: test-only boiler-present override (trips §4.2 edge, transient)
 bool satSimInjectEvent(const char* event, float value, int32_t durationS);  // TASK-797 plan §12 F2: scenario injection
 void satSendStatusJSON();
+bool satRenderStatus(JsonEmit& je);       // same document into any sink, for the "sat" event (sseStuff.ino)
 uint32_t satCycleGetFlameOnStartMs();
 uint32_t satCycleGetFlameOffStartMs();
 bool    satCycleIsHourLimitReached();
@@ -502,6 +541,7 @@ struct OTGWState {
 };
 
 OTGWState state;
+LoopProfile loopProfile;   // loop-task section timings; written by the loop task only
 
 // Central PIC availability guard — returns true when a PIC is available.
 // Set at boot by detectPIC() and can flip true at runtime if a PIC banner is received.
@@ -827,20 +867,26 @@ const char *flashMode[]    { "QIO", "QOUT", "DIO", "DOUT", "Unknown" };
 byte      OTGWdallasdataid = 246;                // foney dataid for temp sensor autoconfigure
 int       DallasrealDeviceCount = 0;             // Total temperature devices found on the bus
 bool      bSensorsDetected = false;              // Runtime: true when sensors initialized this boot
+uint32_t  DallasSweepMs = 0;                     // Last sensor-task sweep, convert to last scratchpad read
+uint32_t  DallasSweepOverruns = 0;               // Polls that found the previous sweep still running
 #define   MAXDALLASDEVICES 16                    // maximum number of devices on the bus
 
-// Define structure to store temperature device addresses found on bus with their latest tempC value
+// Define structure to store temperature device addresses found on bus with their latest tempC value.
+// Loop-owned: the sensor task reads into its own slots and pollSensors() copies them in.
 struct
 {
   int id;
   DeviceAddress addr;
+  char addrStr[17];         // getDallasAddress(addr), cached at init / on a legacy-format change
   float tempC;
   time_t lasttime;
+  DallasReadStats stats;    // scratchpad reads, CRC errors, misses, read time (REST /sensors)
 } DallasrealDevice[MAXDALLASDEVICES];
 // prototype to allow use in restAPI.ino
 char* getDallasAddress(DeviceAddress deviceAddress);
 // forward declarations — defined in sensors_ext.ino (concatenated after handleDebug.ino)
 void pollSensors();
+void refreshDallasAddressCache();
 // forward declarations — defined in s0PulseCount.ino (concatenated after OTGW-firmware.ino)
 void initS0Count();
 void sendS0Counters();
@@ -293,6 +293,7 @@ void setup() {
   readSettings(true);
   checklittlefshash();
   loadOtSupportFiles();  // TASK-693 port: warm the in-RAM support bitmaps from prior-boot knowledge
+  startHistory();        // graph history store, 1m/15m tiers restored from LittleFS
 
   // Set hostname ASAP after loading settings.  WiFi.persistent(true) from a
   // previous boot lets the SDK auto-connect before startWiFi() is reached;
@@ -674,6 +675,7 @@ void doTaskEvery1s(){
   handleCommandQueue(); //just check if there are commands to retry
   state.uptime.iSeconds++;
   sampleHeapWatermark();   // TASK-934: 1 Hz maxBlock min-watermark + histogram
+  historySample();         // graph history: one sample per metric, drains a pending spill
 
   // LED status indicators (evaluated every 1s):
   //   No WiFi          → LED2 blinks 1x/s, LED1 off
@@ -831,6 +833,7 @@ void doTaskMinuteChanged(){
   if (hourFlag) {
     runNightlyRestartCheck();     // TASK-345: moved from doTaskEvery60s
     sendMQTTheapdiag();            // TASK-346: moved from doTaskEvery60s
+    historySpillHourly();          // graph history to LittleFS, one metric per second
   }
 
   // Daily consumers (TASK-351).
@@ -919,6 +922,9 @@ static void handlePicFlashBackgroundTasks()
 
 
 //===[ Do the background tasks ]===
+// LoopProfile.h clock.
+uint32_t loopProfNowUs() { return (uint32_t)micros(); }
+
 void doBackgroundTasks()
 {
   feedWatchDog();               // Feed the dog before it bites!
@@ -935,9 +941,9 @@ void doBackgroundTasks()
   // completes while the upload is still in progress, WIFI_RECONNECTED calls
   // startWebSocket()/startMQTT(), potentially tearing down the HTTP connection
   // carrying the OTA data and leaving the LittleFS partition partially written.
-  if (!isFlashing()) loopWifi();
+  if (!isFlashing()) LOOP_PROFILED(LPS_NETWORK, loopWifi());
 #if defined(HAS_ETH_CAPABLE) && HAS_ETH_CAPABLE
-  if (!isFlashing()) loopEthernet();   // W5500 link-poll + WiFi↔Ethernet failover (every 5s)
+  if (!isFlashing()) LOOP_PROFILED(LPS_NETWORK, loopEthernet());   // W5500 link-poll + WiFi↔Ethernet failover (every 5s)
 #endif
 
   // Check for critically low heap and attempt recovery if needed
@@ -952,14 +958,14 @@ void doBackgroundTasks()
       handlePicFlashBackgroundTasks();
     } else {
       //while connected handle everything that uses network stuff
-      handleDebug();
-      handleOTGWstream();          // OTGW serial bridge on TCP port 25238
-      handleMQTT();                 // MQTT transmissions
-      handlePICSerial();            // OTGW/PIC handling
+      LOOP_PROFILED(LPS_TELNET, handleDebug(); handleOTGWstream()); // debug telnet + OTGW serial bridge on TCP port 25238
+      LOOP_PROFILED(LPS_MQTT, handleMQTT());                         // MQTT transmissions
+      LOOP_PROFILED(LPS_PIC_SERIAL, handlePICSerial());              // OTGW/PIC handling
 #if HAS_DIRECT_OT
       // Run the OT-direct engine only when the OT-direct hardware is active
       // (guards against a degraded init on the fixed OTGW32).
       if (isOTDirectEnabled()) {
+        LoopProfScope _prof(loopProfile, LPS_OTDIRECT);
         handleOTDirectBridgeStream(); // OTGW32/TCP 25238 command bridge
         loopOTDirect();               // OT-direct GPIO poll
       }
@@ -970,7 +976,13 @@ void doBackgroundTasks()
       // timer rather than every loop turn.
       {
         DECLARE_TIMER_SEC(timerWsHousekeeping, 1, SKIP_MISSED_TICKS);
-        if (DUE(timerWsHousekeeping)) handleWebSocket();
+        if (DUE(timerWsHousekeeping)) LOOP_PROFILED(LPS_WEBSOCKET, handleWebSocket());
+      }
+      // /api/v2/events: render and push the due topics (coalesced, at most
+      // SSE_MAX_EVENTS_PER_SEC per topic). Cheap when no client is connected.
+      {
+        DECLARE_TIMER_MS(timerEventStream, 100, SKIP_MISSED_TICKS);
+        if (DUE(timerEventStream)) LOOP_PROFILED(LPS_EVENTS, handleEventStream());
       }
       // TASK-865.9: HTTP serving moved onto the AsyncTCP service task — there is
       // no longer a per-loop handleClient() drain. The sat-slider stall / XHR
@@ -979,7 +991,7 @@ void doBackgroundTasks()
     #if MDNS_NEEDS_UPDATE
   MDNS.update();
 #endif
-      loopNTP();
+      LOOP_PROFILED(LPS_NTP, loopNTP());
     }
   } //otherwise, just wait until reconnected gracefully
   yield();
@@ -1006,6 +1018,7 @@ void loop()
     }
     s_lastLoopMs = nowMs;
   }
+  LoopProfScope loopScope(loopProfile, LPS_LOOP);   // whole body; per-section scopes below
 
 
   DECLARE_TIMER_SEC(timer1s,   1,   SKIP_MISSED_TICKS);
@@ -1017,14 +1030,14 @@ void loop()
 
   if (!isFlashing()) {
     // Only run these tasks when NOT flashing firmware (ESP or PIC)
-    if (DUE(timerFlushSettings))      flushSettings();  // coalesced settings write + service restarts
-    if (DUE(timerpollsensor))         pollSensors();    // poll the temperature sensors connected to 2wire gpio pin
-    if (DUE(timers0counter))          sendS0Counters(); // poll the s0 counter connected to gpio pin when due
-    if (DUE(timer15min))              do15minevent();   // TASK-693 port: persist /ot-thermo.json + /ot-boiler.json
-    if (DUE(timer5min))               do5minevent();
-    if (DUE(timer60s))                doTaskEvery60s();
-    if (DUE(timer3s))                 doTaskEvery3s();
-    if (DUE(timer1s))                 doTaskEvery1s();
+    if (DUE(timerFlushSettings))      LOOP_PROFILED(LPS_SETTINGS, flushSettings());  // coalesced settings write + service restarts
+    if (DUE(timerpollsensor))         LOOP_PROFILED(LPS_SENSORS, pollSensors());     // poll the temperature sensors connected to 2wire gpio pin
+    if (DUE(timers0counter))          LOOP_PROFILED(LPS_S0, sendS0Counters());       // poll the s0 counter connected to gpio pin when due
+    if (DUE(timer15min))              LOOP_PROFILED(LPS_TIMERS, do15minevent());     // TASK-693 port: persist /ot-thermo.json + /ot-boiler.json
+    if (DUE(timer5min))               LOOP_PROFILED(LPS_TIMERS, do5minevent());
+    if (DUE(timer60s))                LOOP_PROFILED(LPS_TIMERS, doTaskEvery60s());
+    if (DUE(timer3s))                 LOOP_PROFILED(LPS_TIMERS, doTaskEvery3s());
+    if (DUE(timer1s))                 LOOP_PROFILED(LPS_TIMERS, doTaskEvery1s());
     if (DUE(timer500ms)) {
       // LED2 fast blink (2x/s) when WiFi is up but no OT traffic for >10s
       bool noOT = (WiFi.status() == WL_CONNECTED) &&
@@ -1035,19 +1048,22 @@ void loop()
         setLed(LED2, _led2Fast ? ON : OFF);
       }
     }
-    if (minuteChanged())              doTaskMinuteChanged(); //ADR-086: sole minuteChanged() caller; hour/day/year dispatch lives inside
-    loopMQTTDiscovery();              // async MQTT discovery drip (self-timed, 2s normal / 10s slow)
-    runTopicCleanupStep();            // ADR-106: drain stale-mode discovery topics after bUseLegacyOtTopics toggle
-    evalOutputs();                    // when the bits change, the output gpio bit will follow
-    evalWebhook();                    // when the trigger bit changes, fire the webhook
-    satControlLoop();                 // SAT thermostat control loop (timer-guarded internally)
-    satBLELoop();                     // BLE temperature sensor scan (timer-guarded, Task #20). TASK-742: no-op stub on ESP8266.
-    weatherLoop();                    // Weather data fetch (timer-guarded, Task #50)
+    if (minuteChanged())              LOOP_PROFILED(LPS_TIMERS, doTaskMinuteChanged()); //ADR-086: sole minuteChanged() caller; hour/day/year dispatch lives inside
+    LOOP_PROFILED(LPS_DISCOVERY,
+      loopMQTTDiscovery();            // async MQTT discovery drip (self-timed, 2s normal / 10s slow)
+      runTopicCleanupStep());         // ADR-106: drain stale-mode discovery topics after bUseLegacyOtTopics toggle
+    LOOP_PROFILED(LPS_OUTPUTS,
+      evalOutputs();                  // when the bits change, the output gpio bit will follow
+      evalWebhook());                 // when the trigger bit changes, fire the webhook
+    LOOP_PROFILED(LPS_SAT, satControlLoop());         // SAT thermostat control loop (timer-guarded internally)
+    LOOP_PROFILED(LPS_SAT_BLE, satBLELoop());         // BLE temperature sensor scan (timer-guarded, Task #20). TASK-742: no-op stub on ESP8266.
+    LOOP_PROFILED(LPS_WEATHER, weatherLoop());        // Weather data fetch (timer-guarded, Task #50)
 #if HAS_PIC
-    handlePendingUpgrade();           // Check if we need to start an upgrade
-    handlePendingPicHttp();           // TASK-865.14: run deferred PIC update-check/refresh outbound HTTP off the AsyncTCP task
+    LOOP_PROFILED(LPS_PIC_UPGRADE,
+      handlePendingUpgrade();         // Check if we need to start an upgrade
+      handlePendingPicHttp());        // TASK-865.14: run deferred PIC update-check/refresh outbound HTTP off the AsyncTCP task
 #endif
-    loopOLED();                       // OLED display refresh and button handling (no-op if no OLED detected)
+    LOOP_PROFILED(LPS_OLED, loopOLED());              // OLED display refresh and button handling (no-op if no OLED detected)
   }
 
   doBackgroundTasks();              // run background tasks
@@ -1057,7 +1073,7 @@ void loop()
   // frames; drain them HERE (loop() proper) — never inside doBackgroundTasks(),
   // which re-enters via doAutoConfigure's file-reading loop and could nest the
   // OTStateLock. processOT() runs from loop() context (not a task) in Phase 1.
-  drainOTFrameQueue();
+  LOOP_PROFILED(LPS_OT_DRAIN, drainOTFrameQueue());
 
   // TASK-396: heap watermark tick + deferred-reboot gate. The watermark runs
   // every loop so slow leaks are visible in the minHeap field of the boot
@@ -14,6 +14,8 @@ extern char ot_log_buffer[OT_LOG_BUFFER_SIZE];
 extern size_t ot_log_pos;
 
 #define ClrLog()            ({ ot_log_buffer[0] = '\0'; ot_log_pos = 0; })
+// Empty buffer that every Add* below skips, until the next ClrLog(): no formatting cost.
+#define MuteLog()           ({ ot_log_buffer[0] = '\0'; ot_log_pos = OT_LOG_BUFFER_SIZE - 1; })
 #define AddLogf(fmt, ...)   ({ if (ot_log_pos < (OT_LOG_BUFFER_SIZE - 1)) { \
                                  int _w = snprintf(ot_log_buffer + ot_log_pos, OT_LOG_BUFFER_SIZE - ot_log_pos, fmt, ##__VA_ARGS__); \
                                  if (_w > 0) { size_t _rem = OT_LOG_BUFFER_SIZE - 1 - ot_log_pos; ot_log_pos += ((size_t)_w < _rem) ? (size_t)_w : _rem; } \
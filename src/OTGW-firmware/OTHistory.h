@@ -0,0 +1,373 @@
+/*
+***************************************************************************
+**  Program  : OTHistory.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Fixed-memory time-series store for the dashboard graphs: flow, return
+**  and room temperature, room and control setpoint, modulation, CH
+**  pressure and flame, sampled once a second (historyStuff.ino) and served
+**  by GET /api/v2/history, so a freshly opened graph starts with the last
+**  day instead of empty.
+**
+**  Three tiers per metric, each a ring of fixed 64-byte blocks:
+**
+**    1s    every sample
+**    1m    mean of the 1 s samples of each wall-clock minute
+**    15m   mean of the 1 min means of each quarter hour
+**
+**  A tier keeps as many blocks as it was given; when the ring is full the
+**  oldest block is overwritten, so how far back a tier reaches depends on
+**  how well its data compresses, never on how much memory it takes.
+**
+**  Values are stored in hundredths (0.01 °C, 0.01 %, 0.01 bar; flame is 0
+**  or 100, i.e. 0.00 or 1.00, so its 1m/15m means are the burner duty as
+**  a fraction) as int16.
+**  OT_HIST_MISSING marks a second without a fresh value. A block holds
+**  consecutive samples from its start time t0 at the tier's step; the first
+**  value sits in the header, every later one is one token:
+**
+**    0x01..0x7F        delta to the previous value, zigzag, -64..+63
+**    0x80 | (k - 1)    the previous value repeated k times, k = 1..64;
+**                      grown in place while the value stays the same
+**    0xE0 | hi, lo     delta, zigzag in 13 bits, -4096..+4095
+**    0xC0 lo hi        absolute value (bigger jumps, to/from missing)
+**
+**  A steady signal (flame off, setpoint, pressure) costs one byte per 64
+**  samples; a temperature one byte per change, two while it ramps fast. A gap in time (no NTP, a
+**  stall) or a full block starts the next block.
+**
+**  No Arduino dependency: tests/test_ot_history.cpp includes this header
+**  directly.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTHISTORY_H
+#define OTHISTORY_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef OT_HIST_BLOCKS_1S
+#define OT_HIST_BLOCKS_1S    8       // per metric; ~10 min (noisy) to hours (steady) of 1 s samples
+#endif
+#ifndef OT_HIST_BLOCKS_1M
+#define OT_HIST_BLOCKS_1M    40      // per metric; ~1 day of 1 min means
+#endif
+#ifndef OT_HIST_BLOCKS_15M
+#define OT_HIST_BLOCKS_15M   8       // per metric; ~5 days or more of 15 min means
+#endif
+
+#define OT_HIST_BLOCK_DATA   52
+#define OT_HIST_MISSING      INT16_MIN
+#define OT_HIST_NO_RUN       0xFF
+
+enum OTHistMetric : uint8_t {
+  OTH_FLOW = 0,          // Tboiler (id 25)
+  OTH_RETURN,            // Tret (id 28)
+  OTH_ROOM,              // Tr (id 24)
+  OTH_ROOM_SETPOINT,     // TrSet (id 16)
+  OTH_CTRL_SETPOINT,     // TSet (id 1)
+  OTH_MODULATION,        // RelModLevel (id 17)
+  OTH_PRESSURE,          // CHPressure (id 18)
+  OTH_FLAME,             // slave status bit 3, 0/100 (off/on)
+  OTH_COUNT
+};
+
+enum OTHistTier : uint8_t { OTH_TIER_1S = 0, OTH_TIER_1M, OTH_TIER_15M, OTH_TIER_COUNT };
+
+// REST keys and units, in enum order.
+static const char kOTHistNames[OTH_COUNT][16] = {
+  "flow", "return", "room", "room_setpoint", "ctrl_setpoint", "modulation", "pressure", "flame"
+};
+static const char kOTHistUnits[OTH_COUNT][4] = { "°C", "°C", "°C", "°C", "°C", "%", "bar", "" };
+static const char kOTHistTierNames[OTH_TIER_COUNT][4] = { "1s", "1m", "15m" };
+static const uint16_t kOTHistStep[OTH_TIER_COUNT] = { 1, 60, 900 };
+static const uint8_t  kOTHistBlocks[OTH_TIER_COUNT] = { OT_HIST_BLOCKS_1S, OT_HIST_BLOCKS_1M, OT_HIST_BLOCKS_15M };
+
+struct OTHistBlock {
+  uint32_t t0;           // epoch seconds of the first sample
+  uint16_t n;            // samples, 0 = empty block
+  int16_t  first;        // first sample
+  int16_t  last;         // last sample (base of the next delta)
+  uint8_t  used;         // token bytes in data
+  uint8_t  runPos;       // data index of the open run token, OT_HIST_NO_RUN if none
+  uint8_t  data[OT_HIST_BLOCK_DATA];
+};
+static_assert(sizeof(OTHistBlock) == 64, "OTHistBlock is sized to 64 bytes");
+
+// Epoch seconds of the last sample in a block.
+inline uint32_t otHistBlockEnd(const OTHistBlock &b, uint16_t step) {
+  return b.t0 + (uint32_t)(b.n ? b.n - 1 : 0) * step;
+}
+
+inline void otHistBlockClear(OTHistBlock &b) {
+  b.t0 = 0; b.n = 0; b.first = b.last = 0; b.used = 0; b.runPos = OT_HIST_NO_RUN;
+}
+
+// Append one value; false (block unchanged) when it does not fit.
+inline bool otHistBlockAppend(OTHistBlock &b, int16_t v) {
+  if (b.n == 0) {
+    b.first = b.last = v; b.n = 1; b.used = 0; b.runPos = OT_HIST_NO_RUN;
+    return true;
+  }
+  if (v == b.last) {
+    if (b.runPos != OT_HIST_NO_RUN && (b.data[b.runPos] & 0x3F) < 0x3F) {
+      b.data[b.runPos]++;
+    } else {
+      if (b.used >= OT_HIST_BLOCK_DATA) return false;
+      b.runPos = b.used;
+      b.data[b.used++] = 0x80;
+    }
+    b.n++;
+    return true;
+  }
+  const int32_t d = (int32_t)v - b.last;
+  const bool known = v != OT_HIST_MISSING && b.last != OT_HIST_MISSING;
+  const uint32_t zz = (uint32_t)((d << 1) ^ (d >> 31));    // zigzag; d != 0 so never 0
+  if (known && zz < 0x80) {
+    if (b.used >= OT_HIST_BLOCK_DATA) return false;
+    b.data[b.used++] = (uint8_t)zz;
+  } else if (known && zz < 0x2000) {
+    if (b.used + 2 > OT_HIST_BLOCK_DATA) return false;
+    b.data[b.used++] = (uint8_t)(0xE0 | (zz >> 8));
+    b.data[b.used++] = (uint8_t)zz;
+  } else {
+    if (b.used + 3 > OT_HIST_BLOCK_DATA) return false;
+    b.data[b.used++] = 0xC0;
+    b.data[b.used++] = (uint8_t)((uint16_t)v);
+    b.data[b.used++] = (uint8_t)((uint16_t)v >> 8);
+  }
+  b.runPos = OT_HIST_NO_RUN;
+  b.last = v;
+  b.n++;
+  return true;
+}
+
+// Decode a block; calls fn(uint32_t t, int16_t v) per sample, at most b.n
+// samples even if the open run token has grown since b.n was read. Returns
+// the number of samples decoded (less than b.n only for a corrupt block).
+template <typename Fn>
+inline uint16_t otHistBlockDecode(const OTHistBlock &b, uint16_t step, Fn fn) {
+  if (b.n == 0) return 0;
+  uint16_t k = 0;
+  int16_t v = b.first;
+  fn(b.t0, v);
+  k++;
+  const uint8_t used = b.used <= OT_HIST_BLOCK_DATA ? b.used : OT_HIST_BLOCK_DATA;
+  for (uint8_t i = 0; i < used && k < b.n; ) {
+    const uint8_t c = b.data[i++];
+    if (c >= 0x01 && c <= 0x7F) {
+      v = (int16_t)(v + ((c >> 1) ^ -(int32_t)(c & 1)));
+      fn(b.t0 + (uint32_t)k * step, v); k++;
+    } else if ((c & 0xC0) == 0x80) {
+      for (uint8_t r = (uint8_t)((c & 0x3F) + 1); r > 0 && k < b.n; r--) {
+        fn(b.t0 + (uint32_t)k * step, v); k++;
+      }
+    } else if (c >= 0xE0 && i + 1 <= used) {
+      const uint32_t zz = ((uint32_t)(c & 0x1F) << 8) | b.data[i++];
+      v = (int16_t)(v + (int32_t)((zz >> 1) ^ -(int32_t)(zz & 1)));
+      fn(b.t0 + (uint32_t)k * step, v); k++;
+    } else if (c == 0xC0 && i + 2 <= used) {
+      v = (int16_t)(uint16_t)(b.data[i] | (b.data[i + 1] << 8));
+      i += 2;
+      fn(b.t0 + (uint32_t)k * step, v); k++;
+    } else {
+      break;                                                   // not a token: stop
+    }
+  }
+  return k;
+}
+
+// Append to a tier ring at epoch t. A sample that is not the next step of the
+// current block (a gap) or does not fit starts the next block, overwriting the
+// oldest. A sample at or before the current block's end is dropped.
+inline void otHistRingAppend(OTHistBlock *ring, uint8_t cap, uint8_t &head,
+                             uint32_t t, uint16_t step, int16_t v) {
+  OTHistBlock *b = &ring[head];
+  if (b->n > 0) {
+    const uint32_t next = b->t0 + (uint32_t)b->n * step;
+    if (t < next) return;
+    if (t == next && otHistBlockAppend(*b, v)) return;
+    head = (uint8_t)((head + 1) % cap);
+    b = &ring[head];
+    otHistBlockClear(*b);
+  }
+  b->t0 = t;
+  otHistBlockAppend(*b, v);
+}
+
+struct OTHistAcc {
+  int32_t  sum;
+  uint16_t cnt;
+};
+
+struct OTHistStore {
+  OTHistBlock b1s[OTH_COUNT][OT_HIST_BLOCKS_1S];
+  OTHistBlock b1m[OTH_COUNT][OT_HIST_BLOCKS_1M];
+  OTHistBlock b15m[OTH_COUNT][OT_HIST_BLOCKS_15M];
+  uint8_t     head[OTH_TIER_COUNT][OTH_COUNT];
+  OTHistAcc   acc[2][OTH_COUNT];            // [0] minute being averaged, [1] quarter hour
+  uint32_t    accBucket[2];                 // epoch start of that minute / quarter, 0 = none
+  uint32_t    lastT;                        // epoch of the last 1 s sample
+};
+
+inline OTHistBlock *otHistRing(OTHistStore &s, uint8_t tier, uint8_t m) {
+  return tier == OTH_TIER_1S ? s.b1s[m] : tier == OTH_TIER_1M ? s.b1m[m] : s.b15m[m];
+}
+inline const OTHistBlock *otHistRing(const OTHistStore &s, uint8_t tier, uint8_t m) {
+  return tier == OTH_TIER_1S ? s.b1s[m] : tier == OTH_TIER_1M ? s.b1m[m] : s.b15m[m];
+}
+
+inline void otHistReset(OTHistStore &s) {
+  memset(&s, 0, sizeof(s));
+  for (uint8_t tier = 0; tier < OTH_TIER_COUNT; tier++)
+    for (uint8_t m = 0; m < OTH_COUNT; m++)
+      for (uint8_t i = 0; i < kOTHistBlocks[tier]; i++) otHistBlockClear(otHistRing(s, tier, m)[i]);
+}
+
+// Mean rounded half away from zero; OT_HIST_MISSING when nothing was added.
+inline int16_t otHistMean(const OTHistAcc &a) {
+  if (a.cnt == 0) return OT_HIST_MISSING;
+  const int32_t h = a.cnt / 2;
+  return (int16_t)(a.sum >= 0 ? (a.sum + h) / a.cnt : (a.sum - h) / a.cnt);
+}
+
+// level 0 averages 1 s samples into OTH_TIER_1M, level 1 averages the
+// minute means into OTH_TIER_15M. A bucket is written when the first
+// sample of the next bucket arrives.
+inline void otHistFeed(OTHistStore &s, uint8_t level, uint32_t t, const int16_t v[OTH_COUNT]) {
+  const uint8_t tier = (uint8_t)(level + 1);
+  const uint32_t step = kOTHistStep[tier];
+  const uint32_t bucket = t - t % step;
+  if (s.accBucket[level] != bucket) {
+    if (s.accBucket[level] != 0) {
+      int16_t mean[OTH_COUNT];
+      for (uint8_t m = 0; m < OTH_COUNT; m++) {
+        mean[m] = otHistMean(s.acc[level][m]);
+        otHistRingAppend(otHistRing(s, tier, m), kOTHistBlocks[tier], s.head[tier][m],
+                         s.accBucket[level], (uint16_t)step, mean[m]);
+        s.acc[level][m].sum = 0;
+        s.acc[level][m].cnt = 0;
+      }
+      if (level == 0) otHistFeed(s, 1, s.accBucket[0], mean);
+    }
+    s.accBucket[level] = bucket;
+  }
+  for (uint8_t m = 0; m < OTH_COUNT; m++) {
+    if (v[m] == OT_HIST_MISSING) continue;
+    s.acc[level][m].sum += v[m];
+    s.acc[level][m].cnt++;
+  }
+}
+
+// One sample per metric at epoch t (seconds). Time must move forward; a
+// repeated or earlier second is ignored.
+inline void otHistSample(OTHistStore &s, uint32_t t, const int16_t v[OTH_COUNT]) {
+  if (t <= s.lastT) return;
+  s.lastT = t;
+  for (uint8_t m = 0; m < OTH_COUNT; m++) {
+    otHistRingAppend(s.b1s[m], OT_HIST_BLOCKS_1S, s.head[OTH_TIER_1S][m], t, 1, v[m]);
+  }
+  otHistFeed(s, 0, t, v);
+}
+
+// Walk the non-empty blocks of one ring oldest first: fn(const OTHistBlock&).
+template <typename Fn>
+inline void otHistForEachBlock(const OTHistStore &s, uint8_t tier, uint8_t m, Fn fn) {
+  const uint8_t cap = kOTHistBlocks[tier];
+  const OTHistBlock *ring = otHistRing(s, tier, m);
+  const uint8_t head = s.head[tier][m];
+  for (uint8_t i = 1; i <= cap; i++) {
+    const OTHistBlock &b = ring[(head + i) % cap];
+    if (b.n) fn(b);
+  }
+}
+
+// Oldest epoch from which every metric of a tier has samples, 0 when empty.
+inline uint32_t otHistTierStart(const OTHistStore &s, uint8_t tier) {
+  uint32_t start = 0;
+  for (uint8_t m = 0; m < OTH_COUNT; m++) {
+    uint32_t oldest = 0;
+    otHistForEachBlock(s, tier, m, [&](const OTHistBlock &b) { if (!oldest) oldest = b.t0; });
+    if (!oldest) return 0;
+    if (oldest > start) start = oldest;
+  }
+  return start;
+}
+
+// Finest tier that reaches back to `from`; else the one reaching furthest back.
+inline uint8_t otHistPickTier(const OTHistStore &s, uint32_t from) {
+  uint8_t best = OTH_TIER_1S;
+  uint32_t bestStart = UINT32_MAX;
+  for (uint8_t tier = 0; tier < OTH_TIER_COUNT; tier++) {
+    const uint32_t start = otHistTierStart(s, tier);
+    if (!start) continue;
+    if (start <= from) return tier;
+    if (start < bestStart) { bestStart = start; best = tier; }
+  }
+  return best;
+}
+
+// Copy the blocks of one tier that overlap [from, to] for the metrics in
+// mask (bit m = metric m), oldest first per metric, into dst. perMetric[m]
+// gets each metric's block count. Returns the total; with dst == nullptr it
+// only counts. Stops at cap.
+inline uint16_t otHistCopyBlocks(const OTHistStore &s, uint8_t tier, uint16_t mask,
+                                 uint32_t from, uint32_t to,
+                                 OTHistBlock *dst, uint16_t cap, uint8_t perMetric[OTH_COUNT]) {
+  const uint16_t step = kOTHistStep[tier];
+  uint16_t total = 0;
+  for (uint8_t m = 0; m < OTH_COUNT; m++) {
+    perMetric[m] = 0;
+    if (!(mask & (1u << m))) continue;
+    otHistForEachBlock(s, tier, m, [&](const OTHistBlock &b) {
+      if (b.t0 > to || otHistBlockEnd(b, step) < from || total >= cap) return;
+      if (dst) dst[total] = b;
+      total++;
+      perMetric[m]++;
+    });
+  }
+  return total;
+}
+
+// A REST response's private copy of the blocks it serves (the store keeps
+// changing under a chunked response). blocks is malloc'd by the filler.
+struct OTHistSnap {
+  uint8_t      tier = OTH_TIER_1M;
+  uint16_t     mask = 0;
+  uint32_t     from = 0;
+  uint32_t     to   = 0;
+  uint8_t      perMetric[OTH_COUNT] = {};
+  uint16_t     count  = 0;
+  OTHistBlock *blocks = nullptr;
+
+  OTHistSnap() = default;
+  OTHistSnap(const OTHistSnap &) = delete;
+  OTHistSnap &operator=(const OTHistSnap &) = delete;
+  ~OTHistSnap() { free(blocks); }
+};
+
+#endif // OTHISTORY_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
@@ -0,0 +1,134 @@
+/*
+***************************************************************************
+**  Program  : OTLogTimestamp.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Cached UTC-offset + integer HH:MM:SS.uuuuuu formatter for the OT log
+**  timestamp that processOT() prepends to every frame.
+**
+**  getOTLogTimestamp() used to resolve the configured zone through
+**  timezoneManager and build a ZonedDateTime for every OT frame (5-10/s
+**  steady state, far more during PS=1 bursts). The UTC offset only changes
+**  at a DST transition, so this header keeps the resolved offset together
+**  with the UTC window it is valid for, and only asks the zone database
+**  again when the clock leaves that window (transition, NTP step, or an
+**  explicit invalidate after the timezone setting changes).
+**
+**  No AceTime / Arduino dependency: the zone lookup is a callback supplied
+**  by the caller, so tests/bench_ot_log_timestamp.cpp drives the same code
+**  on the host.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTLOGTIMESTAMP_H
+#define OTLOGTIMESTAMP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// "HH:MM:SS.uuuuuu" + NUL
+#define OT_LOG_TIMESTAMP_LEN 16
+
+// Longest window a resolved offset is trusted without re-asking the zone
+// database. Bounds the forward transition search and also picks up tz rule
+// changes within a month even if no transition is found.
+#define OT_LOG_TZ_HORIZON_SEC  (35L * 86400L)
+#define OT_LOG_TZ_PROBE_SEC    86400L
+
+struct OTLogTzCache {
+  int32_t offsetSec  = 0;   // local = utc + offsetSec
+  int64_t validFrom  = 0;   // inclusive, UTC seconds
+  int64_t validUntil = 0;   // exclusive, UTC seconds; == validFrom means "empty"
+};
+
+inline bool otLogTzCacheValid(const OTLogTzCache &c, int64_t utcSec)
+{
+  return utcSec >= c.validFrom && utcSec < c.validUntil;
+}
+
+inline void otLogTzCacheInvalidate(OTLogTzCache &c)
+{
+  c.validFrom = 0;
+  c.validUntil = 0;
+}
+
+// Resolve the offset at utcSec and the first second after it where the
+// offset changes (searched up to OT_LOG_TZ_HORIZON_SEC ahead: day-sized
+// probes, then a binary search inside the day that changed). Costs ~35+17
+// zone lookups once per transition/horizon instead of one lookup per frame.
+// offsetAt(int64_t utcSec) -> int32_t must return the UTC offset in seconds.
+template <typename OffsetFn>
+inline void otLogTzResolve(OTLogTzCache &c, int64_t utcSec, OffsetFn offsetAt)
+{
+  const int32_t offset = offsetAt(utcSec);
+  int64_t same = utcSec;
+  int64_t until = utcSec + OT_LOG_TZ_HORIZON_SEC;
+  for (int64_t probe = utcSec + OT_LOG_TZ_PROBE_SEC; probe <= until; probe += OT_LOG_TZ_PROBE_SEC) {
+    if (offsetAt(probe) != offset) {
+      // Transition in (same, probe]: narrow down to the first changed second.
+      int64_t lo = same, hi = probe;
+      while (hi - lo > 1) {
+        const int64_t mid = lo + (hi - lo) / 2;
+        if (offsetAt(mid) == offset) lo = mid; else hi = mid;
+      }
+      until = hi;
+      break;
+    }
+    same = probe;
+  }
+  c.offsetSec = offset;
+  c.validFrom = utcSec;
+  c.validUntil = until;
+}
+
+// Format the time-of-day part of a local epoch second plus microseconds as
+// "HH:MM:SS.uuuuuu". Integer arithmetic only (no snprintf, no tm struct).
+// out must hold OT_LOG_TIMESTAMP_LEN bytes.
+inline void otLogFormatTimestamp(char *out, int64_t localSec, uint32_t usec)
+{
+  int32_t sod = (int32_t)(localSec % 86400);
+  if (sod < 0) sod += 86400;                 // pre-1970 / negative offsets
+  const uint32_t h = (uint32_t)sod / 3600u;
+  const uint32_t m = ((uint32_t)sod / 60u) % 60u;
+  const uint32_t s = (uint32_t)sod % 60u;
+  if (usec > 999999u) usec = 999999u;
+
+  out[0] = (char)('0' + h / 10u);
+  out[1] = (char)('0' + h % 10u);
+  out[2] = ':';
+  out[3] = (char)('0' + m / 10u);
+  out[4] = (char)('0' + m % 10u);
+  out[5] = ':';
+  out[6] = (char)('0' + s / 10u);
+  out[7] = (char)('0' + s % 10u);
+  out[8] = '.';
+  for (int i = 14; i >= 9; i--) {
+    out[i] = (char)('0' + usec % 10u);
+    usec /= 10u;
+  }
+  out[15] = '\0';
+}
+
+#endif // OTLOGTIMESTAMP_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
@@ -0,0 +1,135 @@
+/*
+***************************************************************************
+**  Program  : OTStateSnapshot.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Double-buffered seqlock snapshot of a trivially copyable struct. The
+**  decoded OpenTherm state (OTcurrentSystemState) is published through one
+**  of these after every processOT() call so readers on other tasks (the
+**  async_tcp REST handlers, the webhook test endpoint) get a consistent copy
+**  without taking OTStateLock and without ever making the writer wait.
+**
+**  Writer (one at a time; processOT() already runs under OTStateLock):
+**
+**    seq = 2p+1     publish p+1 in progress
+**    buf[(p+1)&1]   <- state
+**    seq = 2p+2     publish p+1 visible
+**
+**  Reader: load seq, copy buf[p&1] of the last completed publish p, load seq
+**  again. That buffer is only rewritten by publish p+2, which starts with
+**  seq = 2p+3, so the copy is good unless seq reached 2p+3 meanwhile; then
+**  it retries. A reader therefore only retries when the writer finishes one
+**  publish AND starts the next during a single copy (a few hundred bytes),
+**  and the writer never waits for anyone.
+**
+**  The buffers are arrays of std::atomic<uint32_t> accessed relaxed, with
+**  the seqlock fences around them, so a racing copy is a well-defined (if
+**  discarded) read rather than a data race.
+**
+**  No Arduino dependency: tests/test_ot_state_snapshot.cpp includes this
+**  header and tortures it with one writer and several reader std::threads.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTSTATESNAPSHOT_H
+#define OTSTATESNAPSHOT_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+template <typename T>
+class OTStateSnapshot {
+  static_assert(std::is_trivially_copyable<T>::value, "OTStateSnapshot needs a trivially copyable type");
+  static constexpr uint32_t kWords = (uint32_t)((sizeof(T) + 3) / 4);
+
+public:
+  OTStateSnapshot() : _seq(0), _retries(0)
+  {
+    const T init{};
+    store(0, init);
+    store(1, init);
+  }
+
+  // Writer side. Callers must not publish concurrently with each other.
+  void publish(const T &src)
+  {
+    const uint32_t s = _seq.load(std::memory_order_relaxed);   // even: idle
+    _seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    store(((s >> 1) + 1) & 1u, src);
+    _seq.store(s + 2, std::memory_order_release);
+  }
+
+  // Any task. Copies the last completed publish into dst; returns the number
+  // of retries it took (almost always 0).
+  uint32_t read(T &dst) const
+  {
+    for (uint32_t tries = 0;; tries++) {
+      const uint32_t s1 = _seq.load(std::memory_order_acquire);
+      const uint32_t p = s1 >> 1;                  // last completed publish
+      load(p & 1u, dst);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      const uint32_t s2 = _seq.load(std::memory_order_relaxed);
+      if ((uint32_t)(s2 - (2 * p)) < 3) return tries;   // buffer p&1 not touched since
+      _retries.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Completed publishes so far (wraps).
+  uint32_t version() const { return _seq.load(std::memory_order_acquire) >> 1; }
+
+  // Reader retries since boot, for diagnostics.
+  uint32_t retries() const { return _retries.load(std::memory_order_relaxed); }
+
+private:
+  void store(uint32_t b, const T &src)
+  {
+    const uint8_t *in = reinterpret_cast<const uint8_t *>(&src);
+    for (uint32_t i = 0; i < kWords; i++) {
+      uint32_t w = 0;
+      const uint32_t off = i * 4;
+      memcpy(&w, in + off, (sizeof(T) - off) < 4 ? (sizeof(T) - off) : 4);
+      _buf[b][i].store(w, std::memory_order_relaxed);
+    }
+  }
+
+  void load(uint32_t b, T &dst) const
+  {
+    uint8_t *out = reinterpret_cast<uint8_t *>(&dst);
+    for (uint32_t i = 0; i < kWords; i++) {
+      const uint32_t w = _buf[b][i].load(std::memory_order_relaxed);
+      const uint32_t off = i * 4;
+      memcpy(out + off, &w, (sizeof(T) - off) < 4 ? (sizeof(T) - off) : 4);
+    }
+  }
+
+  std::atomic<uint32_t> _seq;                // 2 x publishes, odd while one is in progress
+  mutable std::atomic<uint32_t> _retries;
+  std::atomic<uint32_t> _buf[2][kWords];
+};
+
+#endif // OTSTATESNAPSHOT_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
@@ -0,0 +1,164 @@
+/*
+***************************************************************************
+**  Program  : OTWsBinary.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Binary OT frame stream for the /ws live-log WebSocket.
+**
+**  The text stream sends one column-formatted log line per decoded frame
+**  (~90 bytes, built with snprintf in ot_log_buffer). A client that sends
+**  the text message {"stream":"binary","v":1} after connecting gets the
+**  frames as compact records instead, batched into one binary WebSocket
+**  message per OT_WS_BIN_FLUSH_MS, and decodes labels and values itself
+**  from GET /api/v2/otgw/otmap. Event lines ('>' '<' '!' '*'), keepalives
+**  and JSON notifications stay text for every client.
+**
+**  Message layout, little-endian:
+**
+**    header  8 B   u8  OT_WS_BIN_MAGIC
+**                  u8  OT_WS_BIN_VERSION
+**                  u16 record count
+**                  u32 local time of day of the first record, ms
+**    record  8 B   u16 ms since the previous record (0 for the first)
+**                  u8  source letter as in the text line (T B R A E)
+**                  u8  OT_WS_BIN_F_* flags
+**                  u32 the 32-bit OT frame
+**
+**  A record that would need more than 65535 ms, or a batch that is full,
+**  starts a new message, so deltas never saturate. At one message a second
+**  and a few frames per message that is ~10 bytes per frame.
+**
+**  No Arduino dependency: tests/test_ot_ws_binary.cpp includes this header
+**  directly.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTWSBINARY_H
+#define OTWSBINARY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define OT_WS_BIN_MAGIC        0xB7
+#define OT_WS_BIN_VERSION      1
+#define OT_WS_BIN_HEADER_LEN   8
+#define OT_WS_BIN_RECORD_LEN   8
+#define OT_WS_BIN_MAX_RECORDS  32
+#define OT_WS_BIN_FLUSH_MS     1000
+#define OT_WS_BIN_MAX_LEN      (OT_WS_BIN_HEADER_LEN + OT_WS_BIN_MAX_RECORDS * OT_WS_BIN_RECORD_LEN)
+
+// Record flags: the indicators of the text line.
+#define OT_WS_BIN_F_VALID      0x01   // '>' value valid (is_value_valid())
+#define OT_WS_BIN_F_DECODED    0x02   // "label = value" shown (ADR-097 master-topic validity)
+#define OT_WS_BIN_F_IGNORED    0x04   // '-' / "<ignored>": gateway-substituted (ADR-096)
+#define OT_WS_BIN_F_ANSWER_OVR 0x08   // answer-override A (ADR-103)
+#define OT_WS_BIN_F_WRITE_CTX  0x10   // Unknown-Data-Id answered to a write ("boiler rejected write")
+
+struct OTWsBinBatch {
+  uint8_t  buf[OT_WS_BIN_MAX_LEN];
+  uint16_t count   = 0;
+  uint32_t firstMs = 0;   // millis() of the first record (flush age)
+  uint32_t lastMs  = 0;   // millis() of the last record (next delta)
+};
+
+inline void otWsBinPut16(uint8_t *p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+inline void otWsBinPut32(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+inline uint16_t otWsBinGet16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+inline uint32_t otWsBinGet32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+inline void otWsBinReset(OTWsBinBatch &b) { b.count = 0; }
+
+inline size_t otWsBinLength(const OTWsBinBatch &b) {
+  return b.count ? OT_WS_BIN_HEADER_LEN + (size_t)b.count * OT_WS_BIN_RECORD_LEN : 0;
+}
+
+// True when the record at nowMs does not fit this batch: send it first.
+inline bool otWsBinNeedsFlush(const OTWsBinBatch &b, uint32_t nowMs) {
+  return b.count > 0 && (b.count >= OT_WS_BIN_MAX_RECORDS || (uint32_t)(nowMs - b.lastMs) > 0xFFFFu);
+}
+
+// True when the batch has waited long enough to be sent on its own.
+inline bool otWsBinDue(const OTWsBinBatch &b, uint32_t nowMs) {
+  return b.count > 0 && (uint32_t)(nowMs - b.firstMs) >= OT_WS_BIN_FLUSH_MS;
+}
+
+// Append one frame. The caller flushes first when otWsBinNeedsFlush();
+// returns false (and drops nothing) if it did not.
+inline bool otWsBinAppend(OTWsBinBatch &b, uint32_t nowMs, uint32_t msOfDay,
+                          char source, uint8_t flags, uint32_t frame) {
+  if (otWsBinNeedsFlush(b, nowMs)) return false;
+  uint16_t dt = 0;
+  if (b.count == 0) {
+    b.buf[0] = OT_WS_BIN_MAGIC;
+    b.buf[1] = OT_WS_BIN_VERSION;
+    otWsBinPut32(b.buf + 4, msOfDay);
+    b.firstMs = nowMs;
+  } else {
+    dt = (uint16_t)(nowMs - b.lastMs);
+  }
+  uint8_t *r = b.buf + OT_WS_BIN_HEADER_LEN + (size_t)b.count * OT_WS_BIN_RECORD_LEN;
+  otWsBinPut16(r, dt);
+  r[2] = (uint8_t)source;
+  r[3] = flags;
+  otWsBinPut32(r + 4, frame);
+  b.count++;
+  otWsBinPut16(b.buf + 2, b.count);
+  b.lastMs = nowMs;
+  return true;
+}
+
+struct OTWsBinRecord {
+  uint32_t msOfDay;       // header time + deltas, wrapped at midnight
+  char     source;
+  uint8_t  flags;
+  uint32_t frame;
+};
+
+// Decode one message; calls fn(const OTWsBinRecord&) per record. Returns the
+// record count, or -1 for a bad header or a length that does not match it.
+template <typename Fn>
+inline int otWsBinDecode(const uint8_t *p, size_t len, Fn fn) {
+  if (len < OT_WS_BIN_HEADER_LEN || p[0] != OT_WS_BIN_MAGIC || p[1] != OT_WS_BIN_VERSION) return -1;
+  const uint16_t count = otWsBinGet16(p + 2);
+  if (len != OT_WS_BIN_HEADER_LEN + (size_t)count * OT_WS_BIN_RECORD_LEN) return -1;
+  uint32_t t = otWsBinGet32(p + 4);
+  for (uint16_t i = 0; i < count; i++) {
+    const uint8_t *r = p + OT_WS_BIN_HEADER_LEN + (size_t)i * OT_WS_BIN_RECORD_LEN;
+    t = (t + otWsBinGet16(r)) % 86400000UL;
+    OTWsBinRecord rec;
+    rec.msOfDay = t;
+    rec.source  = (char)r[2];
+    rec.flags   = r[3];
+    rec.frame   = otWsBinGet32(r + 4);
+    fn(rec);
+  }
+  return count;
+}
+
+#endif // OTWSBINARY_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
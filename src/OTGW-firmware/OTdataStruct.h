@@ -0,0 +1,199 @@
+/*
+***************************************************************************
+**  Program  : OTdataStruct.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  OTdataStruct: the decoded OpenTherm state (OTcurrentSystemState, and the
+**  seqlock snapshot the async readers copy). Split out of OTGW-Core.h, like
+**  OTmap.h, so it has no dependency on the platform layer or the sketch
+**  globals: OTDispatch.h takes field offsets from it and the host benchmarks
+**  under tests/ include it directly.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTDATASTRUCT_H
+#define OTDATASTRUCT_H
+
+#include <stdint.h>
+#include <math.h>        // NAN
+
+#define OT_GEN_SLOTS 16  // REST-tracked messages (RestLastUpdatedSlot, OTGW-Core.ino)
+
+typedef struct {
+	uint16_t 	Statusflags = 0; // flag8 / flag8  Master and Slave Status flags. 
+	uint8_t 	MasterStatus = 0; 
+	uint8_t 	SlaveStatus = 0;
+	float 		TSet = 0.0f; // f8.8  Control setpoint  ie CH  water temperature setpoint (°C)
+	uint16_t	MasterConfigMemberIDcode = 0; 	// flag8 / u8  Master Configuration Flags /  Master MemberID Code 
+	uint16_t	SlaveConfigMemberIDcode = 0; // flag8 / u8  Slave Configuration Flags /  Slave MemberID Code 
+	uint16_t 	Command = 0; // u8 / u8  Remote Command 
+	uint16_t 	ASFflags = 0; // / OEM-fault-code  flag8 / u8  Application-specific fault flags and OEM fault code 
+	uint16_t 	RBPflags = 0; // flag8 / flag8  Remote boiler parameter transfer-enable & read/write flags 
+	float 		CoolingControl = 0.0f; // f8.8  Cooling control signal (%) 
+	float 		TsetCH2 = 0.0f; // f8.8  Control setpoint for 2e CH circuit (°C)
+	float 		TrOverride = 0.0f; // f8.8  Remote override room setpoint 
+	float 		TrOverride2 = 0.0f; // f8.8  Remote override room setpoint 2 (°C)
+	uint16_t 	TSP = 0; // u8 / u8  Number of Transparent-Slave-Parameters supported by slave 
+	uint16_t 	TSPindexTSPvalue = 0; // u8 / u8  Index number / Value of referred-to transparent slave parameter. 
+	uint16_t 	FHBsize = 0; // u8 / u8  Size of Fault-History-Buffer supported by slave 
+	uint16_t 	FHBindexFHBvalue = 0; // u8 / u8  Index number / Value of referred-to fault-history buffer entry. 
+	float 		MaxRelModLevelSetting = 0.0f; // f8.8  Maximum relative modulation level setting (%) 
+	uint16_t 	MaxCapacityMinModLevel = 0; // u8 / u8  Maximum boiler capacity (kW) / Minimum boiler modulation level(%) 
+	float 		TrSet = 0.0f; // f8.8  Room Setpoint (°C)
+	float 		RelModLevel = 0.0f; // f8.8  Relative Modulation Level (%) 
+	float 		CHPressure = 0.0f; // f8.8  Water pressure in CH circuit  (bar) 
+	float 		DHWFlowRate = 0.0f; // f8.8  Water flow rate in DHW circuit. (litres/minute) 
+	uint16_t 	DayTime = 0; // special / u8  Day of Week and Time of Day 
+	uint16_t 	Date = 0; // u8 / u8  Calendar date 
+	uint16_t 	Year = 0; // u16  Calendar year 
+	float 		TrSetCH2 = 0.0f; // f8.8  Room Setpoint for 2nd CH circuit (°C)
+	float 		Tr = NAN; // f8.8  Room temperature (°C). NAN-init per TASK-522: distinguishes "never observed" from a real 0 °C reading. Consumers must isnan()-guard before arithmetic or display.
+	float 		Tboiler = 0.0f; // f8.8  Boiler flow water temperature (°C)
+	float 		Tdhw = 0.0f; // f8.8  DHW temperature (°C)
+	float 		Toutside = 0.0f; // f8.8  Outside temperature (°C)
+	float 		Tret = 0.0f; // f8.8  Return water temperature (°C)
+	float 		Tsolarstorage = 0.0f; // f8.8  Solar storage temperature (°C)
+	int16_t 	Tsolarcollector = 0; // s16  Solar collector temperature (°C)
+	float 		TflowCH2 = 0.0f; // f8.8  Flow water temperature CH2 circuit (°C)
+	float 		Tdhw2 = 0.0f; // f8.8  Domestic hot water temperature 2 (°C)
+	int16_t 	Texhaust = 0; // s16  Boiler exhaust temperature (°C)
+	float 		Theatexchanger = 0.0f; // f8.8  Heat Exchanger (°C)
+	uint16_t	FanSpeed = 0; // u8 / u8  Fan Speed setpoint / actual (Hz)
+	float 		ElectricalCurrentBurnerFlame = 0.0f; // f88 Electrical current through burner flame (µA)
+	float 		TRoomCH2= 0.0f; // f88  Room Temperature for 2nd CH circuit ("°C)
+	float 		RelativeHumidity = 0.0f; // f8.8 Relative Humidity (%)
+	uint16_t 	TdhwSetUBTdhwSetLB = 0 ; // s8 / s8  DHW setpoint upper & lower bounds for adjustment  (°C)
+	uint16_t 	MaxTSetUBMaxTSetLB = 0; // s8 / s8  Max CH water setpoint upper & lower bounds for adjustment  (°C)
+	uint16_t	HcratioUBHcratioLB = 0; // s8 / s8  OTC heat curve ratio upper & lower bounds for adjustment  
+	uint16_t	Remoteparameter4boundaries = 0; // s8 / s8  Remote parameter 4 upper & lower bounds for adjustment
+	uint16_t	Remoteparameter5boundaries = 0; // s8 / s8  Remote parameter 5 upper & lower bounds for adjustment
+	uint16_t	Remoteparameter6boundaries = 0; // s8 / s8  Remote parameter 6 upper & lower bounds for adjustment
+	uint16_t	Remoteparameter7boundaries = 0; // s8 / s8  Remote parameter 7 upper & lower bounds for adjustment
+	uint16_t	Remoteparameter8boundaries = 0; // s8 / s8  Remote parameter 8 upper & lower bounds for adjustment
+	float 		TdhwSet = 0.0f; // f8.8  DHW setpoint (°C)    (Remote parameter 1)
+	float 		MaxTSet = 0.0f; // f8.8  Max CH water setpoint (°C)  (Remote parameters 2)
+	float 		Hcratio = 0.0f; // f8.8  OTC heat curve ratio (°C)  (Remote parameter 3)
+	float 		Remoteparameter4 = 0.0f; // f8.8  Remote parameter 4
+	float 		Remoteparameter5 = 0.0f; // f8.8  Remote parameter 5
+	float 		Remoteparameter6 = 0.0f; // f8.8  Remote parameter 6
+	float 		Remoteparameter7 = 0.0f; // f8.8  Remote parameter 7
+	float 		Remoteparameter8 = 0.0f; // f8.8  Remote parameter 8
+
+	//RF
+	uint16_t	RFstrengthbatterylevel = 0; // u8/ u8 RF strength and battery level
+	uint16_t 	OperatingMode_HC1_HC2_DHW = 0; // u8 / u8 Operating Mode HC1, HC2/ DHW
+
+	//Brand identification (mandatory since v4.1)
+	uint16_t	Brand = 0; // u8 / u8 Brand name index / character
+	uint16_t	BrandVersion = 0; // u8 / u8 Brand version index / character
+	uint16_t	BrandSerialNumber = 0; // u8 / u8 Brand serial number index / character
+
+	//Counters
+	uint16_t	CoolingOperationHours = 0; // u16 Cooling operation hours
+	uint16_t	PowerCycles = 0; // u16 Power cycles
+
+	//Electric Producer
+	uint16_t 	ElectricityProducerStarts = 0; // u16 Electricity producer starts 
+	uint16_t 	ElectricityProducerHours = 0; // u16 Electricity producer hours
+	uint16_t 	ElectricityProduction = 0; // u16 Electricity production
+	uint16_t 	CumulativeElectricityProduction = 0; // u16 Cumulative Electricity production
+	
+	//Solar Storage
+	uint16_t 	SolarStorageStatus = 0;
+	uint8_t 	SolarMasterStatus = 0;
+	uint8_t 	SolarSlaveStatus = 0;	
+	uint16_t	SolarStorageASFflags = 0;
+	uint16_t	SolarStorageSlaveConfigMemberIDcode = 0;
+	uint16_t	SolarStorageVersionType = 0;
+	uint16_t 	SolarStorageTSP = 0;
+	uint16_t	SolarStorageTSPindexTSPvalue = 0;
+	uint16_t	SolarStorageFHBsize = 0;
+	uint16_t	SolarStorageFHBindexFHBvalue = 0;
+
+	//Ventilation/HeatRecovery Msgids
+	uint16_t	StatusVH = 0;
+	uint8_t 	MasterStatusVH = 0;
+	uint8_t 	SlaveStatusVH = 0;
+	uint16_t	ControlSetpointVH = 0;  //should be uint8_t
+	uint16_t	ASFFaultCodeVH = 0;
+	uint16_t	DiagnosticCodeVH = 0;
+	uint16_t	ConfigMemberIDVH = 0;
+	float		OpenthermVersionVH = 0.0f;
+	uint16_t	VersionTypeVH = 0;
+	uint16_t	RelativeVentilation = 0;
+	uint16_t	RelativeHumidityExhaustAir = 0;
+	uint16_t	CO2LevelExhaustAir = 0;
+	float		SupplyInletTemperature = 0.0f;
+	float		SupplyOutletTemperature = 0.0f;
+	float		ExhaustInletTemperature = 0.0f;
+	float		ExhaustOutletTemperature = 0.0f;
+	uint16_t	ActualExhaustFanSpeed = 0;
+	uint16_t 	ActualSupplyFanSpeed = 0;
+	uint16_t	RemoteParameterSettingVH = 0;
+	uint16_t	NominalVentilationValue = 0;
+	uint16_t	TSPNumberVH = 0;
+	uint16_t	TSPEntryVH = 0;
+	uint16_t	FaultBufferSizeVH = 0;
+	uint16_t	FaultBufferEntryVH = 0;
+
+	//Statitics
+	uint16_t 	BurnerUnsuccessfulStarts = 0;
+	uint16_t	FlameSignalTooLow = 0;
+	uint16_t 	RemoteOverrideFunction = 0; // flag8 / -  Function of manual and program changes in master and remote room setpoint. 
+	uint16_t 	OEMDiagnosticCode = 0; // u16  OEM-specific diagnostic/service code 
+	uint16_t 	BurnerStarts = 0; // u16  Number of starts burner 
+	uint16_t 	CHPumpStarts = 0; // u16  Number of starts CH pump 
+	uint16_t 	DHWPumpValveStarts = 0; // u16  Number of starts DHW pump/valve 
+	uint16_t 	DHWBurnerStarts = 0; // u16  Number of starts burner during DHW mode 
+	uint16_t 	BurnerOperationHours = 0; // u16  Number of hours that burner is in operation (i.e. flame on) 
+	uint16_t 	CHPumpOperationHours = 0; // u16  Number of hours that CH pump has been running 
+	uint16_t 	DHWPumpValveOperationHours = 0; // u16  Number of hours that DHW pump has been running or DHW valve has been opened 
+	uint16_t 	DHWBurnerOperationHours = 0; // u16  Number of hours that burner is in operation during DHW mode 
+	float 		OpenThermVersionMaster = 0.0f; // f8.8  The implemented version of the OpenTherm Protocol Specification in the master. 
+	float 		OpenThermVersionSlave = 0.0f; // f8.8  The implemented version of the OpenTherm Protocol Specification in the slave. 
+	uint16_t 	MasterVersion = 0; // u8 / u8  Master product version number and type 
+	uint16_t 	SlaveVersion = 0; // u8 / u8  Slave product version number and type
+
+	//Rehmea
+	uint16_t	RemehadFdUcodes = 0; // u16 Remeha dF-/dU-codes
+	uint16_t 	RemehaServicemessage = 0; // u16 Remeha Servicemessage
+	uint16_t    RemehaDetectionConnectedSCU =0; // u16 Remeha detection connected SCU’s
+
+	//errors
+	uint16_t	error01 = 0;
+	uint16_t	error02 = 0;
+	uint16_t	error03 = 0;
+	uint16_t	error04 = 0;
+	uint16_t	errorBufferOverflow = 0;
+
+	//change generations for /api/v2/otgw/otmonitor?since= (OTmonDelta.h); kept
+	//here so a snapshot carries them together with the values they describe
+	uint32_t	gen = 0;                      // last generation handed out
+	uint32_t	genReset = 0;                 // generation of the last clearMsgLastUpdated()
+	uint32_t	genSlot[OT_GEN_SLOTS] = {};   // per tracked message: generation of its last value change
+
+} OTdataStruct;
+
+#endif // OTDATASTRUCT_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
@@ -0,0 +1,355 @@
+/*
+***************************************************************************
+**  Program  : OTmap.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  OpenTherm protocol tables: message-type / message-id enums, the OTtype_t
+**  decode classes and the OTmap[] PROGMEM lookup table. Split out of
+**  OTGW-Core.h so the tables have no dependency on the platform layer or the
+**  sketch globals: the host benchmarks under tests/ include this header
+**  directly instead of carrying a hand-copied table that could drift.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTMAP_H
+#define OTMAP_H
+
+#include <stdint.h>
+#if defined(ARDUINO)
+#include <Arduino.h>     // PROGMEM
+#endif
+#ifndef PROGMEM
+#define PROGMEM          // host builds: flash and RAM share one address space
+#endif
+
+// Value type enum for OTlogStruct
+enum OTValueType {
+	OT_VALTYPE_NONE = 0,
+	OT_VALTYPE_F88,      // float (f8.8)
+	OT_VALTYPE_S16,      // signed 16-bit
+	OT_VALTYPE_U16,      // unsigned 16-bit
+	OT_VALTYPE_U8U8,     // two unsigned 8-bit values
+	OT_VALTYPE_S8S8,     // two signed 8-bit values
+	OT_VALTYPE_FLAG8,    // 8-bit flags
+	OT_VALTYPE_FLAG8FLAG8, // two 8-bit flags
+	OT_VALTYPE_STATUS,   // status flags (master/slave)
+	OT_VALTYPE_DATETIME, // date or time
+	OT_VALTYPE_SPECIAL   // special formatting
+};
+
+enum OTLibMessageType {
+	/*  Master to Slave */
+	OT_READ_DATA       = 0b000,
+	OT_WRITE_DATA      = 0b001,
+	OT_INVALID_DATA    = 0b010,
+	OT_RESERVED        = 0b011,
+	/* Slave to Master */
+	OT_READ_ACK        = 0b100,
+	OT_WRITE_ACK       = 0b101,
+	OT_DATA_INVALID    = 0b110,
+	OT_UNKNOWN_DATA_ID = 0b111
+};
+
+enum OTLibMessageID {
+	OT_Statusflags, // flag8 / flag8  Master and Slave Status flags. 
+	OT_TSet, // f8.8  Control setpoint  ie CH  water temperature setpoint (°C)
+	OT_MasterConfigMemberIDcode, // flag8 / u8  Master Configuration Flags /  Master MemberID Code 
+	OT_SlaveConfigMemberIDcode, // flag8 / u8  Slave Configuration Flags /  Slave MemberID Code 
+	OT_Command, // u8 / u8  Remote Command 
+	OT_ASFflags, // / OEM-fault-code  flag8 / u8  Application-specific fault flags and OEM fault code 
+	OT_RBPflags, // flag8 / flag8  Remote boiler parameter transfer-enable & read/write flags 
+	OT_CoolingControl, // f8.8  Cooling control signal (%) 
+	OT_TsetCH2, // f8.8  Control setpoint for 2e CH circuit (°C)
+	OT_TrOverride, // f8.8  Remote override room setpoint 
+	OT_TSP, // u8 / u8  Number of Transparent-Slave-Parameters supported by slave 
+	OT_TSPindexTSPvalue, // u8 / u8  Index number / Value of referred-to transparent slave parameter. 
+	OT_FHBsize, // u8 / u8  Size of Fault-History-Buffer supported by slave 
+	OT_FHBindexFHBvalue, // u8 / u8  Index number / Value of referred-to fault-history buffer entry. 
+	OT_MaxRelModLevelSetting, // f8.8  Maximum relative modulation level setting (%) 
+	OT_MaxCapacityMinModLevel, // u8 / u8  Maximum boiler capacity (kW) / Minimum boiler modulation level(%) 
+	OT_TrSet, // f8.8  Room Setpoint (°C)
+	OT_RelModLevel, // f8.8  Relative Modulation Level (%) 
+	OT_CHPressure, // f8.8  Water pressure in CH circuit  (bar) 
+	OT_DHWFlowRate, // f8.8  Water flow rate in DHW circuit. (litres/minute) 
+	OT_DayTime, // special / u8  Day of Week and Time of Day 
+	OT_Date, // u8 / u8  Calendar date 
+	OT_Year, // u16  Calendar year 
+	OT_TrSetCH2, // f8.8  Room Setpoint for 2nd CH circuit (°C)
+	OT_Tr, // f8.8  Room temperature (°C)
+	OT_Tboiler, // f8.8  Boiler flow water temperature (°C)
+	OT_Tdhw, // f8.8  DHW temperature (°C)
+	OT_Toutside, // f8.8  Outside temperature (°C)
+	OT_Tret, // f8.8  Return water temperature (°C)
+	OT_Tsolarstorage, // f8.8  Solar storage temperature (°C)
+	OT_Tsolarcollector, // s16  Solar collector temperature (°C)
+	OT_TflowCH2, // f8.8  Flow water temperature CH2 circuit (°C)
+	OT_Tdhw2, // f8.8  Domestic hot water temperature 2 (°C)
+	OT_Texhaust, // s16  Boiler exhaust temperature (°C)
+	OT_Theatexchanger, // f8.8 Heat exchanger temperature (°C)
+	OT_FanSpeed = 35, // u8 / u8  Fan Speed setpoint / actual (Hz)
+	OT_ElectricalCurrentBurnerFlame, // f88 Electrical current through burner flame (µA)
+	OT_TRoomCH2, // f88  Room Temperature for 2nd CH circuit ("°C)
+	OT_RelativeHumidity, // f8.8 Relative Humidity (%)
+	OT_TrOverride2 = 39, // f8.8  Remote override room setpoint 2 (°C)
+	OT_TdhwSetUBTdhwSetLB = 48, // s8 / s8  DHW setpoint upper & lower bounds for adjustment  (°C)
+	OT_MaxTSetUBMaxTSetLB, // s8 / s8  Max CH water setpoint upper & lower bounds for adjustment  (°C)
+	OT_HcratioUBHcratioLB, // s8 / s8  OTC heat curve ratio upper & lower bounds for adjustment  
+	OT_Remoteparameter4boundaries, // s8 / s8  Remote Parameter ratio upper & lower bounds for adjustment
+	OT_Remoteparameter5boundaries, // s8 / s8  Remote Parameter upper & lower bounds for adjustment
+	OT_Remoteparameter6boundaries, // s8 / s8  Remote Parameter upper & lower bounds for adjustment
+	OT_Remoteparameter7boundaries, // s8 / s8  Remote Parameter upper & lower bounds for adjustment
+	OT_Remoteparameter8boundaries, // s8 / s8  Remote Parameter upper & lower bounds for adjustment
+	OT_TdhwSet = 56, // f8.8  DHW setpoint (°C)    (Remote parameter 1)
+	OT_MaxTSet, // f8.8  Max CH water setpoint (°C)  (Remote parameters 2)
+	OT_Hcratio, // f8.8  OTC heat curve ratio (°C)  (Remote parameter 3)
+	OT_Remoteparameter4, // f8.8  Remote parameter 4 (°C)  (Remote parameter 4)
+	OT_Remoteparameter5, // f8.8  Remote parameter 5 (°C)  (Remote parameter 5)
+	OT_Remoteparameter6, // f8.8  Remote parameter 6 (°C)  (Remote parameter 6)
+	OT_Remoteparameter7, // f8.8  Remote parameter 7 (°C)  (Remote parameter 7)
+	OT_Remoteparameter8, // f8.8  Remote parameter 8 (°C)  (Remote parameter 8)
+	OT_StatusVH = 70, // flag8 / flag8 Status Ventilation/Heat recovery
+	OT_ControlSetpointVH, // u8 Control setpoint V/H
+	OT_ASFFaultCodeVH, // flag8 / u8 Aplication Specific Fault Flags/Code V/H
+	OT_DiagnosticCodeVH, // u16 Diagnostic Code V/H
+	OT_ConfigMemberIDVH, // flag8 / u8 Config/Member ID V/H
+	OT_OpenthermVersionVH, // f8.8 OpenTherm Version V/H
+	OT_VersionTypeVH,	// u8 / u8 Version & Type V/H
+	OT_RelativeVentilation, // u8 Relative Ventilation (%)
+	OT_RelativeHumidityExhaustAir, // LB u8 Relative Humidity Exhaust Air (%), HB reserved
+	OT_CO2LevelExhaustAir, // u16 CO2 Level (ppm)
+ 	OT_SupplyInletTemperature,	// f8.8 Supply Inlet Temperature (°C)
+ 	OT_SupplyOutletTemperature, // f8.8 Supply Outlet Temperature(°C)
+ 	OT_ExhaustInletTemperature, // f8.8 Exhaust Inlet Temperature (°C)
+ 	OT_ExhaustOutletTemperature, // f8.8 Exhaust Outlet Temperature (°C)
+	OT_ActualExhaustFanSpeed, // u16 Actual Exhaust Fan Speed (rpm)
+	OT_ActualSupplyFanSpeed, // u16 Actual Supply Fan Speed (rpm) 
+	OT_RemoteParameterSettingVH, // flag8 / flag8 Remote Parameter Setting V/H
+	OT_NominalVentilationValue, // u8 Nominal Ventilation Value
+	OT_TSPNumberVH, // u8 / u8 TSP Number V/H
+	OT_TSPEntryVH,	// u8 / u8 TSP Entry V/H
+	OT_FaultBufferSizeVH, // u8 / u8 Fault Buffer Size V/H
+	OT_FaultBufferEntryVH,	// u8 / u8 Fault Buffer Entry V/H
+	OT_Brand = 93, // u8 / u8 Brand name (index/char)
+	OT_BrandVersion, // u8 / u8 Brand version (index/char)
+	OT_BrandSerialNumber, // u8 / u8 Brand serial number (index/char)
+	OT_CoolingOperationHours, // u16 Cooling operation hours
+	OT_PowerCycles, // u16 Power cycles
+	OT_RFstrengthbatterylevel=98, // special RF sensor status information
+	OT_OperatingMode_HC1_HC2_DHW, // special Remote Override Operating Mode (Heating/DHW)
+	OT_RemoteOverrideFunction, // flag8 / -  Function of manual and program changes in master and remote room setpoint. 
+	OT_SolarStorageMaster,	// flag8 / flag8  Solar Storage  Master flags.
+	OT_SolarStorageASFflags, // flag8 / u8 / Solar Storage OEM-fault-code  flag8 / u8  Application-specific fault flags and OEM fault code 
+	OT_SolarStorageSlaveConfigMemberIDcode, // flag8 / u8  Solar Storage Master Configuration Flags /  Master MemberID Code 
+	OT_SolarStorageVersionType, // u8 / u8 / Solar Storage product version number and type
+	OT_SolarStorageTSP,	// u8 / u8 / Solar Storage Number of Transparent-Slave-Parameters supported
+	OT_SolarStorageTSPindexTSPvalue, // u8 / u8 / Solar Storage Index number / Value of referred-to transparent slave parameter
+	OT_SolarStorageFHBsize, // u8 /u8 / Solar Storage Size of Fault-History-Buffer supported by slave
+	OT_SolarStorageFHBindexFHBvalue, // u8 /u8 / Solar Storage Index number / Value of referred-to fault-history buffer entry
+	OT_ElectricityProducerStarts, // u16 Electricity producer starts
+	OT_ElectricityProducerHours, //u16 Electricity producer hours
+	OT_ElectricityProduction, //u16 Electricity production
+	OT_CumulativeElectricityProduction, // u16 Cumulative Electricity production
+	OT_BurnerUnsuccessfulStarts, // u16 Number of Un-successful burner starts 
+	OT_FlameSignalTooLow, //u16 Number of times flame signal too low
+	OT_OEMDiagnosticCode, // u16  OEM-specific diagnostic/service code 
+	OT_BurnerStarts, // u16  Number of starts burner 
+	OT_CHPumpStarts, // u16  Number of starts CH pump 
+	OT_DHWPumpValveStarts, // u16  Number of starts DHW pump/valve 
+	OT_DHWBurnerStarts, // u16  Number of starts burner during DHW mode 
+	OT_BurnerOperationHours, // u16  Number of hours that burner is in operation (i.e. flame on) 
+	OT_CHPumpOperationHours, // u16  Number of hours that CH pump has been running 
+	OT_DHWPumpValveOperationHours, // u16  Number of hours that DHW pump has been running or DHW valve has been opened 
+	OT_DHWBurnerOperationHours, // u16  Number of hours that burner is in operation during DHW mode 
+	OT_OpenThermVersionMaster, // f8.8  The implemented version of the OpenTherm Protocol Specification in the master. 
+	OT_OpenThermVersionSlave, // f8.8  The implemented version of the OpenTherm Protocol Specification in the slave. 
+	OT_MasterVersion, // u8 / u8  Master product version number and type 
+	OT_SlaveVersion, // u8 / u8  Slave product version number and type
+	// Explicit: ids 128-130 are unassigned OEM space (OTmap[] holds empty
+	// placeholders there). Without the =131 these three would fall on 128/129/130,
+	// three below their real ids, so MsgIDs 131-133 decoded as "Unknown message"
+	// while 128-130 produced label-less output. Numbering per
+	// docs/opentherm specification/New OT data-ids.txt. (TASK-1068)
+	OT_RemehadFdUcodes = 131, // u8 / u8 Remeha dF-/dU-codes
+	OT_RemehaServicemessage, // u8 / u8 Remeha Servicemessage
+	OT_RemehaDetectionConnectedSCU, // u8 / u8 Remeha detection connected SCU’s
+};
+	enum OTtype_t { ot_f88, ot_s16, ot_s8s8, ot_u16, ot_u8u8, ot_flag8, ot_flag8flag8, ot_special, ot_flag8u8, ot_u8, ot_undef}; 
+ 	enum OTmsgcmd_t { OT_READ, OT_WRITE, OT_RW, OT_UNDEF };
+	
+	struct OTlookup_t
+    {
+        int id;
+        OTmsgcmd_t msgcmd;
+        OTtype_t type;
+        const char* label;
+        const char* friendlyname;
+        const char* unit;
+        bool bSlaveEchoesValue;  // ADR-097: false = slave Write-Ack data byte is per-spec undefined; suppress /boiler publication. Default true.
+    };
+
+    constexpr OTlookup_t OTmap[] PROGMEM = {
+        {   0, OT_READ  , ot_flag8flag8,	"Status", "Master and Slave status", "" , true },
+        {   1, OT_WRITE , ot_f88,        	"TSet", "Control setpoint", "°C" , false},
+        {   2, OT_WRITE , ot_flag8u8,    	"MasterConfigMemberIDcode", "Master Config / Member ID", "" , true },
+        {   3, OT_READ  , ot_flag8u8,    	"SlaveConfigMemberIDcode", "Slave Config / Member ID", "" , true },
+        {   4, OT_WRITE , ot_u8u8,       	"Command", "Command-Code", "" , true },
+		{   5, OT_READ  , ot_flag8u8,    	"ASFflags", "Application-specific fault", "" , true },
+		{   6, OT_READ  , ot_flag8flag8,    "RBPflags", "Remote-parameter flags", "" , true },
+		{   7, OT_WRITE , ot_f88,        	"CoolingControl", "Cooling control signal", "%" , false},
+		{   8, OT_WRITE , ot_f88,        	"TsetCH2", "Control setpoint for 2e CH circuit", "°C" , false},
+		{   9, OT_READ  , ot_f88,        	"TrOverride", "Remote override room setpoint", "°C" , true },
+		{  10, OT_READ  , ot_u8u8,       	"TSP", "Number of TSPs", "" , true },
+		{  11, OT_RW    , ot_u8u8,       	"TSPindexTSPvalue", "Index number / Value of referred-to transparent slave parameter", "" , true },
+		{  12, OT_READ  , ot_u8u8,       	"FHBsize", "Size of Fault-History-Buffer supported by slave", "" , true },
+		{  13, OT_READ  , ot_u8u8,       	"FHBindexFHBvalue", "Index number / Value of referred-to fault-history buffer entry", "" , true },
+		{  14, OT_WRITE , ot_f88,        	"MaxRelModLevelSetting", "Maximum relative modulation level setting", "%" , false},
+		{  15, OT_READ  , ot_u8u8,       	"MaxCapacityMinModLevel", "Maximum boiler capacity (kW) / Minimum boiler modulation level(%)", "kW/%" , true },
+		{  16, OT_WRITE , ot_f88,        	"TrSet", "Room Setpoint", "°C" , false},
+		{  17, OT_READ  , ot_f88,        	"RelModLevel", "Relative Modulation Level", "%" , true },
+		{  18, OT_READ  , ot_f88,        	"CHPressure", "CH water pressure", "bar" , true },
+		{  19, OT_READ  , ot_f88,        	"DHWFlowRate", "DHW flow rate", "l/min" , true },
+		{  20, OT_RW    , ot_special,    	"DayTime", "Day of Week and Time of Day", "" , true },
+		{  21, OT_RW    , ot_u8u8,       	"Date", "Calendar date ", "" , true },
+		{  22, OT_RW    , ot_u16,        	"Year", "Calendar year", "" , true },
+		{  23, OT_WRITE , ot_f88,        	"TrSetCH2", "Room Setpoint CH2", "°C" , false},
+		{  24, OT_WRITE , ot_f88,        	"Tr", "Room Temperature", "°C" , false},
+		{  25, OT_READ  , ot_f88,        	"Tboiler", "Boiler water temperature", "°C" , true },
+		{  26, OT_READ  , ot_f88,        	"Tdhw", "DHW temperature", "°C" , true },
+		{  27, OT_RW    , ot_f88,        	"Toutside", "Outside temperature", "°C" , true },
+		{  28, OT_READ  , ot_f88,        	"Tret", "Return water temperature", "°C" , true },
+		{  29, OT_READ  , ot_f88,        	"Tsolarstorage", "Solar storage temperature", "°C" , true },
+		{  30, OT_READ  , ot_s16,        	"Tsolarcollector", "Solar collector temperature", "°C" , true },
+		{  31, OT_READ  , ot_f88,        	"TflowCH2", "Flow water temperature CH2", "°C" , true },
+		{  32, OT_READ  , ot_f88,        	"Tdhw2", "DHW2 temperature", "°C" , true },
+		{  33, OT_READ  , ot_s16,        	"Texhaust", "Exhaust temperature", "°C" , true },
+		{  34, OT_READ  , ot_f88, 	 	 	"Theatexchanger", "Boiler heat exchanger temperature", "°C" , true },
+		{  35, OT_READ  , ot_u8u8,	 	 	"FanSpeed", "Boiler fan speed and setpoint", "Hz" , true },
+		{  36, OT_READ  , ot_f88, 			"ElectricalCurrentBurnerFlame", "Electrical current through burner flame", "µA" , true },
+		{  37, OT_WRITE , ot_f88, 			"TRoomCH2", "Room temperature for 2nd CH circuit", "°C" , false},
+		{  38, OT_RW    , ot_f88, 			"RelativeHumidity", "Relative Humidity", "%" , false}, // OTv4.2 spec §5.3: f8.8 combined (−128.00–+127.996 %); some early Remeha docs described this as u8/u8 but the authoritative v4.2 spec uses f8.8
+		{  39, OT_READ  , ot_f88, 			"TrOverride2", "Remote override room setpoint 2", "°C" , true },
+		{  40, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  41, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  42, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  43, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  44, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  45, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  46, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  47, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  48, OT_READ  , ot_s8s8,        	"TdhwSetUBTdhwSetLB", "DHW setpoint upper & lower bounds for adjustment", "°C" , true },
+		{  49, OT_READ  , ot_s8s8,        	"MaxTSetUBMaxTSetLB", "Max CH water setpoint upper & lower bounds for adjustment", "°C" , true },
+		{  50, OT_READ  , ot_s8s8,        	"HcratioUBHcratioLB", "OTC heat curve ratio upper & lower bounds for adjustment", "°C" , true },
+		{  51, OT_READ  , ot_s8s8, 		  	"Remoteparameter4boundaries", "Remote parameter 4 boundaries", "" , true },
+		{  52, OT_READ  , ot_s8s8, 		  	"Remoteparameter5boundaries", "Remote parameter 5 boundaries", "" , true },
+		{  53, OT_READ  , ot_s8s8, 		  	"Remoteparameter6boundaries", "Remote parameter 6 boundaries", "" , true },
+		{  54, OT_READ  , ot_s8s8, 		  	"Remoteparameter7boundaries", "Remote parameter 7 boundaries", "" , true },
+		{  55, OT_READ  , ot_s8s8, 		  	"Remoteparameter8boundaries", "Remote parameter 8 boundaries", "" , true },
+		{  56, OT_RW    , ot_f88,         	"TdhwSet", "DHW setpoint", "°C" , true },
+		{  57, OT_RW    , ot_f88,         	"MaxTSet", "Max CH water setpoint", "°C" , true },
+		{  58, OT_RW    , ot_f88,         	"Hcratio", "OTC heat curve ratio", "°C" , true },
+		{  59, OT_RW 	, ot_f88, 		  	"Remoteparameter4", "Remote parameter 4", "" , true },
+		{  60, OT_RW 	, ot_f88,         	"Remoteparameter5", "Remote parameter 5", "" , true },
+		{  61, OT_RW 	, ot_f88,         	"Remoteparameter6", "Remote parameter 6", "" , true },
+		{  62, OT_RW 	, ot_f88,         	"Remoteparameter7", "Remote parameter 7", "" , true },
+		{  63, OT_RW 	, ot_f88,         	"Remoteparameter8", "Remote parameter 8", "" , true },
+		{  64, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  65, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  66, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  67, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  68, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  69, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  70, OT_READ  , ot_flag8flag8,  	"StatusVH", "Status Ventilation/Heat recovery", "" , true },
+		{  71, OT_WRITE , ot_u8, 			"ControlSetpointVH", "Control setpoint V/H", "%" , false},
+		{  72, OT_READ  , ot_flag8u8, 		"ASFFaultCodeVH", "Application-specific Fault Flags/Code V/H", "" , true },
+		{  73, OT_READ  , ot_u16,		 	"DiagnosticCodeVH", "Diagnostic code V/H", "" , true },
+		{  74, OT_READ  , ot_flag8u8,		"ConfigMemberIDVH", "Config/Member ID V/H", "" , true },
+		{  75, OT_READ  , ot_f88, 			"OpenthermVersionVH", "OpenTherm version V/H", "" , true },
+		{  76, OT_READ  , ot_u8u8, 			"VersionTypeVH", "Product version & type V/H", "" , true },
+		{  77, OT_READ  , ot_u8, 			"RelativeVentilation", "Relative ventilation", "%" , true },
+		{  78, OT_RW    , ot_u8, 			"RelativeHumidityExhaustAir", "Relative humidity exhaust air", "%" , true },
+		{  79, OT_RW    , ot_u16, 			"CO2LevelExhaustAir", "CO2 level exhaust air", "ppm" , true },
+ 		{  80, OT_READ  , ot_f88, 			"SupplyInletTemperature", "Supply inlet temperature", "°C" , true },
+ 		{  81, OT_READ  , ot_f88, 			"SupplyOutletTemperature", "Supply outlet temperature", "°C" , true },
+ 		{  82, OT_READ  , ot_f88, 			"ExhaustInletTemperature", "Exhaust inlet temperature", "°C" , true },
+ 		{  83, OT_READ  , ot_f88, 			"ExhaustOutletTemperature", "Exhaust outlet temperature", "°C" , true },
+		{  84, OT_READ  , ot_u16, 			"ActualExhaustFanSpeed", "Actual exhaust fan speed", "rpm" , true },
+		{  85, OT_READ  , ot_u16, 			"ActualSupplyFanSpeed", "Actual supply fan speed", "rpm" , true },
+		{  86, OT_READ  , ot_flag8flag8, 	"RemoteParameterSettingVH", "Remote Parameter Setting V/H", "" , true },
+		{  87, OT_RW 	, ot_u8, 			"NominalVentilationValue", "Nominal Ventilation Value", "%" , true },
+		{  88, OT_READ  , ot_u8u8, 			"TSPNumberVH", "TSP Number V/H", "" , true },
+		{  89, OT_RW    , ot_u8u8, 			"TSPEntryVH", "TSP setting V/H", "" , true },
+		{  90, OT_READ  , ot_u8u8, 			"FaultBufferSizeVH", "Fault Buffer Size V/H", "" , true },
+		{  91, OT_READ  , ot_u8u8, 			"FaultBufferEntryVH", "Fault Buffer Entry V/H", "" , true },
+		{  92, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{  93, OT_READ  , ot_u8u8, 			"Brand", "Boiler brand name (index/char)", "" , true },
+		{  94, OT_READ  , ot_u8u8, 			"BrandVersion", "Boiler brand version (index/char)", "" , true },
+		{  95, OT_READ  , ot_u8u8, 			"BrandSerialNumber", "Boiler brand serial number (index/char)", "" , true },
+		{  96, OT_RW    , ot_u16, 			"CoolingOperationHours", "Cooling operation hours", "hrs" , true },
+		{  97, OT_RW    , ot_u16, 			"PowerCycles", "Power cycles", "" , true },
+		{  98, OT_WRITE , ot_special, 		"RFstrengthbatterylevel", "RF sensor status information", "" , false},
+		{  99, OT_RW    , ot_special, 		"OperatingMode_HC1_HC2_DHW", "Remote Override Operating Mode (Heating/DHW)", "" , true },
+		{ 100, OT_READ  , ot_flag8,       	"RoomRemoteOverrideFunction", "Function of manual and program changes in master and remote room setpoint.", "" , true },
+		{ 101, OT_READ  , ot_flag8flag8, 	"SolarStorageMaster", "Solar Storage Master mode", "" , true },
+		{ 102, OT_READ  , ot_flag8u8,    	"SolarStorageASFflags", "Solar Storage Application-specific flags and OEM fault", "" , true },
+        { 103, OT_READ  , ot_flag8u8,    	"SolarStorageSlaveConfigMemberIDcode", "Solar Storage Slave Config / Member ID", "" , true },
+		{ 104, OT_READ  , ot_u8u8,        	"SolarStorageVersionType", "Solar Storage product version number and type", "" , true },
+		{ 105, OT_READ  , ot_u8u8,       	"SolarStorageTSP", "Solar Storage Number of Transparent-Slave-Parameters supported", "" , true },
+		{ 106, OT_RW    , ot_u8u8,       	"SolarStorageTSPindexTSPvalue", "Solar Storage Index number / Value of referred-to transparent slave parameter", "" , true },
+		{ 107, OT_READ  , ot_u8u8,       	"SolarStorageFHBsize", "Solar Storage Size of Fault-History-Buffer supported by slave", "" , true },
+		{ 108, OT_READ  , ot_u8u8,       	"SolarStorageFHBindexFHBvalue", "Solar Storage Index number / Value of referred-to fault-history buffer entry", "" , true },
+		{ 109, OT_RW    , ot_u16, 			"ElectricityProducerStarts", "Electricity producer starts", "" , true },
+		{ 110, OT_RW    , ot_u16, 			"ElectricityProducerHours", "Electricity producer hours", "" , true },
+		{ 111, OT_READ  , ot_u16, 			"ElectricityProduction", "Electricity production", "" , true },
+		{ 112, OT_RW    , ot_u16, 			"CumulativeElectricityProduction", "Cumulative Electricity production", "" , true },
+		{ 113, OT_RW    , ot_u16,         	"BurnerUnsuccessfulStarts", "Unsuccessful burner starts", "" , true },
+		{ 114, OT_RW    , ot_u16,         	"FlameSignalTooLow", "Flame signal too low count", "" , true },
+		{ 115, OT_READ  , ot_u16,         	"OEMDiagnosticCode", "OEM-specific diagnostic/service code", "" , true },
+		{ 116, OT_RW    , ot_u16,         	"BurnerStarts", "Burner starts", "" , true },
+		{ 117, OT_RW    , ot_u16,         	"CHPumpStarts", "CH pump starts", "" , true },
+		{ 118, OT_RW    , ot_u16,         	"DHWPumpValveStarts", "DHW pump/valve starts", "" , true },
+		{ 119, OT_RW    , ot_u16,         	"DHWBurnerStarts", "DHW burner starts", "" , true },
+		{ 120, OT_RW    , ot_u16,         	"BurnerOperationHours", "Burner operation hours", "hrs" , true },
+		{ 121, OT_RW    , ot_u16,         	"CHPumpOperationHours", "CH pump operation hours", "hrs" , true },
+		{ 122, OT_RW    , ot_u16,         	"DHWPumpValveOperationHours", "DHW pump/valve operation hours", "hrs" , true },
+		{ 123, OT_RW    , ot_u16,         	"DHWBurnerOperationHours", "DHW burner operation hours", "hrs" , true },
+		{ 124, OT_WRITE , ot_f88,			"OpenThermVersionMaster", "Master Version OpenTherm Protocol Specification", "" , true },
+		{ 125, OT_READ  , ot_f88,			"OpenThermVersionSlave", "Slave Version OpenTherm Protocol Specification", "" , true },
+		{ 126, OT_WRITE , ot_u8u8,			"MasterVersion", "Master product version number and type", "" , true },
+		{ 127, OT_READ  , ot_u8u8,			"SlaveVersion", "Slave product version number and type", "" , true },
+		{ 128, OT_UNDEF , ot_undef,			"", "", "" , true },
+		{ 129, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{ 130, OT_UNDEF , ot_undef, 		"", "", "" , true },
+		{ 131, OT_RW 	, ot_u8u8, 			"RemehadFdUcodes", "Remeha dF-/dU-codes", "" , true },
+		{ 132, OT_READ 	, ot_u8u8, 			"RemehaServicemessage", "Remeha Servicemessage", "" , true },
+		{ 133, OT_READ 	, ot_u8u8, 			"RemehaDetectionConnectedSCU", "Remeha detection connected SCU’s", "" , true },
+		// all data ids are not defined above are resevered for future use
+		// A foney id is used for sensors on GPIO ports, 
+ 		// 245 for counter and 
+ 		// 246 for Dallas temperature sensors
+	};
+
+#define OT_MSGID_MAX 133
+
+#endif // OTMAP_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
@@ -0,0 +1,180 @@
+/*
+***************************************************************************
+**  Program  : OTmonDelta.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Change generations for GET /api/v2/otgw/otmonitor (sendOTmonitorV2()
+**  in restAPI.ino), so a poller can ask "what changed since I last looked"
+**  instead of receiving every field on every poll.
+**
+**  OT side: processOT() keeps one 32-bit counter in the decoded state
+**  (OTdataStruct::gen). Each REST-tracked message slot remembers the
+**  counter value of its last value change (genSlot[]): a frame whose raw
+**  16-bit value differs from the previous one, or the first frame after
+**  boot or a clear, takes ++gen. A frame that repeats the value does not.
+**  clearMsgLastUpdated() takes ++gen as well and records it in genReset,
+**  because fields disappear then and a delta cannot say so.
+**
+**  Aux side: S0, sensor simulation and the Dallas sensors are not OT
+**  messages. The REST handler hashes their values (FNV-1a) and their
+**  layout (which entries exist) per request; otmonAuxUpdate() turns a
+**  changed hash into a new aux generation, a changed layout into a reset.
+**
+**  The token handed to the client is "<boot>-<gen>-<aux>", boot being a
+**  random per-boot tag so a token from before a reboot never matches.
+**  It goes out as the ETag and as "gen" in the body; the client returns
+**  it as ?since= or If-None-Match:
+**
+**    same token                       -> 304, no body
+**    other boot, from the future,
+**    or older than a reset            -> full response
+**    otherwise                        -> delta: OT fields with a slot
+**                                        generation above since.gen, all
+**                                        aux fields if aux moved on
+**
+**  No Arduino dependency: tests/test_otmon_delta.cpp includes this header
+**  directly.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef OTMONDELTA_H
+#define OTMONDELTA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define OTMON_TOKEN_LEN 32                // "ffffffff-4294967295-4294967295" + NUL
+
+struct OTmonToken {
+  uint32_t boot;
+  uint32_t gen;
+  uint32_t aux;
+};
+
+enum OTmonReply : uint8_t { OTMON_REPLY_FULL, OTMON_REPLY_DELTA, OTMON_REPLY_NOT_MODIFIED };
+
+// Aux generation state, owned by the REST handler.
+struct OTmonAux {
+  uint32_t gen        = 0;
+  uint32_t reset      = 0;                // generation of the last layout change
+  uint32_t valueHash  = 0;
+  uint32_t layoutHash = 0;
+  bool     seen       = false;
+};
+
+#define OTMON_FNV_INIT 2166136261UL
+
+inline uint32_t otmonFnv1a(uint32_t h, const void *p, size_t len)
+{
+  const uint8_t *b = (const uint8_t *)p;
+  for (size_t i = 0; i < len; i++) {
+    h ^= b[i];
+    h *= 16777619UL;
+  }
+  return h;
+}
+
+// processOT(): a tracked message arrived with raw value `raw`. Bumps gen and
+// the slot's generation when the value is new; `seen` is the caller's "slot
+// has a value" flag, set here.
+inline void otmonGenNote(uint32_t &gen, uint32_t &slotGen, uint16_t &lastRaw, bool &seen, uint16_t raw)
+{
+  if (seen && lastRaw == raw) return;
+  seen    = true;
+  lastRaw = raw;
+  slotGen = ++gen;
+}
+
+// clearMsgLastUpdated(): every field is gone; older tokens get a full reply.
+inline void otmonGenReset(uint32_t &gen, uint32_t &genReset)
+{
+  genReset = ++gen;
+}
+
+// Per request, with the hashes of the aux entries as they are now.
+inline void otmonAuxUpdate(OTmonAux &a, uint32_t layoutHash, uint32_t valueHash)
+{
+  if (!a.seen || layoutHash != a.layoutHash) {
+    a.reset = ++a.gen;
+  } else if (valueHash != a.valueHash) {
+    ++a.gen;
+  }
+  a.seen       = true;
+  a.layoutHash = layoutHash;
+  a.valueHash  = valueHash;
+}
+
+// Unquoted "<boot hex>-<gen>-<aux>".
+inline void otmonTokenFormat(const OTmonToken &t, char *buf, size_t len)
+{
+  snprintf(buf, len, "%08lx-%lu-%lu", (unsigned long)t.boot, (unsigned long)t.gen, (unsigned long)t.aux);
+}
+
+// Accepts the token with or without the ETag quotes (and a W/ prefix, which
+// some proxies add). False on anything else.
+inline bool otmonTokenParse(const char *s, OTmonToken &t)
+{
+  if (!s) return false;
+  if (s[0] == 'W' && s[1] == '/') s += 2;
+  const bool quoted = (*s == '"');
+  if (quoted) s++;
+  // strtoull() alone would also take blanks, a sign and "0x".
+  auto digit = [](char c, bool hex) {
+    return (c >= '0' && c <= '9') || (hex && ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')));
+  };
+  char *end = nullptr;
+  if (!digit(*s, true) || (s[0] == '0' && (s[1] == 'x' || s[1] == 'X'))) return false;
+  const unsigned long long boot = strtoull(s, &end, 16);
+  if (*end != '-') return false;
+  s = end + 1;
+  if (!digit(*s, false)) return false;
+  const unsigned long long gen = strtoull(s, &end, 10);
+  if (*end != '-') return false;
+  s = end + 1;
+  if (!digit(*s, false)) return false;
+  const unsigned long long aux = strtoull(s, &end, 10);
+  if (quoted && *end++ != '"') return false;
+  if (*end != '\0') return false;
+  if (boot > 0xFFFFFFFFULL || gen > 0xFFFFFFFFULL || aux > 0xFFFFFFFFULL) return false;
+  t.boot = (uint32_t)boot;
+  t.gen  = (uint32_t)gen;
+  t.aux  = (uint32_t)aux;
+  return true;
+}
+
+// since == nullptr: the client sent no (parsable) token.
+inline OTmonReply otmonDecide(const OTmonToken &cur, const OTmonToken *since,
+                              uint32_t genReset, uint32_t auxReset)
+{
+  if (!since || since->boot != cur.boot) return OTMON_REPLY_FULL;
+  if (since->gen > cur.gen || since->gen < genReset) return OTMON_REPLY_FULL;
+  if (since->aux > cur.aux || since->aux < auxReset) return OTMON_REPLY_FULL;
+  if (since->gen == cur.gen && since->aux == cur.aux) return OTMON_REPLY_NOT_MODIFIED;
+  return OTMON_REPLY_DELTA;
+}
+
+#endif // OTMONDELTA_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
@@ -0,0 +1,175 @@
+/*
+***************************************************************************
+**  Program  : SATQuantile.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Incremental quantile estimators for the SAT cycle statistics
+**  (SATcycles.ino).
+**
+**  The cycle tracker used to answer every percentile by copying its sample
+**  ring and insertion-sorting it: three sorts per flame-off for the tail
+**  window, two more for the full-cycle flow, and a 360-entry sort of the 4h
+**  flow-return deltas on every stats tick. The two shapes of data get two
+**  estimators, each updated as samples arrive:
+**
+**    SATFlowHistogram    quantiles of an unbounded stream of temperatures:
+**                        counts in 0.25 °C bins over 0..100 °C (800 bytes),
+**                        O(1) per sample, one walk over the bins per query.
+**                        Used for the full-cycle flow p10/p90, which has no
+**                        eviction: the cycle resets it. A cycle is a ramp
+**                        sampled at loop rate, the worst case for marker
+**                        sketches such as P² (which drift by degrees at p10
+**                        on such input); the histogram is within half a bin
+**                        whatever the order.
+**    SATOrderWindow<N>   exact order statistics of a bounded sliding window:
+**                        a sorted copy of the window kept up to date with a
+**                        binary-search insert on arrival and erase on
+**                        eviction, O(1) query. The 180 s tail window and
+**                        the 4h window (time-expired) use this; N floats,
+**                        the same RAM as the sort scratch it replaces.
+**
+**  Both answer a percentile at the rank the old sorts used: element
+**  pct * (n - 1) / 100 (integer division) of the sorted samples. The window
+**  is exact; the histogram returns the middle of that element's bin.
+**
+**  No Arduino dependency: tests/test_sat_quantile.cpp checks both against
+**  exact percentiles on recorded and synthetic boiler cycles.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef SATQUANTILE_H
+#define SATQUANTILE_H
+
+#include <stdint.h>
+#include <string.h>
+
+// ---------------------------------------------------------------------------
+// SATFlowHistogram: everything add()ed since reset(), binned. Samples below
+// 0 °C or from 100 °C up count in the first or last bin. A bin that would
+// overflow halves every bin, which keeps the shape of the distribution.
+// NaN is neither stored nor counted.
+// ---------------------------------------------------------------------------
+class SATFlowHistogram {
+public:
+  static constexpr uint16_t kBinsPerDegree = 4;
+  static constexpr uint16_t kBins = 100 * kBinsPerDegree;
+
+  void reset() {
+    memset(_bin, 0, sizeof(_bin));
+    _total = 0;
+    _count = 0;
+  }
+
+  // Samples added since reset() (not reduced by halving).
+  uint32_t count() const { return _count; }
+
+  void add(float x) {
+    if (x != x) return;
+    int32_t b = (int32_t)(x * (float)kBinsPerDegree);
+    if (x < 0.0f) b = 0;                    // also keeps the cast in range
+    if (b >= (int32_t)kBins) b = kBins - 1;
+    if (_bin[b] == 0xFFFF) halve();
+    _bin[b]++;
+    _total++;
+    _count++;
+  }
+
+  // Middle of the bin holding element pct * (n - 1) / 100; 0 when empty.
+  float percentile(uint8_t pct) const {
+    if (_total == 0) return 0.0f;
+    const uint32_t rank = (uint32_t)pct * (_total - 1) / 100;
+    uint32_t seen = 0;
+    uint16_t b = 0;
+    for (; b < kBins - 1; b++) {
+      seen += _bin[b];
+      if (seen > rank) break;
+    }
+    return ((float)b + 0.5f) / (float)kBinsPerDegree;
+  }
+
+private:
+  void halve() {
+    _total = 0;
+    for (uint16_t b = 0; b < kBins; b++) { _bin[b] = (uint16_t)((_bin[b] + 1) / 2); _total += _bin[b]; }
+  }
+
+  uint16_t _bin[kBins] = {};
+  uint32_t _total = 0;   // sum of _bin[]
+  uint32_t _count = 0;
+};
+
+// ---------------------------------------------------------------------------
+// SATOrderWindow<N>: the samples currently inside a window, sorted. The
+// owner keeps the window itself (ring + eviction rule) and mirrors it here:
+// insert() on arrival, erase() with the same value on eviction. NaN is
+// neither stored nor counted.
+// ---------------------------------------------------------------------------
+template <uint16_t N>
+class SATOrderWindow {
+public:
+  void clear() { _n = 0; }
+  uint16_t size() const { return _n; }
+
+  bool insert(float x) {
+    if (x != x || _n >= N) return false;
+    const uint16_t i = upperBound(x);
+    memmove(&_v[i + 1], &_v[i], (size_t)(_n - i) * sizeof(float));
+    _v[i] = x;
+    _n++;
+    return true;
+  }
+
+  bool erase(float x) {
+    if (x != x) return false;
+    const uint16_t i = lowerBound(x);
+    if (i >= _n || _v[i] != x) return false;
+    memmove(&_v[i], &_v[i + 1], (size_t)(_n - i - 1) * sizeof(float));
+    _n--;
+    return true;
+  }
+
+  // Element pct * (n - 1) / 100 of the sorted window; 0 when empty.
+  float percentile(uint8_t pct) const {
+    if (_n == 0) return 0.0f;
+    return _v[(uint32_t)pct * (_n - 1) / 100];
+  }
+
+private:
+  uint16_t lowerBound(float x) const {
+    uint16_t lo = 0, hi = _n;
+    while (lo < hi) { const uint16_t m = (uint16_t)((lo + hi) / 2); if (_v[m] < x) lo = m + 1; else hi = m; }
+    return lo;
+  }
+  uint16_t upperBound(float x) const {
+    uint16_t lo = 0, hi = _n;
+    while (lo < hi) { const uint16_t m = (uint16_t)((lo + hi) / 2); if (_v[m] <= x) lo = m + 1; else hi = m; }
+    return lo;
+  }
+
+  float    _v[N];
+  uint16_t _n = 0;
+};
+
+#endif // SATQUANTILE_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
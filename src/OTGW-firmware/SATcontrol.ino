@@ -1967,6 +1967,260 @@ struct SatStatusSnap {
   char     phaseName[24];
 };
 
+// Forward declarations — prevent the ESP32 auto-prototype conflict (SatStatusSnap not yet visible at sketch top)
+static void satFillStatusSnap(SatStatusSnap& snap);
+static void satEmitStatus(JsonEmit& je, const SatStatusSnap& s);
+
+// Freeze every volatile input ONCE (see SatStatusSnap above). Helpers are called
+// in their original relative order so any side-effects (satGetOutsideTemp resolves
+// its own staleness AFTER satGetRoomTemp) match the pre-chunked behaviour.
+static void satFillStatusSnap(SatStatusSnap& snap)
+{
+  snap.st            = state;                          // en-bloc freeze of all state.*
+  satGetBoilerStatusName(snap.boilerStatus, sizeof(snap.boilerStatus));
+  snap.roomTemp      = satGetRoomTemp();
+  snap.outsideTemp   = satGetOutsideTemp();
+  snap.cyclesThisHour   = satCycleGetCyclesThisHour();
+  strlcpy(snap.phaseName, satCycleGetPhaseName(), sizeof(snap.phaseName));
+  snap.phaseDurationSec = satCycleGetPhaseDurationSec();
+  satGetManufacturerName(snap.manufacturer, sizeof(snap.manufacturer));
+  snap.maxSetpoint   = satGetMaxSetpoint();
+  snap.boilerHwPresent = satBoilerHardwarePresent();
+  snap.otToutside    = OTcurrentSystemState.Toutside;
+  snap.otSlaveConfigMemberIDcode = OTcurrentSystemState.SlaveConfigMemberIDcode;
+  snap.nowMs         = millis();
+  snap.bleFailoverActive = satBLEFailoverActive();
+}
+
+// The status document. Reads ONLY s.*, settings.sat.* and literals (see the
+// DETERMINISM GATE in satSendStatusJSON()).
+static void satEmitStatus(JsonEmit& je, const SatStatusSnap& s)
+{
+  je.beginObject();
+  je.field(F("enabled"),              settings.sat.bEnabled);
+  je.field(F("active"),               s.st.sat.bActive);
+  je.field(F("control_mode"),         (int32_t)s.st.sat.eControlMode);
+  je.field(F("boiler_status"),        s.boilerStatus);
+  je.field(F("target_temp"),          settings.sat.fTargetTemp);
+  je.field(F("room_temp"),            s.roomTemp);
+  // TASK-886 review M1: distinguish "no reading" from a real 0 °C. room_temp
+  // already arrives as NaN->null when no thermostat exists; mirror that for the
+  // other two no-source-prone tiles so the UI shows "--" instead of a misleading
+  // "0.00°C". The outside-temp helper was called FIRST at snapshot time (it
+  // resolves its own staleness side-effects), then if no live source remains AND it fell
+  // through to the bare OT-bus 0.0f (the firmware's own no-sensor convention, see
+  // line ~1113) it is emitted as null. final_setpoint is only meaningful active.
+  {
+    float outsideDisp = s.outsideTemp;
+    bool outsideHasSource = settings.sat.bSimulation || s.st.sat.bExternalOutdoorValid ||
+                            (s.st.sat.weather.bValid && s.otToutside == 0.0f);
+    if (!outsideHasSource && outsideDisp == 0.0f) outsideDisp = NAN;
+    je.field(F("outside_temp"),       outsideDisp);
+  }
+  je.field(F("heating_curve"),        s.st.sat.fHeatingCurveValue);
+  je.field(F("pid_output"),           s.st.sat.fPidOutput);
+  je.field(F("final_setpoint"),       s.st.sat.bActive ? s.st.sat.fFinalSetpoint : NAN);
+  je.field(F("error"),                s.st.sat.fError);
+  je.field(F("pid_p"),                s.st.sat.fPidP);
+  je.field(F("pid_i"),                s.st.sat.fPidI);
+  je.field(F("pid_d"),                s.st.sat.fPidD);
+  je.field(F("kp"),                   s.st.sat.fKp, 6);
+  je.field(F("ki"),                   s.st.sat.fKi, 6);
+  je.field(F("kd"),                   s.st.sat.fKd, 6);
+  je.field(F("raw_derivative"),       s.st.sat.fRawDerivative);
+  je.field(F("coefficient"),          settings.sat.fHeatingCurveCoeff);
+  je.field(F("deadband"),             settings.sat.fDeadband);
+  je.field(F("overshoot_margin"),     settings.sat.fOvershootMargin);
+  je.field(F("cycle_count"),          s.st.sat.iCycleCount);
+  je.field(F("cycles_this_hour"),     (int32_t)s.cyclesThisHour);
+  je.field(F("last_cycle_class"),     (int32_t)s.st.sat.eLastCycleClass);
+  je.field(F("cycle_max_flow"),       s.st.sat.fCycleMaxFlow);
+  je.field(F("cycle_overshoot_sec"),  s.st.sat.fCycleOvershootSec);
+  je.field(F("duty_ratio"),           s.st.sat.fDutyRatio);
+  je.field(F("overshoot_fraction"),   s.st.sat.fOvershootFraction);
+  je.field(F("underheat_fraction"),   s.st.sat.fUnderheatFraction);
+  // TASK-891.4 classifier-depth parity metrics
+  je.field(F("cycle_req_setpoint_error"),  s.st.sat.fCycleReqSetpointError);
+  je.field(F("cycle_time_in_band_sec"),    s.st.sat.fCycleTimeInBandSec);
+  je.field(F("cycle_total_overshoot_sec"), s.st.sat.fCycleTotalOvershootSec);
+  je.field(F("cycle_t_first_overshoot"),   s.st.sat.fCycleTimeToFirstOvershoot);
+  je.field(F("cycle_t_sustained_overshoot"), s.st.sat.fCycleTimeToSustainedOvershoot);
+  je.field(F("off_with_demand_sec"),       s.st.sat.fOffWithDemandSec);
+  je.field(F("24h_cycles"),                (int32_t)s.st.sat.i24hCycles);
+  je.field(F("24h_duty_ratio"),            s.st.sat.f24hDutyRatio);
+  je.field(F("24h_overshoot_fraction"),    s.st.sat.f24hOvershootFraction);
+  je.field(F("24h_underheat_fraction"),    s.st.sat.f24hUnderheatFraction);
+  je.field(F("24h_long_cycle_fraction"),   s.st.sat.f24hLongCycleFraction);
+  je.field(F("cycle_phase"),          s.phaseName);
+  je.field(F("phase_duration_sec"),   (int32_t)s.phaseDurationSec);
+  je.field(F("pwm_duty"),             s.st.sat.fPwmDutyCycle);
+  je.field(F("pwm_flame_req"),        s.st.sat.bPwmFlameRequested);
+  je.field(F("active_preset"),        (int32_t)s.st.sat.eActivePreset);
+  je.field(F("mod_suppressed"),       s.st.sat.bModSuppressed);
+  je.field(F("dhw_active"),           s.st.sat.bDhwActive);
+  je.field(F("dhw_setpoint"),         settings.sat.fDhwSetpoint);
+  // TASK-516: boiler-gated master DHW enable. dhw_config_tank is derived from
+  // MsgID 3 HB3 (bit 11 of the uint16 SlaveConfigMemberIDcode); the UI uses it to
+  // decide whether to render the toggle. dhw_enable mirrors the user setting; only
+  // acted on (HW=) when dhw_config_tank=true.
+  je.field(F("dhw_config_tank"),      (bool)(s.otSlaveConfigMemberIDcode & 0x0800));
+  je.field(F("dhw_enable"),           settings.sat.bDhwEnable);
+  je.field(F("control_interval_sec"), (int32_t)settings.sat.iControlInterval);
+  je.field(F("fallback_active"),      s.st.sat.bFallbackActive);
+  je.field(F("fallback_reason"),      (int32_t)s.st.sat.eFallbackReason);
+  je.field(F("max_rel_modulation"),   (int32_t)settings.sat.iMaxRelModulation);
+  je.field(F("current_modulation"),   (int32_t)s.st.sat.iCurrentModulation);
+  je.field(F("heating_system"),       (int32_t)settings.sat.iHeatingSystem);
+  je.field(F("heating_source"),          (int32_t)settings.sat.iHeatingSource);
+  je.field(F("heating_source_detected"), (int32_t)s.st.sat.iDetectedHeatingSource);
+  je.field(F("manufacturer"),         s.manufacturer);
+  je.field(F("manufacturer_setting"), (int32_t)settings.sat.iManufacturer);
+  je.field(F("manufacturer_detected"), (int32_t)s.st.sat.iDetectedManufacturer);
+  je.field(F("slave_memberid"),       (int32_t)s.st.sat.iSlaveMemberID);
+  je.field(F("max_setpoint_system"),  s.maxSetpoint);
+  je.field(F("external_temp_valid"),  s.st.sat.bExternalTempValid);
+  je.field(F("external_outdoor_valid"), s.st.sat.bExternalOutdoorValid);
+  // PV-surplus boost (TASK-640)
+  je.field(F("pv_surplus_w"),         s.st.sat.fExternalPvSurplusW);
+  je.field(F("pv_surplus_valid"),     s.st.sat.bExternalPvSurplusValid);
+  je.field(F("pv_boost_active"),      s.st.sat.bPvBoostActive);
+  je.field(F("pv_boost_applied_c"),   s.st.sat.fPvBoostAppliedC);
+  je.field(F("pv_boost_enabled"),     settings.sat.bPvBoostEnabled);
+  je.field(F("safety_tripped"),       s.st.sat.bSafetyTripped);
+  je.field(F("valves_open"),          s.st.sat.bValvesOpen);
+  je.field(F("window_open"),          s.st.sat.bWindowOpen);
+  je.field(F("window_detection"),     settings.sat.bWindowDetection);
+  je.field(F("push_setpoint"),        settings.sat.bPushSetpoint);
+  je.field(F("flame_off_offset"),     settings.sat.fFlameOffOffset);
+  je.field(F("force_pwm"),            settings.sat.bForcePWM);
+  je.field(F("flow_offset"),          settings.sat.fFlowOffset);
+  je.field(F("pressure"),             s.st.sat.fSmoothedPressure);
+  je.field(F("pressure_drop_rate"),   s.st.sat.fPressureDropRate);
+  je.field(F("pressure_alarm"),       s.st.sat.bPressureAlarm);
+  je.field(F("modulation_reliable"),  s.st.sat.bModulationReliable);
+  je.field(F("setpoint_mismatch"),    s.st.sat.bSetpointMismatch);
+  { static const char* const crNames[] = { "insufficient", "increase", "decrease", "hold" };
+    int crIdx = (int)s.st.sat.eCurveRecommendation;
+    if (crIdx < 0 || crIdx > 3) crIdx = 0;
+    je.field(F("curve_recommendation"), crNames[crIdx]); }
+  je.field(F("heating_curve_recommendation"), s.st.sat.sHeatCurveRec);
+  je.field(F("mean_error"),           s.st.sat.fMeanError);
+  je.field(F("error_stddev"),         s.st.sat.fErrorStdDev);
+  je.field(F("target_temp_step"),     settings.sat.fTargetTempStep);
+  je.field(F("power_kw"),             s.st.sat.fCurrentPower);
+  je.field(F("energy_kwh"),           s.st.sat.fEnergyTotal);
+  je.field(F("boiler_capacity"),      settings.sat.fBoilerCapacity);
+  // Gas consumption estimation (Task #232)
+  je.field(F("boiler_rated_kw"),      settings.sat.fBoilerRatedKW);
+  je.field(F("boiler_efficiency"),    settings.sat.fBoilerEfficiency);
+  je.field(F("energy_estimated_kwh"), s.st.sat.fEnergyEstimatedKWh);
+  // Preset sync (Task #46)
+  je.field(F("preset_sync"),          settings.sat.bPresetSync);
+  // Thermal drop learning (Task #21)
+  je.field(F("thermal_coeff"),        settings.sat.fThermalCoeff);
+  je.field(F("thermal_drop_rate"),    s.st.sat.fThermalDropRate);
+  je.field(F("thermal_model_valid"),  s.st.sat.bThermalModelValid);
+  je.field(F("estimated_room"),       s.st.sat.fEstimatedRoom);
+  je.field(F("last_known_room"),      s.st.sat.fLastKnownRoom);
+  // Solar gain (Task #23)
+  je.field(F("solar_gain_active"),    s.st.sat.bSolarGainActive);
+  je.field(F("indoor_rise_rate"),     s.st.sat.fIndoorRiseRate);
+  // Summer simmer (Task #24)
+  je.field(F("summer_simmer"),        settings.sat.bSummerSimmer);
+  je.field(F("summer_active"),        s.st.sat.bSummerActive);
+  je.field(F("summer_hours_above"),   s.st.sat.fSummerHoursAbove);
+  je.field(F("summer_threshold"),     settings.sat.fSummerThreshold);
+  je.field(F("summer_min_hours"),     (int32_t)settings.sat.iSummerMinHours);
+  // Thermal comfort (Task #28/#47)
+  je.field(F("comfort_adjust"),       settings.sat.bComfortAdjust);
+  je.field(F("humidity"),             s.st.sat.fHumidity);
+  je.field(F("humidity_valid"),       s.st.sat.bHumidityValid);
+  je.field(F("comfort_offset"),       s.st.sat.fComfortOffset);
+  je.field(F("comfort_ref_humidity"), settings.sat.fComfortHumidity);
+  je.field(F("comfort_max_offset"),   settings.sat.fComfortMaxOffset);
+  // Simulation (Task #37 + TASK-795)
+  je.field(F("simulation"),           settings.sat.bSimulation);
+  // §4.2: mirrors the inverse of the boiler-hardware-present check (frozen above)
+  // so the Web UI can hide the simulation card when a real boiler is attached.
+  je.field(F("sim_available"),        !s.boilerHwPresent);
+  if (settings.sat.bSimulation) {
+    je.field(F("sim_room_temp"),       s.st.sat.fSimRoomTemp);
+    je.field(F("sim_flow_temp"),       s.st.sat.fSimFlowTemp);
+    je.field(F("sim_outdoor_temp"),    s.st.sat.fSimOutdoorTemp);
+    je.field(F("sim_return_temp"),     s.st.sat.fSimReturnTemp);
+    je.field(F("sim_flame_on"),        s.st.sat.bSimFlameOn);
+    je.field(F("sim_modulation"),      (int32_t)s.st.sat.iSimModulation);
+    // §4.3 command trace
+    je.field(F("last_blocked_cmd"),    s.st.sat.sLastBlockedCmd);
+    je.field(F("last_blocked_cmd_age_ms"),
+                     s.st.sat.iLastBlockedCmdMs == 0 ? (int32_t)0
+                       : (int32_t)(s.nowMs - s.st.sat.iLastBlockedCmdMs));
+    // TASK-801 F6: last_blocked_cmds[] ring, newest-first. Each element
+    // {"cmd":"..","age_ms":N}. JsonEmit nested array-of-object (no manual buffer).
+    {
+      const uint8_t ring  = (uint8_t)(sizeof(s.st.sat.iSimTraceMs) / sizeof(s.st.sat.iSimTraceMs[0]));
+      const uint8_t count = s.st.sat.iSimTraceCount;
+      const uint32_t nowMs = s.nowMs;
+      je.beginArray(F("last_blocked_cmds"));
+      for (uint8_t k = 0; k < count; k++) {
+        // newest-first: head-1-k, wrapping
+        uint8_t idx = (uint8_t)((s.st.sat.iSimTraceHead + ring - 1 - k) % ring);
+        uint32_t age = (s.st.sat.iSimTraceMs[idx] == 0) ? 0 : (nowMs - s.st.sat.iSimTraceMs[idx]);
+        je.beginObject();
+        je.field(F("cmd"),    s.st.sat.sSimTraceCmd[idx]);
+        je.field(F("age_ms"), age);
+        je.endObject();
+      }
+      je.endArray();
+    }
+  }
+  // PID auto-tuning (Task #27)
+  je.field(F("auto_tune"),            settings.sat.bAutoTune);
+  je.field(F("auto_tune_active"),     s.st.sat.bAutoTuneActive);
+  je.field(F("auto_tune_cycles"),     (int32_t)s.st.sat.iAutoTuneCycles);
+  je.field(F("auto_tune_score"),      s.st.sat.fAutoTuneScore);
+  je.field(F("auto_tune_rate"),       settings.sat.fAutoTuneRate);
+  // SAT Python parity settings (Task #82)
+  je.field(F("sensor_max_age"),       (int32_t)settings.sat.iSensorMaxAgeS);
+  je.field(F("error_monitoring"),     settings.sat.bErrorMonitoring);
+  je.field(F("auto_gains_value"),     settings.sat.fAutoGainsValue);
+  // TASK-193: manual gains mode
+  je.field(F("auto_gains"),           settings.sat.bAutoGains);
+  je.field(F("kp_manual"),            settings.sat.fKpManual, 6);
+  je.field(F("ki_manual"),            settings.sat.fKiManual, 6);
+  je.field(F("kd_manual"),            settings.sat.fKdManual, 6);
+  // TASK-204: thermal comfort mode (SSI as PID room temp)
+  je.field(F("thermal_comfort"),      settings.sat.bThermalComfort);
+  je.field(F("heating_mode"),         settings.sat.iHeatingMode == 1 ? "eco" : "comfort");
+  je.field(F("cycles_per_hour"),      (int32_t)settings.sat.iCyclesPerHour);
+  je.field(F("valve_offset"),         settings.sat.fValveOffset);
+  je.field(F("solar_freeze_integral"), settings.sat.bSolarFreezeIntegral);
+  // Multi-area (Task #25)
+  je.field(F("multi_area"),           settings.sat.bMultiArea);
+  je.field(F("multi_area_count"),     (int32_t)settings.sat.iMultiAreaCount);
+  if (settings.sat.bMultiArea && settings.sat.iMultiAreaCount > 0) {
+    uint8_t cnt = settings.sat.iMultiAreaCount;
+    if (cnt > SAT_MAX_AREAS) cnt = SAT_MAX_AREAS;
+    for (uint8_t i = 0; i < cnt; i++) {
+      // Dynamic per-area keys (area_0_temp ...): the key is formatted at
+      // runtime, so F() cannot be used. The key buffer is passed to je.field().
+      char nameBuf[20];
+      // area_N_temp
+      snprintf_P(nameBuf, sizeof(nameBuf), PSTR("area_%u_temp"), i);
+      je.field(nameBuf, s.st.sat.fAreaTemp[i]);
+      // area_N_valid
+      snprintf_P(nameBuf, sizeof(nameBuf), PSTR("area_%u_valid"), i);
+      je.field(nameBuf, s.st.sat.bAreaValid[i]);
+      // area_N_weight
+      snprintf_P(nameBuf, sizeof(nameBuf), PSTR("area_%u_weight"), i);
+      je.field(nameBuf, settings.sat.fAreaWeight[i]);
+    }
+  }
+  // BLE sensor status (Task #20). Appends ble_* fields from the frozen snapshot.
+  satBLESendStatusJSON(je, s.st.sat, s.bleFailoverActive);
+  je.endObject();
+}
+
 void satSendStatusJSON()
 {
   const uint32_t startMs = millis();
@@ -1981,254 +2235,14 @@ void satSendStatusJSON()
   // cbuf); guard the snapshot alloc against a fragmented heap (mirrors device/info).
   if (platformMaxFreeBlock() < 8192) { sendApiError(503, F("low heap")); return; }
 
-  // Freeze every volatile input ONCE (see SatStatusSnap above). Helpers are called
-  // in their original relative order so any side-effects (satGetOutsideTemp resolves
-  // its own staleness AFTER satGetRoomTemp) match the pre-chunked behaviour.
   auto snap = std::make_shared<SatStatusSnap>();
-  snap->st            = state;                          // en-bloc freeze of all state.*
-  satGetBoilerStatusName(snap->boilerStatus, sizeof(snap->boilerStatus));
-  snap->roomTemp      = satGetRoomTemp();
-  snap->outsideTemp   = satGetOutsideTemp();
-  snap->cyclesThisHour   = satCycleGetCyclesThisHour();
-  strlcpy(snap->phaseName, satCycleGetPhaseName(), sizeof(snap->phaseName));
-  snap->phaseDurationSec = satCycleGetPhaseDurationSec();
-  satGetManufacturerName(snap->manufacturer, sizeof(snap->manufacturer));
-  snap->maxSetpoint   = satGetMaxSetpoint();
-  snap->boilerHwPresent = satBoilerHardwarePresent();
-  snap->otToutside    = OTcurrentSystemState.Toutside;
-  snap->otSlaveConfigMemberIDcode = OTcurrentSystemState.SlaveConfigMemberIDcode;
-  snap->nowMs         = millis();
-  snap->bleFailoverActive = satBLEFailoverActive();
+  satFillStatusSnap(*snap);
 
   // DETERMINISM GATE (TASK-883): this closure reads ONLY snap->*, settings.sat.*,
   // and F()/PSTR literals. No live state.*, OTcurrentSystemState.*, millis(), or
   // satGet*()/satCycleGet*() — those would shift a field's text width between
   // window passes and corrupt the wire JSON.
-  restSendChunked("application/json", [snap](JsonEmit& je) {
-    je.beginObject();
-    je.field(F("enabled"),              settings.sat.bEnabled);
-    je.field(F("active"),               snap->st.sat.bActive);
-    je.field(F("control_mode"),         (int32_t)snap->st.sat.eControlMode);
-    je.field(F("boiler_status"),        snap->boilerStatus);
-    je.field(F("target_temp"),          settings.sat.fTargetTemp);
-    je.field(F("room_temp"),            snap->roomTemp);
-    // TASK-886 review M1: distinguish "no reading" from a real 0 °C. room_temp
-    // already arrives as NaN->null when no thermostat exists; mirror that for the
-    // other two no-source-prone tiles so the UI shows "--" instead of a misleading
-    // "0.00°C". The outside-temp helper was called FIRST at snapshot time (it
-    // resolves its own staleness side-effects), then if no live source remains AND it fell
-    // through to the bare OT-bus 0.0f (the firmware's own no-sensor convention, see
-    // line ~1113) it is emitted as null. final_setpoint is only meaningful active.
-    {
-      float outsideDisp = snap->outsideTemp;
-      bool outsideHasSource = settings.sat.bSimulation || snap->st.sat.bExternalOutdoorValid ||
-                              (snap->st.sat.weather.bValid && snap->otToutside == 0.0f);
-      if (!outsideHasSource && outsideDisp == 0.0f) outsideDisp = NAN;
-      je.field(F("outside_temp"),       outsideDisp);
-    }
-    je.field(F("heating_curve"),        snap->st.sat.fHeatingCurveValue);
-    je.field(F("pid_output"),           snap->st.sat.fPidOutput);
-    je.field(F("final_setpoint"),       snap->st.sat.bActive ? snap->st.sat.fFinalSetpoint : NAN);
-    je.field(F("error"),                snap->st.sat.fError);
-    je.field(F("pid_p"),                snap->st.sat.fPidP);
-    je.field(F("pid_i"),                snap->st.sat.fPidI);
-    je.field(F("pid_d"),                snap->st.sat.fPidD);
-    je.field(F("kp"),                   snap->st.sat.fKp, 6);
-    je.field(F("ki"),                   snap->st.sat.fKi, 6);
-    je.field(F("kd"),                   snap->st.sat.fKd, 6);
-    je.field(F("raw_derivative"),       snap->st.sat.fRawDerivative);
-    je.field(F("coefficient"),          settings.sat.fHeatingCurveCoeff);
-    je.field(F("deadband"),             settings.sat.fDeadband);
-    je.field(F("overshoot_margin"),     settings.sat.fOvershootMargin);
-    je.field(F("cycle_count"),          snap->st.sat.iCycleCount);
-    je.field(F("cycles_this_hour"),     (int32_t)snap->cyclesThisHour);
-    je.field(F("last_cycle_class"),     (int32_t)snap->st.sat.eLastCycleClass);
-    je.field(F("cycle_max_flow"),       snap->st.sat.fCycleMaxFlow);
-    je.field(F("cycle_overshoot_sec"),  snap->st.sat.fCycleOvershootSec);
-    je.field(F("duty_ratio"),           snap->st.sat.fDutyRatio);
-    je.field(F("overshoot_fraction"),   snap->st.sat.fOvershootFraction);
-    je.field(F("underheat_fraction"),   snap->st.sat.fUnderheatFraction);
-    // TASK-891.4 classifier-depth parity metrics
-    je.field(F("cycle_req_setpoint_error"),  snap->st.sat.fCycleReqSetpointError);
-    je.field(F("cycle_time_in_band_sec"),    snap->st.sat.fCycleTimeInBandSec);
-    je.field(F("cycle_total_overshoot_sec"), snap->st.sat.fCycleTotalOvershootSec);
-    je.field(F("cycle_t_first_overshoot"),   snap->st.sat.fCycleTimeToFirstOvershoot);
-    je.field(F("cycle_t_sustained_overshoot"), snap->st.sat.fCycleTimeToSustainedOvershoot);
-    je.field(F("off_with_demand_sec"),       snap->st.sat.fOffWithDemandSec);
-    je.field(F("24h_cycles"),                (int32_t)snap->st.sat.i24hCycles);
-    je.field(F("24h_duty_ratio"),            snap->st.sat.f24hDutyRatio);
-    je.field(F("24h_overshoot_fraction"),    snap->st.sat.f24hOvershootFraction);
-    je.field(F("24h_underheat_fraction"),    snap->st.sat.f24hUnderheatFraction);
-    je.field(F("24h_long_cycle_fraction"),   snap->st.sat.f24hLongCycleFraction);
-    je.field(F("cycle_phase"),          snap->phaseName);
-    je.field(F("phase_duration_sec"),   (int32_t)snap->phaseDurationSec);
-    je.field(F("pwm_duty"),             snap->st.sat.fPwmDutyCycle);
-    je.field(F("pwm_flame_req"),        snap->st.sat.bPwmFlameRequested);
-    je.field(F("active_preset"),        (int32_t)snap->st.sat.eActivePreset);
-    je.field(F("mod_suppressed"),       snap->st.sat.bModSuppressed);
-    je.field(F("dhw_active"),           snap->st.sat.bDhwActive);
-    je.field(F("dhw_setpoint"),         settings.sat.fDhwSetpoint);
-    // TASK-516: boiler-gated master DHW enable. dhw_config_tank is derived from
-    // MsgID 3 HB3 (bit 11 of the uint16 SlaveConfigMemberIDcode); the UI uses it to
-    // decide whether to render the toggle. dhw_enable mirrors the user setting; only
-    // acted on (HW=) when dhw_config_tank=true.
-    je.field(F("dhw_config_tank"),      (bool)(snap->otSlaveConfigMemberIDcode & 0x0800));
-    je.field(F("dhw_enable"),           settings.sat.bDhwEnable);
-    je.field(F("control_interval_sec"), (int32_t)settings.sat.iControlInterval);
-    je.field(F("fallback_active"),      snap->st.sat.bFallbackActive);
-    je.field(F("fallback_reason"),      (int32_t)snap->st.sat.eFallbackReason);
-    je.field(F("max_rel_modulation"),   (int32_t)settings.sat.iMaxRelModulation);
-    je.field(F("current_modulation"),   (int32_t)snap->st.sat.iCurrentModulation);
-    je.field(F("heating_system"),       (int32_t)settings.sat.iHeatingSystem);
-    je.field(F("heating_source"),          (int32_t)settings.sat.iHeatingSource);
-    je.field(F("heating_source_detected"), (int32_t)snap->st.sat.iDetectedHeatingSource);
-    je.field(F("manufacturer"),         snap->manufacturer);
-    je.field(F("manufacturer_setting"), (int32_t)settings.sat.iManufacturer);
-    je.field(F("manufacturer_detected"), (int32_t)snap->st.sat.iDetectedManufacturer);
-    je.field(F("slave_memberid"),       (int32_t)snap->st.sat.iSlaveMemberID);
-    je.field(F("max_setpoint_system"),  snap->maxSetpoint);
-    je.field(F("external_temp_valid"),  snap->st.sat.bExternalTempValid);
-    je.field(F("external_outdoor_valid"), snap->st.sat.bExternalOutdoorValid);
-    // PV-surplus boost (TASK-640)
-    je.field(F("pv_surplus_w"),         snap->st.sat.fExternalPvSurplusW);
-    je.field(F("pv_surplus_valid"),     snap->st.sat.bExternalPvSurplusValid);
-    je.field(F("pv_boost_active"),      snap->st.sat.bPvBoostActive);
-    je.field(F("pv_boost_applied_c"),   snap->st.sat.fPvBoostAppliedC);
-    je.field(F("pv_boost_enabled"),     settings.sat.bPvBoostEnabled);
-    je.field(F("safety_tripped"),       snap->st.sat.bSafetyTripped);
-    je.field(F("valves_open"),          snap->st.sat.bValvesOpen);
-    je.field(F("window_open"),          snap->st.sat.bWindowOpen);
-    je.field(F("window_detection"),     settings.sat.bWindowDetection);
-    je.field(F("push_setpoint"),        settings.sat.bPushSetpoint);
-    je.field(F("flame_off_offset"),     settings.sat.fFlameOffOffset);
-    je.field(F("force_pwm"),            settings.sat.bForcePWM);
-    je.field(F("flow_offset"),          settings.sat.fFlowOffset);
-    je.field(F("pressure"),             snap->st.sat.fSmoothedPressure);
-    je.field(F("pressure_drop_rate"),   snap->st.sat.fPressureDropRate);
-    je.field(F("pressure_alarm"),       snap->st.sat.bPressureAlarm);
-    je.field(F("modulation_reliable"),  snap->st.sat.bModulationReliable);
-    je.field(F("setpoint_mismatch"),    snap->st.sat.bSetpointMismatch);
-    { static const char* const crNames[] = { "insufficient", "increase", "decrease", "hold" };
-      int crIdx = (int)snap->st.sat.eCurveRecommendation;
-      if (crIdx < 0 || crIdx > 3) crIdx = 0;
-      je.field(F("curve_recommendation"), crNames[crIdx]); }
-    je.field(F("heating_curve_recommendation"), snap->st.sat.sHeatCurveRec);
-    je.field(F("mean_error"),           snap->st.sat.fMeanError);
-    je.field(F("error_stddev"),         snap->st.sat.fErrorStdDev);
-    je.field(F("target_temp_step"),     settings.sat.fTargetTempStep);
-    je.field(F("power_kw"),             snap->st.sat.fCurrentPower);
-    je.field(F("energy_kwh"),           snap->st.sat.fEnergyTotal);
-    je.field(F("boiler_capacity"),      settings.sat.fBoilerCapacity);
-    // Gas consumption estimation (Task #232)
-    je.field(F("boiler_rated_kw"),      settings.sat.fBoilerRatedKW);
-    je.field(F("boiler_efficiency"),    settings.sat.fBoilerEfficiency);
-    je.field(F("energy_estimated_kwh"), snap->st.sat.fEnergyEstimatedKWh);
-    // Preset sync (Task #46)
-    je.field(F("preset_sync"),          settings.sat.bPresetSync);
-    // Thermal drop learning (Task #21)
-    je.field(F("thermal_coeff"),        settings.sat.fThermalCoeff);
-    je.field(F("thermal_drop_rate"),    snap->st.sat.fThermalDropRate);
-    je.field(F("thermal_model_valid"),  snap->st.sat.bThermalModelValid);
-    je.field(F("estimated_room"),       snap->st.sat.fEstimatedRoom);
-    je.field(F("last_known_room"),      snap->st.sat.fLastKnownRoom);
-    // Solar gain (Task #23)
-    je.field(F("solar_gain_active"),    snap->st.sat.bSolarGainActive);
-    je.field(F("indoor_rise_rate"),     snap->st.sat.fIndoorRiseRate);
-    // Summer simmer (Task #24)
-    je.field(F("summer_simmer"),        settings.sat.bSummerSimmer);
-    je.field(F("summer_active"),        snap->st.sat.bSummerActive);
-    je.field(F("summer_hours_above"),   snap->st.sat.fSummerHoursAbove);
-    je.field(F("summer_threshold"),     settings.sat.fSummerThreshold);
-    je.field(F("summer_min_hours"),     (int32_t)settings.sat.iSummerMinHours);
-    // Thermal comfort (Task #28/#47)
-    je.field(F("comfort_adjust"),       settings.sat.bComfortAdjust);
-    je.field(F("humidity"),             snap->st.sat.fHumidity);
-    je.field(F("humidity_valid"),       snap->st.sat.bHumidityValid);
-    je.field(F("comfort_offset"),       snap->st.sat.fComfortOffset);
-    je.field(F("comfort_ref_humidity"), settings.sat.fComfortHumidity);
-    je.field(F("comfort_max_offset"),   settings.sat.fComfortMaxOffset);
-    // Simulation (Task #37 + TASK-795)
-    je.field(F("simulation"),           settings.sat.bSimulation);
-    // §4.2: mirrors the inverse of the boiler-hardware-present check (frozen above)
-    // so the Web UI can hide the simulation card when a real boiler is attached.
-    je.field(F("sim_available"),        !snap->boilerHwPresent);
-    if (settings.sat.bSimulation) {
-      je.field(F("sim_room_temp"),       snap->st.sat.fSimRoomTemp);
-      je.field(F("sim_flow_temp"),       snap->st.sat.fSimFlowTemp);
-      je.field(F("sim_outdoor_temp"),    snap->st.sat.fSimOutdoorTemp);
-      je.field(F("sim_return_temp"),     snap->st.sat.fSimReturnTemp);
-      je.field(F("sim_flame_on"),        snap->st.sat.bSimFlameOn);
-      je.field(F("sim_modulation"),      (int32_t)snap->st.sat.iSimModulation);
-      // §4.3 command trace
-      je.field(F("last_blocked_cmd"),    snap->st.sat.sLastBlockedCmd);
-      je.field(F("last_blocked_cmd_age_ms"),
-                       snap->st.sat.iLastBlockedCmdMs == 0 ? (int32_t)0
-                         : (int32_t)(snap->nowMs - snap->st.sat.iLastBlockedCmdMs));
-      // TASK-801 F6: last_blocked_cmds[] ring, newest-first. Each element
-      // {"cmd":"..","age_ms":N}. JsonEmit nested array-of-object (no manual buffer).
-      {
-        const uint8_t ring  = (uint8_t)(sizeof(snap->st.sat.iSimTraceMs) / sizeof(snap->st.sat.iSimTraceMs[0]));
-        const uint8_t count = snap->st.sat.iSimTraceCount;
-        const uint32_t nowMs = snap->nowMs;
-        je.beginArray(F("last_blocked_cmds"));
-        for (uint8_t k = 0; k < count; k++) {
-          // newest-first: head-1-k, wrapping
-          uint8_t idx = (uint8_t)((snap->st.sat.iSimTraceHead + ring - 1 - k) % ring);
-          uint32_t age = (snap->st.sat.iSimTraceMs[idx] == 0) ? 0 : (nowMs - snap->st.sat.iSimTraceMs[idx]);
-          je.beginObject();
-          je.field(F("cmd"),    snap->st.sat.sSimTraceCmd[idx]);
-          je.field(F("age_ms"), age);
-          je.endObject();
-        }
-        je.endArray();
-      }
-    }
-    // PID auto-tuning (Task #27)
-    je.field(F("auto_tune"),            settings.sat.bAutoTune);
-    je.field(F("auto_tune_active"),     snap->st.sat.bAutoTuneActive);
-    je.field(F("auto_tune_cycles"),     (int32_t)snap->st.sat.iAutoTuneCycles);
-    je.field(F("auto_tune_score"),      snap->st.sat.fAutoTuneScore);
-    je.field(F("auto_tune_rate"),       settings.sat.fAutoTuneRate);
-    // SAT Python parity settings (Task #82)
-    je.field(F("sensor_max_age"),       (int32_t)settings.sat.iSensorMaxAgeS);
-    je.field(F("error_monitoring"),     settings.sat.bErrorMonitoring);
-    je.field(F("auto_gains_value"),     settings.sat.fAutoGainsValue);
-    // TASK-193: manual gains mode
-    je.field(F("auto_gains"),           settings.sat.bAutoGains);
-    je.field(F("kp_manual"),            settings.sat.fKpManual, 6);
-    je.field(F("ki_manual"),            settings.sat.fKiManual, 6);
-    je.field(F("kd_manual"),            settings.sat.fKdManual, 6);
-    // TASK-204: thermal comfort mode (SSI as PID room temp)
-    je.field(F("thermal_comfort"),      settings.sat.bThermalComfort);
-    je.field(F("heating_mode"),         settings.sat.iHeatingMode == 1 ? "eco" : "comfort");
-    je.field(F("cycles_per_hour"),      (int32_t)settings.sat.iCyclesPerHour);
-    je.field(F("valve_offset"),         settings.sat.fValveOffset);
-    je.field(F("solar_freeze_integral"), settings.sat.bSolarFreezeIntegral);
-    // Multi-area (Task #25)
-    je.field(F("multi_area"),           settings.sat.bMultiArea);
-    je.field(F("multi_area_count"),     (int32_t)settings.sat.iMultiAreaCount);
-    if (settings.sat.bMultiArea && settings.sat.iMultiAreaCount > 0) {
-      uint8_t cnt = settings.sat.iMultiAreaCount;
-      if (cnt > SAT_MAX_AREAS) cnt = SAT_MAX_AREAS;
-      for (uint8_t i = 0; i < cnt; i++) {
-        // Dynamic per-area keys (area_0_temp ...): the key is formatted at
-        // runtime, so F() cannot be used. The key buffer is passed to je.field().
-        char nameBuf[20];
-        // area_N_temp
-        snprintf_P(nameBuf, sizeof(nameBuf), PSTR("area_%u_temp"), i);
-        je.field(nameBuf, snap->st.sat.fAreaTemp[i]);
-        // area_N_valid
-        snprintf_P(nameBuf, sizeof(nameBuf), PSTR("area_%u_valid"), i);
-        je.field(nameBuf, snap->st.sat.bAreaValid[i]);
-        // area_N_weight
-        snprintf_P(nameBuf, sizeof(nameBuf), PSTR("area_%u_weight"), i);
-        je.field(nameBuf, settings.sat.fAreaWeight[i]);
-      }
-    }
-    // BLE sensor status (Task #20). Appends ble_* fields from the frozen snapshot.
-    satBLESendStatusJSON(je, snap->st.sat, snap->bleFailoverActive);
-    je.endObject();
-  });
+  restSendChunked("application/json", [snap](JsonEmit& je) { satEmitStatus(je, *snap); });
   const uint32_t totalMs = millis() - startMs;
   restPerfCommit(REST_PERF_SAT_STATUS, totalMs);
   if (state.debug.bRestAPI) {
@@ -2240,6 +2254,19 @@ void satSendStatusJSON()
   }
 }
 
+// The "sat" event of /api/v2/events (sseStuff.ino), loop task. One pass into
+// a buffer, so no chunk re-runs, but the same snapshot keeps the document
+// identical to GET /api/v2/sat/status. False when the snapshot does not fit.
+bool satRenderStatus(JsonEmit& je)
+{
+  if (platformMaxFreeBlock() < 8192) return false;     // same guard as the REST path
+  std::unique_ptr<SatStatusSnap> snap(new (std::nothrow) SatStatusSnap);
+  if (!snap) return false;
+  satFillStatusSnap(*snap);
+  satEmitStatus(je, *snap);
+  return true;
+}
+
 //=====================================================================
 //=== Summer Simmer Index (Task #64) ===
 //=====================================================================
@@ -20,6 +20,8 @@
 #define SATDebugTln(s)        do { if (state.debug.bSAT) DebugTln(s);                  } while(0)
 #define SATDebugf(fmt, ...)   do { if (state.debug.bSAT) Debugf(fmt,   ##__VA_ARGS__); } while(0)
 
+#include "SATQuantile.h"
+
 // --- Cycle Kind & Phase enums are in OTGW-firmware.h ---
 
 // --- Cycle Constants ---
@@ -48,6 +50,21 @@ static SATWindowRecord _win4h[SAT_WIN4H_SIZE];
 static SAT_RING_IDX_T  _win4hHead  = 0;   // next write position
 static SAT_RING_IDX_T  _win4hCount = 0;   // valid entries (0..SAT_WIN4H_SIZE)
 
+// Running aggregates over the records still inside SAT_WIN4H_SPAN_MS. endMs only
+// grows, so those are always the newest _win4hSums.nLive records: a cycle is added
+// when it is recorded and subtracted when it ages out or the ring overwrites it,
+// and satGetWindow4hStats() no longer walks or sorts the ring.
+struct SATWindowSums {
+  SAT_RING_IDX_T nLive;       // records inside the 4h span
+  SAT_RING_IDX_T nOvershoot;
+  SAT_RING_IDX_T nUnderheat;  // UNDERHEAT + UNDERHEAT_PWM
+  uint32_t sumOnMs;
+  uint32_t sumOffMs;
+  double   sumP90Flow;        // double: months of add/subtract must not drift
+};
+static SATWindowSums _win4hSums;
+static SATOrderWindow<SAT_WIN4H_SIZE> _win4hDeltas;  // avgFlowRetDelta of live records (no -1 sentinels)
+
 // --- Rolling 24-hour DAILY window (TASK-891.4, Python DAILY_WINDOW_SECONDS) ---
 // HEAP DISCIPLINE (AC#6): a full per-cycle 24h ring at 4h-window density would be
 // ~6x the 4h ring (~52 KB on ESP32) and blow the 40k heap floor. Instead the daily
@@ -71,7 +88,14 @@ struct SATDailyBucket {
 };
 static SATDailyBucket _daily[SAT_DAILY_BUCKETS];
 static uint8_t        _dailyHead  = 0;   // next write position
-static uint8_t        _dailyCount = 0;   // valid buckets (0..SAT_DAILY_BUCKETS)
+static uint8_t        _dailyCount = 0;   // live buckets, the newest _dailyCount before _dailyHead
+// Running totals over the live buckets: added on record, subtracted when a bucket
+// leaves the 24h window (see _dailyExpire()).
+struct SATDailyTotals {
+  uint32_t nCycles, nOvershoot, nUnderheat, nLong;
+  uint64_t sumOnMs, sumOffMs;
+};
+static SATDailyTotals _dailyTot;
 
 // Forward decl: satGetColdSetpoint() is static in SATcontrol.ino (compiled before
 // this file in the single-TU concatenation). Declared here so a linkage surprise
@@ -87,11 +111,11 @@ static const float SAT_SHAPE_WARMUP_SEC     = 60.0f;  // shape metrics ignore th
 static float    _cycle_sumFlowRetDelta = 0.0f;
 static uint16_t _cycle_deltasamples   = 0;
 
-// --- Per-cycle flow temperature sample buffer (Task #225, p90/p10 classifier) ---
-// SAT_FLOW_SAMPLE_SIZE is board-defined in boards.h (64 on ESP8266, 256 on ESP32).
-static float    _flow_samples[SAT_FLOW_SAMPLE_SIZE];
-static SAT_RING_IDX_T _flow_sampleHead  = 0;  // next write position (ring)
-static SAT_RING_IDX_T _flow_sampleCount = 0;  // valid sample count (0..SAT_FLOW_SAMPLE_SIZE)
+// --- Per-cycle flow temperature distribution (Task #225, p90/p10 classifier) ---
+// Every sample of the cycle, binned (SATQuantile.h). This used to be a ring of the
+// last 256 samples; sampled at loop rate that held well under a
+// second of a multi-minute cycle, so the "full-cycle" p90/p10 were end-of-cycle values.
+static SATFlowHistogram _flow_hist;
 
 // --- Tail ring buffer for end-of-cycle 180s classification window ---
 // Sampled at 1Hz for a true time-based window, independent of loop rate.
@@ -100,6 +124,7 @@ static float    _tail_samples[SAT_TAIL_SAMPLE_SIZE];
 static uint8_t  _tail_sampleHead  = 0;
 static uint8_t  _tail_sampleCount = 0;
 static uint32_t _tail_lastSampleMs = 0;
+static SATOrderWindow<SAT_TAIL_SAMPLE_SIZE> _tail_sorted;  // the ring's samples, sorted
 
 // --- Current Cycle State ---
 static bool     _cycle_flameOn          = false;
@@ -183,6 +208,9 @@ static float _hcrIntraMedian();
 void satHCRSaveState();
 void satHCRLoadState();
 
+//--- Forward declaration: 4h window aggregates (defined with satGetWindow4hStats) ---
+static void _win4hReset();
+
 //=== Initialize cycle tracking ===
 void satCycleInit()
 {
@@ -204,19 +232,17 @@ void satCycleInit()
   _hourCycleHead  = 0;
   _hourCycleCount = 0;
   state.sat.iCyclesThisHour = 0;
-  // Per-cycle flow sample buffer
-  memset(_flow_samples, 0, sizeof(_flow_samples));
-  _flow_sampleHead  = 0;
-  _flow_sampleCount = 0;
+  // Per-cycle flow distribution
+  _flow_hist.reset();
   // Tail ring buffer (180s window)
   memset(_tail_samples, 0, sizeof(_tail_samples));
   _tail_sampleHead  = 0;
   _tail_sampleCount = 0;
   _tail_lastSampleMs = 0;
+  _tail_sorted.clear();
   // Rolling 4-hour window (Task #227)
   memset(_win4h, 0, sizeof(_win4h));
-  _win4hHead  = 0;
-  _win4hCount = 0;
+  _win4hReset();
   _cycle_sumFlowRetDelta = 0.0f;
   _cycle_deltasamples    = 0;
   state.sat.i4hCycles            = 0;
@@ -232,6 +258,7 @@ void satCycleInit()
   memset(_daily, 0, sizeof(_daily));
   _dailyHead  = 0;
   _dailyCount = 0;
+  memset(&_dailyTot, 0, sizeof(_dailyTot));
   state.sat.i24hCycles            = 0;
   state.sat.f24hDutyRatio         = 0.0f;
   state.sat.f24hOvershootFraction = 0.0f;
@@ -299,45 +326,76 @@ uint8_t satCycleGetCyclesThisHour()
   return count;
 }
 
+//=== Rolling 4-hour window aggregates ===
+static bool _win4hIsUnderheat(uint8_t eClass)
+{
+  // Both continuous and PWM underheat count toward the underheat fraction (TASK-891.4).
+  return eClass == (uint8_t)SAT_CYCLE_UNDERHEAT || eClass == (uint8_t)SAT_CYCLE_UNDERHEAT_PWM;
+}
+
+static void _win4hAdd(const SATWindowRecord &r)
+{
+  _win4hSums.nLive++;
+  _win4hSums.sumOnMs    += r.onDurationMs;
+  _win4hSums.sumOffMs   += r.offDurationMs;
+  _win4hSums.sumP90Flow += r.p90FlowTemp;
+  if (r.eClass == (uint8_t)SAT_CYCLE_OVERSHOOT) _win4hSums.nOvershoot++;
+  if (_win4hIsUnderheat(r.eClass)) _win4hSums.nUnderheat++;
+  if (r.avgFlowRetDelta >= 0.0f) _win4hDeltas.insert(r.avgFlowRetDelta);  // sentinel -1 means no data
+}
+
+// Remove the oldest live record from the aggregates.
+static void _win4hDropOldest()
+{
+  const SATWindowRecord &r = _win4h[(_win4hHead + SAT_WIN4H_SIZE - _win4hSums.nLive) % SAT_WIN4H_SIZE];
+  _win4hSums.nLive--;
+  _win4hSums.sumOnMs    -= r.onDurationMs;
+  _win4hSums.sumOffMs   -= r.offDurationMs;
+  _win4hSums.sumP90Flow -= r.p90FlowTemp;
+  if (r.eClass == (uint8_t)SAT_CYCLE_OVERSHOOT) _win4hSums.nOvershoot--;
+  if (_win4hIsUnderheat(r.eClass)) _win4hSums.nUnderheat--;
+  if (r.avgFlowRetDelta >= 0.0f) _win4hDeltas.erase(r.avgFlowRetDelta);
+  if (_win4hSums.nLive == 0) _win4hSums.sumP90Flow = 0.0;  // shed rounding residue
+}
+
+static void _win4hReset()
+{
+  _win4hHead  = 0;
+  _win4hCount = 0;
+  memset(&_win4hSums, 0, sizeof(_win4hSums));
+  _win4hDeltas.clear();
+}
+
+// Append a completed cycle; a full ring overwrites its oldest record.
+static void _win4hPush(const SATWindowRecord &r)
+{
+  if (_win4hSums.nLive == SAT_WIN4H_SIZE) _win4hDropOldest();  // about to be overwritten
+  _win4h[_win4hHead] = r;
+  _win4hHead = (_win4hHead + 1) % SAT_WIN4H_SIZE;
+  if (_win4hCount < SAT_WIN4H_SIZE) _win4hCount++;
+  _win4hAdd(r);
+}
+
+// Age out records that ended more than SAT_WIN4H_SPAN_MS ago (oldest first).
+static void _win4hExpire(uint32_t nowMs)
+{
+  while (_win4hSums.nLive > 0) {
+    const SATWindowRecord &r = _win4h[(_win4hHead + SAT_WIN4H_SIZE - _win4hSums.nLive) % SAT_WIN4H_SIZE];
+    if ((nowMs - r.endMs) <= SAT_WIN4H_SPAN_MS) break;
+    _win4hDropOldest();
+  }
+}
+
 //=== Rolling 4-hour window statistics (Task #227) ===
-// Iterates the ring buffer, filters entries within SAT_WIN4H_SPAN_MS of now,
-// and computes: cycle count, avg on/off durations, avg p90 flow temp,
-// duty ratio, overshoot/underheat fractions, and flow-return delta p50/p90.
+// Expires records older than SAT_WIN4H_SPAN_MS from the running aggregates, then
+// derives: cycle count, avg on/off durations, avg p90 flow temp, duty ratio,
+// overshoot/underheat fractions, and flow-return delta p50/p90.
 // Results are written directly to state.sat.
 void satGetWindow4hStats()
 {
-  uint32_t nowMs = millis();
-
-  uint32_t sumOnMs      = 0;
-  uint32_t sumOffMs     = 0;
-  float    sumP90Flow   = 0.0f;
-  uint16_t nOvershoot   = 0;
-  uint16_t nUnderheat   = 0;
-  uint16_t nValid       = 0;
-
-  // Collect per-cycle flow-return deltas into a scratch array for percentile sort.
-  // static: avoids 1440 bytes on the ESP32 stack (SAT_WIN4H_SIZE=360 on ESP32).
-  // Safe: satUpdate4hWindow() is only ever called from the main loop, never re-entrant.
-  static float deltas[SAT_WIN4H_SIZE];
-  uint16_t nDeltas = 0;
-
-  for (uint16_t i = 0; i < _win4hCount; i++) {
-    // Walk backwards so newest entries are checked first (avoids counting stale wrap-arounds)
-    uint16_t idx = (_win4hHead + SAT_WIN4H_SIZE - 1 - i) % SAT_WIN4H_SIZE;
-    if ((nowMs - _win4h[idx].endMs) > SAT_WIN4H_SPAN_MS) continue; // outside 4h window
-    sumOnMs    += _win4h[idx].onDurationMs;
-    sumOffMs   += _win4h[idx].offDurationMs;
-    sumP90Flow += _win4h[idx].p90FlowTemp;
-    if (_win4h[idx].eClass == (uint8_t)SAT_CYCLE_OVERSHOOT) nOvershoot++;
-    // Both continuous and PWM underheat count toward the underheat fraction (TASK-891.4).
-    if (_win4h[idx].eClass == (uint8_t)SAT_CYCLE_UNDERHEAT ||
-        _win4h[idx].eClass == (uint8_t)SAT_CYCLE_UNDERHEAT_PWM) nUnderheat++;
-    if (_win4h[idx].avgFlowRetDelta >= 0.0f) {  // sentinel -1 means no data
-      deltas[nDeltas++] = _win4h[idx].avgFlowRetDelta;
-    }
-    nValid++;
-  }
+  _win4hExpire(millis());
 
+  const uint16_t nValid = _win4hSums.nLive;
   state.sat.i4hCycles = nValid;
 
   if (nValid == 0) {
@@ -352,39 +410,22 @@ void satGetWindow4hStats()
     return;
   }
 
+  const uint32_t sumOnMs  = _win4hSums.sumOnMs;
+  const uint32_t sumOffMs = _win4hSums.sumOffMs;
   float n = (float)nValid;
   state.sat.f4hAvgOnSec          = (float)sumOnMs  / (n * 1000.0f);
   state.sat.f4hAvgOffSec         = (float)sumOffMs / (n * 1000.0f);
-  state.sat.f4hAvgFlow           = sumP90Flow / n;
-  state.sat.f4hOvershootFraction = (float)nOvershoot / n;
-  state.sat.f4hUnderheatFraction = (float)nUnderheat / n;
+  state.sat.f4hAvgFlow           = (float)(_win4hSums.sumP90Flow / (double)nValid);
+  state.sat.f4hOvershootFraction = (float)_win4hSums.nOvershoot / n;
+  state.sat.f4hUnderheatFraction = (float)_win4hSums.nUnderheat / n;
 
   // Duty ratio: on / (on + off) per cycle, averaged
   float totalMs = (float)(sumOnMs + sumOffMs);
   state.sat.f4hDutyRatio = (totalMs > 0.0f) ? ((float)sumOnMs / totalMs) : 0.0f;
 
-  // Percentiles for flow-return delta: insertion-sort the collected deltas
-  if (nDeltas == 0) {
-    state.sat.f4hFlowRetDeltaP50 = 0.0f;
-    state.sat.f4hFlowRetDeltaP90 = 0.0f;
-  } else {
-    // Insertion sort (n <= SAT_WIN4H_SIZE, runs once per minute)
-    for (uint16_t i = 1; i < nDeltas; i++) {
-      float key = deltas[i];
-      int16_t j = (int16_t)i - 1;
-      while (j >= 0 && deltas[j] > key) {
-        deltas[j + 1] = deltas[j];
-        j--;
-      }
-      deltas[j + 1] = key;
-    }
-    uint16_t idx50 = (uint16_t)((uint32_t)50 * (nDeltas - 1) / 100);
-    uint16_t idx90 = (uint16_t)((uint32_t)90 * (nDeltas - 1) / 100);
-    if (idx50 >= nDeltas) idx50 = nDeltas - 1;
-    if (idx90 >= nDeltas) idx90 = nDeltas - 1;
-    state.sat.f4hFlowRetDeltaP50 = deltas[idx50];
-    state.sat.f4hFlowRetDeltaP90 = deltas[idx90];
-  }
+  // Flow-return delta percentiles: 0 when no live cycle had a return temperature
+  state.sat.f4hFlowRetDeltaP50 = _win4hDeltas.percentile(50);
+  state.sat.f4hFlowRetDeltaP90 = _win4hDeltas.percentile(90);
 
   SATDebugTf(PSTR("SAT 4h: n=%u avgOn=%.0fs avgOff=%.0fs flow=%.1f duty=%.2f overshoot=%.2f underheat=%.2f dP50=%.1f dP90=%.1f\r\n"),
           nValid,
@@ -396,62 +437,81 @@ void satGetWindow4hStats()
 }
 
 //=== Rolling 24-hour DAILY window (TASK-891.4) ===
+// Take bucket `slot` out of the running totals (it is leaving the window).
+static void _dailyTotalsDrop(uint8_t slot)
+{
+  const SATDailyBucket &b = _daily[slot];
+  _dailyTot.nCycles    -= b.nCycles;
+  _dailyTot.nOvershoot -= b.nOvershoot;
+  _dailyTot.nUnderheat -= b.nUnderheat;
+  _dailyTot.nLong      -= b.nLong;
+  _dailyTot.sumOnMs    -= b.sumOnMs;
+  _dailyTot.sumOffMs   -= b.sumOffMs;
+}
+
+// Drop buckets that fell out of the 24h window ending at bucket bidx (oldest first;
+// bucketIdx only grows along the ring).
+static void _dailyExpire(uint32_t bidx)
+{
+  uint32_t cutoff = (bidx >= (uint32_t)SAT_DAILY_BUCKETS) ? (bidx - SAT_DAILY_BUCKETS + 1) : 0;
+  while (_dailyCount > 0) {
+    uint8_t oldest = (uint8_t)((_dailyHead + SAT_DAILY_BUCKETS - _dailyCount) % SAT_DAILY_BUCKETS);
+    if (_daily[oldest].bucketIdx >= cutoff) break;
+    _dailyTotalsDrop(oldest);
+    _dailyCount--;
+  }
+}
+
 // Record a completed cycle into the coarse hourly-bucket ring. Reuses the current
 // bucket while the cycle-end falls in the same wall-clock hour, else opens a new one.
 static void _dailyRecord(uint32_t nowMs, uint32_t onMs, uint32_t offMs,
                          SATCycleClass cls, float durationSec)
 {
   uint32_t bidx = nowMs / SAT_DAILY_BUCKET_MS;
+  _dailyExpire(bidx);
 
-  // Locate the most-recently-written bucket; reuse it if it is the same hour.
+  // Reuse the most-recently-written bucket if it is the same hour.
   uint8_t slot;
-  if (_dailyCount > 0) {
-    uint8_t last = (uint8_t)((_dailyHead + SAT_DAILY_BUCKETS - 1) % SAT_DAILY_BUCKETS);
-    if (_daily[last].bucketIdx == bidx) {
-      slot = last;   // same hour: accumulate into existing bucket
-    } else {
-      slot = _dailyHead;   // new hour: open a fresh bucket
-      memset(&_daily[slot], 0, sizeof(_daily[slot]));
-      _daily[slot].bucketIdx = bidx;
-      _dailyHead = (uint8_t)((_dailyHead + 1) % SAT_DAILY_BUCKETS);
-      if (_dailyCount < SAT_DAILY_BUCKETS) _dailyCount++;
-    }
+  uint8_t last = (uint8_t)((_dailyHead + SAT_DAILY_BUCKETS - 1) % SAT_DAILY_BUCKETS);
+  if (_dailyCount > 0 && _daily[last].bucketIdx == bidx) {
+    slot = last;   // same hour: accumulate into existing bucket
   } else {
-    slot = _dailyHead;
+    if (_dailyCount == SAT_DAILY_BUCKETS) {   // defensive: expiry leaves room for a new hour
+      _dailyTotalsDrop(_dailyHead);
+      _dailyCount--;
+    }
+    slot = _dailyHead;   // new hour: open a fresh bucket
     memset(&_daily[slot], 0, sizeof(_daily[slot]));
     _daily[slot].bucketIdx = bidx;
     _dailyHead = (uint8_t)((_dailyHead + 1) % SAT_DAILY_BUCKETS);
-    _dailyCount = 1;
+    _dailyCount++;
   }
 
+  const uint8_t isOvershoot = (cls == SAT_CYCLE_OVERSHOOT) ? 1 : 0;
+  const uint8_t isUnderheat = (cls == SAT_CYCLE_UNDERHEAT || cls == SAT_CYCLE_UNDERHEAT_PWM) ? 1 : 0;
+  const uint8_t isLong      = (durationSec >= SAT_LONG_CYCLE_SEC) ? 1 : 0;
   _daily[slot].nCycles++;
-  if (cls == SAT_CYCLE_OVERSHOOT) _daily[slot].nOvershoot++;
-  if (cls == SAT_CYCLE_UNDERHEAT || cls == SAT_CYCLE_UNDERHEAT_PWM) _daily[slot].nUnderheat++;
-  if (durationSec >= SAT_LONG_CYCLE_SEC) _daily[slot].nLong++;
-  _daily[slot].sumOnMs  += onMs;
-  _daily[slot].sumOffMs += offMs;
+  _daily[slot].nOvershoot += isOvershoot;
+  _daily[slot].nUnderheat += isUnderheat;
+  _daily[slot].nLong      += isLong;
+  _daily[slot].sumOnMs    += onMs;
+  _daily[slot].sumOffMs   += offMs;
+  _dailyTot.nCycles++;
+  _dailyTot.nOvershoot += isOvershoot;
+  _dailyTot.nUnderheat += isUnderheat;
+  _dailyTot.nLong      += isLong;
+  _dailyTot.sumOnMs    += onMs;
+  _dailyTot.sumOffMs   += offMs;
 }
 
 // Aggregate the last 24h of hourly buckets into state.sat.f24h*. Reduced-resolution:
 // counts/sums only (duty + fractions are exact; percentiles/median are not carried).
+// The totals are kept running by _dailyRecord(); this only expires old buckets.
 void satGetWindow24hStats()
 {
-  uint32_t bidx   = millis() / SAT_DAILY_BUCKET_MS;
-  uint32_t cutoff = (bidx >= (uint32_t)SAT_DAILY_BUCKETS) ? (bidx - SAT_DAILY_BUCKETS + 1) : 0;
-
-  uint32_t nC = 0, nO = 0, nU = 0, nL = 0;
-  uint64_t sOn = 0, sOff = 0;
-  for (uint8_t i = 0; i < _dailyCount; i++) {
-    if (_daily[i].nCycles == 0) continue;
-    if (_daily[i].bucketIdx < cutoff || _daily[i].bucketIdx > bidx) continue; // outside 24h
-    nC  += _daily[i].nCycles;
-    nO  += _daily[i].nOvershoot;
-    nU  += _daily[i].nUnderheat;
-    nL  += _daily[i].nLong;
-    sOn += _daily[i].sumOnMs;
-    sOff += _daily[i].sumOffMs;
-  }
+  _dailyExpire(millis() / SAT_DAILY_BUCKET_MS);
 
+  const uint32_t nC = _dailyTot.nCycles;
   state.sat.i24hCycles = (uint16_t)((nC > 0xFFFFu) ? 0xFFFFu : nC);
   if (nC == 0) {
     state.sat.f24hDutyRatio         = 0.0f;
@@ -461,11 +521,11 @@ void satGetWindow24hStats()
     return;
   }
   float fn = (float)nC;
-  float totalMs = (float)(sOn + sOff);
-  state.sat.f24hDutyRatio         = (totalMs > 0.0f) ? ((float)sOn / totalMs) : 0.0f;
-  state.sat.f24hOvershootFraction = (float)nO / fn;
-  state.sat.f24hUnderheatFraction = (float)nU / fn;
-  state.sat.f24hLongCycleFraction = (float)nL / fn;
+  float totalMs = (float)(_dailyTot.sumOnMs + _dailyTot.sumOffMs);
+  state.sat.f24hDutyRatio         = (totalMs > 0.0f) ? ((float)_dailyTot.sumOnMs / totalMs) : 0.0f;
+  state.sat.f24hOvershootFraction = (float)_dailyTot.nOvershoot / fn;
+  state.sat.f24hUnderheatFraction = (float)_dailyTot.nUnderheat / fn;
+  state.sat.f24hLongCycleFraction = (float)_dailyTot.nLong / fn;
 
   SATDebugTf(PSTR("SAT 24h: n=%lu duty=%.2f overshoot=%.2f underheat=%.2f long=%.2f\r\n"),
           (unsigned long)nC, state.sat.f24hDutyRatio,
@@ -473,68 +533,6 @@ void satGetWindow24hStats()
           state.sat.f24hLongCycleFraction);
 }
 
-//=== Per-cycle flow temperature p-percentile (Task #225) ===
-// Compute approximate percentile from the current flow sample buffer.
-// Uses insertion-sort on a local copy (max 64 floats = 256 bytes stack — acceptable).
-static float _flowPercentile(uint8_t pct)
-{
-  if (_flow_sampleCount == 0) return 0.0f;
-
-  // Copy to local buffer for sorting (avoids mutating the ring)
-  float sorted[SAT_FLOW_SAMPLE_SIZE];
-  uint16_t n = _flow_sampleCount;
-  for (uint16_t i = 0; i < n; i++) {
-    uint16_t src = (_flow_sampleHead + SAT_FLOW_SAMPLE_SIZE - n + i) % SAT_FLOW_SAMPLE_SIZE;
-    sorted[i] = _flow_samples[src];
-  }
-
-  // Insertion sort — O(n^2) but n<=SAT_FLOW_SAMPLE_SIZE, runs once at cycle end
-  for (uint16_t i = 1; i < n; i++) {
-    float key = sorted[i];
-    int16_t j = (int16_t)i - 1;
-    while (j >= 0 && sorted[j] > key) {
-      sorted[j + 1] = sorted[j];
-      j--;
-    }
-    sorted[j + 1] = key;
-  }
-
-  // Index for requested percentile (0-based, clamped)
-  uint16_t idx = (uint16_t)((uint32_t)pct * (n - 1) / 100);
-  if (idx >= n) idx = n - 1;
-  return sorted[idx];
-}
-
-//=== Tail-window percentile (Task #590) ===
-// Same insertion-sort approach as _flowPercentile(), but uses the 1Hz-gated
-// tail ring buffer so only the final SAT_TAIL_SAMPLE_SIZE seconds of the
-// cycle are considered.
-static float _tailPercentile(uint8_t pct)
-{
-  if (_tail_sampleCount == 0) return 0.0f;
-
-  float sorted[SAT_TAIL_SAMPLE_SIZE];
-  uint8_t n = _tail_sampleCount;
-  for (uint8_t i = 0; i < n; i++) {
-    uint8_t src = (_tail_sampleHead + SAT_TAIL_SAMPLE_SIZE - n + i) % SAT_TAIL_SAMPLE_SIZE;
-    sorted[i] = _tail_samples[src];
-  }
-
-  for (uint8_t i = 1; i < n; i++) {
-    float key = sorted[i];
-    int8_t j = (int8_t)i - 1;
-    while (j >= 0 && sorted[j] > key) {
-      sorted[j + 1] = sorted[j];
-      j--;
-    }
-    sorted[j + 1] = key;
-  }
-
-  uint8_t idx = (uint8_t)((uint16_t)pct * (n - 1) / 100);
-  if (idx >= n) idx = n - 1;
-  return sorted[idx];
-}
-
 //=== Determine cycle kind from DHW sample fraction ===
 static SATCycleKind _cycleDetectKind()
 {
@@ -730,18 +728,16 @@ void satCycleOnFlameChange(bool flameOn)
       snprintf_P(_wsMsg, sizeof(_wsMsg), PSTR("{\"type\":\"status\",\"msg\":\"Heating active, setpoint %.1f deg C\"}"), _cycle_setpointAtStart);
       sendWebSocketJSON(_wsMsg);
     }
-    // Reset per-cycle flow sample buffer for p90/p10 classification (Task #225)
-    _flow_sampleHead  = 0;
-    _flow_sampleCount = 0;
+    // Reset per-cycle flow distribution for p90/p10 classification (Task #225)
+    _flow_hist.reset();
     // Seed with current boiler temp so we have at least one sample
-    _flow_samples[_flow_sampleHead] = satGetFlowTemp();
-    _flow_sampleHead = (_flow_sampleHead + 1) % SAT_FLOW_SAMPLE_SIZE;
-    _flow_sampleCount = 1;
+    _flow_hist.add(satGetFlowTemp());
     // Reset tail ring buffer (Task #590: 180s end-of-cycle window)
     memset(_tail_samples, 0, sizeof(_tail_samples));
     _tail_sampleHead  = 0;
     _tail_sampleCount = 0;
     _tail_lastSampleMs = now;
+    _tail_sorted.clear();
     // Reset flow-return delta accumulator (Task #227)
     _cycle_sumFlowRetDelta = 0.0f;
     _cycle_deltasamples    = 0;
@@ -771,16 +767,17 @@ void satCycleOnFlameChange(bool flameOn)
       }
       sendWebSocketJSON(_wsMsg);
     }
-    // Compute p90/p10 from collected flow samples (Task #225)
-    float p90 = (_flow_sampleCount >= 10) ? _flowPercentile(90) : _cycle_maxFlowTemp;
-    float p10 = (_flow_sampleCount >= 10) ? _flowPercentile(10) : _cycle_minFlowTemp;
+    // Compute p90/p10 over the whole cycle's flow samples (Task #225)
+    float p90 = (_flow_hist.count() >= 10) ? _flow_hist.percentile(90) : _cycle_maxFlowTemp;
+    float p10 = (_flow_hist.count() >= 10) ? _flow_hist.percentile(10) : _cycle_minFlowTemp;
     // Task #590: tail-window percentiles (last 180s at 1Hz, or full buffer if shorter).
     // A cycle that self-corrected should not be classified OVERSHOOT from its early peak.
-    float tailP90 = (_tail_sampleCount >= 10) ? _tailPercentile(90) : p90;
-    float tailP10 = (_tail_sampleCount >= 10) ? _tailPercentile(10) : p10;
-    float tailP50 = (_tail_sampleCount >= 10) ? _tailPercentile(50) : (p90 + p10) * 0.5f;
+    const bool tailOk = _tail_sorted.size() >= 10;
+    float tailP90 = tailOk ? _tail_sorted.percentile(90) : p90;
+    float tailP10 = tailOk ? _tail_sorted.percentile(10) : p10;
+    float tailP50 = tailOk ? _tail_sorted.percentile(50) : (p90 + p10) * 0.5f;
     SATDebugTf(PSTR("SAT cycle classify: fullP90=%.1f tailP90=%.1f tailP50=%.1f tailP10=%.1f tailN=%u\r\n"),
-               p90, tailP90, tailP50, tailP10, (unsigned)_tail_sampleCount);
+               p90, tailP90, tailP50, tailP10, (unsigned)_tail_sorted.size());
     // TASK-891.4: mode-aware classification. Snapshot the PID requested setpoint at flame-off
     // (it drifts across a multi-minute cycle) and pick the SHORT threshold from the configured
     // PWM on-time. isPwm follows the active control mode (Python pwm_state.enabled).
@@ -819,14 +816,14 @@ void satCycleOnFlameChange(bool flameOn)
       float avgDelta = (_cycle_deltasamples > 0)
                        ? (_cycle_sumFlowRetDelta / (float)_cycle_deltasamples)
                        : -1.0f;  // sentinel: no valid data
-      _win4h[_win4hHead].endMs          = now;
-      _win4h[_win4hHead].onDurationMs   = onMs;
-      _win4h[_win4hHead].offDurationMs  = offMs;
-      _win4h[_win4hHead].p90FlowTemp    = p90;
-      _win4h[_win4hHead].avgFlowRetDelta = avgDelta;
-      _win4h[_win4hHead].eClass         = (uint8_t)cls;
-      _win4hHead = (_win4hHead + 1) % SAT_WIN4H_SIZE;
-      if (_win4hCount < SAT_WIN4H_SIZE) _win4hCount++;
+      SATWindowRecord rec;
+      rec.endMs           = now;
+      rec.onDurationMs    = onMs;
+      rec.offDurationMs   = offMs;
+      rec.p90FlowTemp     = p90;
+      rec.avgFlowRetDelta = avgDelta;
+      rec.eClass          = (uint8_t)cls;
+      _win4hPush(rec);
 
       // Mirror into the reduced-resolution 24h daily window (TASK-891.4 AC#5)
       _dailyRecord(now, onMs, offMs, cls, durationSec);
@@ -861,18 +858,18 @@ void satCycleSample()
   }
 
   // Collect flow temperature sample for p90/p10 classifier (Task #225)
-  _flow_samples[_flow_sampleHead] = flowTemp;
-  _flow_sampleHead = (_flow_sampleHead + 1) % SAT_FLOW_SAMPLE_SIZE;
-  if (_flow_sampleCount < SAT_FLOW_SAMPLE_SIZE) _flow_sampleCount++;
-  if ((_flow_sampleCount & 0x0F) == 0) { // log every 16th sample to avoid flood
-    SATDebugTf(PSTR("SAT sample: flow=%.1f n=%u sp=%.1f os=%.0fs\r\n"),
-               flowTemp, (unsigned)_flow_sampleCount, _cycle_setpointAtStart, _cycle_overshootSec);
+  _flow_hist.add(flowTemp);
+  if ((_flow_hist.count() & 0x0F) == 0) { // log every 16th sample to avoid flood
+    SATDebugTf(PSTR("SAT sample: flow=%.1f n=%lu sp=%.1f os=%.0fs\r\n"),
+               flowTemp, (unsigned long)_flow_hist.count(), _cycle_setpointAtStart, _cycle_overshootSec);
   }
 
   // Tail ring buffer: 1Hz-gated for time-accurate window (Task #590)
   uint32_t nowMs = millis();
   if (nowMs - _tail_lastSampleMs >= 1000UL) {
+    if (_tail_sampleCount == SAT_TAIL_SAMPLE_SIZE) _tail_sorted.erase(_tail_samples[_tail_sampleHead]);  // evicted
     _tail_samples[_tail_sampleHead] = flowTemp;
+    _tail_sorted.insert(flowTemp);
     _tail_sampleHead = (_tail_sampleHead + 1) % SAT_TAIL_SAMPLE_SIZE;
     if (_tail_sampleCount < SAT_TAIL_SAMPLE_SIZE) _tail_sampleCount++;
     _tail_lastSampleMs = nowMs;
@@ -1280,8 +1277,7 @@ static const uint32_t SAT_CYCLES_STALE_SEC = 14400UL; // 4h stale threshold
 void satFlushCycleWindow()
 {
   LittleFS.remove(FPSTR(SAT_CYCLES_FILE));
-  _win4hHead  = 0;
-  _win4hCount = 0;
+  _win4hReset();
   SATDebugTln(F("SAT: cycle window flushed"));
 }
 
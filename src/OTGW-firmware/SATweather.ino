@@ -23,6 +23,8 @@
 ***************************************************************************
 */
 
+#include "JsonPull.h"
+
 // --- Constants ---
 static const uint16_t WEATHER_POLL_DEFAULT_SEC = 900;  // 15 min default
 static const uint16_t WEATHER_POLL_MIN_SEC     = 300;  // 5 min minimum
@@ -88,206 +90,137 @@ static const char kWeatherOwmUrlFmt[] PROGMEM =
 //=====================================================================
 //=== Streaming JSON parser — no heap allocation ===
 //=====================================================================
-// Single-pass character-by-character parser for the Open-Meteo flat JSON.
-// Uses WiFiClient::peek() for one-byte lookahead so number terminators
-// (commas, brackets) stay unconsumed in the stream for the outer loop.
+// Both APIs are parsed with the JsonPull tokenizer (JsonPull.h): the body
+// is read in TCP-segment-sized blocks into a buffer on the stack and fields
+// are picked out by path ("current/temperature_2m", "main/temp"). Parsing
+// stops when the root object closes, so a kept-alive connection no longer
+// holds the loop for the read timeout after the last byte. The parse loops
+// yield() only while waiting for the next block.
 //
-// Peak stack use: ~60 bytes (keyBuf + numBuf).  No malloc at all.
-// The WiFiClient TCP receive buffer (~1 460 bytes) holds unread bytes
-// while each character is processed one at a time.
-
-// Read one byte from stream; block up to 5 s.  Returns -1 on timeout.
-static int wstreamGet(WiFiClient* s, HTTPClient* h)
-{
-  uint32_t start = millis();
-  while (!s->available()) {
-    if (millis() - start > 5000UL) return -1;  // millis()-wrap-safe
-    if (!h->connected())           return -1;
-    yield();
-  }
-  return s->read();
-}
-
-// Peek at next byte without consuming; block up to 5 s.  Returns -1 on timeout.
-static int wstreamPeek(WiFiClient* s, HTTPClient* h)
-{
-  uint32_t start = millis();
-  while (!s->available()) {
-    if (millis() - start > 5000UL) return -1;  // millis()-wrap-safe
-    if (!h->connected())           return -1;
-    yield();
-  }
-  return s->peek();
-}
-
-// Consume stream up to and including the closing '"'.
-// Opening '"' must already have been consumed.  Handles \" escapes.
-static void wstreamSkipString(WiFiClient* s, HTTPClient* h)
-{
-  int c;
-  while ((c = wstreamGet(s, h)) >= 0) {
-    if (c == '"') return;
-    if (c == '\\') wstreamGet(s, h);  // skip escaped char
-  }
-}
-
-// Consume a complete JSON array (opening '[' already consumed).
-static void wstreamSkipArray(WiFiClient* s, HTTPClient* h)
-{
-  int depth = 1, c;
-  while ((c = wstreamGet(s, h)) >= 0 && depth > 0) {
-    if      (c == '[') depth++;
-    else if (c == ']') depth--;
-    else if (c == '"') wstreamSkipString(s, h);
-    if (depth > 0) yield();
+// Peak stack use: ~1.6 KB (WEATHER_JSON_BLOCK + path).  No malloc at all.
+
+static const uint16_t WEATHER_JSON_BLOCK     = 1460;   // one TCP segment
+static const uint32_t WEATHER_RX_TIMEOUT_MS  = 5000UL; // same budget as http.setTimeout()
+
+// JsonPull source over the HTTP body: hands over what the TCP stack holds,
+// never more than Content-Length, and ends when the server closes or
+// nothing arrives for WEATHER_RX_TIMEOUT_MS.
+struct WeatherHttpSource {
+  WiFiClient* stream;
+  HTTPClient* http;
+  int32_t     remaining;   // body bytes still expected; < 0 = unknown length
+  uint32_t    lastRxMs;
+
+  int read(uint8_t* dst, size_t max) {
+    if (remaining == 0) return -1;
+    const int avail = stream->available();
+    if (avail > 0) {
+      size_t n = ((size_t)avail < max) ? (size_t)avail : max;
+      if (remaining > 0 && (int32_t)n > remaining) n = (size_t)remaining;
+      const int got = stream->read(dst, n);
+      if (got > 0) {
+        lastRxMs = millis();
+        if (remaining > 0) remaining -= got;
+        return got;
+      }
+    }
+    if (!http->connected())                          return -1;
+    if (millis() - lastRxMs > WEATHER_RX_TIMEOUT_MS) return -1;  // millis()-wrap-safe
+    return 0;
   }
-}
+};
 
-// Read a JSON number from stream.  'firstChar' is the first digit or '-'
-// already consumed.  Uses peek() so the terminating delimiter (',', ']',
-// '}', etc.) remains unconsumed for the outer loop to process.
-static float wstreamReadNumber(WiFiClient* s, HTTPClient* h, char firstChar)
-{
-  char numBuf[20];
-  int  numLen = 0;
-  numBuf[numLen++] = firstChar;
-  while (numLen < (int)sizeof(numBuf) - 1) {   // leave room for '\0' at [sizeof-1]
-    int nc = wstreamPeek(s, h);
-    if (nc < 0) break;
-    char c = (char)nc;
-    if (!((c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E')) break;
-    s->read();           // confirmed number char — consume it
-    numBuf[numLen++] = c;
-  }
-  numBuf[numLen] = '\0';
-  return (float)strtod(numBuf, nullptr);
-}
+typedef JsonPull<WeatherHttpSource, WEATHER_JSON_BLOCK> WeatherJson;
 
 // Single-pass streaming parse of the Open-Meteo JSON response.
 // Populates state.sat.weather from the "current":{} section (all platforms).
 // On ESP32 also fills _weather_forecastXxx[] from the "hourly":{} section.
 static void weatherParseStream(WiFiClient* stream, HTTPClient* http)
 {
-  char keyBuf[48];
-  int  keyLen;
-  int  depth        = 0;
-  bool inCurrent    = false;
-  int  currentDepth = 0;
+  WeatherHttpSource src = { stream, http, (int32_t)http->getSize(), millis() };
+  WeatherJson jp(src);
 #if HAS_WEATHER_FORECAST
-  bool inHourly    = false;
-  int  hourlyDepth = 0;
   float*   arrFloat = nullptr;
   uint8_t* arrU8    = nullptr;
-  uint8_t  arrMax   = 0;
   uint8_t  arrPos   = 0;
 #endif
 
-  int ci;
-  while ((ci = wstreamGet(stream, http)) >= 0) {
-    char c = (char)ci;
-
-    if (c == '{') { depth++; continue; }
-    if (c == '}') {
-      if (--depth < currentDepth) inCurrent = false;
-      #if HAS_WEATHER_FORECAST
-      if (  depth < hourlyDepth)  inHourly  = false;
-      #endif
-      continue;
-    }
-    if (c != '"') continue;  // commas, whitespace — skip
+  for (;;) {
+    const JsonPullEvent ev = jp.next();
+    if (ev == JSON_PULL_END) break;
+    if (ev == JSON_PULL_MORE) { yield(); continue; }
 
-    // ── Collect key string ──
-    keyLen = 0;
-    while ((ci = wstreamGet(stream, http)) >= 0 && (char)ci != '"') {
-      if (keyLen < (int)sizeof(keyBuf) - 1) keyBuf[keyLen++] = (char)ci;
-    }
-    keyBuf[keyLen] = '\0';
-
-    // ── Skip to ':' ──
-    while ((ci = wstreamGet(stream, http)) >= 0 && (char)ci != ':');
-    if (ci < 0) break;
-
-    // ── First non-whitespace char of value ──
-    while ((ci = wstreamGet(stream, http)) >= 0 &&
-           ((char)ci == ' ' || (char)ci == '\t' || (char)ci == '\n' || (char)ci == '\r'));
-    if (ci < 0) break;
-    c = (char)ci;
-
-    // ── Dispatch on value type ──
-    if (c == '"') {
-      wstreamSkipString(stream, http);
-
-    } else if (c == '{') {
-      depth++;
-      if (strcmp_P(keyBuf, PSTR("current")) == 0) { inCurrent = true; currentDepth = depth; }
-      #if HAS_WEATHER_FORECAST
-      else if (strcmp_P(keyBuf, PSTR("hourly"))  == 0) { inHourly  = true; hourlyDepth  = depth; }
-      #endif
-
-    } else if (c == '[') {
+    switch (ev) {
+      case JSON_PULL_OBJECT:
+        // Only "current" and "hourly" carry data; *_units are strings.
+        if (jp.depth() > 1 && !jp.pathIs(PSTR("current"))
 #if HAS_WEATHER_FORECAST
-      if (inHourly) {
-        arrFloat = nullptr; arrU8 = nullptr; arrMax = 0; arrPos = 0;
-        if      (strcmp_P(keyBuf, PSTR("temperature_2m"))            == 0) { arrFloat = _weather_forecastTemp;        arrMax = WEATHER_FORECAST_HOURS; }
-        else if (strcmp_P(keyBuf, PSTR("dew_point_2m"))              == 0) { arrFloat = _weather_forecastDewPt;       arrMax = WEATHER_FORECAST_HOURS; }
-        else if (strcmp_P(keyBuf, PSTR("cloud_cover"))               == 0) { arrU8    = _weather_forecastCloud;       arrMax = WEATHER_FORECAST_HOURS; }
-        else if (strcmp_P(keyBuf, PSTR("precipitation_probability")) == 0) { arrU8    = _weather_forecastPrecipProb;  arrMax = WEATHER_FORECAST_HOURS; }
+            && !jp.pathIs(PSTR("hourly"))
+#endif
+           ) jp.skip();
+        break;
 
+      case JSON_PULL_ARRAY:
+#if HAS_WEATHER_FORECAST
+        arrFloat = nullptr; arrU8 = nullptr; arrPos = 0;
+        if      (jp.pathIs(PSTR("hourly/temperature_2m")))            arrFloat = _weather_forecastTemp;
+        else if (jp.pathIs(PSTR("hourly/dew_point_2m")))              arrFloat = _weather_forecastDewPt;
+        else if (jp.pathIs(PSTR("hourly/cloud_cover")))               arrU8    = _weather_forecastCloud;
+        else if (jp.pathIs(PSTR("hourly/precipitation_probability"))) arrU8    = _weather_forecastPrecipProb;
+        if (!arrFloat && !arrU8) jp.skip();
+#else
+        jp.skip();
+#endif  // HAS_WEATHER_FORECAST
+        break;
+
+#if HAS_WEATHER_FORECAST
+      case JSON_PULL_ARRAY_END:
+        if (arrFloat == _weather_forecastTemp) _weather_forecastCount = arrPos;
+        arrFloat = nullptr; arrU8 = nullptr;
+        break;
+
+      case JSON_PULL_LITERAL:
+        if ((arrFloat || arrU8) && jp.isNull() && arrPos < WEATHER_FORECAST_HOURS) {
+          if (arrFloat) arrFloat[arrPos++] = 0.0f; else arrU8[arrPos++] = 0;
+        }
+        break;
+#endif  // HAS_WEATHER_FORECAST
+
+      case JSON_PULL_NUMBER: {
+        const float val = jp.number();
+#if HAS_WEATHER_FORECAST
         if (arrFloat || arrU8) {
-          while ((ci = wstreamGet(stream, http)) >= 0) {
-            c = (char)ci;
-            if (c == ']') break;
-            if (c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r') continue;
-            if (c == 'n') {                                         // null
-              for (int i = 0; i < 3; i++) wstreamGet(stream, http);  // consume 'ull' after 'n'
-              if (arrPos < arrMax) { if (arrFloat) arrFloat[arrPos++] = 0.0f; else arrU8[arrPos++] = 0; }
-              continue;
-            }
-            if ((c >= '0' && c <= '9') || c == '-') {
-              float val = wstreamReadNumber(stream, http, c);
-              if (arrPos < arrMax) {
-                if (arrFloat) arrFloat[arrPos++] = val;
-                else          arrU8[arrPos++]    = (val < 0 ? 0 : val > 255 ? 255 : (uint8_t)(int)val);
-              }
-            }
+          if (arrPos < WEATHER_FORECAST_HOURS) {
+            if (arrFloat) arrFloat[arrPos++] = val;
+            else          arrU8[arrPos++]    = (val < 0 ? 0 : val > 255 ? 255 : (uint8_t)(int)val);
           }
-          if (arrFloat == _weather_forecastTemp) _weather_forecastCount = arrPos;
-        } else {
-          wstreamSkipArray(stream, http);
+          break;
         }
-      } else {
-        wstreamSkipArray(stream, http);
-      }
-#else
-      wstreamSkipArray(stream, http);
 #endif  // HAS_WEATHER_FORECAST
-
-    } else if ((c >= '0' && c <= '9') || c == '-') {
-      // ── Scalar number ──
-      float val = wstreamReadNumber(stream, http, c);
-      if (inCurrent) {
+        if (jp.depth() != 2) break;
         // Core SAT fields — both platforms
-        if      (strcmp_P(keyBuf, PSTR("temperature_2m"))       == 0) state.sat.weather.fTemperature  = val;
-        else if (strcmp_P(keyBuf, PSTR("apparent_temperature")) == 0) state.sat.weather.fApparentTemp  = val;
-        else if (strcmp_P(keyBuf, PSTR("relative_humidity_2m")) == 0) state.sat.weather.fHumidity      = val;
-        else if (strcmp_P(keyBuf, PSTR("wind_speed_10m"))       == 0) state.sat.weather.fWindSpeed     = val;
-        else if (strcmp_P(keyBuf, PSTR("cloud_cover"))          == 0) state.sat.weather.fCloudCover    = val;
+        if      (jp.pathIs(PSTR("current/temperature_2m")))       state.sat.weather.fTemperature  = val;
+        else if (jp.pathIs(PSTR("current/apparent_temperature"))) state.sat.weather.fApparentTemp  = val;
+        else if (jp.pathIs(PSTR("current/relative_humidity_2m"))) state.sat.weather.fHumidity      = val;
+        else if (jp.pathIs(PSTR("current/wind_speed_10m")))       state.sat.weather.fWindSpeed     = val;
+        else if (jp.pathIs(PSTR("current/cloud_cover")))          state.sat.weather.fCloudCover    = val;
 #if HAS_WEATHER_FORECAST
         // Extended fields — ESP32 only (not requested in ESP8266 URL)
-        else if (strcmp_P(keyBuf, PSTR("wind_direction_10m"))   == 0) state.sat.weather.fWindDirection = val;
-        else if (strcmp_P(keyBuf, PSTR("wind_gusts_10m"))       == 0) state.sat.weather.fWindGusts     = val;
-        else if (strcmp_P(keyBuf, PSTR("pressure_msl"))         == 0) state.sat.weather.fPressureMsl   = val;
-        else if (strcmp_P(keyBuf, PSTR("precipitation"))        == 0) state.sat.weather.fPrecipitation = val;
-        else if (strcmp_P(keyBuf, PSTR("rain"))                 == 0) state.sat.weather.fRain          = val;
-        else if (strcmp_P(keyBuf, PSTR("snowfall"))             == 0) state.sat.weather.fSnowfall      = val;
-        else if (strcmp_P(keyBuf, PSTR("weather_code"))         == 0) state.sat.weather.iWeatherCode   = (uint16_t)val;
-        else if (strcmp_P(keyBuf, PSTR("is_day"))               == 0) state.sat.weather.bIsDay         = (val > 0.0f);
+        else if (jp.pathIs(PSTR("current/wind_direction_10m")))   state.sat.weather.fWindDirection = val;
+        else if (jp.pathIs(PSTR("current/wind_gusts_10m")))       state.sat.weather.fWindGusts     = val;
+        else if (jp.pathIs(PSTR("current/pressure_msl")))         state.sat.weather.fPressureMsl   = val;
+        else if (jp.pathIs(PSTR("current/precipitation")))        state.sat.weather.fPrecipitation = val;
+        else if (jp.pathIs(PSTR("current/rain")))                 state.sat.weather.fRain          = val;
+        else if (jp.pathIs(PSTR("current/snowfall")))             state.sat.weather.fSnowfall      = val;
+        else if (jp.pathIs(PSTR("current/weather_code")))         state.sat.weather.iWeatherCode   = (uint16_t)val;
+        else if (jp.pathIs(PSTR("current/is_day")))               state.sat.weather.bIsDay         = (val > 0.0f);
 #endif  // HAS_WEATHER_FORECAST
+        break;
       }
-    }
-    // else: true/false/null at top level — not needed for weather fields
 
-    yield();
+      default:   // keys, strings, true/false — not needed for weather fields
+        break;
+    }
   }
 }
 
@@ -421,50 +354,25 @@ static void weatherFetchOpenMeteo()
 }
 
 // Extract main.temp from OWM current-weather response.
-// Minimal streaming parse: find "main":{..."temp":<num>}.
+// "weather":[{"main":"Clouds",...}] comes first in the body; selecting by
+// path ignores it and skips every other subtree.
 static bool weatherParseOwmTemp(WiFiClient* stream, HTTPClient* http, float* outTemp)
 {
-  static const char kNeedleMain[] PROGMEM = "\"main\":";
-  static const char kNeedleTemp[] PROGMEM = "\"temp\":";
-
-  const size_t mainLen = sizeof(kNeedleMain) - 1;
-  const size_t tempLen = sizeof(kNeedleTemp) - 1;
+  WeatherHttpSource src = { stream, http, (int32_t)http->getSize(), millis() };
+  WeatherJson jp(src);
 
-  uint8_t mainPos = 0;
-  bool inMain = false;
-  uint8_t tempPos = 0;
+  for (;;) {
+    const JsonPullEvent ev = jp.next();
+    if (ev == JSON_PULL_END) return false;
+    if (ev == JSON_PULL_MORE) { yield(); continue; }
 
-  int ci;
-  while ((ci = wstreamGet(stream, http)) >= 0) {
-    char c = (char)ci;
-
-    if (!inMain) {
-      if (c == (char)pgm_read_byte(&kNeedleMain[mainPos])) {
-        if (++mainPos >= mainLen) { inMain = true; }
-      } else {
-        mainPos = (c == (char)pgm_read_byte(&kNeedleMain[0])) ? 1 : 0;
-      }
-      continue;
-    }
-
-    if (c == (char)pgm_read_byte(&kNeedleTemp[tempPos])) {
-      if (++tempPos >= tempLen) {
-        // Skip whitespace after ':'
-        while ((ci = wstreamGet(stream, http)) >= 0) {
-          c = (char)ci;
-          if (!(c == ' ' || c == '\t' || c == '\n' || c == '\r')) break;
-        }
-        if (ci < 0) return false;
-        if (!((c >= '0' && c <= '9') || c == '-' || c == '+')) return false;
-        *outTemp = wstreamReadNumber(stream, http, c);
-        return true;
-      }
-    } else {
-      tempPos = (c == (char)pgm_read_byte(&kNeedleTemp[0])) ? 1 : 0;
+    if (ev == JSON_PULL_NUMBER && jp.pathIs(PSTR("main/temp"))) {
+      *outTemp = jp.number();
+      return true;
     }
+    if ((ev == JSON_PULL_OBJECT || ev == JSON_PULL_ARRAY) &&
+        jp.depth() > 1 && !jp.pathIs(PSTR("main"))) jp.skip();
   }
-
-  return false;
 }
 
 static void weatherFetchOwm()
@@ -0,0 +1,138 @@
+/*
+***************************************************************************
+**  Program  : SseEvents.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Bookkeeping for the GET /api/v2/events Server-Sent Events stream
+**  (sseStuff.ino). One long-lived connection carries what a dashboard
+**  otherwise polls for:
+**
+**    ot      the otmonitor document: in full after a connect, then only
+**            the changed entries ("delta":true), from the generations in
+**            OTmonDelta.h
+**    sat     the /api/v2/sat/status document, when it changed
+**    health  the /api/v2/health document, when it changed
+**
+**  A client picks topics with ?topics=ot,sat (default: all). Each topic
+**  combination has its own AsyncEventSource; an event is rendered once and
+**  sent to every source that includes its topic, and nothing is rendered
+**  for a topic no connected client asked for.
+**
+**  Coalescing: a topic sends at most once per interval. Changes in between
+**  are not queued; the next event carries the state as it is then (for ot,
+**  every entry that changed since the previous event).
+**
+**  No Arduino dependency: tests/test_sse_events.cpp includes this header
+**  directly.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef SSEEVENTS_H
+#define SSEEVENTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef SSE_MAX_CLIENTS
+#define SSE_MAX_CLIENTS 4
+#endif
+
+enum SseTopic : uint8_t { SSE_TOPIC_OT = 0, SSE_TOPIC_SAT, SSE_TOPIC_HEALTH, SSE_TOPIC_COUNT };
+
+#define SSE_TOPIC_ALL ((uint8_t)((1u << SSE_TOPIC_COUNT) - 1))
+
+static const char kSseTopicNames[SSE_TOPIC_COUNT][8] = { "ot", "sat", "health" };
+
+// "ot,sat" -> mask. nullptr or "" is every topic. False on an unknown or
+// empty name (a stray comma), leaving mask untouched.
+inline bool sseParseTopics(const char *s, uint8_t &mask)
+{
+  if (!s || !*s) { mask = SSE_TOPIC_ALL; return true; }
+  uint8_t m = 0;
+  while (true) {
+    const char *end = strchr(s, ',');
+    const size_t len = end ? (size_t)(end - s) : strlen(s);
+    uint8_t t = 0;
+    while (t < SSE_TOPIC_COUNT && !(strlen(kSseTopicNames[t]) == len && strncmp(kSseTopicNames[t], s, len) == 0)) t++;
+    if (t == SSE_TOPIC_COUNT) return false;
+    m |= (uint8_t)(1u << t);
+    if (!end) break;
+    s = end + 1;
+  }
+  mask = m;
+  return true;
+}
+
+// One event source per topic combination (sseStuff.ino), so a client only
+// receives the topics it asked for, and the sat topic (behind HTTP auth) never
+// reaches a client that did not pass the check. Source index = mask - 1.
+#define SSE_SOURCE_COUNT SSE_TOPIC_ALL
+
+inline uint8_t sseSourceIndex(uint8_t mask)
+{
+  return (uint8_t)(mask - 1);             // mask 1..SSE_TOPIC_ALL, from sseParseTopics()
+}
+
+inline bool sseSourceHasTopic(uint8_t source, uint8_t topic)
+{
+  return ((source + 1u) >> topic) & 1u;
+}
+
+// Per-topic send gate: at most one event per interval, and only when the
+// content differs from the last one sent (hash) or a full send was asked for.
+struct SseGate {
+  uint32_t lastMs   = 0;
+  uint32_t hash     = 0;
+  bool     sent     = false;              // anything sent since the last reset
+  bool     wantFull = true;               // next event must be a full document
+};
+
+// Interval check only; the caller renders and hashes after this says yes.
+inline bool sseGateDue(const SseGate &g, uint32_t nowMs, uint32_t intervalMs)
+{
+  return !g.sent || (uint32_t)(nowMs - g.lastMs) >= intervalMs;
+}
+
+inline bool sseGateChanged(const SseGate &g, uint32_t hash)
+{
+  return !g.sent || g.wantFull || hash != g.hash;
+}
+
+inline void sseGateCommit(SseGate &g, uint32_t nowMs, uint32_t hash)
+{
+  g.lastMs   = nowMs;
+  g.hash     = hash;
+  g.sent     = true;
+  g.wantFull = false;
+}
+
+// A client connected: it has no state yet, so every topic starts full.
+inline void sseGateRequestFull(SseGate &g)
+{
+  g.wantFull = true;
+}
+
+#endif // SSEEVENTS_H
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
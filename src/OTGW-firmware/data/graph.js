@@ -33,6 +33,7 @@ var OTGraph = {
     disconnectMarkers: [], // Track disconnect/reconnect events: [{time: timestamp, type: 'disconnect'|'reconnect'}]
     resizeHandler: null, // Store resize handler reference for cleanup
     initialized: false, // Track if already initialized to prevent duplicate event listeners
+    historyLoaded: false, // /api/v2/history backfill requested (once per page load)
     
     // Store DOM event handler references for cleanup
     timeWindowHandler: null,
@@ -219,6 +220,45 @@ var OTGraph = {
         }, this.updateInterval);
         
         this.initialized = true;
+        this.loadHistory();
+    },
+
+    // Backfill the graph from the firmware's history store (GET /api/v2/history)
+    // so it does not start empty. Only points older than the first live point of
+    // a series are added; the live stream keeps appending as before.
+    loadHistory: function() {
+        if (this.historyLoaded || typeof APIGW === 'undefined') return;
+        this.historyLoaded = true;
+        var keys = {
+            flow: 'boiler', 'return': 'return', room: 'room', room_setpoint: 'roomSp',
+            ctrl_setpoint: 'ctrlSp', modulation: 'mod', flame: 'flame'
+        };
+        fetch(APIGW + 'v2/history?metrics=' + Object.keys(keys).join(','))
+            .then(r => r.ok ? r.json() : null)
+            .then(h => {
+                if (!h || !h.series || !this.chart) return;
+                var stepMs = h.step * 1000;
+                var scale = h.scale || 100;
+                Object.keys(keys).forEach(metric => {
+                    var key = keys[metric];
+                    var s = h.series[metric];
+                    if (!s || !Array.isArray(s.segments) || !this.data[key]) return;
+                    var live = this.data[key];
+                    var firstLive = live.length ? live[0].value[0].getTime() : Infinity;
+                    var points = [];
+                    s.segments.forEach(seg => {
+                        seg.v.forEach((v, i) => {
+                            var ms = seg.t * 1000 + i * stepMs;
+                            if (v === null || ms >= firstLive) return;
+                            var time = new Date(ms);
+                            points.push({ name: time.toString(), value: [time, v / scale] });
+                        });
+                    });
+                    if (points.length) this.data[key] = points.concat(live);
+                });
+                this.updateOption();
+            })
+            .catch(e => console.warn('Graph history not loaded', e));
     },
 
     getCachedSensorLabel: function(address, labelMap) {
@@ -5737,18 +5737,94 @@ function refreshDevInfo() {
 } // refreshDevInfo()
 
 //============================================================================  
+// The firmware tags every otmonitor reply with a change token (ETag). Handing
+// it back as ?since= returns only the fields that changed ("delta":true), or a
+// bodyless 304 when nothing did; otmonCache is the full map the deltas are
+// merged into, re-applied on every poll so the graph keeps its cadence.
+let otmonToken = null;
+let otmonCache = null;
+
+// GET /api/v2/events pushes the same changes as "ot" events while the page is
+// open. While the stream is live refreshOTmonitor() re-applies otmonCache
+// instead of fetching; on any stream error it closes and polling takes over,
+// with another try a minute later (the gateway caps the number of streams).
+const OTMON_EVENTS_RETRY_MS = 60000;
+let otmonEvents = null;
+let otmonEventsLive = false;
+let otmonEventsRetryAt = 0;
+
+function closeOTmonitorEvents() {
+  if (otmonEvents) otmonEvents.close();
+  otmonEvents = null;
+  if (otmonEventsLive) otmonToken = null;   // the stream carries no REST token
+  otmonEventsLive = false;
+}
+
+function openOTmonitorEvents() {
+  if (otmonEvents || !window.EventSource || Date.now() < otmonEventsRetryAt) return;
+  var es = new EventSource(APIGW + "v2/events?topics=ot");
+  otmonEvents = es;
+  // A stream that connects while the gateway is sending an ot event can get
+  // that delta before its own full document; otmonCache may still hold an
+  // older poll. Deltas count only once this stream delivered a full one.
+  var seenFull = false;
+  es.addEventListener('ot', function (e) {
+    var json;
+    try { json = JSON.parse(e.data); } catch (err) { return; }
+    if (!json.delta) {
+      otmonCache = json.otmonitor || {};
+      seenFull = true;
+    } else if (seenFull) {
+      Object.assign(otmonCache, json.otmonitor);
+    } else {
+      return;
+    }
+    otmonEventsLive = true;
+  });
+  es.onerror = function () {
+    if (otmonEvents !== es) return;
+    closeOTmonitorEvents();
+    otmonEventsRetryAt = Date.now() + OTMON_EVENTS_RETRY_MS;
+  };
+}
+
 // Resolves to {status, retryAfterMs}, or null when this client opted out of the
 // cycle. Never rejects — the paced poller reads the status.
 function refreshOTmonitor() {
-  if (flashModeActive || !isPageVisible() || !isMainPageActive()) return Promise.resolve(null);
+  if (flashModeActive || !isPageVisible() || !isMainPageActive()) {
+    closeOTmonitorEvents();
+    return Promise.resolve(null);
+  }
 
   data = {};
-  return fetch(APIGW + "v2/otgw/otmonitor")  //api/v2/otgw/otmonitor
+  openOTmonitorEvents();
+  if (otmonEventsLive && otmonCache) {
+    applyOTmonitor({ otmonitor: otmonCache });
+    return Promise.resolve({ status: 200 });
+  }
+  var url = APIGW + "v2/otgw/otmonitor";  //api/v2/otgw/otmonitor
+  if (otmonToken && otmonCache) url += "?since=" + encodeURIComponent(otmonToken);
+  // no-store: the browser must not turn ?since= into its own conditional GET.
+  return fetch(url, { cache: 'no-store' })
     .then(response => {
+      if (response.status === 304 && otmonCache) {
+        applyOTmonitor({ otmonitor: otmonCache });
+        return { status: 200 };
+      }
       if (!response.ok) {
         return pollFailureInfo(response);
       }
-      return response.json().then(json => { applyOTmonitor(json); return { status: 200 }; });
+      var etag = response.headers.get('ETag');
+      return response.json().then(json => {
+        if (json.delta && otmonCache) {
+          Object.assign(otmonCache, json.otmonitor);
+        } else {
+          otmonCache = json.otmonitor || {};
+        }
+        otmonToken = etag ? etag.replace(/^W\//, '').replace(/"/g, '') : (json.gen || null);
+        applyOTmonitor({ otmonitor: otmonCache });
+        return { status: 200 };
+      });
     })
     .catch(function (error) {
       if (flashModeActive || !isPageVisible()) return { status: 0 };
@@ -7458,6 +7534,7 @@ var translateFields = [
   , ["mqttotmessage", "MQTT Raw OpenTherm Messages"]
   , ["mqttseparatesources", "MQTT Separate Sources"]
   , ["mqttuselegacyottopics", "MQTT Use Legacy OT Topics"]
+  , ["mqttdevicediscovery", "MQTT Device-Based Discovery"]
   , ["legacyport25238enabled", "Legacy TCP Port 25238"]
   , ["otgwcommandenable", "Run Boot Command"]
   , ["otgwcommands", "Boot Command"]
@@ -7666,6 +7743,7 @@ var translateTooltips = [
   , ["mqttinterval", "Heartbeat interval in seconds: how often an unchanged value is re-published so Home Assistant does not flag the sensor as unavailable. Changed values are always published immediately regardless of this setting. Only used when MQTT Publish On-Change is on; 60 is a good default, lower means fresher data but more traffic."]
   , ["mqttotmessage", "Publish raw OpenTherm messages on MQTT for diagnostics and advanced integrations."]
   , ["mqttseparatesources", "Publish thermostat and boiler values on separate MQTT topics when available."]
+  , ["mqttdevicediscovery", "Announce the sensors and binary sensors to Home Assistant in a few device discovery messages instead of one message per entity. Needs Home Assistant 2024.11 or newer. Switching clears the old discovery topics; entity IDs stay the same."]
   , ["legacyport25238enabled", "Enable the legacy otmonitor TCP bridge on port 25238. Leave disabled unless pyotgw, otmonitor, or another external TCP client needs it."]
   , ["ntpenable", "Use an NTP server to keep the gateway clock in sync."]
   , ["ntptimezone", "Timezone name used for local time and daylight saving changes."]
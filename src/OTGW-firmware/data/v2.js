@@ -414,8 +414,94 @@
     return m[1] === '>' ? 'cmd' : m[1] === '<' ? 'rsp' : m[1] === '!' ? 'err' : 'evt';
   }
 
+  // ---------- Binary OT frame stream (OTWsBinary.h) ----------
+  // Once GET v2/otgw/otmap has loaded, the socket asks for the binary stream and
+  // the per-frame lines arrive as batched 8-byte records. Each record is turned
+  // back into the line the firmware would have sent, in the same columns, so
+  // rawFromLine/updateStats/the log console work unchanged. Values are decoded
+  // per OTmap type; the firmware's id-specific decoders (status bits, solar,
+  // remote commands) show here as the generic flag/byte form. Firmware without
+  // the endpoint answers 404 and the socket simply stays on text.
+  var WS_BIN_MAGIC = 0xB7, WS_BIN_VERSION = 1;
+  var otMap = null, otMapLoading = false;
+  var BIN_SRC = { T: 'Thermostat', B: 'Boiler', R: 'Request Boiler', A: 'Answer Thermostat', E: 'Parity Error' };
+  var BIN_MSGTYPE = ['Read-Data', 'Write-Data', 'Invalid-Data', 'Reserved', 'Read-Ack', 'Write-Ack', 'Data-Invalid', 'Unknown-Data-Id'];
+  function loadOtMap() {
+    if (otMap || otMapLoading) return;
+    otMapLoading = true;
+    fetch(APIGW + 'v2/otgw/otmap').then(function (r) { return r.ok ? r.json() : null; }).then(function (j) {
+      otMapLoading = false;
+      if (!j || j.version !== WS_BIN_VERSION || !j.msgids) return;
+      var m = {};
+      j.msgids.forEach(function (e) { m[e.id] = e; });
+      otMap = m;
+      requestBinaryStream();
+    }).catch(function () { otMapLoading = false; });
+  }
+  function requestBinaryStream() {
+    if (otMap && ws && ws.readyState === 1) ws.send('{"stream":"binary","v":' + WS_BIN_VERSION + '}');
+  }
+  function padL(s, n) { s = '' + s; while (s.length < n) s = ' ' + s; return s; }
+  function padR(s, n) { s = '' + s; while (s.length < n) s += ' '; return s; }
+  function bits8(b) { return ('0000000' + b.toString(2)).slice(-8); }
+  function binValue(type, hb, lb) {
+    var u16 = (hb << 8) | lb, s16 = u16 > 32767 ? u16 - 65536 : u16;
+    var s8 = function (b) { return b > 127 ? b - 256 : b; };
+    switch (type) {
+      case 'f88': { var t = (s16 / 256).toFixed(2); return t === '-0.00' ? '0.00' : t; }
+      case 's16': return '' + s16;
+      case 'u16': return '' + u16;
+      case 's8s8': return padL(s8(hb), 3) + ' / ' + padL(s8(lb), 3);
+      case 'u8u8': return padL(hb, 3) + ' / ' + padL(lb, 3);
+      case 'u8': return padL(lb, 3);
+      case 'flag8': return 'flag8 = [' + bits8(lb) + '] - decimal = [' + padL(lb, 3) + ']';
+      case 'flag8u8': return 'M[' + bits8(hb) + '] - [' + padL(lb, 3) + ']';
+      case 'flag8flag8': return 'Master [' + bits8(hb) + '] Slave [' + bits8(lb) + ']';
+      default: return '0x' + ('000' + u16.toString(16).toUpperCase()).slice(-4);
+    }
+  }
+  function binLine(msOfDay, src, flags, frame) {
+    var hh = Math.floor(msOfDay / 3600000), mm = Math.floor(msOfDay / 60000) % 60;
+    var ss = Math.floor(msOfDay / 1000) % 60, ms = msOfDay % 1000;
+    var two = function (v) { return (v < 10 ? '0' : '') + v; };
+    var type = (frame >>> 28) & 0x7, id = (frame >>> 16) & 0xFF;
+    var hb = (frame >>> 8) & 0xFF, lb = frame & 0xFF;
+    var ind = src === 'E' ? 'P' : (flags & 0x04) ? '-' : (flags & 0x01) ? '>' : ' ';
+    var e = otMap[id], label = e ? e.label : 'Unknown';
+    var text = label;
+    if ((flags & 0x02) && e) text += ' = ' + binValue(e.type, hb, lb) + (e.unit ? ' ' + e.unit : '');
+    var line = two(hh) + ':' + two(mm) + ':' + two(ss) + '.' + ('00' + ms).slice(-3) + ' ' +
+      padR(BIN_SRC[src] || 'Unknown', 18) + ' ' + src + ('0000000' + frame.toString(16).toUpperCase()).slice(-8) +
+      ' ' + padL(id, 3) + ' ' + padR(BIN_MSGTYPE[type], 16) + ind + ' ' + text;
+    if (flags & 0x04) line += ' <ignored> ';
+    if (type === 7) line += (flags & 0x10) ? ' (boiler rejected write)' : ' (boiler does not implement)';
+    return line;
+  }
+  function onWsBinary(buf) {
+    if (!otMap || buf.byteLength < 8) return;
+    var dv = new DataView(buf);
+    if (dv.getUint8(0) !== WS_BIN_MAGIC || dv.getUint8(1) !== WS_BIN_VERSION) return;
+    var n = dv.getUint16(2, true);
+    if (buf.byteLength !== 8 + n * 8) return;
+    var t = dv.getUint32(4, true);
+    for (var i = 0; i < n; i++) {
+      var off = 8 + i * 8;
+      t = (t + dv.getUint16(off, true)) % 86400000;
+      var src = String.fromCharCode(dv.getUint8(off + 2));
+      var frame = dv.getUint32(off + 4, true);
+      var raw = src + ('0000000' + frame.toString(16).toUpperCase()).slice(-8);
+      var line = binLine(t, src, dv.getUint8(off + 3), frame);
+      applyFrame(raw);
+      pushTicker(line);
+      pushLog(line);
+      updateStats(line, raw);
+    }
+    if (n && activeDesign() === 'c') scheduleRender();
+  }
+
   function onWsMessage(ev) {
     var d = ev.data;
+    if (d instanceof ArrayBuffer) { onWsBinary(d); return; }
     if (typeof d !== 'string') return;
     if (d.indexOf('"type":"keepalive"') !== -1) return;
     if (d.charAt(0) === '{' || d.charAt(0) === '[') return; // JSON status, not a frame
@@ -801,6 +887,8 @@
     var url = (location.protocol === 'https:' ? 'wss://' : 'ws://') + location.host + WS_PATH;
     try {
       ws = new WebSocket(url);
+      ws.binaryType = 'arraybuffer';
+      ws.onopen = function () { if (otMap) requestBinaryStream(); else loadOtMap(); };
       ws.onmessage = onWsMessage;
       ws.onclose = function () { ws = null; scheduleReconnect(); fetchSeed(); };
       ws.onerror = function () { try { if (ws) ws.close(); } catch (e) { } };
@@ -1422,6 +1510,7 @@
     mqttotmessage:   { cat: 'mqtt', sub: 'HA & publishing', label: 'Publish raw OT messages' },
     mqttseparatesources:   { cat: 'mqtt', sub: 'HA & publishing', label: 'Separate thermostat/boiler topics' },
     mqttuselegacyottopics: { cat: 'mqtt', sub: 'HA & publishing', label: 'Legacy OT topic layout' },
+    mqttdevicediscovery:   { cat: 'mqtt', sub: 'HA & publishing', label: 'Device-based HA discovery' },
     legacyport25238enabled:{ cat: 'otgw', label: 'Legacy TCP port 25238' },
     ntpenable:       { cat: 'ntp', label: 'Enable NTP' },
     ntptimezone:     { cat: 'ntp', label: 'Timezone' },
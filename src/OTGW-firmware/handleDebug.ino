@@ -59,6 +59,7 @@ static void dumpDebugInfo() {
     Debugf(PSTR("separate_sources: %s\r\n"), settings.mqtt.bSeparateSources ? "true" : "false");
     Debugf(PSTR("disc_auto_verify: %s\r\n"), settings.mqtt.bDiscoveryAutoVerify ? "true" : "false");
     Debugf(PSTR("use_legacy_ot_topics: %s\r\n"), settings.mqtt.bUseLegacyOtTopics ? "true" : "false");
+    Debugf(PSTR("device_discovery: %s\r\n"), settings.mqtt.bDeviceDiscovery ? "true" : "false");
     Debugf(PSTR("legacy_port25238: %s\r\n"), settings.mqtt.bLegacyPort25238Enabled ? "true" : "false");
 
     Debugln(F("[settings.ntp]"));
@@ -293,6 +294,24 @@ static void dumpDebugInfo() {
     Debugln(F("--- DUMP END ---"));
 }
 
+// Loop-task section timings (LoopProfile.h), one line per section that ran.
+// p50/p99 are bucket upper bounds (at most 2x the real value).
+static void dumpLoopProfile() {
+    Debugln(F("--- LOOP PROFILE ---"));
+    Debugf(PSTR("window: %lu s (reset with 'z')\r\n"),
+           (unsigned long)((millis() - loopProfile.sinceMs) / 1000));
+    Debugln(F("section         calls      avg_us   p50_us   p99_us   max_us   total_ms"));
+    for (uint8_t i = 0; i < LPS_COUNT; i++) {
+        const LoopProfStat st = loopProfile.s[i];
+        if (st.calls == 0) continue;
+        Debugf(PSTR("%-14s %10lu %8lu %8lu %8lu %8lu %10lu\r\n"), loopProfSectionName(i),
+               (unsigned long)st.calls, (unsigned long)loopProfAvgUs(st),
+               (unsigned long)loopProfPercentileUs(st, 50), (unsigned long)loopProfPercentileUs(st, 99),
+               (unsigned long)st.maxUs, (unsigned long)(st.totalUs / 1000));
+    }
+    Debugln(F("--- LOOP PROFILE END ---"));
+}
+
 // Dispatch a single keypress from the telnet debug session.
 // Called from onTelnetInput() in networkStuff.ino via the SimpleTelnet
 // onInputReceived callback (line mode off — one char per call).
@@ -321,7 +340,8 @@ void handleDebugChar(char c){
                 Debugln(F("  a) Send PR=A to identify PIC firmware version & type"));
                 Debugln(F("  s/S) Toggle OTGW serial-simulation replay"));
                 Debugln(F("  w) Trigger Open-Meteo weather fetch and dump state"));
-                Debugln(F("  z) Reset heap soak diagnostics (watermark, histogram, counters)"));
+                Debugln(F("  L) Show loop-task section timings (calls, p50/p99/max us)"));
+                Debugln(F("  z) Reset heap soak diagnostics (watermark, histogram, counters, loop profile)"));
                 Debugln(F("--- GPIO / Misc ---"));
                 Debugln(F("  b) Blink LED 1 (5x)"));
                 Debugln(F("  i) Initialize relay outputs"));
@@ -335,6 +355,9 @@ void handleDebugChar(char c){
             case 'D':
                 dumpDebugInfo();
                 break;
+            case 'L':
+                dumpLoopProfile();
+                break;
             case 'p':
                 // ADR-127: on a combo running OTDirect the PIC reset line is
                 // the W5500 SPI clock — never pulse it in that mode.
@@ -484,7 +507,7 @@ void handleDebugChar(char c){
                 break;
             case 'z':
                 resetHeapWatermark();
-                DebugTln(F("Heap soak diagnostics reset (watermark + histogram + pressure counters; min_free_heap is native, not reset). Use from a healthy heap for accurate tier counts."));
+                DebugTln(F("Heap soak diagnostics reset (watermark + histogram + pressure counters + loop profile; min_free_heap is native, not reset). Use from a healthy heap for accurate tier counts."));
                 break;
             default:
                 break;
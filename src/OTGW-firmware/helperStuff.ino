@@ -16,30 +16,56 @@
 //===========================================================================================
 // Get High Resolution Timestamp for Logs
 //===========================================================================================
-const char* getOTLogTimestamp() {
-  static char timestamp[16]; // "HH:MM:SS.mmmmmm"
+// Called once per OT frame from processOT(). The zone is resolved through
+// timezoneManager only when the cached UTC offset runs out (next DST
+// transition, 35-day horizon, clock step, or timezone setting change);
+// every other frame is an integer add + digit formatting (OTLogTimestamp.h).
+static OTLogTzCache otLogTzCache;
+
+void invalidateOTLogTimestampZone() {
+  otLogTzCacheInvalidate(otLogTzCache);
+}
+
+// Local epoch seconds + microseconds now, through the cached zone offset.
+static int64_t otLogLocalNow(uint32_t &usec) {
   timeval now;
   gettimeofday(&now, nullptr);
-  // Default to UTC if not initialized, but typically settings.ntp.sTimezone is valid
-  // Recreating the timezone object is what _debugBOL does, so we follow that pattern
-  // assuming timezoneManager is available.
-  TimeZone myTz = timezoneManager.createForZoneName(CSTR(settings.ntp.sTimezone));
-  if (myTz.isError()) {
-    // Fallback if generic name failed
-    myTz = TimeZone::forTimeOffset(TimeOffset::forMinutes(0)); 
+  const int64_t utcSec = (int64_t)now.tv_sec;
+  usec = (uint32_t)now.tv_usec;
+
+  if (!otLogTzCacheValid(otLogTzCache, utcSec)) {
+    TimeZone myTz = timezoneManager.createForZoneName(CSTR(settings.ntp.sTimezone));
+    if (myTz.isError()) {
+      // Fallback if generic name failed
+      myTz = TimeZone::forTimeOffset(TimeOffset::forMinutes(0));
+    }
+    otLogTzResolve(otLogTzCache, utcSec, [&myTz](int64_t t) -> int32_t {
+      ZonedDateTime zdt = ZonedDateTime::forUnixSeconds64(t, myTz);
+      // Before NTP sync the clock sits outside AceTime's range: log UTC.
+      return zdt.isError() ? 0 : zdt.timeOffset().toSeconds();
+    });
   }
-  
-  ZonedDateTime myTime = ZonedDateTime::forUnixSeconds64(now.tv_sec, myTz);
 
-  // 6 digit subsecond resolution from microseconds (0..999999)
-  const unsigned long subSeconds = (unsigned long)(now.tv_usec);
-
-  snprintf_P(timestamp, sizeof(timestamp), PSTR("%02d:%02d:%02d.%06lu"),
-           myTime.hour(), myTime.minute(), myTime.second(), subSeconds);
+  return utcSec + otLogTzCache.offsetSec;
+}
 
+const char* getOTLogTimestamp() {
+  static char timestamp[OT_LOG_TIMESTAMP_LEN]; // "HH:MM:SS.uuuuuu"
+  uint32_t usec;
+  const int64_t localSec = otLogLocalNow(usec);
+  otLogFormatTimestamp(timestamp, localSec, usec);
   return timestamp;
 }
 
+// Time of day of the binary WebSocket stream (OTWsBinary.h): the clock the
+// text line's "HH:MM:SS" shows, in ms since local midnight.
+uint32_t getOTLogMsOfDay() {
+  uint32_t usec;
+  int32_t sod = (int32_t)(otLogLocalNow(usec) % 86400);
+  if (sod < 0) sod += 86400;
+  return (uint32_t)sod * 1000u + usec / 1000u;
+}
+
 //===========================================================================================
 // Note: This function returns a pointer to a substring of the original string.
 // If the given string was allocated dynamically, the caller must not overwrite
@@ -454,6 +480,7 @@ void resetHeapWatermark() {
   state.heapdiag.iDripCooldownSkipCount    = 0;
   state.heapdiag.iDripSlowModeCount        = 0;
   state.heapdiag.iMaxLoopGapMs             = 0;
+  loopProfReset(loopProfile, millis());
   // TASK-1017 load-test instrumentation:
   state.heapdiag.iRestInflightHwm          = 0;
   state.heapdiag.iWebfileInflightHwm       = 0;
@@ -556,6 +583,10 @@ static void prepareForReboot() {
   doWebSocketClose();     // close all WebSocket clients (wrapper, see webSocketStuff.ino)
   DebugTf(PSTR("[reboot]   ws close: %lums\r\n"), (unsigned long)(millis() - t));
 
+  t = millis();
+  doEventStreamClose();   // close all /api/v2/events clients (see sseStuff.ino)
+  DebugTf(PSTR("[reboot]   sse close: %lums\r\n"), (unsigned long)(millis() - t));
+
   // Final log line BEFORE debugTelnet.stop() kills our logging sink. Anything
   // after this is best-effort — still emitted but will not reach telnet.
   DebugTf(PSTR("[reboot]   stopping telnet+otgwstream, total=%lums heap=%u\r\n"),
@@ -635,6 +666,10 @@ void doRestart(const char* str) {
   flushSettings();        // persist any pending settings before reboot
   DebugTf(PSTR("[reboot]   flushSettings: %lums\r\n"), (unsigned long)(millis() - t));
 
+  t = millis();
+  historySpillAll();      // keep the graph history across the reboot
+  DebugTf(PSTR("[reboot]   historySpillAll: %lums\r\n"), (unsigned long)(millis() - t));
+
   prepareForReboot();     // graceful shutdown: MQTT LWT, WS close frames, TCP FINs
   // NOTE: prepareForReboot() called debugTelnet.stop() near its end, so every
   // Debug* call from here on is silently dropped to telnet. Serial debug (if
@@ -1028,12 +1063,13 @@ void emergencyHeapRecovery() {
   uint32_t heapBefore = platformFreeHeap();
   uint8_t actions = 0;
 
-  // Action 1: drop all WebSocket clients (~2-4 KB lwIP buffer per client).
+  // Action 1: drop all WebSocket and event stream clients (~2-4 KB lwIP buffer per client).
   // Wrapper lives in webSocketStuff.ino (same pattern as doWebSocketClose).
   if (hasWebSocketClients()) {
     doWebSocketDisconnectAll();
     actions |= 0x01;
   }
+  if (doEventStreamClose()) actions |= 0x01;   // same for the /api/v2/events streams
 
   // Action 2: drop OTGWstream port 25238 clients by stop+restart of the listener.
   // startPICStream() is idempotent (calls WiFiServer::begin() on the same instance)
@@ -0,0 +1,258 @@
+/*
+***************************************************************************
+**  Program  : historyStuff.ino
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  On-device graph history (OTHistory.h). doTaskEvery1s() samples the
+**  decoded OT state once a second into the 1s/1m/15m tiers; GET
+**  /api/v2/history (restAPI.ino) serves a copy of the blocks it needs.
+**
+**  The 1m and 15m tiers are spilled to LittleFS, one file per metric,
+**  so a reboot or OTA keeps the day: hourly (one file per second after
+**  the hour ticks, so no single loop pass writes them all) and from
+**  doRestart(). The 1s tier is RAM only.
+**
+**  The store is written by the loop task only. REST handlers run on the
+**  async TCP task and copy under a sequence counter: odd while a sample
+**  is being written. A reader waits for an even count, and a copy that
+**  saw it change is discarded and retried (see historySnapshot()).
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#include <atomic>
+
+#ifndef OT_HISTORY_SPILL
+#define OT_HISTORY_SPILL     1       // 0: RAM only, history starts empty after a reboot
+#endif
+
+#define OT_HIST_MAX_AGE_S    300     // a value older than this is recorded as missing
+#define OT_HIST_SEQ_WAIT_US  2000    // historySnapshot(): longest wait for a sample to finish
+#define OT_HIST_FILE_MAGIC   0x3148544FUL  // "OTH1"
+#define OT_HIST_FILE_VERSION 1
+
+static OTHistStore *otHist = nullptr;
+static std::atomic<uint32_t> otHistSeq{0};
+static uint16_t otHistSpillPending = 0;    // bit m: metric m still to be written
+
+struct OTHistFileHeader {
+  uint32_t magic;
+  uint8_t  version;
+  uint8_t  metric;
+  uint8_t  blockSize;
+  uint8_t  blocks1m;
+  uint8_t  blocks15m;
+  uint8_t  head1m;
+  uint8_t  head15m;
+  uint8_t  reserved;
+};
+
+// Centi-units, or OT_HIST_MISSING when the message is stale or never seen.
+static int16_t historyValue(uint8_t msgId, float v)
+{
+  if (getMsgAgeSeconds(msgId) > OT_HIST_MAX_AGE_S || isnan(v)) return OT_HIST_MISSING;
+  const long c = lroundf(v * 100.0f);
+  if (c <= INT16_MIN) return INT16_MIN + 1;
+  if (c > INT16_MAX) return INT16_MAX;
+  return (int16_t)c;
+}
+
+static void historyFileName(uint8_t m, char *buf, size_t len)
+{
+  snprintf_P(buf, len, PSTR("/hist_%s.bin"), kOTHistNames[m]);
+}
+
+#if OT_HISTORY_SPILL
+static void historySpillMetric(uint8_t m)
+{
+  char path[32];
+  historyFileName(m, path, sizeof(path));
+  File f = LittleFS.open(path, "w");
+  if (!f) return;
+  OTHistFileHeader h = {};
+  h.magic     = OT_HIST_FILE_MAGIC;
+  h.version   = OT_HIST_FILE_VERSION;
+  h.metric    = m;
+  h.blockSize = sizeof(OTHistBlock);
+  h.blocks1m  = OT_HIST_BLOCKS_1M;
+  h.blocks15m = OT_HIST_BLOCKS_15M;
+  h.head1m    = otHist->head[OTH_TIER_1M][m];
+  h.head15m   = otHist->head[OTH_TIER_15M][m];
+  f.write((const uint8_t*)&h, sizeof(h));
+  f.write((const uint8_t*)otHist->b1m[m],  sizeof(otHist->b1m[m]));
+  f.write((const uint8_t*)otHist->b15m[m], sizeof(otHist->b15m[m]));
+  f.close();
+}
+
+static bool historyRestoreMetric(uint8_t m)
+{
+  char path[32];
+  historyFileName(m, path, sizeof(path));
+  if (!LittleFS.exists(path)) return false;
+  File f = LittleFS.open(path, "r");
+  if (!f) return false;
+  OTHistFileHeader h;
+  const bool ok = f.read((uint8_t*)&h, sizeof(h)) == sizeof(h)
+               && h.magic == OT_HIST_FILE_MAGIC && h.version == OT_HIST_FILE_VERSION
+               && h.metric == m && h.blockSize == sizeof(OTHistBlock)
+               && h.blocks1m == OT_HIST_BLOCKS_1M && h.blocks15m == OT_HIST_BLOCKS_15M
+               && h.head1m < OT_HIST_BLOCKS_1M && h.head15m < OT_HIST_BLOCKS_15M
+               && f.read((uint8_t*)otHist->b1m[m],  sizeof(otHist->b1m[m]))  == sizeof(otHist->b1m[m])
+               && f.read((uint8_t*)otHist->b15m[m], sizeof(otHist->b15m[m])) == sizeof(otHist->b15m[m]);
+  f.close();
+  if (!ok) {
+    // Different build or a torn write: start this metric empty rather than
+    // serve garbage. The decoder is bounded either way.
+    for (uint8_t i = 0; i < OT_HIST_BLOCKS_1M; i++)  otHistBlockClear(otHist->b1m[m][i]);
+    for (uint8_t i = 0; i < OT_HIST_BLOCKS_15M; i++) otHistBlockClear(otHist->b15m[m][i]);
+    return false;
+  }
+  otHist->head[OTH_TIER_1M][m]  = h.head1m;
+  otHist->head[OTH_TIER_15M][m] = h.head15m;
+  return true;
+}
+#endif
+
+// setup(), after LittleFS is mounted. One allocation for the lifetime of the
+// firmware, in PSRAM when the board has it.
+void startHistory()
+{
+  if (otHist) return;
+  otHist = (OTHistStore*)(psramFound() ? ps_malloc(sizeof(OTHistStore)) : malloc(sizeof(OTHistStore)));
+  if (!otHist) {
+    DebugTf(PSTR("History: no memory for %u bytes, graph history disabled\r\n"), (unsigned)sizeof(OTHistStore));
+    return;
+  }
+  otHistReset(*otHist);
+  uint8_t restored = 0;
+#if OT_HISTORY_SPILL
+  if (LittleFSmounted) {
+    for (uint8_t m = 0; m < OTH_COUNT; m++) if (historyRestoreMetric(m)) restored++;
+  }
+#endif
+  DebugTf(PSTR("History: %u bytes (%s), %u/%u metrics restored\r\n"), (unsigned)sizeof(OTHistStore),
+          psramFound() ? "PSRAM" : "heap", restored, (unsigned)OTH_COUNT);
+}
+
+// doTaskEvery1s(): one sample per metric at the current epoch second.
+void historySample()
+{
+  if (!otHist) return;
+#if OT_HISTORY_SPILL
+  if (otHistSpillPending && LittleFSmounted) {
+    const uint8_t m = (uint8_t)__builtin_ctz(otHistSpillPending);
+    historySpillMetric(m);
+    otHistSpillPending &= (uint16_t)~(1u << m);
+  }
+#endif
+  if (!isNTPtimeSet()) return;            // the tiers are wall-clock aligned
+
+  OTdataStruct ot;
+  otStateSnapshot.read(ot);
+  int16_t v[OTH_COUNT];
+  v[OTH_FLOW]          = historyValue(OT_Tboiler, ot.Tboiler);
+  v[OTH_RETURN]        = historyValue(OT_Tret, ot.Tret);
+  v[OTH_ROOM]          = historyValue(OT_Tr, ot.Tr);
+  v[OTH_ROOM_SETPOINT] = historyValue(OT_TrSet, ot.TrSet);
+  v[OTH_CTRL_SETPOINT] = historyValue(OT_TSet, ot.TSet);
+  v[OTH_MODULATION]    = historyValue(OT_RelModLevel, ot.RelModLevel);
+  v[OTH_PRESSURE]      = historyValue(OT_CHPressure, ot.CHPressure);
+  v[OTH_FLAME]         = getMsgAgeSeconds(OT_Statusflags) > OT_HIST_MAX_AGE_S ? OT_HIST_MISSING
+                       : (ot.SlaveStatus & 0x08) ? 100 : 0;
+
+  otHistSeq.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  otHistSample(*otHist, (uint32_t)time(nullptr), v);
+  otHistSeq.fetch_add(1, std::memory_order_release);
+}
+
+// Hourly from doTaskMinuteChanged(): historySample() writes one file a tick.
+void historySpillHourly()
+{
+#if OT_HISTORY_SPILL
+  otHistSpillPending = (uint16_t)((1u << OTH_COUNT) - 1);
+#endif
+}
+
+// doRestart(): everything, now.
+void historySpillAll()
+{
+#if OT_HISTORY_SPILL
+  if (!otHist || !LittleFSmounted) return;
+  for (uint8_t m = 0; m < OTH_COUNT; m++) historySpillMetric(m);
+  otHistSpillPending = 0;
+#endif
+}
+
+// REST (any task). Fills snap with the blocks of snap.tier overlapping
+// [snap.from, snap.to] for snap.mask; with pickTier the finest tier that
+// reaches back to snap.from. False when there is no store, no memory, or
+// no consistent copy after four tries.
+//
+// Unlike OTStateSnapshot this reads the live store with plain loads while
+// the loop task may be writing it: the store is tens of KB, updated in place
+// by the block codec, so neither a second buffer nor word-by-word atomic
+// stores fit. A torn copy is harmless because nothing read before the
+// sequence check is trusted: ring positions are taken modulo the ring
+// length, the copy is bounded by cap, and a copy that overlapped a sample is
+// thrown away undecoded. A sample takes a few microseconds, so an odd
+// sequence is waited out with yield() for up to OT_HIST_SEQ_WAIT_US before
+// copying; only copies count as tries. Nothing here sleeps (this runs on
+// the async TCP task).
+bool historySnapshot(OTHistSnap &snap, bool pickTier)
+{
+  if (!otHist) return false;
+  for (uint8_t tries = 0; tries < 4; tries++) {
+    uint32_t s1 = otHistSeq.load(std::memory_order_acquire);
+    if (s1 & 1) {                         // sample being written: let it finish
+      const uint32_t t0 = micros();
+      do {
+        if ((uint32_t)(micros() - t0) >= OT_HIST_SEQ_WAIT_US) return false;
+        yield();
+        s1 = otHistSeq.load(std::memory_order_acquire);
+      } while (s1 & 1);
+    }
+    if (pickTier) snap.tier = otHistPickTier(*otHist, snap.from);
+    // A sample can start at most one new block per metric while we allocate.
+    const uint16_t cap = otHistCopyBlocks(*otHist, snap.tier, snap.mask, snap.from, snap.to,
+                                          nullptr, UINT16_MAX, snap.perMetric) + OTH_COUNT;
+    free(snap.blocks);
+    const size_t bytes = (size_t)cap * sizeof(OTHistBlock);
+    snap.blocks = (OTHistBlock*)(psramFound() ? ps_malloc(bytes) : malloc(bytes));
+    if (!snap.blocks) return false;
+    snap.count = otHistCopyBlocks(*otHist, snap.tier, snap.mask, snap.from, snap.to,
+                                  snap.blocks, cap, snap.perMetric);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (otHistSeq.load(std::memory_order_relaxed) == s1) return true;
+  }
+  return false;                           // four copies in a row overlapped a sample
+}
+
+// Internal heap a snapshot of one tier can take, for the REST heap guard;
+// 0 when the copy goes to PSRAM.
+uint32_t historyTierBytes(uint8_t tier)
+{
+  if (psramFound()) return 0;
+  return (uint32_t)kOTHistBlocks[tier] * OTH_COUNT * sizeof(OTHistBlock);
+}
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
@@ -19,30 +19,38 @@
 **  HOW: AsyncChunkedResponse pulls the body in TCP-window-sized pieces. Its
 **  filler is called repeatedly with a monotonically increasing `index` (= bytes
 **  produced so far; WebResponses.cpp AsyncChunkedResponse::_fillBuffer passes
-**  _filledLength) and must return bytes [index, index+maxLen). We re-run a
-**  single-pass JsonEmit closure each call into a WINDOWING Print sink that
-**  discards bytes < index and captures [index, index+maxLen). Peak memory is one
-**  ~1460 B window plus the small std::function/snapshot the closure owns; there
-**  is NO whole-response contiguous buffer, so the resize storm cannot occur even
-**  when the heap is fragmented below the response size. Returning 0 (no bytes at
-**  or past index) ends the response.
+**  _filledLength) and must return bytes [index, index+maxLen). Each call runs
+**  the single-pass JsonEmit closure through the response's JsonEmitCursor
+**  (jsonEmit.h, RESUMABLE MODE): ops already delivered are skipped without
+**  being formatted, the op that straddled the previous window edge is re-run
+**  from its saved writer state, and the pass stops when the window is full.
+**  Peak memory is one ~1460 B window plus the small std::function/snapshot/
+**  cursor the response owns; there is NO whole-response contiguous buffer, so
+**  the resize storm cannot occur even when the heap is fragmented below the
+**  response size. Returning 0 ends the response.
 **
-**  COST: O(n^2) in response size (each window re-serializes from byte 0 up to its
-**  end). n is a few KB and windows are ~1460 B, so ~response/1460 passes; the
-**  same re-serialize-per-window trade ADR-145 made (with the now-removed ArduinoJson
-**  path), here on JsonEmit. The deliberate "no whole buffer" vs "re-serialize" choice.
+**  COST: O(n) formatting in response size - every byte is formatted once plus
+**  at most one re-formatted op per window (tests/bench_json_chunked.cpp
+**  measures 1.00-1.02x bytes serialized per byte delivered on settings,
+**  device/info, debug and otmonitor shapes). The closure's control flow still
+**  re-runs per window, but a skipped op is a counter compare. The original
+**  windowing sink re-serialized the whole body on every window (O(n^2):
+**  windows+1 times, 7x for an 8 KB settings body). One op longer than a
+**  window (a multi-KB string value) is re-formatted for each window it spans.
 **
-**  DETERMINISM CONTRACT (critical): the emit closure MUST produce byte-identical
-**  output on every call. If a field's TEXT WIDTH changes between window passes
-**  (e.g. freeheap 95828 -> 100240, uptime ticking a second, a live temperature),
-**  the byte offsets shift and the window misaligns -> corrupt JSON on the wire.
-**    - Request-STABLE state (settings.*, config) may be read live: it does not
-**      change during the few milliseconds a single response streams.
-**    - Any VOLATILE field (heap, uptime, millis-derived, live OT/sensor telemetry,
-**      perf counters) MUST be captured in a SNAPSHOT that the closure owns (a
-**      heap object captured by value/shared_ptr in the lambda), so every re-run
-**      reads the same frozen value. The snapshot is small and fixed-size — far
-**      cheaper and non-fragmenting versus the whole-response cbuf it replaces.
+**  DETERMINISM CONTRACT: the emit closure MUST issue the same SEQUENCE of
+**  JsonEmit calls on every pass (same count, same order, same keys). Values
+**  of ops that were already delivered are not formatted again, so a value
+**  changing text width between windows (freeheap 95828 -> 100240) no longer
+**  misaligns the stream. What still breaks it is STRUCTURE that depends on
+**  volatile state: an `if (live_value) je.field(...)`, a loop over a live
+**  count, or a string value of an op that straddles a window edge changing
+**  length. Hence:
+**    - Request-STABLE state (settings.*, config) may be read live.
+**    - Anything VOLATILE that decides which ops are emitted, or whose strings
+**      are long enough to straddle a window, MUST come from a SNAPSHOT the
+**      closure owns (captured by value/shared_ptr), as the existing device/
+**      info, debug, sat/status and otmonitor snapshots do.
 **
 **  CONCURRENCY: the backpressure gate admits up to REST_MAX_INFLIGHT responses,
 **  whose filler callbacks interleave over time as TCP windows ACK. The window
@@ -69,59 +77,32 @@ extern AsyncWebServerRequest* currentRequest;
 extern bool                   g_responseSent;
 void webApplyHeaders(AsyncWebServerResponse* resp);
 
-// Windowing Print sink: receives the FULL response byte stream from a re-run of
-// the emit closure, but only copies the bytes that fall in [winStart, winStart+cap)
-// into `out`. Bytes before winStart advance the logical position and are dropped;
-// bytes at/after winStart fill `out` until it is full (further bytes are counted
-// but dropped). written() is how many landed in this window (0 => index is at or
-// past the end of the response => the response is complete).
-class RestChunkWindow : public Print {
-public:
-  RestChunkWindow(uint8_t* out, size_t cap, size_t winStart)
-    : _out(out), _cap(cap), _start(winStart), _pos(0), _written(0) {}
-
-  size_t write(uint8_t b) override {
-    if (_pos >= _start && _written < _cap) _out[_written++] = b;
-    _pos++;
-    return 1;
-  }
-  size_t write(const uint8_t* buf, size_t size) override {
-    for (size_t i = 0; i < size; ++i) {
-      if (_pos >= _start && _written < _cap) _out[_written++] = buf[i];
-      ++_pos;
-    }
-    return size;
-  }
-  using Print::write;
-
-  size_t written() const { return _written; }
-
-private:
-  uint8_t* _out;
-  size_t   _cap;
-  size_t   _start;
-  size_t   _pos;       // logical byte position in the full response
-  size_t   _written;   // bytes copied into _out this window
-};
-
 // The emit closure: writes the COMPLETE JSON response via the given JsonEmit on
-// every call. Must be deterministic (see DETERMINISM CONTRACT above).
+// every call. Must issue the same op sequence (see DETERMINISM CONTRACT above).
 using RestEmitFn = std::function<void(JsonEmit&)>;
 
 // Send `emitFn`'s JSON as a true chunked response (no whole-response buffer).
-// Sends exactly once; no-op if the request already sent. The closure is moved
-// into a shared_ptr so it (and any snapshot it captured) lives across all the
-// async filler calls and is freed when the response object is destroyed.
+// Sends exactly once; no-op if the request already sent. The closure and its
+// JsonEmitCursor are held in one shared_ptr so they (and any snapshot the
+// closure captured) live across all the async filler calls and are freed when
+// the response object is destroyed.
+struct RestChunkedState {
+  RestEmitFn     fn;
+  JsonEmitCursor cursor;
+};
+
 inline void restSendChunked(const char* contentType, RestEmitFn emitFn) {
   if (!currentRequest || g_responseSent) return;
-  auto fn = std::make_shared<RestEmitFn>(std::move(emitFn));
+  auto st = std::make_shared<RestChunkedState>();
+  st->fn = std::move(emitFn);
   AsyncWebServerResponse* resp = currentRequest->beginChunkedResponse(
       contentType,
-      [fn](uint8_t* buf, size_t maxLen, size_t index) -> size_t {
-        RestChunkWindow win(buf, maxLen, index);
-        JsonEmit je(win);
-        (*fn)(je);
-        return win.written();   // 0 => nothing at/after index => response complete
+      [st](uint8_t* buf, size_t maxLen, size_t index) -> size_t {
+        // The cursor tracks its own position; AsyncChunkedResponse advances
+        // index by exactly what the previous call returned. If that ever
+        // stops holding, end the body rather than send misaligned bytes.
+        if (index != st->cursor.delivered()) return 0;
+        return st->cursor.fill(buf, maxLen, st->fn);   // 0 => response complete
       });
   if (!resp) return;            // alloc failure: leave unsent (handler may 503)
   webApplyHeaders(resp);
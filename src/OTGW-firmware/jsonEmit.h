@@ -26,12 +26,20 @@
 **      async_tcp past the 30 s watchdog (alpha.211); medium chunks cap it.
 **
 **  WIRING: single-pass into one AsyncResponseStream per response (see
-**  restSendJsonStream in webServerCompat.h). Chunked-re-run is deliberately NOT
-**  used here: a no-document producer re-reads live volatile state (uptime,
-**  freeheap) on each chunk pass, so a field's decimal width can shift between
-**  passes and desynchronize the byte window -> corrupt JSON. Single-pass emits
-**  every volatile field exactly once. (The ArduinoJson chunked path in ADR-145
-**  is safe only because it replays an immutable document snapshot.)
+**  restSendJsonStream in webServerCompat.h), or window-by-window through a
+**  JsonEmitCursor for true chunked responses (restSendChunked, jsonChunked.h).
+**
+**  RESUMABLE MODE (JsonEmitCursor): every public call (beginObject, key,
+**  value, field, ...) is one "op". Per window the cursor lets the closure
+**  re-run, but ops that were already delivered return immediately without
+**  formatting anything; the writer state (depth/comma mask) saved at the op
+**  that straddled the previous window edge is restored, that one op is
+**  re-formatted with its delivered prefix dropped, and the run stops as soon
+**  as the window is full. Serialization is O(n) over the whole response
+**  (about one op re-formatted per window) instead of O(n^2) for re-rendering
+**  from byte 0 every window. Because delivered ops are never formatted again,
+**  a field's text width changing between windows can no longer corrupt the
+**  wire; only the SEQUENCE of ops must be identical on every pass.
 **
 **  TERMS OF USE: GNU GPLv3. See bottom of file.
 ***************************************************************************
@@ -40,9 +48,13 @@
 #ifndef JSONEMIT_H
 #define JSONEMIT_H
 
+#if defined(ARDUINO)
 #include <Arduino.h>
-#include <math.h>     // isnan / isinf
 #include <platform.h> // PLATFORM_INT_DISTINCT_FROM_INT32 must be defined before the int/unsigned field overloads below are parsed
+#endif
+// Host builds (tests/bench_json_chunked.cpp) provide Print, F(), String and
+// snprintf_P stubs before including this header.
+#include <math.h>     // isnan / isinf
 
 // PLATFORM_INT_DISTINCT_FROM_INT32 mirrors the guard the old sendJsonMapEntry
 // layer used (jsonStuff.ino): on this ESP32-S3 toolchain int32_t IS int, so the
@@ -95,26 +107,98 @@ inline void jsonEscapeTo(Print& out, const char* src) {
   if (chunkIdx > 0) { chunk[chunkIdx] = '\0'; out.print(chunk); }
 }
 
+// Structural writer state; saved/restored by JsonEmitCursor at window edges.
+struct JsonEmitState {
+  uint8_t  depth       = 0;
+  uint16_t firstMask   = 0;
+  bool     suppressSep = false;
+  bool     bDepthError = false;
+  uint8_t  dropped     = 0;
+};
+
+class JsonEmit;
+
+// Resumable window sink for chunked responses (see RESUMABLE MODE above).
+// One cursor per response, owned by the response (never shared between
+// concurrent responses). fill() runs the emit closure once and copies the
+// next <= maxLen bytes of its output into buf; 0 means the response is done.
+class JsonEmitCursor : public Print {
+public:
+  template<typename EmitFn> size_t fill(uint8_t* buf, size_t maxLen, EmitFn& emit);
+
+  // Bytes formatted by the writer / bytes handed out by fill(). Their ratio is
+  // the re-serialization overhead (1.0 = every byte formatted exactly once).
+  uint32_t serialized() const { return _serialized; }
+  uint32_t delivered()  const { return _delivered; }
+
+  size_t write(uint8_t b) override {
+    _serialized++;
+    if (_skip) { _skip--; return 1; }
+    if (_len < _cap) _out[_len++] = b; else _overflow = true;
+    return 1;
+  }
+  size_t write(const uint8_t* buf, size_t size) override {
+    for (size_t i = 0; i < size; ++i) write(buf[i]);
+    return size;
+  }
+  using Print::write;
+
+private:
+  friend class JsonEmit;
+  bool _beginOp(JsonEmit& je);
+  void _endOp(JsonEmit& je);
+
+  // per fill() call
+  uint8_t* _out      = nullptr;
+  size_t   _cap      = 0;
+  size_t   _len      = 0;
+  size_t   _skip     = 0;      // bytes of the resumed op already delivered
+  uint32_t _opIndex  = 0;      // ops seen so far in this pass
+  uint32_t _curOp    = 0;
+  size_t   _opStartLen  = 0;
+  size_t   _opStartSkip = 0;
+  JsonEmitState _opStartState;
+  bool     _overflow = false;  // current op produced more than fits
+  bool     _stop     = false;  // window full: remaining ops are no-ops
+  // across fill() calls
+  uint32_t _resumeOp   = 0;
+  size_t   _resumeSkip = 0;
+  JsonEmitState _resumeState;
+  bool     _finished   = false;
+  uint32_t _serialized = 0;
+  uint32_t _delivered  = 0;
+};
+
+// Every public JsonEmit call opens with JSON_EMIT_OP: a no-op outside
+// resumable mode; in resumable mode it lets the cursor skip already-delivered
+// ops and track the op that straddles the window edge. Nested calls (field ->
+// key + value) belong to the outermost op.
+#define JSON_EMIT_OP  _OpGuard _jeOp(*this); if (!_jeOp.active) return
+
 class JsonEmit {
 public:
   static constexpr uint8_t MAX_DEPTH = 8;
 
   explicit JsonEmit(Print& out)
-    : _out(out), _depth(0), _firstMask(0), _suppressSep(false), _bDepthError(false), _dropped(0) {}
+    : _out(out), _cur(nullptr), _opNest(0), _depth(0), _firstMask(0), _suppressSep(false), _bDepthError(false), _dropped(0) {}
+  // Resumable mode: output goes to the cursor's current window.
+  explicit JsonEmit(JsonEmitCursor& cur)
+    : _out(cur), _cur(&cur), _opNest(0), _depth(0), _firstMask(0), _suppressSep(false), _bDepthError(false), _dropped(0) {}
 
   // ---- structure ----
-  void beginObject()                            { _openContainer('{'); }
-  void beginObject(const char* k)               { if (_depth >= MAX_DEPTH) { _bDepthError = true; _dropped++; return; } key(k); _openContainer('{'); }
-  void beginObject(const __FlashStringHelper* k){ if (_depth >= MAX_DEPTH) { _bDepthError = true; _dropped++; return; } key(k); _openContainer('{'); }
-  void endObject()                              { _closeContainer('}'); }
-  void beginArray()                             { _openContainer('['); }
-  void beginArray(const char* k)                { if (_depth >= MAX_DEPTH) { _bDepthError = true; _dropped++; return; } key(k); _openContainer('['); }
-  void beginArray(const __FlashStringHelper* k) { if (_depth >= MAX_DEPTH) { _bDepthError = true; _dropped++; return; } key(k); _openContainer('['); }
-  void endArray()                               { _closeContainer(']'); }
+  void beginObject()                            { JSON_EMIT_OP; _openContainer('{'); }
+  void beginObject(const char* k)               { JSON_EMIT_OP; if (_depth >= MAX_DEPTH) { _bDepthError = true; _dropped++; return; } key(k); _openContainer('{'); }
+  void beginObject(const __FlashStringHelper* k){ JSON_EMIT_OP; if (_depth >= MAX_DEPTH) { _bDepthError = true; _dropped++; return; } key(k); _openContainer('{'); }
+  void endObject()                              { JSON_EMIT_OP; _closeContainer('}'); }
+  void beginArray()                             { JSON_EMIT_OP; _openContainer('['); }
+  void beginArray(const char* k)                { JSON_EMIT_OP; if (_depth >= MAX_DEPTH) { _bDepthError = true; _dropped++; return; } key(k); _openContainer('['); }
+  void beginArray(const __FlashStringHelper* k) { JSON_EMIT_OP; if (_depth >= MAX_DEPTH) { _bDepthError = true; _dropped++; return; } key(k); _openContainer('['); }
+  void endArray()                               { JSON_EMIT_OP; _closeContainer(']'); }
 
   // ---- keys ----
   // Runtime key (escaped): dynamic keys like area_%u_* and Dallas String(addr).
   void key(const char* k) {
+    JSON_EMIT_OP;
     _sep();
     _out.print('"');
     jsonEscapeTo(_out, k);
@@ -124,6 +208,7 @@ public:
   // Compile-time PROGMEM key F("..."): an author-controlled identifier, no escape
   // needed; Print::print(const __FlashStringHelper*) reads PROGMEM correctly.
   void key(const __FlashStringHelper* k) {
+    JSON_EMIT_OP;
     _sep();
     _out.print('"');
     _out.print(k);
@@ -132,9 +217,9 @@ public:
   }
 
   // ---- scalar values ----
-  void value(bool b)     { _sep(); _out.print(b ? F("true") : F("false")); }
-  void value(int32_t v)  { _sep(); char b[12]; snprintf_P(b, sizeof(b), PSTR("%ld"), (long)v);          _out.print(b); }
-  void value(uint32_t v) { _sep(); char b[12]; snprintf_P(b, sizeof(b), PSTR("%lu"), (unsigned long)v); _out.print(b); }
+  void value(bool b)     { JSON_EMIT_OP; _sep(); _out.print(b ? F("true") : F("false")); }
+  void value(int32_t v)  { JSON_EMIT_OP; _sep(); char b[12]; snprintf_P(b, sizeof(b), PSTR("%ld"), (long)v);          _out.print(b); }
+  void value(uint32_t v) { JSON_EMIT_OP; _sep(); char b[12]; snprintf_P(b, sizeof(b), PSTR("%lu"), (unsigned long)v); _out.print(b); }
   // Emits the float as a JSON number with up to `decimals` fractional digits, then
   // trims trailing zeros (and a lone trailing '.') so the wire form matches
   // ArduinoJson's natural representation: 0.000500 -> 0.0005, 21.500000 -> 21.5,
@@ -143,6 +228,7 @@ public:
   // rounded to 0.001 (TASK-886 review: the OTD kp/ki/... contract). Pass a smaller
   // `decimals` to cap precision deliberately. NaN/Inf -> null (no JSON form).
   void value(float f, uint8_t decimals = 6) {
+    JSON_EMIT_OP;
     _sep();
     if (isnan(f) || isinf(f)) { _out.print(F("null")); return; }
     char fmt[8]; snprintf_P(fmt, sizeof(fmt), PSTR("%%.%uf"), (unsigned)decimals);
@@ -157,60 +243,90 @@ public:
     _out.print(b);
   }
   void value(const char* s) {
+    JSON_EMIT_OP;
     _sep();
     if (!s) { _out.print(F("null")); return; }
     _out.print('"'); jsonEscapeTo(_out, s); _out.print('"');
   }
-  void value(const String& s) { value(s.c_str()); }
+  void value(const String& s) { JSON_EMIT_OP; value(s.c_str()); }
   // Compile-time PROGMEM value F("..."): escaped for safety. The
   // reinterpret_cast is valid here because the 2.0.0 line is ESP32-S3-only
   // (ADR-128) and the S3 maps flash into the data address space, so a
   // __FlashStringHelper* is directly readable as a const char*.
   void value(const __FlashStringHelper* s) {
+    JSON_EMIT_OP;
     _sep();
     if (!s) { _out.print(F("null")); return; }
     _out.print('"'); jsonEscapeTo(_out, reinterpret_cast<const char*>(s)); _out.print('"');
   }
 
   // narrow-int forwarders (exact-match to dodge promotion ambiguity)
-  void value(int8_t v)   { value((int32_t)v); }
-  void value(int16_t v)  { value((int32_t)v); }
-  void value(uint16_t v) { value((uint32_t)v); }
+  void value(int8_t v)   { JSON_EMIT_OP; value((int32_t)v); }
+  void value(int16_t v)  { JSON_EMIT_OP; value((int32_t)v); }
+  void value(uint16_t v) { JSON_EMIT_OP; value((uint32_t)v); }
 #if PLATFORM_INT_DISTINCT_FROM_INT32
-  void value(int v)          { value((int32_t)v); }
-  void value(unsigned int v) { value((uint32_t)v); }
+  void value(int v)          { JSON_EMIT_OP; value((int32_t)v); }
+  void value(unsigned int v) { JSON_EMIT_OP; value((uint32_t)v); }
 #endif
 
   // raw pre-formatted JSON token (e.g. settings' addNum emits an unquoted number)
-  void raw(const char* json) { _sep(); _out.print(json); }
-  void rawP(PGM_P json)      { _sep(); _out.print(FPSTR(json)); }
+  void raw(const char* json) { JSON_EMIT_OP; _sep(); _out.print(json); }
+  void rawP(PGM_P json)      { JSON_EMIT_OP; _sep(); _out.print(FPSTR(json)); }
 
   // ---- key+value conveniences ----
   // Templated on the key type K (const char* OR const __FlashStringHelper*, both
   // have a key() overload); the value type resolves through the value() overloads
   // above (including the narrow-int and PROGMEM-string ones). One float overload
   // carries the optional decimals argument.
-  template<typename K> void field(K k, bool b)                          { key(k); value(b); }
-  template<typename K> void field(K k, int32_t v)                       { key(k); value(v); }
-  template<typename K> void field(K k, uint32_t v)                      { key(k); value(v); }
-  template<typename K> void field(K k, int8_t v)                        { key(k); value((int32_t)v); }
-  template<typename K> void field(K k, int16_t v)                       { key(k); value((int32_t)v); }
-  template<typename K> void field(K k, uint16_t v)                      { key(k); value((uint32_t)v); }
-  template<typename K> void field(K k, const char* s)                  { key(k); value(s); }
-  template<typename K> void field(K k, const String& s)               { key(k); value(s.c_str()); }
-  template<typename K> void field(K k, const __FlashStringHelper* s)   { key(k); value(s); }
-  template<typename K> void field(K k, float f, uint8_t dec = 6)        { key(k); value(f, dec); }
+  template<typename K> void field(K k, bool b)                          { JSON_EMIT_OP; key(k); value(b); }
+  template<typename K> void field(K k, int32_t v)                       { JSON_EMIT_OP; key(k); value(v); }
+  template<typename K> void field(K k, uint32_t v)                      { JSON_EMIT_OP; key(k); value(v); }
+  template<typename K> void field(K k, int8_t v)                        { JSON_EMIT_OP; key(k); value((int32_t)v); }
+  template<typename K> void field(K k, int16_t v)                       { JSON_EMIT_OP; key(k); value((int32_t)v); }
+  template<typename K> void field(K k, uint16_t v)                      { JSON_EMIT_OP; key(k); value((uint32_t)v); }
+  template<typename K> void field(K k, const char* s)                  { JSON_EMIT_OP; key(k); value(s); }
+  template<typename K> void field(K k, const String& s)               { JSON_EMIT_OP; key(k); value(s.c_str()); }
+  template<typename K> void field(K k, const __FlashStringHelper* s)   { JSON_EMIT_OP; key(k); value(s); }
+  template<typename K> void field(K k, float f, uint8_t dec = 6)        { JSON_EMIT_OP; key(k); value(f, dec); }
 #if PLATFORM_INT_DISTINCT_FROM_INT32
-  template<typename K> void field(K k, int v)                          { key(k); value((int32_t)v); }
-  template<typename K> void field(K k, unsigned int v)                 { key(k); value((uint32_t)v); }
+  template<typename K> void field(K k, int v)                          { JSON_EMIT_OP; key(k); value((int32_t)v); }
+  template<typename K> void field(K k, unsigned int v)                 { JSON_EMIT_OP; key(k); value((uint32_t)v); }
 #endif
-  template<typename K> void fieldRaw(K k, const char* json)            { key(k); raw(json); }
-  template<typename K> void fieldRawP(K k, PGM_P json)                 { key(k); rawP(json); }
+  template<typename K> void fieldRaw(K k, const char* json)            { JSON_EMIT_OP; key(k); raw(json); }
+  template<typename K> void fieldRawP(K k, PGM_P json)                 { JSON_EMIT_OP; key(k); rawP(json); }
 
   // true if no container was dropped from depth overflow (response is well-formed)
   bool ok() const { return !_bDepthError; }
 
 private:
+  friend class JsonEmitCursor;
+
+  struct _OpGuard {
+    JsonEmit& je;
+    bool      active;
+    explicit _OpGuard(JsonEmit& e) : je(e), active(e._enterOp()) {}
+    ~_OpGuard() { if (active) je._leaveOp(); }
+  };
+  bool _enterOp() {
+    if (_opNest++) return true;                      // nested inside an active op
+    if (!_cur || _cur->_beginOp(*this)) return true;
+    _opNest = 0;                                     // skipped op
+    return false;
+  }
+  void _leaveOp() {
+    if (--_opNest == 0 && _cur) _cur->_endOp(*this);
+  }
+  JsonEmitState _saveState() const {
+    JsonEmitState st;
+    st.depth = _depth; st.firstMask = _firstMask; st.suppressSep = _suppressSep;
+    st.bDepthError = _bDepthError; st.dropped = _dropped;
+    return st;
+  }
+  void _restoreState(const JsonEmitState& st) {
+    _depth = st.depth; _firstMask = st.firstMask; _suppressSep = st.suppressSep;
+    _bDepthError = st.bDepthError; _dropped = st.dropped;
+  }
+
   void _sep() {
     if (_suppressSep) { _suppressSep = false; return; }
     if (_depth > 0) {
@@ -238,6 +354,8 @@ private:
   }
 
   Print&   _out;
+  JsonEmitCursor* _cur;  // non-null in resumable mode
+  uint8_t  _opNest;      // public-call nesting depth (op = outermost call)
   uint8_t  _depth;
   uint16_t _firstMask;
   bool     _suppressSep;
@@ -245,6 +363,53 @@ private:
   uint8_t  _dropped;     // opens dropped at MAX_DEPTH, awaiting their matching close
 };
 
+#undef JSON_EMIT_OP
+
+// ---- JsonEmitCursor: op bookkeeping (needs the complete JsonEmit) ----
+inline bool JsonEmitCursor::_beginOp(JsonEmit& je) {
+  const uint32_t idx = _opIndex++;
+  if (_stop || idx < _resumeOp) return false;      // delivered earlier / window full
+  if (idx == _resumeOp) {                          // first op of this window
+    je._restoreState(_resumeState);
+    _skip = _resumeSkip;
+  }
+  _curOp        = idx;
+  _opStartState = je._saveState();
+  _opStartLen   = _len;
+  _opStartSkip  = _skip;
+  return true;
+}
+
+inline void JsonEmitCursor::_endOp(JsonEmit& je) {
+  if (_overflow) {
+    // Op did not fit: next window re-runs it from its start state and drops
+    // what was delivered so far (previous windows + this one).
+    _resumeOp    = _curOp;
+    _resumeState = _opStartState;
+    _resumeSkip  = _opStartSkip + (_len - _opStartLen);
+    _stop        = true;
+  } else if (_len == _cap) {
+    _resumeOp    = _curOp + 1;
+    _resumeState = je._saveState();
+    _resumeSkip  = 0;
+    _stop        = true;
+  }
+}
+
+template<typename EmitFn>
+inline size_t JsonEmitCursor::fill(uint8_t* buf, size_t maxLen, EmitFn& emit) {
+  if (_finished || maxLen == 0) return 0;
+  _out = buf; _cap = maxLen; _len = 0; _skip = 0;
+  _opIndex = 0; _overflow = false; _stop = false;
+  {
+    JsonEmit je(*this);
+    emit(je);
+  }
+  if (!_stop) _finished = true;                    // closure ran to its end
+  _delivered += (uint32_t)_len;
+  return _len;
+}
+
 #endif // JSONEMIT_H
 
 /***************************************************************************
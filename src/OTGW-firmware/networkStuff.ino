@@ -750,6 +750,7 @@ void loopNTP()
         if (myTz.isError()) {
           DebugTf(PSTR("[NTP] Error: Timezone Invalid/Not Found: [%s]\r\n"), CSTR(settings.ntp.sTimezone));
           strlcpy(settings.ntp.sTimezone, NTP_DEFAULT_TIMEZONE, sizeof(settings.ntp.sTimezone));
+          invalidateOTLogTimestampZone();
           myTz = timezoneManager.createForZoneName(CSTR(settings.ntp.sTimezone));
         } else {
           ZonedDateTime myTime = ZonedDateTime::forUnixSeconds64(now, myTz);
@@ -283,6 +283,7 @@ static void handleSAT(const char words[][API_WORD_LEN], uint8_t wc, HTTPMethod m
 static void handleDiscovery(const char words[][API_WORD_LEN], uint8_t wc, HTTPMethod method, const char* originalURI);
 static void handleMqtt(const char words[][API_WORD_LEN], uint8_t wc, HTTPMethod method, const char* originalURI);
 static void handleDebugDump(const char words[][API_WORD_LEN], uint8_t wc, HTTPMethod method, const char* originalURI);
+static void handleHistory(const char words[][API_WORD_LEN], uint8_t wc, HTTPMethod method, const char* originalURI);
 // TASK-585: WiFi network scan
 static void handleNetwork(const char words[][API_WORD_LEN], uint8_t wc, HTTPMethod method, const char* originalURI);
 
@@ -296,7 +297,7 @@ void sendApiNotFound(const char *URI);
 static void sendApiOptions() {
   sendCorsOriginHeader();
   webPushHeader(F("Access-Control-Allow-Methods"), F("GET, POST, PUT, OPTIONS"));
-  webPushHeader(F("Access-Control-Allow-Headers"), F("Content-Type"));
+  webPushHeader(F("Access-Control-Allow-Headers"), F("Content-Type, If-None-Match"));
   webPushHeader(F("Access-Control-Max-Age"), F("86400"));
   webSendStatus(204);
 }
@@ -311,7 +312,7 @@ static void handleCommandSubmit(const char* cmdStr) {
     sendApiError(400, F("Missing command"));
     return;
   }
-  constexpr size_t kMaxCmdLen = sizeof(cmdqueue[0].cmd) - 1;
+  constexpr size_t kMaxCmdLen = sizeof(OT_cmd_t::cmd) - 1;
   const size_t cmdLen = strlen(cmdStr);
   // OTGW commands are two letters followed by '=' and a value.
   // Reject non-alphabetic prefixes to prevent malformed bytes reaching the command queue (review I2).
@@ -373,8 +374,8 @@ static void handleSettings(const char words[][API_WORD_LEN], uint8_t wc, HTTPMet
 
 static void sendSensorStatus() {
   // ADR-141 / TASK-885: streaming JsonEmit replaces the JsonDocument path. The
-  // getDallasAddress() shared static buffer is emitted immediately as the key, so
-  // no per-device String() copy is needed (mirrors sendDeviceInfoV2/sendOTmonitorV2).
+  // cached DallasrealDevice[].addrStr is emitted as the key, so no per-device
+  // String() copy is needed (mirrors sendDeviceInfoV2/sendOTmonitorV2).
   AsyncResponseStream* strm = restBeginStream("application/json");
   if (strm) {
     JsonEmit je(*strm);
@@ -388,16 +389,23 @@ static void sendSensorStatus() {
     je.field(F("dallas_gpio"),     (int32_t)settings.sensors.iPin);
     je.field(F("dallas_poll_sec"), (int32_t)settings.sensors.iInterval);
     je.field(F("simulated"),       state.debug.bSensorSim);
+    je.field(F("dallas_sweep_ms"), DallasSweepMs);        // last convert + read sweep (sensor task)
+    je.field(F("dallas_sweep_overruns"), DallasSweepOverruns);
 
     // Individual sensor readings
     if (bSensorsDetected || state.debug.bSensorSim) {
       je.beginObject(F("devices"));   // "devices":{
       for (int i = 0; i < DallasrealDeviceCount; i++) {
-        const char *addr = getDallasAddress(DallasrealDevice[i].addr);
-        if (!addr) continue;
+        const char *addr = DallasrealDevice[i].addrStr;
+        const DallasReadStats &st = DallasrealDevice[i].stats;
         je.beginObject(addr);         // dynamic per-address key
         je.field(F("temp"),  DallasrealDevice[i].tempC);
         je.field(F("epoch"), (uint32_t)DallasrealDevice[i].lasttime);
+        je.field(F("reads"),       st.reads);
+        je.field(F("crc_errors"),  st.crcErrors);
+        je.field(F("missing"),     st.missing);
+        je.field(F("read_us"),     st.lastUs);
+        je.field(F("read_us_max"), st.maxUs);
         je.endObject();
       }
       je.endObject();                 // close "devices"
@@ -563,6 +571,12 @@ static void handleOTDirect(const char words[][API_WORD_LEN], uint8_t wc, HTTPMet
       sendApiMethodNotAllowed(F("GET, POST"));
     }
   }
+  // GET /api/v2/otdirect/schedule — requested vs achieved poll rate per MsgID
+  else if (wc > 4 && strcmp_P(words[4], PSTR("schedule")) == 0) {
+    if (method != HTTP_GET) { sendApiMethodNotAllowed(F("GET")); return; }
+    sendCorsOriginHeader();
+    sendOTDirectScheduleJSON();
+  }
   // GET /api/v2/otdirect/overrides — list all active overrides
   // POST /api/v2/otdirect/overrides?action=sr&msgid=X&value=HHHH — set stored response
   // POST /api/v2/otdirect/overrides?action=cr&msgid=X — clear stored response
@@ -802,6 +816,40 @@ static void handleOtgw(const char words[][API_WORD_LEN], uint8_t wc, HTTPMethod
       }
       restFinalize();
     }
+  } else if (strcmp_P(words[4], PSTR("otmap")) == 0) {
+    // GET /api/v2/otgw/otmap -> the OTmap table the binary /ws stream (OTWsBinary.h)
+    // is decoded with in the browser: id, label, value type, unit, direction.
+    // Static for a given firmware build; the UI fetches it once per page load.
+    if (!isGet) { sendApiMethodNotAllowed(F("GET")); return; }
+    sendCorsOriginHeader();
+    {
+      // Indexed by OTtype_t / OTmsgcmd_t (OTmap.h).
+      static const char* const kTypeNames[] = {
+        "f88", "s16", "s8s8", "u16", "u8u8", "flag8", "flag8flag8", "special", "flag8u8", "u8", "undef" };
+      static const char* const kCmdNames[] = { "R", "W", "RW", "" };
+      AsyncResponseStream* strm = restBeginStream("application/json");
+      if (strm) {
+        JsonEmit je(*strm);
+        je.beginObject();                 // root {
+        je.field(F("version"), (int32_t)OT_WS_BIN_VERSION);
+        je.beginArray(F("msgids"));       // "msgids":[
+        for (int i = 0; i <= OT_MSGID_MAX; i++) {
+          OTlookup_t item;
+          PROGMEM_readAnything(&OTmap[i], item);
+          if (item.type == ot_undef) continue;
+          je.beginObject();
+          je.field(F("id"),    i);
+          je.field(F("label"), item.label);
+          je.field(F("type"),  kTypeNames[item.type]);
+          je.field(F("unit"),  item.unit);
+          je.field(F("cmd"),   kCmdNames[item.msgcmd]);
+          je.endObject();
+        }
+        je.endArray();                    // close "msgids"
+        je.endObject();                   // close root
+      }
+      restFinalize();
+    }
   } else if (strcmp_P(words[4], PSTR("overrides")) == 0) {
     // ADR-118: GET /api/v2/otgw/overrides -> active gateway-override values that the
     // boiler-side-worldview gate (ADR-096/103) drops from canonical. Additive surface;
@@ -2000,6 +2048,110 @@ static void handleMqtt(const char words[][API_WORD_LEN], uint8_t wc, HTTPMethod
   sendApiNotFound(originalURI);
 }
 
+//=======================================================================
+// GET /api/v2/history[?tier=1s|1m|15m|auto][&from=epoch][&to=epoch][&metrics=flow,room,...]
+//
+// The dashboard's graph backfill from the OTHistory.h store: by default the
+// last 24 h of every metric, from the finest tier that reaches back that far.
+//   {"tier":"1m","step":60,"scale":100,"from":..,"to":..,
+//    "series":{"flow":{"unit":"°C","segments":[{"t":1760000000,"v":[4512,4520,null,..]}]},..}}
+// v[i] is at t + i*step, in 1/scale units; null = no fresh value that step.
+// A new segment starts at every gap. The blocks are copied once into the
+// response's snapshot (jsonChunked.h DETERMINISM CONTRACT), at most 2.5 KB
+// per metric; the closure decodes them on every window pass.
+//=======================================================================
+#define HISTORY_DEFAULT_SPAN_S  86400UL
+
+static void handleHistory(const char words[][API_WORD_LEN], uint8_t wc, HTTPMethod method, const char* originalURI)
+{
+  if (wc > 4) { sendApiNotFound(originalURI); return; }
+  if (method != HTTP_GET) { sendApiMethodNotAllowed(F("GET")); return; }
+
+  const uint32_t minHeap = historyTierBytes(OTH_TIER_1M) + 4096;   // 1m is the largest tier
+  if (platformMaxFreeBlock() < minHeap) {
+    sendApiError(503, F("low heap"));
+    return;
+  }
+
+  auto snap = std::make_shared<OTHistSnap>();
+  bool pickTier = true;
+  if (hasArgCompat("tier")) {
+    const char* t = argCompat("tier");
+    if (strcmp_P(t, PSTR("auto")) != 0) {
+      uint8_t tier = 0;
+      while (tier < OTH_TIER_COUNT && strcmp(t, kOTHistTierNames[tier]) != 0) tier++;
+      if (tier >= OTH_TIER_COUNT) { sendApiError(400, F("tier must be 1s, 1m, 15m or auto")); return; }
+      snap->tier = tier;
+      pickTier = false;
+    }
+  }
+  snap->to = hasArgCompat("to") ? (uint32_t)strtoul(argCompat("to"), nullptr, 10) : (uint32_t)time(nullptr);
+  snap->from = hasArgCompat("from") ? (uint32_t)strtoul(argCompat("from"), nullptr, 10)
+             : (snap->to > HISTORY_DEFAULT_SPAN_S ? snap->to - HISTORY_DEFAULT_SPAN_S : 0);
+  if (snap->from > snap->to) { sendApiError(400, F("from is after to")); return; }
+
+  snap->mask = (uint16_t)((1u << OTH_COUNT) - 1);
+  if (hasArgCompat("metrics")) {
+    char list[96];
+    strlcpy(list, argCompat("metrics"), sizeof(list));
+    snap->mask = 0;
+    char* save = nullptr;
+    for (char* name = strtok_r(list, ",", &save); name; name = strtok_r(nullptr, ",", &save)) {
+      uint8_t m = 0;
+      while (m < OTH_COUNT && strcmp(name, kOTHistNames[m]) != 0) m++;
+      if (m >= OTH_COUNT) { sendApiError(400, F("unknown metric")); return; }
+      snap->mask |= (uint16_t)(1u << m);
+    }
+  }
+
+  if (!historySnapshot(*snap, pickTier)) {
+    webPushHeader(F("Retry-After"), "1");    // a sample was being written, or no memory
+    sendApiError(503, F("history unavailable"));
+    return;
+  }
+
+  restSendChunked("application/json", [snap](JsonEmit& je) {
+    const uint16_t step = kOTHistStep[snap->tier];
+    je.beginObject();
+    je.field(F("tier"), kOTHistTierNames[snap->tier]);
+    je.field(F("step"), (uint32_t)step);
+    je.field(F("scale"), (int32_t)100);
+    je.field(F("from"), snap->from);
+    je.field(F("to"), snap->to);
+    je.beginObject(F("series"));
+    uint16_t first = 0;
+    for (uint8_t m = 0; m < OTH_COUNT; m++) {
+      if (!(snap->mask & (1u << m))) continue;
+      je.beginObject(kOTHistNames[m]);
+      je.field(F("unit"), kOTHistUnits[m]);
+      je.beginArray(F("segments"));
+      bool open = false;
+      uint32_t next = 0;
+      for (uint16_t i = first; i < first + snap->perMetric[m]; i++) {
+        otHistBlockDecode(snap->blocks[i], step, [&](uint32_t t, int16_t v) {
+          if (t < snap->from || t > snap->to) return;
+          if (!open || t != next) {
+            if (open) { je.endArray(); je.endObject(); }
+            je.beginObject();
+            je.field(F("t"), t);
+            je.beginArray(F("v"));
+            open = true;
+          }
+          if (v == OT_HIST_MISSING) je.value((const char*)nullptr);
+          else                      je.value((int32_t)v);
+          next = t + step;
+        });
+      }
+      if (open) { je.endArray(); je.endObject(); }
+      first += snap->perMetric[m];
+      je.endArray();
+      je.endObject();
+    }
+    je.endObject();
+    je.endObject();
+  });
+}
+
 static void debugFormatLocalIp(char* buf, size_t bufSize)
 {
   IPAddress ip = WiFi.localIP();
@@ -2027,6 +2179,8 @@ struct DebugDumpSnap {
   char      netMode[16];
   char      boilerStatus[20];
   char      manufacturer[12];
+  LoopProfile loopProf;               // LoopProfile.h section timings
+  uint32_t  loopProfWindowMs;
 };
 
 static void handleDebugDump(const char words[][API_WORD_LEN], uint8_t wc, HTTPMethod method, const char* originalURI)
@@ -2059,6 +2213,8 @@ static void handleDebugDump(const char words[][API_WORD_LEN], uint8_t wc, HTTPMe
   snprintf_P(snap->netMode, sizeof(snap->netMode), PSTR("%S"), (PGM_P)networkModeName());
   satGetBoilerStatusName(snap->boilerStatus, sizeof(snap->boilerStatus));
   satGetManufacturerName(snap->manufacturer, sizeof(snap->manufacturer));
+  snap->loopProf         = loopProfile;  // loop task writes it; a torn section is at most one sample off
+  snap->loopProfWindowMs = millis() - loopProfile.sinceMs;
 
   // DETERMINISM GATE (TASK-883): closure reads ONLY snap->*, settings.*, and build
   // constants. The JSON KEYS are F("state.*"/"runtime.*") literals (not reads). No
@@ -2108,6 +2264,7 @@ static void handleDebugDump(const char words[][API_WORD_LEN], uint8_t wc, HTTPMe
     je.field(F("settings.mqtt.sep_sources"), settings.mqtt.bSeparateSources);
     je.field(F("settings.mqtt.disc_verify"), settings.mqtt.bDiscoveryAutoVerify);
     je.field(F("settings.mqtt.use_legacy_topics"), settings.mqtt.bUseLegacyOtTopics);
+    je.field(F("settings.mqtt.device_discovery"), settings.mqtt.bDeviceDiscovery);
     je.field(F("settings.mqtt.ha_reboot"), settings.mqtt.bHaRebootDetect);
     je.field(F("settings.legacy.port25238"), settings.mqtt.bLegacyPort25238Enabled);
 
@@ -2193,6 +2350,21 @@ static void handleDebugDump(const char words[][API_WORD_LEN], uint8_t wc, HTTPMe
 #endif
 
     je.field(F("state.mqtt.connected"), snap->st.mqtt.bConnected);
+    je.field(F("state.mqtt.topic_table_bytes"), snap->st.mqtt.iTopicTableBytes);
+    je.field(F("state.mqtt.topic_formatted_bytes"), snap->st.mqtt.iTopicFormattedBytes);
+    je.field(F("state.mqtt.topic_interned_bytes"), snap->st.mqtt.iTopicInternedBytes);
+    je.field(F("state.mqtt.topic_formatted_bps"), snap->st.mqtt.iTopicFormattedBps);
+    je.field(F("state.mqtt.topic_interned_bps"), snap->st.mqtt.iTopicInternedBps);
+    je.field(F("state.mqtt.topic_intern_misses"), snap->st.mqtt.iTopicInternMisses);
+    je.field(F("state.mqtt.batch_count"), snap->st.mqtt.iBatchCount);
+    je.field(F("state.mqtt.batch_messages"), snap->st.mqtt.iBatchMessages);
+    je.field(F("state.mqtt.batch_max_messages"), snap->st.mqtt.iBatchMaxMessages);
+    je.field(F("state.mqtt.batch_gate_checks_saved"), snap->st.mqtt.iBatchGateChecksSaved);
+    je.field(F("state.mqtt.dedup_hits"), snap->st.mqtt.iDedupHits);
+    je.field(F("state.mqtt.dedup_misses"), snap->st.mqtt.iDedupMisses);
+    je.field(F("state.mqtt.dedup_refreshes"), snap->st.mqtt.iDedupRefreshes);
+    je.field(F("state.mqtt.dedup_evictions"), snap->st.mqtt.iDedupEvictions);
+    je.field(F("state.mqtt.dedup_topics"), snap->st.mqtt.iDedupTopics);
     je.field(F("state.pic.available"), snap->st.pic.bAvailable);
     je.field(F("state.pic.device_id"), snap->st.pic.sDeviceid);
     je.field(F("state.pic.type"), snap->st.pic.sType);
@@ -2309,6 +2481,30 @@ static void handleDebugDump(const char words[][API_WORD_LEN], uint8_t wc, HTTPMe
 #endif
 
     je.endObject();                   // close "debug"
+
+    // Loop-task section timings (LoopProfile.h). hist[b] counts calls of
+    // [2^b, 2^(b+1)) us; p50/p99 are the upper edge of their bucket.
+    je.beginObject(F("loop_profile"));  // "loop_profile":{
+    je.field(F("window_ms"), snap->loopProfWindowMs);
+    je.field(F("buckets"), (uint32_t)LOOP_PROF_BUCKETS);
+    je.beginArray(F("sections"));     // "sections":[
+    for (uint8_t i = 0; i < LPS_COUNT; i++) {
+      const LoopProfStat& st = snap->loopProf.s[i];
+      je.beginObject();
+      je.field(F("name"), loopProfSectionName(i));
+      je.field(F("calls"), st.calls);
+      je.field(F("total_ms"), (uint32_t)(st.totalUs / 1000));
+      je.field(F("avg_us"), loopProfAvgUs(st));
+      je.field(F("p50_us"), loopProfPercentileUs(st, 50));
+      je.field(F("p99_us"), loopProfPercentileUs(st, 99));
+      je.field(F("max_us"), st.maxUs);
+      je.beginArray(F("hist"));
+      for (uint8_t b = 0; b < LOOP_PROF_BUCKETS; b++) je.value(st.hist[b]);
+      je.endArray();
+      je.endObject();
+    }
+    je.endArray();                    // close "sections"
+    je.endObject();                   // close "loop_profile"
     je.endObject();                   // close root
   });
 }
@@ -2423,6 +2619,7 @@ static const char kRouteDiscovery[]  PROGMEM = "discovery";
 static const char kRouteDebugDump[]  PROGMEM = "debug";
 static const char kRouteNetwork[]    PROGMEM = "network";  // TASK-585
 static const char kRouteMqtt[]       PROGMEM = "mqtt";     // TASK-936: OT-value republish
+static const char kRouteHistory[]    PROGMEM = "history";  // graph history (historyStuff.ino)
 
 // Dispatch table placed in PROGMEM so the ~136 B of {segment, handler}
 // rows live in flash, not DRAM. Same pattern as kSatMqttCmds in
@@ -2449,6 +2646,7 @@ static const ApiRoute kV2Routes[] PROGMEM = {
   { kRouteDebugDump,  handleDebugDump },
   { kRouteNetwork,    handleNetwork },  // TASK-585: WiFi scan
   { kRouteMqtt,       handleMqtt },     // TASK-936: POST /api/v2/mqtt/republish
+  { kRouteHistory,    handleHistory },  // GET /api/v2/history
   { nullptr,          nullptr }  // sentinel
 };
 
@@ -2782,115 +2980,271 @@ void sendOTLabel(const char *msglabel){
 // sendOTmonitorV2(); the base char* overloads in jsonStuff.ino are untouched.
 //=======================================================================
 
-void sendOTmonitorV2()
-{
-  time_t now = time(nullptr); // needed for Dallas sensor display
+// Per-response snapshot for the chunked /v2/otgw/otmonitor emit. Which
+// entries appear depends on live state (getMsgLastUpdated() going non-zero,
+// the Dallas device count), so the entry list itself is built ONCE from one
+// otStateSnapshot copy and the closure only walks it (jsonChunked.h DETERMINISM
+// CONTRACT). Name/unit are F() literals and string values are the static
+// CONOFF() literals, so an entry is a few words; ~1 KB per response instead of
+// the ~3-4 KB whole-response cbuf the single-pass stream needed.
+// otmonCollect() emits at most 38 entries (33 OT + 5 aux); slot() refuses
+// anything past the cap. tests/test_otmon_snap_capacity.py counts the emit
+// calls against OTMON_SNAP_MAX_ENTRIES, so a new field cannot silently fall
+// off REST, the ?since= deltas and the SSE "ot" event.
+#define OTMON_SNAP_MAX_ENTRIES 40
+
+struct OTmonEntry {
+  const __FlashStringHelper* name;
+  const __FlashStringHelper* unit;
+  uint32_t epoch;
+  uint32_t gen;                       // OT entries: generation of the last value change (OTmonDelta.h)
+  uint8_t  kind;                      // OTMON_KIND_*
+  bool     aux;                       // not an OT message: S0, sensor simulation, sensor count
+  union { float f; int32_t i; uint32_t u; bool b; const char* s; } v;
+};
+enum : uint8_t { OTMON_KIND_STR, OTMON_KIND_FLOAT, OTMON_KIND_INT, OTMON_KIND_UINT, OTMON_KIND_BOOL };
 
-  // TASK-865.5 (ADR-123 Phase-1): this is the cross-task READER of the decoded
-  // OTGWState snapshot (OTcurrentSystemState.*). Acquire the OTStateLock so the
-  // writer (processOT, via drainOTFrameQueue) cannot tear a multi-byte field
-  // mid-read once the producer is lifted into a FreeRTOS task (seq6). processOT
-  // is never called from here, so the non-recursive mutex cannot self-deadlock.
-  //
-  // TASK-879: BOUNDED acquire (never the default 0 == portMAX_DELAY). This handler
-  // runs on the async_tcp task; the writer (processOT) holds otStateMutex across
-  // per-frame I/O, so an unbounded wait here lets a single slow producer frame
-  // wedge the async_tcp service task (which is WDT-subscribed) and stall every
-  // HTTP request. On timeout we proceed WITHOUT the lock: a torn multi-byte read
-  // is cosmetic for a status snapshot, and serving slightly-stale JSON is far
-  // better than hanging port 80. A request thread must never block forever on a
-  // lock the loop task can hold across writes.
-  OTStateLock stateLock(OT_STATE_READ_LOCK_MS);
+struct OTmonDallasEntry {
+  char     addr[17];
+  float    tempC;
+  uint32_t lasttime;
+};
 
-  // ADR-141 / TASK-885: streaming JsonEmit replaces the JsonDocument path. Each
-  // entry is the OTmon compact object shape "name": {"value": V, "unit": "U",
-  // "epoch": E}. The generic lambda mirrors the old sendJsonOTmonMapEntry
-  // overloads: V is serialised by its native type (CONOFF()/CBOOLEAN strings
-  // stay strings, numerics stay numbers).
-  AsyncResponseStream* strm = restBeginStream("application/json");
-  if (strm) {
-    JsonEmit je(*strm);
-    je.beginObject();                 // root {
-    je.beginObject(F("otmonitor"));   // "otmonitor":{
-    auto emit = [&](const __FlashStringHelper* name, auto value,
-                    const __FlashStringHelper* unit, uint32_t epoch) {
-      je.beginObject(name);
-      je.field(F("value"), value);
-      je.field(F("unit"),  unit);
-      je.field(F("epoch"), epoch);
-      je.endObject();
-    };
+struct OTmonSnap {
+  OTmonEntry       e[OTMON_SNAP_MAX_ENTRIES];
+  uint8_t          count = 0;
+  OTmonDallasEntry dallas[MAXDALLASDEVICES];
+  uint8_t          dallasCount = 0;
+  // Change generations (OTmonDelta.h). gen/genReset come from the same
+  // otStateSnapshot copy as the values; the aux hashes cover the non-OT
+  // entries (values without their epochs, and which entries exist).
+  uint32_t         gen = 0;
+  uint32_t         genReset = 0;
+  uint32_t         auxLayoutHash = OTMON_FNV_INIT;
+  uint32_t         auxValueHash = OTMON_FNV_INIT;
+  // Set by sendOTmonitorV2() (or the SSE "ot" event) once the reply is decided.
+  bool             delta = false;
+  bool             auxChanged = false;
+  uint32_t         sinceGen = 0;
+  char             token[OTMON_TOKEN_LEN] = "";   // empty: no "gen" in a delta (SSE)
+
+  OTmonEntry* slot(const __FlashStringHelper* name, const __FlashStringHelper* unit, uint32_t epoch, uint32_t gen, bool aux, uint8_t kind) {
+    if (count >= OTMON_SNAP_MAX_ENTRIES) return nullptr;
+    OTmonEntry* en = &e[count++];
+    en->name = name; en->unit = unit; en->epoch = epoch; en->gen = gen; en->aux = aux; en->kind = kind;
+    en->v.u = 0;                      // defined bytes for the aux value hash
+    return en;
+  }
+  // Overloads mirror the value types the old generic emit lambda took.
+  void add(const __FlashStringHelper* n, const char* v, const __FlashStringHelper* u, uint32_t ep, uint32_t g, bool aux) { if (OTmonEntry* x = slot(n, u, ep, g, aux, OTMON_KIND_STR))   x->v.s = v; }
+  void add(const __FlashStringHelper* n, float v,       const __FlashStringHelper* u, uint32_t ep, uint32_t g, bool aux) { if (OTmonEntry* x = slot(n, u, ep, g, aux, OTMON_KIND_FLOAT)) x->v.f = v; }
+  void add(const __FlashStringHelper* n, int32_t v,     const __FlashStringHelper* u, uint32_t ep, uint32_t g, bool aux) { if (OTmonEntry* x = slot(n, u, ep, g, aux, OTMON_KIND_INT))   x->v.i = v; }
+  void add(const __FlashStringHelper* n, uint32_t v,    const __FlashStringHelper* u, uint32_t ep, uint32_t g, bool aux) { if (OTmonEntry* x = slot(n, u, ep, g, aux, OTMON_KIND_UINT))  x->v.u = v; }
+  void add(const __FlashStringHelper* n, uint16_t v,    const __FlashStringHelper* u, uint32_t ep, uint32_t g, bool aux) { add(n, (uint32_t)v, u, ep, g, aux); }
+  void add(const __FlashStringHelper* n, bool v,        const __FlashStringHelper* u, uint32_t ep, uint32_t g, bool aux) { if (OTmonEntry* x = slot(n, u, ep, g, aux, OTMON_KIND_BOOL))  x->v.b = v; }
+};
 
-    emit(F("flamestatus"), CONOFF(isFlameStatus()),F(""), getMsgLastUpdated(OT_Statusflags));
-  emit(F("chmodus"), CONOFF(isCentralHeatingActive()),F(""), getMsgLastUpdated(OT_Statusflags));
-  emit(F("chenable"), CONOFF(isCentralHeatingEnabled()),F(""), getMsgLastUpdated(OT_Statusflags));
-  emit(F("ch2modus"), CONOFF(isCentralHeating2Active()),F(""), getMsgLastUpdated(OT_Statusflags));
-  emit(F("ch2enable"), CONOFF(isCentralHeating2enabled()),F(""), getMsgLastUpdated(OT_Statusflags));
-  emit(F("dhwmode"), CONOFF(isDomesticHotWaterActive()),F(""), getMsgLastUpdated(OT_Statusflags));
-  emit(F("dhwenable"), CONOFF(isDomesticHotWaterEnabled()),F(""), getMsgLastUpdated(OT_Statusflags));
-  emit(F("diagnosticindicator"), CONOFF(isDiagnosticIndicator()),F(""), getMsgLastUpdated(OT_Statusflags));
-  emit(F("faultindicator"), CONOFF(isFaultIndicator()),F(""), getMsgLastUpdated(OT_Statusflags));
+// Forward declarations — prevent the ESP32 auto-prototype conflict (OTmonSnap not yet visible at sketch top)
+static void otmonCollect(OTmonSnap& snap);
+static uint8_t otmonEmit(JsonEmit& je, const OTmonSnap& s);
 
-  emit(F("coolingmodus"), CONOFF(isCoolingEnabled()),F(""), getMsgLastUpdated(OT_Statusflags));
-  emit(F("coolingactive"), CONOFF(isCoolingActive()),F(""), getMsgLastUpdated(OT_Statusflags));
-  emit(F("otcactive"), CONOFF(isOutsideTemperatureCompensationActive()),F(""), getMsgLastUpdated(OT_Statusflags));
+static void otmonCollect(OTmonSnap& snap)
+{
+  time_t now = time(nullptr); // needed for Dallas sensor display
+  // One consistent copy of the decoded OT state (never torn, never waits on
+  // processOT). The status bits below are the is*() helpers' masks applied
+  // to that copy.
+  OTdataStruct ot;
+  otStateSnapshot.read(ot);
+  snap.gen      = ot.gen;
+  snap.genReset = ot.genReset;
+  auto emit = [&](const __FlashStringHelper* name, auto value,
+                  const __FlashStringHelper* unit, uint8_t msgId) {
+    snap.add(name, value, unit, getMsgLastUpdated(msgId), getMsgGen(ot, msgId), false);
+  };
+  auto emitAux = [&](const __FlashStringHelper* name, auto value,
+                     const __FlashStringHelper* unit, uint32_t epoch) {
+    snap.add(name, value, unit, epoch, 0, true);
+  };
+  const uint8_t ms = ot.MasterStatus, ss = ot.SlaveStatus;
+  const uint16_t asf = ot.ASFflags;
+
+  emit(F("flamestatus"), CONOFF(ss & 0x08),F(""), OT_Statusflags);
+  emit(F("chmodus"), CONOFF(ss & 0x02),F(""), OT_Statusflags);
+  emit(F("chenable"), CONOFF(ms & 0x01),F(""), OT_Statusflags);
+  emit(F("ch2modus"), CONOFF(ss & 0x20),F(""), OT_Statusflags);
+  emit(F("ch2enable"), CONOFF(ms & 0x10),F(""), OT_Statusflags);
+  emit(F("dhwmode"), CONOFF(ss & 0x04),F(""), OT_Statusflags);
+  emit(F("dhwenable"), CONOFF(ms & 0x02),F(""), OT_Statusflags);
+  emit(F("diagnosticindicator"), CONOFF(ss & 0x40),F(""), OT_Statusflags);
+  emit(F("faultindicator"), CONOFF(ss & 0x01),F(""), OT_Statusflags);
+
+  emit(F("coolingmodus"), CONOFF(ms & 0x04),F(""), OT_Statusflags);
+  emit(F("coolingactive"), CONOFF(ss & 0x10),F(""), OT_Statusflags);
+  emit(F("otcactive"), CONOFF(ms & 0x08),F(""), OT_Statusflags);
 
   if (getMsgLastUpdated(OT_ASFflags)) {
-    emit(F("servicerequest"), CONOFF(isServiceRequest()),F(""), getMsgLastUpdated(OT_ASFflags));
-    emit(F("lockoutreset"), CONOFF(isLockoutReset()),F(""), getMsgLastUpdated(OT_ASFflags));
-    emit(F("lowwaterpressure"), CONOFF(isLowWaterPressure()),F(""), getMsgLastUpdated(OT_ASFflags));
-    emit(F("gasflamefault"), CONOFF(isGasFlameFault()),F(""), getMsgLastUpdated(OT_ASFflags));
-    emit(F("airtemp"), CONOFF(isAirTemperature()),F(""), getMsgLastUpdated(OT_ASFflags));
-    emit(F("waterovertemperature"), CONOFF(isWaterOverTemperature()),F(""), getMsgLastUpdated(OT_ASFflags));
-    emit(F("oemfaultcode"), (int32_t)(OTcurrentSystemState.ASFflags & 0xFF), F(""), getMsgLastUpdated(OT_ASFflags));
-  }
-
-  if (getMsgLastUpdated(OT_Toutside))            emit(F("outsidetemperature"), OTcurrentSystemState.Toutside, F("°C"), getMsgLastUpdated(OT_Toutside));
-  if (getMsgLastUpdated(OT_Tr))                   emit(F("roomtemperature"), OTcurrentSystemState.Tr, F("°C"), getMsgLastUpdated(OT_Tr));
-  if (getMsgLastUpdated(OT_TrSet))                emit(F("roomsetpoint"), OTcurrentSystemState.TrSet, F("°C"), getMsgLastUpdated(OT_TrSet));
-  if (getMsgLastUpdated(OT_TrOverride))           emit(F("remoteroomsetpoint"), OTcurrentSystemState.TrOverride, F("°C"), getMsgLastUpdated(OT_TrOverride));
-  if (getMsgLastUpdated(OT_TSet))                 emit(F("controlsetpoint"), OTcurrentSystemState.TSet,F("°C"), getMsgLastUpdated(OT_TSet));
-  if (getMsgLastUpdated(OT_RelModLevel))          emit(F("relmodlvl"), OTcurrentSystemState.RelModLevel,F("%"), getMsgLastUpdated(OT_RelModLevel));
-  if (getMsgLastUpdated(OT_MaxRelModLevelSetting))emit(F("maxrelmodlvl"), OTcurrentSystemState.MaxRelModLevelSetting, F("%"), getMsgLastUpdated(OT_MaxRelModLevelSetting));
-
-  if (getMsgLastUpdated(OT_Tboiler))              emit(F("boilertemperature"), OTcurrentSystemState.Tboiler, F("°C"), getMsgLastUpdated(OT_Tboiler));
-  if (getMsgLastUpdated(OT_Tret))                 emit(F("returnwatertemperature"), OTcurrentSystemState.Tret,F("°C"), getMsgLastUpdated(OT_Tret));
-  if (getMsgLastUpdated(OT_Tdhw))                 emit(F("dhwtemperature"), OTcurrentSystemState.Tdhw,F("°C"), getMsgLastUpdated(OT_Tdhw));
-  if (getMsgLastUpdated(OT_TdhwSet))              emit(F("dhwsetpoint"), OTcurrentSystemState.TdhwSet,F("°C"), getMsgLastUpdated(OT_TdhwSet));
-  if (getMsgLastUpdated(OT_MaxTSet))              emit(F("maxchwatersetpoint"), OTcurrentSystemState.MaxTSet,F("°C"), getMsgLastUpdated(OT_MaxTSet));
-  if (getMsgLastUpdated(OT_CHPressure))           emit(F("chwaterpressure"), OTcurrentSystemState.CHPressure, F("bar"), getMsgLastUpdated(OT_CHPressure));
-  if (getMsgLastUpdated(OT_OEMDiagnosticCode))    emit(F("oemdiagnosticcode"), OTcurrentSystemState.OEMDiagnosticCode, F(""), getMsgLastUpdated(OT_OEMDiagnosticCode));
-
+    emit(F("servicerequest"), CONOFF(asf & 0x0100),F(""), OT_ASFflags);
+    emit(F("lockoutreset"), CONOFF(asf & 0x0200),F(""), OT_ASFflags);
+    emit(F("lowwaterpressure"), CONOFF(asf & 0x0400),F(""), OT_ASFflags);
+    emit(F("gasflamefault"), CONOFF(asf & 0x0800),F(""), OT_ASFflags);
+    emit(F("airtemp"), CONOFF(asf & 0x1000),F(""), OT_ASFflags);
+    emit(F("waterovertemperature"), CONOFF(asf & 0x2000),F(""), OT_ASFflags);
+    emit(F("oemfaultcode"), (int32_t)(asf & 0xFF), F(""), OT_ASFflags);
+  }
+
+  if (getMsgLastUpdated(OT_Toutside))            emit(F("outsidetemperature"), ot.Toutside, F("°C"), OT_Toutside);
+  if (getMsgLastUpdated(OT_Tr))                   emit(F("roomtemperature"), ot.Tr, F("°C"), OT_Tr);
+  if (getMsgLastUpdated(OT_TrSet))                emit(F("roomsetpoint"), ot.TrSet, F("°C"), OT_TrSet);
+  if (getMsgLastUpdated(OT_TrOverride))           emit(F("remoteroomsetpoint"), ot.TrOverride, F("°C"), OT_TrOverride);
+  if (getMsgLastUpdated(OT_TSet))                 emit(F("controlsetpoint"), ot.TSet,F("°C"), OT_TSet);
+  if (getMsgLastUpdated(OT_RelModLevel))          emit(F("relmodlvl"), ot.RelModLevel,F("%"), OT_RelModLevel);
+  if (getMsgLastUpdated(OT_MaxRelModLevelSetting))emit(F("maxrelmodlvl"), ot.MaxRelModLevelSetting, F("%"), OT_MaxRelModLevelSetting);
+
+  if (getMsgLastUpdated(OT_Tboiler))              emit(F("boilertemperature"), ot.Tboiler, F("°C"), OT_Tboiler);
+  if (getMsgLastUpdated(OT_Tret))                 emit(F("returnwatertemperature"), ot.Tret,F("°C"), OT_Tret);
+  if (getMsgLastUpdated(OT_Tdhw))                 emit(F("dhwtemperature"), ot.Tdhw,F("°C"), OT_Tdhw);
+  if (getMsgLastUpdated(OT_TdhwSet))              emit(F("dhwsetpoint"), ot.TdhwSet,F("°C"), OT_TdhwSet);
+  if (getMsgLastUpdated(OT_MaxTSet))              emit(F("maxchwatersetpoint"), ot.MaxTSet,F("°C"), OT_MaxTSet);
+  if (getMsgLastUpdated(OT_CHPressure))           emit(F("chwaterpressure"), ot.CHPressure, F("bar"), OT_CHPressure);
+  if (getMsgLastUpdated(OT_OEMDiagnosticCode))    emit(F("oemdiagnosticcode"), ot.OEMDiagnosticCode, F(""), OT_OEMDiagnosticCode);
+
+  const uint8_t firstAux = snap.count;
   if (settings.s0.bEnabled)
   {
-    emit(F("s0powerkw"), OTGWs0powerkw , F("kW"), OTGWs0lasttime);
-    emit(F("s0intervalcount"), OTGWs0pulseCount , F(""), OTGWs0lasttime);
-    emit(F("s0totalcount"), OTGWs0pulseCountTot , F(""), OTGWs0lasttime);
+    emitAux(F("s0powerkw"), OTGWs0powerkw , F("kW"), OTGWs0lasttime);
+    emitAux(F("s0intervalcount"), OTGWs0pulseCount , F(""), OTGWs0lasttime);
+    emitAux(F("s0totalcount"), OTGWs0pulseCountTot , F(""), OTGWs0lasttime);
   }
-  emit(F("sensorsimulation"), state.debug.bSensorSim, F(""), now);
+  emitAux(F("sensorsimulation"), state.debug.bSensorSim, F(""), now);
   if (settings.sensors.bEnabled || state.debug.bSensorSim)
   {
-    emit(F("numberofsensors"), DallasrealDeviceCount , F(""), now );
-    for (int i = 0; i < DallasrealDeviceCount; i++) {
-      const char * strDeviceAddress = getDallasAddress(DallasrealDevice[i].addr);
-      if (!strDeviceAddress) continue;
-      // Dallas variant adds "type":"dallas" between unit and epoch.
-      // getDallasAddress() returns a shared static buffer overwritten each call;
-      // the streaming key emits immediately so no per-device copy is needed.
-      je.beginObject(strDeviceAddress);
-      je.field(F("value"), DallasrealDevice[i].tempC);
-      je.field(F("unit"),  F("°C"));
-      je.field(F("type"),  F("dallas"));
-      je.field(F("epoch"), (uint32_t)DallasrealDevice[i].lasttime);
-      je.endObject();
+    emitAux(F("numberofsensors"), (int32_t)DallasrealDeviceCount , F(""), now );
+    for (int i = 0; i < DallasrealDeviceCount && snap.dallasCount < MAXDALLASDEVICES; i++) {
+      OTmonDallasEntry& d = snap.dallas[snap.dallasCount++];
+      strlcpy(d.addr, DallasrealDevice[i].addrStr, sizeof(d.addr));
+      d.tempC    = DallasrealDevice[i].tempC;
+      d.lasttime = (uint32_t)DallasrealDevice[i].lasttime;
       // Labels now managed by Web UI via /dallas_labels.ini file (not sent in API)
     }
   }
 
-    je.endObject();                   // close "otmonitor"
-    je.endObject();                   // close root
+  // Epochs stay out of the value hash: "sensorsimulation" is stamped with
+  // the current second, so hashing it would make every poll a change.
+  for (uint8_t i = firstAux; i < snap.count; i++) {
+    const OTmonEntry& en = snap.e[i];
+    snap.auxLayoutHash = otmonFnv1a(snap.auxLayoutHash, &en.name, sizeof(en.name));
+    snap.auxValueHash  = otmonFnv1a(snap.auxValueHash, &en.v, sizeof(en.v));
   }
-  restFinalize();
+  for (uint8_t i = 0; i < snap.dallasCount; i++) {
+    const OTmonDallasEntry& d = snap.dallas[i];
+    snap.auxLayoutHash = otmonFnv1a(snap.auxLayoutHash, d.addr, strlen(d.addr));
+    snap.auxValueHash  = otmonFnv1a(snap.auxValueHash, &d.tempC, sizeof(d.tempC));
+  }
+}
+
+// The otmonitor document from a collected snapshot. Shared by the REST reply
+// (re-run per chunk, so it reads only s) and the "ot" event of
+// /api/v2/events (sseStuff.ino). A delta adds "delta":true and, when there is
+// one, the new token as "gen", and leaves out the entries that did not change;
+// the full document is unchanged. Returns the number of entries written.
+static uint8_t otmonEmit(JsonEmit& je, const OTmonSnap& s)
+{
+  uint8_t written = 0;
+  je.beginObject();                   // root {
+  if (s.delta) {
+    je.field(F("delta"), true);
+    if (s.token[0]) je.field(F("gen"), (const char*)s.token);
+  }
+  je.beginObject(F("otmonitor"));     // "otmonitor":{
+  for (uint8_t i = 0; i < s.count; i++) {
+    const OTmonEntry& en = s.e[i];
+    if (s.delta && (en.aux ? !s.auxChanged : en.gen <= s.sinceGen)) continue;
+    je.beginObject(en.name);
+    switch (en.kind) {
+      case OTMON_KIND_STR:   je.field(F("value"), en.v.s); break;
+      case OTMON_KIND_FLOAT: je.field(F("value"), en.v.f); break;
+      case OTMON_KIND_INT:   je.field(F("value"), en.v.i); break;
+      case OTMON_KIND_UINT:  je.field(F("value"), en.v.u); break;
+      default:               je.field(F("value"), en.v.b); break;
+    }
+    je.field(F("unit"),  en.unit);
+    je.field(F("epoch"), en.epoch);
+    je.endObject();
+    written++;
+  }
+  for (uint8_t i = 0; i < s.dallasCount; i++) {
+    if (s.delta && !s.auxChanged) break;
+    // Dallas variant adds "type":"dallas" between unit and epoch.
+    const OTmonDallasEntry& d = s.dallas[i];
+    je.beginObject(d.addr);
+    je.field(F("value"), d.tempC);
+    je.field(F("unit"),  F("°C"));
+    je.field(F("type"),  F("dallas"));
+    je.field(F("epoch"), d.lasttime);
+    je.endObject();
+    written++;
+  }
+  je.endObject();                     // close "otmonitor"
+  je.endObject();                     // close root
+  return written;
+}
+
+// Aux generations and the per-boot token tag. Only the async_tcp task
+// serves REST, so these need no lock.
+static OTmonAux otmonAux;
+static uint32_t otmonBootTag = 0;
+
+void sendOTmonitorV2()
+{
+  // The snapshot is ~1 KB; refuse rather than fail the allocation on a
+  // fragmented heap (mirrors the device/info and debug guards).
+  if (platformMaxFreeBlock() < 4096) { sendApiError(503, F("low heap")); return; }
+  auto snap = std::make_shared<OTmonSnap>();
+
+  // TASK-865.5 / TASK-879: this runs on the async_tcp task, the cross-task
+  // READER of the decoded OT state. otmonCollect() copies it out of
+  // otStateSnapshot (seqlock, OTGW-Core.h) instead of taking OTStateLock, so it
+  // never waits on processOT() holding the lock across per-frame I/O and never
+  // serves a torn multi-byte value.
+  otmonCollect(*snap);
+
+  // Change generations (OTmonDelta.h). The token goes out as the ETag on
+  // every reply; a poller hands it back as ?since= to get only the fields
+  // that changed, or as If-None-Match to get a bodyless 304. Only ?since=
+  // asks for a delta: a plain conditional GET gets the full document.
+  if (otmonBootTag == 0) otmonBootTag = platformHardwareRandom() | 1u;
+  otmonAuxUpdate(otmonAux, snap->auxLayoutHash, snap->auxValueHash);
+  const OTmonToken cur = { otmonBootTag, snap->gen, otmonAux.gen };
+  otmonTokenFormat(cur, snap->token, sizeof(snap->token));
+  char etag[OTMON_TOKEN_LEN + 2];
+  snprintf_P(etag, sizeof(etag), PSTR("\"%s\""), snap->token);
+
+  OTmonToken since = {};
+  const bool hasSince = hasArgCompat(F("since")) && otmonTokenParse(argCompat(F("since")), since);
+  const bool hasMatch = !hasSince && hasHeaderCompat(F("If-None-Match"))
+                        && otmonTokenParse(headerCompat(F("If-None-Match")), since);
+  OTmonReply reply = otmonDecide(cur, (hasSince || hasMatch) ? &since : nullptr,
+                                 snap->genReset, otmonAux.reset);
+  if (reply == OTMON_REPLY_DELTA && !hasSince) reply = OTMON_REPLY_FULL;
+
+  sendCorsOriginHeader();
+  webPushHeader(F("Access-Control-Expose-Headers"), F("ETag"));
+  webPushHeader(F("Cache-Control"), F("no-cache"));
+  webPushHeader(F("ETag"), etag);
+  if (reply == OTMON_REPLY_NOT_MODIFIED) {
+    webSendStatus(304);
+    return;
+  }
+  snap->delta      = (reply == OTMON_REPLY_DELTA);
+  snap->sinceGen   = since.gen;
+  snap->auxChanged = snap->delta && since.aux != cur.aux;
+
+  // ADR-141 / TASK-885: streaming JsonEmit, chunked + resumable (jsonChunked.h).
+  // Each entry is the OTmon compact object shape "name": {"value": V, "unit": "U",
+  // "epoch": E}; V keeps its native type (CONOFF() strings stay strings, numerics
+  // stay numbers). The closure reads ONLY snap->*; otmonEmit() has the shape.
+  restSendChunked("application/json", [snap](JsonEmit& je) { otmonEmit(je, *snap); });
 }
 
 //=======================================================================
@@ -2913,8 +3267,8 @@ void sendOTmonitorV2()
 // TASK-883: per-response snapshot for the chunked /v2/device/info emit.
 // jsonChunked.h re-runs the emit closure once per TCP window; those passes can
 // span many ms-to-seconds under a flood (filler callbacks interleave as windows
-// ACK). The DETERMINISM CONTRACT requires byte-identical output every pass, so
-// every AUTONOMOUS value (heap, uptime, RSSI, perf/drop/discovery counters, all
+// ACK). The DETERMINISM CONTRACT requires the same op sequence every pass, and
+// one frozen view keeps the document self-consistent, so every AUTONOMOUS value (heap, uptime, RSSI, perf/drop/discovery counters, all
 // state.* that the OT/MQTT tasks mutate on their own) is FROZEN here once. The
 // full OTGWState copy freezes them en bloc so the closure can read snap->st.*
 // uniformly. Captured strings replace String-returning live APIs and the shared
@@ -3221,6 +3575,53 @@ void sendDeviceInfoV2()
 
 } // sendDeviceInfoV2()
 
+//=======================================================================
+// The health document. Shared by GET /api/v2/health and the "health" event
+// of /api/v2/events (sseStuff.ino), so both stay the same shape.
+static void healthEmit(JsonEmit& je)
+{
+  je.beginObject();                 // root {
+  je.beginObject(F("health"));      // "health":{
+  je.field(F("status"),         LittleFSmounted ? "UP" : "DEGRADED");
+  je.field(F("uptime"),         upTime());
+  je.field(F("heap"),           platformFreeHeap());
+  je.field(F("networkmode"),    networkModeName());
+#if defined(HAS_ETH_CAPABLE) && HAS_ETH_CAPABLE
+  je.field(F("wifirssi"),       (int32_t)((state.net.eMode == NET_ETHERNET) ? 0 : WiFi.RSSI()));
+#else
+  je.field(F("wifirssi"),       (int32_t)WiFi.RSSI());
+#endif
+  je.field(F("mqttconnected"),  state.mqtt.bConnected);
+  je.field(F("otgwconnected"),  state.otBus.bOnline);
+  // Two-link OT model + gateway MODE for the v2 connectivity map. Mirror of the
+  // already-proven /api/v2/device/info emitter (sendDeviceInfoV2): the UI needs
+  // thermostat and boiler as INDEPENDENT links (bOnline alone can't tell "boiler
+  // not answering" from "thermostat not asking"), the active OT interface so it
+  // can pick the two-link (PIC) vs single-bus (OT-Direct) presentation, and the
+  // gateway/monitor MODE which is a setting, not a health state.
+  if (hasOTCommandInterface()) {
+    je.field(F("thermostatconnected"), state.otBus.bThermostatState);
+    je.field(F("boilerconnected"),     state.otBus.bBoilerState);
+    // Per-link recency for the v2 connectivity degraded/stale state (ADR-155):
+    // seconds since the last frame from each side, -1 when never seen since boot.
+    // Only the PIC/OT-frame parser stamps these; on OT-Direct they stay -1 and the
+    // UI keeps its bOnline two-link fallback (additive fields per ADR-019).
+    time_t otNow = time(nullptr);   // epoch source used across the firmware (NTP-set system clock); now() is TimeLib, not in scope here
+    je.field(F("thermostat_age_s"), state.otBus.tThermostatLastSeen ? (int32_t)(otNow - state.otBus.tThermostatLastSeen) : (int32_t)-1);
+    je.field(F("boiler_age_s"),     state.otBus.tBoilerLastSeen     ? (int32_t)(otNow - state.otBus.tBoilerLastSeen)     : (int32_t)-1);
+  }
+  if (isPICEnabled())           je.field(F("otcommandinterface"), F("PIC"));
+  else if (isOTDirectEnabled()) je.field(F("otcommandinterface"), F("OT-Direct"));
+  else                          je.field(F("otcommandinterface"), F("None"));
+  if (isPICEnabled()) {
+    je.field(F("otgwmode"), !isGatewayFirmware() ? "N/A" : state.otBus.bGatewayModeKnown ? CCONOFF(state.otBus.bGatewayMode) : "detecting");
+  }
+  je.field(F("ntpenable"),      settings.ntp.bEnable);
+  je.field(F("littlefsMounted"), LittleFSmounted);
+  je.endObject();                   // close "health"
+  je.endObject();                   // close root
+}
+
 //=======================================================================
 // Sends health status as JSON object (map format)
 // Returns: {"health": {"status": "UP", "uptime": "...", ...}}
@@ -3234,46 +3635,7 @@ void sendHealth()
   AsyncResponseStream* strm = restBeginStream("application/json");
   if (strm) {
     JsonEmit je(*strm);
-    je.beginObject();                 // root {
-    je.beginObject(F("health"));      // "health":{
-    je.field(F("status"),         LittleFSmounted ? "UP" : "DEGRADED");
-    je.field(F("uptime"),         upTime());
-    je.field(F("heap"),           platformFreeHeap());
-    je.field(F("networkmode"),    networkModeName());
-#if defined(HAS_ETH_CAPABLE) && HAS_ETH_CAPABLE
-    je.field(F("wifirssi"),       (int32_t)((state.net.eMode == NET_ETHERNET) ? 0 : WiFi.RSSI()));
-#else
-    je.field(F("wifirssi"),       (int32_t)WiFi.RSSI());
-#endif
-    je.field(F("mqttconnected"),  state.mqtt.bConnected);
-    je.field(F("otgwconnected"),  state.otBus.bOnline);
-    // Two-link OT model + gateway MODE for the v2 connectivity map. Mirror of the
-    // already-proven /api/v2/device/info emitter (sendDeviceInfoV2): the UI needs
-    // thermostat and boiler as INDEPENDENT links (bOnline alone can't tell "boiler
-    // not answering" from "thermostat not asking"), the active OT interface so it
-    // can pick the two-link (PIC) vs single-bus (OT-Direct) presentation, and the
-    // gateway/monitor MODE which is a setting, not a health state.
-    if (hasOTCommandInterface()) {
-      je.field(F("thermostatconnected"), state.otBus.bThermostatState);
-      je.field(F("boilerconnected"),     state.otBus.bBoilerState);
-      // Per-link recency for the v2 connectivity degraded/stale state (ADR-155):
-      // seconds since the last frame from each side, -1 when never seen since boot.
-      // Only the PIC/OT-frame parser stamps these; on OT-Direct they stay -1 and the
-      // UI keeps its bOnline two-link fallback (additive fields per ADR-019).
-      time_t otNow = time(nullptr);   // epoch source used across the firmware (NTP-set system clock); now() is TimeLib, not in scope here
-      je.field(F("thermostat_age_s"), state.otBus.tThermostatLastSeen ? (int32_t)(otNow - state.otBus.tThermostatLastSeen) : (int32_t)-1);
-      je.field(F("boiler_age_s"),     state.otBus.tBoilerLastSeen     ? (int32_t)(otNow - state.otBus.tBoilerLastSeen)     : (int32_t)-1);
-    }
-    if (isPICEnabled())           je.field(F("otcommandinterface"), F("PIC"));
-    else if (isOTDirectEnabled()) je.field(F("otcommandinterface"), F("OT-Direct"));
-    else                          je.field(F("otcommandinterface"), F("None"));
-    if (isPICEnabled()) {
-      je.field(F("otgwmode"), !isGatewayFirmware() ? "N/A" : state.otBus.bGatewayModeKnown ? CCONOFF(state.otBus.bGatewayMode) : "detecting");
-    }
-    je.field(F("ntpenable"),      settings.ntp.bEnable);
-    je.field(F("littlefsMounted"), LittleFSmounted);
-    je.endObject();                   // close "health"
-    je.endObject();                   // close root
+    healthEmit(je);
   }
   restFinalize();
 
@@ -3650,6 +4012,7 @@ void sendDeviceSettings()
   addInt(F("mqttinterval"), settings.mqtt.iInterval, "i", 0, 3600);
   addBool(F("mqttseparatesources"), settings.mqtt.bSeparateSources, "b");
   addBool(F("mqttuselegacyottopics"), settings.mqtt.bUseLegacyOtTopics, "b");
+  addBool(F("mqttdevicediscovery"), settings.mqtt.bDeviceDiscovery, "b");
   addBool(F("legacyport25238enabled"), settings.mqtt.bLegacyPort25238Enabled, "b");
   addBool(F("ntpenable"), settings.ntp.bEnable, "b");
   addStr(F("ntptimezone"), CSTR(settings.ntp.sTimezone), "s", 50);
@@ -4003,7 +4366,7 @@ static const char* const PROGMEM knownSettings[] = {
   "gpiooutputsenabled", "gpiooutputspin", "gpiooutputstriggerbit",
   "gpiosensorsenabled", "gpiosensorsinterval", "gpiosensorslegacyformat", "gpiosensorspin",
   "hostname", "httppasswd", "ledblink", "nightlyrestart", "nightlyrestarthour",
-  "mqttbroker", "mqttbrokerport", "mqttenable", "mqtthaprefix", "mqttharebootdetection",
+  "mqttbroker", "mqttbrokerport", "mqttdevicediscovery", "mqttenable", "mqtthaprefix", "mqttharebootdetection",
   "mqttinterval", "mqttonchangepublishing", "mqttotmessage", "mqttpasswd", "mqttseparatesources", "legacyport25238enabled",
   "mqtttoptopic", "mqttuniqueid", "mqttuser",
   "ntpenable", "ntphostname", "ntpsendtime", "ntptimezone",
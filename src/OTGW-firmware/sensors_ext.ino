@@ -11,6 +11,8 @@
 ** most code shamelessly copied from Miles Burton's - Arduino Dallas library
 ** example 'Multiple'   
 */
+#include <atomic>
+
 // Number of temperature devices found
 int numberOfDevices;
 
@@ -55,7 +57,7 @@ void ensureSensorDefaultLabels()
   bool changed = false;
   for (int i = 0; i < DallasrealDeviceCount; i++)
   {
-    const char* addr = getDallasAddress(DallasrealDevice[i].addr);
+    const char* addr = DallasrealDevice[i].addrStr;
     bool found = false;
     for (int j = 0; j < existingCount; j++) {
       if (strcmp(existing[j].addr, addr) == 0) { found = true; break; }
@@ -83,7 +85,7 @@ void ensureSensorDefaultLabels()
   // Append defaults for sensors not yet in file
   for (int i = 0; i < DallasrealDeviceCount; i++)
   {
-    const char* addr = getDallasAddress(DallasrealDevice[i].addr);
+    const char* addr = DallasrealDevice[i].addrStr;
     bool found = false;
     for (int j = 0; j < existingCount; j++) {
       if (strcmp(existing[j].addr, addr) == 0) { found = true; break; }
@@ -114,7 +116,9 @@ void initSimulatedDallasSensors()
     memcpy(DallasrealDevice[i].addr, DallasSimDeviceAddresses[i], sizeof(DeviceAddress));
     DallasrealDevice[i].tempC = 30.0f + (i * 5.0f);
     DallasrealDevice[i].lasttime = 0;
+    DallasrealDevice[i].stats = DallasReadStats();
   }
+  refreshDallasAddressCache();
 
   if (state.debug.bSensors)
   {
@@ -130,8 +134,161 @@ OneWire oneWire;
 // Pass our oneWire reference to Dallas Temperature sensor 
 DallasTemperature sensors(&oneWire);
 
+//=======================================================================
+// 1-Wire sensor task. The bus used to be driven from the loop: every poll
+// sent the convert-all and then a getTempC() per probe, each a ~10 ms
+// bit-banged scratchpad read with interrupts off, so every extra DS18B20 added
+// to the loop gap (iMaxLoopGapMs). The task now owns the bus after
+// initSensors() and runs one sweep per request:
+//
+//   convert   reset + skip ROM + 0x44, one command for every probe
+//   wait      the conversion time of the slowest resolution seen (<=750 ms),
+//             sleeping in 20 ms steps so a park request is honoured quickly
+//   read      one scratchpad per probe, CRC-8 checked (DallasSweep.h); a
+//             CRC error is read once more, the scratchpad holds until the
+//             next convert
+//
+// Hand-off (g_sensorSweep): the loop sets REQUESTED, the task owns the result
+// slots until it stores DONE, then the loop owns them again. The release/
+// acquire pair on that one byte orders the slot writes; nothing else is
+// shared. pollSensors() on the poll timer publishes the previous sweep and
+// requests the next, so the loop never touches the bus or waits on it.
+// Enumeration (initSensors, also the 'd' debug toggle) parks the task first,
+// the same handshake the PIC serial task uses for the flash FSM.
+//=======================================================================
+enum : uint8_t {
+  SENSOR_SWEEP_IDLE = 0,                         // loop owns the slots, nothing new
+  SENSOR_SWEEP_REQUESTED,                        // task owns the slots
+  SENSOR_SWEEP_DONE                              // loop owns the slots, new readings
+};
+
+struct DallasSweepSlot {
+  float            tempC;                        // valid when result == DALLAS_READ_OK
+  DallasReadResult result;                       // this sweep
+  DallasReadStats  stats;
+};
+
+static DallasSweepSlot      dallasSlot[MAXDALLASDEVICES];
+static std::atomic<uint8_t> g_sensorSweep{SENSOR_SWEEP_IDLE};
+static PlatformTask         g_sensorTask       = nullptr;
+static std::atomic<bool>    g_sensorTaskPark{true};      // loop -> task; parked until a bus is enumerated
+static std::atomic<bool>    g_sensorTaskParked{false};   // task -> loop park acknowledgement
+static uint16_t             sensorConvertMs    = DALLAS_CONVERT_MAX_MS;  // task-only
+
+// Returns false when a park request cut the sweep short.
+static bool sensorSweepOnce() {
+  const uint32_t start = millis();
+  sensors.requestTemperatures();                 // setWaitForConversion(false): returns after 0x44
+  for (uint32_t waited = 0; waited < sensorConvertMs; waited += 20) {
+    if (g_sensorTaskPark.load(std::memory_order_relaxed)) return false;
+    platformTaskDelay(20);
+  }
+
+  uint16_t convertMs = 0;
+  uint8_t sp[DALLAS_SCRATCHPAD_SIZE];
+  for (int i = 0; i < DallasrealDeviceCount; i++) {
+    if (g_sensorTaskPark.load(std::memory_order_relaxed)) return false;
+    DallasSweepSlot &slot = dallasSlot[i];
+    DallasReadResult r = DALLAS_READ_MISSING;
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+      uint32_t t0 = micros();
+      bool presence = sensors.readScratchPad(DallasrealDevice[i].addr, sp);
+      r = dallasCheckScratchpad(presence, sp);
+      slot.stats.record(r, micros() - t0);
+      if (r != DALLAS_READ_CRC) break;
+    }
+    slot.result = r;
+    if (r == DALLAS_READ_OK) {
+      slot.tempC = dallasRawToCelsius(dallasScratchpadRaw(DallasrealDevice[i].addr[0], sp));
+      uint16_t ms = dallasConversionMs(DallasrealDevice[i].addr[0], sp);
+      if (ms > convertMs) convertMs = ms;
+    }
+  }
+  // No good read => no resolution known; fall back to the full 12-bit time.
+  sensorConvertMs = convertMs ? convertMs : DALLAS_CONVERT_MAX_MS;
+  DallasSweepMs = millis() - start;
+  return true;
+}
+
+// Leaving the park clears the ack first and then re-checks the request, as
+// picSerialTaskBody() does: initSensors() may re-arm the park between the
+// first check and the clear and, still seeing the old ack, search the bus
+// while this task starts a convert. With the fences here and in
+// sensorTaskParkAcked(), either the loop sees the cleared ack or this
+// re-check sees the new park.
+static void sensorTaskBody(void *arg) {
+  (void)arg;
+  for (;;) {
+    if (g_sensorTaskPark.load(std::memory_order_relaxed)) {
+      g_sensorTaskParked.store(true, std::memory_order_relaxed);
+      platformTaskDelay(20);            // parked: the loop is enumerating, hands off the bus
+      continue;
+    }
+    g_sensorTaskParked.store(false, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (g_sensorTaskPark.load(std::memory_order_relaxed)) {   // re-armed while unparking
+      g_sensorTaskParked.store(true, std::memory_order_relaxed);
+      continue;
+    }
+    if (g_sensorSweep.load(std::memory_order_acquire) != SENSOR_SWEEP_REQUESTED) {
+      platformTaskDelay(20);
+      continue;
+    }
+    if (sensorSweepOnce()) {
+      g_sensorSweep.store(SENSOR_SWEEP_DONE, std::memory_order_release);
+    }
+  }
+}
+
+// Create the sensor task once (ADR-044), the first time a bus is enumerated.
+static void startSensorTask() {
+  if (g_sensorTask != nullptr) return;
+  // 4096 bytes like the PIC task: OneWire byte I/O is shallow and the task
+  // never logs; the scratchpad buffer is the only sizeable local.
+  g_sensorTask = platformTaskCreatePinned(sensorTaskBody, "sensors", 4096, nullptr, 1);
+  if (g_sensorTask == nullptr) {
+    DebugTln(F("ERROR: failed to create sensor task"));
+  } else {
+    DebugTln(F("Sensor task started (pinned to app core)"));
+  }
+}
+
+// Loop side of the park handshake: the ack only counts together with the
+// request it answers (see sensorTaskBody()).
+static bool sensorTaskParkAcked() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return g_sensorTaskParked.load(std::memory_order_relaxed) &&
+         g_sensorTaskPark.load(std::memory_order_relaxed);
+}
+
+// Take the bus back from the task before enumerating. Bounded like
+// waitForPICTaskParked(): the task checks the flag every 20 ms step and
+// between scratchpad reads, so it parks within ~30 ms.
+static void parkSensorTask() {
+  g_sensorTaskPark.store(true, std::memory_order_relaxed);
+  if (g_sensorTask != nullptr) {
+    for (uint16_t i = 0; i < 50 && !sensorTaskParkAcked(); i++) {
+      feedWatchDog();
+      delay(2);
+    }
+  }
+  g_sensorSweep.store(SENSOR_SWEEP_IDLE, std::memory_order_release);
+}
+
+// Rebuild DallasrealDevice[].addrStr. The string is the MQTT topic, HA
+// unique_id, REST key and SAT area mapping of a probe, so it was formatted on
+// every poll and every REST call; now only when the bus is enumerated or
+// settings.sensors.bLegacyFormat changes.
+void refreshDallasAddressCache() {
+  for (int i = 0; i < DallasrealDeviceCount; i++) {
+    strlcpy(DallasrealDevice[i].addrStr, getDallasAddress(DallasrealDevice[i].addr),
+            sizeof(DallasrealDevice[i].addrStr));
+  }
+}
+
 // Initialise the oneWire bus on the GPIO pin 
 void initSensors() {
+  parkSensorTask();          // the task must not drive the bus while it is searched
   bSensorsDetected = false;  // Reset runtime detection state on each init call
   if (!settings.sensors.bEnabled && !state.debug.bSensorSim)
   {
@@ -178,6 +335,8 @@ void initSensors() {
     DallasrealDevice[i].id = DallasrealDeviceCount ;
     DallasrealDevice[i].tempC = 0 ;
     DallasrealDevice[i].lasttime = 0 ;
+    DallasrealDevice[i].stats = DallasReadStats();
+    dallasSlot[i] = DallasSweepSlot();
     
     // Labels are now managed by Web UI via /dallas_labels.json file
     // No label storage in backend memory
@@ -196,9 +355,15 @@ void initSensors() {
     return;  // bSensorsDetected stays false
   }
 
+  refreshDallasAddressCache();
+
   // Create default labels for discovered sensors if they don't exist yet
   ensureSensorDefaultLabels();
   bSensorsDetected = true;  // Sensors successfully detected and initialized
+
+  sensorConvertMs = DALLAS_CONVERT_MAX_MS;  // resolution unknown until the first sweep
+  startSensorTask();
+  g_sensorTaskPark.store(false, std::memory_order_release);   // hand the bus to the task
 }
 
 // Send the sensor device address to MQ for Autoconfigure
@@ -210,7 +375,7 @@ if (settings.mqtt.bEnable) {
     for (int i = 0; i < DallasrealDeviceCount ; i++) 
     {
       // Now configure the MQ interface, it will return immediatly when already configured
-      const char * strDeviceAddress = getDallasAddress(DallasrealDevice[i].addr);
+      const char * strDeviceAddress = DallasrealDevice[i].addrStr;
       if (state.debug.bSensors) DebugTf(PSTR("Sensor Device MQ configuration for device no[%d] addr[%s] \r\n"), i, strDeviceAddress);
       sensorAutoConfigure(OTGWdallasdataid, false, strDeviceAddress) ;     // Configure sensor with the Dallas Deviceaddress
     }
@@ -224,10 +389,6 @@ if (settings.mqtt.bEnable) {
   time_t now = time(nullptr);
   if (!bSensorsDetected) return;  // Guard on runtime detection state, not persisted setting
 
-  if (!state.debug.bSensorSim)
-  {
-    sensors.requestTemperatures(); // Non-blocking: setWaitForConversion(false) in initSensors()
-  }
   bool simUpdateDue = true;
   if (state.debug.bSensorSim && simLastUpdateTime != 0 && (now - simLastUpdateTime) < (time_t)SIM_SENSOR_UPDATE_INTERVAL_SECONDS)
   {
@@ -238,11 +399,27 @@ if (settings.mqtt.bEnable) {
   if (settings.mqtt.bEnable && !getMQTTConfigDone(OTGWdallasdataid)) {
     setMQTTConfigPending(OTGWdallasdataid);
   }
+
+  // Real probes: publish the sweep the sensor task finished since the last
+  // poll, then request the next one. The loop never waits on the bus; a sweep
+  // still running (interval shorter than conversion + reads) is left alone.
+  bool sweepDone = false;
+  if (!state.debug.bSensorSim)
+  {
+    uint8_t sweep = g_sensorSweep.load(std::memory_order_acquire);
+    if (sweep == SENSOR_SWEEP_REQUESTED)
+    {
+      DallasSweepOverruns++;
+      if (state.debug.bSensors) DebugTln(F("Sensor sweep still running, poll skipped"));
+      return;
+    }
+    sweepDone = (sweep == SENSOR_SWEEP_DONE);
+  }
+
   // Loop through each real device, store temperature data and send to MQ 
   for (int i = 0; i < DallasrealDeviceCount; i++)
   {
-    // Convert device address to string
-    const char * strDeviceAddress = getDallasAddress(DallasrealDevice[i].addr);
+    const char * strDeviceAddress = DallasrealDevice[i].addrStr;
     // Store the C temp in struc to allow it to be shown on Homepage through restAPI.ino
     if (state.debug.bSensorSim)
     {
@@ -257,13 +434,16 @@ if (settings.mqtt.bEnable) {
     }
     else
     {
-      float tempC = sensors.getTempC(DallasrealDevice[i].addr);
-      if (tempC == DEVICE_DISCONNECTED_C) {
+      if (!sweepDone) continue;                  // first poll after init: nothing read yet
+      const DallasSweepSlot &slot = dallasSlot[i];
+      DallasrealDevice[i].stats = slot.stats;
+      if (slot.result != DALLAS_READ_OK) {
         // Sensor disconnected or read error — skip, keep previous value (Finding #29)
-        if (state.debug.bSensors) DebugTf(PSTR("Sensor [%s] disconnected or read error, skipping\r\n"), strDeviceAddress);
+        if (state.debug.bSensors) DebugTf(PSTR("Sensor [%s] %s, skipping\r\n"), strDeviceAddress,
+                                          slot.result == DALLAS_READ_CRC ? "CRC error" : "disconnected");
         continue;
       }
-      DallasrealDevice[i].tempC = tempC;
+      DallasrealDevice[i].tempC = slot.tempC;
     }
     DallasrealDevice[i].lasttime = now ;
     
@@ -284,7 +464,7 @@ if (settings.mqtt.bEnable) {
       //Build string for MQTT, use sendMQTTData for this
       // ref MQTTPubNamespace = settings.mqtt.sTopTopic + "/value/" + strDeviceAddress ;
       char _msg[15]{0};
-      // strDeviceAddress is already a const char* from getDallasAddress()
+      // strDeviceAddress is the cached DallasrealDevice[i].addrStr
       // Just format the temperature value
       snprintf_P(_msg, sizeof _msg, PSTR("%4.1f"), DallasrealDevice[i].tempC);
 
@@ -309,6 +489,10 @@ if (settings.mqtt.bEnable) {
   {
     simLastUpdateTime = now;
   }
+  else
+  {
+    g_sensorSweep.store(SENSOR_SWEEP_REQUESTED, std::memory_order_release);  // slots go to the task
+  }
 
   // DebugTln(F("end polling sensors"));
   DebugFlush();
@@ -271,6 +271,8 @@ void writeSettings(bool show)
   writeJsonBoolKV(file, F("MQTTdiscoveryAutoVerify"), settings.mqtt.bDiscoveryAutoVerify, true);
   writeJsonBoolKV(file, F("MQTTuseLegacyOtTopics"), settings.mqtt.bUseLegacyOtTopics, true);
   writeJsonBoolKV(file, F("MQTTlastPublishedLegacy"), settings.mqtt.bLastPublishedLegacy, true);  // TASK-648 Task 6: topology stamp
+  writeJsonBoolKV(file, F("MQTTdeviceDiscovery"), settings.mqtt.bDeviceDiscovery, true);
+  writeJsonBoolKV(file, F("MQTTlastPublishedDevice"), settings.mqtt.bLastPublishedDevice, true);  // discovery-format stamp
   writeJsonBoolKV(file, F("NTPenable"), settings.ntp.bEnable, true);
   writeJsonStringKV(file, F("NTPtimezone"), settings.ntp.sTimezone, true);
   writeJsonStringKV(file, F("NTPhostname"), settings.ntp.sHostname, true);
@@ -647,6 +649,7 @@ void readSettings(bool show)
     Debugf(PSTR("HA reboot detection   : %s\r\n"), CBOOLEAN(settings.mqtt.bHaRebootDetect));
     Debugf(PSTR("Discovery auto-verify : %s\r\n"), CBOOLEAN(settings.mqtt.bDiscoveryAutoVerify));
     Debugf(PSTR("Use legacy OT topics  : %s\r\n"), CBOOLEAN(settings.mqtt.bUseLegacyOtTopics));
+    Debugf(PSTR("HA device discovery   : %s\r\n"), CBOOLEAN(settings.mqtt.bDeviceDiscovery));
     Debugf(PSTR("NTP enabled           : %s\r\n"), CBOOLEAN(settings.ntp.bEnable));
     Debugf(PSTR("NPT timezone          : %s\r\n"), CSTR(settings.ntp.sTimezone));
     Debugf(PSTR("NPT hostname          : %s\r\n"), CSTR(settings.ntp.sHostname));
@@ -817,6 +820,10 @@ void updateSetting(const char *field, const char *newValue)
   }
   else if (strcasecmp_P(field, PSTR("MQTTseparatesources"))==0) settings.mqtt.bSeparateSources = EVALBOOLEAN(newValue);
   else if (strcasecmp_P(field, PSTR("MQTTlastPublishedLegacy"))==0) settings.mqtt.bLastPublishedLegacy = EVALBOOLEAN(newValue);  // TASK-648 Task 6
+  // No markAll here: the "mqtt" side effect restarts MQTT, and startMQTT() ->
+  // publishNonOTDiscoveryConfigs() sees the stamp mismatch and migrates.
+  else if (strcasecmp_P(field, PSTR("MQTTdeviceDiscovery"))==0) settings.mqtt.bDeviceDiscovery = EVALBOOLEAN(newValue);
+  else if (strcasecmp_P(field, PSTR("MQTTlastPublishedDevice"))==0) settings.mqtt.bLastPublishedDevice = EVALBOOLEAN(newValue);
   else if (strcasecmp_P(field, PSTR("LegacyPort25238Enabled"))==0) {
     settings.mqtt.bLegacyPort25238Enabled = EVALBOOLEAN(newValue);
     pendingSideEffects |= SIDE_EFFECT_OTGWSTREAM;
@@ -828,6 +835,7 @@ void updateSetting(const char *field, const char *newValue)
   }
   else if (strcasecmp_P(field, PSTR("NTPtimezone"))==0)    {
     strlcpy(settings.ntp.sTimezone, newValue, sizeof(settings.ntp.sTimezone));
+    invalidateOTLogTimestampZone();        // OT log re-resolves the zone on the next frame
     pendingSideEffects |= SIDE_EFFECT_NTP; // defer NTP restart to flushSettings()
   }
   else if (strcasecmp_P(field, PSTR("NTPsendtime"))==0)    settings.ntp.bSendtime = EVALBOOLEAN(newValue);
@@ -860,6 +868,7 @@ void updateSetting(const char *field, const char *newValue)
   else if (strcasecmp_P(field, PSTR("GPIOSENSORSlegacyformat")) == 0)
   {
     settings.sensors.bLegacyFormat = EVALBOOLEAN(newValue);
+    refreshDallasAddressCache();  // topics / REST keys switch format on the next poll
     Debugln();
     DebugTf(PSTR("Updated GPIO Sensors Legacy Format to %s\r\n\n"), CBOOLEAN(settings.sensors.bLegacyFormat));
   }
@@ -0,0 +1,305 @@
+/*
+***************************************************************************
+**  Program  : sseStuff.ino
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+**  GET /api/v2/events: Server-Sent Events push of the state the Web UI
+**  otherwise polls for (SseEvents.h has the topics and the bookkeeping).
+**
+**    event: ot       otmonitor document, full after a connect, then deltas
+**    event: sat      /api/v2/sat/status document, when it changed
+**    event: health   /api/v2/health document, when it changed
+**    event: hello    on connect; carries the reconnect hint
+**    event: keepalive  every 30 s without other traffic
+**
+**  The stream is served on the AsyncTCP task like every other response;
+**  handleEventStream() runs on the loop task from doBackgroundTasks() and
+**  renders each due topic once into a buffer, then hands the same bytes to
+**  every event source (one per topic combination) that carries the topic.
+**
+**  Security: same as the REST API. The sat topic needs the HTTP password
+**  when one is set (checkHttpAuth(), as /api/v2/sat); ot and health do not.
+***************************************************************************
+*/
+
+#include "webServerCompat.h"   // extern AsyncWebServer server (port 80, TASK-865.9)
+
+#ifndef SSE_MAX_EVENTS_PER_SEC
+#define SSE_MAX_EVENTS_PER_SEC  2             // per topic; changes in between coalesce
+#endif
+#define SSE_OT_INTERVAL_MS      (1000 / SSE_MAX_EVENTS_PER_SEC)
+#define SSE_SAT_INTERVAL_MS     1000          // the control loop runs every few seconds
+#define SSE_HEALTH_INTERVAL_MS  5000          // uptime and heap differ on every render
+#define SSE_KEEPALIVE_MS        30000
+#define SSE_RETRY_MS            5000          // EventSource reconnect delay hint
+#define SSE_BUF_LEN             6144          // largest document (sat with BLE + areas) fits
+#define SSE_MAX_QUEUED          4             // events waiting per client before topics pause
+
+// One source per topic combination, index sseSourceIndex(mask). Not attached
+// to the server: the /api/v2/events route picks the source per request.
+static AsyncEventSource *sseSources[SSE_SOURCE_COUNT] = {};
+static bool sseInitialized = false;
+
+// Set by onConnect on the AsyncTCP task, consumed by the loop task: the new
+// client has no state yet, so its topics go out in full on the next tick.
+static volatile bool sseJoined[SSE_SOURCE_COUNT] = {};
+
+// Loop task only.
+struct SseScratch {
+  char      buf[SSE_BUF_LEN];
+  OTmonSnap ot;
+};
+static SseScratch *sseScratch = nullptr;
+static SseGate  sseGates[SSE_TOPIC_COUNT];
+static OTmonAux sseOtAux;                     // aux generations of the ot topic (not REST's)
+static uint32_t sseOtGen = 0;                 // OT generation the last ot event covered
+static uint32_t sseOtAuxGen = 0;
+static uint32_t sseEventId = 0;
+static uint32_t sseLastSendMs = 0;
+static uint32_t sseOverflows = 0;            // documents over SSE_BUF_LEN, dropped
+
+// JsonEmit sink into the scratch buffer. A document that does not fit is
+// dropped (overflow()), never sent truncated.
+class SseBufPrint : public Print {
+public:
+  SseBufPrint(char *buf, size_t cap) : _buf(buf), _cap(cap) { _buf[0] = '\0'; }
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *p, size_t n) override {
+    if (_overflow || _len + n >= _cap) { _overflow = true; return 0; }
+    memcpy(_buf + _len, p, n);
+    _len += n;
+    _buf[_len] = '\0';
+    return n;
+  }
+  size_t length() const { return _len; }
+  bool overflow() const { return _overflow; }
+private:
+  char  *_buf;
+  size_t _cap;
+  size_t _len = 0;
+  bool   _overflow = false;
+};
+
+static uint8_t sseClientCount()
+{
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < SSE_SOURCE_COUNT; i++) if (sseSources[i]) n += (uint8_t)sseSources[i]->count();
+  return n;
+}
+
+// Topics at least one connected client asked for.
+static uint8_t sseActiveTopics()
+{
+  uint8_t mask = 0;
+  for (uint8_t i = 0; i < SSE_SOURCE_COUNT; i++) {
+    if (sseSources[i] && sseSources[i]->count() > 0) mask |= (uint8_t)(i + 1);
+  }
+  return mask;
+}
+
+// A slow client's queue fills; its topics wait (and coalesce) instead of
+// piling up more events in lwIP buffers.
+static bool sseTopicBacklogged(uint8_t topic)
+{
+  for (uint8_t i = 0; i < SSE_SOURCE_COUNT; i++) {
+    if (sseSources[i] && sseSourceHasTopic(i, topic) && sseSources[i]->count() > 0 &&
+        sseSources[i]->avgPacketsWaiting() > SSE_MAX_QUEUED) return true;
+  }
+  return false;
+}
+
+static void sseNoteOverflow(uint8_t topic)
+{
+  if ((sseOverflows++ & 0x3F) == 0) {       // first, then every 64th
+    DebugTf(PSTR("SSE: %s event over %u bytes, dropped (%lu so far)\r\n"),
+            kSseTopicNames[topic], (unsigned)SSE_BUF_LEN, (unsigned long)sseOverflows);
+  }
+}
+
+static void sseBroadcast(uint8_t topic, const char *data)
+{
+  ++sseEventId;
+  for (uint8_t i = 0; i < SSE_SOURCE_COUNT; i++) {
+    if (sseSources[i] && sseSourceHasTopic(i, topic) && sseSources[i]->count() > 0) {
+      sseSources[i]->send(data, kSseTopicNames[topic], sseEventId);
+    }
+  }
+  sseLastSendMs = millis();
+}
+
+// AsyncTCP task.
+static void handleEventStreamRequest(AsyncWebServerRequest *request)
+{
+  webBeginRequest(request);
+  uint8_t mask = SSE_TOPIC_ALL;
+  if (!sseParseTopics(hasArgCompat(F("topics")) ? argCompat(F("topics")) : nullptr, mask)) {
+    sendApiError(400, F("Unknown topic: use ot, sat and/or health"));
+    return;
+  }
+  if ((mask & (1u << SSE_TOPIC_SAT)) && !checkHttpAuth()) return;   // same gate as /api/v2/sat
+  if (sseClientCount() >= SSE_MAX_CLIENTS) {
+    sendApiError(503, F("Too many event stream clients"));
+    return;
+  }
+  if (platformFreeHeap() < HEAP_WARNING_THRESHOLD) {
+    sendApiError(503, F("low heap"));
+    return;
+  }
+  AsyncEventSourceResponse *resp = new (std::nothrow) AsyncEventSourceResponse(sseSources[sseSourceIndex(mask)]);
+  if (!resp) { sendApiError(503, F("low heap")); return; }
+  sendCorsOriginHeader();
+  webApplyHeaders(resp);
+  request->send(resp);
+  g_responseSent = true;
+}
+
+// Called from startWebserver() before the /api route, which would otherwise
+// take /api/v2/events as a REST call.
+void startEventStream()
+{
+  if (sseInitialized) return;
+  for (uint8_t i = 0; i < SSE_SOURCE_COUNT; i++) {
+    sseSources[i] = new AsyncEventSource("/api/v2/events");
+    // The next ot tick sends this source a full document. A tick already
+    // rendering still reaches the new client as a delta first; clients drop
+    // deltas until their first full document (index.js, docs/api).
+    sseSources[i]->onConnect([i](AsyncEventSourceClient *client) {
+      sseJoined[i] = true;
+      client->send("{}", "hello", 0, SSE_RETRY_MS);
+    });
+  }
+  server.on("/api/v2/events", HTTP_GET, handleEventStreamRequest);
+  sseInitialized = true;
+}
+
+// ot: the otmonitor snapshot, as a delta against the previous ot event.
+static void sseSendOT(uint32_t now)
+{
+  SseGate &g = sseGates[SSE_TOPIC_OT];
+  if (!sseGateDue(g, now, SSE_OT_INTERVAL_MS)) return;
+  OTmonSnap &snap = *new (&sseScratch->ot) OTmonSnap();   // fresh in place, no stack copy
+  otmonCollect(snap);
+  otmonAuxUpdate(sseOtAux, snap.auxLayoutHash, snap.auxValueHash);
+  g.lastMs = now;
+  // A clear or an aux layout change removes fields, which a delta cannot say.
+  const bool full = g.wantFull || snap.genReset > sseOtGen || sseOtAux.reset > sseOtAuxGen;
+  if (!full && snap.gen == sseOtGen && sseOtAux.gen == sseOtAuxGen) return;
+  snap.delta      = !full;
+  snap.sinceGen   = sseOtGen;
+  snap.auxChanged = sseOtAux.gen != sseOtAuxGen;
+
+  SseBufPrint out(sseScratch->buf, sizeof(sseScratch->buf));
+  uint8_t entries;
+  {
+    JsonEmit je(out);
+    entries = otmonEmit(je, snap);
+  }
+  if (out.overflow()) { sseNoteOverflow(SSE_TOPIC_OT); return; }
+  // A generation can move for a message the document does not show.
+  if (full || entries > 0) sseBroadcast(SSE_TOPIC_OT, sseScratch->buf);
+  sseOtGen    = snap.gen;
+  sseOtAuxGen = sseOtAux.gen;
+  sseGateCommit(g, now, 0);
+}
+
+// sat, health: the whole document, when its bytes changed.
+static void sseSendDocument(uint8_t topic, uint32_t now, uint32_t intervalMs)
+{
+  SseGate &g = sseGates[topic];
+  if (!sseGateDue(g, now, intervalMs)) return;
+  g.lastMs = now;
+  SseBufPrint out(sseScratch->buf, sizeof(sseScratch->buf));
+  {
+    JsonEmit je(out);
+    if (topic == SSE_TOPIC_SAT) {
+      if (!satRenderStatus(je)) return;
+    } else {
+      healthEmit(je);
+    }
+  }
+  if (out.overflow()) { sseNoteOverflow(topic); return; }
+  const uint32_t hash = otmonFnv1a(OTMON_FNV_INIT, sseScratch->buf, out.length());
+  if (!sseGateChanged(g, hash)) return;
+  sseBroadcast(topic, sseScratch->buf);
+  sseGateCommit(g, now, hash);
+}
+
+//===========================================================================================
+// Loop task, every 100 ms from doBackgroundTasks(). Nothing is rendered for a
+// topic without a subscriber; with no clients at all this is a few counters.
+//===========================================================================================
+void handleEventStream()
+{
+  if (!sseInitialized) return;
+  const uint8_t topics = sseActiveTopics();
+  if (!topics) {
+    for (uint8_t t = 0; t < SSE_TOPIC_COUNT; t++) sseGates[t] = SseGate();
+    return;
+  }
+  for (uint8_t i = 0; i < SSE_SOURCE_COUNT; i++) {
+    if (!sseJoined[i]) continue;
+    sseJoined[i] = false;
+    for (uint8_t t = 0; t < SSE_TOPIC_COUNT; t++) if (sseSourceHasTopic(i, t)) sseGateRequestFull(sseGates[t]);
+  }
+  if (!canSendWebSocket()) return;            // same HEAP_CRITICAL gate as the /ws stream
+
+  if (!sseScratch) {
+    void *mem = psramFound() ? ps_malloc(sizeof(SseScratch)) : malloc(sizeof(SseScratch));
+    if (!mem) return;
+    sseScratch = new (mem) SseScratch();
+    DebugTf(PSTR("SSE: %u byte render buffer (%s)\r\n"), (unsigned)sizeof(SseScratch),
+            psramFound() ? "PSRAM" : "heap");
+  }
+
+  const uint32_t now = millis();
+  if ((topics & (1u << SSE_TOPIC_OT)) && !sseTopicBacklogged(SSE_TOPIC_OT))
+    sseSendOT(now);
+  if ((topics & (1u << SSE_TOPIC_SAT)) && !sseTopicBacklogged(SSE_TOPIC_SAT))
+    sseSendDocument(SSE_TOPIC_SAT, now, SSE_SAT_INTERVAL_MS);
+  if ((topics & (1u << SSE_TOPIC_HEALTH)) && !sseTopicBacklogged(SSE_TOPIC_HEALTH))
+    sseSendDocument(SSE_TOPIC_HEALTH, now, SSE_HEALTH_INTERVAL_MS);
+
+  if ((uint32_t)(now - sseLastSendMs) >= SSE_KEEPALIVE_MS) {
+    for (uint8_t i = 0; i < SSE_SOURCE_COUNT; i++) {
+      if (sseSources[i] && sseSources[i]->count() > 0) sseSources[i]->send("{}", "keepalive", 0);
+    }
+    sseLastSendMs = now;
+  }
+}
+
+// prepareForReboot() and emergencyHeapRecovery() in helperStuff.ino. True
+// when there was a client to drop. Browsers reconnect by themselves.
+bool doEventStreamClose()
+{
+  if (!sseInitialized) return false;
+  bool any = false;
+  for (uint8_t i = 0; i < SSE_SOURCE_COUNT; i++) {
+    if (sseSources[i] && sseSources[i]->count() > 0) {
+      sseSources[i]->close();
+      any = true;
+    }
+  }
+  return any;
+}
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
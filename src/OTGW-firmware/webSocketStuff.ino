@@ -16,6 +16,9 @@
 **  - AsyncWebSocket attached to the shared port-80 AsyncWebServer at path /ws
 **    (TASK-865.10, ADR-123 Phase 3): no separate TCP listener, no dedicated port, no loop poll
 **  - Broadcasts log messages directly to all connected clients
+**  - Opt-in binary OT frame stream per client (OTWsBinary.h): a client that
+**    sends {"stream":"binary","v":1} gets batched 8-byte frame records
+**    instead of the per-frame text lines; everything else stays text
 **  - Minimal memory footprint
 **  - Auto-cleanup of disconnected clients (cleanupClients() from a periodic timer)
 **
@@ -140,6 +143,73 @@ bool hasWebSocketClients() {
   return wsInitialized && (otLogWs.count() > 0);
 }
 
+//===========================================================================================
+// Per-client stream mode (text log lines or OTWsBinary.h records)
+//===========================================================================================
+// Written from the WebSocket event handler (AsyncTCP task), read from processOT()
+// on the loop task. Plain volatile like the PIC task flags: a frame that races a
+// connect/mode switch goes out in the old mode once, which the client tolerates.
+// The mode is chosen in-band with a text message instead of a Sec-WebSocket-Protocol
+// subprotocol, so the /ws handshake, the client cap and older UIs are unchanged.
+struct WsClientMode {
+  uint32_t id;        // AsyncWebSocketClient::id(), 0 = free slot
+  bool     binary;
+};
+static volatile WsClientMode wsClientModes[MAX_WEBSOCKET_CLIENTS] = {};
+static volatile uint8_t wsBinaryClientCount = 0;
+static OTWsBinBatch wsBinBatch;       // loop task only
+
+static const char kWsHelloBinary[] PROGMEM = "{\"stream\":\"binary\",\"v\":1}";
+static const char kWsHelloText[]   PROGMEM = "{\"stream\":\"text\"}";
+
+static void recountWsBinaryClients() {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < MAX_WEBSOCKET_CLIENTS; i++) {
+    if (wsClientModes[i].id != 0 && wsClientModes[i].binary) n++;
+  }
+  wsBinaryClientCount = n;
+}
+
+static void setWsClientMode(uint32_t id, bool track, bool binary) {
+  int8_t slot = -1;
+  for (uint8_t i = 0; i < MAX_WEBSOCKET_CLIENTS; i++) {
+    if (wsClientModes[i].id == id) { slot = (int8_t)i; break; }
+  }
+  if (!track) {
+    if (slot >= 0) wsClientModes[slot].id = 0;
+  } else {
+    for (uint8_t i = 0; slot < 0 && i < MAX_WEBSOCKET_CLIENTS; i++) {
+      if (wsClientModes[i].id == 0) slot = (int8_t)i;
+    }
+    if (slot >= 0) {
+      wsClientModes[slot].binary = binary;
+      wsClientModes[slot].id = id;
+    }
+  }
+  recountWsBinaryClients();
+}
+
+bool hasWebSocketBinaryClients() {
+  return wsInitialized && wsBinaryClientCount > 0;
+}
+
+// True when at least one connected client still wants the per-frame text line.
+bool hasWebSocketTextClients() {
+  return hasWebSocketClients() && (otLogWs.count() > wsBinaryClientCount);
+}
+
+static void flushWsBinaryBatch() {
+  const size_t len = otWsBinLength(wsBinBatch);
+  if (len == 0) return;
+  if (wsBinaryClientCount > 0 && canSendWebSocket()) {
+    for (uint8_t i = 0; i < MAX_WEBSOCKET_CLIENTS; i++) {
+      const uint32_t id = wsClientModes[i].id;
+      if (id != 0 && wsClientModes[i].binary) otLogWs.binary(id, wsBinBatch.buf, len);
+    }
+  }
+  otWsBinReset(wsBinBatch);
+}
+
 //===========================================================================================
 // WebSocket event handler (AsyncWebSocket AwsEventHandler signature)
 //===========================================================================================
@@ -152,6 +222,7 @@ void webSocketEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
                     AwsEventType type, void *arg, uint8_t *data, size_t len) {
   switch (type) {
     case WS_EVT_DISCONNECT:
+      setWsClientMode(client->id(), false, false);
       noteWebSocketBurstEvent(WS_BURST_DISCONNECTED);
       DebugTf(PSTR("[%lu] WebSocket[%u] disconnected. Clients: %u\r\n"),
               millis(), client->id(), (unsigned)otLogWs.count());
@@ -178,6 +249,7 @@ void webSocketEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
           return;
         }
 
+        setWsClientMode(client->id(), true, false);   // text until it asks for binary
         IPAddress ip = client->remoteIP();
         noteWebSocketBurstEvent(WS_BURST_CONNECTED);
         DebugTf(PSTR("[%lu] WebSocket[%u] connected from %d.%d.%d.%d. Clients: %u\r\n"),
@@ -186,9 +258,25 @@ void webSocketEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
       break;
 
     case WS_EVT_DATA:
-      // Handle incoming data from client (currently not used, but available for future commands)
-      DebugTf(PSTR("[%lu] WebSocket[%u] received data (%u bytes)\r\n"),
-              millis(), client->id(), static_cast<unsigned>(len));
+      {
+        // Stream-mode hello: a single unfragmented text frame, compared exactly.
+        const AwsFrameInfo *info = static_cast<const AwsFrameInfo *>(arg);
+        const bool whole = info && info->final && info->index == 0 && info->len == len &&
+                           info->opcode == WS_TEXT;
+        bool binary = false;
+        if (whole && len == strlen_P(kWsHelloBinary) && memcmp_P(data, kWsHelloBinary, len) == 0) {
+          binary = true;
+        } else if (!(whole && len == strlen_P(kWsHelloText) && memcmp_P(data, kWsHelloText, len) == 0)) {
+          DebugTf(PSTR("[%lu] WebSocket[%u] received data (%u bytes)\r\n"),
+                  millis(), client->id(), static_cast<unsigned>(len));
+          break;
+        }
+        setWsClientMode(client->id(), true, binary);
+        client->text(binary ? F("{\"type\":\"stream\",\"mode\":\"binary\",\"v\":1}")
+                            : F("{\"type\":\"stream\",\"mode\":\"text\"}"));
+        DebugTf(PSTR("[%lu] WebSocket[%u] stream mode %s. Binary clients: %u\r\n"),
+                millis(), client->id(), binary ? "binary" : "text", (unsigned)wsBinaryClientCount);
+      }
       break;
 
     case WS_EVT_ERROR:
@@ -255,6 +343,7 @@ void handleWebSocket() {
   otLogWs.cleanupClients(MAX_WEBSOCKET_CLIENTS);
 
   unsigned long now = millis();
+  if (otWsBinDue(wsBinBatch, now)) flushWsBinaryBatch();   // quiet bus: do not hold the last frames
   if (otLogWs.count() > 0 &&
       (now - lastKeepaliveMs) >= KEEPALIVE_INTERVAL_MS) {
     otLogWs.textAll("{\"type\":\"keepalive\"}");
@@ -276,6 +365,33 @@ void sendLogToWebSocket(const char* logMessage) {
   }
 }
 
+//===========================================================================================
+// Per-frame OT log line: text-mode clients only. With no binary clients this is
+// the plain textAll() above; with a mix each text client gets its own copy.
+//===========================================================================================
+void sendOTFrameLogToWebSocket(const char* logLine) {
+  if (logLine == nullptr || logLine[0] == '\0') return;   // muted in processOT(): no reader
+  if (wsBinaryClientCount == 0) { sendLogToWebSocket(logLine); return; }
+  if (!hasWebSocketTextClients() || !canSendWebSocket()) return;
+  for (uint8_t i = 0; i < MAX_WEBSOCKET_CLIENTS; i++) {
+    const uint32_t id = wsClientModes[i].id;
+    if (id != 0 && !wsClientModes[i].binary) otLogWs.text(id, logLine);
+  }
+}
+
+//===========================================================================================
+// Per-frame OT record for binary-mode clients, batched (OTWsBinary.h). Sent when
+// the batch is full, a delta would not fit 16 bits, or OT_WS_BIN_FLUSH_MS has
+// passed (also checked from handleWebSocket() for a quiet bus).
+//===========================================================================================
+void sendOTFrameToWebSocketBinary(char source, uint8_t flags, uint32_t frame) {
+  if (wsBinaryClientCount == 0) { otWsBinReset(wsBinBatch); return; }
+  const uint32_t now = millis();
+  if (otWsBinNeedsFlush(wsBinBatch, now)) flushWsBinaryBatch();
+  otWsBinAppend(wsBinBatch, now, getOTLogMsOfDay(), source, flags, frame);
+  if (otWsBinDue(wsBinBatch, now)) flushWsBinaryBatch();
+}
+
 
 
 /***************************************************************************
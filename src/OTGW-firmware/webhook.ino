@@ -115,7 +115,7 @@ static bool isLocalUrl(const char* url) {
 // relay such as a Node-RED flow or Home Assistant webhook automation, as
 // this device only makes outbound HTTP calls to local-network hosts.
 //=======================================================================
-static bool expandPayload(const char* tmpl, char* out, size_t outLen, bool stateOn) {
+static bool expandPayload(const char* tmpl, char* out, size_t outLen, bool stateOn, const OTdataStruct& ot) {
   bool truncated = false;
   size_t di = 0;
   const char* p = tmpl;
@@ -135,15 +135,15 @@ static bool expandPayload(const char* tmpl, char* out, size_t outLen, bool state
 
     char val[16] = "";
     if      (strcmp_P(varName, PSTR("state"))      == 0) { snprintf_P(val, sizeof(val), stateOn ? PSTR("ON") : PSTR("OFF")); }
-    else if (strcmp_P(varName, PSTR("tboiler"))    == 0) { snprintf_P(val, sizeof(val), PSTR("%.1f"), OTcurrentSystemState.Tboiler); }
-    else if (strcmp_P(varName, PSTR("tr"))         == 0) { if (isnan(OTcurrentSystemState.Tr)) strlcpy_P(val, PSTR("--"), sizeof(val)); else snprintf_P(val, sizeof(val), PSTR("%.1f"), OTcurrentSystemState.Tr); }
-    else if (strcmp_P(varName, PSTR("tset"))       == 0) { snprintf_P(val, sizeof(val), PSTR("%.1f"), OTcurrentSystemState.TSet); }
-    else if (strcmp_P(varName, PSTR("tdhw"))       == 0) { snprintf_P(val, sizeof(val), PSTR("%.1f"), OTcurrentSystemState.Tdhw); }
-    else if (strcmp_P(varName, PSTR("relmod"))     == 0) { snprintf_P(val, sizeof(val), PSTR("%.0f"), OTcurrentSystemState.RelModLevel); }
-    else if (strcmp_P(varName, PSTR("chpressure")) == 0) { snprintf_P(val, sizeof(val), PSTR("%.2f"), OTcurrentSystemState.CHPressure); }
-    else if (strcmp_P(varName, PSTR("flameon"))    == 0) { snprintf_P(val, sizeof(val), (OTcurrentSystemState.SlaveStatus & (1U << 3)) ? PSTR("true") : PSTR("false")); }
-    else if (strcmp_P(varName, PSTR("chmode"))     == 0) { snprintf_P(val, sizeof(val), (OTcurrentSystemState.SlaveStatus & (1U << 1)) ? PSTR("true") : PSTR("false")); }
-    else if (strcmp_P(varName, PSTR("dhwmode"))    == 0) { snprintf_P(val, sizeof(val), (OTcurrentSystemState.SlaveStatus & (1U << 2)) ? PSTR("true") : PSTR("false")); }
+    else if (strcmp_P(varName, PSTR("tboiler"))    == 0) { snprintf_P(val, sizeof(val), PSTR("%.1f"), ot.Tboiler); }
+    else if (strcmp_P(varName, PSTR("tr"))         == 0) { if (isnan(ot.Tr)) strlcpy_P(val, PSTR("--"), sizeof(val)); else snprintf_P(val, sizeof(val), PSTR("%.1f"), ot.Tr); }
+    else if (strcmp_P(varName, PSTR("tset"))       == 0) { snprintf_P(val, sizeof(val), PSTR("%.1f"), ot.TSet); }
+    else if (strcmp_P(varName, PSTR("tdhw"))       == 0) { snprintf_P(val, sizeof(val), PSTR("%.1f"), ot.Tdhw); }
+    else if (strcmp_P(varName, PSTR("relmod"))     == 0) { snprintf_P(val, sizeof(val), PSTR("%.0f"), ot.RelModLevel); }
+    else if (strcmp_P(varName, PSTR("chpressure")) == 0) { snprintf_P(val, sizeof(val), PSTR("%.2f"), ot.CHPressure); }
+    else if (strcmp_P(varName, PSTR("flameon"))    == 0) { snprintf_P(val, sizeof(val), (ot.SlaveStatus & (1U << 3)) ? PSTR("true") : PSTR("false")); }
+    else if (strcmp_P(varName, PSTR("chmode"))     == 0) { snprintf_P(val, sizeof(val), (ot.SlaveStatus & (1U << 1)) ? PSTR("true") : PSTR("false")); }
+    else if (strcmp_P(varName, PSTR("dhwmode"))    == 0) { snprintf_P(val, sizeof(val), (ot.SlaveStatus & (1U << 2)) ? PSTR("true") : PSTR("false")); }
     else { out[di++] = *p++; continue; }  // unknown variable — pass '{' literally
 
     size_t valLen = strlen(val);
@@ -184,9 +184,9 @@ static volatile bool webhookInFlight = false;   // ADR-057 §5: one pending tran
 // task never reads cross-task state. Returns false when there is nothing to
 // send (no URL configured for this state) — a non-error "nothing to do".
 //
-// MUST be called with OpenTherm state reads consistent: loop context (where
-// the OT consumer also runs) needs no lock; the AsyncTCP test endpoint wraps
-// this in an OTStateLock. expandPayload() only READS OTcurrentSystemState.
+// OpenTherm values come from one otStateSnapshot copy, so the payload is
+// consistent from any task (loop, or the AsyncTCP test endpoint) without
+// taking OTStateLock.
 //=======================================================================
 static bool buildWebhookJob(bool stateOn, WebhookJob& job) {
   const char* url = stateOn ? settings.webhook.sURLon : settings.webhook.sURLoff;
@@ -200,9 +200,11 @@ static bool buildWebhookJob(bool stateOn, WebhookJob& job) {
 
   job.hasPayload = (settings.webhook.sPayload[0] != '\0');
   if (job.hasPayload) {
+    OTdataStruct ot;
+    otStateSnapshot.read(ot);
     bool wasTruncated = expandPayload(settings.webhook.sPayload,
                                       job.sPayloadExpanded, sizeof(job.sPayloadExpanded),
-                                      stateOn);
+                                      stateOn, ot);
     if (wasTruncated) {
       DebugTf(PSTR("Webhook: expanded payload truncated to %u bytes for %s\r\n"),
               static_cast<unsigned int>(sizeof(job.sPayloadExpanded) - 1), url);
@@ -338,8 +340,9 @@ void startWebhookTask() {
 
 //=======================================================================
 // Fire the webhook for a specific state on demand (for testing).
-// Called from the AsyncTCP web-server task (restAPI test endpoint), so the
-// OpenTherm-state read inside buildWebhookJob() is wrapped in an OTStateLock.
+// Called from the AsyncTCP web-server task (restAPI test endpoint);
+// buildWebhookJob() reads the OpenTherm state from otStateSnapshot, so this
+// never waits on the loop-task writer (TASK-879).
 // Enqueues a job and returns immediately — the blocking send happens on the
 // webhook task, never on the AsyncTCP task.
 //=======================================================================
@@ -347,17 +350,7 @@ void testWebhook(bool testOn) {
   DebugTf(PSTR("Webhook: test requested for state %s\r\n"), testOn ? "ON" : "OFF");
   if (webhookQueue == nullptr) return;
   WebhookJob job;
-  bool built;
-  {
-    // TASK-879: bounded acquire (never the default 0 == portMAX_DELAY). testWebhook
-    // runs on the async_tcp task (POST /api/v2/webhook/test); the loop-task writer
-    // (processOT) holds otStateMutex across slow I/O, so an unbounded wait here can
-    // wedge the WDT-subscribed service task. On timeout buildWebhookJob proceeds
-    // unlocked — at worst a slightly-stale test payload.
-    OTStateLock stateLock(OT_STATE_READ_LOCK_MS);
-    built = buildWebhookJob(testOn, job);
-  }
-  if (built) {
+  if (buildWebhookJob(testOn, job)) {
     if (!platformQueueSend(webhookQueue, &job)) {
       DebugTln(F("Webhook: test enqueue dropped (queue full)"));
     }
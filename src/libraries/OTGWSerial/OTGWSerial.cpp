@@ -56,6 +56,39 @@ static char fwversion[16];
 const char hexbytefmt[] PROGMEM = "%02x";
 const char hexwordfmt[] PROGMEM = "%04x";
 
+// Row image of a hex file, stored next to it as <name>.img. Parsing the hex
+// (sscanf per word) is the slow part of preparing an upgrade, and it used to
+// be done twice: in readHexFile() and again row by row while programming.
+// The first upgrade from a hex file writes the rows prepareCode() produces
+// to the image; later upgrades from the same file (size and CRC-32 match)
+// read the rows from the image instead. Layout: header, datamem[256],
+// eedata[256], then one record per program memory row.
+#define IMAGE_FORMAT    1
+#define IMAGE_ROWSIZE   32  // words per row, one codemem[] buffer
+
+const char imagemagic[] PROGMEM = "OTGI";
+
+struct OTGWImageHeader {
+    char magic[4];
+    uint16_t format;
+    uint8_t model, rowsize;
+    uint16_t rows, weight;
+    uint32_t hexsize, hexcrc;
+    uint16_t reserved;
+    uint16_t crc;           // CRC-16 of the header, datamem and eedata
+};
+
+struct OTGWImageRow {
+    uint16_t addr;
+    uint16_t crc;           // CRC-16 of code[]
+    uint16_t code[IMAGE_ROWSIZE];
+};
+
+static_assert(sizeof(OTGWImageHeader) == 24, "image header layout");
+static_assert(sizeof(OTGWImageRow) == 4 + 2 * IMAGE_ROWSIZE, "image row layout");
+
+#define IMAGE_ROWSTART  (sizeof(OTGWImageHeader) + 2 * 256)
+
 enum {
     FWSTATE_IDLE,
     FWSTATE_RSET,
@@ -117,6 +150,58 @@ unsigned short p16f1847recover(unsigned short addr, unsigned short *code) {
     return cnt;
 }
 
+// CRC-16/CCITT-FALSE and CRC-32 (IEEE), a nibble at a time
+const unsigned short crc16table[16] PROGMEM = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef
+};
+
+const uint32_t crc32table[16] PROGMEM = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+    0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+    0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+};
+
+static unsigned short crc16ccitt(const void *buf, size_t len, unsigned short crc = 0xffff) {
+    const unsigned char *p = (const unsigned char *)buf;
+    while (len-- > 0) {
+        crc = (crc << 4) ^ pgm_read_word(crc16table + ((crc >> 12) ^ (*p >> 4)));
+        crc = (crc << 4) ^ pgm_read_word(crc16table + ((crc >> 12) ^ (*p++ & 0xf)));
+    }
+    return crc;
+}
+
+// CRC-32 of the remainder of a file
+static uint32_t fileCrc32(File &f) {
+    unsigned char buf[64];
+    uint32_t crc = 0xffffffff;
+    int len;
+
+    while ((len = f.read(buf, sizeof(buf))) > 0) {
+        for (int n = 0; n < len; n++) {
+            crc = (crc >> 4) ^ pgm_read_dword(crc32table + ((crc ^ buf[n]) & 0xf));
+            crc = (crc >> 4) ^ pgm_read_dword(crc32table + ((crc ^ (buf[n] >> 4)) & 0xf));
+        }
+    }
+    return ~crc;
+}
+
+static unsigned short imageCrc(OTGWImageHeader hdr, const unsigned char *datamem, const unsigned char *eedata) {
+    hdr.crc = 0;
+    return crc16ccitt(eedata, 256, crc16ccitt(datamem, 256, crc16ccitt(&hdr, sizeof(hdr))));
+}
+
+// Derive the image file name from the hex file name: x.hex -> x.img
+static bool imagePath(const char *hexfile, char *path, size_t size) {
+    const char *ext = strrchr(hexfile, '.');
+    if (ext == nullptr || strcmp_P(ext, PSTR(".hex")) != 0) return false;
+    if ((size_t)(ext - hexfile) + 5 > size) return false;
+    memcpy(path, hexfile, ext - hexfile);
+    strcpy_P(path + (ext - hexfile), PSTR(".img"));
+    return true;
+}
+
 OTGWUpgrade::OTGWUpgrade(OTGWSerial *serial)
   : serial(serial), stage(FWSTATE_IDLE) {
     // Explicitly zero the receive-framing state: these members were never
@@ -127,11 +212,18 @@ OTGWUpgrade::OTGWUpgrade(OTGWSerial *serial)
     checksum = 0;
     cmdcode = 0;
     buffer[0] = '\0';
+    imgrows = 0;
+    imgrow = 0;
+    rowcheck = false;
+    rowmisses = 0;
+    rowswritten = 0;
+    rowsskipped = 0;
     lastaction = millis();
 }
 
 OTGWUpgrade::~OTGWUpgrade() {
     if (hexfd) hexfd.close();
+    if (imgfd) imgfd.close();
 }
 
 OTGWError OTGWUpgrade::start(const char *hexfile) {
@@ -221,23 +313,14 @@ OTGWError OTGWUpgrade::readHexRecord() {
     return OTGW_ERROR_HEX_FORMAT;
 }
 
-OTGWError OTGWUpgrade::readHexFile(const char *hexfile) {
-    int linecnt = 0, addr = 0, weight, rowsize = 0;
+// Parse the complete hex file: determine the PIC model, collect the data
+// memory contents and add up the programming weight
+OTGWError OTGWUpgrade::parseHexFile(int &weight) {
+    int linecnt = 0, addr = 0, rowsize = 0;
     byte datamap = 0;
     OTGWError rc = OTGW_ERROR_NONE;
 
-    hexfd = LittleFS.open(hexfile, "r");
-    if (!hexfd) return finishUpgrade(OTGW_ERROR_HEX_ACCESS);
-    hexfd.setTimeout(0);
-
-    model = PICUNKNOWN;
-    memset(datamem, -1, 256 * sizeof(char));
-    memset(eedata, -1, 256 * sizeof(char));
-    weight = WEIGHT_RESET + WEIGHT_VERSION;
-
-    hexseg = 0;
-    hexaddr = 0;
-    hexpos = 0;
+    rewindHex();
     while (rc == OTGW_ERROR_NONE) {
         rc = readHexRecord();
         if (hexlen == 0) break;
@@ -299,12 +382,46 @@ OTGWError OTGWUpgrade::readHexFile(const char *hexfile) {
         }
         addr = hexaddr + hexlen;
     }
-    if (rc != OTGW_ERROR_NONE) return finishUpgrade(rc);
-
-    Dprintf(PSTR("model: %d\n"), model);
+    if (rc != OTGW_ERROR_NONE) return rc;
 
     // The self-programming code will be skipped (assume 256 program words)
     weight -= 8 * WEIGHT_CODEPROG;
+    return OTGW_ERROR_NONE;
+}
+
+OTGWError OTGWUpgrade::readHexFile(const char *hexfile) {
+    int weight;
+    OTGWError rc;
+    char imgfile[64];
+    uint32_t hexsize = 0, hexcrc = 0;
+    bool cache;
+
+    hexfd = LittleFS.open(hexfile, "r");
+    if (!hexfd) return finishUpgrade(OTGW_ERROR_HEX_ACCESS);
+    hexfd.setTimeout(0);
+
+    model = PICUNKNOWN;
+    memset(datamem, -1, 256 * sizeof(char));
+    memset(eedata, -1, 256 * sizeof(char));
+    weight = WEIGHT_RESET + WEIGHT_VERSION;
+
+    // An image compiled from this exact hex file saves parsing it
+    cache = imagePath(hexfile, imgfile, sizeof(imgfile));
+    if (cache) {
+        hexsize = hexfd.size();
+        hexcrc = fileCrc32(hexfd);
+    }
+    if (cache && loadImage(imgfile, hexsize, hexcrc, weight)) {
+        hexfd.close();
+    } else {
+        rc = parseHexFile(weight);
+        if (rc != OTGW_ERROR_NONE) return finishUpgrade(rc);
+        if (cache) compileImage(imgfile, hexsize, hexcrc, weight);
+        // Without an image the hex file is read again while programming
+        if (imgfd) hexfd.close();
+    }
+
+    Dprintf(PSTR("model: %d\n"), model);
 
     // Look for the new firmware version
     // Use sliding window search with memcmp_P to safely handle binary data
@@ -433,6 +550,163 @@ int OTGWUpgrade::prepareCode(unsigned short *buffer) {
     return start;
 }
 
+// Return to the start of the hex file
+void OTGWUpgrade::rewindHex() {
+    hexfd.seek(0, SeekSet);
+    hexseg = 0;
+    hexaddr = 0;
+    hexpos = 0;
+}
+
+// Open the image compiled from the hex file with the given size and CRC and
+// load the header data. Every row is checked, so a damaged or stale image
+// is simply compiled again.
+bool OTGWUpgrade::loadImage(const char *imgfile, uint32_t hexsize, uint32_t hexcrc, int &weight) {
+    OTGWImageHeader hdr;
+    OTGWImageRow row;
+
+    imgfd = LittleFS.open(imgfile, "r");
+    if (!imgfd) return false;
+    if (imgfd.read((uint8_t *)&hdr, sizeof(hdr)) == sizeof(hdr)
+      && memcmp_P(hdr.magic, imagemagic, sizeof(hdr.magic)) == 0
+      && hdr.format == IMAGE_FORMAT && hdr.model < PICCOUNT
+      && hdr.rowsize == IMAGE_ROWSIZE
+      && hdr.hexsize == hexsize && hdr.hexcrc == hexcrc
+      && imgfd.size() == IMAGE_ROWSTART + hdr.rows * sizeof(row)
+      && imgfd.read(datamem, 256) == 256 && imgfd.read(eedata, 256) == 256
+      && imageCrc(hdr, datamem, eedata) == hdr.crc) {
+        for (imgrow = 0; imgrow < hdr.rows; imgrow++) {
+            if (imgfd.read((uint8_t *)&row, sizeof(row)) != sizeof(row)) break;
+            if (crc16ccitt(row.code, sizeof(row.code)) != row.crc) break;
+        }
+        if (imgrow == hdr.rows) {
+            model = hdr.model;
+            memcpy_P(&info, PicInfo + model, sizeof(struct PicInfo));
+            imgrows = hdr.rows;
+            weight = hdr.weight;
+            Dprintf(PSTR("Image %s: %d rows\n"), imgfile, imgrows);
+            return true;
+        }
+    }
+    Dprintf(PSTR("Image %s not usable\n"), imgfile);
+    imgfd.close();
+    memset(datamem, -1, 256 * sizeof(char));
+    memset(eedata, -1, 256 * sizeof(char));
+    return false;
+}
+
+// Write the program memory rows of the parsed hex file to an image. The
+// header goes in last, so an image that was not completely written is never
+// used. Without an image (e.g. file system full) the upgrade reads the rows
+// from the hex file as before.
+void OTGWUpgrade::compileImage(const char *imgfile, uint32_t hexsize, uint32_t hexcrc, int weight) {
+    OTGWImageHeader hdr = {};
+    OTGWImageRow row;
+    int addr;
+    bool ok;
+
+    imgfd = LittleFS.open(imgfile, "w");
+    if (!imgfd) return;
+    ok = imgfd.write((const uint8_t *)&hdr, sizeof(hdr)) == sizeof(hdr)
+      && imgfd.write(datamem, 256) == 256 && imgfd.write(eedata, 256) == 256;
+    rewindHex();
+    while (ok) {
+        addr = prepareCode(row.code);
+        if (addr >= info.codesize) break;
+        row.addr = addr;
+        row.crc = crc16ccitt(row.code, sizeof(row.code));
+        ok = imgfd.write((const uint8_t *)&row, sizeof(row)) == sizeof(row);
+        hdr.rows++;
+        // prepareCode() keeps returning the last row at the end of the file
+        if (hexlen == 0) break;
+    }
+    if (ok) {
+        memcpy_P(hdr.magic, imagemagic, sizeof(hdr.magic));
+        hdr.format = IMAGE_FORMAT;
+        hdr.model = model;
+        hdr.rowsize = IMAGE_ROWSIZE;
+        hdr.weight = weight;
+        hdr.hexsize = hexsize;
+        hdr.hexcrc = hexcrc;
+        hdr.crc = imageCrc(hdr, datamem, eedata);
+        ok = imgfd.seek(0, SeekSet)
+          && imgfd.write((const uint8_t *)&hdr, sizeof(hdr)) == sizeof(hdr);
+    }
+    imgfd.close();
+    if (!ok) {
+        Dprintf(PSTR("Image %s could not be written\n"), imgfile);
+        LittleFS.remove(imgfile);
+        return;
+    }
+    Dprintf(PSTR("Image %s: %d rows compiled\n"), imgfile, hdr.rows);
+    imgfd = LittleFS.open(imgfile, "r");
+    imgrows = hdr.rows;
+}
+
+// Start reading program memory rows from the beginning
+void OTGWUpgrade::rewindCode() {
+    if (imgfd) {
+        imgfd.seek(IMAGE_ROWSTART, SeekSet);
+        imgrow = 0;
+    } else {
+        rewindHex();
+    }
+}
+
+// Fill the buffer with the next program memory row and return its address.
+// Returns the code size after the last row and -1 if the image is damaged.
+int OTGWUpgrade::codeRow(unsigned short *buffer) {
+    OTGWImageRow row;
+
+    if (!imgfd) return prepareCode(buffer);
+    if (imgrow >= imgrows) return info.codesize;
+    if (imgfd.read((uint8_t *)&row, sizeof(row)) != sizeof(row)) return -1;
+    if (crc16ccitt(row.code, sizeof(row.code)) != row.crc) return -1;
+    imgrow++;
+    memcpy(buffer, row.code, sizeof(row.code));
+    return row.addr;
+}
+
+// Proceed with the next row that is not part of the self-programming code,
+// or with the data memory after the last row
+void OTGWUpgrade::nextRow() {
+    int addr;
+
+    do {
+        addr = codeRow(codemem);
+    } while (addr >= 0 && addr + 31 >= protectstart && addr <= protectend);
+    if (addr < 0) {
+        finishUpgrade(OTGW_ERROR_HEX_CHECKSUM);
+        return;
+    }
+    pc = addr;
+    if (pc >= info.codesize) {
+        Dprintf(PSTR("Program memory: %d rows written, %d unchanged\n"),
+          rowswritten, rowsskipped);
+        pc = 0;
+        stage = FWSTATE_DATA;
+        while (loadData(pc) == 0) {
+            pc += 64;
+            if (pc >= info.datasize) {
+                finishUpgrade(OTGW_ERROR_NONE);
+                break;
+            }
+        }
+    } else {
+        // Read the row first. If it already holds the new code, it doesn't
+        // have to be erased and programmed. Once several rows in a row had
+        // to be programmed anyway (blank PIC, other firmware, shifted code),
+        // only check one row in sixteen until a row matches again.
+        if (serial->_differential && (rowmisses < 4 || (pc & 0x1ff) == 0)) {
+            rowcheck = true;
+            readCode(pc);
+        } else {
+            eraseCode(pc);
+        }
+        progress(WEIGHT_CODEPROG);
+    }
+}
+
 void OTGWUpgrade::fwCommand(const unsigned char *cmd, int len) {
     uint8_t i, ch, sum = 0;
 
@@ -508,6 +782,14 @@ bool OTGWUpgrade::verifyCode(const unsigned short *code, const unsigned short *d
     return rc;
 }
 
+// Compare without reporting: a difference is not an error
+bool OTGWUpgrade::sameCode(const unsigned short *code, const unsigned short *data, short len) {
+    for (short i = 0; i < len; i++) {
+        if (data[i] != (code[i] & 0x3fff)) return false;
+    }
+    return true;
+}
+
 short OTGWUpgrade::loadData(short addr) {
     short first = -1, last;
     byte fwcommand[68] = {CMD_WRITEDATA};
@@ -721,15 +1003,9 @@ void OTGWUpgrade::stateMachine(const unsigned char *packet, int len) {
             if (packet != nullptr && packet[1] == 4 && data[1] == info.erasesize && verifyCode(failsafe, data + 2, 4)) {
                 Dprintf(PSTR("Fail safe code installed\n"));
                 // The fail safe is in place, programming can start
-                progress(WEIGHT_CODEPROG);
-                // Return to the start of the file
-                hexfd.seek(0, SeekSet);
-                hexseg = 0;
-                hexaddr = 0;
-                hexpos = 0;
-                pc = prepareCode(codemem);
-                eraseCode(pc);
+                rewindCode();
                 stage = FWSTATE_CODE;
+                nextRow();
             } else {
                 // Failed. Try again.
                 eraseCode(info.erasesize);
@@ -744,26 +1020,21 @@ void OTGWUpgrade::stateMachine(const unsigned char *packet, int len) {
             // digitalWrite(LED2, HIGH);
             readCode(pc);
         } else if (cmd == CMD_ERASEPROG) {
-            if (packet != nullptr && packet[1] == 32 && data[1] == pc && verifyCode(codemem, data + 2)) {
-              do {
-                  pc = prepareCode(codemem);
-              } while (pc + 31 >= protectstart && pc <= protectend);
-                if (pc >= info.codesize) {
-                    pc = 0;
-                    stage = FWSTATE_DATA;
-                    while (loadData(pc) == 0) {
-                        pc += 64;
-                        if (pc >= info.datasize) {
-                            finishUpgrade(OTGW_ERROR_NONE);
-                            break;
-                        }
-                    }
-                    break;
+            bool valid = packet != nullptr && packet[1] == 32 && data[1] == pc;
+            if (rowcheck) {
+                // Row read back before programming
+                rowcheck = false;
+                if (valid && sameCode(codemem, data + 2)) {
+                    rowmisses = 0;
+                    rowsskipped++;
+                    nextRow();
                 } else {
+                    if (rowmisses < 255) rowmisses++;
                     eraseCode(pc);
-                    progress(WEIGHT_CODEPROG);
-                    break;
                 }
+            } else if (valid && verifyCode(codemem, data + 2)) {
+                rowswritten++;
+                nextRow();
             } else {
                 eraseCode(pc);
             }
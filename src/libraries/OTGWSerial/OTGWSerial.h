@@ -101,16 +101,24 @@ protected:
    void progress(int weight);
    unsigned char hexChecksum(char *hex, int len);
    OTGWError readHexRecord();
+   OTGWError parseHexFile(int &weight);
    OTGWError readHexFile(const char *hexfile);
    int versionCompare(const char *version1, const char* version2);
    int eepromSettings(const char *version, OTGWTransferData *xfer);
    void transferSettings(const char *ver1, const char *ver2);
    int prepareCode(unsigned short *buffer);
+   void rewindHex();
+   bool loadImage(const char *imgfile, uint32_t hexsize, uint32_t hexcrc, int &weight);
+   void compileImage(const char *imgfile, uint32_t hexsize, uint32_t hexcrc, int weight);
+   void rewindCode();
+   int codeRow(unsigned short *buffer);
+   void nextRow();
    void fwCommand(const unsigned char *cmd, int len);
    void eraseCode(short addr);
    short loadCode(short addr, const unsigned short *code, short len = 32);
    void readCode(short addr, short len = 32);
    bool verifyCode(const unsigned short *code, const unsigned short *data, short len = 32);
+   bool sameCode(const unsigned short *code, const unsigned short *data, short len = 32);
    short loadData(short addr);
    void readData(short addr, short len = 64);
    bool verifyData(short addr, const byte *data, short len = 64);
@@ -140,6 +148,13 @@ protected:
    byte hexlen, hexpos;
    unsigned short hexdata[8];
    char *version;
+   // Row image compiled from the hex file (<name>.img), replaces prepareCode()
+   File imgfd;
+   unsigned short imgrows, imgrow;
+   // Differential programming: the row at pc is being read back before erase
+   bool rowcheck;
+   byte rowmisses;
+   unsigned short rowswritten, rowsskipped;
 };
 
 class OTGWSerial: public HardwareSerial {
@@ -183,6 +198,10 @@ public:
    // S3 Mini pins, but a boot-detected S3 Mini Pro uses different reset/LED pins.
    void setResetPin(int pin)    { _reset = pin; }
    void setProgressLed(int pin) { _led = pin; }
+   // Read back each program memory row before erasing it and leave rows that
+   // already hold the new code alone (default). Off erases and programs every
+   // row, like before.
+   void setDifferential(bool on) { _differential = on; }
    OTGWError startUpgrade(const char *hexfile);
    void registerFinishedCallback(OTGWUpgradeFinished *func);
    void registerProgressCallback(OTGWUpgradeProgress *func);
@@ -198,6 +217,7 @@ protected:
    OTGWFirmwareReport *_firmwareFunc = nullptr;
    OTGWProcessor model = PIC16F88;
    int _reset, _led;
+   bool _differential = true;
    byte _banner_matched[FIRMWARE_COUNT], _version_pos;
 
    OTGWError finishUpgrade(OTGWError result, short errors, short retries);
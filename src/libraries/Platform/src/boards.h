@@ -118,7 +118,6 @@
 // has ample SRAM, so the SAT history buffers run much deeper than on ESP8266.
 // Ring indices that exceed 255 slots need uint16_t counters; see SAT_RING_IDX_T.
 #define SAT_WIN4H_SIZE          360  // rolling 4h cycle window (12h of 2-min cycle history)
-#define SAT_FLOW_SAMPLE_SIZE    256  // per-cycle flow sample ring (1024 B SRAM, better p90/p10)
 #define SAT_TAIL_SAMPLE_SIZE    180  // end-of-cycle tail = 180s @1Hz
 #define HCR_DAYS                30   // heating-curve daily-median ring (4-week trend)
 #define HCR_INTRADAY_SIZE       1440 // intra-day samples (per-minute, one day)
@@ -185,7 +184,6 @@ typedef uint16_t SAT_RING_IDX_T;
 
 // SAT per-platform buffer sizing — ESP32-S3 SRAM budget (same as OTGW32).
 #define SAT_WIN4H_SIZE          360
-#define SAT_FLOW_SAMPLE_SIZE    256
 #define SAT_TAIL_SAMPLE_SIZE    180
 #define HCR_DAYS                30
 #define HCR_INTRADAY_SIZE       1440
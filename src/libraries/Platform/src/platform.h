@@ -37,6 +37,11 @@
 #include <WiFiUdp.h>
 #include <WiFiClient.h>
 
+// ---- Lock-free SPSC record ring -------------------------------------------
+// Variable-length producer->consumer records without FreeRTOS queue copies
+// (OT frame hand-off, see OTGW-Core.h). Plain C++, shared with host tests.
+#include "platform_spsc_ring.h"
+
 // ---- Unified directory iteration -----------------------------------------
 // Wraps the ESP32 File-based directory API into a small iteration interface.
 class PlatformDir {
@@ -0,0 +1,203 @@
+/*
+***************************************************************************
+**  Program  : platform_spsc_ring.h
+**  Version  : v2.0.0-alpha.354
+**
+**  Copyright (c) 2021-2026 Robert van den Breemen
+**
+**  Lock-free single-producer/single-consumer ring of variable-length
+**  records. Included by platform.h; no Arduino or FreeRTOS dependency, so
+**  tests/test_spsc_ring.cpp includes it directly and hammers it from two
+**  std::threads.
+**
+**  Why not platformQueueCreate(): a FreeRTOS queue copies fixed-size items
+**  by value on send and again on receive, so every item costs its worst-case
+**  size in RAM and two memcpy's of that size in time. Here a record costs
+**  only what it carries, and the data moves once:
+**
+**    producer   p = reserve(maxLen)   contiguous payload space, or nullptr
+**               ...write payload...   (straight from the source buffer)
+**               commit(len, tag)      publishes the record (len <= maxLen)
+**    consumer   p = peek(len, tag)    oldest record, in place, or nullptr
+**               ...use payload...
+**               release()             frees it for the producer
+**
+**  Layout: 4-byte header {uint16 len, uint16 tag} + payload, padded to 4
+**  bytes. A record never straddles the end of the buffer; when it does not
+**  fit in the tail the producer writes a wrap marker and starts at offset 0.
+**  head is written only by the producer and tail only by the consumer, each
+**  published with release and read with acquire, so a record's bytes are
+**  visible before the index that covers them. head == tail means empty; the
+**  producer never lets head catch up with tail from behind.
+**
+**  Exactly ONE producer context and ONE consumer context at a time. Two
+**  producers must be serialized by the caller.
+**
+**  Any record of up to Bytes / 2 - 8 payload bytes (kMaxPayload) fits into
+**  an empty ring regardless of where the indices stand.
+**
+**  TERMS OF USE: GNU GPLv3. See bottom of file.
+***************************************************************************
+*/
+
+#ifndef PLATFORM_SPSC_RING_H
+#define PLATFORM_SPSC_RING_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+#define PLATFORM_SPSC_HDR   4u
+#define PLATFORM_SPSC_WRAP  0xFFFFu   // header len: rest of the buffer is unused, continue at 0
+
+template <uint32_t Bytes>
+class PlatformSpscRing {
+  static_assert(Bytes >= 16 && (Bytes % 4) == 0 && Bytes <= 0x10000u,
+                "PlatformSpscRing size must be a multiple of 4, 16..65536");
+
+public:
+  // Largest payload guaranteed to fit into an empty ring.
+  static constexpr uint16_t kMaxPayload = (uint16_t)(Bytes / 2 - 2 * PLATFORM_SPSC_HDR);
+
+  // Bytes a record with this payload occupies.
+  static constexpr uint32_t recordBytes(uint32_t len) { return (PLATFORM_SPSC_HDR + len + 3u) & ~3u; }
+
+  PlatformSpscRing() : _head(0), _tail(0), _resPos(0), _resMax(0), _peekLen(0), _highWater(0) {}
+
+  // ---- producer ----------------------------------------------------------
+
+  // Contiguous space for a payload of up to maxLen bytes, or nullptr when the
+  // ring is full. Nothing is visible to the consumer until commit().
+  uint8_t *reserve(uint16_t maxLen)
+  {
+    if (maxLen >= PLATFORM_SPSC_WRAP) return nullptr;
+    const uint32_t need = recordBytes(maxLen);
+    const uint32_t h = _head.load(std::memory_order_relaxed);
+    const uint32_t t = _tail.load(std::memory_order_acquire);
+    uint32_t pos;
+    if (h >= t) {
+      if (Bytes - h >= need && !(h + need == Bytes && t == 0)) {
+        pos = h;                       // fits in the tail
+      } else if (t > need) {
+        pos = 0;                       // wrap: [0, t) is free, keep one gap before tail
+      } else {
+        return nullptr;
+      }
+    } else {
+      if (t - h <= need) return nullptr;
+      pos = h;
+    }
+    _resPos = pos;
+    _resMax = maxLen;
+    return _buf + pos + PLATFORM_SPSC_HDR;
+  }
+
+  // Publish the reserved record with its final length (<= the reserved
+  // maxLen) and an application tag.
+  void commit(uint16_t len, uint16_t tag)
+  {
+    if (len > _resMax) len = _resMax;
+    const uint32_t h = _head.load(std::memory_order_relaxed);
+    if (_resPos != h) writeHeader(h, PLATFORM_SPSC_WRAP, 0);   // skipped tail
+    writeHeader(_resPos, len, tag);
+    uint32_t next = _resPos + recordBytes(len);
+    if (next == Bytes) next = 0;
+    const uint32_t t = _tail.load(std::memory_order_relaxed);
+    const uint32_t used = (next >= t) ? next - t : Bytes - t + next;
+    if (used > _highWater) _highWater = used;
+    _head.store(next, std::memory_order_release);
+  }
+
+  // Copying convenience: reserve + memcpy + commit. false when full.
+  bool push(const void *data, uint16_t len, uint16_t tag)
+  {
+    uint8_t *p = reserve(len);
+    if (!p) return false;
+    memcpy(p, data, len);
+    commit(len, tag);
+    return true;
+  }
+
+  // ---- consumer ----------------------------------------------------------
+
+  // Oldest record in place, or nullptr when empty. Stays valid until release().
+  const uint8_t *peek(uint16_t &len, uint16_t &tag)
+  {
+    uint32_t t = _tail.load(std::memory_order_relaxed);
+    uint32_t h = _head.load(std::memory_order_acquire);
+    if (t == h) return nullptr;
+    uint16_t l, g;
+    readHeader(t, l, g);
+    if (l == PLATFORM_SPSC_WRAP) {
+      t = 0;
+      _tail.store(0, std::memory_order_release);
+      if (t == h) return nullptr;      // cannot happen: the wrapped record was committed with it
+      readHeader(0, l, g);
+    }
+    _peekLen = l;
+    len = l;
+    tag = g;
+    return _buf + t + PLATFORM_SPSC_HDR;
+  }
+
+  // Drop the record returned by the last peek().
+  void release()
+  {
+    uint32_t t = _tail.load(std::memory_order_relaxed) + recordBytes(_peekLen);
+    if (t == Bytes) t = 0;
+    _tail.store(t, std::memory_order_release);
+  }
+
+  // ---- either side (approximate while the other side runs) ---------------
+
+  bool empty() const
+  {
+    return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+  }
+
+  uint32_t highWater() const { return _highWater; }   // peak bytes in use (producer-maintained)
+  static constexpr uint32_t capacity() { return Bytes; }
+
+private:
+  void writeHeader(uint32_t pos, uint16_t len, uint16_t tag)
+  {
+    const uint16_t hdr[2] = { len, tag };
+    memcpy(_buf + pos, hdr, sizeof(hdr));
+  }
+
+  void readHeader(uint32_t pos, uint16_t &len, uint16_t &tag) const
+  {
+    uint16_t hdr[2];
+    memcpy(hdr, _buf + pos, sizeof(hdr));
+    len = hdr[0];
+    tag = hdr[1];
+  }
+
+  alignas(4) uint8_t _buf[Bytes];
+  std::atomic<uint32_t> _head;      // producer-owned: next write offset
+  std::atomic<uint32_t> _tail;      // consumer-owned: next read offset
+  uint32_t _resPos;                 // producer-private
+  uint16_t _resMax;                 // producer-private
+  uint16_t _peekLen;                // consumer-private
+  uint32_t _highWater;              // producer-private
+};
+
+/***************************************************************************
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <https://www.gnu.org/licenses/>.
+*
+****************************************************************************
+*/
+
+#endif // PLATFORM_SPSC_RING_H
@@ -0,0 +1,451 @@
+/**
+ * Host test + benchmark for the PIC command queue (OTCmdQueue.h).
+ *
+ * OTCmdQueue replaced cmdqueue[CMDQUEUE_MAX] + fill pointer in
+ * OTGW-Core.ino: linear scans by two-letter code in addCommandToQueue(),
+ * checkCommandResponse(), the PR=A banner and the ser2net override path, a
+ * full scan for due entries in handleCommandQueue(), and a left-shift on
+ * every removal. This file lifts both versions of those five operations
+ * (queue logic only; logging, sendPICSerial and WebSocket events become a
+ * sent/dropped trace) and checks:
+ *
+ *   1. Equivalence: a random stream of adds (dedup, forced PR=x reads, full
+ *      queue, codes outside "AA".."ZZ"), PIC responses, banners, ser2net
+ *      overrides and queue ticks with a fake clock that wraps through
+ *      0xFFFFFFFF. After every operation both queues must hold the same
+ *      commands with the same retry counts and due times; every tick must
+ *      send and drop the same set of commands. (Entries due in the same tick
+ *      go out in due order now instead of slot order, so the per-tick trace
+ *      is compared as a sorted set.)
+ *   2. Heap invariant and code-chain consistency after every operation.
+ *   3. Benchmark: ns/operation for a burst mix (producers far outpacing the
+ *      1 s queue tick, long first-send delays, so the queue runs deep) at
+ *      CMDQUEUE_MAX 20 (firmware default) and 200, legacy vs indexed.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/bench_cmd_queue.cpp -o tests/bench_cmd_queue.out
+ *   ./tests/bench_cmd_queue.out [operations]
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../src/OTGW-firmware/OTCmdQueue.h"
+
+static int failures = 0;
+
+static void check(const char *name, bool ok)
+{
+  printf("%-56s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+#define OTGW_CMD_RETRY 5
+#define OTGW_CMD_INTERVAL_MS 5000
+
+struct Trace {
+  std::vector<std::string> sent, dropped;
+  void clear() { sent.clear(); dropped.clear(); }
+  void onSent(const char *cmd) { sent.push_back(cmd); }
+  void onDropped(const char *cmd) { dropped.push_back(cmd); }
+};
+
+// Benchmark sink: no allocation, so the timing is the queue's own work.
+struct CountTrace {
+  size_t sent = 0, dropped = 0;
+  void clear() {}
+  void onSent(const char *cmd) { sent += (size_t)cmd[0]; }
+  void onDropped(const char *) { dropped++; }
+};
+
+// ---- Legacy: cmdqueue[] + fill pointer (OTGW-Core.ino before OTCmdQueue.h) ----
+template <int Capacity>
+struct LegacyQueue {
+  OT_cmd_t cmdqueue[Capacity];
+  int cmdQueueSize = 0;
+
+  LegacyQueue() { memset(cmdqueue, 0, sizeof(cmdqueue)); }
+
+  void removeFromCmdQueue(int index)
+  {
+    for (int j = index; j < (cmdQueueSize - 1); j++) {
+      memcpy(cmdqueue[j].cmd, cmdqueue[j + 1].cmd, sizeof(cmdqueue[j].cmd));
+      cmdqueue[j].cmdlen = cmdqueue[j + 1].cmdlen;
+      cmdqueue[j].retrycnt = cmdqueue[j + 1].retrycnt;
+      cmdqueue[j].due = cmdqueue[j + 1].due;
+    }
+    cmdQueueSize--;
+    cmdqueue[cmdQueueSize].cmd[0] = '\0';
+    cmdqueue[cmdQueueSize].cmdlen = 0;
+    cmdqueue[cmdQueueSize].retrycnt = 0;
+    cmdqueue[cmdQueueSize].due = 0;
+  }
+
+  void add(const char *buf, int len, bool forceQueue, uint32_t now, uint32_t delay)
+  {
+    bool foundcmd = false;
+    int insertptr = cmdQueueSize;
+    if (!forceQueue) {
+      for (int i = 0; i < cmdQueueSize; i++) {
+        if (cmdqueue[i].cmd[0] == buf[0] && cmdqueue[i].cmd[1] == buf[1]) { foundcmd = true; insertptr = i; break; }
+      }
+    }
+    if (!foundcmd && cmdQueueSize >= Capacity) return;
+    const int cmdlen = std::min(len, (int)sizeof(cmdqueue[insertptr].cmd) - 1);
+    memset(cmdqueue[insertptr].cmd, 0, cmdlen + 1);
+    memcpy(cmdqueue[insertptr].cmd, buf, cmdlen);
+    cmdqueue[insertptr].cmdlen = cmdlen;
+    cmdqueue[insertptr].retrycnt = 0;
+    cmdqueue[insertptr].due = now + delay;
+    if (!foundcmd) cmdQueueSize++;
+  }
+
+  template <typename T>
+  void handle(uint32_t now, T &t)
+  {
+    for (int i = 0; i < cmdQueueSize; i++) {
+      if ((int32_t)(now - cmdqueue[i].due) >= 0) {
+        t.onSent(cmdqueue[i].cmd);
+        cmdqueue[i].retrycnt++;
+        cmdqueue[i].due = now + OTGW_CMD_INTERVAL_MS;
+        if (cmdqueue[i].retrycnt >= OTGW_CMD_RETRY) {
+          t.onDropped(cmdqueue[i].cmd);
+          removeFromCmdQueue(i);
+          i--;
+        }
+      }
+    }
+  }
+
+  void response(const char *cmd, const char *value)
+  {
+    for (int i = 0; i < cmdQueueSize; i++) {
+      if (cmdqueue[i].cmd[0] == cmd[0] && cmdqueue[i].cmd[1] == cmd[1]) {
+        if (cmd[0] == 'P' && cmd[1] == 'R' && cmdqueue[i].cmdlen >= 4) {
+          const char *reg = value;
+          while (*reg == ' ') reg++;
+          if (cmdqueue[i].cmd[3] != *reg) continue;
+        }
+        removeFromCmdQueue(i);
+        break;
+      }
+    }
+  }
+
+  void banner()
+  {
+    for (int qi = 0; qi < cmdQueueSize; qi++) {
+      if (cmdqueue[qi].cmd[0] == 'P' && cmdqueue[qi].cmd[1] == 'R' &&
+          cmdqueue[qi].cmdlen >= 4 && cmdqueue[qi].cmd[3] == 'A') {
+        removeFromCmdQueue(qi);
+        break;
+      }
+    }
+  }
+
+  void ser2net(const char *sWrite, int bytes_write)
+  {
+    for (int qi = 0; qi < cmdQueueSize; qi++) {
+      if (cmdqueue[qi].cmd[0] == sWrite[0] && cmdqueue[qi].cmd[1] == sWrite[1]) {
+        if (sWrite[0] == 'P' && sWrite[1] == 'R' && bytes_write >= 4 && cmdqueue[qi].cmdlen >= 4) {
+          if (cmdqueue[qi].cmd[3] != sWrite[3]) continue;
+        }
+        removeFromCmdQueue(qi);
+        break;
+      }
+    }
+  }
+
+  std::vector<std::string> dump() const
+  {
+    std::vector<std::string> v;
+    for (int i = 0; i < cmdQueueSize; i++) {
+      char line[64];
+      snprintf(line, sizeof(line), "%s|%d|%d|%u", cmdqueue[i].cmd, cmdqueue[i].cmdlen, cmdqueue[i].retrycnt,
+               (unsigned)cmdqueue[i].due);
+      v.push_back(line);
+    }
+    std::sort(v.begin(), v.end());
+    return v;
+  }
+};
+
+// ---- Indexed: OTCmdQueue (OTGW-Core.ino now) ----
+template <uint8_t Capacity>
+struct IndexedQueue {
+  OTCmdQueue<Capacity> cmdQueue;
+
+  bool removeCmdFromQueue(char c0, char c1, bool matchReg, char reg)
+  {
+    const int slot = cmdQueue.find(c0, c1, matchReg, reg);
+    if (slot < 0) return false;
+    cmdQueue.remove((uint8_t)slot);
+    return true;
+  }
+
+  void add(const char *buf, int len, bool forceQueue, uint32_t now, uint32_t delay)
+  {
+    const uint32_t due = now + delay;
+    int insertptr = forceQueue ? -1 : cmdQueue.find(buf[0], buf[1]);
+    const bool foundcmd = (insertptr >= 0);
+    if (!foundcmd) {
+      if (cmdQueue.full()) return;
+      insertptr = cmdQueue.insert(buf[0], buf[1], due);
+    }
+    if (insertptr < 0 || insertptr >= Capacity) return;
+    OT_cmd_t &entry = cmdQueue.entry[insertptr];
+    const int cmdlen = std::min(len, (int)sizeof(entry.cmd) - 1);
+    memset(entry.cmd, 0, sizeof(entry.cmd));
+    memcpy(entry.cmd, buf, cmdlen);
+    entry.cmdlen = cmdlen;
+    entry.retrycnt = 0;
+    if (foundcmd) {
+      entry.due = due;
+      cmdQueue.reschedule((uint8_t)insertptr);
+    }
+  }
+
+  template <typename T>
+  void handle(uint32_t now, T &t)
+  {
+    int slot;
+    while ((slot = cmdQueue.top()) >= 0 && (int32_t)(now - cmdQueue.entry[slot].due) >= 0) {
+      OT_cmd_t &entry = cmdQueue.entry[slot];
+      t.onSent(entry.cmd);
+      entry.retrycnt++;
+      entry.due = now + OTGW_CMD_INTERVAL_MS;
+      if (entry.retrycnt >= OTGW_CMD_RETRY) {
+        t.onDropped(entry.cmd);
+        cmdQueue.remove((uint8_t)slot);
+      } else {
+        cmdQueue.reschedule((uint8_t)slot);
+      }
+    }
+  }
+
+  void response(const char *cmd, const char *value)
+  {
+    const char *reg = value;
+    while (*reg == ' ') reg++;
+    const bool isPR = (cmd[0] == 'P' && cmd[1] == 'R');
+    removeCmdFromQueue(cmd[0], cmd[1], isPR, *reg);
+  }
+
+  void banner() { removeCmdFromQueue('P', 'R', true, 'A'); }
+
+  void ser2net(const char *sWrite, int bytes_write)
+  {
+    const bool matchReg = (bytes_write >= 4);
+    removeCmdFromQueue(sWrite[0], sWrite[1], matchReg, matchReg ? sWrite[3] : 0);
+  }
+
+  std::vector<std::string> dump() const
+  {
+    std::vector<std::string> v;
+    for (uint8_t i = 0; i < cmdQueue.size(); i++) {
+      const OT_cmd_t &e = cmdQueue.entry[cmdQueue.slotAt(i)];
+      char line[64];
+      snprintf(line, sizeof(line), "%s|%d|%d|%u", e.cmd, e.cmdlen, e.retrycnt, (unsigned)e.due);
+      v.push_back(line);
+    }
+    std::sort(v.begin(), v.end());
+    return v;
+  }
+
+  // Heap order on (due, insertion order), heapPos/heap inverse, every live
+  // slot reachable from its code chain exactly once, free slots unlinked.
+  bool invariantsHold() const
+  {
+    const auto &q = cmdQueue;
+    for (uint8_t i = 0; i < Capacity; i++) {
+      if (q.heapPos[q.heap[i]] != i) return false;
+    }
+    for (uint8_t i = 1; i < q.count; i++) {
+      const uint8_t c = q.heap[i], p = q.heap[(i - 1) / 2];
+      const int32_t d = (int32_t)(q.entry[c].due - q.entry[p].due);
+      if (d < 0 || (d == 0 && (int32_t)(q.order[c] - q.order[p]) < 0)) return false;
+    }
+    int linked = 0;
+    for (int b = 0; b < OT_CMD_CODE_BUCKETS; b++) {
+      int guard = 0;
+      for (uint8_t s = q.head[b]; s != OT_CMD_NO_SLOT; s = q.next[s]) {
+        if (++guard > Capacity || q.heapPos[s] >= q.count) return false;
+        if (otCmdCodeBucket(q.entry[s].cmd[0], q.entry[s].cmd[1]) != b) return false;
+        linked++;
+      }
+    }
+    return linked == q.count;
+  }
+};
+
+// ---- Deterministic PRNG (xorshift64*) ----
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+static inline uint32_t rnd()
+{
+  g_rng ^= g_rng >> 12; g_rng ^= g_rng << 25; g_rng ^= g_rng >> 27;
+  return (uint32_t)((g_rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static const char *const kCodes[] = { "TT", "TC", "CS", "SW", "CH", "HW", "GW", "SB", "VR", "MM",
+                                      "OT", "SC", "SH", "BS", "LA", "LB", "PS", "PR", "KI", "SR" };
+static const char kPRRegs[] = "ABCDGILMOPQRSTVW";
+
+enum OpKind { OP_ADD, OP_FORCE_PR, OP_RESPONSE, OP_BANNER, OP_SER2NET, OP_TICK };
+
+struct Op {
+  OpKind kind;
+  char buf[16];
+  int len;
+  uint32_t delay;
+  uint32_t dt;   // clock advance before the op
+};
+
+// burst: producers (SAT, MQTT, REST, ser2net) pushing far faster than the
+// 1 s queue tick drains, with long first-send delays, so the queue runs deep.
+static Op randomOp(bool wideCodes, bool burst = false)
+{
+  Op op {};
+  uint32_t r = rnd() % 100;
+  if (burst && r >= 75) r = (rnd() % 50 == 0) ? 99 : rnd() % 75;
+  op.dt = burst ? rnd() % 20 : rnd() % 700;
+  if (r < 40) {
+    op.kind = OP_ADD;
+    if (wideCodes && rnd() % 3 == 0) {                  // any code: 26x26 spread + the odd lower/digit code
+      const char *alpha = (rnd() % 8) ? "ABCDEFGHIJKLMNOPQRSTUVWXYZ" : "abz09_";
+      const size_t n = strlen(alpha);
+      op.buf[0] = alpha[rnd() % n]; op.buf[1] = alpha[rnd() % n];
+    } else {
+      memcpy(op.buf, kCodes[rnd() % (sizeof(kCodes) / sizeof(kCodes[0]))], 2);
+    }
+    op.len = snprintf(op.buf + 2, sizeof(op.buf) - 2, "=%u.%u", rnd() % 100, rnd() % 10) + 2;
+    if (rnd() % 50 == 0) op.len = 14;                   // max length, padded with what snprintf left
+    op.delay = (rnd() % 4 == 0) ? 0 : rnd() % (burst ? 30000 : 3000);
+  } else if (r < 50) {
+    op.kind = OP_FORCE_PR;
+    op.len = snprintf(op.buf, sizeof(op.buf), "PR=%c", kPRRegs[rnd() % 16]);
+    op.delay = rnd() % 2000;
+  } else if (r < 65) {
+    op.kind = OP_RESPONSE;
+    if (rnd() % 2) {
+      snprintf(op.buf, sizeof(op.buf), "PR:%s%c=1", (rnd() % 2) ? " " : "", kPRRegs[rnd() % 16]);
+    } else {
+      snprintf(op.buf, sizeof(op.buf), "%s: 1", kCodes[rnd() % (sizeof(kCodes) / sizeof(kCodes[0]))]);
+    }
+    op.len = (int)strlen(op.buf);
+  } else if (r < 68) {
+    op.kind = OP_BANNER;
+  } else if (r < 75) {
+    op.kind = OP_SER2NET;
+    if (rnd() % 2) op.len = snprintf(op.buf, sizeof(op.buf), "PR=%c", kPRRegs[rnd() % 16]);
+    else           op.len = snprintf(op.buf, sizeof(op.buf), "%s=1", kCodes[rnd() % (sizeof(kCodes) / sizeof(kCodes[0]))]);
+  } else {
+    op.kind = OP_TICK;
+    op.dt = 1000;
+  }
+  return op;
+}
+
+template <typename Q, typename T>
+static void apply(Q &q, const Op &op, uint32_t now, T &t)
+{
+  switch (op.kind) {
+    case OP_ADD:      q.add(op.buf, op.len, false, now, op.delay); break;
+    case OP_FORCE_PR: q.add(op.buf, op.len, true, now, op.delay); break;
+    case OP_RESPONSE: {
+      char cmd[3] = { op.buf[0], op.buf[1], 0 };
+      char value[11] = {0};
+      const size_t n = (size_t)op.len - 3;
+      memcpy(value, op.buf + 3, n < sizeof(value) - 1 ? n : sizeof(value) - 1);
+      q.response(cmd, value);
+      break;
+    }
+    case OP_BANNER:   q.banner(); break;
+    case OP_SER2NET:  q.ser2net(op.buf, op.len); break;
+    case OP_TICK:     q.handle(now, t); break;
+  }
+}
+
+// ---- 1 + 2. equivalence ----
+template <uint8_t Capacity>
+static void equivalence(long n, bool wideCodes, const char *label)
+{
+  LegacyQueue<Capacity> legacy;
+  IndexedQueue<Capacity> indexed;
+  uint32_t now = 0xFFFFFFFFu - 600000u;   // wraps through 0 during the run
+  long mismatches = 0, brokenInvariants = 0, sent = 0;
+  unsigned peak = 0;
+  Trace tl, ti;
+  for (long i = 0; i < n; i++) {
+    const Op op = randomOp(wideCodes);
+    now += op.dt;
+    tl.clear(); ti.clear();
+    apply(legacy, op, now, tl);
+    apply(indexed, op, now, ti);
+    std::sort(tl.sent.begin(), tl.sent.end()); std::sort(ti.sent.begin(), ti.sent.end());
+    std::sort(tl.dropped.begin(), tl.dropped.end()); std::sort(ti.dropped.begin(), ti.dropped.end());
+    sent += (long)tl.sent.size();
+    if (indexed.cmdQueue.size() > peak) peak = indexed.cmdQueue.size();
+    const bool same = tl.sent == ti.sent && tl.dropped == ti.dropped && legacy.dump() == indexed.dump();
+    if (!same && mismatches++ < 3) printf("  mismatch at op %ld (kind %d, '%s')\n", i, (int)op.kind, op.buf);
+    if (!indexed.invariantsHold() && brokenInvariants++ < 3) printf("  invariant broken at op %ld\n", i);
+  }
+  char name[96];
+  snprintf(name, sizeof(name), "%s: same queue + sends as legacy (%ld ops)", label, n);
+  check(name, mismatches == 0);
+  snprintf(name, sizeof(name), "%s: heap + code index invariants", label);
+  check(name, brokenInvariants == 0);
+  printf("  commands sent: %ld, peak depth %u/%u\n", sent, peak, (unsigned)Capacity);
+}
+
+// ---- 3. benchmark ----
+template <uint8_t Capacity>
+static void bench(long n)
+{
+  std::vector<Op> ops((size_t)n);
+  for (long i = 0; i < n; i++) ops[(size_t)i] = randomOp(true, true);
+  double legacyNs = 1e18, indexedNs = 1e18;
+  size_t sink = 0;
+  for (int round = 0; round < 3; round++) {
+    LegacyQueue<Capacity> legacy;
+    IndexedQueue<Capacity> indexed;
+    CountTrace t;
+    uint32_t now = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (const Op &op : ops) { now += op.dt; t.clear(); apply(legacy, op, now, t); }
+    auto t1 = std::chrono::steady_clock::now();
+    now = 0;
+    for (const Op &op : ops) { now += op.dt; t.clear(); apply(indexed, op, now, t); }
+    auto t2 = std::chrono::steady_clock::now();
+    sink += t.sent + t.dropped + legacy.cmdQueueSize + indexed.cmdQueue.size();
+    legacyNs  = std::min(legacyNs,  std::chrono::duration<double, std::nano>(t1 - t0).count() / n);
+    indexedNs = std::min(indexedNs, std::chrono::duration<double, std::nano>(t2 - t1).count() / n);
+  }
+  printf("CMDQUEUE_MAX %3u: legacy %7.1f ns/op, indexed %7.1f ns/op (%.1fx)  [%zu]\n",
+         (unsigned)Capacity, legacyNs, indexedNs, legacyNs / indexedNs, sink);
+  if (Capacity >= 100) {
+    char name[96];
+    snprintf(name, sizeof(name), "indexed faster than linear scans at CMDQUEUE_MAX %u", (unsigned)Capacity);
+    check(name, indexedNs < legacyNs);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const long n = (argc > 1) ? atol(argv[1]) : 200000;
+  printf("=== PIC command queue test + benchmark ===\n");
+  equivalence<20>(n, false, "CMDQUEUE_MAX 20, OTGW codes");
+  equivalence<20>(n, true, "CMDQUEUE_MAX 20, any codes");
+  equivalence<4>(n / 4, true, "CMDQUEUE_MAX 4, mostly full");
+  equivalence<200>(n, true, "CMDQUEUE_MAX 200, any codes");
+  bench<20>(n);
+  bench<200>(n);
+  printf("=== %s (failures=%d) ===\n", failures ? "SOME TESTS FAILED" : "ALL TESTS PASSED", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,348 @@
+/**
+ * Host benchmark for HA discovery payload composition (composeAndPublish()
+ * in MQTTHaDiscovery.cpp, TASK-865.7).
+ *
+ * The real MQTTHaDiscovery.cpp is compiled in against tests/stubs/, as in
+ * test_ha_device_discovery.cpp. One "republish" runs every discovery config
+ * the .cpp can compose:
+ *
+ *   - all 389 sensor rows (source-expanded rows once per source) and all
+ *     binary_sensor rows, on the device doAutoConfigureMsgid() gives them;
+ *   - climate (2), SAT switches (13) and select (1), the Toutside override
+ *     number, the ADR-118 override sensors (8), the PIC button and selects (9)
+ *     and four Dallas sensors.
+ *
+ * streamSatZoneDiscovery() lives in MQTTstuff.ino (its own stack buffers) and
+ * is not part of this engine.
+ *
+ * The republish is timed twice: with the scratch arena disabled
+ * (sComposeArenaCap = 0: every payload spills, i.e. the old MEASURE pass +
+ * malloc + WRITE pass) and with the arena. Both runs must publish the
+ * identical stream (topic + payload). Reported per topic: compose passes,
+ * heap allocations and ns. The payload size distribution is reported for the
+ * normal strings and for the longest, most-escaped strings the settings
+ * allow with the full device block on every payload; no per-entity config may
+ * spill in either. Device discovery slots (user-011) are bigger than the arena
+ * and must take the spill path with an unchanged payload.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra -I tests/stubs tests/bench_ha_discovery_compose.cpp -o tests/bench_ha_discovery_compose.out
+ *   ./tests/bench_ha_discovery_compose.out [republishes]
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+// The firmware tables leave trailing fields to zero-initialisation.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#include "../src/OTGW-firmware/MQTTHaDiscovery.cpp"
+#pragma GCC diagnostic pop
+
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+
+// ---- Allocation counter (as in bench_ot_replay.cpp) ----
+static uint64_t g_allocs = 0;
+
+void *operator new(size_t n)
+{
+  g_allocs++;
+  void *p = std::malloc(n ? n : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+#if defined(__GLIBC__)
+extern "C" void *__libc_malloc(size_t);
+extern "C" void *malloc(size_t n)
+{
+  g_allocs++;
+  return __libc_malloc(n);
+}
+#endif
+
+// ---- firmware seams ------------------------------------------------------
+uint32_t hostFreeHeap = 1u << 20;
+uint32_t hostMaxFreeBlock = 1u << 20;
+const char kPicSubtreePrefix[] PROGMEM = "otgw-pic/";   // MQTTstuff.ino
+
+// Sink: FNV-1a over every topic + payload, plus sizes. Recording full
+// payloads is opt-in so the timed loop does not allocate.
+static uint64_t sinkHash = 1469598103934665603ull;
+static uint32_t sinkCount = 0;
+static size_t   sinkMaxPayload = 0;
+static std::vector<size_t> *sinkSizes = nullptr;
+static std::vector<std::string> *sinkPayloads = nullptr;
+
+static void fnv(const void *p, size_t n)
+{
+  const uint8_t *b = static_cast<const uint8_t *>(p);
+  for (size_t i = 0; i < n; i++) { sinkHash ^= b[i]; sinkHash *= 1099511628211ull; }
+}
+
+bool canPublishMQTT() { return true; }
+bool mqttIsConnected() { return true; }
+void feedWatchDog() {}
+void incPublishedTopicCount() {}
+bool mqttPublishRaw(const char *topic, const uint8_t *payload, size_t len, bool)
+{
+  fnv(topic, strlen(topic) + 1);
+  fnv(payload, len);
+  sinkCount++;
+  sinkMaxPayload = std::max(sinkMaxPayload, len);
+  if (sinkSizes) sinkSizes->push_back(len);
+  if (sinkPayloads) sinkPayloads->push_back(std::string(reinterpret_cast<const char *>(payload), len));
+  return true;
+}
+
+static void resetSink()
+{
+  sinkHash = 1469598103934665603ull;
+  sinkCount = 0;
+  sinkMaxPayload = 0;
+}
+
+static int failures = 0;
+
+static void check(const char *name, bool ok)
+{
+  std::printf("%-64s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+// ---------------------------------------------------------------------------
+// Context
+// ---------------------------------------------------------------------------
+struct Strings {
+  std::string nodeId, hostname, pubTopic, subTopic, manufacturer, model;
+};
+
+static Strings normalStrings()
+{
+  return {"otgw-0123456789ab", "OTGW", "OTGW/value/otgw-0123456789ab", "OTGW/set/otgw-0123456789ab",
+          "NodoShop", "OTGW32"};
+}
+
+// Longest values the settings allow (sUniqueid[41], sTopTopic[41],
+// sHostname, sManufacturer/sModel[33]), every byte needing a JSON escape.
+static Strings worstStrings()
+{
+  Strings s;
+  s.nodeId = std::string(40, 'n');
+  s.pubTopic = std::string(40, 't') + "/value/" + s.nodeId;
+  s.subTopic = std::string(40, 't') + "/set/" + s.nodeId;
+  s.hostname = std::string(40, '"');
+  s.manufacturer = std::string(32, '\\');
+  s.model = std::string(32, '"');
+  return s;
+}
+
+static HaDiscoveryContext makeCtx(const Strings &s, bool firstEntity)
+{
+  HaDiscoveryContext ctx{};
+  ctx.nodeId = s.nodeId.c_str();
+  ctx.hostname = s.hostname.c_str();
+  ctx.version = "2.0.0-alpha.354";
+  ctx.mqttPubTopic = s.pubTopic.c_str();
+  ctx.mqttSubTopic = s.subTopic.c_str();
+  ctx.haPrefix = "homeassistant";
+  ctx.manufacturer = s.manufacturer.c_str();
+  ctx.model = s.model.c_str();
+  ctx.isFirstEntity = firstEntity;
+  ctx.legacyMode = false;
+  ctx.separateSources = true;
+  ctx.legacyOtTopics = true;
+  ctx.device = HaDevice::Esp;
+  ctx.otCoreSuffix = PSTR(HA_OTCORE_SUFFIX);
+  ctx.otCoreName = HA_OTCORE_NAME;
+  ctx.sourceSuffix = "";
+  ctx.sourceName = "";
+  ctx.sourceTopicSegment = "";
+  return ctx;
+}
+
+static HaDevice deviceFor(uint8_t id)
+{
+  return id <= 127 ? HaDevice::Boiler : topoDeviceForPseudoId(id);
+}
+
+// ---------------------------------------------------------------------------
+// One full republish of every config the engine composes.
+// ---------------------------------------------------------------------------
+static const struct { uint8_t id; const char *label; } kOverrides[] = {
+  {1, "TSet"}, {8, "TsetCH2"}, {9, "TrOverride"}, {14, "MaxRelModLevelSetting"},
+  {16, "TrSet"}, {39, "TrOverride2"}, {56, "TdhwSet"}, {57, "MaxTSet"},
+};
+static const char *const kDallas[] = {
+  "28FF64D1841703F1", "28FF1A2B3C4D5E6F", "2800000000000000", "28AABBCCDDEEFF00",
+};
+
+static uint32_t republish(HaDiscoveryContext &ctx)
+{
+  uint32_t ok = 0;
+  for (uint16_t i = 0; i < MQTT_HA_SENSOR_COUNT; i++) {
+    MqttHaSensorCfg cfg = readSensorCfg(i);
+    ctx.device = deviceFor(cfg.id);
+    if (cfg.flags & MQTT_HA_FLAG_ANY_SOURCE) ok += expandAndStreamSensorSources(cfg, ctx);
+    else ok += streamSensorDiscovery(cfg, ctx);
+  }
+  for (uint16_t i = 0; i < MQTT_HA_BINSENSOR_COUNT; i++) {
+    MqttHaBinSensorCfg cfg = readBinSensorCfg(i);
+    ctx.device = deviceFor(cfg.id);
+    ok += streamBinarySensorDiscovery(cfg, ctx);
+  }
+  ctx.device = HaDevice::Thermostat;
+  ok += streamClimateDiscovery(0, ctx);
+  ok += streamClimateDiscovery(1, ctx);
+  ok += streamNumberDiscovery(ctx);
+  ctx.device = HaDevice::Sat;
+  for (uint8_t i = 0; i < 13; i++) ok += streamSatSwitchDiscovery(i, ctx);
+  ok += streamSatSelectDiscovery(0, ctx);
+  ctx.device = HaDevice::Gateway;
+  for (const auto &o : kOverrides) ok += streamOverrideSensorDiscovery(ctx, o.id, o.label);
+  ok += streamButtonDiscovery(ctx);
+  for (uint8_t i = 0; i <= 7; i++) ok += streamSelectDiscovery(i, ctx);
+  ctx.device = HaDevice::Sensors;
+  for (const char *a : kDallas) ok += streamDallasSensorDiscovery(a, ctx);
+  return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Timed runs: arena off (legacy two-pass) vs arena on
+// ---------------------------------------------------------------------------
+struct Run {
+  uint64_t hash;
+  uint32_t topics;
+  uint32_t composes;
+  uint32_t spills;
+  uint64_t allocs;
+  double nsPerTopic;
+};
+
+static Run timeRun(size_t arenaCap, int reps)
+{
+  const Strings s = normalStrings();
+  HaDiscoveryContext ctx = makeCtx(s, false);
+  sComposeArenaCap = arenaCap;
+
+  // Warm-up + stream identity.
+  resetSink();
+  sComposeCount = sComposeSpills = 0;
+  const uint64_t a0 = g_allocs;
+  republish(ctx);
+  Run r{sinkHash, sinkCount, sComposeCount, sComposeSpills, g_allocs - a0, 0.0};
+
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) republish(ctx);
+  const auto t1 = std::chrono::steady_clock::now();
+  const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+  r.nsPerTopic = ns / ((double)reps * r.topics);
+  sComposeArenaCap = sizeof(sComposeArena);
+  return r;
+}
+
+static void report(const char *name, const Run &r)
+{
+  // A spilled payload is composed twice (arena/MEASURE, then the buffer).
+  const uint32_t passes = r.composes + r.spills;
+  std::printf("  %-26s %4u topics  %.2f compose passes/topic  %.2f allocs/topic  %7.0f ns/topic\n",
+              name, (unsigned)r.topics, (double)passes / r.topics,
+              (double)r.allocs / r.topics, r.nsPerTopic);
+}
+
+static void testRepublish(int reps)
+{
+  std::printf("--- full republish, %d reps, arena %zu B ---\n", reps, sizeof(sComposeArena));
+  const Run legacy = timeRun(0, reps);
+  const Run arena = timeRun(sizeof(sComposeArena), reps);
+  report("two-pass (arena off):", legacy);
+  report("single-pass (arena):", arena);
+  std::printf("  speedup %.2fx\n", legacy.nsPerTopic / arena.nsPerTopic);
+
+  check("identical publish stream (topics + payloads)", legacy.hash == arena.hash && legacy.topics == arena.topics);
+  check("every config composed and published", arena.topics == arena.composes && arena.topics > 389);
+  check("arena off: every payload spills (legacy baseline)", legacy.spills == legacy.composes);
+  check("arena: one compose pass per payload, no spills", arena.spills == 0);
+  check("arena: no heap allocation on the publish path", arena.allocs == 0);
+}
+
+// ---------------------------------------------------------------------------
+// Payload sizes: normal vs worst-case strings
+// ---------------------------------------------------------------------------
+static void sizeReport(const char *name, bool worst, bool firstEntity)
+{
+  const Strings s = worst ? worstStrings() : normalStrings();
+  HaDiscoveryContext ctx = makeCtx(s, firstEntity);
+  std::vector<size_t> sizes;
+  sizes.reserve(1024);
+  sinkSizes = &sizes;
+  resetSink();
+  sComposeCount = sComposeSpills = 0;
+  republish(ctx);
+  sinkSizes = nullptr;
+  std::sort(sizes.begin(), sizes.end());
+  const size_t n = sizes.size();
+  std::printf("  %-34s p50 %4zu  p99 %4zu  max %4zu B  (%u spills)\n", name,
+              sizes[n / 2], sizes[(n * 99) / 100], sizes[n - 1], (unsigned)sComposeSpills);
+  char label[96];
+  snprintf(label, sizeof(label), "%s: fits the arena", name);
+  check(label, sComposeSpills == 0 && sizes[n - 1] <= sizeof(sComposeArena));
+}
+
+static void testSizes()
+{
+  std::printf("--- payload sizes (arena %zu B) ---\n", sizeof(sComposeArena));
+  sizeReport("normal strings", false, false);
+  sizeReport("normal strings, full dev block", false, true);
+  sizeReport("worst-case strings, full dev block", true, true);
+}
+
+// ---------------------------------------------------------------------------
+// Device discovery slots: bigger than the arena, must spill unchanged
+// ---------------------------------------------------------------------------
+static void testDeviceSpill()
+{
+  std::printf("--- device discovery slots (spill path) ---\n");
+  const Strings s = normalStrings();
+  HaDiscoveryContext ctx = makeCtx(s, false);
+  uint8_t slotOf[256];
+  const uint8_t slots = buildHaDeviceSlots(ctx, slotOf);
+  uint32_t known[8] = {0};
+  for (uint16_t id = 0; id < 256; id++)
+    if (id != 246 && slotOf[id] != HA_DEVICE_SLOT_NONE) known[id >> 5] |= 1UL << (id & 31);
+
+  std::vector<std::string> legacy, arena;
+  for (int pass = 0; pass < 2; pass++) {
+    sComposeArenaCap = pass == 0 ? 0 : sizeof(sComposeArena);
+    sComposeCount = sComposeSpills = 0;
+    sinkPayloads = pass == 0 ? &legacy : &arena;
+    for (uint8_t sl = 0; sl < slots; sl++) streamDeviceDiscovery(sl, slotOf, known, ctx, false);
+  }
+  sinkPayloads = nullptr;
+  const uint32_t spills = sComposeSpills;
+  sComposeArenaCap = sizeof(sComposeArena);
+
+  size_t maxLen = 0;
+  for (const auto &p : arena) maxLen = std::max(maxLen, p.size());
+  std::printf("  %u slots, largest %zu B, %u spills\n", (unsigned)slots, maxLen, (unsigned)spills);
+  check("every slot published, identical with and without the arena",
+        arena.size() == slots && arena == legacy);
+  check("slots that outgrow the arena take the spill path",
+        spills == (uint32_t)std::count_if(arena.begin(), arena.end(),
+                                          [](const std::string &p) { return p.size() > sizeof(sComposeArena); }));
+}
+
+int main(int argc, char **argv)
+{
+  const int reps = (argc > 1) ? std::atoi(argv[1]) : 200;
+  std::printf("=== HA discovery compose benchmark ===\n");
+  testRepublish(reps);
+  testSizes();
+  testDeviceSpill();
+  std::printf("\n%s (%d failure%s)\n", failures ? "FAILED" : "ALL PASSED", failures, failures == 1 ? "" : "s");
+  return failures ? 1 : 0;
+}
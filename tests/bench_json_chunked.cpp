@@ -0,0 +1,401 @@
+/**
+ * Host test + benchmark for the resumable chunked JSON path (jsonEmit.h
+ * JsonEmitCursor, used by restSendChunked() in jsonChunked.h).
+ *
+ * AsyncChunkedResponse asks for the body one TCP window at a time. The old
+ * filler re-ran the emit closure from byte 0 into a windowing sink on every
+ * call (RestChunkWindow, lifted below as the reference), which formats the
+ * whole n-byte body once per window plus a final empty pass: ~n^2/window. JsonEmitCursor skips the ops
+ * that were already delivered and re-formats at most one op per window.
+ *
+ * Emitters below are shaped like the largest REST bodies (field count, key
+ * and value mix, nesting): /v2/settings (~7.3 KB), /v2/device/info,
+ * /v2/debug and /v2/otgw/otmonitor with 16 Dallas sensors.
+ *
+ *   1. Output of the cursor path is byte-identical to single-pass JsonEmit
+ *      for window sizes 1460, 536, 64, 7 and 1.
+ *   2. Bytes serialized per byte delivered at 1460 B windows: legacy vs
+ *      cursor. Fails if the cursor path is above 1.25x for the REST-shaped
+ *      bodies (a single op longer than a window is re-formatted once per
+ *      window it spans; reported separately).
+ *   3. A value that changes text width on every pass (heap counter) still
+ *      yields well-formed JSON through the cursor path.
+ *   4. A string longer than several windows, and depth overflow, stream
+ *      correctly.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/bench_json_chunked.cpp -o tests/bench_json_chunked.out
+ *   ./tests/bench_json_chunked.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// ---- Arduino compatibility stubs (host-only) ----
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+#define PSTR(s) (s)
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper *>(p))
+#define snprintf_P snprintf
+typedef const char *PGM_P;
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t b) = 0;
+  virtual size_t write(const uint8_t *buf, size_t size)
+  {
+    for (size_t i = 0; i < size; i++) write(buf[i]);
+    return size;
+  }
+  size_t print(const char *s) { return write(reinterpret_cast<const uint8_t *>(s), strlen(s)); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(const __FlashStringHelper *s) { return print(reinterpret_cast<const char *>(s)); }
+};
+
+class String {
+public:
+  String(const char *s = "") : _s(s) {}
+  const char *c_str() const { return _s.c_str(); }
+private:
+  std::string _s;
+};
+
+#include "../src/OTGW-firmware/jsonEmit.h"
+
+static int failures = 0;
+
+static void check(const char *name, bool ok)
+{
+  printf("%-60s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+// ---- Sinks ----
+struct StringSink : public Print {
+  std::string s;
+  size_t write(uint8_t b) override { s.push_back((char)b); return 1; }
+  using Print::write;
+};
+
+// Lifted: the pre-cursor RestChunkWindow from jsonChunked.h.
+class RestChunkWindow : public Print {
+public:
+  RestChunkWindow(uint8_t *out, size_t cap, size_t winStart)
+    : _out(out), _cap(cap), _start(winStart), _pos(0), _written(0) {}
+  size_t write(uint8_t b) override {
+    if (_pos >= _start && _written < _cap) _out[_written++] = b;
+    _pos++;
+    return 1;
+  }
+  using Print::write;
+  size_t written() const { return _written; }
+  size_t pos() const { return _pos; }
+private:
+  uint8_t *_out;
+  size_t _cap, _start, _pos, _written;
+};
+
+// ---- Emitters shaped like the big REST bodies ----
+static uint32_t g_pass = 0;   // bumped per closure run; used by the volatile test
+
+static void emitSettings(JsonEmit &je)
+{
+  je.beginObject();
+  je.beginObject(F("settings"));
+  char key[32], val[48];
+  for (int i = 0; i < 132; i++) {
+    snprintf(key, sizeof(key), "setting_%03d_name", i);
+    je.beginObject(key);
+    switch (i % 4) {
+      case 0: snprintf(val, sizeof(val), "value-%d-\"quoted\"", i); je.field(F("value"), (const char *)val); break;
+      case 1: je.field(F("value"), (int32_t)(i * 37)); break;
+      case 2: je.field(F("value"), (i & 8) != 0); break;
+      default: je.field(F("value"), (float)i / 7.0f, 3); break;
+    }
+    je.field(F("type"), F("s"));
+    je.field(F("maxlen"), (int32_t)32);
+    je.endObject();
+  }
+  je.endObject();
+  je.endObject();
+}
+
+static void emitDeviceInfo(JsonEmit &je)
+{
+  je.beginObject();
+  je.beginObject(F("device"));
+  je.field(F("author"), F("Robert van den Breemen"));
+  je.field(F("fwversion"), F("2.0.0-alpha.354+abcdef0"));
+  char key[32];
+  for (int g = 0; g < 8; g++) {
+    snprintf(key, sizeof(key), "group_%d", g);
+    je.beginObject(key);
+    for (int i = 0; i < 14; i++) {
+      snprintf(key, sizeof(key), "metric_%d_%d", g, i);
+      if (i % 3 == 0) je.field(key, (uint32_t)(123456u * (i + 1)));
+      else if (i % 3 == 1) je.field(key, F("some descriptive text value"));
+      else je.field(key, -12.5f + (float)i);
+    }
+    je.endObject();
+  }
+  je.beginArray(F("wifi_networks"));
+  for (int i = 0; i < 10; i++) je.value(F("ssid-with-some-length"));
+  je.endArray();
+  je.endObject();
+  je.endObject();
+}
+
+static void emitDebugDump(JsonEmit &je)
+{
+  je.beginObject();
+  je.beginObject(F("debug"));
+  char key[48];
+  for (int i = 0; i < 160; i++) {
+    snprintf(key, sizeof(key), "state.section%d.field_%d", i / 20, i);
+    if (i & 1) je.field(key, (uint32_t)(i * 1000003u));
+    else je.field(key, (i & 2) != 0);
+  }
+  je.endObject();
+  je.endObject();
+}
+
+static void emitOtmonitor(JsonEmit &je)
+{
+  je.beginObject();
+  je.beginObject(F("otmonitor"));
+  char name[24];
+  for (int i = 0; i < 38; i++) {
+    snprintf(name, sizeof(name), "otvalue%02d", i);
+    je.beginObject(name);
+    if (i < 18) je.field(F("value"), (i & 1) ? "On" : "Off");
+    else je.field(F("value"), 20.0f + (float)i / 16.0f);
+    je.field(F("unit"), F("°C"));
+    je.field(F("epoch"), (uint32_t)(1760000000u + i));
+    je.endObject();
+  }
+  for (int i = 0; i < 16; i++) {
+    snprintf(name, sizeof(name), "28FF641E8216C3%02X", i);
+    je.beginObject(name);
+    je.field(F("value"), 18.25f + (float)i);
+    je.field(F("unit"), F("°C"));
+    je.field(F("type"), F("dallas"));
+    je.field(F("epoch"), (uint32_t)(1760000000u + i));
+    je.endObject();
+  }
+  je.endObject();
+  je.endObject();
+}
+
+typedef void (*EmitFn)(JsonEmit &);
+
+static std::string singlePass(EmitFn fn)
+{
+  StringSink sink;
+  JsonEmit je(sink);
+  fn(je);
+  return sink.s;
+}
+
+struct StreamResult { std::string body; uint64_t serialized; };
+
+static StreamResult streamLegacy(EmitFn fn, size_t window)
+{
+  StreamResult r { std::string(), 0 };
+  std::string buf(window, '\0');
+  for (;;) {
+    RestChunkWindow win(reinterpret_cast<uint8_t *>(&buf[0]), window, r.body.size());
+    JsonEmit je(win);
+    fn(je);
+    r.serialized += win.pos();
+    if (win.written() == 0) break;
+    r.body.append(buf.data(), win.written());
+  }
+  return r;
+}
+
+static StreamResult streamCursor(EmitFn fn, size_t window)
+{
+  StreamResult r { std::string(), 0 };
+  JsonEmitCursor cur;
+  std::string buf(window, '\0');
+  for (;;) {
+    const size_t n = cur.fill(reinterpret_cast<uint8_t *>(&buf[0]), window, fn);
+    if (n == 0) break;
+    r.body.append(buf.data(), n);
+  }
+  r.serialized = cur.serialized();
+  if (cur.delivered() != r.body.size()) r.serialized = 100 * r.body.size();   // bookkeeping mismatch -> fails ratio
+  return r;
+}
+
+// Minimal JSON well-formedness checker (objects, arrays, strings, literals, numbers).
+struct JsonCheck {
+  const char *p, *end;
+  void ws() { while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++; }
+  bool str() {
+    if (p >= end || *p != '"') return false;
+    for (p++; p < end; p++) {
+      if (*p == '\\') { p++; continue; }
+      if (*p == '"') { p++; return true; }
+    }
+    return false;
+  }
+  bool val() {
+    ws();
+    if (p >= end) return false;
+    if (*p == '{') {
+      p++; ws();
+      if (p < end && *p == '}') { p++; return true; }
+      for (;;) {
+        ws(); if (!str()) return false;
+        ws(); if (p >= end || *p++ != ':') return false;
+        if (!val()) return false;
+        ws(); if (p >= end) return false;
+        if (*p == ',') { p++; continue; }
+        if (*p == '}') { p++; return true; }
+        return false;
+      }
+    }
+    if (*p == '[') {
+      p++; ws();
+      if (p < end && *p == ']') { p++; return true; }
+      for (;;) {
+        if (!val()) return false;
+        ws(); if (p >= end) return false;
+        if (*p == ',') { p++; continue; }
+        if (*p == ']') { p++; return true; }
+        return false;
+      }
+    }
+    if (*p == '"') return str();
+    const char *s = p;
+    while (p < end && (isalnum((unsigned char)*p) || *p == '-' || *p == '+' || *p == '.')) p++;
+    return p > s;
+  }
+  static bool ok(const std::string &s) {
+    JsonCheck c { s.data(), s.data() + s.size() };
+    if (!c.val()) return false;
+    c.ws();
+    return c.p == c.end;
+  }
+};
+
+// ---- 3. volatile width ----
+static void emitVolatile(JsonEmit &je)
+{
+  g_pass++;
+  je.beginObject();
+  je.beginObject(F("runtime"));
+  char key[24];
+  for (int i = 0; i < 60; i++) {
+    snprintf(key, sizeof(key), "heap_%02d", i);
+    // 9 -> 10 -> 100 ... digits: text width grows as passes go by.
+    je.field(key, (uint32_t)(g_pass * g_pass * g_pass * 97u));
+  }
+  je.endObject();
+  je.endObject();
+}
+
+// ---- 4. long string + depth overflow ----
+static void emitLongString(JsonEmit &je)
+{
+  static std::string big;
+  if (big.empty()) {
+    for (int i = 0; i < 5000; i++) big.push_back((i % 97 == 0) ? '"' : (char)('a' + i % 26));
+  }
+  je.beginObject();
+  je.field(F("before"), (int32_t)1);
+  je.field(F("blob"), big.c_str());
+  je.beginArray(F("deep"));
+  for (int i = 0; i < 12; i++) je.beginArray();      // exceeds MAX_DEPTH: dropped but balanced
+  je.value((int32_t)42);
+  for (int i = 0; i < 12; i++) je.endArray();
+  je.endArray();
+  je.field(F("after"), true);
+  je.endObject();
+}
+
+int main()
+{
+  printf("=== Resumable chunked JSON (JsonEmitCursor) ===\n");
+  struct Body { const char *name; EmitFn fn; };
+  const Body bodies[] = {
+    { "settings",      emitSettings },
+    { "device/info",   emitDeviceInfo },
+    { "debug",         emitDebugDump },
+    { "otmonitor",     emitOtmonitor },
+    { "long-string",   emitLongString },
+  };
+  const size_t windows[] = { 1460, 536, 64, 7, 1 };
+
+  // 1. byte-identical output
+  for (const Body &b : bodies) {
+    const std::string ref = singlePass(b.fn);
+    bool same = JsonCheck::ok(ref);
+    for (size_t w : windows) same = same && (streamCursor(b.fn, w).body == ref);
+    char name[96];
+    snprintf(name, sizeof(name), "%-12s %6zu B identical for windows 1460..1", b.name, ref.size());
+    check(name, same);
+  }
+
+  // 2. bytes serialized per byte delivered @1460
+  printf("\n%-12s %8s %14s %14s\n", "body", "bytes", "legacy ser/dlv", "cursor ser/dlv");
+  for (const Body &b : bodies) {
+    const StreamResult legacy = streamLegacy(b.fn, 1460);
+    const StreamResult cursor = streamCursor(b.fn, 1460);
+    const double lr = (double)legacy.serialized / (double)legacy.body.size();
+    const double cr = (double)cursor.serialized / (double)cursor.body.size();
+    printf("%-12s %8zu %13.2fx %13.2fx\n", b.name, cursor.body.size(), lr, cr);
+    // An op larger than a window (long-string: one 5 KB value) is re-formatted
+    // for every window it spans; the REST bodies have no such op.
+    const bool singleOpBody = (b.fn == emitLongString);
+    char name[96];
+    snprintf(name, sizeof(name), "%-12s cursor %s serialized/delivered", b.name,
+             singleOpBody ? "< legacy" : "<= 1.25x");
+    check(name, (singleOpBody ? cr < lr : cr <= 1.25) && legacy.body == cursor.body);
+  }
+
+  // Timing on the largest body (informational).
+  {
+    const int reps = 2000;
+    auto t0 = std::chrono::steady_clock::now();
+    size_t sink = 0;
+    for (int i = 0; i < reps; i++) sink += streamLegacy(emitSettings, 1460).body.size();
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < reps; i++) sink += streamCursor(emitSettings, 1460).body.size();
+    auto t2 = std::chrono::steady_clock::now();
+    printf("settings @1460: legacy %.1f us/response, cursor %.1f us/response (%zu)\n\n",
+           std::chrono::duration<double, std::micro>(t1 - t0).count() / reps,
+           std::chrono::duration<double, std::micro>(t2 - t1).count() / reps, sink % 10);
+  }
+
+  // 3. volatile width between windows
+  {
+    g_pass = 0;
+    const StreamResult cur = streamCursor(emitVolatile, 64);
+    check("volatile value width: cursor output is well-formed JSON", JsonCheck::ok(cur.body));
+    g_pass = 0;
+    const StreamResult old = streamLegacy(emitVolatile, 64);
+    printf("  (legacy windowing on the same closure: %s)\n",
+           JsonCheck::ok(old.body) ? "well-formed" : "corrupt JSON, as documented");
+  }
+
+  // 4. empty response and zero-length window
+  {
+    JsonEmitCursor cur;
+    uint8_t b[8];
+    auto none = [](JsonEmit &) {};
+    check("empty closure ends immediately", cur.fill(b, sizeof(b), none) == 0);
+    JsonEmitCursor cur2;
+    check("maxLen 0 returns 0", cur2.fill(b, 0, emitOtmonitor) == 0);
+  }
+
+  printf("=== %s (failures=%d) ===\n", failures ? "SOME TESTS FAILED" : "ALL TESTS PASSED", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,632 @@
+/**
+ * Host test + benchmark for the compile-time message-id dispatch table
+ * (OTDispatch.h).
+ *
+ * OTDispatch[] replaced the six decodeAndPublish*Value() switches that
+ * decodeAndPublishOTValue() tried in turn, and the getOTGWValue() switch
+ * behind REST /api/v2/otgw/messages/{id} and /label. This test includes the real header,
+ * lifts the legacy switches verbatim and the new table path from
+ * OTGW-Core.ino, and replaces every print_* decoder with a stub that records
+ * which decoder ran on which OTcurrentSystemState field:
+ *
+ *   1. For all 256 message ids the table calls the same decoder on the same
+ *      field as the legacy chain, and "Unknown message" ids stay unknown.
+ *   2. getOTGWValue() returns the same string for ids -1..256 with the state
+ *      filled with distinct values.
+ *   3. The status-gate and id>127 flags used by shouldPublishMQTTForID()
+ *      match the id tests they replaced.
+ *   4. Benchmark: ns/frame for both dispatch paths over the message ids of
+ *      a captured PIC log (tests/fixtures/otgw_replay.log), and over random
+ *      ids, where the legacy chain pays up to six switches per unknown id.
+ *
+ * The static_asserts in OTDispatch.h (OTmap[] row order, decoder vs OTmap[]
+ * type, decoder vs field type, duplicate rows) are checked by compiling this
+ * file.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/bench_ot_dispatch.cpp -o tests/bench_ot_dispatch.out
+ *   ./tests/bench_ot_dispatch.out [passes]
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/OTGW-firmware/OTDispatch.h"
+
+#define PSTR(s) (s)
+#define strncpy_P strncpy
+#define PROGMEM_readAnything(src, dest) memcpy(&(dest), (src), sizeof(dest))
+
+static OTdataStruct OTcurrentSystemState;
+
+static int failures = 0;
+
+static void check(const char *name, bool ok)
+{
+  printf("%-60s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+// Arduino dtostrf(value, 0, prec, buf): minimum width 0, fixed notation.
+static char *dtostrf(double v, int width, unsigned int prec, char *buf)
+{
+  sprintf(buf, "%*.*f", width, (int)prec, v);
+  return buf;
+}
+
+// ---- print_* stubs: remember the last decoder and field ----
+static uint8_t lastKind = OTDEC_NONE;
+static const void *lastField = nullptr;
+static uint32_t decodeCount = 0;
+
+static inline void record(uint8_t kind, const void *field)
+{
+  lastKind = kind;
+  lastField = field;
+  decodeCount++;
+}
+
+void print_f88(float &v) { record(OTDEC_F88, &v); }
+void print_s16(int16_t &v) { record(OTDEC_S16, &v); }
+void print_s8s8(uint16_t &v) { record(OTDEC_S8S8, &v); }
+void print_u16(uint16_t &v) { record(OTDEC_U16, &v); }
+void print_u8u8(uint16_t &v) { record(OTDEC_U8U8, &v); }
+void print_u8_hb(uint16_t &v) { record(OTDEC_U8_HB, &v); }
+void print_u8_lb(uint16_t &v) { record(OTDEC_U8_LB, &v); }
+void print_flag8u8(uint16_t &v) { record(OTDEC_FLAG8U8, &v); }
+void print_status(uint16_t &v) { record(OTDEC_STATUS, &v); }
+void print_statusVH(uint16_t &v) { record(OTDEC_STATUS_VH, &v); }
+void print_ASFflags(uint16_t &v) { record(OTDEC_ASF_FLAGS, &v); }
+void print_RBPflags(uint16_t &v) { record(OTDEC_RBP_FLAGS, &v); }
+void print_mastermemberid(uint16_t &v) { record(OTDEC_MASTER_MEMBERID, &v); }
+void print_slavememberid(uint16_t &v) { record(OTDEC_SLAVE_MEMBERID, &v); }
+void print_command(uint16_t &v) { record(OTDEC_COMMAND, &v); }
+void print_date(uint16_t &v) { record(OTDEC_DATE, &v); }
+void print_daytime(uint16_t &v) { record(OTDEC_DAYTIME, &v); }
+void print_remoteoverridefunction(uint16_t &v) { record(OTDEC_REMOTE_OVERRIDE_FN, &v); }
+void print_vh_configmemberid(uint16_t &v) { record(OTDEC_VH_CONFIG_MEMBERID, &v); }
+void print_vh_remoteparametersetting(uint16_t &v) { record(OTDEC_VH_REMOTE_PARAM, &v); }
+void print_rf_sensor_status_information(uint16_t &v) { record(OTDEC_RF_SENSOR, &v); }
+void print_remote_override_operating_mode(uint16_t &v) { record(OTDEC_OPERATING_MODE, &v); }
+void print_solar_storage_status(uint16_t &v) { record(OTDEC_SOLAR_STATUS, &v); }
+void print_solarstorage_slavememberid(uint16_t &v) { record(OTDEC_SOLAR_SLAVE_MEMBERID, &v); }
+
+// ---- Legacy path (OTGW-Core.ino before OTDispatch.h) ----
+static bool decodeAndPublishStatusAndConfigValue(OTLibMessageID msgId)
+{
+  switch (msgId) {
+    case OT_Statusflags:                            print_status(OTcurrentSystemState.Statusflags); return true;
+    case OT_ASFflags:                               print_ASFflags(OTcurrentSystemState.ASFflags); return true;
+    case OT_MasterConfigMemberIDcode:               print_mastermemberid(OTcurrentSystemState.MasterConfigMemberIDcode); return true;
+    case OT_SlaveConfigMemberIDcode:                print_slavememberid(OTcurrentSystemState.SlaveConfigMemberIDcode); return true;
+    case OT_Command:                                print_command(OTcurrentSystemState.Command );  return true;
+    case OT_RBPflags:                               print_RBPflags(OTcurrentSystemState.RBPflags); return true;
+    case OT_TSP:                                    print_u8u8(OTcurrentSystemState.TSP); return true;
+    case OT_TSPindexTSPvalue:                       print_u8u8(OTcurrentSystemState.TSPindexTSPvalue); return true;
+    case OT_FHBsize:                                print_u8u8(OTcurrentSystemState.FHBsize); return true;
+    case OT_FHBindexFHBvalue:                       print_u8u8(OTcurrentSystemState.FHBindexFHBvalue); return true;
+    case OT_MaxCapacityMinModLevel:                 print_u8u8(OTcurrentSystemState.MaxCapacityMinModLevel); return true;
+    case OT_Date:                                   print_date(OTcurrentSystemState.Date); return true;
+    case OT_Year:                                   print_u16(OTcurrentSystemState.Year); return true;
+    case OT_TdhwSetUBTdhwSetLB:                     print_s8s8(OTcurrentSystemState.TdhwSetUBTdhwSetLB ); return true;
+    case OT_MaxTSetUBMaxTSetLB:                     print_s8s8(OTcurrentSystemState.MaxTSetUBMaxTSetLB); return true;
+    case OT_HcratioUBHcratioLB:                     print_s8s8(OTcurrentSystemState.HcratioUBHcratioLB); return true;
+    case OT_Remoteparameter4boundaries:             print_s8s8(OTcurrentSystemState.Remoteparameter4boundaries); return true;
+    case OT_Remoteparameter5boundaries:             print_s8s8(OTcurrentSystemState.Remoteparameter5boundaries); return true;
+    case OT_Remoteparameter6boundaries:             print_s8s8(OTcurrentSystemState.Remoteparameter6boundaries); return true;
+    case OT_Remoteparameter7boundaries:             print_s8s8(OTcurrentSystemState.Remoteparameter7boundaries); return true;
+    case OT_Remoteparameter8boundaries:             print_s8s8(OTcurrentSystemState.Remoteparameter8boundaries); return true;
+    case OT_RemoteOverrideFunction:                 print_remoteoverridefunction(OTcurrentSystemState.RemoteOverrideFunction); return true;
+    case OT_OEMDiagnosticCode:                      print_u16(OTcurrentSystemState.OEMDiagnosticCode); return true;
+    case OT_OpenThermVersionMaster:                 print_f88(OTcurrentSystemState.OpenThermVersionMaster); return true;
+    case OT_OpenThermVersionSlave:                  print_f88(OTcurrentSystemState.OpenThermVersionSlave); return true;
+    case OT_MasterVersion:                          print_u8u8(OTcurrentSystemState.MasterVersion ); return true;
+    case OT_SlaveVersion:                           print_u8u8(OTcurrentSystemState.SlaveVersion); return true;
+    case OT_Brand:                                  print_u8u8(OTcurrentSystemState.Brand); return true;
+    case OT_BrandVersion:                           print_u8u8(OTcurrentSystemState.BrandVersion); return true;
+    case OT_BrandSerialNumber:                      print_u8u8(OTcurrentSystemState.BrandSerialNumber); return true;
+    default:
+      return false;
+  }
+}
+
+static bool decodeAndPublishTemperatureAndSensorValue(OTLibMessageID msgId)
+{
+  switch (msgId) {
+    case OT_TSet:                                   print_f88(OTcurrentSystemState.TSet); return true;
+    case OT_CoolingControl:                         print_f88(OTcurrentSystemState.CoolingControl); return true;
+    case OT_TsetCH2:                                print_f88(OTcurrentSystemState.TsetCH2); return true;
+    case OT_TrOverride:                             print_f88(OTcurrentSystemState.TrOverride); return true;
+    case OT_MaxRelModLevelSetting:                  print_f88(OTcurrentSystemState.MaxRelModLevelSetting); return true;
+    case OT_TrSet:                                  print_f88(OTcurrentSystemState.TrSet); return true;
+    case OT_TrSetCH2:                               print_f88(OTcurrentSystemState.TrSetCH2); return true;
+    case OT_RelModLevel:                            print_f88(OTcurrentSystemState.RelModLevel); return true;
+    case OT_CHPressure:                             print_f88(OTcurrentSystemState.CHPressure); return true;
+    case OT_DHWFlowRate:                            print_f88(OTcurrentSystemState.DHWFlowRate); return true;
+    case OT_Tr:                                     print_f88(OTcurrentSystemState.Tr); return true;
+    case OT_Tboiler:                                print_f88(OTcurrentSystemState.Tboiler);return true;
+    case OT_Tdhw:                                   print_f88(OTcurrentSystemState.Tdhw); return true;
+    case OT_Toutside:                               print_f88(OTcurrentSystemState.Toutside); return true;
+    case OT_Tret:                                   print_f88(OTcurrentSystemState.Tret); return true;
+    case OT_Tsolarstorage:                          print_f88(OTcurrentSystemState.Tsolarstorage); return true;
+    case OT_Tsolarcollector:                        print_s16(OTcurrentSystemState.Tsolarcollector); return true;
+    case OT_TflowCH2:                               print_f88(OTcurrentSystemState.TflowCH2); return true;
+    case OT_Tdhw2:                                  print_f88(OTcurrentSystemState.Tdhw2 ); return true;
+    case OT_Texhaust:                               print_s16(OTcurrentSystemState.Texhaust); return true;
+    case OT_Theatexchanger:                         print_f88(OTcurrentSystemState.Theatexchanger); return true;
+    case OT_TdhwSet:                                print_f88(OTcurrentSystemState.TdhwSet); return true;
+    case OT_MaxTSet:                                print_f88(OTcurrentSystemState.MaxTSet); return true;
+    case OT_Hcratio:                                print_f88(OTcurrentSystemState.Hcratio); return true;
+    case OT_Remoteparameter4:                       print_f88(OTcurrentSystemState.Remoteparameter4); return true;
+    case OT_Remoteparameter5:                       print_f88(OTcurrentSystemState.Remoteparameter5); return true;
+    case OT_Remoteparameter6:                       print_f88(OTcurrentSystemState.Remoteparameter6); return true;
+    case OT_Remoteparameter7:                       print_f88(OTcurrentSystemState.Remoteparameter7); return true;
+    case OT_Remoteparameter8:                       print_f88(OTcurrentSystemState.Remoteparameter8); return true;
+    case OT_BurnerStarts:                           print_u16(OTcurrentSystemState.BurnerStarts); return true;
+    case OT_CHPumpStarts:                           print_u16(OTcurrentSystemState.CHPumpStarts); return true;
+    case OT_DHWPumpValveStarts:                     print_u16(OTcurrentSystemState.DHWPumpValveStarts); return true;
+    case OT_DHWBurnerStarts:                        print_u16(OTcurrentSystemState.DHWBurnerStarts); return true;
+    case OT_BurnerOperationHours:                   print_u16(OTcurrentSystemState.BurnerOperationHours); return true;
+    case OT_CHPumpOperationHours:                   print_u16(OTcurrentSystemState.CHPumpOperationHours); return true;
+    case OT_DHWPumpValveOperationHours:             print_u16(OTcurrentSystemState.DHWPumpValveOperationHours); return true;
+    case OT_DHWBurnerOperationHours:                print_u16(OTcurrentSystemState.DHWBurnerOperationHours); return true;
+    case OT_FanSpeed:                               print_u8u8(OTcurrentSystemState.FanSpeed); return true;
+    case OT_ElectricalCurrentBurnerFlame:           print_f88(OTcurrentSystemState.ElectricalCurrentBurnerFlame); return true;
+    case OT_TRoomCH2:                               print_f88(OTcurrentSystemState.TRoomCH2); return true;
+    case OT_RelativeHumidity:                       print_f88(OTcurrentSystemState.RelativeHumidity); return true;
+    case OT_TrOverride2:                            print_f88(OTcurrentSystemState.TrOverride2); return true;
+    case OT_CoolingOperationHours:                  print_u16(OTcurrentSystemState.CoolingOperationHours); return true;
+    case OT_PowerCycles:                            print_u16(OTcurrentSystemState.PowerCycles); return true;
+    case OT_ElectricityProducerStarts:              print_u16(OTcurrentSystemState.ElectricityProducerStarts); return true;
+    case OT_ElectricityProducerHours:               print_u16(OTcurrentSystemState.ElectricityProducerHours); return true;
+    case OT_ElectricityProduction:                  print_u16(OTcurrentSystemState.ElectricityProduction); return true;
+    case OT_CumulativeElectricityProduction:        print_u16(OTcurrentSystemState.CumulativeElectricityProduction); return true;
+    case OT_BurnerUnsuccessfulStarts:               print_u16(OTcurrentSystemState.BurnerUnsuccessfulStarts); return true;
+    case OT_FlameSignalTooLow:                      print_u16(OTcurrentSystemState.FlameSignalTooLow); return true;
+    default:
+      return false;
+  }
+}
+
+static bool decodeAndPublishVentilationValue(OTLibMessageID msgId)
+{
+  switch (msgId) {
+    case OT_StatusVH:                               print_statusVH(OTcurrentSystemState.StatusVH); return true;
+    case OT_ControlSetpointVH:                      print_u8_lb(OTcurrentSystemState.ControlSetpointVH); return true;
+    case OT_ASFFaultCodeVH:                         print_flag8u8(OTcurrentSystemState.ASFFaultCodeVH); return true;
+    case OT_DiagnosticCodeVH:                       print_u16(OTcurrentSystemState.DiagnosticCodeVH); return true;
+    case OT_ConfigMemberIDVH:                       print_vh_configmemberid(OTcurrentSystemState.ConfigMemberIDVH); return true;
+    case OT_OpenthermVersionVH:                     print_f88(OTcurrentSystemState.OpenthermVersionVH); return true;
+    case OT_VersionTypeVH:                          print_u8u8(OTcurrentSystemState.VersionTypeVH ); return true;
+    case OT_RelativeVentilation:                    print_u8_lb(OTcurrentSystemState.RelativeVentilation); return true;
+    case OT_RelativeHumidityExhaustAir:             print_u8_lb(OTcurrentSystemState.RelativeHumidityExhaustAir); return true;
+    case OT_CO2LevelExhaustAir:                     print_u16(OTcurrentSystemState.CO2LevelExhaustAir); return true;
+    case OT_SupplyInletTemperature:                 print_f88(OTcurrentSystemState.SupplyInletTemperature); return true;
+    case OT_SupplyOutletTemperature:                print_f88(OTcurrentSystemState.SupplyOutletTemperature); return true;
+    case OT_ExhaustInletTemperature:                print_f88(OTcurrentSystemState.ExhaustInletTemperature); return true;
+    case OT_ExhaustOutletTemperature:               print_f88(OTcurrentSystemState.ExhaustOutletTemperature); return true;
+    case OT_ActualExhaustFanSpeed:                  print_u16(OTcurrentSystemState.ActualExhaustFanSpeed); return true;
+    case OT_ActualSupplyFanSpeed:                   print_u16(OTcurrentSystemState.ActualSupplyFanSpeed); return true;
+    case OT_RemoteParameterSettingVH:               print_vh_remoteparametersetting(OTcurrentSystemState.RemoteParameterSettingVH); return true;
+    case OT_NominalVentilationValue:                print_u8_hb(OTcurrentSystemState.NominalVentilationValue); return true;
+    case OT_TSPNumberVH:                            print_u8u8(OTcurrentSystemState.TSPNumberVH); return true;
+    case OT_TSPEntryVH:                             print_u8u8(OTcurrentSystemState.TSPEntryVH); return true;
+    case OT_FaultBufferSizeVH:                      print_u8u8(OTcurrentSystemState.FaultBufferSizeVH); return true;
+    case OT_FaultBufferEntryVH:                     print_u8u8(OTcurrentSystemState.FaultBufferEntryVH); return true;
+    default:
+      return false;
+  }
+}
+
+static bool decodeAndPublishSpecialValue(OTLibMessageID msgId)
+{
+  switch (msgId) {
+    case OT_DayTime:                                print_daytime(OTcurrentSystemState.DayTime); return true;
+    case OT_RFstrengthbatterylevel:                 print_rf_sensor_status_information(OTcurrentSystemState.RFstrengthbatterylevel); return true;
+    case OT_OperatingMode_HC1_HC2_DHW:              print_remote_override_operating_mode(OTcurrentSystemState.OperatingMode_HC1_HC2_DHW ); return true;
+    default:
+      return false;
+  }
+}
+
+static bool decodeAndPublishSolarStorageValue(OTLibMessageID msgId)
+{
+  switch (msgId) {
+    case OT_SolarStorageMaster:                     print_solar_storage_status(OTcurrentSystemState.SolarStorageStatus ); return true;
+    case OT_SolarStorageASFflags:                   print_flag8u8(OTcurrentSystemState.SolarStorageASFflags); return true;
+    case OT_SolarStorageSlaveConfigMemberIDcode:    print_solarstorage_slavememberid(OTcurrentSystemState.SolarStorageSlaveConfigMemberIDcode); return true;
+    case OT_SolarStorageVersionType:                print_u8u8(OTcurrentSystemState.SolarStorageVersionType); return true;
+    case OT_SolarStorageTSP:                        print_u8u8(OTcurrentSystemState.SolarStorageTSP ); return true;
+    case OT_SolarStorageTSPindexTSPvalue:           print_u8u8(OTcurrentSystemState.SolarStorageTSPindexTSPvalue ); return true;
+    case OT_SolarStorageFHBsize:                    print_u8u8(OTcurrentSystemState.SolarStorageFHBsize ); return true;
+    case OT_SolarStorageFHBindexFHBvalue:           print_u8u8(OTcurrentSystemState.SolarStorageFHBindexFHBvalue ); return true;
+    default:
+      return false;
+  }
+}
+
+static bool decodeAndPublishVendorValue(OTLibMessageID msgId)
+{
+  switch (msgId) {
+    case OT_RemehadFdUcodes:                        print_u8u8(OTcurrentSystemState.RemehadFdUcodes); return true;
+    case OT_RemehaServicemessage:                   print_u8u8(OTcurrentSystemState.RemehaServicemessage); return true;
+    case OT_RemehaDetectionConnectedSCU:            print_u8u8(OTcurrentSystemState.RemehaDetectionConnectedSCU); return true;
+    default:
+      return false;
+  }
+}
+
+static bool legacyDispatch(uint8_t id)
+{
+  const OTLibMessageID msgId = static_cast<OTLibMessageID>(id);
+
+  if (decodeAndPublishStatusAndConfigValue(msgId)) return true;
+  if (decodeAndPublishTemperatureAndSensorValue(msgId)) return true;
+  if (decodeAndPublishVentilationValue(msgId)) return true;
+  if (decodeAndPublishSpecialValue(msgId)) return true;
+  if (decodeAndPublishSolarStorageValue(msgId)) return true;
+  if (decodeAndPublishVendorValue(msgId)) return true;
+  return false;
+}
+
+static const char* legacyGetOTGWValue(int msgid)
+{
+  static char buffer[32];
+  
+  switch (static_cast<OTLibMessageID>(msgid)) { 
+    case OT_TSet:                              dtostrf(OTcurrentSystemState.TSet, 0, 2, buffer); return buffer;
+    case OT_CoolingControl:                    dtostrf(OTcurrentSystemState.CoolingControl, 0, 2, buffer); return buffer;
+    case OT_TsetCH2:                           dtostrf(OTcurrentSystemState.TsetCH2, 0, 2, buffer); return buffer;
+    case OT_TrOverride:                        dtostrf(OTcurrentSystemState.TrOverride, 0, 2, buffer); return buffer;
+    case OT_TrOverride2:                       dtostrf(OTcurrentSystemState.TrOverride2, 0, 2, buffer); return buffer;
+    case OT_MaxRelModLevelSetting:             dtostrf(OTcurrentSystemState.MaxRelModLevelSetting, 0, 2, buffer); return buffer;
+    case OT_TrSet:                             dtostrf(OTcurrentSystemState.TrSet, 0, 2, buffer); return buffer;
+    case OT_TrSetCH2:                          dtostrf(OTcurrentSystemState.TrSetCH2, 0, 2, buffer); return buffer;
+    case OT_RelModLevel:                       dtostrf(OTcurrentSystemState.RelModLevel, 0, 2, buffer); return buffer;
+    case OT_CHPressure:                        dtostrf(OTcurrentSystemState.CHPressure, 0, 2, buffer); return buffer;
+    case OT_DHWFlowRate:                       dtostrf(OTcurrentSystemState.DHWFlowRate, 0, 2, buffer); return buffer;
+    case OT_Tr:                                dtostrf(OTcurrentSystemState.Tr, 0, 2, buffer); return buffer;
+    case OT_Tboiler:                           dtostrf(OTcurrentSystemState.Tboiler, 0, 2, buffer); return buffer;
+    case OT_Tdhw:                              dtostrf(OTcurrentSystemState.Tdhw, 0, 2, buffer); return buffer;
+    case OT_Toutside:                          dtostrf(OTcurrentSystemState.Toutside, 0, 2, buffer); return buffer;
+    case OT_Tret:                              dtostrf(OTcurrentSystemState.Tret, 0, 2, buffer); return buffer;
+    case OT_Tsolarstorage:                     dtostrf(OTcurrentSystemState.Tsolarstorage, 0, 2, buffer); return buffer;
+    case OT_Tsolarcollector:                   dtostrf(OTcurrentSystemState.Tsolarcollector, 0, 2, buffer); return buffer;
+    case OT_TflowCH2:                          dtostrf(OTcurrentSystemState.TflowCH2, 0, 2, buffer); return buffer;
+    case OT_Tdhw2:                             dtostrf(OTcurrentSystemState.Tdhw2, 0, 2, buffer); return buffer;
+    case OT_Texhaust:                          dtostrf(OTcurrentSystemState.Texhaust, 0, 2, buffer); return buffer;
+    case OT_Theatexchanger:                    dtostrf(OTcurrentSystemState.Theatexchanger, 0, 2, buffer); return buffer;
+    case OT_TdhwSet:                           dtostrf(OTcurrentSystemState.TdhwSet, 0, 2, buffer); return buffer;
+    case OT_MaxTSet:                           dtostrf(OTcurrentSystemState.MaxTSet, 0, 2, buffer); return buffer;
+    case OT_Hcratio:                           dtostrf(OTcurrentSystemState.Hcratio, 0, 2, buffer); return buffer;
+    case OT_Remoteparameter4:                  dtostrf(OTcurrentSystemState.Remoteparameter4, 0, 2, buffer); return buffer;
+    case OT_Remoteparameter5:                  dtostrf(OTcurrentSystemState.Remoteparameter5, 0, 2, buffer); return buffer;
+    case OT_Remoteparameter6:                  dtostrf(OTcurrentSystemState.Remoteparameter6, 0, 2, buffer); return buffer;
+    case OT_Remoteparameter7:                  dtostrf(OTcurrentSystemState.Remoteparameter7, 0, 2, buffer); return buffer;
+    case OT_Remoteparameter8:                  dtostrf(OTcurrentSystemState.Remoteparameter8, 0, 2, buffer); return buffer;
+    case OT_OpenThermVersionMaster:            dtostrf(OTcurrentSystemState.OpenThermVersionMaster, 0, 2, buffer); return buffer;
+    case OT_OpenThermVersionSlave:             dtostrf(OTcurrentSystemState.OpenThermVersionSlave, 0, 2, buffer); return buffer;
+    case OT_Statusflags:                       dtostrf(OTcurrentSystemState.Statusflags, 0, 2, buffer); return buffer;
+    case OT_ASFflags:                          dtostrf(OTcurrentSystemState.ASFflags, 0, 2, buffer); return buffer;
+    case OT_MasterConfigMemberIDcode:          dtostrf(OTcurrentSystemState.MasterConfigMemberIDcode, 0, 2, buffer); return buffer;
+    case OT_SlaveConfigMemberIDcode:           dtostrf(OTcurrentSystemState.SlaveConfigMemberIDcode, 0, 2, buffer); return buffer;
+    case OT_Command:                           dtostrf(OTcurrentSystemState.Command, 0, 2, buffer); return buffer;
+    case OT_RBPflags:                          dtostrf(OTcurrentSystemState.RBPflags, 0, 2, buffer); return buffer;
+    case OT_TSP:                               dtostrf(OTcurrentSystemState.TSP, 0, 2, buffer); return buffer;
+    case OT_TSPindexTSPvalue:                  dtostrf(OTcurrentSystemState.TSPindexTSPvalue, 0, 2, buffer); return buffer;
+    case OT_FHBsize:                           dtostrf(OTcurrentSystemState.FHBsize, 0, 2, buffer); return buffer;
+    case OT_FHBindexFHBvalue:                  dtostrf(OTcurrentSystemState.FHBindexFHBvalue, 0, 2, buffer); return buffer;
+    case OT_MaxCapacityMinModLevel:            dtostrf(OTcurrentSystemState.MaxCapacityMinModLevel, 0, 2, buffer); return buffer;
+    case OT_DayTime:                           dtostrf(OTcurrentSystemState.DayTime, 0, 2, buffer); return buffer;
+    case OT_Date:                              dtostrf(OTcurrentSystemState.Date, 0, 2, buffer); return buffer;
+    case OT_Year:                              dtostrf(OTcurrentSystemState.Year, 0, 2, buffer); return buffer;
+    case OT_TdhwSetUBTdhwSetLB:                dtostrf(OTcurrentSystemState.TdhwSetUBTdhwSetLB, 0, 2, buffer); return buffer;
+    case OT_MaxTSetUBMaxTSetLB:                dtostrf(OTcurrentSystemState.MaxTSetUBMaxTSetLB, 0, 2, buffer); return buffer;
+    case OT_HcratioUBHcratioLB:                dtostrf(OTcurrentSystemState.HcratioUBHcratioLB, 0, 2, buffer); return buffer;
+    case OT_Remoteparameter4boundaries:        dtostrf(OTcurrentSystemState.Remoteparameter4boundaries, 0, 2, buffer); return buffer;
+    case OT_Remoteparameter5boundaries:        dtostrf(OTcurrentSystemState.Remoteparameter5boundaries, 0, 2, buffer); return buffer;
+    case OT_Remoteparameter6boundaries:        dtostrf(OTcurrentSystemState.Remoteparameter6boundaries, 0, 2, buffer); return buffer;
+    case OT_Remoteparameter7boundaries:        dtostrf(OTcurrentSystemState.Remoteparameter7boundaries, 0, 2, buffer); return buffer;
+    case OT_Remoteparameter8boundaries:        dtostrf(OTcurrentSystemState.Remoteparameter8boundaries, 0, 2, buffer); return buffer;
+    case OT_RemoteOverrideFunction:            dtostrf(OTcurrentSystemState.RemoteOverrideFunction, 0, 2, buffer); return buffer;
+    case OT_OEMDiagnosticCode:                 dtostrf(OTcurrentSystemState.OEMDiagnosticCode, 0, 2, buffer); return buffer;
+    case OT_BurnerStarts:                      dtostrf(OTcurrentSystemState.BurnerStarts, 0, 2, buffer); return buffer;
+    case OT_CHPumpStarts:                      dtostrf(OTcurrentSystemState.CHPumpStarts, 0, 2, buffer); return buffer;
+    case OT_DHWPumpValveStarts:                dtostrf(OTcurrentSystemState.DHWPumpValveStarts, 0, 2, buffer); return buffer;
+    case OT_DHWBurnerStarts:                   dtostrf(OTcurrentSystemState.DHWBurnerStarts, 0, 2, buffer); return buffer;
+    case OT_BurnerOperationHours:              dtostrf(OTcurrentSystemState.BurnerOperationHours, 0, 2, buffer); return buffer;
+    case OT_CHPumpOperationHours:              dtostrf(OTcurrentSystemState.CHPumpOperationHours, 0, 2, buffer); return buffer;
+    case OT_DHWPumpValveOperationHours:        dtostrf(OTcurrentSystemState.DHWPumpValveOperationHours, 0, 2, buffer); return buffer;
+    case OT_DHWBurnerOperationHours:           dtostrf(OTcurrentSystemState.DHWBurnerOperationHours, 0, 2, buffer); return buffer;
+    case OT_Brand:                             dtostrf(OTcurrentSystemState.Brand, 0, 2, buffer); return buffer;
+    case OT_BrandVersion:                      dtostrf(OTcurrentSystemState.BrandVersion, 0, 2, buffer); return buffer;
+    case OT_BrandSerialNumber:                 dtostrf(OTcurrentSystemState.BrandSerialNumber, 0, 2, buffer); return buffer;
+    case OT_CoolingOperationHours:             dtostrf(OTcurrentSystemState.CoolingOperationHours, 0, 2, buffer); return buffer;
+    case OT_PowerCycles:                       dtostrf(OTcurrentSystemState.PowerCycles, 0, 2, buffer); return buffer;
+    case OT_MasterVersion:                     dtostrf(OTcurrentSystemState.MasterVersion, 0, 2, buffer); return buffer;
+    case OT_SlaveVersion:                      dtostrf(OTcurrentSystemState.SlaveVersion, 0, 2, buffer); return buffer;
+    case OT_StatusVH:                          dtostrf(OTcurrentSystemState.StatusVH, 0, 2, buffer); return buffer;
+    case OT_ControlSetpointVH:                 dtostrf(OTcurrentSystemState.ControlSetpointVH, 0, 2, buffer); return buffer;
+    case OT_ASFFaultCodeVH:                    dtostrf(OTcurrentSystemState.ASFFaultCodeVH, 0, 2, buffer); return buffer;
+    case OT_DiagnosticCodeVH:                  dtostrf(OTcurrentSystemState.DiagnosticCodeVH, 0, 2, buffer); return buffer;
+    case OT_ConfigMemberIDVH:                  dtostrf(OTcurrentSystemState.ConfigMemberIDVH, 0, 2, buffer); return buffer;
+    case OT_OpenthermVersionVH:                dtostrf(OTcurrentSystemState.OpenthermVersionVH, 0, 2, buffer); return buffer;
+    case OT_VersionTypeVH:                     dtostrf(OTcurrentSystemState.VersionTypeVH, 0, 2, buffer); return buffer;
+    case OT_RelativeVentilation:               dtostrf(OTcurrentSystemState.RelativeVentilation, 0, 2, buffer); return buffer;
+    case OT_RelativeHumidityExhaustAir:        dtostrf(OTcurrentSystemState.RelativeHumidityExhaustAir, 0, 2, buffer); return buffer;
+    case OT_CO2LevelExhaustAir:                dtostrf(OTcurrentSystemState.CO2LevelExhaustAir, 0, 2, buffer); return buffer;
+    case OT_SupplyInletTemperature:            dtostrf(OTcurrentSystemState.SupplyInletTemperature, 0, 2, buffer); return buffer;
+    case OT_SupplyOutletTemperature:           dtostrf(OTcurrentSystemState.SupplyOutletTemperature, 0, 2, buffer); return buffer;
+    case OT_ExhaustInletTemperature:           dtostrf(OTcurrentSystemState.ExhaustInletTemperature, 0, 2, buffer); return buffer;
+    case OT_ExhaustOutletTemperature:          dtostrf(OTcurrentSystemState.ExhaustOutletTemperature, 0, 2, buffer); return buffer;
+    case OT_ActualExhaustFanSpeed:             dtostrf(OTcurrentSystemState.ActualExhaustFanSpeed, 0, 2, buffer); return buffer;
+    case OT_ActualSupplyFanSpeed:              dtostrf(OTcurrentSystemState.ActualSupplyFanSpeed, 0, 2, buffer); return buffer;
+    case OT_RemoteParameterSettingVH:          dtostrf(OTcurrentSystemState.RemoteParameterSettingVH, 0, 2, buffer); return buffer;
+    case OT_NominalVentilationValue:           dtostrf(OTcurrentSystemState.NominalVentilationValue, 0, 2, buffer); return buffer;
+    case OT_TSPNumberVH:                       dtostrf(OTcurrentSystemState.TSPNumberVH, 0, 2, buffer); return buffer;
+    case OT_TSPEntryVH:                        dtostrf(OTcurrentSystemState.TSPEntryVH, 0, 2, buffer); return buffer;
+    case OT_FaultBufferSizeVH:                 dtostrf(OTcurrentSystemState.FaultBufferSizeVH, 0, 2, buffer); return buffer;
+    case OT_FaultBufferEntryVH:                dtostrf(OTcurrentSystemState.FaultBufferEntryVH, 0, 2, buffer); return buffer;
+    case OT_FanSpeed:                          dtostrf(OTcurrentSystemState.FanSpeed, 0, 2, buffer); return buffer;
+    case OT_ElectricalCurrentBurnerFlame:      dtostrf(OTcurrentSystemState.ElectricalCurrentBurnerFlame, 0, 2, buffer); return buffer;
+    case OT_TRoomCH2:                          dtostrf(OTcurrentSystemState.TRoomCH2, 0, 2, buffer); return buffer;
+    case OT_RelativeHumidity:                  dtostrf(OTcurrentSystemState.RelativeHumidity, 0, 2, buffer); return buffer;
+    case OT_RFstrengthbatterylevel:            dtostrf(OTcurrentSystemState.RFstrengthbatterylevel, 0, 2, buffer); return buffer;
+    case OT_OperatingMode_HC1_HC2_DHW:         dtostrf(OTcurrentSystemState.OperatingMode_HC1_HC2_DHW, 0, 2, buffer); return buffer;
+    case OT_ElectricityProducerStarts:         dtostrf(OTcurrentSystemState.ElectricityProducerStarts, 0, 2, buffer); return buffer;
+    case OT_ElectricityProducerHours:          dtostrf(OTcurrentSystemState.ElectricityProducerHours, 0, 2, buffer); return buffer;
+    case OT_ElectricityProduction:             dtostrf(OTcurrentSystemState.ElectricityProduction, 0, 2, buffer); return buffer;
+    case OT_CumulativeElectricityProduction:   dtostrf(OTcurrentSystemState.CumulativeElectricityProduction, 0, 2, buffer); return buffer;
+    case OT_BurnerUnsuccessfulStarts:          dtostrf(OTcurrentSystemState.BurnerUnsuccessfulStarts, 0, 2, buffer); return buffer;
+    case OT_FlameSignalTooLow:                 dtostrf(OTcurrentSystemState.FlameSignalTooLow, 0, 2, buffer); return buffer;
+    case OT_RemehadFdUcodes:                   dtostrf(OTcurrentSystemState.RemehadFdUcodes, 0, 2, buffer); return buffer;
+    case OT_RemehaServicemessage:              dtostrf(OTcurrentSystemState.RemehaServicemessage, 0, 2, buffer); return buffer;
+    case OT_RemehaDetectionConnectedSCU:       dtostrf(OTcurrentSystemState.RemehaDetectionConnectedSCU, 0, 2, buffer); return buffer;
+    case OT_SolarStorageMaster:                dtostrf(OTcurrentSystemState.SolarStorageStatus, 0, 2, buffer); return buffer;
+    case OT_SolarStorageASFflags:              dtostrf(OTcurrentSystemState.SolarStorageASFflags, 0, 2, buffer); return buffer;
+    case OT_SolarStorageSlaveConfigMemberIDcode:  dtostrf(OTcurrentSystemState.SolarStorageSlaveConfigMemberIDcode, 0, 2, buffer); return buffer;
+    case OT_SolarStorageVersionType:           dtostrf(OTcurrentSystemState.SolarStorageVersionType, 0, 2, buffer); return buffer;
+    case OT_SolarStorageTSP:                   dtostrf(OTcurrentSystemState.SolarStorageTSP, 0, 2, buffer); return buffer;
+    case OT_SolarStorageTSPindexTSPvalue:      dtostrf(OTcurrentSystemState.SolarStorageTSPindexTSPvalue, 0, 2, buffer); return buffer;
+    case OT_SolarStorageFHBsize:               dtostrf(OTcurrentSystemState.SolarStorageFHBsize, 0, 2, buffer); return buffer;
+    case OT_SolarStorageFHBindexFHBvalue:      dtostrf(OTcurrentSystemState.SolarStorageFHBindexFHBvalue, 0, 2, buffer); return buffer;
+    default: 
+      strncpy_P(buffer, PSTR("Error: not implemented yet!\r\n"), sizeof(buffer) - 1);
+      buffer[sizeof(buffer) - 1] = '\0';
+      return buffer;
+  } // switch
+} // legacyGetOTGWValue
+
+// ---- Table path (OTGW-Core.ino) ----
+typedef void (*OTDecodeFn)(void *field);
+
+static void otDecF88(void *f)                 { print_f88(*static_cast<float *>(f)); }
+static void otDecS16(void *f)                 { print_s16(*static_cast<int16_t *>(f)); }
+static void otDecS8S8(void *f)                { print_s8s8(*static_cast<uint16_t *>(f)); }
+static void otDecU16(void *f)                 { print_u16(*static_cast<uint16_t *>(f)); }
+static void otDecU8U8(void *f)                { print_u8u8(*static_cast<uint16_t *>(f)); }
+static void otDecU8Hb(void *f)                { print_u8_hb(*static_cast<uint16_t *>(f)); }
+static void otDecU8Lb(void *f)                { print_u8_lb(*static_cast<uint16_t *>(f)); }
+static void otDecFlag8U8(void *f)             { print_flag8u8(*static_cast<uint16_t *>(f)); }
+static void otDecStatus(void *f)              { print_status(*static_cast<uint16_t *>(f)); }
+static void otDecStatusVH(void *f)            { print_statusVH(*static_cast<uint16_t *>(f)); }
+static void otDecASFflags(void *f)            { print_ASFflags(*static_cast<uint16_t *>(f)); }
+static void otDecRBPflags(void *f)            { print_RBPflags(*static_cast<uint16_t *>(f)); }
+static void otDecMasterMemberId(void *f)      { print_mastermemberid(*static_cast<uint16_t *>(f)); }
+static void otDecSlaveMemberId(void *f)       { print_slavememberid(*static_cast<uint16_t *>(f)); }
+static void otDecCommand(void *f)             { print_command(*static_cast<uint16_t *>(f)); }
+static void otDecDate(void *f)                { print_date(*static_cast<uint16_t *>(f)); }
+static void otDecDaytime(void *f)             { print_daytime(*static_cast<uint16_t *>(f)); }
+static void otDecRemoteOverrideFn(void *f)    { print_remoteoverridefunction(*static_cast<uint16_t *>(f)); }
+static void otDecVHConfigMemberId(void *f)    { print_vh_configmemberid(*static_cast<uint16_t *>(f)); }
+static void otDecVHRemoteParam(void *f)       { print_vh_remoteparametersetting(*static_cast<uint16_t *>(f)); }
+static void otDecRFSensor(void *f)            { print_rf_sensor_status_information(*static_cast<uint16_t *>(f)); }
+static void otDecOperatingMode(void *f)       { print_remote_override_operating_mode(*static_cast<uint16_t *>(f)); }
+static void otDecSolarStatus(void *f)         { print_solar_storage_status(*static_cast<uint16_t *>(f)); }
+static void otDecSolarSlaveMemberId(void *f)  { print_solarstorage_slavememberid(*static_cast<uint16_t *>(f)); }
+
+static const OTDecodeFn otDecoders[] = {
+  nullptr,                                // OTDEC_NONE
+  otDecF88,
+  otDecS16,
+  otDecS8S8,
+  otDecU16,
+  otDecU8U8,
+  otDecU8Hb,
+  otDecU8Lb,
+  otDecFlag8U8,
+  otDecStatus,
+  otDecStatusVH,
+  otDecASFflags,
+  otDecRBPflags,
+  otDecMasterMemberId,
+  otDecSlaveMemberId,
+  otDecCommand,
+  otDecDate,
+  otDecDaytime,
+  otDecRemoteOverrideFn,
+  otDecVHConfigMemberId,
+  otDecVHRemoteParam,
+  otDecRFSensor,
+  otDecOperatingMode,
+  otDecSolarStatus,
+  otDecSolarSlaveMemberId,
+};
+static_assert(sizeof(otDecoders) / sizeof(otDecoders[0]) == OTDEC_COUNT,
+              "otDecoders[] must have one entry per OTDecodeKind, in enum order");
+
+static inline void *otDispatchField(const OTDispatchEntry &d)
+{
+  return reinterpret_cast<uint8_t *>(&OTcurrentSystemState) + d.offset;
+}
+
+static bool tableDispatch(uint8_t id)
+{
+  OTDispatchEntry d;
+  PROGMEM_readAnything(&OTDispatch.e[id], d);
+  if (d.flags & OTD_FLAG_DEFINED) {
+    otDecoders[d.decoder](otDispatchField(d));
+    return true;
+  }
+  return false;
+}
+
+static const char* tableGetOTGWValue(int msgid)
+{
+  static char buffer[32];
+
+  if (msgid >= 0 && msgid < OTD_TABLE_SIZE) {
+    OTDispatchEntry d;
+    PROGMEM_readAnything(&OTDispatch.e[msgid], d);
+    if (d.flags & OTD_FLAG_DEFINED) {
+      const void *field = otDispatchField(d);
+      double v;
+      switch (d.fieldKind) {
+        case OTFIELD_FLOAT: v = *static_cast<const float *>(field);    break;
+        case OTFIELD_S16:   v = *static_cast<const int16_t *>(field);  break;
+        default:            v = *static_cast<const uint16_t *>(field); break;
+      }
+      dtostrf(v, 0, 2, buffer);
+      return buffer;
+    }
+  }
+  strncpy_P(buffer, PSTR("Error: not implemented yet!\r\n"), sizeof(buffer) - 1);
+  buffer[sizeof(buffer) - 1] = '\0';
+  return buffer;
+} // tableGetOTGWValue
+
+// ---- 1. Same decoder on the same field ----
+static void testDispatch()
+{
+  int mismatches = 0, defined = 0;
+  for (int id = 0; id < OTD_TABLE_SIZE; id++) {
+    lastKind = OTDEC_NONE; lastField = nullptr;
+    const bool lOk = legacyDispatch((uint8_t)id);
+    const uint8_t lKind = lastKind; const void *lField = lastField;
+    lastKind = OTDEC_NONE; lastField = nullptr;
+    const bool tOk = tableDispatch((uint8_t)id);
+    if (lOk != tOk || lKind != lastKind || lField != lastField) {
+      if (mismatches < 10) printf("  id %d: legacy %d/%u/%p table %d/%u/%p\n", id,
+                                  lOk, lKind, lField, tOk, lastKind, lastField);
+      mismatches++;
+    }
+    if (tOk) defined++;
+  }
+  printf("  %d of %d ids have a decoder\n", defined, OTD_TABLE_SIZE);
+  check("table decoder + field == legacy switches (ids 0..255)", mismatches == 0);
+  check("every OTD_ROW reachable", defined == (int)(sizeof(OTDispatchRows) / sizeof(OTDispatchRows[0])));
+}
+
+// ---- 2. getOTGWValue() strings ----
+static void testGetValue()
+{
+  // Distinct, non-trivial values in every field: floats with fractions,
+  // negative int16_t, u16 above 0x7FFF.
+  uint8_t *base = reinterpret_cast<uint8_t *>(&OTcurrentSystemState);
+  for (const OTDispatchRow &r : OTDispatchRows) {
+    void *f = base + r.offset;
+    if (r.fieldKind == OTFIELD_FLOAT)      *static_cast<float *>(f)    = -12.5f + r.id * 0.39f;
+    else if (r.fieldKind == OTFIELD_S16)   *static_cast<int16_t *>(f)  = (int16_t)(-300 + r.id * 7);
+    else                                   *static_cast<uint16_t *>(f) = (uint16_t)(0x8000 + r.id * 131);
+  }
+  int mismatches = 0;
+  for (int id = -1; id <= OTD_TABLE_SIZE; id++) {
+    const std::string l = legacyGetOTGWValue(id);
+    const std::string t = tableGetOTGWValue(id);
+    if (l != t) {
+      if (mismatches < 10) printf("  id %d: legacy \"%s\" table \"%s\"\n", id, l.c_str(), t.c_str());
+      mismatches++;
+    }
+  }
+  check("getOTGWValue() == legacy for ids -1..256", mismatches == 0);
+}
+
+// ---- 3. MQTT gate flags ----
+static void testGateFlags()
+{
+  int wrong = 0;
+  for (int id = 0; id < OTD_TABLE_SIZE; id++) {
+    const uint8_t f = OTDispatch.e[id].flags;
+    const bool status = (id == OT_Statusflags || id == OT_StatusVH);
+    if (((f & OTD_FLAG_STATUS_GATE) != 0) != status) wrong++;
+    if (((f & OTD_FLAG_UNTRACKED) != 0) != (id > 127)) wrong++;
+    if (id <= OT_MSGID_MAX && OTDispatch.e[id].type != OTmap[id].type) wrong++;
+  }
+  check("status-gate / id>127 flags and OTmap[] type per id", wrong == 0);
+}
+
+// ---- 4. Benchmark ----
+static std::vector<uint8_t> loadReplayIds(const char *path)
+{
+  std::vector<uint8_t> ids;
+  FILE *fp = fopen(path, "r");
+  if (!fp) return ids;
+  char line[128];
+  while (fgets(line, sizeof(line), fp)) {
+    size_t len = strcspn(line, "\r\n");
+    if (len != 9 || !strchr("TBARE", line[0]) || line[2] == ':') continue;
+    char *end = nullptr;
+    const unsigned long v = strtoul(line + 1, &end, 16);
+    if (end != line + 9) continue;
+    ids.push_back((uint8_t)(v >> 16));
+  }
+  fclose(fp);
+  return ids;
+}
+
+typedef bool (*DispatchFn)(uint8_t);
+
+static double timeDispatch(DispatchFn fn, const std::vector<uint8_t> &ids, int passes)
+{
+  const auto t0 = std::chrono::steady_clock::now();
+  uint32_t hits = 0;
+  for (int p = 0; p < passes; p++) {
+    for (uint8_t id : ids) hits += fn(id);
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  if (hits == 0xFFFFFFFFu) printf("(unreachable)\n");
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)ids.size() * passes);
+}
+
+static void bench(int passes)
+{
+  std::vector<uint8_t> replay = loadReplayIds("tests/fixtures/otgw_replay.log");
+  if (replay.empty()) replay = loadReplayIds("fixtures/otgw_replay.log");
+  check("replay capture has OT frames", !replay.empty());
+  if (replay.empty()) return;
+
+  std::vector<uint8_t> random(4096);
+  std::mt19937 rng(42);
+  for (uint8_t &id : random) id = (uint8_t)rng();
+
+  const double lr = timeDispatch(legacyDispatch, replay, passes);
+  const double tr = timeDispatch(tableDispatch, replay, passes);
+  const int randomPasses = passes * (int)replay.size() / (int)random.size() + 1;
+  const double lx = timeDispatch(legacyDispatch, random, randomPasses);
+  const double tx = timeDispatch(tableDispatch, random, randomPasses);
+  printf("  replay (%zu frames x %d): legacy %.2f ns/frame, table %.2f ns/frame (%.1fx)\n",
+         replay.size(), passes, lr, tr, lr / tr);
+  printf("  random ids             : legacy %.2f ns/frame, table %.2f ns/frame (%.1fx)\n",
+         lx, tx, lx / tx);
+  printf("  table: %zu bytes, %zu rows, %d decoders\n",
+         sizeof(OTDispatch), sizeof(OTDispatchRows) / sizeof(OTDispatchRows[0]), OTDEC_COUNT - 1);
+}
+
+int main(int argc, char **argv)
+{
+  const int passes = (argc > 1) ? atoi(argv[1]) : 20000;
+  testDispatch();
+  testGetValue();
+  testGateFlags();
+  bench(passes > 0 ? passes : 1);
+  printf(failures ? "FAILED\n" : "ALL PASSED\n");
+  return failures ? 1 : 0;
+}
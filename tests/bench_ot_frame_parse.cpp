@@ -0,0 +1,209 @@
+/**
+ * Host fuzz test + benchmark for otParseFrame() (OTFrameParse.h).
+ *
+ * otParseFrame() replaced the isvalidotmsg() + sscanf(buf+1, "%8x") pair at
+ * the top of processOT(). This test includes the real header and compares
+ * it against the legacy path (lifted verbatim below) on millions of
+ * synthetic lines:
+ *
+ *   1. Valid frames (random 32-bit value, random TBARE prefix, upper and
+ *      lower case hex): value, type, id, HB/LB must equal the legacy
+ *      shift-split of the sscanf value; parity must equal a bit-count.
+ *   2. Mutated frames (random byte flips, length changes, ':' in slot 2,
+ *      PIC responses like "PR: A=..."): whenever the legacy path rejects the
+ *      line, otParseFrame() must reject it too. Where the legacy path
+ *      accepted a non-hex payload (sscanf stops at the first non-hex digit,
+ *      skips leading blanks, takes "+", "-" and "0x"), the new parser returns
+ *      OT_FRAME_BAD_HEX; those are counted and reported, not failed.
+ *   3. Benchmark: ns/frame for both paths on the same valid-frame stream.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/bench_ot_frame_parse.cpp -o tests/bench_ot_frame_parse.out
+ *   ./tests/bench_ot_frame_parse.out [frames]
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../src/OTGW-firmware/OTFrameParse.h"
+
+static int failures = 0;
+
+static void check(const char *name, bool ok)
+{
+  printf("%-52s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+// ---- Legacy path (OTGW-Core.ino before OTFrameParse.h) ----
+static bool isvalidotmsg(const char *buf, int len)
+{
+  bool _ret = (len == 9);
+  _ret &= (buf[2] != ':');
+  char c = buf[0];
+  _ret &= (c == 'T' || c == 'B' || c == 'A' || c == 'R' || c == 'E');
+  return _ret;
+}
+
+struct LegacyResult { bool frame; bool parsed; uint32_t value; };
+
+static LegacyResult legacyParse(const char *buf, int len)
+{
+  LegacyResult r { false, false, 0 };
+  if (!isvalidotmsg(buf, len)) return r;
+  r.frame = true;
+  unsigned int value = 0;
+  r.parsed = (sscanf(buf + 1, "%8x", &value) == 1);
+  r.value = value;
+  return r;
+}
+
+// ---- Deterministic PRNG (xorshift64*) ----
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+static inline uint32_t rnd()
+{
+  g_rng ^= g_rng >> 12; g_rng ^= g_rng << 25; g_rng ^= g_rng >> 27;
+  return (uint32_t)((g_rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static const char kPrefix[5] = { 'T', 'B', 'A', 'R', 'E' };
+
+static void makeFrame(char *buf, uint32_t v, bool lower)
+{
+  snprintf(buf, 10, lower ? "%c%08x" : "%c%08X", kPrefix[rnd() % 5], v);
+}
+
+static uint8_t expectedSource(char c)
+{
+  switch (c) {
+    case 'B': return OT_RAW_SRC_BOILER;
+    case 'T': return OT_RAW_SRC_THERMOSTAT;
+    case 'A': return OT_RAW_SRC_ANSWER;
+    case 'R': return OT_RAW_SRC_REQUEST;
+    case 'E': return OT_RAW_SRC_PARITY;
+    default:  return OT_RAW_SRC_NONE;
+  }
+}
+
+static int popcount32(uint32_t v) { int n = 0; while (v) { n += v & 1u; v >>= 1; } return n; }
+
+// ---- 1. valid frames ----
+static void fuzzValid(long n)
+{
+  long mismatches = 0;
+  char buf[16];
+  for (long i = 0; i < n; i++) {
+    const uint32_t v = rnd();
+    makeFrame(buf, v, (i & 1) != 0);
+    OTRawFrame f;
+    const OTFrameParseResult pr = otParseFrame(buf, 9, f);
+    const LegacyResult lr = legacyParse(buf, 9);
+    bool ok = pr == OT_FRAME_OK && lr.frame && lr.parsed && f.value == lr.value && f.value == v;
+    ok = ok && f.type == ((lr.value >> 28) & 0x7) && f.masterslave == ((f.type >> 2) & 0x1);
+    ok = ok && f.id == ((lr.value >> 16) & 0xFF) && f.valueHB == ((lr.value >> 8) & 0xFF);
+    ok = ok && f.valueLB == (lr.value & 0xFF) && f.parityOk == ((popcount32(v) & 1) == 0);
+    ok = ok && f.source == expectedSource(buf[0]);
+    if (!ok && mismatches++ < 3) printf("  valid mismatch: %s\n", buf);
+  }
+  char name[64];
+  snprintf(name, sizeof(name), "valid frames agree with sscanf (%ld)", n);
+  check(name, mismatches == 0);
+}
+
+// ---- 2. mutated / non-frame lines ----
+static void fuzzMutated(long n)
+{
+  long mismatches = 0, legacyLenient = 0, rejectedBoth = 0;
+  char buf[16];
+  for (long i = 0; i < n; i++) {
+    makeFrame(buf, rnd(), false);
+    int len = 9;
+    switch (rnd() % 6) {
+      case 0: buf[1 + rnd() % 8] = (char)(rnd() & 0xFF); break;       // any byte in payload
+      case 1: buf[1 + rnd() % 8] = " +-xXgG:\r\n"[rnd() % 10]; break;  // sscanf-interesting bytes
+      case 2: buf[0] = (char)(rnd() & 0xFF); break;                    // prefix
+      case 3: buf[2] = ':'; break;                                     // command response shape
+      case 4: len = (int)(rnd() % 12); break;                          // wrong length
+      default: buf[1] = '0'; buf[2] = 'x'; break;                      // "0x" prefix
+    }
+    if (buf[1 + rnd() % 8] == '\0') buf[1] = '0';   // keep strlen >= len for sscanf
+    OTRawFrame f;
+    const OTFrameParseResult pr = otParseFrame(buf, len, f);
+    const LegacyResult lr = legacyParse(buf, len);
+
+    bool ok;
+    if (!lr.frame) {
+      ok = (pr == OT_FRAME_NOT_FRAME);
+      rejectedBoth += ok;
+    } else if (pr == OT_FRAME_OK) {
+      ok = lr.parsed && lr.value == f.value;
+    } else if (pr == OT_FRAME_BAD_HEX) {
+      ok = true;
+      if (lr.parsed) legacyLenient++; else rejectedBoth++;
+    } else {
+      ok = false;   // legacy saw a frame, new parser did not
+    }
+    if (!ok && mismatches++ < 3) printf("  mutated mismatch: len=%d '%.9s'\n", len, buf);
+  }
+
+  // Lines the PIC actually prints that must not be taken as frames.
+  const char *pic[] = { "PR: A=OpenTherm Gateway 6.6", "PS: 0", "Error 01", "TT: 20.50",
+                        "OT: 0", "T0000010", "T000001000", "BB: 00:00" };
+  for (const char *l : pic) {
+    OTRawFrame f;
+    if (otParseFrame(l, (int)strlen(l), f) != OT_FRAME_NOT_FRAME && mismatches++ < 6)
+      printf("  PIC line taken as frame: %s\n", l);
+  }
+
+  char name[64];
+  snprintf(name, sizeof(name), "mutated lines never accepted wrongly (%ld)", n);
+  check(name, mismatches == 0);
+  printf("  rejected by both: %ld, sscanf-lenient now BAD_HEX: %ld\n", rejectedBoth, legacyLenient);
+}
+
+// ---- 3. benchmark ----
+static void bench(long n)
+{
+  std::vector<char> frames((size_t)n * 10);
+  for (long i = 0; i < n; i++) makeFrame(&frames[(size_t)i * 10], rnd(), false);
+
+  volatile uint32_t sink = 0;
+  double legacyNs = 1e18, newNs = 1e18;
+  for (int round = 0; round < 3; round++) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < n; i++) {
+      const LegacyResult r = legacyParse(&frames[(size_t)i * 10], 9);
+      sink = sink + r.value;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (long i = 0; i < n; i++) {
+      OTRawFrame f;
+      if (otParseFrame(&frames[(size_t)i * 10], 9, f) == OT_FRAME_OK) sink = sink + f.value + f.parityOk;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    const double l = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+    const double c = std::chrono::duration<double, std::nano>(t2 - t1).count() / n;
+    if (l < legacyNs) legacyNs = l;
+    if (c < newNs) newNs = c;
+  }
+  (void)sink;
+  printf("isvalidotmsg + sscanf : %6.1f ns/frame\n", legacyNs);
+  printf("otParseFrame (+parity): %6.1f ns/frame (%.1fx)\n", newNs, legacyNs / newNs);
+  check("otParseFrame faster than sscanf path", newNs < legacyNs);
+}
+
+int main(int argc, char **argv)
+{
+  const long n = (argc > 1) ? atol(argv[1]) : 2000000;
+  printf("=== OT frame parser fuzz + benchmark ===\n");
+  fuzzValid(n);
+  fuzzMutated(n);
+  bench(n);
+  printf("=== %s (failures=%d) ===\n", failures ? "SOME TESTS FAILED" : "ALL TESTS PASSED", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+/**
+ * Host test + micro-benchmark for the OT log timestamp engine (OTLogTimestamp.h).
+ *
+ * getOTLogTimestamp() runs once per OT frame. It used to resolve the zone and
+ * build a ZonedDateTime on every call; it now keeps the UTC offset cached
+ * until the next DST transition and formats with integer arithmetic only.
+ *
+ * The firmware's zone lookup is AceTime, which does not build on the host.
+ * Here glibc plays that role: TZ is set to a POSIX rule string (no tzdata
+ * files needed) and localtime_r()/tm_gmtoff is the offsetAt() callback.
+ *
+ *   1. Correctness: for several zones, every timestamp across two years
+ *      (plus each transition second +/-1) formats identically to
+ *      localtime_r + "%02d:%02d:%02d.%06lu", and the zone is re-resolved
+ *      only a handful of times.
+ *   2. Benchmark: legacy shape (zone lookup + snprintf per frame) vs the
+ *      cached engine, at a realistic 100 ms frame spacing (best of 3).
+ *      Fails if the speed-up is below 10x.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/bench_ot_log_timestamp.cpp -o tests/bench_ot_log_timestamp.out
+ *   ./tests/bench_ot_log_timestamp.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <time.h>
+
+#include "../src/OTGW-firmware/OTLogTimestamp.h"
+
+static int failures = 0;
+static uint64_t g_lookups = 0;
+
+static int32_t hostOffsetAt(int64_t utcSec)
+{
+  g_lookups++;
+  time_t t = (time_t)utcSec;
+  struct tm tmv;
+  localtime_r(&t, &tmv);
+  return (int32_t)tmv.tm_gmtoff;
+}
+
+// Legacy shape of getOTLogTimestamp(): resolve the zone, decompose, snprintf.
+static void legacyTimestamp(char *out, int64_t utcSec, uint32_t usec)
+{
+  time_t t = (time_t)utcSec;
+  struct tm tmv;
+  localtime_r(&t, &tmv);
+  snprintf(out, OT_LOG_TIMESTAMP_LEN, "%02d:%02d:%02d.%06lu",
+           tmv.tm_hour, tmv.tm_min, tmv.tm_sec, (unsigned long)usec);
+}
+
+static void cachedTimestamp(OTLogTzCache &cache, char *out, int64_t utcSec, uint32_t usec)
+{
+  if (!otLogTzCacheValid(cache, utcSec)) otLogTzResolve(cache, utcSec, hostOffsetAt);
+  otLogFormatTimestamp(out, utcSec + cache.offsetSec, usec);
+}
+
+static void setZone(const char *posixTz)
+{
+  setenv("TZ", posixTz, 1);
+  tzset();
+}
+
+// ---- 1. correctness ----
+static void checkZone(const char *name, const char *posixTz)
+{
+  setZone(posixTz);
+  OTLogTzCache cache;
+  char a[OT_LOG_TIMESTAMP_LEN], b[OT_LOG_TIMESTAMP_LEN];
+  const int64_t start = 1704067200;            // 2024-01-01T00:00:00Z
+  const int64_t end = start + 2 * 366 * 86400;
+  uint64_t mismatches = 0, samples = 0;
+  uint32_t usec = 0;
+  g_lookups = 0;
+
+  // Monotonic clock at 7 s + jitter spacing, as processOT() sees it.
+  for (int64_t t = start; t < end; t += 7) {
+    usec = (usec * 1103515245u + 12345u) % 1000000u;
+    legacyTimestamp(a, t, usec);
+    cachedTimestamp(cache, b, t, usec);
+    samples++;
+    if (strcmp(a, b) != 0 && mismatches++ < 3)
+      printf("  %s t=%lld legacy=%s cached=%s\n", name, (long long)t, a, b);
+  }
+  const uint64_t monotonicLookups = g_lookups;
+
+  // Every second around each transition in the window (found by scanning offsets).
+  int32_t prev = hostOffsetAt(start);
+  for (int64_t t = start; t < end; t += 60) {
+    const int32_t off = hostOffsetAt(t);
+    if (off == prev) continue;
+    prev = off;
+    for (int64_t u = t - 3600; u <= t + 60; u++) {
+      legacyTimestamp(a, u, 999999);
+      cachedTimestamp(cache, b, u, 999999);
+      samples++;
+      if (strcmp(a, b) != 0 && mismatches++ < 3)
+        printf("  %s t=%lld legacy=%s cached=%s\n", name, (long long)u, a, b);
+    }
+  }
+
+  // Clock stepping backwards (NTP correction) must not reuse a stale window.
+  cachedTimestamp(cache, b, start + 86400 * 200, 0);
+  legacyTimestamp(a, start + 86400 * 10, 0);
+  cachedTimestamp(cache, b, start + 86400 * 10, 0);
+  if (strcmp(a, b) != 0) mismatches++;
+  samples++;
+
+  // 2 years / 35-day horizon + transitions: a few dozen resolves, each ~50 lookups.
+  const bool fewLookups = monotonicLookups < samples / 1000;
+  const bool ok = (mismatches == 0) && fewLookups;
+  printf("%-26s samples=%llu mismatches=%llu lookups=%llu %s\n", name,
+         (unsigned long long)samples, (unsigned long long)mismatches,
+         (unsigned long long)monotonicLookups, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+static void checkFormatEdges()
+{
+  struct Case { int64_t local; uint32_t usec; const char *expect; };
+  const Case cases[] = {
+    { 0,              0,       "00:00:00.000000" },
+    { 86399,          999999,  "23:59:59.999999" },
+    { 86400 + 3723,   4,       "01:02:03.000004" },
+    { -1,             500000,  "23:59:59.500000" },     // negative local epoch
+    { 45296,          1234567, "12:34:56.999999" },     // usec clamped
+  };
+  for (const Case &c : cases) {
+    char out[OT_LOG_TIMESTAMP_LEN];
+    otLogFormatTimestamp(out, c.local, c.usec);
+    const bool ok = strcmp(out, c.expect) == 0;
+    printf("format %-12lld %-8u expected=%s got=%s %s\n", (long long)c.local, c.usec, c.expect, out,
+           ok ? "PASS" : "FAIL");
+    if (!ok) failures++;
+  }
+}
+
+// ---- 2. benchmark ----
+static void bench()
+{
+  setZone("CET-1CEST,M3.5.0,M10.5.0/3");
+  const int N = 2000000;
+  const int64_t start = 1711846800 - 3600;  // straddles the 2024-03-31 CET->CEST switch
+  char out[OT_LOG_TIMESTAMP_LEN];
+  volatile char sink = 0;
+
+  // Best of 3 rounds each, so a busy CI host does not fail the ratio check.
+  double legacyNs = 1e18, cachedNs = 1e18;
+  OTLogTzCache cache;
+  for (int round = 0; round < 3; round++) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; i++) {
+      legacyTimestamp(out, start + i / 10, (uint32_t)(i % 10) * 100000u);
+      sink = sink + out[7];
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    otLogTzCacheInvalidate(cache);
+    g_lookups = 0;
+    for (int i = 0; i < N; i++) {
+      cachedTimestamp(cache, out, start + i / 10, (uint32_t)(i % 10) * 100000u);
+      sink = sink + out[7];
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    const double l = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+    const double c = std::chrono::duration<double, std::nano>(t2 - t1).count() / N;
+    if (l < legacyNs) legacyNs = l;
+    if (c < cachedNs) cachedNs = c;
+  }
+  (void)sink;
+
+  const double speedup = legacyNs / cachedNs;
+  printf("legacy  (lookup + snprintf)  : %7.1f ns/frame\n", legacyNs);
+  printf("cached  (offset + int format): %7.1f ns/frame (%llu zone lookups in %d frames)\n",
+         cachedNs, (unsigned long long)g_lookups, N);
+  const bool ok = speedup >= 10.0;
+  printf("speed-up                     : %7.1fx %s\n", speedup, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+int main()
+{
+  printf("=== OT log timestamp engine ===\n");
+  checkFormatEdges();
+  checkZone("Europe/Amsterdam", "CET-1CEST,M3.5.0,M10.5.0/3");
+  checkZone("America/New_York", "EST5EDT,M3.2.0,M11.1.0");
+  checkZone("Australia/Sydney", "AEST-10AEDT,M10.1.0,M4.1.0/3");
+  checkZone("Asia/Kolkata (no DST)", "IST-5:30");
+  checkZone("UTC", "UTC0");
+  bench();
+  printf("=== %s (failures=%d) ===\n", failures ? "SOME TESTS FAILED" : "ALL TESTS PASSED", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,904 @@
+/**
+ * Host replay benchmark for the OT frame decode + publish path.
+ *
+ * Replays a captured OTGW serial log (one PIC line per row) through the
+ * firmware's processOT() hot path and reports frames/second, ns/frame and
+ * heap allocations per frame. The point is to catch regressions on the
+ * hottest code in the firmware before it reaches a boiler.
+ *
+ * What runs here, and where it comes from:
+ *   - the decode + publish body: #included from src/OTGW-firmware/OTDecode.h,
+ *     the same file OTGW-Core.ino includes. processOTFrame() (the raw-frame
+ *     branch of processOT(): delayed (T,R)/(B,A) pairing, capability bitmaps,
+ *     OT log line), is_value_valid*(), every print_* decoder,
+ *     decodeAndPublishOTValue() with OTDispatch[] and processPSSummary() are
+ *     the firmware code, not copies.
+ *   - OTmap[], otParseFrame(), OTF88.h, OTDispatch.h, AddLog*: the firmware
+ *     headers, pulled in by OTDecode.h or #included below.
+ *   - the pre-rendered OT value topic table (MQTTTopicIntern.h) and the
+ *     per-frame publish window (MQTTPublishBatch.h): #included.
+ *   - sendMQTTData() topic composition, sendMQTTDataForId() and
+ *     publishToSourceTopic[ForId](): LIFTED from MQTTstuff.ino with the
+ *     link/heap gate stubbed to a counter. They sit on the async MQTT client.
+ *   - host seams for what OTDecode.h calls back into the sketch: the MQTT
+ *     on-change throttle answers "publish" (legacy worst case, every valid
+ *     value publishes), the Status/VH/RBP fan-out publishes every bit
+ *     unconditionally, PS mode, SAT and the WebSocket/telnet sinks are
+ *     counters or no-ops.
+ *   - MQTT and WebSocket sinks: counters only (messages, bytes, and a hash of
+ *     every topic + payload). The bench measures the firmware's own
+ *     formatting work, not the network stack.
+ *
+ * The capture is timed twice: once with the topic table empty (every OT
+ * value topic composed at publish time, as before the table existed) and
+ * once with the table built. Both runs must publish the identical message
+ * stream; the report shows topic bytes composed per frame for each. Every
+ * table entry is also checked against the legacy composition up front.
+ * A third run repeats the table run with a publish window per frame, as
+ * processOT() opens one, and must publish the same stream with one
+ * link/heap gate evaluation per publishing frame.
+ *
+ * processOT() itself stays in the sketch (OTStateLock, snapshot publish and
+ * the non-frame PIC lines); the replay loop below calls otParseFrame() and
+ * processOTFrame() the way it does. Keep the lifted MQTT layer and the seams
+ * in step with MQTTstuff.ino / OTGW-Core.ino when their signatures change:
+ * the build breaks when OTDecode.h calls something the bench does not provide.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra -I tests/stubs tests/bench_ot_replay.cpp -o tests/bench_ot_replay.out
+ *   ./tests/bench_ot_replay.out [capture.log] [passes]
+ *   echo $?   # 0 on pass, 1 on failure
+ *
+ * Default capture: tests/fixtures/otgw_replay.log, 2000 passes.
+ * See tests/README.md for details.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include <sys/time.h>
+#include <time.h>
+
+// ---- Arduino compatibility stubs (host-only) ----
+#include <Arduino.h>                // tests/stubs: F(), PSTR(), PGM_P, strlcpy
+typedef char __FlashStringHelper;   // F() is the identity in the stubs
+
+#if !defined(__GLIBC__) || !(__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 38))
+static size_t strlcat(char *dst, const char *src, size_t size)
+{
+  const size_t dstLen = strnlen(dst, size);
+  if (dstLen == size) return size + strlen(src);
+  return dstLen + strlcpy(dst + dstLen, src, size - dstLen);
+}
+#endif
+
+// avr-libc/newlib itoa()/utoa(), decimal only (all OTDecode.h uses).
+static char *utoa(unsigned value, char *buf, int base)
+{
+  (void)base;
+  char tmp[12];
+  int n = 0;
+  do { tmp[n++] = (char)('0' + value % 10); value /= 10; } while (value);
+  for (int i = 0; i < n; i++) buf[i] = tmp[n - 1 - i];
+  buf[n] = '\0';
+  return buf;
+}
+
+static char *itoa(int value, char *buf, int base)
+{
+  if (value >= 0) return utoa((unsigned)value, buf, base);
+  buf[0] = '-';
+  utoa(0u - (unsigned)value, buf + 1, base);
+  return buf;
+}
+
+// OTmap[] omits bSlaveEchoesValue on most rows (defaults to false on purpose).
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#include "../src/OTGW-firmware/OTmap.h"
+#pragma GCC diagnostic pop
+#include "../src/OTGW-firmware/OTGWLogMacros.h"
+#include "../src/OTGW-firmware/OTFrameParse.h"
+#include "../src/OTGW-firmware/OTF88.h"
+#include "../src/OTGW-firmware/OTDispatch.h"
+#include "../src/OTGW-firmware/OTWsBinary.h"
+#include "../src/OTGW-firmware/SATtypes.h"
+#include "../src/OTGW-firmware/MQTTTopicIntern.h"
+#include "../src/OTGW-firmware/MQTTPublishBatch.h"
+
+char   ot_log_buffer[OT_LOG_BUFFER_SIZE];
+size_t ot_log_pos = 0;
+
+#define PROGMEM_readAnything(src, dest) memcpy(&(dest), (src), sizeof(dest))
+#define MQTT_TOPIC_MAX_LEN 200
+#define OT_TOPIC_LEN 50
+static char otTopic[OT_TOPIC_LEN];
+
+// Debug output is off in the bench (state.debug.bOTmsg == false).
+#define DebugTf(...)     do {} while (0)
+#define OTDebugTf(...)   do {} while (0)
+#define OTDebugT(line)   do { if (state.debug.bOTmsg) (void)(line); } while (0)
+#define OTDebugln(...)   do {} while (0)
+#define OTDebugFlush()   do {} while (0)
+
+// ---- Allocation counter ----
+// Every operator new and (on glibc) every malloc bumps the counter. The
+// firmware hot path is supposed to be allocation-free; a non-zero steady
+// state here means someone introduced a String or a heap buffer per frame.
+static uint64_t g_allocs = 0;
+
+void *operator new(size_t n)
+{
+  g_allocs++;
+  void *p = std::malloc(n ? n : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+#if defined(__GLIBC__)
+extern "C" void *__libc_malloc(size_t);
+extern "C" void *malloc(size_t n)
+{
+  g_allocs++;
+  return __libc_malloc(n);
+}
+#endif
+
+// ---- Sinks ----
+struct BenchSink {
+  uint64_t mqttMessages;
+  uint64_t mqttTopicBytes;
+  uint64_t mqttPayloadBytes;
+  uint64_t mqttHash;            // FNV-1a over every topic + payload, in order
+  uint64_t topicFormattedBytes; // state.mqtt.iTopicFormattedBytes
+  uint64_t topicInternedBytes;  // state.mqtt.iTopicInternedBytes
+  uint64_t topicInternMisses;   // state.mqtt.iTopicInternMisses
+  uint64_t topicShapeMisses;    // misses for a suffix the table should hold
+  uint64_t gateEvaluations;     // mqttLinkGate() calls
+  uint64_t wsMessages;
+  uint64_t wsBytes;
+};
+static BenchSink g_sink;
+
+static const char *kPubNamespace = "OTGW/value/otgw-1C69E2A4B5C6";  // typical MQTTPubNamespace
+static bool g_separateSources = true;   // settings.mqtt.bSeparateSources
+static const size_t kTopicMaxLen = 200; // MQTT_TOPIC_MAX_LEN
+static MqttTopicTable g_topicTable;     // mqttTopicTable
+static MqttPublishBatch g_batch;        // mqttBatch
+static bool g_batchFrames = false;      // open a window per frame (processOT)
+static uint8_t g_linkGate = MQTT_BATCH_GATE_OPEN;  // what the stubbed link/heap gate answers
+
+static uint64_t fnv1a(uint64_t h, const void *data, size_t len)
+{
+  const uint8_t *p = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < len; i++) { h ^= p[i]; h *= 0x100000001B3ull; }
+  return h;
+}
+
+static void mqttPublishRaw(const char *topic, const uint8_t *payload, size_t len)
+{
+  const size_t topicLen = strlen(topic);
+  g_sink.mqttMessages++;
+  g_sink.mqttTopicBytes += topicLen;
+  g_sink.mqttPayloadBytes += len;
+  g_sink.mqttHash = fnv1a(fnv1a(g_sink.mqttHash, topic, topicLen + 1), payload, len);
+}
+
+static void sendLogToWebSocket(const char *line)
+{
+  g_sink.wsMessages++;
+  g_sink.wsBytes += strlen(line);
+}
+
+
+// ---- Host seams: OpenthermData_t, state, settings (OTGW-Core.h, OTGW-firmware.h) ----
+enum OTGW_response_type {
+  OTGW_BOILER,
+  OTGW_THERMOSTAT,
+  OTGW_ANSWER_THERMOSTAT,
+  OTGW_REQUEST_BOILER,
+  OTGW_PARITY_ERROR,
+  OTGW_UNDEF
+};
+
+struct OpenthermData_t {
+  char buf[10];
+  byte len;
+  uint32_t value;
+  byte masterslave;
+  byte type;
+  byte id;
+  byte valueHB;
+  byte valueLB;
+  byte rsptype;
+  byte skipthis;
+  byte bGatewaySubstituted;
+  byte bAnswerOverride;
+  time_t time;
+  float f88() { return otF88ToFloat(otF88FromBytes(valueHB, valueLB)); }
+  uint16_t u16() { uint16_t v = valueHB; return (uint16_t)((v << 8) + valueLB); }
+  int16_t s16() { int16_t v = valueHB; return (int16_t)((v << 8) + valueLB); }
+};
+
+static OpenthermData_t OTdata, delayedOTdata, tmpOTdata;
+static OTlookup_t OTlookupitem;
+static OTdataStruct OTcurrentSystemState;
+static unsigned long g_fakeMillis = 0;
+static unsigned long lastOTmsgMs = 0;
+
+unsigned long millis() { return g_fakeMillis; }
+
+// Only the fields OTDecode.h touches.
+static struct {
+  struct {
+    bool   bPSmode;
+    bool   bOnline;
+    bool   bBoilerState;
+    bool   bThermostatState;
+    time_t tBoilerLastSeen;
+    time_t tThermostatLastSeen;
+  } otBus;
+  struct { bool bOTmsg; } debug;
+  struct { uint8_t iDetectedHeatingSource; } sat;
+} state;
+
+static struct {
+  struct {
+    bool bEnable = true;
+    bool bOTmessage = false;
+    bool bUseLegacyOtTopics = false;
+  } mqtt;
+} settings;
+// ---- Lifted: sendMQTTData[ForId]() / publishToSourceTopic[ForId]() (MQTTstuff.ino) ----
+// Stub for mqttLinkGate(): bEnable, connected(), isValidIP(), canPublishMQTT().
+static uint8_t mqttLinkGate()
+{
+  g_sink.gateEvaluations++;
+  return g_linkGate;
+}
+
+static bool mqttPublishAllowed = true;      // OTPublishGate
+static uint32_t mqttSendSuccessCount = 0;
+
+static bool mqttPublishGatesOpen()
+{
+  if (!mqttPublishAllowed) return false;
+  return mqttBatchLinkGate(g_batch, mqttLinkGate) == MQTT_BATCH_GATE_OPEN;
+}
+
+static bool mqttPublishFullTopic(const char *full_topic, const char *json)
+{
+  mqttPublishRaw(full_topic, reinterpret_cast<const uint8_t *>(json), strlen(json));
+  mqttBatchAppend(g_batch);
+  mqttSendSuccessCount++;
+  return true;
+}
+
+static bool sendMQTTData(const char *topic, const char *json)
+{
+  if (!mqttPublishGatesOpen()) return false;
+  char full_topic[kTopicMaxLen];
+  snprintf_P(full_topic, sizeof(full_topic), PSTR("%s/"), kPubNamespace);
+  const size_t topicLen = strlcat(full_topic, topic, sizeof(full_topic));
+  g_sink.topicFormattedBytes += (topicLen < sizeof(full_topic)) ? topicLen : sizeof(full_topic) - 1;
+  return mqttPublishFullTopic(full_topic, json);
+}
+
+// Bench-only: a miss on a (msgId, suffix) inside the OTmap type's shape means
+// the table failed to serve a topic it is supposed to hold.
+static void countTopicMiss(uint8_t msgId, uint8_t suffix)
+{
+  g_sink.topicInternMisses++;
+  if (g_topicTable.block && msgId <= OT_MSGID_MAX &&
+      (mqttTopicShapeFor(OTmap[msgId].type).suffixMask & MQTT_TOPIC_BIT(suffix)))
+    g_sink.topicShapeMisses++;
+}
+
+static void composeOTValueLeaf(char *dest, size_t destSize, uint8_t msgId, uint8_t suffix)
+{
+  const char *label = (msgId <= OT_MSGID_MAX) ? OTmap[msgId].label : "Undefined";
+  strlcpy(dest, label, destSize);
+  if (suffix < MQTT_TOPIC_SFX_COUNT) strlcat(dest, kMqttTopicSuffixText[suffix], destSize);
+  g_sink.topicFormattedBytes += strlen(dest);
+}
+
+static bool sendMQTTDataForId(uint8_t msgId, uint8_t suffix, const char *json)
+{
+  if (!mqttPublishGatesOpen()) return false;
+  const char *full_topic = mqttTopicLookup(g_topicTable, msgId, suffix, MQTT_TOPIC_CANONICAL);
+  if (full_topic) {
+    g_sink.topicInternedBytes += strlen(full_topic);
+    return mqttPublishFullTopic(full_topic, json);
+  }
+  countTopicMiss(msgId, suffix);
+  char leaf[50];   // OT_TOPIC_LEN
+  composeOTValueLeaf(leaf, sizeof(leaf), msgId, suffix);
+  return sendMQTTData(leaf, json);
+}
+
+static bool routeSourceTopics(byte rsptype, bool &toThermostat, bool &toBoiler)
+{
+  if (OTdata.type == OT_WRITE_ACK && rsptype == OTGW_BOILER && !OTlookupitem.bSlaveEchoesValue) return false;
+  toThermostat = false;
+  toBoiler = false;
+  switch (rsptype) {
+    case OTGW_THERMOSTAT:        toThermostat = true; toBoiler = !OTdata.bGatewaySubstituted; break;
+    case OTGW_BOILER:            toBoiler = true; toThermostat = !OTdata.bGatewaySubstituted; break;
+    case OTGW_REQUEST_BOILER:    toBoiler = true; break;
+    case OTGW_ANSWER_THERMOSTAT: toThermostat = true; toBoiler = !OTdata.bAnswerOverride; break;
+    default: return false;
+  }
+  return true;
+}
+
+static void publishToSourceTopic(const char *topic, const char *json, byte rsptype)
+{
+  if (!g_separateSources || !topic || !json) return;
+  bool toThermostat, toBoiler;
+  if (!routeSourceTopics(rsptype, toThermostat, toBoiler)) return;
+  static char sourceTopic[kTopicMaxLen];
+  if (toThermostat) {
+    snprintf_P(sourceTopic, sizeof(sourceTopic), PSTR("%s_thermostat"), topic);
+    g_sink.topicFormattedBytes += strlen(sourceTopic);
+    sendMQTTData(sourceTopic, json);
+  }
+  if (toBoiler) {
+    snprintf_P(sourceTopic, sizeof(sourceTopic), PSTR("%s_boiler"), topic);
+    g_sink.topicFormattedBytes += strlen(sourceTopic);
+    sendMQTTData(sourceTopic, json);
+  }
+}
+
+static void publishToSourceTopicForId(uint8_t msgId, uint8_t suffix, const char *json, byte rsptype)
+{
+  if (!g_separateSources || !json) return;
+  bool toThermostat, toBoiler;
+  if (!routeSourceTopics(rsptype, toThermostat, toBoiler)) return;
+  const char *thermostatTopic = toThermostat ? mqttTopicLookup(g_topicTable, msgId, suffix, MQTT_TOPIC_THERMOSTAT) : nullptr;
+  const char *boilerTopic = toBoiler ? mqttTopicLookup(g_topicTable, msgId, suffix, MQTT_TOPIC_BOILER) : nullptr;
+  if ((toThermostat && !thermostatTopic) || (toBoiler && !boilerTopic)) {
+    countTopicMiss(msgId, suffix);
+    char leaf[50];
+    composeOTValueLeaf(leaf, sizeof(leaf), msgId, suffix);
+    publishToSourceTopic(leaf, json, rsptype);
+    return;
+  }
+  if (thermostatTopic && mqttPublishGatesOpen()) { g_sink.topicInternedBytes += strlen(thermostatTopic); mqttPublishFullTopic(thermostatTopic, json); }
+  if (boilerTopic && mqttPublishGatesOpen())     { g_sink.topicInternedBytes += strlen(boilerTopic);     mqttPublishFullTopic(boilerTopic, json); }
+}
+
+
+// ---- Host seams: publish window + OTPublishGate (OTGW-Core.h, MQTTstuff.ino) ----
+static void beginMQTTPublishBatch()
+{
+  if (g_batchFrames) mqttBatchBegin(g_batch);
+}
+
+static void commitMQTTPublishBatch()
+{
+  if (g_batchFrames) mqttBatchCommit(g_batch);
+}
+
+struct OTPublishGate {
+  bool _saved;
+  explicit OTPublishGate(bool allow) : _saved(mqttPublishAllowed) { mqttPublishAllowed = allow; }
+  ~OTPublishGate() { mqttPublishAllowed = _saved; }
+  OTPublishGate(const OTPublishGate&) = delete;
+  OTPublishGate& operator=(const OTPublishGate&) = delete;
+};
+
+struct MQTTPublishBatchScope {
+  MQTTPublishBatchScope() { beginMQTTPublishBatch(); }
+  ~MQTTPublishBatchScope() { commitMQTTPublishBatch(); }
+  MQTTPublishBatchScope(const MQTTPublishBatchScope&) = delete;
+  MQTTPublishBatchScope& operator=(const MQTTPublishBatchScope&) = delete;
+};
+
+static bool publishMQTTOnOff(const char *topic, bool value)
+{
+  return sendMQTTData(topic, value ? "ON" : "OFF");
+}
+
+// ---- Host seams: on-change throttle (OTGW-Core.ino) ----
+// Every value publishes: the legacy worst case, and what the firmware does on
+// the first frame of each id or with the interval set to 0.
+struct MQTTPendingSlotUpdate { bool pending; };
+static MQTTPendingSlotUpdate mqttPendingSlot = { false };
+static uint16_t mqttlastsentASFbit[8], mqttlastsentASFbyte[1];
+static uint16_t mqttlastsentRObit[2], mqttlastsentRObyte[1];
+
+static bool shouldPublishMQTTForID(byte, byte, uint16_t) { return true; }
+static bool shouldPublishMQTTForPSField(byte) { return true; }
+static void confirmMQTTPublishSlot() { mqttPendingSlot.pending = false; }
+static uint16_t currentTrackedSeconds() { return (uint16_t)(g_fakeMillis / 1000); }
+static void setMsgLastUpdated(uint8_t, uint16_t, uint16_t) {}
+static bool getMQTTConfigDone(uint8_t) { return true; }
+static void setMQTTConfigPending(uint8_t) {}
+
+static void publishGatedBitMQTT(uint16_t *, uint8_t, const char *topic, bool newVal, bool,
+                                const char *aliasLabel = nullptr)
+{
+  publishMQTTOnOff((aliasLabel && !settings.mqtt.bUseLegacyOtTopics) ? aliasLabel : topic, newVal);
+}
+
+static void publishGatedByteMQTT(uint16_t *, uint8_t, const char *topic, const char *payload, uint8_t, uint8_t)
+{
+  sendMQTTData(topic, payload);
+}
+
+// ---- Host seams: protocol helpers (OTGW-Core.ino) ----
+static const char *byte_to_binary(int x)
+{
+  static char b[9];
+  b[0] = '\0';
+  for (int z = 128; z > 0; z >>= 1) strlcat(b, ((x & z) == z) ? "1" : "0", sizeof(b));
+  return b;
+}
+
+static const char *messageTypeToString(OTLibMessageType message_type)
+{
+  switch (message_type) {
+    case OT_READ_DATA:       return "Read-Data";
+    case OT_WRITE_DATA:      return "Write-Data";
+    case OT_INVALID_DATA:    return "Invalid-Data";
+    case OT_RESERVED:        return "Reserved";
+    case OT_READ_ACK:        return "Read-Ack";
+    case OT_WRITE_ACK:       return "Write-Ack";
+    case OT_DATA_INVALID:    return "Data-Invalid";
+    case OT_UNKNOWN_DATA_ID: return "Unknown-Data-Id";
+    default:                 return "Unknown";
+  }
+}
+
+static const char *messageIDToString(OTLibMessageID message_id)
+{
+  if (message_id <= OT_MSGID_MAX) {
+    PROGMEM_readAnything(&OTmap[message_id], OTlookupitem);
+    return OTlookupitem.label;
+  }
+  return "Undefined";
+}
+
+static bool isMsgIdReservedInActiveProfile(uint8_t) { return false; }   // OpenTherm v4.x ids only
+static PGM_P activeOTSpecProfileName_P() { return PSTR("OpenTherm v4.x"); }
+
+static void copyProgmemString(char *dst, size_t dstSize, PGM_P src)
+{
+  if (dst == nullptr || dstSize == 0) return;
+  strlcpy(dst, src ? src : "", dstSize);
+}
+
+static inline const __FlashStringHelper *toFlashStringHelper(PGM_P p) { return p; }
+static const char *skipOTLogTimestamp(const char *logLine) { return logLine; }
+
+enum OTOverrideKind : uint8_t {
+  OT_OVERRIDE_ANSWER       = 0,
+  OT_OVERRIDE_SUBSTITUTED  = 1
+};
+static void recordOTOverride(uint8_t, uint8_t, float) {}
+
+// ---- Host seams: Status / Status V/H / RBP fan-out (OTGW-Core.ino) ----
+// Same topics as the firmware, every bit published (no per-bit throttle).
+struct StatusBitTopic { const char *topic; const char *alias; };
+
+static void publishStatusBits(const StatusBitTopic *bits, int count, uint8_t value)
+{
+  for (int i = 0; i < count; i++) {
+    if (!bits[i].topic) continue;
+    const char *label = (bits[i].alias && !settings.mqtt.bUseLegacyOtTopics) ? bits[i].alias : bits[i].topic;
+    publishMQTTOnOff(label, value & (1 << i));
+  }
+}
+
+static void publishHvacMode(bool)
+{
+  const uint8_t hb = OTcurrentSystemState.MasterStatus;
+  sendMQTTData("hvac_mode", !state.otBus.bThermostatState ? "off" : (hb & 0x04) ? "cool" : "heat");
+}
+
+static void publishHvacAction(bool)
+{
+  const uint8_t lb = OTcurrentSystemState.SlaveStatus;
+  sendMQTTData("hvac_action", !state.otBus.bThermostatState ? "off"
+                            : (lb & 0x10) ? "cooling" : (lb & 0x02) ? "heating" : "idle");
+}
+
+static void publishMasterStatusState(uint8_t valueHB, const char *statusText)
+{
+  static const StatusBitTopic kBits[] = {
+    {"ch_enable", nullptr}, {"dhw_enable", nullptr}, {"cooling_enable", nullptr}, {"otc_active", nullptr},
+    {"ch2_enable", nullptr}, {"summerwintertime", nullptr}, {"dhw_blocking", nullptr},
+  };
+  OTcurrentSystemState.MasterStatus = valueHB;
+  sendMQTTData("status_master", statusText);
+  publishStatusBits(kBits, 7, valueHB);
+  publishHvacMode(false);
+}
+
+static void publishSlaveStatusState(uint8_t valueLB, const char *statusText)
+{
+  static const StatusBitTopic kBits[] = {
+    {"fault", "fault_indication"}, {"centralheating", "central_heating"}, {"domestichotwater", "hot_water"},
+    {"flame", nullptr}, {"cooling", nullptr}, {"centralheating2", "central_heating_2"},
+    {"diagnostic_indicator", "diagnostic_indication"}, {"electric_production", nullptr},
+  };
+  OTcurrentSystemState.SlaveStatus = valueLB;
+  sendMQTTData("status_slave", statusText);
+  publishStatusBits(kBits, 8, valueLB);
+  publishHvacAction(false);
+}
+
+static void buildStatusText(uint8_t value, const char *onChars, char offChar5, char *text)
+{
+  for (int i = 0; i < 8; i++) text[i] = (value & (1 << i)) ? onChars[i] : (i == 5 ? offChar5 : '-');
+  text[8] = '\0';
+}
+
+static uint16_t publishCombinedStatusState(uint8_t valueHB, uint8_t valueLB)
+{
+  char masterStatus[9], slaveStatus[9];
+  buildStatusText(valueHB, "CDCO2SB.", 'W', masterStatus);
+  buildStatusText(valueLB, "ECWFC2DP", '-', slaveStatus);
+  publishMasterStatusState(valueHB, masterStatus);
+  publishSlaveStatusState(valueLB, slaveStatus);
+  return (OTcurrentSystemState.MasterStatus << 8) | OTcurrentSystemState.SlaveStatus;
+}
+
+static void publishMasterStatusVHState(uint8_t valueHB, const char *statusText)
+{
+  static const StatusBitTopic kBits[] = {
+    {"vh_ventilation_enabled", "ventilation_enabled"}, {"vh_bypass_position", "ventilation_bypass_position"},
+    {"vh_bypass_mode", "ventilation_bypass_mode"}, {"vh_free_ventilation_mode", "ventilation_free_mode"},
+  };
+  OTcurrentSystemState.MasterStatusVH = valueHB;
+  sendMQTTData("status_vh_master", statusText);
+  publishStatusBits(kBits, 4, valueHB);
+}
+
+static void publishSlaveStatusVHState(uint8_t valueLB, const char *statusText)
+{
+  static const StatusBitTopic kBits[] = {
+    {"vh_fault", "ventilation_fault"}, {"vh_ventilation_mode", "ventilation_active"},
+    {"vh_bypass_status", "ventilation_bypass_status"}, {"vh_bypass_automatic_status", "ventilation_bypass_automatic"},
+    {"vh_free_ventliation_status", "ventilation_free_status"}, {nullptr, nullptr},
+    {"vh_diagnostic_indicator", "ventilation_diagnostic"},
+  };
+  OTcurrentSystemState.SlaveStatusVH = valueLB;
+  sendMQTTData("status_vh_slave", statusText);
+  publishStatusBits(kBits, 7, valueLB);
+}
+
+static uint16_t publishCombinedStatusVHState(uint8_t valueHB, uint8_t valueLB)
+{
+  char masterStatus[9], slaveStatus[9];
+  buildStatusText(valueHB, "VPMF....", '-', masterStatus);
+  buildStatusText(valueLB, "FVBAF.D.", '-', slaveStatus);
+  publishMasterStatusVHState(valueHB, masterStatus);
+  publishSlaveStatusVHState(valueLB, slaveStatus);
+  return (OTcurrentSystemState.MasterStatusVH << 8) | OTcurrentSystemState.SlaveStatusVH;
+}
+
+static uint16_t publishRBPFlagsState(uint8_t transferEnableFlags, uint8_t readWriteFlags, uint8_t, uint8_t)
+{
+  static const StatusBitTopic kBits[] = {{"rbp_dhw_setpoint", nullptr}, {"rbp_max_ch_setpoint", nullptr}};
+  static const StatusBitTopic kRwBits[] = {{"rbp_rw_dhw_setpoint", nullptr}, {"rbp_rw_max_ch_setpoint", nullptr}};
+  char text[9];
+  strlcpy(text, byte_to_binary(transferEnableFlags), sizeof(text));
+  sendMQTTData("RBP_flags_transfer_enable", text);
+  strlcpy(text, byte_to_binary(readWriteFlags), sizeof(text));
+  sendMQTTData("RBP_flags_read_write", text);
+  publishStatusBits(kBits, 2, transferEnableFlags);
+  publishStatusBits(kRwBits, 2, readWriteFlags);
+  return ((uint16_t)transferEnableFlags << 8) | readWriteFlags;
+}
+
+// ---- Host seams: connection state, PS mode, SAT, WebSocket (MQTTstuff.ino, SATcontrol.ino, webSocketStuff.ino) ----
+static void publishBoilerConnectedState() {}
+static void publishThermostatConnectedState() {}
+static void publishOTGWConnectedState() {}
+
+static void enterPSMode(PGM_P, PGM_P, bool) { state.otBus.bPSmode = true; }
+static void leavePSMode(PGM_P, PGM_P) { state.otBus.bPSmode = false; }
+
+static void satNotifyBoilerFrameSeen() {}
+static void satDetectManufacturer(uint8_t) {}
+
+static bool hasWebSocketTextClients() { return true; }     // build the OT log line every frame
+static bool hasWebSocketBinaryClients() { return false; }
+static void sendOTFrameLogToWebSocket(const char *line) { sendLogToWebSocket(line); }
+static void sendOTFrameToWebSocketBinary(char, uint8_t, uint32_t) {}
+// ---- Lifted: getOTLogTimestamp() shape (helperStuff.ino) ----
+// The firmware resolves an AceTime zone per frame; that cost is measured on
+// its own elsewhere. Here: localtime_r + the same HH:MM:SS.uuuuuu format.
+static const char *getOTLogTimestamp()
+{
+  static char timestamp[16];
+  timeval now;
+  gettimeofday(&now, nullptr);
+  struct tm tmv;
+  localtime_r(&now.tv_sec, &tmv);
+  snprintf_P(timestamp, sizeof(timestamp), PSTR("%02d:%02d:%02d.%06lu"),
+             tmv.tm_hour, tmv.tm_min, tmv.tm_sec, (unsigned long)now.tv_usec);
+  return timestamp;
+}
+
+
+// ---- The firmware decode + publish body ----
+#include "../src/OTGW-firmware/OTDecode.h"
+
+// ---- processOT() line dispatch (OTGW-Core.ino) ----
+// The raw-frame half of processOT(); the OTStateLock, the snapshot publish
+// and the command-response/banner branches stay in the sketch.
+struct ReplayStats {
+  uint64_t lines;
+  uint64_t frames;
+  uint64_t parseFailures;
+  uint64_t otherLines;
+};
+
+static void processOT(const char *buf, int len, ReplayStats &rs)
+{
+  rs.lines++;
+  OTRawFrame frame;
+  const OTFrameParseResult parsed = otParseFrame(buf, len, frame);
+  if (parsed == OT_FRAME_NOT_FRAME) { rs.otherLines++; return; }
+  rs.frames++;
+  if (parsed != OT_FRAME_OK) rs.parseFailures++;
+  processOTFrame(buf, len, parsed, frame, false);
+}
+
+// ---- Capture loading ----
+static bool loadCapture(const char *path, std::vector<std::string> &lines)
+{
+  FILE *f = std::fopen(path, "rb");
+  if (!f) return false;
+  std::string cur;
+  int c;
+  while ((c = std::fgetc(f)) != EOF) {
+    if (c == '\r' || c == '\n') {
+      if (!cur.empty()) lines.push_back(cur);
+      cur.clear();
+    } else if (cur.size() < 511) {   // MAX_BUFFER_READ - 1
+      cur.push_back((char)c);
+    }
+  }
+  if (!cur.empty()) lines.push_back(cur);
+  std::fclose(f);
+  return true;
+}
+
+// ---- Topic table vs legacy composition ----
+// Every (msgId, suffix, variant) the table holds must equal what the
+// composing path publishes: "<ns>/" + label + suffix [+ variant], cut at
+// MQTT_TOPIC_MAX_LEN - 1. Anything outside the shape must miss.
+static int checkTopicTable(const char *ns, bool sourceVariants)
+{
+  MqttTopicTable t;
+  if (!mqttTopicTableBuild(t, ns, sourceVariants, kTopicMaxLen - 1)) {
+    std::printf("FAIL: topic table build (ns len %zu)\n", strlen(ns));
+    return 1;
+  }
+  int bad = 0;
+  unsigned hits = 0;
+  for (int id = 0; id <= 255; id++) {
+    for (uint8_t sfx = 0; sfx < MQTT_TOPIC_SFX_COUNT; sfx++) {
+      for (uint8_t v = 0; v < MQTT_TOPIC_VARIANT_COUNT; v++) {
+        const char *got = mqttTopicLookup(t, (uint8_t)id, sfx, v);
+        bool expect = false;
+        if (id <= OT_MSGID_MAX && OTmap[id].label[0]) {
+          const MqttTopicShape sh = mqttTopicShapeFor(OTmap[id].type);
+          expect = (sh.suffixMask & MQTT_TOPIC_BIT(sfx)) && v < (sourceVariants ? sh.variants : 1);
+        }
+        if (!expect) { if (got && bad++ < 3) std::printf("  unexpected topic %d/%u/%u: %s\n", id, sfx, v, got); continue; }
+        char leaf[kTopicMaxLen], withVariant[kTopicMaxLen], full[kTopicMaxLen];
+        strlcpy(leaf, OTmap[id].label, 50);          // otTopic[OT_TOPIC_LEN]
+        strlcat(leaf, kMqttTopicSuffixText[sfx], 50);
+        snprintf(withVariant, sizeof(withVariant), "%s%s", leaf, kMqttTopicVariantText[v]);
+        snprintf(full, sizeof(full), "%s/", ns);
+        strlcat(full, withVariant, sizeof(full));
+        hits++;
+        if (!got || strcmp(got, full) != 0) {
+          if (bad++ < 3) std::printf("  topic %d/%u/%u: table '%s' legacy '%s'\n", id, sfx, v, got ? got : "(null)", full);
+        }
+      }
+    }
+  }
+  std::printf("topic table (ns %3zu B, variants %d): %u topics, %u B %s\n", strlen(ns), sourceVariants ? 1 : 0,
+              hits, (unsigned)t.bytes, bad ? "FAIL" : "PASS");
+  mqttTopicTableFree(t);
+  return bad ? 1 : 0;
+}
+
+// ---- Publish window semantics (MQTTPublishBatch.h) ----
+static int checkPublishBatch()
+{
+  int bad = 0;
+  auto expect = [&](const char *what, bool ok) {
+    if (!ok && bad++ < 8) std::printf("  publish window: %s\n", what);
+  };
+  const BenchSink saved = g_sink;
+  g_sink = BenchSink {};
+  MqttPublishBatch &b = g_batch;
+  b = MqttPublishBatch {};
+
+  // Outside a window every publish evaluates the gate.
+  mqttPublishGatesOpen(); mqttPublishGatesOpen();
+  expect("unbatched gate runs per publish", g_sink.gateEvaluations == 2);
+
+  // Lazy: an empty window costs nothing and is not counted as a batch.
+  mqttBatchBegin(b);
+  expect("empty window commits", mqttBatchCommit(b));
+  expect("empty window not evaluated", g_sink.gateEvaluations == 2 && b.batches == 0);
+
+  // One evaluation per window, nested begin/commit folds into the outer one.
+  g_sink.gateEvaluations = 0;
+  mqttBatchBegin(b);
+  for (int i = 0; i < 5; i++) { if (mqttPublishGatesOpen()) mqttBatchAppend(b); }
+  mqttBatchBegin(b);
+  if (mqttPublishGatesOpen()) mqttBatchAppend(b);
+  expect("inner commit does not close", !mqttBatchCommit(b) && mqttBatchActive(b));
+  g_linkGate = MQTT_BATCH_GATE_CLOSED;   // link drops mid-frame: cached verdict stands
+  if (mqttPublishGatesOpen()) mqttBatchAppend(b);
+  expect("outer commit closes", mqttBatchCommit(b) && !mqttBatchActive(b));
+  expect("one evaluation per window", g_sink.gateEvaluations == 1);
+  expect("messages counted", b.batches == 1 && b.batchedMessages == 7 && b.maxMessages == 7);
+  expect("gate checks saved", b.gateChecksSaved == 6);
+
+  // Next window re-evaluates and sees the closed link; a heap verdict is cached too.
+  mqttBatchBegin(b);
+  expect("closed link re-evaluated", !mqttPublishGatesOpen() && g_sink.gateEvaluations == 2);
+  expect("unbalanced commit ignored", mqttBatchCommit(b) && !mqttBatchCommit(b));
+  g_linkGate = MQTT_BATCH_GATE_HEAP;
+  mqttBatchBegin(b);
+  const bool heap1 = mqttPublishGatesOpen(), heap2 = mqttPublishGatesOpen();
+  mqttBatchCommit(b);
+  expect("heap verdict cached", !heap1 && !heap2 && g_sink.gateEvaluations == 3);
+  expect("window without publishes not a batch", b.batches == 1 && b.gateChecksSaved == 7);
+
+  g_linkGate = MQTT_BATCH_GATE_OPEN;
+  g_batch = MqttPublishBatch {};
+  g_sink = saved;
+  std::printf("publish window semantics: %s\n", bad ? "FAIL" : "PASS");
+  return bad ? 1 : 0;
+}
+
+struct ReplayRun {
+  ReplayStats rs;
+  BenchSink sink;
+  double ns;
+  uint64_t allocs;
+};
+
+static ReplayRun replay(const std::vector<std::string> &lines, long passes)
+{
+  // Warm-up pass: first-frame pairing, lazy libc init, page faults.
+  ReplayStats warm {};
+  for (const std::string &l : lines) { g_fakeMillis += 100; processOT(l.c_str(), (int)l.size(), warm); }
+
+  ReplayRun r {};
+  g_sink = BenchSink {};
+  g_sink.mqttHash = 0xCBF29CE484222325ull;
+  g_batch = MqttPublishBatch {};
+  const uint64_t allocsBefore = g_allocs;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (long p = 0; p < passes; p++) {
+    for (const std::string &l : lines) {
+      g_fakeMillis += 100;
+      processOT(l.c_str(), (int)l.size(), r.rs);
+    }
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  r.allocs = g_allocs - allocsBefore;
+  r.ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+  r.sink = g_sink;
+  return r;
+}
+
+int main(int argc, char **argv)
+{
+  const char *path = (argc > 1) ? argv[1] : "tests/fixtures/otgw_replay.log";
+  const long passes = (argc > 2) ? std::atol(argv[2]) : 2000;
+
+  std::vector<std::string> lines;
+  if (!loadCapture(path, lines) || lines.empty()) {
+    std::printf("cannot read capture '%s'\n", path);
+    return 1;
+  }
+
+  std::printf("=== OT replay benchmark ===\n");
+  std::printf("capture: %s (%zu lines), passes: %ld\n", path, lines.size(), passes);
+
+  int failures = 0;
+  failures += checkTopicTable(kPubNamespace, true);
+  failures += checkTopicTable(kPubNamespace, false);
+  const std::string longNs(191, 'n');   // MQTT_NAMESPACE_MAX_LEN - 1: every topic truncated
+  failures += checkTopicTable(longNs.c_str(), true);
+  failures += checkPublishBatch();
+
+  // Same capture, same delayed-pair state: topic table empty, then built.
+  const unsigned long startMillis = g_fakeMillis;
+  mqttTopicTableFree(g_topicTable);
+  const ReplayRun legacy = replay(lines, passes);
+  g_fakeMillis = startMillis;
+  delayedOTdata = OpenthermData_t {};
+  if (!mqttTopicTableBuild(g_topicTable, kPubNamespace, g_separateSources, kTopicMaxLen - 1)) {
+    std::printf("FAIL: topic table build\n");
+    return 1;
+  }
+  const ReplayRun unbatched = replay(lines, passes);
+  g_fakeMillis = startMillis;
+  delayedOTdata = OpenthermData_t {};
+  g_batchFrames = true;
+  const ReplayRun interned = replay(lines, passes);
+  g_batchFrames = false;
+
+  const ReplayRun &r = interned;
+  const double frames = (double)r.rs.frames;
+  std::printf("frames decoded        : %llu (non-frame lines %llu)\n",
+              (unsigned long long)r.rs.frames, (unsigned long long)r.rs.otherLines);
+  std::printf("frames/second         : %.0f (topics composed: %.0f)\n", frames / (r.ns / 1e9),
+              (double)legacy.rs.frames / (legacy.ns / 1e9));
+  std::printf("ns/frame              : %.1f (topics composed: %.1f)\n", r.ns / frames,
+              legacy.ns / (double)legacy.rs.frames);
+  std::printf("allocations/frame     : %.3f\n", (double)r.allocs / frames);
+  std::printf("mqtt msgs/frame       : %.2f (topic %.1f B + payload %.1f B per frame)\n",
+              (double)r.sink.mqttMessages / frames,
+              (double)r.sink.mqttTopicBytes / frames,
+              (double)r.sink.mqttPayloadBytes / frames);
+  std::printf("topic bytes composed  : %.1f B/frame before, %.1f B/frame with table (%.1f B/frame pre-rendered, %.2f misses/frame)\n",
+              (double)legacy.sink.topicFormattedBytes / (double)legacy.rs.frames,
+              (double)r.sink.topicFormattedBytes / frames,
+              (double)r.sink.topicInternedBytes / frames,
+              (double)r.sink.topicInternMisses / frames);
+  std::printf("gate checks/frame     : %.2f per publish, %.2f with a window per frame (%.2f msgs/batch, max %u, %llu saved)\n",
+              (double)unbatched.sink.gateEvaluations / (double)unbatched.rs.frames,
+              (double)r.sink.gateEvaluations / frames,
+              g_batch.batches ? (double)g_batch.batchedMessages / (double)g_batch.batches : 0.0,
+              (unsigned)g_batch.maxMessages, (unsigned long long)g_batch.gateChecksSaved);
+  std::printf("topic table           : %u topics, %u B\n", (unsigned)g_topicTable.slots, (unsigned)g_topicTable.bytes);
+  std::printf("websocket bytes/frame : %.1f\n", (double)r.sink.wsBytes / frames);
+
+  if (r.rs.frames == 0)        { std::printf("FAIL: capture contained no OT frames\n"); failures++; }
+  if (r.rs.parseFailures != 0) { std::printf("FAIL: %llu frames failed to parse\n", (unsigned long long)r.rs.parseFailures); failures++; }
+  if (r.sink.mqttMessages == 0) { std::printf("FAIL: no MQTT publishes produced\n"); failures++; }
+  if (legacy.allocs != 0 || r.allocs != 0) {
+    std::printf("FAIL: hot path allocated %llu/%llu times\n", (unsigned long long)legacy.allocs, (unsigned long long)r.allocs);
+    failures++;
+  }
+  if (legacy.sink.mqttMessages != r.sink.mqttMessages || legacy.sink.mqttHash != r.sink.mqttHash) {
+    std::printf("FAIL: topic table changed the published stream (%llu vs %llu msgs)\n",
+                (unsigned long long)legacy.sink.mqttMessages, (unsigned long long)r.sink.mqttMessages);
+    failures++;
+  }
+  // The Status fan-out and the flag decoders still compose their (fixed)
+  // topics; every OT value topic inside the table's shape must be served
+  // pre-rendered.
+  if (r.sink.topicShapeMisses != 0 || r.sink.topicFormattedBytes >= legacy.sink.topicFormattedBytes) {
+    std::printf("FAIL: %llu OT value topics composed despite the table\n", (unsigned long long)r.sink.topicShapeMisses);
+    failures++;
+  }
+  // One link/heap evaluation per frame that publishes; everything else in the
+  // frame is answered from the window.
+  if (unbatched.sink.mqttMessages != r.sink.mqttMessages || unbatched.sink.mqttHash != r.sink.mqttHash) {
+    std::printf("FAIL: publish window changed the published stream\n");
+    failures++;
+  }
+  if (r.sink.gateEvaluations > r.rs.frames ||
+      r.sink.gateEvaluations + g_batch.gateChecksSaved != unbatched.sink.gateEvaluations) {
+    std::printf("FAIL: publish window evaluated the gate %llu times (unbatched %llu, saved %llu)\n",
+                (unsigned long long)r.sink.gateEvaluations, (unsigned long long)unbatched.sink.gateEvaluations,
+                (unsigned long long)g_batch.gateChecksSaved);
+    failures++;
+  }
+  mqttTopicTableFree(g_topicTable);
+  std::printf("=== %s (failures=%d) ===\n", failures ? "FAILED" : "ALL CHECKS PASSED", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,451 @@
+/**
+ * Host test + benchmark for the OTDirect master request scheduler
+ * (OTDirectSchedule.h).
+ *
+ * scheduleMasterRequest() in OTDirect.ino used to run from a 100 ms timer and
+ * walk otSchedule[] round-robin. It now asks OTDeadlineScheduler for the most
+ * overdue entry of the highest priority class and sleeps until the next
+ * deadline. This file replays both against the same simulated OT bus:
+ *
+ *   - the real otSchedule[] tiers (status, 9 writes, 13 temperature reads,
+ *     81 slow reads), three writes with a value set;
+ *   - a boiler answering in 80-380 ms, UNKNOWN_DATA_ID for a fixed set of
+ *     MsgIDs (3-strike auto-disable), a 2 minute outage (bus offline, status
+ *     probe only) and a switch to a ventilation slave (MsgID 70/71 fast poll);
+ *   - a thermostat forwarding one frame per ~second ahead of the scheduler;
+ *   - random PM= (force), DA=/EN= (disable/enable) and write set/clear
+ *     commands, MI=100;
+ *   - a millis() clock that wraps through 0xFFFFFFFF ten minutes in.
+ *
+ * Checks:
+ *   1. Every deadline send is legal: eligible under the current bus state,
+ *      its interval elapsed (legacy compare), and it is the most overdue
+ *      entry of the highest class that has anything due.
+ *   2. Heap invariants after every send and touch.
+ *   3. Against the round-robin: status (MsgID 0) gaps never longer, fewer
+ *      status gaps over 1 s, fewer scheduler calls, and no slower poll rate
+ *      for any class.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/bench_otdirect_schedule.cpp -o tests/bench_otdirect_schedule.out
+ *   ./tests/bench_otdirect_schedule.out [minutes]
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../src/OTGW-firmware/OTDirectSchedule.h"
+
+static int failures = 0;
+
+static void check(const char *name, bool ok)
+{
+  printf("%-60s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+static inline uint32_t rnd()
+{
+  g_rng ^= g_rng >> 12; g_rng ^= g_rng << 25; g_rng ^= g_rng >> 27;
+  return (uint32_t)((g_rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+// ---- otSchedule[] tiers as in OTDirect.ino ----
+static const uint8_t kWrites[] = { 1, 7, 8, 14, 16, 24, 27, 56, 57 };
+static const uint8_t kTemps[]  = { 25, 28, 26, 17, 18, 19, 29, 30, 31, 32, 35, 36, 38 };
+static const uint8_t kSlow[]   = { 3, 5, 6, 9, 15, 20, 21, 22, 33, 34, 37, 39, 48, 49, 50, 51, 52, 53, 54, 55,
+                                   58, 59, 60, 61, 62, 63, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82,
+                                   83, 84, 85, 86, 87, 88, 89, 90, 91, 93, 94, 95, 96, 97, 98, 99, 100, 101,
+                                   102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116,
+                                   117, 118, 119, 120, 121, 122, 123, 125, 127 };
+// MsgIDs this simulated boiler answers with UNKNOWN_DATA_ID.
+static bool unsupported(uint8_t id)
+{
+  return (id >= 29 && id <= 32) || (id >= 50 && id <= 55) || (id >= 72 && id <= 91) ||
+         (id >= 101 && id <= 112) || id == 7 || id == 8 || id == 38 || id == 39;
+}
+
+static const uint8_t kTableSize = 1 + sizeof(kWrites) + sizeof(kTemps) + sizeof(kSlow);
+
+static void buildTable(OTScheduleEntry *tab)
+{
+  uint8_t n = 0;
+  tab[n++] = { 0, OT_STATUS_INTERVAL_MS, 0, false, false, false, 0 };
+  for (uint8_t id : kWrites) tab[n++] = { id, OT_WRITE_INTERVAL_MS, 0, false, true, false, 0 };
+  for (uint8_t id : kTemps)  tab[n++] = { id, OT_TEMP_INTERVAL_MS, 0, false, false, false, 0 };
+  for (uint8_t id : kSlow)   tab[n++] = { id, OT_SLOW_INTERVAL_MS, 0, false, false, false, 0 };
+}
+
+// ---- Simulated OT bus + the OTDirect.ino state the schedulers read ----
+struct Sim {
+  OTScheduleEntry tab[kTableSize];
+  uint32_t now = 0;
+  uint32_t minIntervalMs = 100;         // otMinIntervalMs (MI=)
+  uint32_t lastAnySendMs = 0;           // otLastAnySendMs
+  bool     active = false;              // otMasterRequestActive
+  uint32_t busyUntil = 0;
+  uint8_t  inFlight = 0xFF;             // schedule index of the gateway request, 0xFF = thermostat/none
+  uint8_t  inFlightId = 0;
+  bool     online = true;               // state.otBus.bOnline
+  bool     boilerUp = true;
+  bool     ventSlave = false;           // otIsVentSlave()
+  uint32_t nextThermostat = 0;
+  uint8_t  unknownCount[128] = {};
+  uint64_t busyMs = 0;
+  uint32_t calls = 0;                   // scheduleMasterRequest() invocations
+  uint32_t gatewaySends = 0;
+  std::vector<std::vector<uint32_t>> sendTimes;   // per schedule index
+
+  Sim() : sendTimes(kTableSize) { buildTable(tab); }
+
+  OTScheduleContext ctx() const { return OTScheduleContext{ !online, ventSlave }; }
+
+  bool sendAsync(uint8_t idx)
+  {
+    if (active) return false;
+    active = true;
+    busyUntil = now + 80 + rnd() % 300;
+    lastAnySendMs = now;
+    inFlight = idx;
+    inFlightId = idx == 0xFF ? 0 : tab[idx].msgId;
+    if (idx != 0xFF) {
+      gatewaySends++;
+      sendTimes[idx].push_back(now);
+    }
+    return true;
+  }
+};
+
+// ---- Legacy: round-robin scheduleMasterRequest() (before OTDirectSchedule.h) ----
+struct LegacyScheduler {
+  uint8_t otScheduleIdx = 0;
+  uint64_t examined = 0;
+
+  void onChange(Sim &, uint8_t) {}
+  void onBulkChange(Sim &) {}
+
+  bool awake(const Sim &s, uint32_t &timerDue) const
+  {
+    // DECLARE_TIMER_MS(timerOTSchedule, 100, SKIP_MISSED_TICKS)
+    (void)s;
+    return (int32_t)(s.now - timerDue) >= 0;
+  }
+
+  void run(Sim &s)
+  {
+    if (s.active) return;
+    uint32_t now = s.now;
+    if ((now - s.lastAnySendMs) < s.minIntervalMs) return;
+    bool busOffline = !s.online;
+    uint8_t startIdx = otScheduleIdx;
+    do {
+      OTScheduleEntry &entry = s.tab[otScheduleIdx];
+      const uint8_t idx = otScheduleIdx;
+      otScheduleIdx = (otScheduleIdx + 1) % kTableSize;
+      examined++;
+      if (entry.disabled) continue;
+      if (busOffline && entry.msgId != 0) continue;
+      if (entry.isWrite && !entry.valueSet) continue;
+      uint32_t interval = (busOffline && entry.msgId == 0) ? OT_OFFLINE_RETRY_MS : entry.intervalMs;
+      if ((entry.msgId == 70 || entry.msgId == 71) && s.ventSlave) interval = OT_VENT_FAST_INTERVAL_MS;
+      if ((now - entry.lastSentMs) >= interval) {
+        if (s.sendAsync(idx)) entry.lastSentMs = now;
+        return;
+      }
+    } while (otScheduleIdx != startIdx);
+  }
+};
+
+// ---- Deadline: scheduleMasterRequest() as in OTDirect.ino now ----
+struct DeadlineScheduler {
+  OTDeadlineScheduler<kTableSize> sched;
+  uint32_t sleepStart = 0, sleepMs = 0;
+
+  void onChange(Sim &s, uint8_t i) { sched.touch(s.tab, i, s.now); wake(); }
+  void onBulkChange(Sim &) { sched.markDirty(); wake(); }
+  void wake() { sleepMs = 0; }
+
+  bool awake(const Sim &s, uint32_t &) const { return (s.now - sleepStart) >= sleepMs; }
+
+  void sleep(uint32_t now, uint32_t ms) { sleepStart = now; sleepMs = ms; }
+
+  void run(Sim &s)
+  {
+    if (s.active) return;
+    uint32_t now = s.now;
+    if ((now - s.lastAnySendMs) < s.minIntervalMs) {
+      sleep(now, s.minIntervalMs - (now - s.lastAnySendMs));
+      return;
+    }
+    const OTScheduleContext ctx = s.ctx();
+    int idx = sched.pick(s.tab, kTableSize, ctx, now);
+    if (idx < 0) {
+      sleep(now, sched.msUntilDue(now));
+      return;
+    }
+    verifyPick(s, ctx, (uint8_t)idx);
+    if (s.sendAsync((uint8_t)idx)) {
+      sched.sent(s.tab, (uint8_t)idx, now);
+      verifyHeaps(s);
+      sleep(now, sched.msUntilDue(now));
+    } else {
+      sleep(now, OT_SCHEDULE_RETRY_MS);
+    }
+  }
+
+  // ---- invariants ----
+  bool pickOk = true, heapOk = true;
+  uint32_t picksChecked = 0;
+
+  static int64_t lateness(const OTScheduleEntry &e, const OTScheduleContext &ctx, uint32_t now)
+  {
+    return (int64_t)(uint32_t)(now - e.lastSentMs) - (int64_t)otScheduleInterval(e, ctx);
+  }
+
+  void verifyPick(const Sim &s, const OTScheduleContext &ctx, uint8_t idx)
+  {
+    picksChecked++;
+    const OTScheduleEntry &e = s.tab[idx];
+    if (!otScheduleEligible(e, ctx) || lateness(e, ctx, s.now) < 0) { pickOk = false; return; }
+    const uint8_t k = otScheduleClassOf(e, ctx);
+    const int64_t late = lateness(e, ctx, s.now);
+    for (uint8_t j = 0; j < kTableSize; j++) {
+      const OTScheduleEntry &o = s.tab[j];
+      if (j == idx || !otScheduleEligible(o, ctx)) continue;
+      const int64_t ol = lateness(o, ctx, s.now);
+      if (ol < 0) continue;
+      const uint8_t ok = otScheduleClassOf(o, ctx);
+      if (ok < k) { pickOk = false; return; }   // a higher class had something due
+      // Same class: nothing strictly more overdue (keys clamp at 2^30, where
+      // forced entries all tie and table order / touch order decides).
+      if (ok == k && ol > late && late < 0x3FFFFFFF) { pickOk = false; return; }
+    }
+  }
+
+  void verifyHeaps(const Sim &s)
+  {
+    const OTScheduleContext ctx = sched.ctx;
+    uint8_t seen = 0;
+    for (uint8_t k = 0; k < OT_SCHED_CLASS_COUNT; k++) {
+      for (uint8_t p = 0; p < sched.count[k]; p++) {
+        const uint8_t i = sched.heap[k][p];
+        if (sched.cls[i] != k || sched.heapPos[i] != p) heapOk = false;
+        if (p > 0) {
+          const uint8_t parent = sched.heap[k][(p - 1) / 2];
+          const int32_t d = (int32_t)(sched.due[parent] - sched.due[i]);
+          if (d > 0 || (d == 0 && parent > i)) heapOk = false;
+        }
+        seen++;
+      }
+    }
+    uint8_t eligible = 0;
+    for (uint8_t i = 0; i < kTableSize; i++) {
+      const bool el = otScheduleEligible(s.tab[i], ctx);
+      if (el) eligible++;
+      if (el != sched.queued(i)) heapOk = false;
+    }
+    if (seen != eligible) heapOk = false;
+  }
+};
+
+struct Result {
+  uint32_t statusMaxGap = 0;
+  uint32_t statusGapsOver1s = 0;
+  uint32_t calls = 0;
+  uint32_t sends = 0;
+  double   busy = 0;
+  double   ratio[OT_SCHED_CLASS_COUNT] = {};   // mean achieved / requested interval
+  uint64_t examined = 0;
+};
+
+template <typename S>
+static Result replay(S &sch, uint32_t minutes, uint64_t seed)
+{
+  g_rng = seed;
+  Sim s;
+  const uint32_t start = 0xFFFFFFFFu - 10u * 60000u;   // wraps 10 minutes in
+  const uint32_t total = minutes * 60000u;
+  const uint32_t outageAt = total / 3, outageLen = 120000;
+  const uint32_t ventAt = total / 2;
+  uint32_t timerDue = start;
+  s.now = start;
+  s.lastAnySendMs = start - 1000;
+  s.nextThermostat = start + 500;
+  for (uint8_t i = 0; i < kTableSize; i++) s.tab[i].lastSentMs = 0;
+  // Writes with a value from the first control pass (MsgID 1, 16, 24).
+  for (uint8_t i = 0; i < kTableSize; i++) {
+    if (s.tab[i].isWrite && (s.tab[i].msgId == 1 || s.tab[i].msgId == 16 || s.tab[i].msgId == 24)) {
+      s.tab[i].valueSet = true;
+    }
+  }
+  sch.onBulkChange(s);
+
+  uint32_t lastStatus = 0;
+  bool haveStatus = false;
+  Result r;
+  for (uint32_t t = 0; t < total; t++, s.now++) {
+    s.boilerUp = !(t >= outageAt && t < outageAt + outageLen);
+    s.ventSlave = t >= ventAt;
+    if (s.active) s.busyMs++;
+
+    // Response (or timeout) for the request on the bus.
+    if (s.active && (int32_t)(s.now - s.busyUntil) >= 0) {
+      s.active = false;
+      if (!s.boilerUp) {
+        s.online = false;
+      } else {
+        s.online = true;
+        const uint8_t id = s.inFlightId;
+        if (s.inFlight != 0xFF && id != 0 && unsupported(id) && ++s.unknownCount[id] >= 3) {
+          for (uint8_t i = 0; i < kTableSize; i++) {
+            if (s.tab[i].msgId == id && !s.tab[i].disabled) {
+              s.tab[i].disabled = true;
+              sch.onChange(s, i);
+              break;
+            }
+          }
+        }
+      }
+    }
+
+    // Thermostat frame forwarded ahead of the scheduler.
+    if (!s.active && (int32_t)(s.now - s.nextThermostat) >= 0) {
+      s.sendAsync(0xFF);
+      s.nextThermostat = s.now + 900 + rnd() % 200;
+    }
+
+    // Operator / control traffic.
+    if (rnd() % 20000 == 0) {
+      const uint8_t i = (uint8_t)(rnd() % kTableSize);
+      switch (rnd() % 4) {
+        case 0: s.tab[i].lastSentMs = 0; s.tab[i].disabled = false; break;            // PM=
+        case 1: if (i != 0) s.tab[i].disabled = true; break;                          // DA=
+        case 2: s.tab[i].disabled = false; s.unknownCount[s.tab[i].msgId] = 0; break; // EN=
+        case 3: if (s.tab[i].isWrite) s.tab[i].valueSet = !s.tab[i].valueSet; break;  // set / clear write
+      }
+      sch.onChange(s, i);
+    }
+
+    if (!s.active && sch.awake(s, timerDue)) {
+      timerDue += 100;
+      s.calls++;
+      const uint32_t before = s.gatewaySends;
+      sch.run(s);
+      if (s.gatewaySends != before && s.inFlight == 0) {
+        if (haveStatus && s.online) {
+          const uint32_t gap = s.now - lastStatus;
+          if (gap > r.statusMaxGap) r.statusMaxGap = gap;
+          if (gap > 1000) r.statusGapsOver1s++;
+        }
+        lastStatus = s.now;
+        haveStatus = s.online;
+      }
+    }
+    // The legacy timer skips missed ticks.
+    if ((int32_t)(s.now - timerDue) > 100) timerDue = s.now;
+  }
+
+  // Achieved vs requested, steady state online, before the vent switch.
+  const OTScheduleContext ctx = { false, false };
+  double sum[OT_SCHED_CLASS_COUNT] = {};
+  uint32_t n[OT_SCHED_CLASS_COUNT] = {};
+  for (uint8_t i = 0; i < kTableSize; i++) {
+    const std::vector<uint32_t> &v = s.sendTimes[i];
+    uint32_t prev = 0, gaps = 0;
+    uint64_t acc = 0;
+    bool havePrev = false;
+    for (uint32_t ts : v) {
+      const uint32_t rel = ts - start;
+      if (rel >= outageAt) break;
+      if (havePrev && rel > 120000) { acc += ts - prev; gaps++; }
+      prev = ts;
+      havePrev = true;
+    }
+    if (!gaps) continue;
+    const uint8_t k = otScheduleClassOf(s.tab[i], ctx);
+    sum[k] += ((double)acc / gaps) / otScheduleInterval(s.tab[i], ctx);
+    n[k]++;
+  }
+  for (uint8_t k = 0; k < OT_SCHED_CLASS_COUNT; k++) r.ratio[k] = n[k] ? sum[k] / n[k] : 0;
+  r.calls = s.calls;
+  r.sends = s.gatewaySends;
+  r.busy = (double)s.busyMs / total;
+  return r;
+}
+
+int main(int argc, char **argv)
+{
+  const uint32_t minutes = argc > 1 ? (uint32_t)atol(argv[1]) : 60;
+  const uint64_t seed = 0x5EED0F0D1234ull;
+  printf("OTDirect schedule replay: %u entries, %u simulated minutes\n\n", (unsigned)kTableSize, (unsigned)minutes);
+
+  LegacyScheduler legacy;
+  Result a = replay(legacy, minutes, seed);
+  a.examined = legacy.examined;
+  DeadlineScheduler edf;
+  Result b = replay(edf, minutes, seed);
+
+  static const char *const kClass[] = { "status", "write", "vent_fast", "poll", "slow" };
+  printf("%-28s %14s %14s\n", "", "round-robin", "deadline");
+  printf("%-28s %14u %14u\n", "scheduler calls", (unsigned)a.calls, (unsigned)b.calls);
+  printf("%-28s %14llu %14s\n", "table entries examined", (unsigned long long)a.examined, "-");
+  printf("%-28s %14u %14u\n", "gateway requests", (unsigned)a.sends, (unsigned)b.sends);
+  printf("%-28s %13.1f%% %13.1f%%\n", "bus busy", a.busy * 100, b.busy * 100);
+  printf("%-28s %12ums %12ums\n", "status max gap", (unsigned)a.statusMaxGap, (unsigned)b.statusMaxGap);
+  printf("%-28s %14u %14u\n", "status gaps > 1 s", (unsigned)a.statusGapsOver1s, (unsigned)b.statusGapsOver1s);
+  for (uint8_t k = 0; k < OT_SCHED_CLASS_COUNT; k++) {
+    if (!a.ratio[k] && !b.ratio[k]) continue;
+    char label[40];
+    snprintf(label, sizeof(label), "achieved/requested %s", kClass[k]);
+    printf("%-28s %14.3f %14.3f\n", label, a.ratio[k], b.ratio[k]);
+  }
+  printf("\n");
+
+  char name[96];
+  snprintf(name, sizeof(name), "every deadline pick legal (%u picks)", (unsigned)edf.picksChecked);
+  check(name, edf.pickOk && edf.picksChecked > 0);
+  check("heap invariants after every send and touch", edf.heapOk);
+  check("status max gap not longer than round-robin", b.statusMaxGap <= a.statusMaxGap);
+  check("fewer status gaps over 1 s", b.statusGapsOver1s <= a.statusGapsOver1s);
+  check("fewer scheduler calls", b.calls < a.calls);
+  bool rates = true;
+  for (uint8_t k = 0; k < OT_SCHED_CLASS_COUNT; k++) {
+    if (a.ratio[k] && b.ratio[k] > a.ratio[k] * 1.02) rates = false;
+  }
+  check("no class polled slower than round-robin", rates);
+  check("no more gateway requests than the interval budget allows", b.sends <= a.sends * 11 / 10);
+
+  // msUntilDue / pick on a tiny table, wrap-safe.
+  {
+    OTDeadlineScheduler<3> t;
+    OTScheduleEntry tab[3] = { { 0, 800, 0, false, false, false, 0 },
+                               { 25, 10000, 0, false, false, false, 0 },
+                               { 1, 15000, 0, false, true, false, 0 } };
+    const OTScheduleContext on = { false, false };
+    const uint32_t now = 0xFFFFFF00u;
+    tab[0].lastSentMs = now - 100;
+    tab[1].lastSentMs = now - 9000;
+    t.rebuild(tab, 3, on, now);
+    check("nothing due: pick -1, wake at status deadline",
+          t.pick(tab, 3, on, now) == -1 && t.msUntilDue(now) == 700);
+    check("write without value not queued", !t.queued(2));
+    check("status first once both due, across the wrap", t.pick(tab, 3, on, now + 1000) == 0);
+    t.sent(tab, 0, now + 1000);
+    check("then the poll", t.pick(tab, 3, on, now + 1000) == 1);
+    tab[2].valueSet = true;
+    t.touch(tab, 2, now + 1000);
+    check("touched write queued in write class", t.queued(2) && t.cls[2] == OT_SCHED_WRITE);
+    const OTScheduleContext off = { true, false };
+    check("offline: only status, at the retry interval",
+          t.pick(tab, 3, off, now + 1000) == -1 && t.queued(0) && !t.queued(1) && !t.queued(2) &&
+          t.msUntilDue(now + 1000) == OT_OFFLINE_RETRY_MS);
+  }
+
+  printf("\n%s (%d failure%s)\n", failures ? "FAILED" : "ALL PASSED", failures, failures == 1 ? "" : "s");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,869 @@
+/**
+ * Host test + benchmark for the weather JSON parsers (SATweather.ino) and
+ * the pull tokenizer behind them (JsonPull.h).
+ *
+ * The old weatherParseStream() / weatherParseOwmTemp() pulled the HTTP body
+ * one byte at a time through wstreamGet()/wstreamPeek(), and only returned
+ * once the 5 s read timeout expired or the server closed the socket. This
+ * file lifts both the legacy byte parsers and the current JsonPull-based
+ * ones (verbatim, against a simulated WiFiClient/HTTPClient and a clock
+ * that only moves while a yield() waits for data) and checks:
+ *
+ *   1. Tokenizer: the event stream (type, path, index, text) is the same
+ *      whatever the read boundaries: a cut at every byte offset, 1-byte
+ *      reads, reads interleaved with "nothing yet", and a 32-byte buffer.
+ *      Escapes, over-long tokens, nesting beyond MaxDepth and skip().
+ *   2. The parsers fill the same weather fields and forecast arrays as the
+ *      legacy code on saved Open-Meteo and OpenWeatherMap responses
+ *      (fixtures/weather_openmeteo.json, fixtures/weather_owm.json), for TCP
+ *      segment sizes 1460..1 B, with and without Content-Length, kept-alive
+ *      or closed.
+ *   3. Simulated wall time of a fetch on a kept-alive connection (the
+ *      HTTPClient default): legacy waits out the read timeout after the
+ *      last byte, JsonPull stops at the closing brace. Fails if the new
+ *      parser is not done within 1 ms of the last segment.
+ *   4. Host ns per response and WiFiClient calls per response with the body
+ *      already buffered.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/bench_weather_json.cpp -o tests/bench_weather_json.out
+ *   ./tests/bench_weather_json.out [openmeteo.json] [owm.json]
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ---- Arduino compatibility stubs (host-only) ----
+#define PROGMEM
+#define PSTR(s) (s)
+#define strcmp_P strcmp
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+
+#include "../src/OTGW-firmware/JsonPull.h"
+
+static int failures = 0;
+
+static void check(const char *name, bool ok)
+{
+  printf("%-64s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+// ---------------------------------------------------------------------------
+// Simulated network. A response body arrives in segments of `seg` bytes, one
+// every `gapMs` ms starting at t0. Only a yield() with nothing to read moves
+// the clock (1 ms), so the simulated wall time of a parse is the time it
+// spent waiting for data; yields between buffered bytes are free.
+// ---------------------------------------------------------------------------
+static uint32_t g_nowMs  = 0;
+static bool   (*g_waiting)() = nullptr;
+static uint32_t millis() { return g_nowMs; }
+static void yield() { if (!g_waiting || g_waiting()) g_nowMs++; }
+
+struct SimNet {
+  const char *body;
+  size_t      len;
+  size_t      seg;
+  uint32_t    t0;
+  uint32_t    gapMs;
+  bool        closeAtEnd;      // server closes after the last byte (else keep-alive)
+  bool        sendLength;      // Content-Length known
+
+  size_t arrived() const {
+    if (g_nowMs < t0) return 0;
+    const size_t segs = gapMs ? (size_t)((g_nowMs - t0) / gapMs) + 1 : (size_t)-1 / seg;
+    const size_t n = segs * seg;
+    return n < len ? n : len;
+  }
+  uint32_t lastArrivalMs() const {
+    const size_t segs = (len + seg - 1) / seg;
+    return t0 + (uint32_t)(segs - 1) * gapMs;
+  }
+};
+
+class WiFiClient;
+static WiFiClient *g_client = nullptr;
+
+class WiFiClient {
+public:
+  explicit WiFiClient(const SimNet *n) : net(n) { g_client = this; }
+  int available() { calls++; return (int)(net->arrived() - pos); }
+  int read() { calls++; return pos < net->arrived() ? (uint8_t)net->body[pos++] : -1; }
+  int peek() { calls++; return pos < net->arrived() ? (uint8_t)net->body[pos] : -1; }
+  int read(uint8_t *dst, size_t n) {
+    calls++;
+    const size_t a = net->arrived() - pos;
+    if (n > a) n = a;
+    memcpy(dst, net->body + pos, n);
+    pos += n;
+    return (int)n;
+  }
+  const SimNet *net;
+  size_t   pos   = 0;
+  uint64_t calls = 0;
+};
+
+static bool clientWaiting() { return g_client && g_client->pos >= g_client->net->arrived(); }
+
+class HTTPClient {
+public:
+  explicit HTTPClient(WiFiClient *c) : client(c) {}
+  // Arduino HTTPClient: still "connected" while unread bytes are buffered.
+  bool connected() {
+    client->calls++;
+    const SimNet *n = client->net;
+    return !(n->closeAtEnd && n->arrived() == n->len) || client->pos < n->len;
+  }
+  int getSize() { return client->net->sendLength ? (int)client->net->len : -1; }
+  WiFiClient *client;
+};
+
+// ---------------------------------------------------------------------------
+// Parser output, same names as the firmware so the parsers below compile
+// unchanged.
+// ---------------------------------------------------------------------------
+#define HAS_WEATHER_FORECAST 1
+
+struct WeatherState {
+  float    fTemperature, fApparentTemp, fHumidity, fWindSpeed, fCloudCover;
+  float    fWindDirection, fWindGusts, fPressureMsl, fPrecipitation, fRain, fSnowfall;
+  uint16_t iWeatherCode;
+  bool     bIsDay;
+};
+static struct { struct { WeatherState weather; } sat; } state;
+
+static const uint8_t WEATHER_FORECAST_HOURS = 24;
+static float   _weather_forecastTemp[WEATHER_FORECAST_HOURS];
+static float   _weather_forecastDewPt[WEATHER_FORECAST_HOURS];
+static uint8_t _weather_forecastCloud[WEATHER_FORECAST_HOURS];
+static uint8_t _weather_forecastPrecipProb[WEATHER_FORECAST_HOURS];
+static uint8_t _weather_forecastCount = 0;
+
+struct WeatherResult {
+  WeatherState w;
+  float   temp[WEATHER_FORECAST_HOURS], dewpt[WEATHER_FORECAST_HOURS];
+  uint8_t cloud[WEATHER_FORECAST_HOURS], precip[WEATHER_FORECAST_HOURS];
+  uint8_t count;
+};
+
+static void resetOutputs()
+{
+  const float nan = std::nanf("");
+  state.sat.weather = WeatherState{ nan, nan, nan, nan, nan, nan, nan, nan, nan, nan, nan, 0xFFFF, false };
+  for (uint8_t i = 0; i < WEATHER_FORECAST_HOURS; i++) {
+    _weather_forecastTemp[i] = nan; _weather_forecastDewPt[i] = nan;
+    _weather_forecastCloud[i] = 0xEE; _weather_forecastPrecipProb[i] = 0xEE;
+  }
+  _weather_forecastCount = 0xEE;
+}
+
+static WeatherResult captureOutputs()
+{
+  WeatherResult r;
+  r.w = state.sat.weather;
+  memcpy(r.temp, _weather_forecastTemp, sizeof(r.temp));
+  memcpy(r.dewpt, _weather_forecastDewPt, sizeof(r.dewpt));
+  memcpy(r.cloud, _weather_forecastCloud, sizeof(r.cloud));
+  memcpy(r.precip, _weather_forecastPrecipProb, sizeof(r.precip));
+  r.count = _weather_forecastCount;
+  return r;
+}
+
+static bool sameF(float a, float b) { return (std::isnan(a) && std::isnan(b)) || a == b; }
+
+static bool sameResult(const WeatherResult &a, const WeatherResult &b)
+{
+  const WeatherState &x = a.w, &y = b.w;
+  bool ok = sameF(x.fTemperature, y.fTemperature) && sameF(x.fApparentTemp, y.fApparentTemp) &&
+            sameF(x.fHumidity, y.fHumidity) && sameF(x.fWindSpeed, y.fWindSpeed) &&
+            sameF(x.fCloudCover, y.fCloudCover) && sameF(x.fWindDirection, y.fWindDirection) &&
+            sameF(x.fWindGusts, y.fWindGusts) && sameF(x.fPressureMsl, y.fPressureMsl) &&
+            sameF(x.fPrecipitation, y.fPrecipitation) && sameF(x.fRain, y.fRain) &&
+            sameF(x.fSnowfall, y.fSnowfall) && x.iWeatherCode == y.iWeatherCode && x.bIsDay == y.bIsDay &&
+            a.count == b.count;
+  for (uint8_t i = 0; ok && i < WEATHER_FORECAST_HOURS; i++) {
+    ok = sameF(a.temp[i], b.temp[i]) && sameF(a.dewpt[i], b.dewpt[i]) &&
+         a.cloud[i] == b.cloud[i] && a.precip[i] == b.precip[i];
+  }
+  return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Legacy byte-at-a-time parsers, lifted from SATweather.ino before JsonPull.
+// ---------------------------------------------------------------------------
+namespace legacy {
+
+static int wstreamGet(WiFiClient* s, HTTPClient* h)
+{
+  uint32_t start = millis();
+  while (!s->available()) {
+    if (millis() - start > 5000UL) return -1;  // millis()-wrap-safe
+    if (!h->connected())           return -1;
+    yield();
+  }
+  return s->read();
+}
+
+static int wstreamPeek(WiFiClient* s, HTTPClient* h)
+{
+  uint32_t start = millis();
+  while (!s->available()) {
+    if (millis() - start > 5000UL) return -1;  // millis()-wrap-safe
+    if (!h->connected())           return -1;
+    yield();
+  }
+  return s->peek();
+}
+
+static void wstreamSkipString(WiFiClient* s, HTTPClient* h)
+{
+  int c;
+  while ((c = wstreamGet(s, h)) >= 0) {
+    if (c == '"') return;
+    if (c == '\\') wstreamGet(s, h);  // skip escaped char
+  }
+}
+
+static void wstreamSkipArray(WiFiClient* s, HTTPClient* h)
+{
+  int depth = 1, c;
+  while ((c = wstreamGet(s, h)) >= 0 && depth > 0) {
+    if      (c == '[') depth++;
+    else if (c == ']') depth--;
+    else if (c == '"') wstreamSkipString(s, h);
+    if (depth > 0) yield();
+  }
+}
+
+static float wstreamReadNumber(WiFiClient* s, HTTPClient* h, char firstChar)
+{
+  char numBuf[20];
+  int  numLen = 0;
+  numBuf[numLen++] = firstChar;
+  while (numLen < (int)sizeof(numBuf) - 1) {   // leave room for '\0' at [sizeof-1]
+    int nc = wstreamPeek(s, h);
+    if (nc < 0) break;
+    char c = (char)nc;
+    if (!((c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E')) break;
+    s->read();           // confirmed number char — consume it
+    numBuf[numLen++] = c;
+  }
+  numBuf[numLen] = '\0';
+  return (float)strtod(numBuf, nullptr);
+}
+
+static void weatherParseStream(WiFiClient* stream, HTTPClient* http)
+{
+  char keyBuf[48];
+  int  keyLen;
+  int  depth        = 0;
+  bool inCurrent    = false;
+  int  currentDepth = 0;
+  bool inHourly    = false;
+  int  hourlyDepth = 0;
+  float*   arrFloat = nullptr;
+  uint8_t* arrU8    = nullptr;
+  uint8_t  arrMax   = 0;
+  uint8_t  arrPos   = 0;
+
+  int ci;
+  while ((ci = wstreamGet(stream, http)) >= 0) {
+    char c = (char)ci;
+
+    if (c == '{') { depth++; continue; }
+    if (c == '}') {
+      if (--depth < currentDepth) inCurrent = false;
+      if (  depth < hourlyDepth)  inHourly  = false;
+      continue;
+    }
+    if (c != '"') continue;  // commas, whitespace — skip
+
+    keyLen = 0;
+    while ((ci = wstreamGet(stream, http)) >= 0 && (char)ci != '"') {
+      if (keyLen < (int)sizeof(keyBuf) - 1) keyBuf[keyLen++] = (char)ci;
+    }
+    keyBuf[keyLen] = '\0';
+
+    while ((ci = wstreamGet(stream, http)) >= 0 && (char)ci != ':');
+    if (ci < 0) break;
+
+    while ((ci = wstreamGet(stream, http)) >= 0 &&
+           ((char)ci == ' ' || (char)ci == '\t' || (char)ci == '\n' || (char)ci == '\r'));
+    if (ci < 0) break;
+    c = (char)ci;
+
+    if (c == '"') {
+      wstreamSkipString(stream, http);
+
+    } else if (c == '{') {
+      depth++;
+      if (strcmp_P(keyBuf, PSTR("current")) == 0) { inCurrent = true; currentDepth = depth; }
+      else if (strcmp_P(keyBuf, PSTR("hourly"))  == 0) { inHourly  = true; hourlyDepth  = depth; }
+
+    } else if (c == '[') {
+      if (inHourly) {
+        arrFloat = nullptr; arrU8 = nullptr; arrMax = 0; arrPos = 0;
+        if      (strcmp_P(keyBuf, PSTR("temperature_2m"))            == 0) { arrFloat = _weather_forecastTemp;        arrMax = WEATHER_FORECAST_HOURS; }
+        else if (strcmp_P(keyBuf, PSTR("dew_point_2m"))              == 0) { arrFloat = _weather_forecastDewPt;       arrMax = WEATHER_FORECAST_HOURS; }
+        else if (strcmp_P(keyBuf, PSTR("cloud_cover"))               == 0) { arrU8    = _weather_forecastCloud;       arrMax = WEATHER_FORECAST_HOURS; }
+        else if (strcmp_P(keyBuf, PSTR("precipitation_probability")) == 0) { arrU8    = _weather_forecastPrecipProb;  arrMax = WEATHER_FORECAST_HOURS; }
+
+        if (arrFloat || arrU8) {
+          while ((ci = wstreamGet(stream, http)) >= 0) {
+            c = (char)ci;
+            if (c == ']') break;
+            if (c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r') continue;
+            if (c == 'n') {                                         // null
+              for (int i = 0; i < 3; i++) wstreamGet(stream, http);  // consume 'ull' after 'n'
+              if (arrPos < arrMax) { if (arrFloat) arrFloat[arrPos++] = 0.0f; else arrU8[arrPos++] = 0; }
+              continue;
+            }
+            if ((c >= '0' && c <= '9') || c == '-') {
+              float val = wstreamReadNumber(stream, http, c);
+              if (arrPos < arrMax) {
+                if (arrFloat) arrFloat[arrPos++] = val;
+                else          arrU8[arrPos++]    = (val < 0 ? 0 : val > 255 ? 255 : (uint8_t)(int)val);
+              }
+            }
+          }
+          if (arrFloat == _weather_forecastTemp) _weather_forecastCount = arrPos;
+        } else {
+          wstreamSkipArray(stream, http);
+        }
+      } else {
+        wstreamSkipArray(stream, http);
+      }
+
+    } else if ((c >= '0' && c <= '9') || c == '-') {
+      float val = wstreamReadNumber(stream, http, c);
+      if (inCurrent) {
+        if      (strcmp_P(keyBuf, PSTR("temperature_2m"))       == 0) state.sat.weather.fTemperature  = val;
+        else if (strcmp_P(keyBuf, PSTR("apparent_temperature")) == 0) state.sat.weather.fApparentTemp  = val;
+        else if (strcmp_P(keyBuf, PSTR("relative_humidity_2m")) == 0) state.sat.weather.fHumidity      = val;
+        else if (strcmp_P(keyBuf, PSTR("wind_speed_10m"))       == 0) state.sat.weather.fWindSpeed     = val;
+        else if (strcmp_P(keyBuf, PSTR("cloud_cover"))          == 0) state.sat.weather.fCloudCover    = val;
+        else if (strcmp_P(keyBuf, PSTR("wind_direction_10m"))   == 0) state.sat.weather.fWindDirection = val;
+        else if (strcmp_P(keyBuf, PSTR("wind_gusts_10m"))       == 0) state.sat.weather.fWindGusts     = val;
+        else if (strcmp_P(keyBuf, PSTR("pressure_msl"))         == 0) state.sat.weather.fPressureMsl   = val;
+        else if (strcmp_P(keyBuf, PSTR("precipitation"))        == 0) state.sat.weather.fPrecipitation = val;
+        else if (strcmp_P(keyBuf, PSTR("rain"))                 == 0) state.sat.weather.fRain          = val;
+        else if (strcmp_P(keyBuf, PSTR("snowfall"))             == 0) state.sat.weather.fSnowfall      = val;
+        else if (strcmp_P(keyBuf, PSTR("weather_code"))         == 0) state.sat.weather.iWeatherCode   = (uint16_t)val;
+        else if (strcmp_P(keyBuf, PSTR("is_day"))               == 0) state.sat.weather.bIsDay         = (val > 0.0f);
+      }
+    }
+
+    yield();
+  }
+}
+
+static bool weatherParseOwmTemp(WiFiClient* stream, HTTPClient* http, float* outTemp)
+{
+  static const char kNeedleMain[] PROGMEM = "\"main\":";
+  static const char kNeedleTemp[] PROGMEM = "\"temp\":";
+
+  const size_t mainLen = sizeof(kNeedleMain) - 1;
+  const size_t tempLen = sizeof(kNeedleTemp) - 1;
+
+  uint8_t mainPos = 0;
+  bool inMain = false;
+  uint8_t tempPos = 0;
+
+  int ci;
+  while ((ci = wstreamGet(stream, http)) >= 0) {
+    char c = (char)ci;
+
+    if (!inMain) {
+      if (c == (char)pgm_read_byte(&kNeedleMain[mainPos])) {
+        if (++mainPos >= mainLen) { inMain = true; }
+      } else {
+        mainPos = (c == (char)pgm_read_byte(&kNeedleMain[0])) ? 1 : 0;
+      }
+      continue;
+    }
+
+    if (c == (char)pgm_read_byte(&kNeedleTemp[tempPos])) {
+      if (++tempPos >= tempLen) {
+        while ((ci = wstreamGet(stream, http)) >= 0) {
+          c = (char)ci;
+          if (!(c == ' ' || c == '\t' || c == '\n' || c == '\r')) break;
+        }
+        if (ci < 0) return false;
+        if (!((c >= '0' && c <= '9') || c == '-' || c == '+')) return false;
+        *outTemp = wstreamReadNumber(stream, http, c);
+        return true;
+      }
+    } else {
+      tempPos = (c == (char)pgm_read_byte(&kNeedleTemp[0])) ? 1 : 0;
+    }
+  }
+
+  return false;
+}
+
+} // namespace legacy
+
+// ---------------------------------------------------------------------------
+// Current parsers, lifted verbatim from SATweather.ino.
+// ---------------------------------------------------------------------------
+namespace pull {
+
+static const uint16_t WEATHER_JSON_BLOCK     = 1460;   // one TCP segment
+static const uint32_t WEATHER_RX_TIMEOUT_MS  = 5000UL; // same budget as http.setTimeout()
+
+struct WeatherHttpSource {
+  WiFiClient* stream;
+  HTTPClient* http;
+  int32_t     remaining;   // body bytes still expected; < 0 = unknown length
+  uint32_t    lastRxMs;
+
+  int read(uint8_t* dst, size_t max) {
+    if (remaining == 0) return -1;
+    const int avail = stream->available();
+    if (avail > 0) {
+      size_t n = ((size_t)avail < max) ? (size_t)avail : max;
+      if (remaining > 0 && (int32_t)n > remaining) n = (size_t)remaining;
+      const int got = stream->read(dst, n);
+      if (got > 0) {
+        lastRxMs = millis();
+        if (remaining > 0) remaining -= got;
+        return got;
+      }
+    }
+    if (!http->connected())                          return -1;
+    if (millis() - lastRxMs > WEATHER_RX_TIMEOUT_MS) return -1;  // millis()-wrap-safe
+    return 0;
+  }
+};
+
+typedef JsonPull<WeatherHttpSource, WEATHER_JSON_BLOCK> WeatherJson;
+
+static void weatherParseStream(WiFiClient* stream, HTTPClient* http)
+{
+  WeatherHttpSource src = { stream, http, (int32_t)http->getSize(), millis() };
+  WeatherJson jp(src);
+#if HAS_WEATHER_FORECAST
+  float*   arrFloat = nullptr;
+  uint8_t* arrU8    = nullptr;
+  uint8_t  arrPos   = 0;
+#endif
+
+  for (;;) {
+    const JsonPullEvent ev = jp.next();
+    if (ev == JSON_PULL_END) break;
+    if (ev == JSON_PULL_MORE) { yield(); continue; }
+
+    switch (ev) {
+      case JSON_PULL_OBJECT:
+        // Only "current" and "hourly" carry data; *_units are strings.
+        if (jp.depth() > 1 && !jp.pathIs(PSTR("current"))
+#if HAS_WEATHER_FORECAST
+            && !jp.pathIs(PSTR("hourly"))
+#endif
+           ) jp.skip();
+        break;
+
+      case JSON_PULL_ARRAY:
+#if HAS_WEATHER_FORECAST
+        arrFloat = nullptr; arrU8 = nullptr; arrPos = 0;
+        if      (jp.pathIs(PSTR("hourly/temperature_2m")))            arrFloat = _weather_forecastTemp;
+        else if (jp.pathIs(PSTR("hourly/dew_point_2m")))              arrFloat = _weather_forecastDewPt;
+        else if (jp.pathIs(PSTR("hourly/cloud_cover")))               arrU8    = _weather_forecastCloud;
+        else if (jp.pathIs(PSTR("hourly/precipitation_probability"))) arrU8    = _weather_forecastPrecipProb;
+        if (!arrFloat && !arrU8) jp.skip();
+#else
+        jp.skip();
+#endif  // HAS_WEATHER_FORECAST
+        break;
+
+#if HAS_WEATHER_FORECAST
+      case JSON_PULL_ARRAY_END:
+        if (arrFloat == _weather_forecastTemp) _weather_forecastCount = arrPos;
+        arrFloat = nullptr; arrU8 = nullptr;
+        break;
+
+      case JSON_PULL_LITERAL:
+        if ((arrFloat || arrU8) && jp.isNull() && arrPos < WEATHER_FORECAST_HOURS) {
+          if (arrFloat) arrFloat[arrPos++] = 0.0f; else arrU8[arrPos++] = 0;
+        }
+        break;
+#endif  // HAS_WEATHER_FORECAST
+
+      case JSON_PULL_NUMBER: {
+        const float val = jp.number();
+#if HAS_WEATHER_FORECAST
+        if (arrFloat || arrU8) {
+          if (arrPos < WEATHER_FORECAST_HOURS) {
+            if (arrFloat) arrFloat[arrPos++] = val;
+            else          arrU8[arrPos++]    = (val < 0 ? 0 : val > 255 ? 255 : (uint8_t)(int)val);
+          }
+          break;
+        }
+#endif  // HAS_WEATHER_FORECAST
+        if (jp.depth() != 2) break;
+        // Core SAT fields — both platforms
+        if      (jp.pathIs(PSTR("current/temperature_2m")))       state.sat.weather.fTemperature  = val;
+        else if (jp.pathIs(PSTR("current/apparent_temperature"))) state.sat.weather.fApparentTemp  = val;
+        else if (jp.pathIs(PSTR("current/relative_humidity_2m"))) state.sat.weather.fHumidity      = val;
+        else if (jp.pathIs(PSTR("current/wind_speed_10m")))       state.sat.weather.fWindSpeed     = val;
+        else if (jp.pathIs(PSTR("current/cloud_cover")))          state.sat.weather.fCloudCover    = val;
+#if HAS_WEATHER_FORECAST
+        // Extended fields — ESP32 only (not requested in ESP8266 URL)
+        else if (jp.pathIs(PSTR("current/wind_direction_10m")))   state.sat.weather.fWindDirection = val;
+        else if (jp.pathIs(PSTR("current/wind_gusts_10m")))       state.sat.weather.fWindGusts     = val;
+        else if (jp.pathIs(PSTR("current/pressure_msl")))         state.sat.weather.fPressureMsl   = val;
+        else if (jp.pathIs(PSTR("current/precipitation")))        state.sat.weather.fPrecipitation = val;
+        else if (jp.pathIs(PSTR("current/rain")))                 state.sat.weather.fRain          = val;
+        else if (jp.pathIs(PSTR("current/snowfall")))             state.sat.weather.fSnowfall      = val;
+        else if (jp.pathIs(PSTR("current/weather_code")))         state.sat.weather.iWeatherCode   = (uint16_t)val;
+        else if (jp.pathIs(PSTR("current/is_day")))               state.sat.weather.bIsDay         = (val > 0.0f);
+#endif  // HAS_WEATHER_FORECAST
+        break;
+      }
+
+      default:   // keys, strings, true/false — not needed for weather fields
+        break;
+    }
+  }
+}
+
+static bool weatherParseOwmTemp(WiFiClient* stream, HTTPClient* http, float* outTemp)
+{
+  WeatherHttpSource src = { stream, http, (int32_t)http->getSize(), millis() };
+  WeatherJson jp(src);
+
+  for (;;) {
+    const JsonPullEvent ev = jp.next();
+    if (ev == JSON_PULL_END) return false;
+    if (ev == JSON_PULL_MORE) { yield(); continue; }
+
+    if (ev == JSON_PULL_NUMBER && jp.pathIs(PSTR("main/temp"))) {
+      *outTemp = jp.number();
+      return true;
+    }
+    if ((ev == JSON_PULL_OBJECT || ev == JSON_PULL_ARRAY) &&
+        jp.depth() > 1 && !jp.pathIs(PSTR("main"))) jp.skip();
+  }
+}
+
+} // namespace pull
+
+// ---------------------------------------------------------------------------
+// 1. Tokenizer event stream vs read boundaries
+// ---------------------------------------------------------------------------
+struct ChunkSource {
+  explicit ChunkSource(const std::string *d) : doc(d) {}
+  const std::string *doc;
+  std::vector<size_t> cuts;   // read boundaries (sorted); no cut = one read
+  size_t pos = 0;
+  size_t cutIdx = 0;
+  size_t maxRead = (size_t)-1;
+  bool   starve = false;      // return "nothing yet" before every read
+  bool   starved = false;
+  uint32_t reads = 0;
+
+  int read(uint8_t *dst, size_t max) {
+    if (pos >= doc->size()) return -1;
+    if (starve && !starved) { starved = true; return 0; }
+    starved = false;
+    size_t end = doc->size();
+    while (cutIdx < cuts.size() && cuts[cutIdx] <= pos) cutIdx++;
+    if (cutIdx < cuts.size()) end = cuts[cutIdx];
+    size_t n = end - pos;
+    if (n > max) n = max;
+    if (n > maxRead) n = maxRead;
+    memcpy(dst, doc->data() + pos, n);
+    pos += n;
+    reads++;
+    return (int)n;
+  }
+};
+
+template <uint16_t N, uint8_t D = 8>
+static std::string renderEvents(ChunkSource &src, uint32_t *moreCount = nullptr)
+{
+  static const char kCode[] = "-E{}[]KSNL";
+  JsonPull<ChunkSource, N, D> jp(src);
+  std::string out;
+  char tmp[48];
+  for (int guard = 0; guard < 1000000; guard++) {
+    const JsonPullEvent ev = jp.next();
+    if (ev == JSON_PULL_MORE) { if (moreCount) (*moreCount)++; continue; }
+    out += kCode[ev];
+    out += ' ';
+    out += jp.path();
+    snprintf(tmp, sizeof(tmp), " #%u d%u ", jp.index(), jp.depth());
+    out += tmp;
+    if (ev >= JSON_PULL_KEY) {
+      out.append(jp.text(), jp.length());
+      if (jp.truncated()) out += "<trunc>";
+    }
+    if (ev == JSON_PULL_NUMBER) { snprintf(tmp, sizeof(tmp), " =%g", (double)jp.number()); out += tmp; }
+    out += '\n';
+    if (ev == JSON_PULL_END) break;
+  }
+  return out;
+}
+
+static bool readFile(const char *path, std::string &out)
+{
+  FILE *f = fopen(path, "rb");
+  if (!f) return false;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+static void tokenizerChecks(const std::string &om, const std::string &owm)
+{
+  for (const std::string *doc : { &om, &owm }) {
+    const char *tag = (doc == &om) ? "open-meteo" : "owm";
+    ChunkSource ref{ doc };
+    const std::string want = renderEvents<4096>(ref);
+
+    bool allCuts = true;
+    for (size_t cut = 1; cut < doc->size(); cut++) {
+      ChunkSource s{ doc }; s.cuts = { cut };
+      if (renderEvents<64>(s) != want) { allCuts = false; printf("  %s: cut at %zu differs\n", tag, cut); break; }
+    }
+    char name[96];
+    snprintf(name, sizeof(name), "%s: same events for a read cut at every offset", tag);
+    check(name, allCuts);
+
+    ChunkSource one{ doc }; one.maxRead = 1;
+    snprintf(name, sizeof(name), "%s: same events with 1-byte reads", tag);
+    check(name, renderEvents<64>(one) == want);
+
+    ChunkSource st{ doc }; st.maxRead = 7; st.starve = true;
+    uint32_t more = 0;
+    const std::string got = renderEvents<32>(st, &more);
+    snprintf(name, sizeof(name), "%s: same events, 32 B buffer, 'nothing yet' before reads", tag);
+    check(name, got == want && more > 0);
+
+    ChunkSource blk{ doc };
+    renderEvents<1460>(blk);
+    snprintf(name, sizeof(name), "%s: %zu B body read in %u block(s) of <= 1460 B", tag, doc->size(), blk.reads);
+    check(name, blk.reads == (doc->size() + 1459) / 1460);
+  }
+
+  {
+    const std::string doc = "{\"a\":\"x\\\"y\\\\\",\"b\":[1,-2.5e1,true,null,{\"c\":false}],\"d\":{\"e\":{\"f\":7}}} trailing";
+    ChunkSource s{ &doc };
+    const std::string got = renderEvents<64>(s);
+    const std::string want =
+      "{  #0 d1 \n"
+      "K a #0 d1 a\n"
+      "S a #0 d1 x\\\"y\\\\\n"
+      "K b #0 d1 b\n"
+      "[ b #0 d2 \n"
+      "N b #0 d2 1 =1\n"
+      "N b #1 d2 -2.5e1 =-25\n"
+      "L b #2 d2 true\n"
+      "L b #3 d2 null\n"
+      "{ b #4 d3 \n"
+      "K b/c #4 d3 c\n"
+      "L b/c #0 d3 false\n"
+      "} b #0 d2 \n"
+      "] b #0 d1 \n"
+      "K d #0 d1 d\n"
+      "{ d #0 d2 \n"
+      "K d/e #0 d2 e\n"
+      "{ d/e #0 d3 \n"
+      "K d/e/f #0 d3 f\n"
+      "N d/e/f #0 d3 7 =7\n"
+      "} d/e #0 d2 \n"
+      "} d #0 d1 \n"
+      "}  #0 d0 \n"
+      "E  #0 d0 \n";
+    check("escapes, literals, array index, nested paths, stops at root close", got == want);
+    if (got != want) printf("%s", got.c_str());
+    check("nothing read past the root value", s.pos <= doc.size());
+  }
+
+  {
+    const std::string doc = "{\"long\":\"" + std::string(100, 'x') + "\",\"n\":12345678901234567890123456789012345,\"k\":1}";
+    ChunkSource s{ &doc }; s.maxRead = 5;
+    const std::string got = renderEvents<32>(s);
+    const bool ok = got.find("S long #0 d1 <trunc>\n") != std::string::npos &&
+                    got.find("N n #0 d1 <trunc> =0\n") != std::string::npos &&
+                    got.find("N k #0 d1 1 =1\n") != std::string::npos;
+    check("token longer than the buffer: truncated, parse continues", ok);
+    if (!ok) printf("%s", got.c_str());
+  }
+
+  {
+    const std::string doc = "{\"a\":{\"b\":[[[[[[[[{\"deep\":1}]]]]]]]],\"c\":2},\"z\":3}";
+    ChunkSource s{ &doc };
+    const std::string got = renderEvents<64, 4>(s);
+    const bool ok = got.find("N a/c #0 d2 2 =2\n") != std::string::npos &&
+                    got.find("N z #0 d1 3 =3\n") != std::string::npos &&
+                    got.find("deep #") == std::string::npos;
+    check("nesting beyond MaxDepth: no path there, path restored after", ok);
+    if (!ok) printf("%s", got.c_str());
+  }
+
+  {
+    const std::string doc = "{\"skip\":{\"x\":[1,2,{\"y\":\"]}\"}]},\"arr\":[[1,2],3],\"keep\":4}";
+    ChunkSource s{ &doc };
+    JsonPull<ChunkSource, 64> jp(s);
+    std::string seen;
+    for (;;) {
+      const JsonPullEvent ev = jp.next();
+      if (ev == JSON_PULL_END) break;
+      if ((ev == JSON_PULL_OBJECT && jp.pathIs("skip")) || (ev == JSON_PULL_ARRAY && jp.depth() == 3)) jp.skip();
+      if (ev == JSON_PULL_NUMBER) { seen += jp.path(); seen += '='; seen.append(jp.text(), jp.length()); seen += ' '; }
+    }
+    check("skip() drops the subtree and its end event only", seen == "arr=3 keep=4 ");
+    if (seen != "arr=3 keep=4 ") printf("  got: %s\n", seen.c_str());
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 2/3. Parsers vs legacy on the simulated network
+// ---------------------------------------------------------------------------
+struct FetchRun {
+  WeatherResult out;
+  bool     owmOk;
+  float    owmTemp;
+  uint32_t wallMs;       // simulated, from request to parser return
+  uint64_t calls;        // WiFiClient + HTTPClient calls
+};
+
+template <bool Legacy>
+static FetchRun runOpenMeteo(const SimNet &net)
+{
+  g_nowMs = 0;
+  resetOutputs();
+  WiFiClient c(&net);
+  HTTPClient h(&c);
+  if (Legacy) legacy::weatherParseStream(&c, &h);
+  else        pull::weatherParseStream(&c, &h);
+  return FetchRun{ captureOutputs(), false, 0.0f, g_nowMs, c.calls };
+}
+
+template <bool Legacy>
+static FetchRun runOwm(const SimNet &net)
+{
+  g_nowMs = 0;
+  WiFiClient c(&net);
+  HTTPClient h(&c);
+  float t = NAN;
+  const bool ok = Legacy ? legacy::weatherParseOwmTemp(&c, &h, &t) : pull::weatherParseOwmTemp(&c, &h, &t);
+  FetchRun r{};
+  r.owmOk = ok; r.owmTemp = t; r.wallMs = g_nowMs; r.calls = c.calls;
+  return r;
+}
+
+static void parserChecks(const std::string &om, const std::string &owm)
+{
+  static const size_t kSegs[] = { 1460, 536, 64, 7, 1 };
+  bool omSame = true, owmSame = true, omFilled = true;
+  for (size_t seg : kSegs) {
+    for (int variant = 0; variant < 4; variant++) {
+      const bool closeAtEnd = variant & 1, sendLength = variant & 2;
+      SimNet n1{ om.data(), om.size(), seg, 30, seg >= 64 ? 20u : 0u, closeAtEnd, sendLength };
+      const FetchRun a = runOpenMeteo<true>(n1), b = runOpenMeteo<false>(n1);
+      if (!sameResult(a.out, b.out)) { omSame = false; printf("  open-meteo differs: seg %zu variant %d\n", seg, variant); }
+      if (b.out.count != 24 || std::isnan(b.out.w.fTemperature) || b.out.w.iWeatherCode == 0xFFFF) omFilled = false;
+
+      SimNet n2{ owm.data(), owm.size(), seg, 30, seg >= 64 ? 20u : 0u, closeAtEnd, sendLength };
+      const FetchRun c = runOwm<true>(n2), d = runOwm<false>(n2);
+      if (c.owmOk != d.owmOk || c.owmTemp != d.owmTemp || !d.owmOk) { owmSame = false; printf("  owm differs: seg %zu variant %d\n", seg, variant); }
+    }
+  }
+  check("open-meteo: same fields/forecast as legacy (5 segmentations x 4)", omSame);
+  check("open-meteo: all current fields and 24 forecast hours filled", omFilled);
+  check("owm: same main.temp as legacy (5 segmentations x 4)", owmSame);
+
+  // A body with a "main" string before main{} and members out of order.
+  {
+    const std::string doc = "{\"weather\":[{\"main\":\"Clear\",\"temp\":99}],\"wind\":{\"temp\":-1},\"main\":{\"feels_like\":1.5,\"temp\":-3.25}}";
+    SimNet n{ doc.data(), doc.size(), 1460, 0, 0, true, true };
+    const FetchRun r = runOwm<false>(n);
+    check("owm: main/temp picked by path, not first \"temp\" seen", r.owmOk && r.owmTemp == -3.25f);
+  }
+
+  // Wall time, kept-alive connection, body in 1460 B segments 20 ms apart.
+  printf("\n  simulated fetch wall time (keep-alive, 1460 B segments every 20 ms, first at 30 ms):\n");
+  printf("  %-12s %10s %10s %10s %12s\n", "body", "last byte", "legacy", "JsonPull", "");
+  bool inTime[2][2];
+  for (int which = 0; which < 2; which++) {
+    const std::string &doc = which ? owm : om;
+    for (int withLen = 0; withLen < 2; withLen++) {
+      SimNet n{ doc.data(), doc.size(), 1460, 30, 20, false, withLen != 0 };
+      const FetchRun a = which ? runOwm<true>(n)  : runOpenMeteo<true>(n);
+      const FetchRun b = which ? runOwm<false>(n) : runOpenMeteo<false>(n);
+      printf("  %-12s %8u ms %7u ms %7u ms %12s\n", which ? "owm" : "open-meteo", n.lastArrivalMs(),
+             a.wallMs, b.wallMs, withLen ? "(length)" : "(no length)");
+      inTime[which][withLen] = b.wallMs <= n.lastArrivalMs() + 1;
+    }
+  }
+  printf("\n");
+  check("open-meteo: JsonPull done within 1 ms of the last segment", inTime[0][0] && inTime[0][1]);
+  check("owm: JsonPull done within 1 ms of the last segment", inTime[1][0] && inTime[1][1]);
+}
+
+// ---------------------------------------------------------------------------
+// 4. Host cost per response, body already buffered
+// ---------------------------------------------------------------------------
+template <bool Legacy>
+static void timeParse(const std::string &doc, bool owm, int reps, double &nsPer, uint64_t &callsPer)
+{
+  SimNet n{ doc.data(), doc.size(), 1460, 0, 0, true, true };
+  volatile float sink = 0;
+  uint64_t calls = 0;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) {
+    const FetchRun r = owm ? runOwm<Legacy>(n) : runOpenMeteo<Legacy>(n);
+    sink = sink + r.out.w.fTemperature + r.owmTemp;
+    calls += r.calls;
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  nsPer    = std::chrono::duration<double, std::nano>(t1 - t0).count() / reps;
+  callsPer = calls / (uint64_t)reps;
+}
+
+static void bench(const std::string &om, const std::string &owm, int reps)
+{
+  printf("\n  host cost per response (body buffered, %d reps):\n", reps);
+  printf("  %-12s %12s %12s %14s %14s %8s\n", "body", "legacy ns", "JsonPull ns", "legacy calls", "JsonPull calls", "speedup");
+  for (int which = 0; which < 2; which++) {
+    const std::string &doc = which ? owm : om;
+    double nsL, nsP;
+    uint64_t cL, cP;
+    timeParse<true>(doc, which != 0, reps, nsL, cL);
+    timeParse<false>(doc, which != 0, reps, nsP, cP);
+    printf("  %-12s %12.0f %12.0f %14llu %14llu %7.1fx\n", which ? "owm" : "open-meteo", nsL, nsP,
+           (unsigned long long)cL, (unsigned long long)cP, nsL / nsP);
+    char name[96];
+    snprintf(name, sizeof(name), "%s: <= 4 stream calls per 1460 B block", which ? "owm" : "open-meteo");
+    check(name, cP <= 4 * ((doc.size() + 1459) / 1460) + 2);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const char *omPath  = (argc > 1) ? argv[1] : "tests/fixtures/weather_openmeteo.json";
+  const char *owmPath = (argc > 2) ? argv[2] : "tests/fixtures/weather_owm.json";
+  std::string om, owm;
+  if (!readFile(omPath, om) || !readFile(owmPath, owm)) {
+    fprintf(stderr, "cannot read %s / %s (run from the repo root)\n", omPath, owmPath);
+    return 1;
+  }
+  g_waiting = clientWaiting;
+  printf("=== Weather JSON pull tokenizer test + benchmark ===\n");
+  tokenizerChecks(om, owm);
+  parserChecks(om, owm);
+  bench(om, owm, 20000);
+  printf("=== %s (failures=%d) ===\n", failures ? "SOME TESTS FAILED" : "ALL TESTS PASSED", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,39 @@
+// Host stub of <Arduino.h> (see tests/README.md). The timing and GPIO calls
+// are only declared: a test that reaches them defines them.
+#pragma once
+#include <pgmspace.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <string>
+
+typedef uint8_t byte;
+
+#define LOW     0
+#define HIGH    1
+#define INPUT   0
+#define OUTPUT  1
+
+#define bitRead(value, bit) (((value) >> (bit)) & 1)
+#define bitSet(value, bit)  ((value) |= (1UL << (bit)))
+
+using std::min;
+using std::max;
+
+unsigned long millis();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+
+#define F(s) (s)
+
+class String {
+public:
+  String(const char *s = "") : _s(s) {}
+  const char *c_str() const { return _s.c_str(); }
+  size_t length() const { return _s.size(); }
+  bool operator==(const char *s) const { return _s == s; }
+private:
+  std::string _s;
+};
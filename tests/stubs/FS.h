@@ -0,0 +1,65 @@
+// Host stub of the Arduino core <FS.h> (see tests/README.md). Files live in
+// a directory on the host, set by the test through FS::root.
+#pragma once
+#include <Arduino.h>
+#include <stdio.h>
+#include <memory>
+#include <string>
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+namespace fs {
+
+class File {
+public:
+  File() {}
+  explicit File(FILE *f) : _f(f, fclose) {}
+  explicit operator bool() const { return (bool)_f; }
+  void close() { _f.reset(); }
+  size_t size() const {
+    const long pos = ftell(_f.get());
+    fseek(_f.get(), 0, SEEK_END);
+    const long len = ftell(_f.get());
+    fseek(_f.get(), pos, SEEK_SET);
+    return (size_t)len;
+  }
+  size_t position() const { return (size_t)ftell(_f.get()); }
+  int available() { return (int)(size() - position()); }
+  bool seek(uint32_t pos, SeekMode mode = SeekSet) { return fseek(_f.get(), (long)pos, mode) == 0; }
+  int read() { return fgetc(_f.get()); }
+  size_t read(uint8_t *buf, size_t len) { return fread(buf, 1, len, _f.get()); }
+  size_t write(const uint8_t *buf, size_t len) { return fwrite(buf, 1, len, _f.get()); }
+  void setTimeout(unsigned long ms) { (void)ms; }
+  size_t readBytesUntil(char terminator, char *buf, size_t len) {
+    size_t n = 0;
+    int c;
+    while (n < len && (c = fgetc(_f.get())) >= 0 && c != terminator) buf[n++] = (char)c;
+    return n;
+  }
+private:
+  std::shared_ptr<FILE> _f;
+};
+
+class FS {
+public:
+  // Host directory that serves as the file system root
+  std::string root;
+  // Opening for writing fails while readOnly is set (a full file system)
+  bool readOnly = false;
+  File open(const char *path, const char *mode = "r") {
+    if (readOnly && *mode != 'r') return File();
+    FILE *f = fopen((root + path).c_str(), *mode == 'r' ? "rb" : *mode == 'w' ? "wb" : "ab");
+    return f ? File(f) : File();
+  }
+  File open(const String &path, const char *mode = "r") { return open(path.c_str(), mode); }
+  bool exists(const char *path) {
+    FILE *f = fopen((root + path).c_str(), "rb");
+    if (f) fclose(f);
+    return f != nullptr;
+  }
+  bool remove(const char *path) { return ::remove((root + path).c_str()) == 0; }
+};
+
+} // namespace fs
+
+using fs::File;
@@ -0,0 +1,30 @@
+// Host stub of the Arduino core <HardwareSerial.h> (see tests/README.md).
+// The UART is a pair of byte streams supplied by the test: hostUartRead()
+// and friends are declared here and defined by the test, which plays the
+// device on the other end of the wire.
+#pragma once
+#include <Arduino.h>
+
+#define SERIAL_8N1 0x800001c
+
+int hostUartAvailable();
+int hostUartRead();
+void hostUartWrite(uint8_t c);
+void hostUartFlush();
+
+class HardwareSerial {
+public:
+  explicit HardwareSerial(int uart) { (void)uart; }
+  void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int rxPin = -1, int txPin = -1) {
+    (void)baud; (void)config; (void)rxPin; (void)txPin;
+  }
+  int available() { return hostUartAvailable(); }
+  int read() { return hostUartRead(); }
+  int availableForWrite() { return 128; }
+  size_t write(uint8_t c) { hostUartWrite(c); return 1; }
+  size_t write(const uint8_t *buffer, size_t len) {
+    for (size_t i = 0; i < len; i++) hostUartWrite(buffer[i]);
+    return len;
+  }
+  void flush() { hostUartFlush(); }
+};
@@ -0,0 +1,6 @@
+// Host stub of <LittleFS.h> (see tests/README.md). The test defines
+// LittleFS and points LittleFS.root at a host directory.
+#pragma once
+#include <FS.h>
+
+extern fs::FS LittleFS;
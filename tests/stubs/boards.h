@@ -0,0 +1,6 @@
+// Host stub of the Platform library's boards.h (see tests/README.md): a
+// classic PIC build, so the OT-engine entity prefix is "pic_".
+#pragma once
+#define HAS_PIC               1
+#define HAS_DIRECT_OT         0
+#define HAS_RUNTIME_HW_DETECT 0
@@ -0,0 +1,34 @@
+// Host stub of the Arduino <pgmspace.h> for tests that compile firmware .cpp
+// files directly (see tests/README.md). Flash is ordinary memory on the host.
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P              const char *
+#define PSTR(s)            (s)
+#define pgm_read_byte(p)   (*(const uint8_t *)(p))
+#define pgm_read_word(p)   (*(const uint16_t *)(p))
+#define pgm_read_dword(p)  (*(const uint32_t *)(p))
+#define pgm_read_ptr(p)    (*(const void * const *)(p))
+#define strlen_P           strlen
+#define memcpy_P           memcpy
+#define memcmp_P           memcmp
+#define strcmp_P           strcmp
+#define strcpy_P           strcpy
+#define strncpy_P          strncpy
+#define snprintf_P         snprintf
+
+#if !defined(__GLIBC__) || !(__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 38))
+static inline size_t strlcpy(char *dst, const char *src, size_t size)
+{
+  const size_t srcLen = strlen(src);
+  if (size) {
+    const size_t n = (srcLen >= size) ? size - 1 : srcLen;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return srcLen;
+}
+#endif
@@ -0,0 +1,8 @@
+// Host stub of the Platform library's platform.h (see tests/README.md). The
+// heap figures are plain variables so a test can simulate pressure.
+#pragma once
+#include <stdint.h>
+extern uint32_t hostFreeHeap;
+extern uint32_t hostMaxFreeBlock;
+inline uint32_t platformFreeHeap()     { return hostFreeHeap; }
+inline uint32_t platformMaxFreeBlock() { return hostMaxFreeBlock; }
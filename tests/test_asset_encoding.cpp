@@ -0,0 +1,289 @@
+/**
+ * Host test for the precompressed asset negotiation (AssetEncoding.h).
+ *
+ * serveVersionedAsset() / serveImmutableAsset() / handleFile() in
+ * FSexplorer.ino pick between "<path>" and "<path>.gz" on LittleFS per
+ * request. This file checks:
+ *
+ *   1. assetAcceptsGzip(): real browser headers, no header / empty header,
+ *      q-values (0, 0.000, 0.001, 1.0, malformed), x-gzip, "*" with and
+ *      without an explicit gzip entry, case, whitespace and junk parameters.
+ *   2. assetChooseVariant(): all eight (plain, gz, accepts) combinations.
+ *   3. ETags: identity keeps the pre-gzip format, the gzip variant differs,
+ *      overflow is reported; If-None-Match lists, W/ prefixes, "*", commas
+ *      inside a tag and malformed input.
+ *   4. A request matrix: a conditional GET only gets 304 for the ETag of
+ *      the variant it would be sent now, so a client that switches encoding
+ *      (or a shared cache) never pairs a gzip ETag with an identity body.
+ *   5. assetGzipHeaderLen(): the header build.py writes, FNAME / FEXTRA /
+ *      FCOMMENT / FHCRC, truncation at every byte, bad magic, method and
+ *      reserved flags.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/test_asset_encoding.cpp -o tests/test_asset_encoding.out
+ *   ./tests/test_asset_encoding.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "../src/OTGW-firmware/AssetEncoding.h"
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...)                                  \
+  do {                                                    \
+    checks++;                                             \
+    if (!(cond)) {                                        \
+      failures++;                                         \
+      if (failures <= 20) {                               \
+        std::printf("FAIL %s:%d: ", __FILE__, __LINE__);  \
+        std::printf(__VA_ARGS__);                         \
+        std::printf("\n");                                \
+      }                                                   \
+    }                                                     \
+  } while (0)
+
+static void testAcceptEncoding()
+{
+  struct { const char *ae; bool gzip; } cases[] = {
+    // Browsers
+    { "gzip, deflate",                           true  },
+    { "gzip, deflate, br",                       true  },
+    { "gzip, deflate, br, zstd",                 true  },
+    { "br;q=1.0, gzip;q=0.8, *;q=0.1",           true  },
+    // Non-browsers and refusals
+    { "",                                        false },
+    { "identity",                                false },
+    { "deflate, br",                             false },
+    { "gzip;q=0",                                false },
+    { "gzip;q=0.0",                              false },
+    { "gzip;q=0.000",                            false },
+    { "gzip; q=0, identity",                     false },
+    { "*;q=0",                                   false },
+    { "br, *;q=0",                               false },
+    // q-values
+    { "gzip;q=0.001",                            true  },
+    { "gzip;q=0.5",                              true  },
+    { "gzip;q=1",                                true  },
+    { "gzip;q=1.000",                            true  },
+    { "gzip;Q=0.5",                              true  },
+    { "gzip;q=1.5",                              false },
+    { "gzip;q=0.0001",                           false },
+    { "gzip;q=",                                 false },
+    { "gzip;q=abc",                              false },
+    { "gzip;q=-1",                               false },
+    // Names
+    { "x-gzip",                                  true  },
+    { "GZIP",                                    true  },
+    { "Gzip;q=0.7",                              true  },
+    { "gzipx",                                   false },
+    { "gzi",                                     false },
+    { "xgzip",                                   false },
+    { "*",                                       true  },
+    { "br, *",                                   true  },
+    { "gzip;q=0, *",                             false },   // explicit gzip beats *
+    { "*, gzip;q=0",                             false },
+    { "*;q=0, gzip",                             true  },
+    // Whitespace and parameters
+    { "  gzip  ",                                true  },
+    { "\tgzip\t,deflate",                        true  },
+    { "deflate ,gzip",                           true  },
+    { ",,gzip,,",                                true  },
+    { "gzip ; q = 0",                            false },
+    { "gzip;level=9",                            true  },
+    { "gzip;level=9;q=0",                        false },
+    { "gzip;;q=0",                               false },
+    { "gzip;q",                                  true  },
+    { "deflate;q=0.5 junk, gzip",                true  },
+  };
+  for (auto &c : cases) {
+    CHECK(assetAcceptsGzip(c.ae) == c.gzip, "\"%s\" -> %d, want %d", c.ae, !c.gzip, c.gzip);
+  }
+  CHECK(!assetAcceptsGzip(nullptr), "no header accepted gzip");
+}
+
+static void testVariant()
+{
+  struct { bool plain, gz, acc; AssetVariant v; } cases[] = {
+    { false, false, false, ASSET_SEND_NONE    },
+    { false, false, true,  ASSET_SEND_NONE    },
+    { true,  false, false, ASSET_SEND_PLAIN   },
+    { true,  false, true,  ASSET_SEND_PLAIN   },
+    { false, true,  false, ASSET_SEND_INFLATE },
+    { false, true,  true,  ASSET_SEND_GZIP    },
+    { true,  true,  false, ASSET_SEND_PLAIN   },
+    { true,  true,  true,  ASSET_SEND_GZIP    },
+  };
+  for (auto &c : cases) {
+    CHECK(assetChooseVariant(c.plain, c.gz, c.acc) == c.v, "plain=%d gz=%d accepts=%d -> %d, want %d",
+          c.plain, c.gz, c.acc, assetChooseVariant(c.plain, c.gz, c.acc), c.v);
+  }
+  CHECK(assetVariantCoding(ASSET_SEND_GZIP) == ASSET_CODING_GZIP, "gzip variant coding");
+  CHECK(assetVariantCoding(ASSET_SEND_PLAIN) == ASSET_CODING_IDENTITY, "plain variant coding");
+  CHECK(assetVariantCoding(ASSET_SEND_INFLATE) == ASSET_CODING_IDENTITY, "inflated variant coding");
+
+  char buf[16];
+  CHECK(assetGzPath(buf, sizeof(buf), "/index.js") && strcmp(buf, "/index.js.gz") == 0, "gz path %s", buf);
+  CHECK(!assetGzPath(buf, 12, "/index.js"), "gz path overflow not reported");
+  CHECK(assetGzPath(buf, 13, "/index.js"), "gz path exact fit rejected");
+}
+
+static void testEtag()
+{
+  char id[64], gz[64];
+  CHECK(assetEtagFormat(id, sizeof(id), "a46e95a", "/index.js", ASSET_CODING_IDENTITY), "identity etag");
+  CHECK(strcmp(id, "\"a46e95a-/index.js\"") == 0, "identity etag %s (changed from the pre-gzip format)", id);
+  CHECK(assetEtagFormat(gz, sizeof(gz), "a46e95a", "/index.js", ASSET_CODING_GZIP), "gzip etag");
+  CHECK(strcmp(gz, "\"a46e95a-/index.js-gz\"") == 0, "gzip etag %s", gz);
+  CHECK(!assetEtagFormat(id, 19, "a46e95a", "/index.js", ASSET_CODING_IDENTITY), "etag overflow not reported");
+  CHECK(assetEtagFormat(id, 20, "a46e95a", "/index.js", ASSET_CODING_IDENTITY), "etag exact fit rejected");
+  // The longest LittleFS name the server routes still fits the firmware's buffer.
+  char big[72];
+  CHECK(assetEtagFormat(big, sizeof(big), "0123456789abcdef", "/fonts/jetbrains-mono-400.woff2", ASSET_CODING_GZIP),
+        "longest route etag does not fit 72 bytes");
+
+  const char *e = "\"a46e95a-/index.js\"";
+  struct { const char *inm; bool match; } cases[] = {
+    { "\"a46e95a-/index.js\"",                       true  },
+    { "W/\"a46e95a-/index.js\"",                     true  },
+    { "*",                                           true  },
+    { "\"x\", \"a46e95a-/index.js\"",                true  },
+    { "\"x\",W/\"a46e95a-/index.js\" ",              true  },
+    { "\"a,b\", \"a46e95a-/index.js\"",              true  },
+    { "\"a46e95a-/index.js-gz\"",                    false },
+    { "\"a46e95a-/index.js",                         false },
+    { "a46e95a-/index.js",                           false },
+    { "\"A46E95A-/index.js\"",                       false },
+    { "\"03591d5-/index.js\"",                       false },
+    { "w/\"a46e95a-/index.js\"",                     false },
+    { "",                                            false },
+    { " , ",                                         false },
+    { "junk, \"a46e95a-/index.js\"",                 false },   // malformed entry ends the scan
+  };
+  for (auto &c : cases) {
+    CHECK(assetEtagMatches(c.inm, e) == c.match, "If-None-Match %s -> %d, want %d", c.inm, !c.match, c.match);
+  }
+  CHECK(!assetEtagMatches(nullptr, e), "nullptr If-None-Match matched");
+}
+
+// One conditional GET as serveVersionedAsset() handles it.
+struct Reply { int status; AssetVariant v; char etag[64]; };
+
+static Reply serve(bool plain, bool gz, const char *ae, const char *inm)
+{
+  Reply r{};
+  r.v = assetChooseVariant(plain, gz, assetAcceptsGzip(ae));
+  if (r.v == ASSET_SEND_NONE) { r.status = 404; return r; }
+  assetEtagFormat(r.etag, sizeof(r.etag), "a46e95a", "/v2.js", assetVariantCoding(r.v));
+  r.status = assetEtagMatches(inm, r.etag) ? 304 : 200;
+  return r;
+}
+
+static void testMatrix()
+{
+  const char *aes[] = { nullptr, "", "gzip, deflate, br", "identity", "gzip;q=0", "*" };
+  const bool layouts[][2] = { { true, false }, { false, true }, { true, true } };
+  int n304 = 0;
+  for (auto &l : layouts) {
+    for (const char *ae1 : aes) {
+      const Reply first = serve(l[0], l[1], ae1, nullptr);
+      CHECK(first.status == 200, "first GET %d", first.status);
+      for (const char *ae2 : aes) {
+        const Reply again = serve(l[0], l[1], ae2, first.etag);
+        // 304 exactly when the body would be the same bytes as the one cached.
+        const bool same = assetVariantCoding(again.v) == assetVariantCoding(first.v);
+        CHECK((again.status == 304) == same, "plain=%d gz=%d ae '%s' then '%s': %d",
+              l[0], l[1], ae1 ? ae1 : "(none)", ae2 ? ae2 : "(none)", again.status);
+        if (again.status == 304) n304++;
+        // Inflated and plain bodies are the same bytes and share an ETag.
+        if (again.v == ASSET_SEND_INFLATE || again.v == ASSET_SEND_PLAIN)
+          CHECK(strstr(again.etag, "-gz\"") == nullptr, "identity body with gzip etag %s", again.etag);
+        if (again.v == ASSET_SEND_GZIP)
+          CHECK(strstr(again.etag, "-gz\"") != nullptr, "gzip body with identity etag %s", again.etag);
+      }
+    }
+  }
+  CHECK(n304 > 0, "no 304 in the matrix");
+  CHECK(serve(false, false, "gzip", nullptr).status == 404, "missing asset not 404");
+}
+
+static std::vector<uint8_t> hdr(uint8_t flg)
+{
+  return { 0x1f, 0x8b, 8, flg, 0, 0, 0, 0, 2, 3 };
+}
+
+static void testGzipHeader()
+{
+  // gzip.compress(b"...", mtime=0) as scripts/gzip_assets.py writes it:
+  // no flags, data right after the fixed 10 bytes.
+  const uint8_t plain[] = { 0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03,
+                            0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00 };
+  CHECK(assetGzipHeaderLen(plain, sizeof(plain)) == 10, "plain header %zu", assetGzipHeaderLen(plain, sizeof(plain)));
+  CHECK(assetGzipHeaderLen(plain, 10) == 0, "header with no data accepted");
+
+  // gzip(1) on a file: FNAME.
+  std::vector<uint8_t> named = hdr(ASSET_GZ_FNAME);
+  for (const char *s = "index.js"; *s; s++) named.push_back((uint8_t)*s);
+  named.push_back(0);
+  const size_t namedLen = named.size();
+  named.push_back(0xcb);
+  CHECK(assetGzipHeaderLen(named.data(), named.size()) == namedLen, "FNAME header %zu, want %zu",
+        assetGzipHeaderLen(named.data(), named.size()), namedLen);
+  for (size_t n = 0; n < named.size(); n++) {
+    CHECK(assetGzipHeaderLen(named.data(), n) == 0, "FNAME header truncated at %zu accepted", n);
+  }
+
+  // Every optional field at once.
+  std::vector<uint8_t> all = hdr(ASSET_GZ_FEXTRA | ASSET_GZ_FNAME | ASSET_GZ_FCOMMENT | ASSET_GZ_FHCRC | 0x01);
+  all.push_back(3); all.push_back(0); all.push_back('a'); all.push_back(0); all.push_back('c');   // XLEN 3 (contains a NUL)
+  all.push_back('n'); all.push_back(0);                                                         // FNAME
+  all.push_back('c'); all.push_back('c'); all.push_back(0);                                     // FCOMMENT
+  all.push_back(0x12); all.push_back(0x34);                                                     // FHCRC
+  const size_t allLen = all.size();
+  all.push_back(0x03); all.push_back(0x00);
+  CHECK(assetGzipHeaderLen(all.data(), all.size()) == allLen, "full header %zu, want %zu",
+        assetGzipHeaderLen(all.data(), all.size()), allLen);
+  for (size_t n = 0; n <= allLen; n++) {
+    CHECK(assetGzipHeaderLen(all.data(), n) == 0, "full header truncated at %zu accepted", n);
+  }
+
+  // Large FEXTRA beyond the buffer.
+  std::vector<uint8_t> extra = hdr(ASSET_GZ_FEXTRA);
+  extra.push_back(0xff); extra.push_back(0xff);
+  extra.resize(100, 0);
+  CHECK(assetGzipHeaderLen(extra.data(), extra.size()) == 0, "65535-byte FEXTRA in 100 bytes accepted");
+
+  // Not gzip, or not deflate, or reserved flags set.
+  uint8_t bad[sizeof(plain)];
+  memcpy(bad, plain, sizeof(plain)); bad[0] = 0x1e;
+  CHECK(assetGzipHeaderLen(bad, sizeof(bad)) == 0, "bad magic 0 accepted");
+  memcpy(bad, plain, sizeof(plain)); bad[1] = 0x8c;
+  CHECK(assetGzipHeaderLen(bad, sizeof(bad)) == 0, "bad magic 1 accepted");
+  memcpy(bad, plain, sizeof(plain)); bad[2] = 7;
+  CHECK(assetGzipHeaderLen(bad, sizeof(bad)) == 0, "method 7 accepted");
+  for (uint8_t bit = 0x20; bit; bit <<= 1) {
+    memcpy(bad, plain, sizeof(plain)); bad[3] = bit;
+    CHECK(assetGzipHeaderLen(bad, sizeof(bad)) == 0, "reserved flag 0x%02x accepted", bit);
+  }
+  const char *text = "<!DOCTYPE html>";
+  CHECK(assetGzipHeaderLen((const uint8_t *)text, strlen(text)) == 0, "plain text accepted");
+  CHECK(assetGzipHeaderLen(plain, 0) == 0, "empty buffer accepted");
+}
+
+int main()
+{
+  testAcceptEncoding();
+  testVariant();
+  testEtag();
+  testMatrix();
+  testGzipHeader();
+
+  std::printf("%d checks, %d failures\n", checks, failures);
+  std::printf(failures ? "FAILED\n" : "ALL PASSED\n");
+  return failures ? 1 : 0;
+}
@@ -40,6 +40,7 @@ class TestBuildHelpFlags(unittest.TestCase):
         "--manifest",         # TASK-287: produce artifact manifest
         "--firmware",         # Long-standing: firmware-only subset
         "--clean",            # Long-standing: clean build
+        "--no-gzip-assets",   # ADR-175: plain-file filesystem escape hatch
     ]
 
     @classmethod
@@ -0,0 +1,210 @@
+/**
+ * Host test for the 1-Wire sensor task's scratchpad helpers (DallasSweep.h).
+ *
+ * The sensor task in sensors_ext.ino reads every DS18B20/DS18S20 scratchpad
+ * itself instead of through DallasTemperature::getTempC(). This file checks
+ * that nothing about the reported temperature or the failure handling moved:
+ *
+ *   1. dallasCrc8() equals the table-driven OneWire::crc8() on random
+ *      buffers and gives the Maxim application-note ROM example.
+ *   2. dallasScratchpadRaw() equals DallasTemperature::calculateTemperature()
+ *      for every LSB/MSB pair (DS18B20) and every COUNT_REMAIN/COUNT_PER_C
+ *      (DS18S20), and the datasheet table temperatures.
+ *   3. dallasCheckScratchpad(): no presence, all ones and all zeros are
+ *      missing (what isConnected() rejects), any single flipped bit of a good
+ *      scratchpad is a CRC error (or missing), good stays good.
+ *   4. dallasConversionMs() per configuration register resolution, and the
+ *      DallasReadStats counters.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/test_dallas_sweep.cpp -o tests/test_dallas_sweep.out
+ *   ./tests/test_dallas_sweep.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "../src/OTGW-firmware/DallasSweep.h"
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...)                                  \
+  do {                                                    \
+    checks++;                                             \
+    if (!(cond)) {                                        \
+      failures++;                                         \
+      if (failures <= 20) {                               \
+        std::printf("FAIL %s:%d: ", __FILE__, __LINE__);  \
+        std::printf(__VA_ARGS__);                         \
+        std::printf("\n");                                \
+      }                                                   \
+    }                                                     \
+  } while (0)
+
+// ---- References (copies of the library implementations) ----
+
+// OneWire 2.3.x crc8(), ONEWIRE_CRC8_TABLE variant.
+static const uint8_t dscrc_table[] = {
+      0, 94,188,226, 97, 63,221,131,194,156,126, 32,163,253, 31, 65,
+    157,195, 33,127,252,162, 64, 30, 95,  1,227,189, 62, 96,130,220,
+     35,125,159,193, 66, 28,254,160,225,191, 93,  3,128,222, 60, 98,
+    190,224,  2, 92,223,129, 99, 61,124, 34,192,158, 29, 67,161,255,
+     70, 24,250,164, 39,121,155,197,132,218, 56,102,229,187, 89,  7,
+    219,133,103, 57,186,228,  6, 88, 25, 71,165,251,120, 38,196,154,
+    101, 59,217,135,  4, 90,184,230,167,249, 27, 69,198,152,122, 36,
+    248,166, 68, 26,153,199, 37,123, 58,100,134,216, 91,  5,231,185,
+    140,210, 48,110,237,179, 81, 15, 78, 16,242,172, 47,113,147,205,
+     17, 79,173,243,112, 46,204,146,211,141,111, 49,178,236, 14, 80,
+    175,241, 19, 77,206,144,114, 44,109, 51,209,143, 12, 82,176,238,
+     50,108,142,208, 83, 13,239,177,240,174, 76, 18,145,207, 45,115,
+    202,148,118, 40,171,245, 23, 73,  8, 86,180,234,105, 55,213,139,
+     87,  9,235,181, 54,104,138,212,149,203, 41,119,244,170, 72, 22,
+    233,183, 85, 11,136,214, 52,106, 43,117,151,201, 74, 20,246,168,
+    116, 42,200,150, 21, 75,169,247,182,232, 10, 84,215,137,107, 53};
+
+static uint8_t refCrc8(const uint8_t *addr, uint8_t len) {
+  uint8_t crc = 0;
+  while (len--) crc = dscrc_table[crc ^ *addr++];
+  return crc;
+}
+
+// DallasTemperature 4.0.x calculateTemperature(), in 1/128 °C.
+static int32_t refCalculateTemperature(const uint8_t *deviceAddress, const uint8_t *scratchPad) {
+  int32_t fpTemperature = 0;
+  int32_t neg = 0x0;
+  if (scratchPad[1] & 0x80) neg = 0xFFF80000;
+  fpTemperature = (((int32_t)scratchPad[1]) << 11) | (((int32_t)scratchPad[0]) << 3) | neg;
+  if ((deviceAddress[0] == 0x10) && (scratchPad[7] != 0)) {
+    // Parenthesised as C++ groups the library's unbracketed "a - 32 + b | neg".
+    fpTemperature = (((fpTemperature & 0xfff0) << 3) - 32
+        + (((scratchPad[7] - scratchPad[6]) << 7) / scratchPad[7])) | neg;
+  }
+  return fpTemperature;
+}
+
+static void sealScratchpad(uint8_t sp[9]) { sp[8] = refCrc8(sp, 8); }
+
+// ---- 1. CRC-8 ----
+static void testCrc() {
+  // Maxim AN27: ROM 02 1C B8 01 00 00 00 has CRC A2.
+  const uint8_t rom[7] = {0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00};
+  CHECK(dallasCrc8(rom, 7) == 0xA2, "AN27 ROM crc %02X", dallasCrc8(rom, 7));
+
+  std::mt19937 rng(1);
+  uint8_t buf[32];
+  for (int iter = 0; iter < 200000; iter++) {
+    uint8_t len = (uint8_t)(rng() % sizeof(buf));
+    for (uint8_t i = 0; i < len; i++) buf[i] = (uint8_t)rng();
+    uint8_t a = dallasCrc8(buf, len), b = refCrc8(buf, len);
+    if (a != b) { CHECK(false, "crc len %u: %02X vs %02X", len, a, b); break; }
+  }
+  checks++;
+}
+
+// ---- 2. Temperature decode ----
+static void testDecode() {
+  const uint8_t ds18b20[8] = {0x28, 1, 2, 3, 4, 5, 6, 7};
+  const uint8_t ds18s20[8] = {0x10, 1, 2, 3, 4, 5, 6, 7};
+  uint8_t sp[9] = {0, 0, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10, 0};
+  int mismatches = 0;
+  for (int v = 0; v < 65536; v++) {
+    sp[0] = (uint8_t)v; sp[1] = (uint8_t)(v >> 8);
+    if (dallasScratchpadRaw(ds18b20[0], sp) != refCalculateTemperature(ds18b20, sp)) mismatches++;
+    for (int cpc = 0; cpc <= 16; cpc += 8) {
+      for (int cr = 0; cr <= 16; cr++) {
+        sp[6] = (uint8_t)cr; sp[7] = (uint8_t)cpc;
+        if (dallasScratchpadRaw(ds18s20[0], sp) != refCalculateTemperature(ds18s20, sp)) mismatches++;
+      }
+    }
+    sp[6] = 0x0C; sp[7] = 0x10;
+  }
+  CHECK(mismatches == 0, "%d raw values differ from calculateTemperature()", mismatches);
+
+  // DS18B20 datasheet table 1.
+  struct { uint16_t reg; float c; } table[] = {
+    {0x07D0, 125.0f}, {0x0550, 85.0f}, {0x0191, 25.0625f}, {0x00A2, 10.125f},
+    {0x0008, 0.5f}, {0x0000, 0.0f}, {0xFFF8, -0.5f}, {0xFF5E, -10.125f},
+    {0xFE6F, -25.0625f}, {0xFC90, -55.0f}};
+  for (const auto &t : table) {
+    sp[0] = (uint8_t)t.reg; sp[1] = (uint8_t)(t.reg >> 8);
+    float c = dallasRawToCelsius(dallasScratchpadRaw(0x28, sp));
+    CHECK(c == t.c, "reg %04X: %.4f expected %.4f", t.reg, c, t.c);
+  }
+  // DS18S20 datasheet: 0x00AA is +85 °C at 0.5 °C, COUNT_REMAIN 0x0C of 0x10 => 85 - 0.25 + 0.25.
+  sp[0] = 0xAA; sp[1] = 0x00; sp[6] = 0x0C; sp[7] = 0x10;
+  float c = dallasRawToCelsius(dallasScratchpadRaw(DALLAS_FAMILY_DS18S20, sp));
+  CHECK(c == 85.0f, "DS18S20 85 C: %.4f", c);
+}
+
+// ---- 3. Classification ----
+static void testCheck() {
+  uint8_t sp[9] = {0x91, 0x01, 0x4B, 0x46, 0x7F, 0xFF, 0x0F, 0x10, 0};
+  sealScratchpad(sp);
+  CHECK(dallasCheckScratchpad(true, sp) == DALLAS_READ_OK, "good scratchpad");
+  CHECK(dallasCheckScratchpad(false, sp) == DALLAS_READ_MISSING, "no presence");
+
+  uint8_t ones[9], zeros[9];
+  std::memset(ones, 0xFF, sizeof(ones));
+  std::memset(zeros, 0, sizeof(zeros));
+  CHECK(dallasCheckScratchpad(true, ones) == DALLAS_READ_MISSING, "all ones");
+  CHECK(dallasCheckScratchpad(true, zeros) == DALLAS_READ_MISSING, "all zeros (crc8 of zeros is 0)");
+
+  int wrong = 0;
+  for (int bit = 0; bit < 72; bit++) {
+    uint8_t bad[9];
+    std::memcpy(bad, sp, sizeof(bad));
+    bad[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+    if (dallasCheckScratchpad(true, bad) == DALLAS_READ_OK) wrong++;
+  }
+  CHECK(wrong == 0, "%d single-bit errors accepted", wrong);
+
+  // Random scratchpads: OK exactly when the library's isConnected() would be true.
+  std::mt19937 rng(7);
+  int disagree = 0;
+  for (int iter = 0; iter < 100000; iter++) {
+    uint8_t r[9];
+    for (int i = 0; i < 9; i++) r[i] = (uint8_t)rng();
+    if (iter & 1) sealScratchpad(r);
+    bool allZero = true;
+    for (int i = 0; i < 9; i++) if (r[i]) allZero = false;
+    bool isConnected = !allZero && refCrc8(r, 8) == r[8];
+    if ((dallasCheckScratchpad(true, r) == DALLAS_READ_OK) != isConnected) disagree++;
+  }
+  CHECK(disagree == 0, "%d random scratchpads disagree with isConnected()", disagree);
+}
+
+// ---- 4. Conversion time + counters ----
+static void testConversionAndStats() {
+  uint8_t sp[9] = {0};
+  const struct { uint8_t cfg; uint16_t ms; } res[] = {
+    {0x1F, 94}, {0x3F, 188}, {0x5F, 375}, {0x7F, 750}};
+  for (const auto &r : res) {
+    sp[4] = r.cfg;
+    CHECK(dallasConversionMs(0x28, sp) == r.ms, "cfg %02X: %u ms", r.cfg, dallasConversionMs(0x28, sp));
+    CHECK(dallasConversionMs(DALLAS_FAMILY_DS18S20, sp) == DALLAS_CONVERT_MAX_MS, "DS18S20 cfg %02X", r.cfg);
+  }
+
+  DallasReadStats st;
+  st.record(DALLAS_READ_OK, 11000);
+  st.record(DALLAS_READ_CRC, 12500);
+  st.record(DALLAS_READ_OK, 10800);
+  st.record(DALLAS_READ_MISSING, 1100);
+  CHECK(st.reads == 2 && st.crcErrors == 1 && st.missing == 1,
+        "counts %u/%u/%u", (unsigned)st.reads, (unsigned)st.crcErrors, (unsigned)st.missing);
+  CHECK(st.lastUs == 1100 && st.maxUs == 12500, "last %u max %u", (unsigned)st.lastUs, (unsigned)st.maxUs);
+}
+
+int main() {
+  testCrc();
+  testDecode();
+  testCheck();
+  testConversionAndStats();
+  std::printf("%d checks, %d failures\n", checks, failures);
+  std::printf(failures ? "FAILED\n" : "ALL PASSED\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""
+Tests for the precompressed filesystem staging (scripts/gzip_assets.py,
+ADR-175). build.py and the PlatformIO buildfs hook pack the LittleFS image
+from this staging copy, and the firmware (AssetEncoding.h) relies on:
+
+  - a compressible asset is stored as <name>.gz ONLY (the partition cannot
+    hold both copies), and inflates to the source bytes;
+  - the gzip header is the fixed 10-byte one (no FNAME / FEXTRA), and the
+    output is byte-identical between runs;
+  - images, fonts, PIC hex files, settings and version.hash are copied as
+    is, FSexplorer.html (recovery page) stays plain;
+  - every web route in FSexplorer.ino still resolves to a staged file;
+  - the real data/ directory, staged, fits the filesystem partition.
+
+Run: python tests/test_gzip_assets.py
+"""
+
+import gzip
+import hashlib
+import re
+import sys
+import tempfile
+import unittest
+from pathlib import Path
+
+REPO_ROOT = Path(__file__).resolve().parent.parent
+DATA_DIR = REPO_ROOT / "src" / "OTGW-firmware" / "data"
+FSEXPLORER = REPO_ROOT / "src" / "OTGW-firmware" / "FSexplorer.ino"
+
+sys.path.insert(0, str(REPO_ROOT / "scripts"))
+sys.path.insert(0, str(REPO_ROOT))
+import gzip_assets  # noqa: E402
+
+
+def _tree(root):
+    return sorted(str(p.relative_to(root)).replace("\\", "/") for p in Path(root).rglob("*") if p.is_file())
+
+
+class TestStagingPolicy(unittest.TestCase):
+    def setUp(self):
+        self.tmp = tempfile.TemporaryDirectory()
+        self.src = Path(self.tmp.name) / "data"
+        self.dst = Path(self.tmp.name) / "staged"
+        self.src.mkdir()
+        (self.src / "fonts").mkdir()
+        (self.src / "pic16f88").mkdir()
+        text = ("function f() { return 42; }\n" * 400).encode()
+        self.files = {
+            "index.html": b"<!DOCTYPE html>\n" + b"<p>hello</p>\n" * 300,
+            "index.js": text,
+            "v2-bundle.css": b".a { color: red; }\n" * 300,
+            "icon.svg": b"<svg>" + b"<path d='M0 0'/>" * 200 + b"</svg>",
+            "FSexplorer.html": b"<html>" + b"<br>" * 500 + b"</html>",
+            "tiny.js": b"x=1",
+            "random.js": b"".join(hashlib.sha256(bytes([i, i >> 8])).digest() for i in range(128)),
+            "favicon.ico": b"\x00" * 2000,
+            "settings.ini": b"a=1\n" * 200,
+            "version.hash": b"a46e95a\n",
+            "fonts/inter-400.woff2": b"wOF2" + b"\x00" * 3000,
+            "pic16f88/gateway.hex": b":00000001FF\n" * 300,
+            "empty.css": b"",
+        }
+        for rel, data in self.files.items():
+            (self.src / rel).write_bytes(data)
+
+    def tearDown(self):
+        self.tmp.cleanup()
+
+    def test_compressible_assets_stored_gz_only(self):
+        gzip_assets.stage_data_dir(self.src, self.dst)
+        for rel in ("index.html", "index.js", "v2-bundle.css", "icon.svg"):
+            with self.subTest(rel=rel):
+                self.assertFalse((self.dst / rel).exists(), f"{rel} staged plain as well")
+                packed = (self.dst / (rel + ".gz")).read_bytes()
+                self.assertEqual(gzip.decompress(packed), self.files[rel])
+                self.assertLess(len(packed), len(self.files[rel]))
+
+    def test_other_files_copied_unchanged(self):
+        gzip_assets.stage_data_dir(self.src, self.dst)
+        for rel in ("FSexplorer.html", "tiny.js", "random.js", "favicon.ico", "settings.ini",
+                    "version.hash", "fonts/inter-400.woff2", "pic16f88/gateway.hex", "empty.css"):
+            with self.subTest(rel=rel):
+                self.assertEqual((self.dst / rel).read_bytes(), self.files[rel])
+                self.assertFalse((self.dst / (rel + ".gz")).exists(), f"{rel} got a .gz")
+
+    def test_gzip_header_is_fixed_and_output_deterministic(self):
+        gzip_assets.stage_data_dir(self.src, self.dst)
+        first = {rel: (self.dst / rel).read_bytes() for rel in _tree(self.dst)}
+        for rel, data in first.items():
+            if rel.endswith(".gz"):
+                with self.subTest(rel=rel):
+                    # ID1 ID2 CM=deflate FLG=0 MTIME=0: assetGzipHeaderLen() == 10.
+                    self.assertEqual(data[:8], b"\x1f\x8b\x08\x00\x00\x00\x00\x00")
+        again = Path(self.tmp.name) / "again"
+        gzip_assets.stage_data_dir(self.src, again)
+        self.assertEqual(first, {rel: (again / rel).read_bytes() for rel in _tree(again)})
+
+    def test_restage_replaces_previous_contents(self):
+        gzip_assets.stage_data_dir(self.src, self.dst)
+        (self.src / "index.js").unlink()
+        gzip_assets.stage_data_dir(self.src, self.dst)
+        self.assertFalse((self.dst / "index.js.gz").exists(), "stale .gz survived a restage")
+
+    def test_plain_mode_copies_tree(self):
+        gzip_assets.stage_data_dir(self.src, self.dst, compress=False)
+        self.assertEqual(_tree(self.dst), _tree(self.src))
+
+    def test_source_gz_is_not_doubled(self):
+        (self.src / "index.js.gz").write_bytes(gzip.compress(b"own"))
+        gzip_assets.stage_data_dir(self.src, self.dst)
+        self.assertEqual(gzip.decompress((self.dst / "index.js.gz").read_bytes()), b"own")
+        self.assertEqual((self.dst / "index.js").read_bytes(), self.files["index.js"])
+
+    def test_refuses_staging_onto_sources(self):
+        with self.assertRaises(ValueError):
+            gzip_assets.stage_data_dir(self.src, self.src)
+
+    def test_summary(self):
+        staged = gzip_assets.stage_data_dir(self.src, self.dst)
+        self.assertEqual(len(staged), len(self.files))
+        self.assertIn("4 of 13 files gzipped", gzip_assets.summarize(staged))
+
+
+class TestRealDataDir(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.tmp = tempfile.TemporaryDirectory()
+        cls.dst = Path(cls.tmp.name) / "staged"
+        cls.staged = gzip_assets.stage_data_dir(DATA_DIR, cls.dst)
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.tmp.cleanup()
+
+    def test_every_route_resolves(self):
+        routes = set(re.findall(r'serve(?:Versioned|Immutable)Asset\("(/[^"]+)"', FSEXPLORER.read_text(encoding="utf-8")))
+        self.assertGreater(len(routes), 10)
+        for route in sorted(routes):
+            with self.subTest(route=route):
+                rel = route.lstrip("/")
+                self.assertTrue((self.dst / rel).exists() or (self.dst / (rel + ".gz")).exists(),
+                                f"{route} has neither a plain nor a .gz file")
+
+    def test_large_assets_are_compressed(self):
+        for rel in ("index.js", "v2.js", "v2-bundle.css", "index.html", "v2.html"):
+            with self.subTest(rel=rel):
+                self.assertTrue((self.dst / (rel + ".gz")).exists())
+                ratio = (DATA_DIR / rel).stat().st_size / (self.dst / (rel + ".gz")).stat().st_size
+                self.assertGreater(ratio, 3.0, f"{rel} only {ratio:.1f}x smaller")
+
+    def test_recovery_page_and_fonts_stay_plain(self):
+        self.assertTrue((self.dst / "FSexplorer.html").exists())
+        for font in (DATA_DIR / "fonts").glob("*.woff2"):
+            self.assertTrue((self.dst / "fonts" / font.name).exists())
+
+    def test_staged_image_fits_partition(self):
+        import build
+        fs_size = min(t["fs_size"] for t in build.TARGETS.values())
+        total = sum(s[3] for s in self.staged)
+        # Leave room for LittleFS metadata and the files the firmware writes.
+        self.assertLess(total, fs_size * 0.6, f"{total} bytes staged for a {fs_size} byte partition")
+
+
+if __name__ == "__main__":
+    unittest.main(verbosity=2)
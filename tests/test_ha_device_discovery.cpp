@@ -0,0 +1,543 @@
+/**
+ * Host test for device-based HA discovery (streamDeviceDiscovery() in
+ * MQTTHaDiscovery.cpp, settings.mqtt.bDeviceDiscovery).
+ *
+ * The real MQTTHaDiscovery.cpp (PROGMEM tables + composers) is compiled in,
+ * against the host stubs in tests/stubs/; mqttPublishRaw() captures what
+ * would go to the broker. For every combination of bLegacyMode,
+ * bSeparateSources and bUseLegacyOtTopics this checks:
+ *
+ *   1. Entity set: the per-entity table walk of doAutoConfigureMsgid()
+ *      (mirrored below: bilateral Boiler/Thermostat passes, source variants,
+ *      ADR-106 legacy/alias rows) and the device-mode slots announce the same
+ *      uniq_ids, each with the same platform and the same entity fields
+ *      (everything except avty_t/dev/origin, which device mode hoists to the
+ *      top level once per payload).
+ *   2. Payloads: every slot carries the full dev block, origin and avty_t,
+ *      component keys are the uniq_id tails, and no slot exceeds
+ *      HA_DEVICE_DISCOVERY_CHUNK_MAX, also with the longest nodeId, topic
+ *      namespace and JSON-escaped device strings the settings allow.
+ *   3. Slot boundaries do not depend on settings or string lengths.
+ *   4. JIT: announcing OT IDs one at a time republishes only the new ID's
+ *      slot topic, always as a superset of what that topic carried before,
+ *      and ends with the full entity set.
+ *   5. Gates: heap pressure and an all-unknown slot publish nothing;
+ *      clearDeviceDiscovery() empties exactly the slot topics.
+ *
+ * Reports publishes and bytes for both modes.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra -I tests/stubs tests/test_ha_device_discovery.cpp -o tests/test_ha_device_discovery.out
+ *   ./tests/test_ha_device_discovery.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+// The firmware tables leave trailing fields to zero-initialisation.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+#include "../src/OTGW-firmware/MQTTHaDiscovery.cpp"
+#pragma GCC diagnostic pop
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ---- firmware seams ------------------------------------------------------
+uint32_t hostFreeHeap = 1u << 20;
+uint32_t hostMaxFreeBlock = 1u << 20;
+const char kPicSubtreePrefix[] PROGMEM = "otgw-pic/";   // MQTTstuff.ino
+
+struct Publish { std::string topic; std::string payload; };
+static std::vector<Publish> published;
+static uint32_t topicCount = 0;
+
+bool canPublishMQTT() { return true; }
+bool mqttIsConnected() { return true; }
+void feedWatchDog() {}
+void incPublishedTopicCount() { topicCount++; }
+bool mqttPublishRaw(const char *topic, const uint8_t *payload, size_t len, bool)
+{
+  published.push_back({topic, std::string(reinterpret_cast<const char *>(payload ? payload : (const uint8_t *)""), len)});
+  return true;
+}
+
+static const uint8_t kDallasId = 246;   // OTGWdallasdataid: announced by configSensors(), not the tables
+
+static int failures = 0;
+
+static void check(const char *name, bool ok)
+{
+  std::printf("%-64s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+// ---------------------------------------------------------------------------
+// Minimal JSON object splitter: top-level "key": <raw value text> pairs in
+// order. Enough for the composers' output (strings, numbers, bools, nested
+// objects); not a general parser.
+// ---------------------------------------------------------------------------
+typedef std::vector<std::pair<std::string, std::string>> Fields;
+
+static size_t skipString(const std::string &s, size_t i)   // i at opening quote
+{
+  for (i++; i < s.size(); i++) {
+    if (s[i] == '\\') { i++; continue; }
+    if (s[i] == '"') return i + 1;
+  }
+  return std::string::npos;
+}
+
+static size_t skipValue(const std::string &s, size_t i)
+{
+  if (s[i] == '"') return skipString(s, i);
+  if (s[i] == '{') {
+    int depth = 0;
+    while (i < s.size()) {
+      if (s[i] == '"') { i = skipString(s, i); continue; }
+      if (s[i] == '{') depth++;
+      if (s[i] == '}' && --depth == 0) return i + 1;
+      i++;
+    }
+    return std::string::npos;
+  }
+  while (i < s.size() && s[i] != ',' && s[i] != '}') i++;
+  return i;
+}
+
+static bool splitObject(const std::string &s, Fields &out)
+{
+  out.clear();
+  if (s.size() < 2 || s.front() != '{' || s.back() != '}') return false;
+  size_t i = 1;
+  if (s[i] == '}') return i + 1 == s.size();
+  while (i < s.size()) {
+    if (s[i] != '"') return false;
+    const size_t keyEnd = skipString(s, i);
+    if (keyEnd == std::string::npos || s[keyEnd] != ':') return false;
+    const std::string key = s.substr(i + 1, keyEnd - i - 2);
+    const size_t valEnd = skipValue(s, keyEnd + 1);
+    if (valEnd == std::string::npos) return false;
+    out.emplace_back(key, s.substr(keyEnd + 1, valEnd - keyEnd - 1));
+    if (s[valEnd] == '}') return valEnd + 1 == s.size();
+    if (s[valEnd] != ',') return false;
+    i = valEnd + 1;
+  }
+  return false;
+}
+
+static std::string field(const Fields &f, const char *key)
+{
+  for (const auto &kv : f) if (kv.first == key) return kv.second;
+  return std::string();
+}
+
+static std::string unquote(const std::string &v)
+{
+  return (v.size() >= 2 && v.front() == '"') ? v.substr(1, v.size() - 2) : v;
+}
+
+// Entity identity as HA sees it: platform + the fields that describe it.
+struct Entity {
+  std::string platform;
+  std::string fields;   // "k=v;" in composer order, without avty_t/dev/origin
+  bool operator==(const Entity &o) const { return platform == o.platform && fields == o.fields; }
+};
+typedef std::map<std::string, Entity> EntitySet;   // keyed by uniq_id
+
+static std::string entityFields(const Fields &f, const char *skip1, const char *skip2, const char *skip3)
+{
+  std::string out;
+  for (const auto &kv : f) {
+    if (kv.first == skip1 || kv.first == skip2 || kv.first == skip3) continue;
+    out += kv.first + "=" + kv.second + ";";
+  }
+  return out;
+}
+
+// ---------------------------------------------------------------------------
+// Context + settings
+// ---------------------------------------------------------------------------
+struct Strings {
+  std::string nodeId, hostname, pubTopic, subTopic, manufacturer, model;
+};
+
+static Strings normalStrings()
+{
+  return {"otgw-0123456789ab", "OTGW", "OTGW/value/otgw-0123456789ab", "OTGW/set/otgw-0123456789ab",
+          "NodoShop", "OTGW32"};
+}
+
+// Longest values the settings allow (sUniqueid[41], sTopTopic[41],
+// sHostname, sManufacturer/sModel[33]) with characters that need escaping.
+static Strings worstStrings()
+{
+  Strings s;
+  s.nodeId = std::string(40, 'n');
+  s.pubTopic = std::string(40, 't') + "/value/" + s.nodeId;
+  s.subTopic = std::string(40, 't') + "/set/" + s.nodeId;
+  s.hostname = std::string(40, '"');
+  s.manufacturer = std::string(32, '\\');
+  s.model = std::string(32, '"');
+  return s;
+}
+
+static HaDiscoveryContext makeCtx(const Strings &s, bool legacyMode, bool separateSources, bool legacyOtTopics)
+{
+  HaDiscoveryContext ctx{};
+  ctx.nodeId = s.nodeId.c_str();
+  ctx.hostname = s.hostname.c_str();
+  ctx.version = "2.0.0-alpha.354";
+  ctx.mqttPubTopic = s.pubTopic.c_str();
+  ctx.mqttSubTopic = s.subTopic.c_str();
+  ctx.haPrefix = "homeassistant";
+  ctx.manufacturer = s.manufacturer.c_str();
+  ctx.model = s.model.c_str();
+  ctx.isFirstEntity = false;
+  ctx.legacyMode = legacyMode;
+  ctx.separateSources = separateSources;
+  ctx.legacyOtTopics = legacyOtTopics;
+  ctx.device = HaDevice::Esp;
+  ctx.otCoreSuffix = PSTR(HA_OTCORE_SUFFIX);
+  ctx.otCoreName = HA_OTCORE_NAME;
+  ctx.sourceSuffix = "";
+  ctx.sourceName = "";
+  ctx.sourceTopicSegment = "";
+  return ctx;
+}
+
+static bool hasTableEntities(uint8_t id)
+{
+  return readSensorIndex(id) != MQTT_HA_INDEX_NONE || readBinSensorIndex(id) != MQTT_HA_INDEX_NONE;
+}
+
+// ---------------------------------------------------------------------------
+// Per-entity mode: the sensor / binary_sensor part of doAutoConfigureMsgid()
+// (MQTTstuff.ino), with deviceForOTId() for the pseudo IDs.
+// ---------------------------------------------------------------------------
+static void perEntityMsgid(uint8_t otId, HaDiscoveryContext &ctx)
+{
+  const bool isBilateral = !ctx.legacyMode && otId <= 127;
+  const HaDevice primary = (otId <= 127) ? HaDevice::Boiler : topoDeviceForPseudoId(otId);
+  ctx.device = primary;
+
+  const uint16_t sIdx = readSensorIndex(otId);
+  if (sIdx != MQTT_HA_INDEX_NONE) {
+    for (uint8_t pass = 0; pass < (isBilateral ? 2 : 1); pass++) {
+      if (isBilateral) ctx.device = pass == 0 ? HaDevice::Boiler : HaDevice::Thermostat;
+      for (uint16_t i = sIdx; i < MQTT_HA_SENSOR_COUNT; i++) {
+        MqttHaSensorCfg cfg = readSensorCfg(i);
+        if (cfg.id != otId) break;
+        if (cfg.flags & MQTT_HA_FLAG_ANY_SOURCE) {
+          if (ctx.separateSources) expandAndStreamSensorSources(cfg, ctx);
+        } else {
+          streamSensorDiscovery(cfg, ctx);
+        }
+      }
+    }
+  }
+  ctx.device = primary;
+  for (uint8_t pass = 0; pass < (isBilateral ? 2 : 1); pass++) {
+    if (isBilateral) ctx.device = pass == 0 ? HaDevice::Boiler : HaDevice::Thermostat;
+    uint16_t bIdx = readBinSensorIndex(otId);
+    if (bIdx != MQTT_HA_INDEX_NONE) {
+      for (; bIdx < MQTT_HA_BINSENSOR_INDEXED_COUNT; bIdx++) {
+        MqttHaBinSensorCfg cfg = readBinSensorCfg(bIdx);
+        if (cfg.id != otId) break;
+        if (!ctx.legacyOtTopics && (cfg.flags & MQTT_HA_FLAG_LEGACY_REPLACED_BY_ALIAS)) continue;
+        streamBinarySensorDiscovery(cfg, ctx);
+      }
+    }
+    if (!ctx.legacyOtTopics) {
+      for (uint16_t a = MQTT_HA_BINSENSOR_INDEXED_COUNT; a < MQTT_HA_BINSENSOR_COUNT; a++) {
+        MqttHaBinSensorCfg cfg = readBinSensorCfg(a);
+        if (cfg.id == otId) streamBinarySensorDiscovery(cfg, ctx);
+      }
+    }
+  }
+}
+
+// Per-entity publishes -> entity set. Duplicate uniq_ids (the bilateral
+// passes) must describe the same entity, otherwise HA would see a conflict.
+static bool collectPerEntity(const std::vector<Publish> &pubs, EntitySet &out, std::string &err)
+{
+  out.clear();
+  Fields f;
+  for (const auto &p : pubs) {
+    if (!splitObject(p.payload, f)) { err = "unparsable " + p.topic; return false; }
+    const size_t a = p.topic.find('/');
+    const size_t b = p.topic.find('/', a + 1);
+    Entity e{p.topic.substr(a + 1, b - a - 1), entityFields(f, "avty_t", "dev", "origin")};
+    const std::string uid = unquote(field(f, "uniq_id"));
+    auto it = out.find(uid);
+    if (it != out.end() && !(it->second == e)) { err = "conflicting duplicate " + uid; return false; }
+    out[uid] = e;
+  }
+  return true;
+}
+
+// Device-mode payloads -> entity set, checking the envelope on the way.
+static bool collectDevice(const std::vector<Publish> &pubs, const HaDiscoveryContext &ctx,
+                          EntitySet &out, std::string &err)
+{
+  out.clear();
+  Fields top, dev, cmps, cmp;
+  const std::string avty = std::string("\"") + ctx.mqttPubTopic + "\"";
+  for (const auto &p : pubs) {
+    if (!splitObject(p.payload, top)) { err = "unparsable " + p.topic; return false; }
+    if (field(top, "avty_t") != avty) { err = "avty_t " + p.topic; return false; }
+    if (!splitObject(field(top, "dev"), dev) || field(dev, "manufacturer").empty() ||
+        unquote(field(dev, "identifiers")) != ctx.nodeId) { err = "dev block " + p.topic; return false; }
+    if (field(top, "origin").empty()) { err = "origin " + p.topic; return false; }
+    if (!splitObject(field(top, "cmps"), cmps) || cmps.empty()) { err = "cmps " + p.topic; return false; }
+    for (const auto &kv : cmps) {
+      if (!splitObject(kv.second, cmp) || cmp.empty() || cmp[0].first != "p") { err = "component " + kv.first; return false; }
+      const std::string uid = unquote(field(cmp, "uniq_id"));
+      if (uid != std::string(ctx.nodeId) + "-" + kv.first) { err = "key/uniq_id mismatch " + kv.first; return false; }
+      if (out.count(uid)) { err = "uniq_id in two components " + uid; return false; }
+      out[uid] = Entity{unquote(cmp[0].second), entityFields(cmp, "p", "", "")};
+    }
+  }
+  return true;
+}
+
+static void allKnown(uint32_t known[8])
+{
+  memset(known, 0, 8 * sizeof(uint32_t));
+  for (uint16_t id = 0; id < 256; id++)
+    if (id != kDallasId && hasTableEntities((uint8_t)id)) known[id >> 5] |= 1UL << (id & 31);
+}
+
+static size_t totalBytes(const std::vector<Publish> &pubs)
+{
+  size_t n = 0;
+  for (const auto &p : pubs) n += p.topic.size() + p.payload.size();
+  return n;
+}
+
+// ---------------------------------------------------------------------------
+// 1./2. Entity set + payloads per settings combination
+// ---------------------------------------------------------------------------
+static void testEntitySets()
+{
+  std::printf("--- entity set: per-entity vs device mode ---\n");
+  const Strings s = normalStrings();
+  uint8_t slotOf[256];
+  uint32_t known[8];
+  allKnown(known);
+
+  for (int combo = 0; combo < 8; combo++) {
+    const bool legacyMode = combo & 1, separateSources = combo & 2, legacyOtTopics = combo & 4;
+    HaDiscoveryContext ctx = makeCtx(s, legacyMode, separateSources, legacyOtTopics);
+    char name[96];
+
+    published.clear();
+    for (uint16_t id = 0; id < 256; id++) {
+      if (id == kDallasId || !hasTableEntities((uint8_t)id)) continue;
+      ctx.isFirstEntity = (id == 0);
+      perEntityMsgid((uint8_t)id, ctx);
+    }
+    const std::vector<Publish> perEntity = published;
+
+    const uint8_t slots = buildHaDeviceSlots(ctx, slotOf);
+    published.clear();
+    topicCount = 0;
+    bool allOk = slots > 0;
+    for (uint8_t sl = 0; sl < slots; sl++) allOk = streamDeviceDiscovery(sl, slotOf, known, ctx, true) && allOk;
+    const std::vector<Publish> device = published;
+
+    EntitySet a, b;
+    std::string errA, errB;
+    const bool okA = collectPerEntity(perEntity, a, errA);
+    const bool okB = collectDevice(device, ctx, b, errB);
+    if (!okA) std::printf("  per-entity: %s\n", errA.c_str());
+    if (!okB) std::printf("  device: %s\n", errB.c_str());
+
+    size_t onlyA = 0, onlyB = 0, differ = 0;
+    for (const auto &kv : a) {
+      auto it = b.find(kv.first);
+      if (it == b.end()) { if (onlyA++ < 3) std::printf("  missing in device mode: %s\n", kv.first.c_str()); }
+      else if (!(it->second == kv.second)) { if (differ++ < 3) std::printf("  differs: %s\n", kv.first.c_str()); }
+    }
+    for (const auto &kv : b)
+      if (!a.count(kv.first) && onlyB++ < 3) std::printf("  extra in device mode: %s\n", kv.first.c_str());
+
+    size_t maxPayload = 0;
+    for (const auto &p : device) maxPayload = std::max(maxPayload, p.payload.size());
+
+    std::printf("  legacyMode=%d separateSources=%d legacyOtTopics=%d: %zu entities, "
+                "per-entity %zu publishes / %zu B, device %zu publishes / %zu B (largest %zu B)\n",
+                legacyMode, separateSources, legacyOtTopics, a.size(), perEntity.size(),
+                totalBytes(perEntity), device.size(), totalBytes(device), maxPayload);
+
+    snprintf(name, sizeof(name), "combo %d: both modes parse, every slot published", combo);
+    check(name, okA && okB && allOk && device.size() == slots && topicCount == slots);
+    snprintf(name, sizeof(name), "combo %d: same uniq_ids, platforms and entity fields", combo);
+    check(name, !a.empty() && onlyA == 0 && onlyB == 0 && differ == 0);
+    snprintf(name, sizeof(name), "combo %d: every slot <= HA_DEVICE_DISCOVERY_CHUNK_MAX", combo);
+    check(name, maxPayload <= HA_DEVICE_DISCOVERY_CHUNK_MAX);
+    snprintf(name, sizeof(name), "combo %d: fewer publishes than per-entity mode", combo);
+    check(name, device.size() * 10 < perEntity.size());
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 2./3. Worst-case sizes, stable boundaries
+// ---------------------------------------------------------------------------
+static void testBoundaries()
+{
+  std::printf("--- slot boundaries ---\n");
+  uint8_t ref[256], slotOf[256];
+  const Strings normal = normalStrings(), worst = worstStrings();
+  const uint8_t slots = buildHaDeviceSlots(makeCtx(normal, false, false, false), ref);
+  bool same = true;
+  for (int combo = 0; combo < 8; combo++) {
+    for (const Strings *s : {&normal, &worst}) {
+      const uint8_t n = buildHaDeviceSlots(makeCtx(*s, combo & 1, combo & 2, combo & 4), slotOf);
+      same = same && n == slots && memcmp(ref, slotOf, sizeof(ref)) == 0;
+    }
+  }
+  std::printf("  %u slots\n", (unsigned)slots);
+  check("boundaries independent of settings and string lengths", same);
+
+  bool covered = true;
+  for (uint16_t id = 0; id < 256; id++)
+    covered = covered && ((ref[id] != HA_DEVICE_SLOT_NONE) == hasTableEntities((uint8_t)id));
+  check("every OT ID with table entities has a slot, no other", covered);
+
+  bool ascending = true;
+  uint8_t last = 0;
+  for (uint16_t id = 0; id < 256; id++) {
+    if (ref[id] == HA_DEVICE_SLOT_NONE) continue;
+    ascending = ascending && (ref[id] == last || ref[id] == last + 1);
+    last = ref[id];
+  }
+  check("slots cover contiguous OT ID ranges", ascending && slots < HA_DEVICE_SLOT_MAX);
+
+  // Largest possible payload: worst strings, every variant published.
+  size_t maxPayload = 0;
+  uint32_t known[8];
+  allKnown(known);
+  for (int combo = 0; combo < 8; combo++) {
+    HaDiscoveryContext ctx = makeCtx(worst, combo & 1, combo & 2, combo & 4);
+    published.clear();
+    for (uint8_t sl = 0; sl < slots; sl++) streamDeviceDiscovery(sl, ref, known, ctx, false);
+    for (const auto &p : published) maxPayload = std::max(maxPayload, p.payload.size());
+  }
+  std::printf("  worst-case payload %zu B of %zu\n", maxPayload, HA_DEVICE_DISCOVERY_CHUNK_MAX);
+  check("worst-case strings still fit HA_DEVICE_DISCOVERY_CHUNK_MAX", maxPayload <= HA_DEVICE_DISCOVERY_CHUNK_MAX);
+}
+
+// ---------------------------------------------------------------------------
+// 4. JIT announcements
+// ---------------------------------------------------------------------------
+static uint64_t rngState = 0x9E3779B97F4A7C15ull;
+static uint64_t rnd()
+{
+  rngState ^= rngState >> 12;
+  rngState ^= rngState << 25;
+  rngState ^= rngState >> 27;
+  return rngState * 2685821657736338717ull;
+}
+
+static void testJit()
+{
+  std::printf("--- JIT: OT IDs announced one at a time ---\n");
+  const Strings s = normalStrings();
+  HaDiscoveryContext ctx = makeCtx(s, false, true, false);
+  uint8_t slotOf[256];
+  const uint8_t slots = buildHaDeviceSlots(ctx, slotOf);
+  (void)slots;
+
+  std::vector<uint8_t> order;
+  for (uint16_t id = 0; id < 256; id++)
+    if (id != kDallasId && hasTableEntities((uint8_t)id)) order.push_back((uint8_t)id);
+  for (size_t i = order.size(); i > 1; i--) std::swap(order[i - 1], order[rnd() % i]);
+
+  uint32_t known[8] = {0};
+  std::map<std::string, EntitySet> retained;     // what the broker holds per topic
+  std::set<uint8_t> countedSlots;
+  bool oneTopic = true, superset = true, sameTopic = true;
+  topicCount = 0;
+  for (uint8_t id : order) {
+    known[id >> 5] |= 1UL << (id & 31);
+    const bool first = countedSlots.insert(slotOf[id]).second;
+    published.clear();
+    streamDeviceDiscovery(slotOf[id], slotOf, known, ctx, first);
+    if (published.size() != 1) { oneTopic = false; continue; }
+    EntitySet now;
+    std::string err;
+    if (!collectDevice(published, ctx, now, err)) { superset = false; continue; }
+    EntitySet &before = retained[published[0].topic];
+    for (const auto &kv : before) superset = superset && now.count(kv.first) && now[kv.first] == kv.second;
+    before = now;
+    // The topic must be the slot's, whichever ID triggered it.
+    sameTopic = sameTopic && published[0].topic.find("/ot_") != std::string::npos;
+  }
+  check("each announcement republishes exactly one slot topic", oneTopic && sameTopic);
+  check("a republished slot is a superset of its retained payload", superset);
+  check("ADR-062 count: one per slot topic", topicCount == retained.size());
+
+  uint32_t all[8];
+  allKnown(all);
+  published.clear();
+  for (uint8_t sl = 0; sl < slots; sl++) streamDeviceDiscovery(sl, slotOf, all, ctx, false);
+  EntitySet full, merged;
+  std::string err;
+  collectDevice(published, ctx, full, err);
+  for (const auto &t : retained) merged.insert(t.second.begin(), t.second.end());
+  check("after the last announcement the broker holds the full set", merged.size() == full.size() &&
+        std::equal(merged.begin(), merged.end(), full.begin(),
+                   [](const EntitySet::value_type &x, const EntitySet::value_type &y) {
+                     return x.first == y.first && x.second == y.second;
+                   }));
+}
+
+// ---------------------------------------------------------------------------
+// 5. Gates and cleanup
+// ---------------------------------------------------------------------------
+static void testGates()
+{
+  std::printf("--- gates and cleanup ---\n");
+  const Strings s = normalStrings();
+  HaDiscoveryContext ctx = makeCtx(s, false, false, false);
+  uint8_t slotOf[256];
+  const uint8_t slots = buildHaDeviceSlots(ctx, slotOf);
+  uint32_t known[8];
+  allKnown(known);
+
+  published.clear();
+  hostFreeHeap = 2 * HA_DEVICE_DISCOVERY_CHUNK_MAX;
+  const bool lowHeap = streamDeviceDiscovery(0, slotOf, known, ctx, true);
+  hostFreeHeap = 1u << 20;
+  hostMaxFreeBlock = HA_DEVICE_DISCOVERY_CHUNK_MAX - 1;
+  const bool fragmented = streamDeviceDiscovery(0, slotOf, known, ctx, true);
+  hostMaxFreeBlock = 1u << 20;
+  check("heap pressure: nothing published", !lowHeap && !fragmented && published.empty());
+
+  uint32_t none[8] = {0};
+  const bool empty = streamDeviceDiscovery(0, slotOf, none, ctx, true);
+  check("slot without known IDs: nothing published", !empty && published.empty());
+
+  std::set<std::string> topics;
+  for (uint8_t sl = 0; sl < slots; sl++) streamDeviceDiscovery(sl, slotOf, known, ctx, false);
+  for (const auto &p : published) topics.insert(p.topic);
+  published.clear();
+  const uint8_t cleared = clearDeviceDiscovery(slotOf, ctx.haPrefix, ctx.nodeId);
+  bool allEmpty = cleared == slots && published.size() == slots;
+  for (const auto &p : published) allEmpty = allEmpty && p.payload.empty() && topics.count(p.topic);
+  check("clearDeviceDiscovery empties exactly the slot topics", allEmpty);
+}
+
+int main()
+{
+  std::printf("=== HA device discovery test ===\n");
+  testEntitySets();
+  testBoundaries();
+  testJit();
+  testGates();
+  std::printf("\n%s (%d failure%s)\n", failures ? "FAILED" : "ALL PASSED", failures, failures == 1 ? "" : "s");
+  return failures ? 1 : 0;
+}
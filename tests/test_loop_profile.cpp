@@ -0,0 +1,214 @@
+/**
+ * Host test for the loop-task section profiler (LoopProfile.h).
+ *
+ * loop() and doBackgroundTasks() in OTGW-firmware.ino wrap every service call
+ * in LOOP_PROFILED(), which records the call's duration into a log2
+ * histogram. /api/v2/debug and telnet 'L' read back calls, avg, p50, p99 and
+ * max. This file checks the math behind those numbers:
+ *
+ *   1. loopProfBucket() puts every duration in [2^b, 2^(b+1)) (0 and 1 us in
+ *      bucket 0, everything past the last edge in the last bucket), at every
+ *      power-of-two edge and against a reference floor(log2) on random input.
+ *   2. loopProfPercentileUs() on random distributions is never below the
+ *      exact percentile of the recorded samples and never more than twice
+ *      it (plus the 1 us of bucket 0), and never above the max.
+ *   3. Counters: calls, total, max, avg; an empty section reads 0; reset.
+ *   4. LoopProfScope / LOOP_PROFILED() with a fake clock, including a clock
+ *      wrap inside a section and nested sections.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/test_loop_profile.cpp -o tests/test_loop_profile.out
+ *   ./tests/test_loop_profile.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../src/OTGW-firmware/LoopProfile.h"
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...)                                  \
+  do {                                                    \
+    checks++;                                             \
+    if (!(cond)) {                                        \
+      failures++;                                         \
+      if (failures <= 20) {                               \
+        std::printf("FAIL %s:%d: ", __FILE__, __LINE__);  \
+        std::printf(__VA_ARGS__);                         \
+        std::printf("\n");                                \
+      }                                                   \
+    }                                                     \
+  } while (0)
+
+// The firmware reads micros(); the test drives the clock by hand.
+static uint32_t fakeClockUs = 0;
+uint32_t loopProfNowUs() { return fakeClockUs; }
+
+static LoopProfile loopProfile;
+
+static uint8_t refBucket(uint32_t us)
+{
+  uint8_t b = 0;
+  while (b < 31 && (us >> (b + 1)) != 0) b++;
+  return b < LOOP_PROF_BUCKETS - 1 ? b : LOOP_PROF_BUCKETS - 1;
+}
+
+// ---- 1. Buckets ----
+static void testBuckets()
+{
+  CHECK(loopProfBucket(0) == 0 && loopProfBucket(1) == 0, "0 and 1 us in bucket 0");
+  int wrong = 0;
+  for (uint8_t b = 1; b < 32; b++) {
+    const uint32_t edge = 1UL << b;
+    const uint8_t want = b < LOOP_PROF_BUCKETS - 1 ? b : LOOP_PROF_BUCKETS - 1;
+    if (loopProfBucket(edge) != want) wrong++;
+    if (loopProfBucket(edge - 1) != (b - 1 < LOOP_PROF_BUCKETS - 1 ? b - 1 : LOOP_PROF_BUCKETS - 1)) wrong++;
+  }
+  CHECK(wrong == 0, "%d power-of-two edges in the wrong bucket", wrong);
+  CHECK(loopProfBucket(UINT32_MAX) == LOOP_PROF_BUCKETS - 1, "UINT32_MAX in the last bucket");
+
+  std::mt19937 rng(1);
+  int diff = 0;
+  for (int i = 0; i < 1000000; i++) {
+    const uint32_t us = rng() >> (rng() % 32);
+    if (loopProfBucket(us) != refBucket(us)) diff++;
+  }
+  CHECK(diff == 0, "%d random durations differ from floor(log2)", diff);
+
+  for (uint8_t b = 0; b < LOOP_PROF_BUCKETS; b++) {
+    CHECK(loopProfBucket(loopProfBucketLowUs(b)) == b, "low edge of bucket %u", b);
+  }
+}
+
+// ---- 2. Percentiles ----
+static uint32_t exactPercentile(std::vector<uint32_t> v, uint8_t pct)
+{
+  std::sort(v.begin(), v.end());
+  size_t rank = (v.size() * pct + 99) / 100;   // 1-based, as the firmware
+  if (rank == 0) rank = 1;
+  return v[rank - 1];
+}
+
+static void testPercentiles()
+{
+  std::mt19937 rng(2);
+  int below = 0, tooHigh = 0, aboveMax = 0;
+  for (int run = 0; run < 2000; run++) {
+    LoopProfStat st;
+    std::vector<uint32_t> samples;
+    const int n = 1 + (int)(rng() % 500);
+    const int shape = run % 3;
+    for (int i = 0; i < n; i++) {
+      uint32_t us;
+      if (shape == 0)      us = rng() % 200;                        // fast service
+      else if (shape == 1) us = (rng() % 100 < 98) ? 20 + rng() % 30 : 5000 + rng() % 300000; // rare stalls
+      else                 us = rng() >> (rng() % 32);              // every scale
+      loopProfRecord(st, us);
+      samples.push_back(us);
+    }
+    for (uint8_t pct : {0, 1, 50, 90, 99, 100}) {
+      const uint32_t exact = exactPercentile(samples, pct);
+      const uint32_t est = loopProfPercentileUs(st, pct);
+      if (est < exact) below++;
+      if (exact < (1UL << (LOOP_PROF_BUCKETS - 1)) && est > 2 * exact + 1) tooHigh++;
+      if (est > st.maxUs) aboveMax++;
+    }
+  }
+  CHECK(below == 0, "%d percentiles below the exact value", below);
+  CHECK(tooHigh == 0, "%d percentiles more than 2x the exact value", tooHigh);
+  CHECK(aboveMax == 0, "%d percentiles above the max", aboveMax);
+
+  // 99 fast calls and one 250 ms stall: p50 fast, p99 fast, p100 the stall.
+  LoopProfStat st;
+  for (int i = 0; i < 99; i++) loopProfRecord(st, 40);
+  loopProfRecord(st, 250000);
+  CHECK(loopProfPercentileUs(st, 50) == 63, "p50 %u", (unsigned)loopProfPercentileUs(st, 50));
+  CHECK(loopProfPercentileUs(st, 99) == 63, "p99 %u", (unsigned)loopProfPercentileUs(st, 99));
+  CHECK(loopProfPercentileUs(st, 100) == 250000, "p100 %u", (unsigned)loopProfPercentileUs(st, 100));
+  // Past the last bucket edge the percentile is the max itself.
+  LoopProfStat big;
+  loopProfRecord(big, 3000000);
+  CHECK(loopProfPercentileUs(big, 50) == 3000000, "last bucket reads the max");
+}
+
+// ---- 3. Counters ----
+static void testCounters()
+{
+  LoopProfStat st;
+  CHECK(loopProfAvgUs(st) == 0 && loopProfPercentileUs(st, 99) == 0, "empty section reads 0");
+  loopProfRecord(st, 10);
+  loopProfRecord(st, 30);
+  loopProfRecord(st, 0);
+  CHECK(st.calls == 3 && st.totalUs == 40 && st.maxUs == 30, "calls %u total %llu max %u",
+        (unsigned)st.calls, (unsigned long long)st.totalUs, (unsigned)st.maxUs);
+  CHECK(loopProfAvgUs(st) == 13, "avg %u", (unsigned)loopProfAvgUs(st));
+  CHECK(st.hist[0] == 1 && st.hist[3] == 1 && st.hist[4] == 1, "histogram 0/10/30 us");
+
+  // total is 64-bit: 10 000 calls of 1 s do not wrap.
+  LoopProfStat slow;
+  for (int i = 0; i < 10000; i++) loopProfRecord(slow, 1000000);
+  CHECK(slow.totalUs == 10000ULL * 1000000ULL, "64-bit total");
+
+  LoopProfile p;
+  loopProfRecord(p.s[LPS_MQTT], 5);
+  loopProfReset(p, 1234);
+  CHECK(p.s[LPS_MQTT].calls == 0 && p.s[LPS_MQTT].hist[2] == 0 && p.sinceMs == 1234, "reset");
+
+  int unnamed = 0;
+  for (uint8_t i = 0; i < LPS_COUNT; i++) {
+    const char *n = loopProfSectionName(i);
+    if (n[0] == '\0' || std::strlen(n) >= LOOP_PROF_NAME_LEN) unnamed++;
+    for (uint8_t j = 0; j < i; j++) if (std::strcmp(n, loopProfSectionName(j)) == 0) unnamed++;
+  }
+  CHECK(unnamed == 0, "%d sections without a unique name", unnamed);
+  CHECK(loopProfSectionName(LPS_COUNT)[0] == '\0', "out-of-range name is empty");
+}
+
+// ---- 4. Scoped timer ----
+static void work(uint32_t us) { fakeClockUs += us; }
+
+static void testScope()
+{
+  loopProfReset(loopProfile, 0);
+  fakeClockUs = 1000;
+  LOOP_PROFILED(LPS_MQTT, work(120));
+  LOOP_PROFILED(LPS_MQTT, work(80));
+  if (false) LOOP_PROFILED(LPS_MQTT, work(1));   // statement form under a bare if
+  CHECK(loopProfile.s[LPS_MQTT].calls == 2 && loopProfile.s[LPS_MQTT].totalUs == 200,
+        "two mqtt calls, 200 us");
+
+  // Clock wraps during the section.
+  fakeClockUs = 0xFFFFFF00u;
+  LOOP_PROFILED(LPS_PIC_SERIAL, work(0x300));
+  CHECK(loopProfile.s[LPS_PIC_SERIAL].maxUs == 0x300, "wrap: %u us", (unsigned)loopProfile.s[LPS_PIC_SERIAL].maxUs);
+
+  // Nested: the outer section includes the inner one.
+  {
+    LoopProfScope outer(loopProfile, LPS_LOOP);
+    work(10);
+    LOOP_PROFILED(LPS_SAT, work(500));
+    work(5);
+  }
+  CHECK(loopProfile.s[LPS_SAT].totalUs == 500 && loopProfile.s[LPS_LOOP].totalUs == 515,
+        "nested: sat %llu loop %llu", (unsigned long long)loopProfile.s[LPS_SAT].totalUs,
+        (unsigned long long)loopProfile.s[LPS_LOOP].totalUs);
+  CHECK(loopProfile.s[LPS_WEATHER].calls == 0, "untouched section stays empty");
+}
+
+int main()
+{
+  testBuckets();
+  testPercentiles();
+  testCounters();
+  testScope();
+  std::printf("%d checks, %d failures\n", checks, failures);
+  std::printf(failures ? "FAILED\n" : "ALL PASSED\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,217 @@
+/**
+ * Host test for the MQTT publish window (MQTTPublishBatch.h).
+ *
+ * processOT() opens one window per decoded OT frame (MQTTPublishBatchScope)
+ * so the ~30 publishes of a Status frame share one link/heap gate verdict.
+ * This file checks:
+ *
+ *   1. Begin/append/commit: a window opens and closes, appends are counted
+ *      only inside a window, an empty window is not a batch, and an
+ *      unbalanced commit is ignored.
+ *   2. Nesting: only the outermost begin/commit pair opens and closes the
+ *      window; inner appends fold into the outer window.
+ *   3. Gate caching: outside a window the gate is evaluated per publish;
+ *      inside it is evaluated once, lazily (not at all when nothing
+ *      publishes), its verdict (OPEN, CLOSED or HEAP) is reused even when the
+ *      link changes mid-window, and the next window evaluates afresh.
+ *   4. Counters: batches, batchedMessages, maxMessages and gateChecksSaved
+ *      across several windows, and the per-window message count saturating
+ *      at UINT16_MAX instead of wrapping.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/test_mqtt_publish_batch.cpp -o tests/test_mqtt_publish_batch.out
+ *   ./tests/test_mqtt_publish_batch.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <cstdint>
+#include <cstdio>
+
+#include "../src/OTGW-firmware/MQTTPublishBatch.h"
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...)                                  \
+  do {                                                    \
+    checks++;                                             \
+    if (!(cond)) {                                        \
+      failures++;                                         \
+      if (failures <= 20) {                               \
+        std::printf("FAIL %s:%d: ", __FILE__, __LINE__);  \
+        std::printf(__VA_ARGS__);                         \
+        std::printf("\n");                                \
+      }                                                   \
+    }                                                     \
+  } while (0)
+
+// Stand-in for mqttPublishGatesOpen()'s link/heap evaluation.
+static uint8_t g_link = MQTT_BATCH_GATE_OPEN;
+static int g_evaluations = 0;
+
+static uint8_t evaluateGate()
+{
+  g_evaluations++;
+  return g_link;
+}
+
+// One publish the way sendMQTTData() does it: gate, then append when open.
+static bool publish(MqttPublishBatch &b)
+{
+  if (mqttBatchLinkGate(b, evaluateGate) != MQTT_BATCH_GATE_OPEN) return false;
+  mqttBatchAppend(b);
+  return true;
+}
+
+static void reset()
+{
+  g_link = MQTT_BATCH_GATE_OPEN;
+  g_evaluations = 0;
+}
+
+static void testBeginAppendCommit()
+{
+  reset();
+  MqttPublishBatch b;
+  CHECK(!mqttBatchActive(b), "fresh batch active");
+  CHECK(!mqttBatchCommit(b), "commit without begin closed a window");
+  CHECK(b.depth == 0 && b.batches == 0, "unbalanced commit changed state");
+
+  mqttBatchAppend(b);                                   // outside: not counted
+  CHECK(b.messages == 0, "append outside a window counted: %u", b.messages);
+
+  mqttBatchBegin(b);
+  CHECK(mqttBatchActive(b), "window not active after begin");
+  for (int i = 0; i < 3; i++) CHECK(publish(b), "publish %d refused", i);
+  CHECK(b.messages == 3, "messages %u", b.messages);
+  CHECK(mqttBatchCommit(b), "outermost commit did not close");
+  CHECK(!mqttBatchActive(b), "window still active");
+  CHECK(b.batches == 1 && b.batchedMessages == 3, "batches %u msgs %u", b.batches, b.batchedMessages);
+  CHECK(!mqttBatchCommit(b), "second commit closed again");
+
+  // Empty window: commits, not a batch, gate never consulted.
+  const int before = g_evaluations;
+  mqttBatchBegin(b);
+  CHECK(mqttBatchCommit(b), "empty window did not close");
+  CHECK(b.batches == 1, "empty window counted as batch");
+  CHECK(g_evaluations == before, "empty window evaluated the gate");
+}
+
+static void testNesting()
+{
+  reset();
+  MqttPublishBatch b;
+  mqttBatchBegin(b);
+  publish(b);
+  mqttBatchBegin(b);
+  CHECK(b.depth == 2, "depth %u", b.depth);
+  publish(b);
+  publish(b);
+  CHECK(!mqttBatchCommit(b), "inner commit closed the window");
+  CHECK(mqttBatchActive(b) && b.messages == 3, "inner commit reset the window (msgs %u)", b.messages);
+  CHECK(b.batches == 0, "inner commit folded counters");
+  mqttBatchBegin(b);                                    // inner begin must not reset
+  CHECK(b.messages == 3, "inner begin reset messages");
+  CHECK(!mqttBatchCommit(b), "second inner commit closed");
+  CHECK(mqttBatchCommit(b), "outer commit did not close");
+  CHECK(b.batches == 1 && b.batchedMessages == 3 && b.maxMessages == 3,
+        "nested totals %u/%u/%u", b.batches, b.batchedMessages, b.maxMessages);
+  CHECK(g_evaluations == 1, "nested window evaluated %d times", g_evaluations);
+}
+
+static void testGateCaching()
+{
+  reset();
+  MqttPublishBatch b;
+
+  // Outside a window: every publish evaluates, and follows the link.
+  publish(b);
+  publish(b);
+  g_link = MQTT_BATCH_GATE_CLOSED;
+  CHECK(!publish(b), "closed link published outside a window");
+  CHECK(g_evaluations == 3, "unbatched evaluations %d", g_evaluations);
+  CHECK(b.gateChecks == 0, "unbatched consults counted");
+
+  // Inside: one evaluation, verdict stands when the link changes mid-window.
+  g_link = MQTT_BATCH_GATE_OPEN;
+  g_evaluations = 0;
+  mqttBatchBegin(b);
+  CHECK(b.gate == MQTT_BATCH_GATE_UNKNOWN, "window opened with a verdict");
+  CHECK(g_evaluations == 0, "begin evaluated eagerly");
+  CHECK(publish(b), "open link refused");
+  g_link = MQTT_BATCH_GATE_CLOSED;
+  CHECK(publish(b), "cached OPEN not reused");
+  CHECK(g_evaluations == 1, "window evaluated %d times", g_evaluations);
+  mqttBatchCommit(b);
+  CHECK(b.gate == MQTT_BATCH_GATE_UNKNOWN, "verdict survived the commit");
+
+  // Next window re-evaluates: CLOSED is cached as well.
+  mqttBatchBegin(b);
+  CHECK(!publish(b), "closed link published");
+  g_link = MQTT_BATCH_GATE_OPEN;
+  CHECK(!publish(b), "cached CLOSED not reused");
+  CHECK(g_evaluations == 2, "evaluations %d", g_evaluations);
+  CHECK(b.gate == MQTT_BATCH_GATE_CLOSED, "gate %u", b.gate);
+  mqttBatchCommit(b);
+
+  // HEAP is a verdict like the others: every publish in the window drops.
+  g_link = MQTT_BATCH_GATE_HEAP;
+  mqttBatchBegin(b);
+  CHECK(mqttBatchLinkGate(b, evaluateGate) == MQTT_BATCH_GATE_HEAP, "heap verdict");
+  g_link = MQTT_BATCH_GATE_OPEN;
+  CHECK(mqttBatchLinkGate(b, evaluateGate) == MQTT_BATCH_GATE_HEAP, "heap verdict not cached");
+  CHECK(g_evaluations == 3, "evaluations %d", g_evaluations);
+  mqttBatchCommit(b);
+  CHECK(mqttBatchLinkGate(b, evaluateGate) == MQTT_BATCH_GATE_OPEN, "heap verdict leaked out of the window");
+}
+
+static void testCounters()
+{
+  reset();
+  MqttPublishBatch b;
+
+  const int sizes[] = { 5, 0, 30, 1, 12 };
+  uint32_t total = 0, saved = 0, batches = 0;
+  for (int n : sizes) {
+    mqttBatchBegin(b);
+    for (int i = 0; i < n; i++) publish(b);
+    mqttBatchCommit(b);
+    total += (uint32_t)n;
+    if (n > 0) batches++;
+    if (n > 1) saved += (uint32_t)(n - 1);
+  }
+  CHECK(b.batches == batches, "batches %u want %u", b.batches, batches);
+  CHECK(b.batchedMessages == total, "batchedMessages %u want %u", b.batchedMessages, total);
+  CHECK(b.maxMessages == 30, "maxMessages %u", b.maxMessages);
+  CHECK(b.gateChecksSaved == saved, "gateChecksSaved %u want %u", b.gateChecksSaved, saved);
+  CHECK(g_evaluations == (int)batches, "evaluations %d want %u", g_evaluations, batches);
+
+  // Refused publishes still consult the (cached) gate: those are saved too.
+  g_link = MQTT_BATCH_GATE_CLOSED;
+  mqttBatchBegin(b);
+  for (int i = 0; i < 4; i++) publish(b);
+  mqttBatchCommit(b);
+  CHECK(b.batches == batches, "refused window counted as batch");
+  CHECK(b.gateChecksSaved == saved + 3, "gateChecksSaved %u want %u", b.gateChecksSaved, saved + 3);
+
+  // The per-window count saturates instead of wrapping to a small number.
+  g_link = MQTT_BATCH_GATE_OPEN;
+  mqttBatchBegin(b);
+  for (uint32_t i = 0; i < (uint32_t)UINT16_MAX + 10; i++) mqttBatchAppend(b);
+  CHECK(b.messages == UINT16_MAX, "messages %u", b.messages);
+  mqttBatchCommit(b);
+  CHECK(b.maxMessages == UINT16_MAX, "maxMessages %u", b.maxMessages);
+  CHECK(b.batchedMessages == total + UINT16_MAX, "batchedMessages %u", b.batchedMessages);
+}
+
+int main()
+{
+  testBeginAppendCommit();
+  testNesting();
+  testGateCaching();
+  testCounters();
+
+  std::printf("%d checks, %d failures\n", checks, failures);
+  std::printf(failures ? "FAILED\n" : "ALL PASSED\n");
+  return failures ? 1 : 0;
+}
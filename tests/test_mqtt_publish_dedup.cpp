@@ -0,0 +1,192 @@
+/**
+ * Host test for the value-topic duplicate-payload filter (MQTTPublishDedup.h).
+ *
+ * mqttPublishFullTopic() in MQTTstuff.ino asks mqttDedupCheck() before every
+ * value publish and calls mqttDedupCommit() once the publish is queued. This
+ * file checks that the filter only ever drops what the broker already has:
+ *
+ *   1. New topic, unchanged payload within the heartbeat, changed payload,
+ *      heartbeat expiry, failed publish (no commit), heartbeat 0, clear, and
+ *      a millis() wrap between two publishes.
+ *   2. Against an exact per-topic model (std::map of last payload + time) on
+ *      random streams: with fewer topics than slots the verdicts are
+ *      identical; with 4x more topics than slots a publish is never dropped
+ *      unless the model would drop it too (evictions only add sends).
+ *   3. A stable system (300 topics published once a second, a few changing)
+ *      sends far fewer messages, and every topic still goes out at least once
+ *      per heartbeat.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/test_mqtt_publish_dedup.cpp -o tests/test_mqtt_publish_dedup.out
+ *   ./tests/test_mqtt_publish_dedup.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/OTGW-firmware/MQTTPublishDedup.h"
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...)                                  \
+  do {                                                    \
+    checks++;                                             \
+    if (!(cond)) {                                        \
+      failures++;                                         \
+      if (failures <= 20) {                               \
+        std::printf("FAIL %s:%d: ", __FILE__, __LINE__);  \
+        std::printf(__VA_ARGS__);                         \
+        std::printf("\n");                                \
+      }                                                   \
+    }                                                     \
+  } while (0)
+
+// The firmware path: check, publish, commit on success.
+static bool publish(MqttPublishDedup &d, const std::string &topic, const std::string &payload,
+                    uint32_t now, uint32_t heartbeat, bool publishOk = true)
+{
+  MqttDedupVerdict v = mqttDedupCheck(d, topic.c_str(),
+                                      reinterpret_cast<const uint8_t *>(payload.data()),
+                                      payload.size(), now, heartbeat);
+  if (!v.send) return false;
+  if (publishOk) mqttDedupCommit(d, v, now);
+  return true;
+}
+
+// ---- 1. Basic behaviour ----
+static void testBasics()
+{
+  static MqttPublishDedup d;
+  const uint32_t hb = 59000;
+  const std::string t = "OTGW/value/otgw-AABBCC/Tboiler";
+
+  CHECK(publish(d, t, "45.50", 1000, hb), "new topic is sent");
+  CHECK(!publish(d, t, "45.50", 2000, hb), "same payload within heartbeat is dropped");
+  CHECK(publish(d, t, "45.56", 3000, hb), "changed payload is sent");
+  CHECK(!publish(d, t, "45.56", 3000 + hb - 1, hb), "dropped until the heartbeat");
+  CHECK(publish(d, t, "45.56", 3000 + hb, hb), "sent when the heartbeat expires");
+  CHECK(d.hits == 2 && d.misses == 2 && d.refreshes == 1 && d.used == 1,
+        "counters %u/%u/%u used %u", (unsigned)d.hits, (unsigned)d.misses,
+        (unsigned)d.refreshes, (unsigned)d.used);
+
+  // Failed publish: nothing recorded, the retry goes out.
+  CHECK(publish(d, t, "46.00", 70000, hb, /*publishOk=*/false), "changed payload sent (publish fails)");
+  CHECK(publish(d, t, "46.00", 70100, hb), "retried after a failed publish");
+  CHECK(!publish(d, t, "46.00", 70200, hb), "then deduplicated");
+
+  // Same payload on a different topic is independent.
+  CHECK(publish(d, t + "_boiler", "46.00", 70300, hb), "source variant is its own topic");
+
+  // Empty payload is a payload like any other (the length is in the hash).
+  CHECK(publish(d, "OTGW/x", "", 0, hb), "empty payload sent");
+  CHECK(!publish(d, "OTGW/x", "", 10, hb), "empty payload deduplicated");
+  CHECK(publish(d, "OTGW/x", std::string(1, '\0'), 20, hb), "one NUL byte differs from empty");
+
+  // Heartbeat 0 = on-change publishing off: never drop.
+  CHECK(publish(d, t, "46.00", 70400, 0), "heartbeat 0 never drops");
+
+  // millis() wrap between two publishes.
+  static MqttPublishDedup w;
+  CHECK(publish(w, t, "1", 0xFFFFF000u, hb), "before wrap");
+  CHECK(!publish(w, t, "1", 0x00001000u, hb), "8 s later across the wrap: dropped");
+  CHECK(publish(w, t, "1", 0xFFFFF000u + hb, hb), "heartbeat across the wrap: sent");
+
+  // Clear: every topic is new again, counters kept.
+  const uint32_t hitsBefore = d.hits;
+  mqttDedupClear(d);
+  CHECK(d.used == 0, "clear empties the table");
+  CHECK(publish(d, t, "46.00", 70500, hb), "sent after clear");
+  CHECK(d.hits == hitsBefore, "clear keeps the counters");
+
+  CHECK(mqttDedupTopicHash("") != 0, "topic hash never 0");
+}
+
+// ---- 2. Against an exact per-topic model ----
+struct ModelEntry { std::string payload; uint32_t sentMs; };
+
+static void runModel(int topics, int steps, bool expectIdentical, uint32_t seed)
+{
+  static MqttPublishDedup d;
+  d = MqttPublishDedup();
+  std::map<std::string, ModelEntry> model;
+  std::mt19937 rng(seed);
+  const uint32_t hb = 9000;
+  uint32_t now = 0xFFF00000u;               // run through a millis() wrap
+  int differ = 0, falseDrops = 0, sent = 0;
+
+  for (int step = 0; step < steps; step++) {
+    now += rng() % 200;
+    const std::string topic = "OTGW/value/n/t" + std::to_string(rng() % topics);
+    const std::string payload = std::to_string(rng() % 3);
+    const bool ok = (rng() % 50) != 0;      // 2 % failed publishes
+
+    auto it = model.find(topic);
+    const bool modelSend = it == model.end() || it->second.payload != payload
+                           || (uint32_t)(now - it->second.sentMs) >= hb;
+    const bool send = publish(d, topic, payload, now, hb, ok);
+    if (send && ok) model[topic] = ModelEntry{payload, now};
+    if (send != modelSend) differ++;
+    if (!send && modelSend) falseDrops++;
+    sent += send;
+  }
+  std::printf("  %4d topics, %d publishes: sent %d, evictions %u, verdicts differ %d\n",
+              topics, steps, sent, (unsigned)d.evictions, differ);
+  if (expectIdentical) {
+    CHECK(differ == 0 && d.evictions == 0, "%d verdicts differ from the exact model", differ);
+  }
+  CHECK(falseDrops == 0, "%d publishes dropped that the exact model would send", falseDrops);
+}
+
+// ---- 3. Stable system ----
+static void testStableSystem()
+{
+  static MqttPublishDedup d;
+  d = MqttPublishDedup();
+  const int topics = 300;
+  const uint32_t hb = 59000;                // MQTTinterval 60 s
+  std::vector<int> value(topics, 0);
+  std::vector<uint32_t> lastSent(topics, 0);
+  std::mt19937 rng(3);
+  uint64_t offered = 0, sent = 0;
+  uint32_t worstGap = 0;
+
+  for (uint32_t sec = 0; sec < 3600; sec++) {
+    const uint32_t now = sec * 1000;
+    for (int i = 0; i < topics; i++) {
+      if (rng() % 100 < 2) value[i]++;       // 2 % of the topics change per second
+      char topic[64], payload[16];
+      std::snprintf(topic, sizeof(topic), "OTGW/value/otgw-AABBCC/topic%d", i);
+      std::snprintf(payload, sizeof(payload), "%d", value[i]);
+      offered++;
+      if (publish(d, topic, payload, now, hb)) {
+        sent++;
+        if (sec > 0 && now - lastSent[i] > worstGap) worstGap = now - lastSent[i];
+        lastSent[i] = now;
+      }
+    }
+  }
+  std::printf("  stable system: %llu offered, %llu sent (%.1f %%), hits %u, worst gap %u ms\n",
+              (unsigned long long)offered, (unsigned long long)sent, 100.0 * sent / offered,
+              (unsigned)d.hits, (unsigned)worstGap);
+  CHECK(sent * 10 < offered, "dedup should cut a stable system's publishes by >90 %%");
+  CHECK(worstGap <= hb + 1000, "a topic went %u ms without a publish", (unsigned)worstGap);
+  CHECK(d.evictions == 0 && d.used == topics, "300 topics fit without eviction (%u evictions, %u used)", (unsigned)d.evictions, (unsigned)d.used);
+}
+
+int main()
+{
+  testBasics();
+  runModel(200, 200000, true, 1);
+  runModel(MQTT_DEDUP_SLOTS * 4, 400000, false, 2);
+  testStableSystem();
+  std::printf("%d checks, %d failures\n", checks, failures);
+  std::printf(failures ? "FAILED\n" : "ALL PASSED\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+/**
+ * Host test for the integer f8.8 helpers (OTF88.h).
+ *
+ * print_f88() and the PS=1 summary now format f8.8 values with
+ * otF88Format() / otFormatCenti() instead of roundf() + dtostrf(), and
+ * OTDirect encodes with otF88FromFloat() instead of a truncating cast. This
+ * file runs every one of the 65536 f8.8 values through both paths:
+ *
+ *   1. otF88ToFloat() equals the legacy OpenthermData_t::f88() bit for bit,
+ *      and otF88FromFloat() takes it back to the same value.
+ *   2. otF88ToCenti() equals roundf(f88 * 100), and the float print_f88()
+ *      stores (centi / 100.0f) is the legacy roundf(...) / 100.0f.
+ *   3. otF88Format() gives the same MQTT payload and log text as the legacy
+ *      roundf() + dtostrf(v, 3, 2) (the Arduino-ESP32 dtostrf(), lifted
+ *      below), and the text is the exact decimal value rounded half away
+ *      from zero (checked with integer long division).
+ *   4. otF88FromFloat(): nearest value for 0.001 °C steps over the clamp
+ *      range of floatToF88(), saturation, NaN; otFormatCenti() edges and a
+ *      too-small buffer. The PS=1 path (parse two-decimal text, publish)
+ *      gives the legacy dtostrf() text for every value the PIC can print.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/test_ot_f88.cpp -o tests/test_ot_f88.out
+ *   ./tests/test_ot_f88.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../src/OTGW-firmware/OTF88.h"
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...)                                  \
+  do {                                                    \
+    checks++;                                             \
+    if (!(cond)) {                                        \
+      failures++;                                         \
+      if (failures <= 20) {                               \
+        std::printf("FAIL %s:%d: ", __FILE__, __LINE__);  \
+        std::printf(__VA_ARGS__);                         \
+        std::printf("\n");                                \
+      }                                                   \
+    }                                                     \
+  } while (0)
+
+// ---- Legacy path ----
+
+// Arduino-ESP32 cores/esp32/stdlib_noniso.c dtostrf().
+static char *dtostrf(double number, signed int width, unsigned int prec, char *s)
+{
+  bool negative = false;
+  if (std::isnan(number)) { std::strcpy(s, "nan"); return s; }
+  if (std::isinf(number)) { std::strcpy(s, "inf"); return s; }
+  char *out = s;
+  int fillme = width;
+  if (prec > 0) fillme -= (prec + 1);
+  if (number < 0.0) { negative = true; fillme--; number = -number; }
+  double rounding = 2.0;
+  for (unsigned int i = 0; i < prec; ++i) rounding *= 10.0;
+  rounding = 1.0 / rounding;
+  number += rounding;
+  double tenpow = 1.0;
+  unsigned int digitcount = 1;
+  while (number >= 10.0 * tenpow) { tenpow *= 10.0; digitcount++; }
+  number /= tenpow;
+  fillme -= digitcount;
+  while (fillme-- > 0) *out++ = ' ';
+  if (negative) *out++ = '-';
+  digitcount += prec;
+  int8_t digit = 0;
+  while (digitcount-- > 0) {
+    digit = (int8_t)number;
+    if (digit > 9) digit = 9;
+    *out++ = (char)('0' | digit);
+    if ((digitcount == prec) && (prec > 0)) *out++ = '.';
+    number -= digit;
+    number *= 10.0;
+  }
+  *out = 0;
+  return s;
+}
+
+// OpenthermData_t::f88() before OTF88.h.
+static float legacyF88(uint8_t valueHB, uint8_t valueLB)
+{
+  float value = (int8_t)valueHB;
+  return value + (float)valueLB / 256.0f;
+}
+
+// print_f88() before OTF88.h: stored value and payload text.
+static float legacyPrintF88(uint8_t hb, uint8_t lb, char msg[15])
+{
+  float _value = roundf(legacyF88(hb, lb) * 100.0f) / 100.0f;
+  std::memset(msg, 0, 15);
+  dtostrf(_value, 3, 2, msg);
+  return _value;
+}
+
+// Exact decimal text of q/256 rounded half away from zero to 2 decimals,
+// by integer long division (independent of otF88ToCenti()).
+static void exactText(int16_t q, char *out, size_t size)
+{
+  const long mag = std::labs((long)q);
+  const long num = mag * 100;               // hundredths * 256
+  long centi = num / 256;
+  if ((num % 256) * 2 >= 256) centi++;
+  if (centi == 0) std::snprintf(out, size, "0.00");
+  else std::snprintf(out, size, "%s%ld.%02ld", q < 0 ? "-" : "", centi / 100, centi % 100);
+}
+
+// ---- 1-3. All 65536 values ----
+static void testAllValues()
+{
+  int floatDiff = 0, roundTrip = 0, centiDiff = 0, storedDiff = 0, textDiff = 0, exactDiff = 0;
+  for (int raw = 0; raw < 65536; raw++) {
+    const uint8_t hb = (uint8_t)(raw >> 8), lb = (uint8_t)raw;
+    const int16_t q = otF88FromBytes(hb, lb);
+    const float legacy = legacyF88(hb, lb);
+    const float exact = otF88ToFloat(q);
+    if (std::memcmp(&legacy, &exact, sizeof(float)) != 0) floatDiff++;
+    if (otF88FromFloat(exact) != q) roundTrip++;
+
+    const int16_t centi = otF88ToCenti(q);
+    if ((float)centi != roundf(legacy * 100.0f)) centiDiff++;
+
+    char legacyMsg[15], msg[OT_F88_TEXT_LEN], ex[16];
+    const float stored = legacyPrintF88(hb, lb, legacyMsg);
+    const float newStored = (float)centi / 100.0f;
+    if (stored != newStored) storedDiff++;   // -0.0f (legacy, raw FFFF) == 0.0f
+    otF88Format(q, msg, sizeof(msg));
+    if (std::strcmp(msg, legacyMsg) != 0) {
+      if (textDiff < 5) std::printf("  raw %04X: legacy \"%s\" new \"%s\"\n", raw, legacyMsg, msg);
+      textDiff++;
+    }
+    exactText(q, ex, sizeof(ex));
+    if (std::strcmp(msg, ex) != 0) exactDiff++;
+  }
+  CHECK(floatDiff == 0, "%d values: otF88ToFloat() != OpenthermData_t::f88()", floatDiff);
+  CHECK(roundTrip == 0, "%d values do not survive float and back", roundTrip);
+  CHECK(centiDiff == 0, "%d values: otF88ToCenti() != roundf(f88 * 100)", centiDiff);
+  CHECK(storedDiff == 0, "%d values: stored state differs from roundf()/100", storedDiff);
+  CHECK(textDiff == 0, "%d values: payload differs from roundf + dtostrf", textDiff);
+  CHECK(exactDiff == 0, "%d values: payload is not the exact decimal rounding", exactDiff);
+}
+
+// ---- 4. Encoding and formatting edges ----
+static void testEdges()
+{
+  // Nearest Q8.8 for every 0.001 step in floatToF88()'s -40..127 clamp range.
+  int notNearest = 0;
+  for (int m = -40000; m <= 127000; m++) {
+    const float v = (float)m / 1000.0f;
+    const int16_t q = otF88FromFloat(v);
+    const double err = std::fabs((double)q / 256.0 - (double)v);
+    if (err > 0.5 / 256.0 + 1e-9) notNearest++;
+  }
+  CHECK(notNearest == 0, "%d values not encoded to the nearest f8.8", notNearest);
+  // Spec examples (OpenTherm v4.2 §4.2.2: f8.8 two's complement).
+  CHECK(otF88FromFloat(21.5f) == 0x1580, "21.5 -> %04X", (unsigned)(uint16_t)otF88FromFloat(21.5f));
+  CHECK((uint16_t)otF88FromFloat(-1.0f) == 0xFF00, "-1.0");
+  CHECK((uint16_t)otF88FromFloat(-0.00390625f) == 0xFFFF, "-1/256");
+  CHECK(otF88FromFloat(20.3f) == 5197, "20.3 rounds to nearest (was truncated to 5196)");
+  CHECK(otF88FromFloat(-20.3f) == -5197, "-20.3 rounds to nearest");
+  CHECK(otF88FromFloat(1000.0f) == INT16_MAX && otF88FromFloat(-1000.0f) == INT16_MIN, "saturates");
+  CHECK(otF88FromFloat(NAN) == 0, "NaN -> 0");
+
+  char b[OT_F88_TEXT_LEN];
+  otF88Format(INT16_MIN, b, sizeof(b));
+  CHECK(std::strcmp(b, "-128.00") == 0, "INT16_MIN -> %s", b);
+  otF88Format(INT16_MAX, b, sizeof(b));
+  CHECK(std::strcmp(b, "128.00") == 0, "INT16_MAX -> %s", b);
+  otF88Format(-1, b, sizeof(b));
+  CHECK(std::strcmp(b, "0.00") == 0, "-1/256 -> %s (no sign on zero)", b);
+  otF88Format(-2, b, sizeof(b));
+  CHECK(std::strcmp(b, "-0.01") == 0, "-2/256 -> %s", b);
+  char small[7];
+  CHECK(otF88Format(INT16_MIN, small, sizeof(small)) == 0 && small[0] == '\0', "too small: empty");
+  char wide[16];
+  CHECK(otFormatCenti(INT32_MIN, wide, sizeof(wide)) == 12 && std::strcmp(wide, "-21474836.48") == 0,
+        "INT32_MIN -> %s", wide);
+  otFormatCenti(-123456, wide, sizeof(wide));
+  CHECK(std::strcmp(wide, "-1234.56") == 0, "centi -> %s", wide);
+}
+
+// ---- PS=1: two-decimal text from the PIC, republished ----
+static void testPSSummary()
+{
+  int diff = 0;
+  for (int c = -12800; c <= 12799; c++) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "%s%d.%02d", c < 0 ? "-" : "", std::abs(c) / 100, std::abs(c) % 100);
+    const float value = std::strtof(text, nullptr);
+    char legacy[12] = {0};
+    dtostrf(value, 3, 2, legacy);
+    char now[12];
+    otFormatCenti((int32_t)lroundf(value * 100.0f), now, sizeof(now));
+    if (std::strcmp(legacy, now) != 0) {
+      if (diff < 5) std::printf("  PS text \"%s\": legacy \"%s\" new \"%s\"\n", text, legacy, now);
+      diff++;
+    }
+  }
+  CHECK(diff == 0, "%d PS=1 values format differently", diff);
+}
+
+int main()
+{
+  testAllValues();
+  testEdges();
+  testPSSummary();
+  std::printf("%d checks, %d failures\n", checks, failures);
+  std::printf(failures ? "FAILED\n" : "ALL PASSED\n");
+  return failures ? 1 : 0;
+}
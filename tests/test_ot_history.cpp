@@ -0,0 +1,378 @@
+/**
+ * Host test for the graph history store (OTHistory.h).
+ *
+ * historyStuff.ino samples flow/return/room temperature, setpoints,
+ * modulation, pressure and flame once a second into 1s/1m/15m rings of
+ * 64-byte delta/run-length blocks; GET /api/v2/history decodes them. This
+ * file checks:
+ *
+ *   1. Block encoding round-trips random walks with small steps, big jumps,
+ *      repeats and OT_HIST_MISSING, token by token up to a full block; a full
+ *      block refuses the value and stays unchanged.
+ *   2. Runs: a constant signal costs one byte per 64 samples; a corrupt
+ *      token stops the decoder, which never returns more than n samples.
+ *   3. Rings: a gap or a full block starts the next block, an old or repeated
+ *      time is dropped, the oldest block is overwritten, blocks walk oldest
+ *      first.
+ *   4. Downsampling: 1m means of the 1 s samples (rounded, missing samples
+ *      left out, an all-missing minute missing), 15m means of the minutes,
+ *      time going backwards ignored.
+ *   5. Reads: otHistCopyBlocks() range/metric filter and otHistPickTier().
+ *   6. Size: a simulated boiler day fits the 1m tier; prints bytes per sample.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/test_ot_history.cpp -o tests/test_ot_history.out
+ *   ./tests/test_ot_history.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../src/OTGW-firmware/OTHistory.h"
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...)                                  \
+  do {                                                    \
+    checks++;                                             \
+    if (!(cond)) {                                        \
+      failures++;                                         \
+      if (failures <= 20) {                               \
+        std::printf("FAIL %s:%d: ", __FILE__, __LINE__);  \
+        std::printf(__VA_ARGS__);                         \
+        std::printf("\n");                                \
+      }                                                   \
+    }                                                     \
+  } while (0)
+
+struct Sample { uint32_t t; int16_t v; };
+
+static std::vector<Sample> decode(const OTHistBlock &b, uint16_t step)
+{
+  std::vector<Sample> out;
+  otHistBlockDecode(b, step, [&](uint32_t t, int16_t v) { out.push_back({t, v}); });
+  return out;
+}
+
+static std::vector<Sample> decodeRing(const OTHistStore &s, uint8_t tier, uint8_t m)
+{
+  std::vector<Sample> out;
+  otHistForEachBlock(s, tier, m, [&](const OTHistBlock &b) {
+    otHistBlockDecode(b, kOTHistStep[tier], [&](uint32_t t, int16_t v) { out.push_back({t, v}); });
+  });
+  return out;
+}
+
+static int16_t nextValue(std::mt19937 &rng, int16_t prev)
+{
+  const uint32_t r = rng() % 100;
+  if (r < 40) return prev;                                          // repeat
+  if (r < 80) return (int16_t)std::max(-30000, std::min(30000, prev + (int)(rng() % 129) - 64)); // small step
+  if (r < 90) return OT_HIST_MISSING;
+  return (int16_t)((int)(rng() % 60001) - 30000);                   // big jump
+}
+
+// ---- 1. Round trip ----
+static void testRoundTrip()
+{
+  std::mt19937 rng(1);
+  int bad = 0, partial = 0, changedOnRefuse = 0;
+  for (int run = 0; run < 20000; run++) {
+    OTHistBlock b;
+    otHistBlockClear(b);
+    b.t0 = 1700000000u + run;
+    std::vector<int16_t> want;
+    int16_t v = (int16_t)((int)(rng() % 4000) - 1000);
+    for (;;) {
+      const OTHistBlock before = b;
+      if (!otHistBlockAppend(b, v)) {
+        if (std::memcmp(&before, &b, sizeof(b)) != 0) changedOnRefuse++;
+        break;
+      }
+      want.push_back(v);
+      // Decode after every append: the open run token is always consistent.
+      if (want.size() % 7 == 0) {
+        const std::vector<Sample> got = decode(b, 1);
+        if (got.size() != want.size()) partial++;
+      }
+      v = nextValue(rng, v);
+    }
+    const std::vector<Sample> got = decode(b, 60);
+    if (got.size() != want.size() || b.n != want.size()) { bad++; continue; }
+    for (size_t i = 0; i < want.size(); i++) {
+      if (got[i].v != want[i] || got[i].t != b.t0 + (uint32_t)i * 60) { bad++; break; }
+    }
+    CHECK(b.used <= OT_HIST_BLOCK_DATA, "used %u", b.used);
+  }
+  CHECK(bad == 0, "%d blocks did not round-trip", bad);
+  CHECK(partial == 0, "%d partial decodes short", partial);
+  CHECK(changedOnRefuse == 0, "%d full blocks changed on a refused append", changedOnRefuse);
+
+  // Delta edges: -64..+63 one byte, -4096..+4095 two, beyond and missing three.
+  OTHistBlock b;
+  otHistBlockClear(b);
+  otHistBlockAppend(b, 0);
+  otHistBlockAppend(b, -64);   CHECK(b.used == 1, "delta -64 is one byte");
+  otHistBlockAppend(b, -1);    CHECK(b.used == 2, "delta +63 is one byte");
+  otHistBlockAppend(b, 63);    CHECK(b.used == 4, "delta +64 is two bytes");
+  otHistBlockAppend(b, -2);    CHECK(b.used == 6, "delta -65 is two bytes");
+  otHistBlockAppend(b, 4093);  CHECK(b.used == 8, "delta +4095 is two bytes");
+  otHistBlockAppend(b, -3);    CHECK(b.used == 10, "delta -4096 is two bytes");
+  otHistBlockAppend(b, 4093);  CHECK(b.used == 13, "delta +4096 is absolute");
+  otHistBlockAppend(b, OT_HIST_MISSING); CHECK(b.used == 16, "to missing is absolute");
+  otHistBlockAppend(b, -1);    CHECK(b.used == 19, "from missing is absolute");
+  const std::vector<Sample> got = decode(b, 1);
+  const int16_t want[] = {0, -64, -1, 63, -2, 4093, -3, 4093, OT_HIST_MISSING, -1};
+  bool same = got.size() == 10;
+  for (size_t i = 0; same && i < 10; i++) same = got[i].v == want[i];
+  CHECK(same, "edge values round-trip");
+}
+
+// ---- 2. Runs and corrupt blocks ----
+static void testRuns()
+{
+  OTHistBlock b;
+  otHistBlockClear(b);
+  int n = 0;
+  while (otHistBlockAppend(b, 1500)) n++;
+  CHECK(n == 1 + OT_HIST_BLOCK_DATA * 64, "constant block holds %d samples", n);
+  CHECK(b.used == OT_HIST_BLOCK_DATA, "used %u", b.used);
+  const std::vector<Sample> got = decode(b, 1);
+  bool all = got.size() == (size_t)n;
+  for (const Sample &s : got) all = all && s.v == 1500;
+  CHECK(all, "constant block decodes");
+
+  // A run is broken by a change and a new run starts after it.
+  otHistBlockClear(b);
+  for (int i = 0; i < 10; i++) otHistBlockAppend(b, 0);
+  otHistBlockAppend(b, 1);
+  for (int i = 0; i < 10; i++) otHistBlockAppend(b, 1);
+  CHECK(b.used == 3 && b.data[0] == 0x88 && b.data[1] == 0x02 && b.data[2] == 0x89,
+        "run/delta/run tokens %02x %02x %02x", b.data[0], b.data[1], b.data[2]);
+
+  // n caps the decode even if the run token says more (a copy mid-append).
+  b.n = 15;
+  CHECK(decode(b, 1).size() == 15, "decode capped at n");
+  // An invalid token stops the decoder.
+  otHistBlockClear(b);
+  b.n = 40; b.first = 7; b.used = 3; b.data[0] = 0x02; b.data[1] = 0x00; b.data[2] = 0x02;
+  CHECK(decode(b, 1).size() == 2, "0x00 token stops the decoder");
+  b.data[1] = 0xC5;
+  CHECK(decode(b, 1).size() == 2, "0xC5 token stops the decoder");
+  b.used = 200;                                    // corrupt length from flash
+  CHECK(decode(b, 1).size() <= 40, "corrupt used stays bounded");
+  b.data[1] = 0xC0; b.used = 2;                    // absolute token cut short
+  CHECK(decode(b, 1).size() == 2, "truncated absolute stops");
+}
+
+// ---- 3. Rings ----
+static void testRings()
+{
+  OTHistBlock ring[4];
+  for (OTHistBlock &b : ring) otHistBlockClear(b);
+  uint8_t head = 0;
+  otHistRingAppend(ring, 4, head, 1000, 60, 10);
+  otHistRingAppend(ring, 4, head, 1060, 60, 11);
+  otHistRingAppend(ring, 4, head, 1060, 60, 99);   // repeated time: dropped
+  otHistRingAppend(ring, 4, head, 1000, 60, 99);   // older: dropped
+  CHECK(head == 0 && ring[0].n == 2, "dropped old samples (n=%u)", ring[0].n);
+  otHistRingAppend(ring, 4, head, 1300, 60, 12);   // gap: next block
+  CHECK(head == 1 && ring[1].t0 == 1300 && ring[1].n == 1, "gap starts a block");
+  otHistRingAppend(ring, 4, head, 1330, 60, 13);   // inside the current step: dropped
+  otHistRingAppend(ring, 4, head, 1390, 60, 13);   // off-step: next block too
+  CHECK(head == 2 && ring[1].n == 1 && ring[2].t0 == 1390, "off-step starts a block");
+
+  // Fill to wrap: the oldest block is overwritten, order stays oldest-first.
+  OTHistStore *s = new OTHistStore;
+  otHistReset(*s);
+  std::mt19937 rng(3);
+  uint32_t t = 1700000000u;
+  int16_t v = 2000;
+  std::vector<Sample> all;
+  for (int i = 0; i < 200000; i++) {
+    v = (int16_t)(v + (int)(rng() % 201) - 100);
+    otHistRingAppend(s->b1s[0], OT_HIST_BLOCKS_1S, s->head[OTH_TIER_1S][0], t, 1, v);
+    all.push_back({t, v});
+    t += (rng() % 500 == 0) ? 30 : 1;              // occasional gap
+  }
+  const std::vector<Sample> kept = decodeRing(*s, OTH_TIER_1S, 0);
+  CHECK(!kept.empty() && kept.size() < all.size(), "ring kept %zu of %zu", kept.size(), all.size());
+  const size_t off = all.size() - kept.size();
+  bool tail = true;
+  for (size_t i = 0; tail && i < kept.size(); i++) tail = kept[i].t == all[off + i].t && kept[i].v == all[off + i].v;
+  CHECK(tail, "ring holds exactly the newest samples, oldest first");
+  delete s;
+}
+
+// ---- 4. Downsampling ----
+static void fill(int16_t v[OTH_COUNT], int16_t x)
+{
+  for (uint8_t m = 0; m < OTH_COUNT; m++) v[m] = x;
+}
+
+static void testDownsample()
+{
+  std::unique_ptr<OTHistStore> s(new OTHistStore);
+  otHistReset(*s);
+  const uint32_t t0 = 1700000100u;                 // a quarter-hour boundary
+  CHECK(t0 % 900 == 0, "test start is aligned");
+  int16_t v[OTH_COUNT];
+  // Minute 0: 0..59 on flow; room missing for the first half; pressure always missing.
+  for (uint32_t i = 0; i < 60; i++) {
+    fill(v, 100);
+    v[OTH_FLOW] = (int16_t)i;
+    v[OTH_ROOM] = i < 30 ? OT_HIST_MISSING : 2000;
+    v[OTH_PRESSURE] = OT_HIST_MISSING;
+    v[OTH_FLAME] = (i % 4 == 0) ? 100 : 0;
+    otHistSample(*s, t0 + i, v);
+  }
+  CHECK(decodeRing(*s, OTH_TIER_1M, OTH_FLOW).empty(), "open minute is not written yet");
+  // Minutes 1..15 constant; the first sample of minute 1 closes minute 0,
+  // the first of minute 16 closes minute 15 and with it the first quarter.
+  for (uint32_t i = 60; i <= 16 * 60; i++) {
+    fill(v, 100);
+    v[OTH_FLOW] = -5;
+    v[OTH_PRESSURE] = OT_HIST_MISSING;
+    otHistSample(*s, t0 + i, v);
+  }
+  otHistSample(*s, t0 + 100, v);                   // backwards: ignored
+  CHECK(s->lastT == t0 + 16 * 60, "lastT %u", (unsigned)(s->lastT - t0));
+
+  const std::vector<Sample> flow = decodeRing(*s, OTH_TIER_1M, OTH_FLOW);
+  CHECK(flow.size() == 16, "16 closed minutes, got %zu", flow.size());
+  CHECK(flow.size() > 1 && flow[0].t == t0 && flow[0].v == 30 && flow[1].v == -5,
+        "minute means %d %d", flow.empty() ? 0 : flow[0].v, flow.size() > 1 ? flow[1].v : 0);
+  // (0+..+59)/60 = 29.5 -> 30; the flame ran 15 of 60 seconds -> 0.25.
+  const std::vector<Sample> room = decodeRing(*s, OTH_TIER_1M, OTH_ROOM);
+  CHECK(!room.empty() && room[0].v == 2000, "missing seconds left out of the mean");
+  const std::vector<Sample> pres = decodeRing(*s, OTH_TIER_1M, OTH_PRESSURE);
+  CHECK(!pres.empty() && pres[0].v == OT_HIST_MISSING, "all-missing minute is missing");
+  const std::vector<Sample> flame = decodeRing(*s, OTH_TIER_1M, OTH_FLAME);
+  CHECK(!flame.empty() && flame[0].v == 25 && flame[1].v == 100, "flame duty %d", flame.empty() ? -1 : flame[0].v);
+
+  // 15m: (30 + 14 * -5) / 15 = -2.67 -> -3.
+  const std::vector<Sample> q = decodeRing(*s, OTH_TIER_15M, OTH_FLOW);
+  CHECK(q.size() == 1 && q[0].t == t0 && q[0].v == -3, "quarter mean %d", q.empty() ? 0 : q[0].v);
+  CHECK(otHistMean({-5, 2}) == -3 && otHistMean({5, 2}) == 3 && otHistMean({0, 0}) == OT_HIST_MISSING,
+        "mean rounds half away from zero");
+
+  // A long gap closes the pending minute at its own time, not the gap's.
+  otHistSample(*s, t0 + 5000, v);
+  otHistSample(*s, t0 + 5100, v);
+  const std::vector<Sample> after = decodeRing(*s, OTH_TIER_1M, OTH_FLOW);
+  CHECK(after.size() == 18 && after[16].t == t0 + 16 * 60 && after[17].t == t0 + 5000 - 5000 % 60,
+        "gap minutes %zu", after.size());
+}
+
+// ---- 5. Reads ----
+static void testReads()
+{
+  std::unique_ptr<OTHistStore> s(new OTHistStore);
+  otHistReset(*s);
+  CHECK(otHistTierStart(*s, OTH_TIER_1S) == 0, "empty tier has no start");
+  CHECK(otHistPickTier(*s, 0) == OTH_TIER_1S, "empty store picks 1s");
+
+  const uint32_t t0 = 1700000100u;
+  int16_t v[OTH_COUNT];
+  std::mt19937 rng(5);
+  int16_t x = 4000;
+  for (uint32_t i = 0; i < 3 * 86400; i++) {
+    x = (int16_t)std::max(1000, std::min(8000, x + (int)(rng() % 41) - 20));
+    fill(v, x);
+    otHistSample(*s, t0 + i, v);
+  }
+  const uint32_t now = t0 + 3 * 86400 - 1;
+  const uint32_t s1 = otHistTierStart(*s, OTH_TIER_1S);
+  const uint32_t s2 = otHistTierStart(*s, OTH_TIER_1M);
+  const uint32_t s3 = otHistTierStart(*s, OTH_TIER_15M);
+  CHECK(s1 > s2 && s2 > s3 && s3 >= t0, "tier starts %u %u %u", (unsigned)(now - s1), (unsigned)(now - s2), (unsigned)(now - s3));
+  CHECK(otHistPickTier(*s, now - 60) == OTH_TIER_1S, "last minute from 1s");
+  CHECK(otHistPickTier(*s, s2) == OTH_TIER_1M, "from 1m start picks 1m");
+  CHECK(otHistPickTier(*s, s2 - 1) == OTH_TIER_15M, "past the 1m start picks 15m");
+  CHECK(otHistPickTier(*s, t0 - 86400) == OTH_TIER_15M, "before any data picks the longest");
+
+  uint8_t per[OTH_COUNT];
+  const uint16_t all = otHistCopyBlocks(*s, OTH_TIER_1M, 0xFF, 0, UINT32_MAX, nullptr, UINT16_MAX, per);
+  CHECK(all == OTH_COUNT * OT_HIST_BLOCKS_1M, "a full ring copies every block (%u)", all);
+  const uint16_t two = otHistCopyBlocks(*s, OTH_TIER_1M, (1u << OTH_ROOM) | (1u << OTH_FLAME), now - 3600, now, nullptr, UINT16_MAX, per);
+  CHECK(per[OTH_FLOW] == 0 && per[OTH_ROOM] > 0 && per[OTH_ROOM] == per[OTH_FLAME] && two == 2 * per[OTH_ROOM],
+        "mask and range filter (%u)", two);
+  std::vector<OTHistBlock> dst(two);
+  CHECK(otHistCopyBlocks(*s, OTH_TIER_1M, (1u << OTH_ROOM) | (1u << OTH_FLAME), now - 3600, now, dst.data(), two, per) == two,
+        "copy count");
+  uint32_t lastEnd = 0;
+  bool ordered = true, overlaps = true;
+  for (uint8_t i = 0; i < per[OTH_ROOM]; i++) {
+    ordered = ordered && dst[i].t0 > lastEnd;
+    overlaps = overlaps && otHistBlockEnd(dst[i], 60) >= now - 3600;
+    lastEnd = otHistBlockEnd(dst[i], 60);
+  }
+  CHECK(ordered && overlaps, "copied blocks oldest first and in range");
+  CHECK(otHistCopyBlocks(*s, OTH_TIER_1M, 0xFF, 0, UINT32_MAX, dst.data(), 3, per) == 3, "copy stops at cap");
+}
+
+// ---- 6. Size ----
+static void testSize()
+{
+  std::unique_ptr<OTHistStore> s(new OTHistStore);
+  otHistReset(*s);
+  const uint32_t t0 = 1700000100u;
+  int16_t v[OTH_COUNT];
+  // A boiler day: 20 burner cycles, flow rising to 60 °C and cooling to 35 °C,
+  // return 8-12 K below, room drifting around 20.5 °C, setpoints stepping twice
+  // a day, modulation following the flame, 1.6 bar. Sensor values are OT f8.8
+  // (1/256 °C), so the 0.01 steps are rarely repeated exactly second to second.
+  for (uint32_t i = 0; i < 86400 + 60; i++) {
+    const double day = i / 86400.0;
+    const double cyc = std::fmod(i, 4320.0);
+    const bool burn = cyc < 1200;
+    const double flow = burn ? 35 + 25 * (cyc / 1200.0) : 35 + 25 * std::exp(-(cyc - 1200) / 600.0);
+    const double q = 1.0 / 256;
+    v[OTH_FLOW] = (int16_t)std::lround(std::round(flow / q) * q * 100);
+    v[OTH_RETURN] = (int16_t)std::lround(std::round((flow - (burn ? 12 : 8)) / q) * q * 100);
+    v[OTH_ROOM] = (int16_t)std::lround(std::round((20.5 + 0.4 * std::sin(day * 6.283)) / q) * q * 100);
+    v[OTH_ROOM_SETPOINT] = (day > 0.3 && day < 0.9) ? 2100 : 1700;
+    v[OTH_CTRL_SETPOINT] = burn ? 6000 : 1000;
+    v[OTH_MODULATION] = burn ? (int16_t)(3000 + (cyc / 1200.0) * 4000) / 100 * 100 : 0;
+    v[OTH_PRESSURE] = 160;
+    v[OTH_FLAME] = burn ? 100 : 0;
+    otHistSample(*s, t0 + i, v);
+  }
+  const uint32_t now = t0 + 86400 + 59;
+  uint32_t worst = 0;
+  for (uint8_t m = 0; m < OTH_COUNT; m++) {
+    const std::vector<Sample> got = decodeRing(*s, OTH_TIER_1M, m);
+    const uint32_t span = got.empty() ? 0 : now - got.front().t;
+    if (m == 0 || span < worst) worst = span;
+    CHECK(span >= 86400 - 60, "%s: 1m tier holds %.1f h", kOTHistNames[m], span / 3600.0);
+  }
+  uint32_t used1s = 0;
+  uint32_t n1s = 0;
+  for (uint8_t m = 0; m < OTH_COUNT; m++) {
+    otHistForEachBlock(*s, OTH_TIER_1S, m, [&](const OTHistBlock &b) { used1s += 12 + b.used; n1s += b.n; });
+  }
+  std::printf("store %zu B; 1 s tier: %u samples in %u B (%.2f B/sample, raw 2); 1m tier reaches back %.1f h\n",
+              sizeof(OTHistStore), (unsigned)n1s, (unsigned)used1s, (double)used1s / n1s, worst / 3600.0);
+  CHECK((double)used1s / n1s < 1.0, "1 s tier under a byte per sample");
+  CHECK(sizeof(OTHistStore) < 29 * 1024, "store %zu B", sizeof(OTHistStore));
+}
+
+int main()
+{
+  testRoundTrip();
+  testRuns();
+  testRings();
+  testDownsample();
+  testReads();
+  testSize();
+  std::printf("%d checks, %d failures\n", checks, failures);
+  std::printf(failures ? "FAILED\n" : "ALL PASSED\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+/**
+ * Host torture test for the decoded-state snapshot (OTStateSnapshot.h).
+ *
+ * processOT() publishes OTcurrentSystemState into an OTStateSnapshot after
+ * every frame; the async_tcp REST handlers and the webhook test endpoint
+ * copy it out with read() instead of taking OTStateLock. This file checks:
+ *
+ *   1. Single-thread: initial value, read-after-publish, version counting.
+ *   2. Torture: one writer std::thread publishes a struct shaped like
+ *      OTdataStruct (floats and uint16 flags of mixed alignment, ~300 bytes)
+ *      as fast as it can while several reader threads copy it in a loop.
+ *      Every field of publish k is derived from k, so any mix of two
+ *      publishes is detected. Every read must be internally consistent and
+ *      a reader's versions must never go backwards; the writer never waits.
+ *   3. Control: the same readers on a plain single buffer (relaxed word
+ *      copies, no sequence check — what an unlocked reader of the live
+ *      struct does) report how many copies came out torn.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra -pthread tests/test_ot_state_snapshot.cpp -o tests/test_ot_state_snapshot.out
+ *   ./tests/test_ot_state_snapshot.out [milliseconds]
+ *   echo $?   # 0 on pass, 1 on failure
+ *
+ * Under ThreadSanitizer (no reports expected; gcc warns that TSan does not
+ * model atomic_thread_fence, the buffer words themselves are atomics):
+ *   g++ -std=c++17 -O1 -g -fsanitize=thread -pthread tests/test_ot_state_snapshot.cpp -o tests/test_ot_state_snapshot.tsan
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../src/OTGW-firmware/OTStateSnapshot.h"
+
+// Shaped like OTdataStruct: status words, f8.8 floats and u16 pairs, with
+// the odd uint8_t that shifts the alignment of what follows.
+struct FakeOTState {
+  uint16_t Statusflags = 0;
+  uint8_t  MasterStatus = 0;
+  uint8_t  SlaveStatus = 0;
+  float    temps[40] = {};
+  uint16_t words[60] = {};
+  uint8_t  tailByte = 0;
+  float    TSet = 0.0f;
+};
+
+static void fill(FakeOTState &s, uint32_t k)
+{
+  s.Statusflags = (uint16_t)k;
+  s.MasterStatus = (uint8_t)(k >> 8);
+  s.SlaveStatus = (uint8_t)(k >> 16);
+  for (int i = 0; i < 40; i++) s.temps[i] = (float)(k % 100000u) + (float)i * 0.25f;
+  for (int i = 0; i < 60; i++) s.words[i] = (uint16_t)(k * 3u + (uint32_t)i);
+  s.tailByte = (uint8_t)(k * 7u);
+  s.TSet = (float)(k % 100000u);
+}
+
+// Publish number encoded in a copy, or -1 when its fields disagree.
+static int64_t decode(const FakeOTState &s)
+{
+  const uint32_t k = (uint32_t)s.Statusflags | ((uint32_t)s.MasterStatus << 8) | ((uint32_t)s.SlaveStatus << 16);
+  FakeOTState ref;
+  fill(ref, k);
+  // Field by field: padding bytes carry no state.
+  bool same = ref.tailByte == s.tailByte && ref.TSet == s.TSet;
+  for (int i = 0; i < 40 && same; i++) same = ref.temps[i] == s.temps[i];
+  for (int i = 0; i < 60 && same; i++) same = ref.words[i] == s.words[i];
+  return same ? (int64_t)k : -1;
+}
+
+static int failures = 0;
+
+static void check(const char *name, bool ok)
+{
+  std::printf("%-56s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+// ---------------------------------------------------------------------------
+// 1. Single-thread
+// ---------------------------------------------------------------------------
+
+static void testBasics()
+{
+  std::printf("--- single thread ---\n");
+  auto *snap = new OTStateSnapshot<FakeOTState>();
+  FakeOTState s;
+  fill(s, 99);
+  check("initial read is the default-constructed state",
+        snap->read(s) == 0 && snap->version() == 0 && s.Statusflags == 0 &&
+        s.temps[0] == 0.0f && s.words[59] == 0 && s.TSet == 0.0f);
+
+  bool ok = true;
+  for (uint32_t k = 1; k <= 1000 && ok; k++) {
+    FakeOTState w;
+    fill(w, k);
+    snap->publish(w);
+    FakeOTState r;
+    ok = snap->read(r) == 0 && decode(r) == (int64_t)k && snap->version() == k;
+  }
+  check("read returns the latest publish, version counts publishes", ok);
+  check("no retries without a concurrent writer", snap->retries() == 0);
+  delete snap;
+}
+
+// ---------------------------------------------------------------------------
+// 2./3. Torture
+// ---------------------------------------------------------------------------
+
+// What an unlocked reader of the live struct sees: one buffer, no sequence.
+struct PlainBuffer {
+  static constexpr uint32_t kWords = (sizeof(FakeOTState) + 3) / 4;
+  std::atomic<uint32_t> w[kWords];
+  void publish(const FakeOTState &s)
+  {
+    uint32_t tmp[kWords] = {};
+    memcpy(tmp, &s, sizeof(s));
+    for (uint32_t i = 0; i < kWords; i++) w[i].store(tmp[i], std::memory_order_relaxed);
+  }
+  void read(FakeOTState &s) const
+  {
+    uint32_t tmp[kWords];
+    for (uint32_t i = 0; i < kWords; i++) tmp[i] = w[i].load(std::memory_order_relaxed);
+    memcpy(&s, tmp, sizeof(s));
+  }
+};
+
+struct ReaderStats {
+  uint64_t reads = 0;
+  uint64_t torn = 0;
+  uint64_t backwards = 0;
+};
+
+template <typename Store>
+static uint64_t torture(Store &store, int readers, int ms, std::vector<ReaderStats> &stats)
+{
+  std::atomic<bool> stop{false};
+  std::atomic<uint64_t> published{0};
+  stats.assign(readers, ReaderStats());
+
+  std::thread writer([&]() {
+    FakeOTState s;
+    uint32_t k = 0;
+    while (!stop.load(std::memory_order_relaxed)) {
+      fill(s, ++k & 0xFFFFFFu);           // k fits the 24 bits decode() reads back
+      store.publish(s);
+    }
+    published = k;
+  });
+
+  std::vector<std::thread> rs;
+  for (int r = 0; r < readers; r++) {
+    rs.emplace_back([&, r]() {
+      ReaderStats &st = stats[r];
+      FakeOTState s;
+      int64_t last = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        store.read(s);
+        st.reads++;
+        const int64_t k = decode(s);
+        if (k < 0) { st.torn++; continue; }
+        if (k < last && last - k < 0x800000) st.backwards++;   // ignore the 24-bit wrap
+        last = k;
+      }
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  stop = true;
+  writer.join();
+  for (auto &t : rs) t.join();
+  return published;
+}
+
+static void testTorture(int ms)
+{
+  const int readers = 3;
+  std::vector<ReaderStats> st;
+
+  std::printf("--- torture: 1 writer, %d readers, %d ms ---\n", readers, ms);
+  auto *snap = new OTStateSnapshot<FakeOTState>();
+  const uint64_t pubs = torture(*snap, readers, ms, st);
+  uint64_t reads = 0, torn = 0, backwards = 0;
+  for (const auto &s : st) { reads += s.reads; torn += s.torn; backwards += s.backwards; }
+  std::printf("  snapshot: %llu publishes, %llu reads, %u retries, %llu torn, %llu backwards\n",
+              (unsigned long long)pubs, (unsigned long long)reads, (unsigned)snap->retries(),
+              (unsigned long long)torn, (unsigned long long)backwards);
+  check("writer and readers all made progress", pubs > 1000 && reads > 1000);
+  check("no torn snapshot", torn == 0);
+  check("versions never go backwards per reader", backwards == 0);
+  delete snap;
+
+  auto *plain = new PlainBuffer();
+  FakeOTState z;
+  fill(z, 0);
+  plain->publish(z);
+  const uint64_t pubs2 = torture(*plain, readers, ms, st);
+  reads = torn = 0;
+  for (const auto &s : st) { reads += s.reads; torn += s.torn; }
+  std::printf("  unprotected buffer (control): %llu publishes, %llu reads, %llu torn (%.2f%%)\n",
+              (unsigned long long)pubs2, (unsigned long long)reads, (unsigned long long)torn,
+              reads ? 100.0 * (double)torn / (double)reads : 0.0);
+  delete plain;
+}
+
+int main(int argc, char **argv)
+{
+  const int ms = (argc > 1) ? std::atoi(argv[1]) : 2000;
+  std::printf("=== OTStateSnapshot torture test ===\n");
+  testBasics();
+  testTorture(ms);
+  std::printf("\n%s (%d failure%s)\n", failures ? "FAILED" : "ALL PASSED", failures, failures == 1 ? "" : "s");
+  return failures ? 1 : 0;
+}
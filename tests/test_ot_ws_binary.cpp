@@ -0,0 +1,239 @@
+/**
+ * Host test for the binary OT frame stream on /ws (OTWsBinary.h).
+ *
+ * A WebSocket client that sends {"stream":"binary","v":1} gets each decoded
+ * OT frame as an 8-byte record, batched into one message per second, instead
+ * of the ~90-byte text line. webSocketStuff.ino fills the batch with
+ * otWsBinAppend() and data/v2.js decodes it with a DataView. This file checks
+ * the wire format both sides depend on:
+ *
+ *   1. Byte layout of the header and records, little-endian, against a
+ *      hand-built message.
+ *   2. Round trip of random frame sequences through append/flush/decode,
+ *      with the time of day of every record rebuilt from the deltas.
+ *   3. Batch limits: full at OT_WS_BIN_MAX_RECORDS, a new message when a
+ *      delta does not fit 16 bits, otWsBinDue() after OT_WS_BIN_FLUSH_MS,
+ *      millis() wrap, midnight wrap of the time of day.
+ *   4. Decoder rejects bad magic, version and lengths.
+ *   5. Size: bytes per frame of the binary stream against the text lines the
+ *      firmware sends for the same frames.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/test_ot_ws_binary.cpp -o tests/test_ot_ws_binary.out
+ *   ./tests/test_ot_ws_binary.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../src/OTGW-firmware/OTWsBinary.h"
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...)                                  \
+  do {                                                    \
+    checks++;                                             \
+    if (!(cond)) {                                        \
+      failures++;                                         \
+      if (failures <= 20) {                               \
+        std::printf("FAIL %s:%d: ", __FILE__, __LINE__);  \
+        std::printf(__VA_ARGS__);                         \
+        std::printf("\n");                                \
+      }                                                   \
+    }                                                     \
+  } while (0)
+
+// One sent WebSocket message.
+typedef std::vector<uint8_t> Msg;
+
+// The firmware's send path: flush when the record does not fit, append, flush when due.
+struct Sender {
+  OTWsBinBatch batch;
+  std::vector<Msg> sent;
+  void flush() {
+    const size_t len = otWsBinLength(batch);
+    if (len) sent.push_back(Msg(batch.buf, batch.buf + len));
+    otWsBinReset(batch);
+  }
+  void frame(uint32_t nowMs, uint32_t msOfDay, char src, uint8_t flags, uint32_t frame) {
+    if (otWsBinNeedsFlush(batch, nowMs)) flush();
+    const bool ok = otWsBinAppend(batch, nowMs, msOfDay, src, flags, frame);
+    CHECK(ok, "append after flush");
+    if (otWsBinDue(batch, nowMs)) flush();
+  }
+  void tick(uint32_t nowMs) { if (otWsBinDue(batch, nowMs)) flush(); }   // handleWebSocket()
+};
+
+// ---- 1. Layout ----
+static void testLayout()
+{
+  OTWsBinBatch b;
+  CHECK(otWsBinLength(b) == 0, "empty batch has no message");
+  otWsBinAppend(b, 5000, 0x01020304, 'T', OT_WS_BIN_F_VALID, 0x80190000);
+  otWsBinAppend(b, 5300, 0x01020304 + 300, 'B', OT_WS_BIN_F_VALID | OT_WS_BIN_F_DECODED, 0x40192B00);
+  const uint8_t want[] = {
+    0xB7, 0x01, 0x02, 0x00, 0x04, 0x03, 0x02, 0x01,      // magic, version, count 2, ms of day
+    0x00, 0x00, 'T', 0x01, 0x00, 0x00, 0x19, 0x80,       // dt 0, T, valid, 80190000
+    0x2C, 0x01, 'B', 0x03, 0x00, 0x2B, 0x19, 0x40,       // dt 300, B, valid|decoded, 40192B00
+  };
+  CHECK(otWsBinLength(b) == sizeof(want), "length %zu", otWsBinLength(b));
+  CHECK(std::memcmp(b.buf, want, sizeof(want)) == 0, "bytes differ from the documented layout");
+  CHECK(OT_WS_BIN_MAX_LEN == 8 + 32 * 8, "max message %d bytes", OT_WS_BIN_MAX_LEN);
+}
+
+// ---- 2. Round trip ----
+struct Frame { uint32_t ms; char src; uint8_t flags; uint32_t frame; };
+
+static void testRoundTrip()
+{
+  std::mt19937 rng(21);
+  const char srcs[] = { 'T', 'B', 'R', 'A', 'E' };
+  int lost = 0, wrong = 0, badMsg = 0;
+  for (int run = 0; run < 200; run++) {
+    Sender s;
+    std::vector<Frame> in, out;
+    uint32_t now = rng();                       // any millis(), wraps included
+    uint32_t tod = rng() % 86400000UL;
+    const int n = 1 + (int)(rng() % 400);
+    for (int i = 0; i < n; i++) {
+      // mostly bus rate (~100 ms), sometimes a quiet bus of minutes
+      const uint32_t dt = (rng() % 50 == 0) ? rng() % 200000 : rng() % 1200;
+      now += dt;
+      tod = (tod + dt) % 86400000UL;
+      Frame f = { tod, srcs[rng() % 5], (uint8_t)(rng() & 0x1F), (uint32_t)rng() };
+      in.push_back(f);
+      s.frame(now, tod, f.src, f.flags, f.frame);
+      if (rng() % 4 == 0) s.tick(now + rng() % 1500);
+    }
+    s.flush();
+    for (const Msg &m : s.sent) {
+      const int c = otWsBinDecode(m.data(), m.size(), [&](const OTWsBinRecord &r) {
+        out.push_back(Frame{ r.msOfDay, r.source, r.flags, r.frame });
+      });
+      if (c <= 0) badMsg++;
+    }
+    if (out.size() != in.size()) { lost++; continue; }
+    for (size_t i = 0; i < in.size(); i++) {
+      if (in[i].ms != out[i].ms || in[i].src != out[i].src || in[i].flags != out[i].flags ||
+          in[i].frame != out[i].frame) wrong++;
+    }
+  }
+  CHECK(lost == 0, "%d runs lost or duplicated frames", lost);
+  CHECK(wrong == 0, "%d frames decoded differently", wrong);
+  CHECK(badMsg == 0, "%d sent messages did not decode", badMsg);
+}
+
+// ---- 3. Batch limits ----
+static void testLimits()
+{
+  // Full batch: the 33rd frame starts a new message.
+  Sender s;
+  for (int i = 0; i < OT_WS_BIN_MAX_RECORDS + 1; i++) s.frame(1000 + i, 1000 + i, 'T', 0, i);
+  CHECK(s.sent.size() == 1 && otWsBinGet16(s.sent[0].data() + 2) == OT_WS_BIN_MAX_RECORDS,
+        "full batch sent at %d records", OT_WS_BIN_MAX_RECORDS);
+  CHECK(s.batch.count == 1, "33rd frame opens the next batch");
+
+  // Append refuses what does not fit instead of dropping or saturating.
+  OTWsBinBatch full = s.batch;
+  for (int i = 1; i < OT_WS_BIN_MAX_RECORDS; i++) otWsBinAppend(full, 2000, 2000, 'T', 0, 0);
+  CHECK(!otWsBinAppend(full, 2000, 2000, 'T', 0, 0) && full.count == OT_WS_BIN_MAX_RECORDS,
+        "append to a full batch fails");
+  OTWsBinBatch gap;
+  otWsBinAppend(gap, 0, 0, 'T', 0, 0);
+  CHECK(!otWsBinAppend(gap, 70000, 70000, 'B', 0, 0) && gap.count == 1, "70 s delta refused");
+  CHECK(otWsBinAppend(gap, 65535, 65535, 'B', 0, 0), "65535 ms delta fits");
+
+  // Due after the flush interval, measured from the first record.
+  OTWsBinBatch d;
+  CHECK(!otWsBinDue(d, 99999), "empty batch never due");
+  otWsBinAppend(d, 0xFFFFFF00u, 0, 'T', 0, 0);            // millis() about to wrap
+  CHECK(!otWsBinDue(d, 0xFFFFFF00u + OT_WS_BIN_FLUSH_MS - 1), "not due before the interval");
+  CHECK(otWsBinDue(d, 0xFFFFFF00u + OT_WS_BIN_FLUSH_MS), "due at the interval across the wrap");
+  CHECK(!otWsBinNeedsFlush(d, 0xFFFFFF00u + 500), "no flush needed across the wrap");
+
+  // Midnight: the time of day wraps in the decoder.
+  OTWsBinBatch m;
+  otWsBinAppend(m, 0, 86399900UL, 'T', 0, 1);
+  otWsBinAppend(m, 250, 150, 'B', 0, 2);
+  std::vector<uint32_t> t;
+  otWsBinDecode(m.buf, otWsBinLength(m), [&](const OTWsBinRecord &r) { t.push_back(r.msOfDay); });
+  CHECK(t.size() == 2 && t[0] == 86399900UL && t[1] == 150, "midnight wrap");
+}
+
+// ---- 4. Bad messages ----
+static void testReject()
+{
+  OTWsBinBatch b;
+  otWsBinAppend(b, 0, 0, 'T', 0, 0x80000000);
+  otWsBinAppend(b, 10, 10, 'B', 0, 0xC0000000);
+  Msg m(b.buf, b.buf + otWsBinLength(b));
+  int calls = 0;
+  auto count = [&](const OTWsBinRecord &) { calls++; };
+  CHECK(otWsBinDecode(m.data(), m.size(), count) == 2 && calls == 2, "good message decodes");
+  Msg bad = m; bad[0] = 0x7B;                            // '{': a text frame
+  CHECK(otWsBinDecode(bad.data(), bad.size(), count) == -1, "bad magic");
+  bad = m; bad[1] = 2;
+  CHECK(otWsBinDecode(bad.data(), bad.size(), count) == -1, "unknown version");
+  CHECK(otWsBinDecode(m.data(), m.size() - 1, count) == -1, "truncated");
+  CHECK(otWsBinDecode(m.data(), 4, count) == -1, "short header");
+  bad = m; bad.push_back(0);
+  CHECK(otWsBinDecode(bad.data(), bad.size(), count) == -1, "trailing byte");
+  CHECK(calls == 2, "no callback on a rejected message");
+}
+
+// ---- 5. Size against the text stream ----
+static void testSize()
+{
+  // Text lines as processOT() sends them (timestamp, source, frame, id, type, decoded, CRLF).
+  static const char *const lines[] = {
+    "14:23:45.123456 Thermostat         T80000200   0 Read-Data       > Status = Master [-C------]\r\n",
+    "14:23:45.223456 Boiler             B40000200   0 Read-Ack        > Status = Slave  [-C------]\r\n",
+    "14:23:46.123456 Thermostat         T90014000   1 Write-Data      > TSet = 64.00 °C\r\n",
+    "14:23:46.223456 Boiler             BD0014000   1 Write-Ack       > TSet = 64.00 °C\r\n",
+    "14:23:47.123456 Thermostat         T00190000  25 Read-Data         Tboiler\r\n",
+    "14:23:47.223456 Boiler             B40193B80  25 Read-Ack        > Tboiler = 59.50 °C\r\n",
+    "14:23:48.123456 Thermostat         T80110000  17 Read-Data         RelModLevel\r\n",
+    "14:23:48.223456 Boiler             B40110F00  17 Read-Ack        > RelModLevel = 15.00 %\r\n",
+    "14:23:49.123456 Thermostat         T001C0000  28 Read-Data         Tret\r\n",
+    "14:23:49.223456 Boiler             B401C3100  28 Read-Ack        > Tret = 49.00 °C\r\n",
+  };
+  const size_t nLines = sizeof(lines) / sizeof(lines[0]);
+  size_t textBytes = 0;
+  for (size_t i = 0; i < nLines; i++) textBytes += std::strlen(lines[i]);
+
+  // One minute at a typical bus rate: one frame every 100 ms, 600 frames.
+  Sender s;
+  uint32_t now = 0;
+  for (int i = 0; i < 600; i++) {
+    now += 100;
+    s.frame(now, now, (i & 1) ? 'B' : 'T', OT_WS_BIN_F_VALID, 0x40190000u + i);
+  }
+  s.flush();
+  size_t binBytes = 0;
+  for (const Msg &m : s.sent) binBytes += m.size();
+
+  const double textPerFrame = (double)textBytes / nLines;
+  const double binPerFrame = (double)binBytes / 600;
+  std::printf("  text %.1f B/frame, binary %.1f B/frame (%zu messages/min), %.1fx smaller\n",
+              textPerFrame, binPerFrame, s.sent.size(), textPerFrame / binPerFrame);
+  CHECK(binPerFrame < 9.0, "binary %.1f B/frame", binPerFrame);
+  CHECK(textPerFrame / binPerFrame > 8.0, "only %.1fx smaller", textPerFrame / binPerFrame);
+  CHECK(s.sent.size() <= 61, "%zu messages for one minute", s.sent.size());
+}
+
+int main()
+{
+  testLayout();
+  testRoundTrip();
+  testLimits();
+  testReject();
+  testSize();
+  std::printf("%d checks, %d failures\n", checks, failures);
+  std::printf(failures ? "FAILED\n" : "ALL PASSED\n");
+  return failures ? 1 : 0;
+}
@@ -25,6 +25,8 @@
 #include <cstdio>
 #include <cstdlib>
 
+#include "../src/OTGW-firmware/OTF88.h"
+
 // ---------------------------------------------------------------------------
 // Lifted constants — kept in sync with src/OTGW-firmware/OTDirect.ino
 // ---------------------------------------------------------------------------
@@ -59,7 +61,7 @@ static uint16_t castCelsiusToF88(float celsius)
   // TASK-495 clamp: prevent float-to-narrow UB outside [-128, 127].
   if (celsius < -40.0f) celsius = -40.0f;
   if (celsius > 127.0f) celsius = 127.0f;
-  return (uint16_t)((int16_t)(celsius * 256.0f));
+  return (uint16_t)otF88FromFloat(celsius);   // floatToF88(): nearest f8.8
 }
 
 // Mirror of onThermostatMsgID16()'s delta math (TASK-491 sign-extend).
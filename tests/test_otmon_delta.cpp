@@ -0,0 +1,283 @@
+/**
+ * Host test for the otmonitor change generations (OTmonDelta.h).
+ *
+ * processOT() stamps each REST-tracked message slot with a generation when
+ * its value changes; sendOTmonitorV2() in restAPI.ino turns the generations
+ * into an ETag token and answers GET /api/v2/otgw/otmonitor?since=<token>
+ * with a delta, a 304 or the full document. This file checks:
+ *
+ *   1. Token format/parse round trip, with and without the ETag quotes and a
+ *      W/ prefix, and rejection of malformed tokens (signs, blanks, "0x",
+ *      missing parts, trailing bytes, values over 32 bits).
+ *   2. otmonGenNote(): a repeated value takes no generation, a changed or
+ *      first value does; a reset makes every slot new again.
+ *   3. otmonAuxUpdate(): first call and layout changes move the reset mark,
+ *      value changes only the generation, unchanged hashes nothing.
+ *   4. otmonDecide(): no token, other boot, tokens from the future or from
+ *      before a reset give the full document; the current token a 304;
+ *      anything else a delta.
+ *   5. A simulated poller against a simulated processOT (mostly repeated
+ *      values, some changes, occasional clears and reboots): after every
+ *      poll its merged view equals the full document, and on a steady
+ *      system it receives a small fraction of the entries.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/test_otmon_delta.cpp -o tests/test_otmon_delta.out
+ *   ./tests/test_otmon_delta.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+
+#include "../src/OTGW-firmware/OTmonDelta.h"
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...)                                  \
+  do {                                                    \
+    checks++;                                             \
+    if (!(cond)) {                                        \
+      failures++;                                         \
+      if (failures <= 20) {                               \
+        std::printf("FAIL %s:%d: ", __FILE__, __LINE__);  \
+        std::printf(__VA_ARGS__);                         \
+        std::printf("\n");                                \
+      }                                                   \
+    }                                                     \
+  } while (0)
+
+static bool sameToken(const OTmonToken &a, const OTmonToken &b)
+{
+  return a.boot == b.boot && a.gen == b.gen && a.aux == b.aux;
+}
+
+static void testToken()
+{
+  const OTmonToken cases[] = {
+    {0, 0, 0}, {1, 2, 3}, {0xdeadbeef, 123456, 7}, {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
+  };
+  for (const OTmonToken &t : cases) {
+    char buf[OTMON_TOKEN_LEN];
+    otmonTokenFormat(t, buf, sizeof(buf));
+    CHECK(strlen(buf) + 1 < sizeof(buf), "token %s truncated", buf);
+    OTmonToken p = {9, 9, 9};
+    CHECK(otmonTokenParse(buf, p) && sameToken(p, t), "round trip of %s", buf);
+
+    char quoted[OTMON_TOKEN_LEN + 4];
+    snprintf(quoted, sizeof(quoted), "\"%s\"", buf);
+    p = {9, 9, 9};
+    CHECK(otmonTokenParse(quoted, p) && sameToken(p, t), "quoted %s", quoted);
+    snprintf(quoted, sizeof(quoted), "W/\"%s\"", buf);
+    p = {9, 9, 9};
+    CHECK(otmonTokenParse(quoted, p) && sameToken(p, t), "weak %s", quoted);
+  }
+
+  OTmonToken p;
+  CHECK(otmonTokenParse("0000002a-10-3", p) && p.boot == 42 && p.gen == 10 && p.aux == 3, "hex boot");
+  CHECK(otmonTokenParse("ABCDEF01-1-1", p) && p.boot == 0xABCDEF01, "upper-case hex");
+
+  const char *bad[] = {
+    nullptr, "", "-", "1-2", "1-2-", "1--3", "-1-2-3", "+1-2-3", " 1-2-3", "1- 2-3", "1-+2-3",
+    "1-2--3", "1-2-3x", "1-2-3 ", "\"1-2-3", "1-2-3\"", "\"1-2-3\"x", "0x1-2-3", "g-2-3",
+    "1-2a-3", "100000000-1-1", "1-4294967296-1", "1-1-4294967296", "1-2-3-4", "W/1-2-3x",
+  };
+  for (const char *b : bad) {
+    OTmonToken q = {7, 7, 7};
+    CHECK(!otmonTokenParse(b, q), "accepted bad token \"%s\"", b ? b : "(null)");
+    CHECK(q.boot == 7 && q.gen == 7 && q.aux == 7, "bad token \"%s\" changed the output", b ? b : "(null)");
+  }
+}
+
+static void testGenNote()
+{
+  uint32_t gen = 0, genReset = 0, slotGen[2] = {0, 0};
+  uint16_t last[2] = {0, 0};
+  bool seen[2] = {false, false};
+
+  otmonGenNote(gen, slotGen[0], last[0], seen[0], 0);
+  CHECK(gen == 1 && slotGen[0] == 1 && seen[0], "first value (0) takes a generation");
+  otmonGenNote(gen, slotGen[0], last[0], seen[0], 0);
+  CHECK(gen == 1 && slotGen[0] == 1, "repeat takes none");
+  otmonGenNote(gen, slotGen[1], last[1], seen[1], 0x1234);
+  CHECK(gen == 2 && slotGen[1] == 2 && slotGen[0] == 1, "other slot");
+  otmonGenNote(gen, slotGen[0], last[0], seen[0], 1);
+  CHECK(gen == 3 && slotGen[0] == 3 && slotGen[1] == 2, "change");
+  for (int i = 0; i < 100; i++) otmonGenNote(gen, slotGen[1], last[1], seen[1], 0x1234);
+  CHECK(gen == 3 && slotGen[1] == 2, "a hundred repeats take none");
+
+  otmonGenReset(gen, genReset);
+  CHECK(gen == 4 && genReset == 4, "reset takes a generation");
+  seen[0] = seen[1] = false;                // clearMsgLastUpdated() does this
+  otmonGenNote(gen, slotGen[0], last[0], seen[0], 1);
+  CHECK(gen == 5 && slotGen[0] == 5, "same value after a reset is new again");
+}
+
+static void testAux()
+{
+  OTmonAux a;
+  otmonAuxUpdate(a, 10, 20);
+  CHECK(a.gen == 1 && a.reset == 1, "first call: gen %u reset %u", a.gen, a.reset);
+  otmonAuxUpdate(a, 10, 20);
+  CHECK(a.gen == 1 && a.reset == 1, "unchanged");
+  otmonAuxUpdate(a, 10, 21);
+  CHECK(a.gen == 2 && a.reset == 1, "value change: gen %u reset %u", a.gen, a.reset);
+  otmonAuxUpdate(a, 11, 21);
+  CHECK(a.gen == 3 && a.reset == 3, "layout change: gen %u reset %u", a.gen, a.reset);
+  otmonAuxUpdate(a, 11, 21);
+  CHECK(a.gen == 3 && a.reset == 3, "unchanged after layout change");
+}
+
+static void testDecide()
+{
+  const OTmonToken cur = {0xABCD, 50, 7};
+  const uint32_t genReset = 20, auxReset = 5;
+  struct Case { OTmonToken since; bool has; OTmonReply want; const char *what; } cases[] = {
+    {{0, 0, 0},         false, OTMON_REPLY_FULL,         "no token"},
+    {{0xABCE, 50, 7},   true,  OTMON_REPLY_FULL,         "other boot"},
+    {{0xABCD, 50, 7},   true,  OTMON_REPLY_NOT_MODIFIED, "current"},
+    {{0xABCD, 49, 7},   true,  OTMON_REPLY_DELTA,        "older gen"},
+    {{0xABCD, 50, 6},   true,  OTMON_REPLY_DELTA,        "older aux"},
+    {{0xABCD, 20, 5},   true,  OTMON_REPLY_DELTA,        "at both resets"},
+    {{0xABCD, 19, 7},   true,  OTMON_REPLY_FULL,         "before the OT reset"},
+    {{0xABCD, 50, 4},   true,  OTMON_REPLY_FULL,         "before the aux reset"},
+    {{0xABCD, 51, 7},   true,  OTMON_REPLY_FULL,         "gen from the future"},
+    {{0xABCD, 50, 8},   true,  OTMON_REPLY_FULL,         "aux from the future"},
+    {{0xABCD, 0, 0},    true,  OTMON_REPLY_FULL,         "zero token"},
+  };
+  for (const Case &c : cases) {
+    const OTmonReply r = otmonDecide(cur, c.has ? &c.since : nullptr, genReset, auxReset);
+    CHECK(r == c.want, "%s: got %d want %d", c.what, (int)r, (int)c.want);
+  }
+}
+
+// --- 5. simulated device and poller ----------------------------------------
+
+#define SIM_SLOTS 16
+#define SIM_AUX   4
+
+struct SimDevice {
+  uint32_t boot;
+  uint32_t gen = 0, genReset = 0;
+  uint32_t slotGen[SIM_SLOTS] = {};
+  uint16_t last[SIM_SLOTS] = {};
+  bool     seen[SIM_SLOTS] = {};
+  uint16_t auxVal[SIM_AUX] = {};
+  uint8_t  auxCount = 2;                  // Dallas sensors come and go
+  OTmonAux aux;
+
+  explicit SimDevice(uint32_t b) : boot(b) { otmonGenReset(gen, genReset); }
+
+  void frame(uint8_t slot, uint16_t raw) { otmonGenNote(gen, slotGen[slot], last[slot], seen[slot], raw); }
+  void clear()
+  {
+    for (bool &s : seen) s = false;
+    otmonGenReset(gen, genReset);
+  }
+
+  // Full document: key -> value. OT keys 0..15 for seen slots, aux 100+.
+  std::map<int, uint16_t> full() const
+  {
+    std::map<int, uint16_t> m;
+    for (int i = 0; i < SIM_SLOTS; i++) if (seen[i]) m[i] = last[i];
+    for (int i = 0; i < auxCount; i++) m[100 + i] = auxVal[i];
+    return m;
+  }
+
+  // What sendOTmonitorV2() does; returns entries sent, -1 for a 304.
+  int serve(const char *since, std::map<int, uint16_t> &client, char *etag)
+  {
+    uint32_t layout = otmonFnv1a(OTMON_FNV_INIT, &auxCount, sizeof(auxCount));
+    uint32_t value  = otmonFnv1a(OTMON_FNV_INIT, auxVal, auxCount * sizeof(auxVal[0]));
+    otmonAuxUpdate(aux, layout, value);
+    const OTmonToken cur = {boot, gen, aux.gen};
+    otmonTokenFormat(cur, etag, OTMON_TOKEN_LEN);
+    OTmonToken s = {};
+    const bool has = since && otmonTokenParse(since, s);
+    const OTmonReply r = otmonDecide(cur, has ? &s : nullptr, genReset, aux.reset);
+    if (r == OTMON_REPLY_NOT_MODIFIED) return -1;
+    int sent = 0;
+    if (r == OTMON_REPLY_FULL) {
+      client = full();
+      return (int)client.size();
+    }
+    for (int i = 0; i < SIM_SLOTS; i++) {
+      if (seen[i] && slotGen[i] > s.gen) { client[i] = last[i]; sent++; }
+    }
+    if (s.aux != cur.aux) {
+      for (int i = 0; i < auxCount; i++) { client[100 + i] = auxVal[i]; sent++; }
+    }
+    return sent;
+  }
+};
+
+static void testSimulation()
+{
+  std::mt19937 rng(0x07D0);
+  SimDevice *dev = new SimDevice(rng() | 1u);
+  std::map<int, uint16_t> client;
+  char token[OTMON_TOKEN_LEN] = "";
+  bool haveToken = false;
+  long sentDelta = 0, sentFull = 0, polls = 0, notModified = 0;
+  int mismatches = 0;
+
+  for (int second = 0; second < 200000; second++) {
+    // ~10 frames a second over the 16 slots; a value changes now and then.
+    for (int f = 0; f < 10; f++) {
+      const uint8_t slot = (uint8_t)(rng() % SIM_SLOTS);
+      uint16_t raw = dev->seen[slot] ? dev->last[slot] : (uint16_t)(rng() & 0xFFFF);
+      if (rng() % 100 < 3) raw = (uint16_t)(raw + 1 + rng() % 5);
+      dev->frame(slot, raw);
+    }
+    if (rng() % 60 == 0) dev->auxVal[rng() % SIM_AUX]++;
+    if (rng() % 5000 == 0) dev->auxCount = (uint8_t)(rng() % (SIM_AUX + 1));
+    if (rng() % 20000 == 0) dev->clear();
+    if (rng() % 50000 == 0) {
+      // Reboot: new boot tag, everything from scratch, the client keeps its token.
+      const uint32_t boot = dev->boot;
+      delete dev;
+      dev = new SimDevice(boot + 1);
+    }
+
+    // Poll every 2 s, like the paced poller.
+    if (second % 2) continue;
+    char etag[OTMON_TOKEN_LEN];
+    const int sent = dev->serve(haveToken ? token : nullptr, client, etag);
+    polls++;
+    const std::map<int, uint16_t> want = dev->full();
+    if (sent < 0) {
+      notModified++;
+      CHECK(strcmp(etag, token) == 0, "304 with a different token %s vs %s", etag, token);
+    } else {
+      sentDelta += sent;
+      sentFull += (long)want.size();
+    }
+    if (client != want) mismatches++;
+    snprintf(token, sizeof(token), "%s", etag);
+    haveToken = true;
+  }
+  delete dev;
+
+  CHECK(mismatches == 0, "client view differed from the full document after %d of %ld polls", mismatches, polls);
+  CHECK(notModified > 0, "no 304 in %ld polls", polls);
+  CHECK(sentDelta * 4 < sentFull, "delta sent %ld of %ld entries", sentDelta, sentFull);
+  std::printf("  simulation: %ld polls, %ld x 304, %ld/%ld entries sent (%.1f%%)\n",
+              polls, notModified, sentDelta, sentFull, sentFull ? 100.0 * sentDelta / sentFull : 0.0);
+}
+
+int main()
+{
+  testToken();
+  testGenNote();
+  testAux();
+  testDecide();
+  testSimulation();
+
+  std::printf("%d checks, %d failures\n", checks, failures);
+  std::printf(failures ? "FAILED\n" : "ALL PASSED\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,55 @@
+"""Regression check: otmonCollect() fits its per-response entry list.
+
+OTmonSnap::slot() refuses entries past OTMON_SNAP_MAX_ENTRIES, and the
+refused field is then missing from /api/v2/otgw/otmonitor, its ?since=
+deltas and the SSE "ot" event. Every entry comes from one straight-line
+emit()/emitAux() call in otmonCollect() (the Dallas loop fills its own
+array), so counting the calls gives the worst case.
+"""
+
+from pathlib import Path
+import re
+import unittest
+
+
+ROOT = Path(__file__).resolve().parents[1]
+REST_API = ROOT / "src" / "OTGW-firmware" / "restAPI.ino"
+
+
+def _braced_block(text, open_pos):
+    depth = 0
+    for pos in range(open_pos, len(text)):
+        if text[pos] == "{":
+            depth += 1
+        elif text[pos] == "}":
+            depth -= 1
+            if depth == 0:
+                return text[open_pos:pos + 1]
+    raise AssertionError("unbalanced braces")
+
+
+class TestOtmonSnapCapacity(unittest.TestCase):
+    def setUp(self):
+        self.source = REST_API.read_text(encoding="utf-8")
+        start = self.source.index("static void otmonCollect(OTmonSnap& snap)\n{")
+        self.body = _braced_block(self.source, self.source.index("{", start))
+
+    def test_emits_fit_the_snapshot(self):
+        cap = int(re.search(r"#define OTMON_SNAP_MAX_ENTRIES\s+(\d+)", self.source).group(1))
+        calls = re.findall(r"\bemit(?:Aux)?\(F\(", self.body)
+        self.assertGreater(len(calls), 0, "no emit calls found in otmonCollect()")
+        self.assertLessEqual(
+            len(calls), cap,
+            f"otmonCollect() emits up to {len(calls)} entries; raise OTMON_SNAP_MAX_ENTRIES ({cap})")
+
+    def test_no_emit_inside_a_loop(self):
+        # A loop makes the entry count data-dependent, and the count above meaningless.
+        loops = list(re.finditer(r"\b(?:for|while)\s*\(.*\)\s*\{", self.body))
+        self.assertGreater(len(loops), 0, "expected the Dallas/hash loops in otmonCollect()")
+        for match in loops:
+            loop = _braced_block(self.body, match.end() - 1)
+            self.assertNotRegex(loop, r"\bemit(?:Aux)?\(", "emit() inside a loop in otmonCollect()")
+
+
+if __name__ == "__main__":
+    unittest.main(verbosity=2)
@@ -0,0 +1,666 @@
+/**
+ * Host test for the PIC upgrade row image and differential programming
+ * (OTGWUpgrade in src/libraries/OTGWSerial/OTGWSerial.cpp).
+ *
+ * The real OTGWSerial.cpp is compiled in against the host stubs in
+ * tests/stubs/ (UART, LittleFS on a temporary host directory, simulated
+ * clock). On the other end of the UART sits a simulated PIC bootloader:
+ * STX/DLE/ETX framing with checksums, the version/read/write/erase/EEPROM
+ * commands, 16F88 block writes, flash writes that can only clear bits (so a
+ * missed erase shows up) and a protected self-programming area. For every
+ * hex file bundled in src/OTGW-firmware/data (pic16f88 and pic16f1847) this
+ * checks:
+ *
+ *   1. The rows read from the compiled image are the rows prepareCode()
+ *      parses from the hex file, in the same order.
+ *   2. A blank PIC programmed from the image, differential, ends up with the
+ *      same program and data memory as the old path (no image, every row
+ *      erased and programmed); so does an upgrade over older firmware.
+ *   3. Flashing the same file again loads the image instead of parsing the
+ *      hex, and only the fail safe row is erased and programmed again (when
+ *      the firmware has code there). A one-word firmware change programs
+ *      only that row on top. Over different firmware, where every row has
+ *      to be programmed, the row checks cost little.
+ *   4. A changed hex file or a damaged image is compiled again; a full file
+ *      system falls back to reading the hex file, without an image.
+ *   5. Dropped and corrupted bootloader replies still give the same result.
+ *
+ * Reports commands, bytes on the wire and simulated upgrade time per file
+ * for both modes, and the sscanf() calls and host time to prepare an
+ * upgrade (parse + fetch every row) from the hex file and from the image.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra -I tests/stubs tests/test_pic_image_flash.cpp -o tests/test_pic_image_flash.out
+ *   ./tests/test_pic_image_flash.out [datadir]
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+// The OTGWSerial constructor picks the UART by platform
+#define ESP32 1
+
+// Count the hex parsing work: on the ESP every sscanf() call is expensive.
+// The headers go first so the macro below only renames the library's calls.
+#include <Arduino.h>
+#include <HardwareSerial.h>
+#include <LittleFS.h>
+#include <cstdio>
+#include <stdarg.h>
+static unsigned long scanCalls = 0;
+static int countedSscanf(const char *s, const char *fmt, ...)
+{
+  va_list ap;
+  va_start(ap, fmt);
+  const int n = vsscanf(s, fmt, ap);
+  va_end(ap);
+  scanCalls++;
+  return n;
+}
+#define sscanf countedSscanf
+
+// The vendored library mixes & and | without parentheses in a few places.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wparentheses"
+#pragma GCC diagnostic ignored "-Wformat-truncation"
+#include "../src/libraries/OTGWSerial/OTGWSerial.cpp"
+#pragma GCC diagnostic pop
+#undef sscanf
+
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ---- simulated clock and GPIO ---------------------------------------------
+static uint64_t nowUs = 0;
+
+unsigned long millis() { return (unsigned long)(nowUs / 1000); }
+void delay(unsigned long ms) { nowUs += ms * 1000; }
+void delayMicroseconds(unsigned int us) { nowUs += us; }
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+
+fs::FS LittleFS;
+
+// ---- simulated bootloader -------------------------------------------------
+static const unsigned kByteUs  = 1042;   // 9600 baud, 8N1
+static const unsigned kEraseUs = 2000;   // row erase
+static const unsigned kWriteUs = 2000;   // 16F88 4-word block / 16F1847 row write
+static const unsigned kEeUs    = 4000;   // EEPROM byte write
+static const unsigned kResetUs = 50000;  // reset to bootloader handshake
+
+struct Bootloader {
+  byte pic = 1;                          // bootloader major version: 1 = 16F88, 2 = 16F1847
+  unsigned codesize = 4096, group = 4;
+  bool blockwrite = true;
+  unsigned protectstart = 0, protectend = 0;
+  std::vector<uint16_t> flash;
+  uint8_t eeprom[256];
+
+  // Wire state
+  std::deque<uint8_t> rx;                // towards the ESP
+  std::vector<uint8_t> reply;            // framed reply in progress
+  unsigned replyUs = 0;
+  bool replying = false;
+  std::vector<uint8_t> frame;
+  bool inFrame = false, dle = false;
+  std::string line;
+
+  // Fault injection: drop / corrupt every n-th reply (0 = never)
+  unsigned dropEvery = 0, corruptEvery = 0, replies = 0;
+
+  // Statistics
+  unsigned commands = 0, erases = 0, writes = 0, reads = 0, violations = 0;
+  uint64_t txBytes = 0, rxBytes = 0;
+
+  void setPic(OTGWProcessor model) {
+    pic = model == PIC16F88 ? 1 : 2;
+    codesize = model == PIC16F88 ? 4096 : 8192;
+    blockwrite = model == PIC16F88;
+    group = model == PIC16F88 ? 4 : 32;
+    protectstart = codesize - 256;
+    protectend = codesize - 1;
+  }
+
+  // A PIC with only the bootloader in it
+  void blank() {
+    flash.assign(codesize, 0x3fff);
+    for (unsigned a = protectstart; a <= protectend; a++) flash[a] = (uint16_t)(0x2000 | (a & 0x7ff));
+    memset(eeprom, 0xff, sizeof(eeprom));
+  }
+
+  void resetStats() { commands = erases = writes = reads = violations = 0; txBytes = rxBytes = 0; }
+
+  bool isProtected(unsigned addr) const { return addr >= protectstart && addr <= protectend; }
+
+  void sendFrame(std::vector<uint8_t> payload, unsigned opUs) {
+    uint8_t sum = 0;
+    for (uint8_t b : payload) sum -= b;
+    payload.push_back(sum);
+    replies++;
+    if (dropEvery && replies % dropEvery == 0) return;
+    if (corruptEvery && replies % corruptEvery == 0) payload[0] ^= 0x40;
+    reply.clear();
+    reply.push_back(STX);
+    for (uint8_t b : payload) {
+      if (b == STX || b == ETX || b == DLE) reply.push_back(DLE);
+      reply.push_back(b);
+    }
+    reply.push_back(ETX);
+    replyUs = opUs;
+    replying = true;
+  }
+
+  void command(const std::vector<uint8_t> &f) {
+    uint8_t sum = 0;
+    for (uint8_t b : f) sum += b;
+    if (f.size() < 3 || sum != 0) return;          // bad frame: no reply
+    commands++;
+    const unsigned n = f[1];
+    const unsigned addr = f.size() > 3 ? f[2] | f[3] << 8 : 0;
+    std::vector<uint8_t> r(f.begin(), f.begin() + std::min<size_t>(4, f.size() - 1));
+    switch (f[0]) {
+     case CMD_VERSION:
+      r = {CMD_VERSION, 3, 0, pic,
+           (uint8_t)protectstart, (uint8_t)(protectstart >> 8),
+           (uint8_t)protectend, (uint8_t)(protectend >> 8)};
+      sendFrame(r, 0);
+      break;
+     case CMD_READPROG:
+      reads++;
+      for (unsigned i = 0; i < n; i++) {
+        const uint16_t w = addr + i < codesize ? flash[addr + i] : 0x3fff;
+        r.push_back((uint8_t)w);
+        r.push_back((uint8_t)(w >> 8));
+      }
+      sendFrame(r, 0);
+      break;
+     case CMD_WRITEPROG: {
+      writes++;
+      const unsigned words = blockwrite ? n * group : n;
+      for (unsigned i = 0; i < words && 4 + 2 * i + 1 < f.size() - 1; i++) {
+        const uint16_t w = (uint16_t)(f[4 + 2 * i] | f[5 + 2 * i] << 8);
+        if (addr + i >= codesize || isProtected(addr + i)) { violations++; continue; }
+        flash[addr + i] &= w;                      // programming only clears bits
+      }
+      sendFrame(r, kWriteUs * (blockwrite ? n : 1));
+      break;
+     }
+     case CMD_ERASEPROG:
+      erases++;
+      for (unsigned i = 0; i < 32; i++) {
+        if (isProtected((addr & ~31u) + i)) { violations++; continue; }
+        flash[(addr & ~31u) + i] = 0x3fff;
+      }
+      sendFrame(r, kEraseUs);
+      break;
+     case CMD_READDATA:
+      for (unsigned i = 0; i < n; i++) r.push_back(eeprom[(addr + i) & 0xff]);
+      sendFrame(r, 0);
+      break;
+     case CMD_WRITEDATA:
+      for (unsigned i = 0; i < n && 4 + i < f.size() - 1; i++) eeprom[(addr + i) & 0xff] = f[4 + i];
+      sendFrame(r, kEeUs * n);
+      break;
+     case CMD_RESET:
+      break;
+    }
+  }
+
+  // A byte from the ESP
+  void receive(uint8_t c) {
+    txBytes++;
+    if (!inFrame) {
+      if (c == STX) {
+        inFrame = true;
+        dle = false;
+        frame.clear();
+        return;
+      }
+      line += (char)c;
+      if (line.size() >= 5 && line.compare(line.size() - 5, 5, "GW=R\r") == 0) {
+        // Reset: the bootloader announces itself with a bare ETX
+        line.clear();
+        reply.assign(1, ETX);
+        replyUs = kResetUs;
+        replying = true;
+      }
+      return;
+    }
+    if (dle) {
+      frame.push_back(c);
+      dle = false;
+    } else if (c == DLE) {
+      dle = true;
+    } else if (c == ETX) {
+      inFrame = false;
+      command(frame);
+    } else if (c == STX) {
+      frame.clear();
+    } else {
+      frame.push_back(c);
+    }
+  }
+
+  // Put the pending reply on the wire; false when there is none
+  bool deliver() {
+    if (!replying) return false;
+    replying = false;
+    nowUs += replyUs + kByteUs * reply.size();
+    rxBytes += reply.size();
+    rx.insert(rx.end(), reply.begin(), reply.end());
+    return true;
+  }
+};
+
+static Bootloader pic;
+
+int hostUartAvailable() { return (int)pic.rx.size(); }
+int hostUartRead()
+{
+  if (pic.rx.empty()) return -1;
+  const int c = pic.rx.front();
+  pic.rx.pop_front();
+  return c;
+}
+void hostUartWrite(uint8_t c) { nowUs += kByteUs; pic.receive(c); }
+void hostUartFlush() {}
+
+// ---- upgrade driver ---------------------------------------------------------
+static std::string debugLog;
+static void debugCapture(const char *fmt, ...)
+{
+  char buf[256];
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  debugLog += buf;
+}
+
+static bool upgradeDone = false;
+static OTGWError upgradeResult = OTGW_ERROR_NONE;
+static short upgradeErrors = 0, upgradeRetries = 0;
+static void upgradeFinished(OTGWError result, short errors, short retries)
+{
+  upgradeDone = true;
+  upgradeResult = result;
+  upgradeErrors = errors;
+  upgradeRetries = retries;
+}
+
+struct Run {
+  OTGWError rc = OTGW_ERROR_NONE;
+  short errors = 0, retries = 0;
+  unsigned commands = 0, erases = 0, writes = 0, reads = 0, violations = 0;
+  uint64_t bytes = 0, us = 0;
+  std::string log;
+};
+
+static Run flash(OTGWSerial &serial, const std::string &hexfile, bool differential)
+{
+  Run run;
+  serial.setDifferential(differential);
+  pic.resetStats();
+  pic.replies = 0;
+  debugLog.clear();
+  upgradeDone = false;
+  const uint64_t start = nowUs;
+  OTGWError rc = serial.startUpgrade(hexfile.c_str());
+  if (rc != OTGW_ERROR_NONE) {
+    run.rc = rc;
+    return run;
+  }
+  while (!upgradeDone && nowUs - start < 3600ull * 1000000) {
+    serial.busy();
+    if (upgradeDone) break;
+    if (!pic.deliver()) nowUs += 10000;       // nothing in flight: time passes
+  }
+  run.rc = upgradeDone ? upgradeResult : OTGW_ERROR_RETRIES;
+  run.errors = upgradeErrors;
+  run.retries = upgradeRetries;
+  run.commands = pic.commands;
+  run.erases = pic.erases;
+  run.writes = pic.writes;
+  run.reads = pic.reads;
+  run.violations = pic.violations;
+  run.bytes = pic.txBytes + pic.rxBytes;
+  run.us = nowUs - start;
+  run.log = debugLog;
+  return run;
+}
+
+// Rows in the order the CODE stage fetches them, from the image or the hex
+class Probe : public OTGWUpgrade {
+public:
+  explicit Probe(OTGWSerial *serial) : OTGWUpgrade(serial) {}
+  bool prepare(const char *hexfile) { return readHexFile(hexfile) == OTGW_ERROR_NONE; }
+  bool usesImage() const { return (bool)imgfd; }
+  std::vector<std::vector<uint16_t>> rows() {
+    std::vector<std::vector<uint16_t>> out;
+    rewindCode();
+    for (int addr; out.size() <= info.codesize / 32u && (addr = codeRow(codemem)) >= 0 && addr < info.codesize; ) {
+      std::vector<uint16_t> row(1, (uint16_t)addr);
+      row.insert(row.end(), codemem, codemem + 32);
+      out.push_back(row);
+    }
+    return out;
+  }
+};
+
+// ---- helpers ----------------------------------------------------------------
+static int failures = 0;
+
+static void check(const std::string &name, bool ok)
+{
+  std::printf("%-72s %s\n", name.c_str(), ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+static std::string readFile(const std::string &path)
+{
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+static void writeFile(const std::string &path, const std::string &data)
+{
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << data;
+}
+
+static bool exists(const std::string &path) { return std::filesystem::exists(LittleFS.root + path); }
+
+static std::string imageOf(const std::string &hexfile) { return hexfile.substr(0, hexfile.size() - 4) + ".img"; }
+
+// Change one program word in the middle of the code: the smallest firmware bump
+static std::string bumpHex(const std::string &hex, unsigned codesize)
+{
+  std::vector<std::string> lines;
+  std::istringstream in(hex);
+  for (std::string l; std::getline(in, l); ) lines.push_back(l);
+  unsigned seg = 0, candidates = 0;
+  std::vector<size_t> data;
+  for (size_t i = 0; i < lines.size(); i++) {
+    unsigned len, addr, tag;
+    if (std::sscanf(lines[i].c_str(), ":%2x%4x%2x", &len, &addr, &tag) != 3) continue;
+    if (tag == 4) { unsigned v; std::sscanf(lines[i].c_str() + 9, "%4x", &v); seg = v << 16; }
+    const unsigned word = (seg + addr) / 2;
+    if (tag == 0 && len >= 2 && word >= 256 && word + len / 2 < codesize - 256) data.push_back(i), candidates++;
+  }
+  if (!candidates) return hex;
+  std::string &l = lines[data[candidates / 2]];
+  unsigned lo;
+  std::sscanf(l.c_str() + 9, "%2x", &lo);
+  char b[3];
+  std::snprintf(b, sizeof(b), "%02X", (lo ^ 0x01) & 0xff);
+  l.replace(9, 2, b);
+  unsigned len, sum = 0;
+  std::sscanf(l.c_str() + 1, "%2x", &len);
+  for (unsigned i = 0; i < len + 4; i++) { unsigned v; std::sscanf(l.c_str() + 1 + 2 * i, "%2x", &v); sum += v; }
+  std::snprintf(b, sizeof(b), "%02X", (unsigned)(-sum) & 0xff);
+  l.replace(1 + 2 * (len + 4), 2, b);
+  std::string out;
+  for (const std::string &s : lines) out += s + "\n";
+  return out;
+}
+
+struct Memory {
+  std::vector<uint16_t> flash;
+  std::vector<uint8_t> eeprom;
+  bool operator==(const Memory &o) const { return flash == o.flash && eeprom == o.eeprom; }
+};
+
+static Memory snapshot() { return {pic.flash, std::vector<uint8_t>(pic.eeprom, pic.eeprom + 256)}; }
+static void restore(const Memory &m) { pic.flash = m.flash; memcpy(pic.eeprom, m.eeprom.data(), 256); }
+
+static std::string label(const std::string &hexfile, const char *what) { return hexfile + ": " + what; }
+
+static bool clean(const Run &r) { return r.rc == OTGW_ERROR_NONE && r.errors == 0 && r.violations == 0; }
+
+// ---- cases -------------------------------------------------------------------
+struct Timing { std::string file; unsigned rows; Run legacy, first, again, bump; };
+static std::vector<Timing> timings;
+
+static void testFile(OTGWSerial &serial, OTGWProcessor model, const std::string &hexfile)
+{
+  pic.setPic(model);
+  LittleFS.remove(imageOf(hexfile).c_str());
+
+  // 1. Image rows == hex rows
+  std::vector<std::vector<uint16_t>> hexRows, imgRows;
+  {
+    LittleFS.readOnly = true;
+    Probe p(&serial);
+    check(label(hexfile, "prepared from hex (no image)"), p.prepare(hexfile.c_str()) && !p.usesImage());
+    hexRows = p.rows();
+    LittleFS.readOnly = false;
+  }
+  {
+    Probe p(&serial);
+    check(label(hexfile, "first prepare compiles the image"), p.prepare(hexfile.c_str()) && p.usesImage() && exists(imageOf(hexfile)));
+  }
+  {
+    Probe p(&serial);
+    check(label(hexfile, "next prepare loads the image"), p.prepare(hexfile.c_str()) && p.usesImage());
+    imgRows = p.rows();
+  }
+  check(label(hexfile, "image rows equal prepareCode() rows"), !hexRows.empty() && imgRows == hexRows);
+  // The fail safe row is programmed again if the firmware has code there
+  unsigned failsafe = 1;
+  for (const auto &row : hexRows) if (row[0] == 32) failsafe = 2;
+
+  // 2. Old path vs image + differential on a blank PIC
+  LittleFS.remove(imageOf(hexfile).c_str());
+  LittleFS.readOnly = true;
+  pic.blank();
+  Timing t;
+  t.file = hexfile;
+  t.rows = (unsigned)hexRows.size();
+  t.legacy = flash(serial, hexfile, false);
+  const Memory reference = snapshot();
+  LittleFS.readOnly = false;
+  check(label(hexfile, "old path programs a blank PIC"), clean(t.legacy) && !exists(imageOf(hexfile)));
+
+  pic.blank();
+  t.first = flash(serial, hexfile, true);
+  check(label(hexfile, "image + differential programs a blank PIC the same"),
+        clean(t.first) && snapshot() == reference && t.first.log.find("rows compiled") != std::string::npos);
+
+  // 3. Same file again: image loaded, only the fail safe row reprogrammed
+  t.again = flash(serial, hexfile, true);
+  check(label(hexfile, "reflash loads the image, same memory"),
+        clean(t.again) && snapshot() == reference && t.again.log.find("rows compiled") == std::string::npos
+        && t.again.log.find(" rows\n") != std::string::npos);
+  check(label(hexfile, "reflash erases only the fail safe row"), t.again.erases == failsafe && t.again.writes == failsafe);
+
+  // One changed word: that row and the fail safe row
+  const std::string bumped = hexfile.substr(0, hexfile.size() - 4) + "-bump.hex";
+  writeFile(LittleFS.root + bumped, bumpHex(readFile(LittleFS.root + hexfile), pic.codesize));
+  LittleFS.readOnly = true;
+  pic.blank();
+  flash(serial, bumped, false);
+  const Memory bumpReference = snapshot();
+  LittleFS.readOnly = false;
+  check(label(hexfile, "bumped hex differs in program memory"), !(bumpReference == reference));
+  restore(reference);
+  t.bump = flash(serial, bumped, true);
+  check(label(hexfile, "one-word bump programs two rows, same memory"),
+        clean(t.bump) && snapshot() == bumpReference && t.bump.erases == failsafe + 1);
+  LittleFS.remove(bumped.c_str());
+  LittleFS.remove(imageOf(bumped).c_str());
+  timings.push_back(t);
+}
+
+static void testUpgrade(OTGWSerial &serial, const std::string &from, const std::string &to)
+{
+  pic.setPic(PIC16F88);
+  LittleFS.readOnly = true;
+  pic.blank();
+  flash(serial, from, false);
+  const Memory old = snapshot();
+  const Run legacy = flash(serial, to, false);
+  const Memory reference = snapshot();
+  LittleFS.readOnly = false;
+
+  restore(old);
+  const Run diff = flash(serial, to, true);
+  check(to + ": over " + from + ", differential = old path",
+        clean(legacy) && clean(diff) && snapshot() == reference);
+  check(to + ": over " + from + ", row checks cost < 3%", diff.us < legacy.us * 103 / 100);
+  std::printf("  %s -> %s: %u of %u rows erased, %.1f s -> %.1f s, %llu -> %llu bytes\n",
+              from.c_str(), to.c_str(), diff.erases, legacy.erases, legacy.us / 1e6, diff.us / 1e6,
+              (unsigned long long)legacy.bytes, (unsigned long long)diff.bytes);
+}
+
+static void testStaleImage(OTGWSerial &serial, const std::string &dir, const std::string &older, const std::string &newer)
+{
+  pic.setPic(PIC16F88);
+  const std::string hexfile = dir + "/stale.hex";
+  LittleFS.readOnly = true;
+  pic.blank();
+  flash(serial, newer, false);
+  const Memory reference = snapshot();
+  LittleFS.readOnly = false;
+
+  // The image of an older file under the same name
+  writeFile(LittleFS.root + hexfile, readFile(LittleFS.root + older));
+  pic.blank();
+  check("stale.hex (older firmware) compiles an image", clean(flash(serial, hexfile, true)) && exists(imageOf(hexfile)));
+  writeFile(LittleFS.root + hexfile, readFile(LittleFS.root + newer));
+  pic.blank();
+  Run r = flash(serial, hexfile, true);
+  check("replaced hex: stale image rejected and compiled again",
+        clean(r) && snapshot() == reference && r.log.find("not usable") != std::string::npos
+        && r.log.find("rows compiled") != std::string::npos);
+
+  // A flipped bit in a row
+  std::string img = readFile(LittleFS.root + imageOf(hexfile));
+  img[img.size() / 2] ^= 0x10;
+  writeFile(LittleFS.root + imageOf(hexfile), img);
+  pic.blank();
+  r = flash(serial, hexfile, true);
+  check("damaged image rejected and compiled again",
+        clean(r) && snapshot() == reference && r.log.find("not usable") != std::string::npos
+        && r.log.find("rows compiled") != std::string::npos);
+
+  // Truncated image (e.g. power loss while writing it)
+  img = readFile(LittleFS.root + imageOf(hexfile));
+  writeFile(LittleFS.root + imageOf(hexfile), img.substr(0, img.size() - 100));
+  pic.blank();
+  r = flash(serial, hexfile, true);
+  check("truncated image rejected and compiled again", clean(r) && snapshot() == reference
+        && r.log.find("not usable") != std::string::npos);
+  LittleFS.remove(hexfile.c_str());
+  LittleFS.remove(imageOf(hexfile).c_str());
+}
+
+static void testFaults(OTGWSerial &serial, OTGWProcessor model, const std::string &from, const std::string &to)
+{
+  pic.setPic(model);
+  LittleFS.readOnly = true;
+  pic.blank();
+  flash(serial, from, false);
+  const Memory old = snapshot();
+  flash(serial, to, false);
+  const Memory reference = snapshot();
+  LittleFS.readOnly = false;
+
+  restore(old);
+  // About one reply in twelve lost: well inside the 100 retries per upgrade
+  pic.dropEvery = 23;
+  pic.corruptEvery = 29;
+  const Run r = flash(serial, to, true);
+  pic.dropEvery = 0;
+  pic.corruptEvery = 0;
+  check(to + ": dropped/corrupted replies, same memory",
+        r.rc == OTGW_ERROR_NONE && r.violations == 0 && r.retries > 0 && snapshot() == reference);
+}
+
+static void hostTiming(OTGWSerial &serial, const std::string &hexfile)
+{
+  const int passes = 20;
+  double ns[2];
+  unsigned long scans[2];
+  for (int image = 0; image < 2; image++) {
+    LittleFS.readOnly = !image;
+    if (!image) {
+      LittleFS.remove(imageOf(hexfile).c_str());
+    } else {
+      Probe(&serial).prepare(hexfile.c_str());   // compile the image once
+    }
+    scanCalls = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < passes; i++) {
+      Probe p(&serial);
+      p.prepare(hexfile.c_str());
+      p.rows();
+    }
+    ns[image] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / passes;
+    scans[image] = scanCalls / passes;
+  }
+  LittleFS.readOnly = false;
+  check(hexfile + ": preparing from the image parses nothing", scans[0] > 0 && scans[1] == 0);
+  std::printf("  prepare + fetch all rows of %s: hex %lu sscanf calls %.0f us, image %lu calls %.0f us (host)\n",
+              hexfile.c_str(), scans[0], ns[0] / 1000, scans[1], ns[1] / 1000);
+}
+
+int main(int argc, char **argv)
+{
+  const std::string data = argc > 1 ? argv[1] : "src/OTGW-firmware/data";
+  std::printf("=== PIC image + differential flash test ===\n");
+
+  char tmpl[] = "/tmp/otgw_pic_XXXXXX";
+  if (!mkdtemp(tmpl)) {
+    std::printf("cannot create a temporary directory\n");
+    return 1;
+  }
+  LittleFS.root = tmpl;
+  const char *dirs[] = {"pic16f88", "pic16f1847"};
+  std::vector<std::pair<OTGWProcessor, std::string>> files;
+  for (int d = 0; d < 2; d++) {
+    std::filesystem::create_directory(LittleFS.root + "/" + dirs[d]);
+    std::vector<std::string> names;
+    for (const auto &e : std::filesystem::directory_iterator(data + "/" + dirs[d])) {
+      if (e.path().extension() != ".hex") continue;
+      std::filesystem::copy_file(e.path(), LittleFS.root + "/" + dirs[d] + "/" + e.path().filename().string());
+      names.push_back(e.path().filename().string());
+    }
+    std::sort(names.begin(), names.end());
+    for (const std::string &n : names) files.push_back({d ? PIC16F1847 : PIC16F88, std::string("/") + dirs[d] + "/" + n});
+  }
+  check("bundled hex files found for both PICs", files.size() >= 4);
+
+  pic.setPic(PIC16F88);
+  pic.blank();
+  OTGWSerial serial;
+  pic.rx.clear();
+  pic.replying = false;
+  serial.registerFinishedCallback(upgradeFinished);
+  serial.registerDebugFunc(debugCapture);
+
+  for (const auto &f : files) testFile(serial, f.first, f.second);
+  testUpgrade(serial, "/pic16f88/gateway-4.3.hex", "/pic16f88/gateway.hex");
+  testStaleImage(serial, "/pic16f88", "/pic16f88/gateway-4.3.hex", "/pic16f88/gateway.hex");
+  testFaults(serial, PIC16F88, "/pic16f88/gateway-4.3.hex", "/pic16f88/gateway.hex");
+  testFaults(serial, PIC16F1847, "/pic16f1847/gateway.hex", "/pic16f1847/gateway.hex");
+
+  std::printf("\n%-28s %5s | %-26s | %-26s | %-26s | %-26s\n", "file", "rows",
+              "old path", "image, blank PIC", "same file again", "one-word bump");
+  for (const Timing &t : timings) {
+    std::printf("%-28s %5u", t.file.c_str(), t.rows);
+    for (const Run *r : {&t.legacy, &t.first, &t.again, &t.bump})
+      std::printf(" | %4u cmd %6llu B %6.1f s", r->commands, (unsigned long long)r->bytes, r->us / 1e6);
+    std::printf("\n");
+  }
+  hostTiming(serial, "/pic16f88/gateway.hex");
+  hostTiming(serial, "/pic16f1847/gateway.hex");
+
+  std::filesystem::remove_all(LittleFS.root);
+  std::printf("\n%s (%d failure%s)\n", failures ? "FAILED" : "ALL PASSED", failures, failures == 1 ? "" : "s");
+  return failures ? 1 : 0;
+}
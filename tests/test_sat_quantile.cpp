@@ -0,0 +1,370 @@
+/**
+ * Host accuracy test for the SAT cycle quantile estimators (SATQuantile.h).
+ *
+ * SATcycles.ino answers its percentiles from SATFlowHistogram (full-cycle
+ * flow p10/p90) and SATOrderWindow (180 s tail window, 4h flow-return deltas)
+ * instead of copying and insertion-sorting its sample rings per query. The
+ * reference throughout is that legacy answer: element pct * (n - 1) / 100
+ * of the sorted samples. This file checks:
+ *
+ *   1. Histogram accuracy on boiler flow traces: the Tboiler/Tret readings
+ *      in tests/fixtures/otgw_replay.log, and synthetic cycles (warm-up ramp,
+ *      overshoot, settling, f8.8 quantisation, the loop sampling each OT
+ *      reading many times over) from 5 to 200000 samples, plus sorted and
+ *      shuffled orderings. p10/p50/p90 must be within half a bin (0.125 °C)
+ *      of exact, 1.5 bins on a trace long enough to halve the bins.
+ *   2. SATOrderWindow as the tail window: a ring of SAT_TAIL_SAMPLE_SIZE
+ *      values with insert/erase mirrored on every push matches a fresh sort
+ *      after every sample, including duplicates, NaN and -0.0/+0.0.
+ *   3. SATOrderWindow as the 4h window: records with random cycle lengths,
+ *      expired by age from the oldest end and overwritten by a full ring,
+ *      match the legacy walk-and-sort after every query.
+ *
+ * Also reports ns per query for the legacy sort against the estimators.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/test_sat_quantile.cpp -o tests/test_sat_quantile.out
+ *   ./tests/test_sat_quantile.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../src/OTGW-firmware/SATQuantile.h"
+
+// boards.h (ESP32 builds)
+static const uint16_t kTailSize = 180;   // SAT_TAIL_SAMPLE_SIZE
+static const uint16_t kWin4hSize = 360;  // SAT_WIN4H_SIZE
+
+static int failures = 0;
+
+static void check(const char *name, bool ok)
+{
+  std::printf("%-64s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+static uint64_t g_rng = 0x9E3779B97F4A7C15ull;
+static inline uint32_t rnd()
+{
+  g_rng ^= g_rng >> 12; g_rng ^= g_rng << 25; g_rng ^= g_rng >> 27;
+  return (uint32_t)((g_rng * 0x2545F4914F6CDD1Dull) >> 32);
+}
+static inline float frand() { return (float)(rnd() & 0xFFFFFF) / (float)0x1000000; }
+
+// The legacy answer: element pct * (n - 1) / 100 of the sorted samples.
+static float exactPercentile(const std::vector<float> &samples, uint8_t pct)
+{
+  std::vector<float> s(samples);
+  std::sort(s.begin(), s.end());
+  return s[(uint32_t)pct * (s.size() - 1) / 100];
+}
+
+// What _flowPercentile()/_tailPercentile() did per query: copy + insertion sort.
+static float insertionSortPercentile(const std::vector<float> &samples, uint8_t pct)
+{
+  std::vector<float> s(samples);
+  for (size_t i = 1; i < s.size(); i++) {
+    const float key = s[i];
+    size_t j = i;
+    while (j > 0 && s[j - 1] > key) { s[j] = s[j - 1]; j--; }
+    s[j] = key;
+  }
+  return s[(uint32_t)pct * (s.size() - 1) / 100];
+}
+
+static float f88(float c) { return std::round(c * 256.0f) / 256.0f; }
+
+// ---------------------------------------------------------------------------
+// Traces
+// ---------------------------------------------------------------------------
+struct Trace {
+  std::string name;
+  std::vector<float> v;
+};
+
+// f8.8 data of MsgID 25 (Tboiler) and 28 (Tret) read-acks in the capture.
+static std::vector<float> recordedTemps(const char *path)
+{
+  std::vector<float> out;
+  FILE *f = std::fopen(path, "r");
+  if (!f) return out;
+  char line[128];
+  while (std::fgets(line, sizeof(line), f)) {
+    unsigned type, id, data;
+    if (line[0] != 'B' || std::sscanf(line + 1, "%1x%*1x%2x%4x", &type, &id, &data) != 3) continue;
+    if ((type & 0x7) != 0x4 || (id != 25 && id != 28)) continue;   // READ_ACK
+    out.push_back((float)(int16_t)data / 256.0f);
+  }
+  std::fclose(f);
+  return out;
+}
+
+// One heating cycle sampled at loop rate: flow starts at the return
+// temperature, rises towards the setpoint with an overshoot, settles with a
+// slow oscillation; a new OT reading every `hold` loop samples.
+static std::vector<float> syntheticCycle(uint32_t samples, uint32_t hold, float start, float setpoint)
+{
+  std::vector<float> v;
+  v.reserve(samples);
+  float reading = start;
+  const float tau = (float)samples * 0.15f + 1.0f;
+  for (uint32_t i = 0; i < samples; i++) {
+    if (i % hold == 0) {
+      const float t = (float)i;
+      const float rise = (setpoint - start) * (1.0f - std::exp(-t / tau));
+      const float overshoot = 4.0f * std::exp(-std::pow((t - 1.5f * tau) / tau, 2.0f));
+      const float wobble = 0.6f * std::sin(t / (tau * 0.3f));
+      reading = f88(start + rise + overshoot + wobble + (frand() - 0.5f) * 0.4f);
+    }
+    v.push_back(reading);
+  }
+  return v;
+}
+
+static std::vector<Trace> traces()
+{
+  std::vector<Trace> t;
+  t.push_back({"capture Tboiler/Tret", recordedTemps("tests/fixtures/otgw_replay.log")});
+  static const struct { uint32_t n, hold; } kShapes[] = {
+    {5, 1}, {10, 1}, {12, 1}, {50, 1}, {180, 1}, {256, 1}, {1000, 1}, {1000, 8},
+    {5000, 1}, {5000, 25}, {20000, 50}, {200000, 200},
+  };
+  for (const auto &s : kShapes) {
+    for (int k = 0; k < 3; k++) {
+      char name[48];
+      std::snprintf(name, sizeof(name), "cycle n=%u hold=%u #%d", s.n, s.hold, k);
+      t.push_back({name, syntheticCycle(s.n, s.hold, 25.0f + 10.0f * frand(), 45.0f + 25.0f * frand())});
+    }
+  }
+  // Hours at one reading after the ramp: enough samples in one bin to halve.
+  std::vector<float> steady = syntheticCycle(20000, 1, 30.0f, 55.0f);
+  steady.insert(steady.end(), 300000, 55.0f);
+  t.push_back({"steady n=320000", steady});
+  // Adversarial orderings of the same values.
+  std::vector<float> up = syntheticCycle(4000, 1, 30.0f, 60.0f);
+  std::sort(up.begin(), up.end());
+  t.push_back({"sorted ascending n=4000", up});
+  std::vector<float> down(up.rbegin(), up.rend());
+  t.push_back({"sorted descending n=4000", down});
+  std::vector<float> shuffled(up);
+  for (size_t i = shuffled.size(); i > 1; i--) std::swap(shuffled[i - 1], shuffled[rnd() % i]);
+  t.push_back({"shuffled n=4000", shuffled});
+  return t;
+}
+
+// ---------------------------------------------------------------------------
+// 1. Full-cycle histogram
+// ---------------------------------------------------------------------------
+static const double kHalfBin = 0.5 / SATFlowHistogram::kBinsPerDegree;
+
+static void testHistogram()
+{
+  std::printf("--- full-cycle flow histogram vs exact percentile ---\n");
+  static const uint8_t kPcts[] = {10, 50, 90};
+  const std::vector<Trace> all = traces();
+  double worst = 0.0, worstHalved = 0.0;
+  bool recorded = false;
+  static SATFlowHistogram h;
+
+  for (const Trace &t : all) {
+    if (t.v.empty()) continue;
+    if (t.name.compare(0, 7, "capture") == 0) recorded = true;
+    h.reset();
+    for (float x : t.v) h.add(x);
+    std::vector<float> sorted(t.v);
+    std::sort(sorted.begin(), sorted.end());
+    // A bin reached 0xFFFF when the most frequent value covers that many samples.
+    size_t run = 1, maxRun = 1;
+    for (size_t i = 1; i < sorted.size(); i++) {
+      run = (std::floor(sorted[i] * 4.0f) == std::floor(sorted[i - 1] * 4.0f)) ? run + 1 : 1;
+      maxRun = std::max(maxRun, run);
+    }
+    const bool halved = maxRun >= 0xFFFF;
+    double row = 0.0;
+    for (uint8_t pct : kPcts) {
+      const double err = std::fabs((double)h.percentile(pct) - (double)exactPercentile(t.v, pct));
+      row = std::max(row, err);
+    }
+    if (halved) worstHalved = std::max(worstHalved, row);
+    else worst = std::max(worst, row);
+    std::printf("  %-28s n=%-7zu max err %.3f C%s\n", t.name.c_str(), t.v.size(), row, halved ? " (bins halved)" : "");
+  }
+  std::printf("  worst p10/p50/p90 error %.3f C, %.3f C after halving (half a bin = %.3f C)\n",
+              worst, worstHalved, kHalfBin);
+  check("recorded capture found and used", recorded);
+  check("p10/p50/p90 within half a bin of exact on every trace", worst <= kHalfBin + 1e-6);
+  check("within one and a half bins after halving", worstHalved <= 3 * kHalfBin + 1e-6);
+
+  h.reset();
+  h.add(NAN);
+  h.add(-5.0f);
+  h.add(250.0f);
+  check("NaN ignored, out-of-range samples land in the edge bins",
+        h.count() == 2 && h.percentile(0) == (float)kHalfBin && h.percentile(100) == 100.0f - (float)kHalfBin);
+}
+
+// ---------------------------------------------------------------------------
+// 2. Tail window: ring + mirrored order window
+// ---------------------------------------------------------------------------
+static void testTailWindow()
+{
+  std::printf("--- order window as the %u s tail ring ---\n", (unsigned)kTailSize);
+  SATOrderWindow<kTailSize> win;
+  float ring[kTailSize];
+  uint16_t head = 0, count = 0;
+  bool same = true;
+  uint32_t queries = 0;
+
+  for (uint32_t i = 0; i < 20000 && same; i++) {
+    float x;
+    switch (rnd() % 16) {
+      case 0:  x = NAN; break;
+      case 1:  x = (rnd() & 1) ? 0.0f : -0.0f; break;
+      case 2:  x = count ? ring[(head + kTailSize - 1) % kTailSize] : 40.0f; break;   // repeat
+      default: x = f88(30.0f + 40.0f * frand()); break;
+    }
+    if (count == kTailSize) win.erase(ring[head]);   // evicted by this push
+    ring[head] = x;
+    win.insert(x);
+    head = (uint16_t)((head + 1) % kTailSize);
+    if (count < kTailSize) count++;
+
+    std::vector<float> cur;
+    for (uint16_t k = 0; k < count; k++) {
+      const float v = ring[(head + kTailSize - count + k) % kTailSize];
+      if (v == v) cur.push_back(v);
+    }
+    same = win.size() == cur.size();
+    for (uint8_t pct : {0, 10, 50, 90, 100}) {
+      if (!same || cur.empty()) break;
+      same = win.percentile(pct) == exactPercentile(cur, pct);
+      queries++;
+    }
+  }
+  std::printf("  %u queries\n", (unsigned)queries);
+  check("tail window percentiles equal a fresh sort after every sample", same);
+}
+
+// ---------------------------------------------------------------------------
+// 3. 4h window: age expiry from the oldest end + ring overwrite
+// ---------------------------------------------------------------------------
+static void test4hWindow()
+{
+  std::printf("--- order window as the 4h cycle window (%u records) ---\n", (unsigned)kWin4hSize);
+  const uint32_t span = 4UL * 3600UL * 1000UL;
+  struct Rec { uint32_t endMs; float delta; };
+  std::vector<Rec> ring(kWin4hSize);
+  uint16_t head = 0, count = 0, live = 0;
+  SATOrderWindow<kWin4hSize> win;
+  uint32_t now = 0xFFFFFFFFu - 6UL * 3600UL * 1000UL;   // crosses the millis() wrap
+  bool same = true;
+  uint32_t queries = 0, maxLive = 0;
+  bool emptied = false;
+
+  for (uint32_t i = 0; i < 40000 && same; i++) {
+    // Bursts of short cycles fill the ring; long gaps age everything out.
+    const uint32_t r = rnd() % 100;
+    if (i % 4000 < 2000) now += 5000 + rnd() % 25000;   // dense phase: the ring runs full
+    else now += (r < 85) ? 10000 + rnd() % 30000 : (r < 97) ? 300000 + rnd() % 900000 : 3600000 + rnd() % 10000000;
+    const float delta = (rnd() % 10 == 0) ? -1.0f : f88(3.0f + 15.0f * frand());
+
+    if (count == kWin4hSize && live == kWin4hSize) {   // overwriting a live record
+      if (ring[head].delta >= 0.0f) win.erase(ring[head].delta);
+      live--;
+    }
+    ring[head] = {now, delta};
+    if (delta >= 0.0f) win.insert(delta);
+    head = (uint16_t)((head + 1) % kWin4hSize);
+    if (count < kWin4hSize) count++;
+    live++;
+
+    if (rnd() % 3) continue;   // stats tick is not after every cycle
+    now += (rnd() % 200 == 0) ? 5UL * 3600UL * 1000UL : rnd() % 120000;   // sometimes the boiler stays off
+    while (live > 0) {
+      const Rec &old = ring[(head + kWin4hSize - live) % kWin4hSize];
+      if (now - old.endMs <= span) break;
+      if (old.delta >= 0.0f) win.erase(old.delta);
+      live--;
+    }
+    maxLive = std::max<uint32_t>(maxLive, live);
+    if (maxLive == kWin4hSize && live == 0) emptied = true;
+
+    // Legacy: walk every record, keep those inside the span, sort.
+    std::vector<float> deltas;
+    for (uint16_t k = 0; k < count; k++) {
+      const Rec &rec = ring[(head + kWin4hSize - 1 - k) % kWin4hSize];
+      if (now - rec.endMs > span) continue;
+      if (rec.delta >= 0.0f) deltas.push_back(rec.delta);
+    }
+    same = win.size() == deltas.size();
+    if (same && !deltas.empty())
+      same = win.percentile(50) == exactPercentile(deltas, 50) && win.percentile(90) == exactPercentile(deltas, 90);
+    queries++;
+  }
+  std::printf("  %u queries, up to %u live records\n", (unsigned)queries, (unsigned)maxLive);
+  check("4h window percentiles equal the legacy walk after every tick", same);
+  check("ring ran full, then aged out completely", maxLive == kWin4hSize && emptied);
+}
+
+// ---------------------------------------------------------------------------
+// Cost per query
+// ---------------------------------------------------------------------------
+static void bench()
+{
+  std::printf("--- cost per query ---\n");
+  const std::vector<float> cyc = syntheticCycle(kWin4hSize, 1, 30.0f, 60.0f);
+  volatile float sink = 0.0f;
+  const int reps = 20000;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) sink = sink + insertionSortPercentile(cyc, 90);
+  auto t1 = std::chrono::steady_clock::now();
+  const double sortNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / reps;
+
+  SATOrderWindow<kWin4hSize> win;
+  for (float x : cyc) win.insert(x);
+  t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) {   // one eviction + arrival, then the query
+    win.erase(cyc[i % cyc.size()]);
+    win.insert(cyc[i % cyc.size()]);
+    sink = sink + win.percentile(90);
+  }
+  t1 = std::chrono::steady_clock::now();
+  const double winNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / reps;
+
+  static SATFlowHistogram h;
+  h.reset();
+  t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) h.add(cyc[i % cyc.size()]);
+  t1 = std::chrono::steady_clock::now();
+  const double addNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / reps;
+  t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) sink = sink + h.percentile(90);
+  t1 = std::chrono::steady_clock::now();
+  const double histNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / reps;
+
+  std::printf("  n=%u: copy + insertion sort %.0f ns/query\n", (unsigned)kWin4hSize, sortNs);
+  std::printf("  order window %.0f ns/update+query; histogram %.1f ns/sample, %.0f ns/query\n",
+              winNs, addNs, histNs);
+  (void)sink;
+}
+
+int main()
+{
+  std::printf("=== SAT quantile estimator test ===\n");
+  testHistogram();
+  testTailWindow();
+  test4hWindow();
+  bench();
+  std::printf("\n%s (%d failure%s)\n", failures ? "FAILED" : "ALL PASSED", failures, failures == 1 ? "" : "s");
+  return failures ? 1 : 0;
+}
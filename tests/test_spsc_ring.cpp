@@ -0,0 +1,285 @@
+/**
+ * Host test for the lock-free SPSC record ring (PlatformSpscRing in
+ * src/libraries/Platform/src/platform_spsc_ring.h).
+ *
+ * otFrameRing (OTGW-Core.ino) carries every PIC / OTDirect line from the
+ * producer (the PIC task, or loop for OTDirect and the replay simulation) to
+ * drainOTFrameQueue() in loop. It replaced a FreeRTOS queue of 16 fixed
+ * 516-byte OTFrameMsg items. This file checks:
+ *
+ *   1. Sizing: a kMaxPayload record fits into an empty ring at every index,
+ *      and for the firmware ring (OT_FRAME_RING_BYTES) a full MAX_BUFFER_READ
+ *      line still fits behind a backlog of 16 frames at every index. Reports
+ *      the RAM against the old queue storage.
+ *   2. Single-thread model check: a random reserve(maxLen)/commit(len <=
+ *      maxLen)/peek/release stream against a std::deque, across many wraps,
+ *      including full-ring refusals and zero-length records.
+ *   3. Stress: one producer std::thread and one consumer std::thread on small
+ *      and firmware-sized rings, random lengths up to kMaxPayload, random
+ *      yields on both sides. The consumer checks sequence (tag), length and
+ *      every payload byte in place; the producer writes the payload straight
+ *      into the reserved space (the firmware's single memcpy).
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra -pthread tests/test_spsc_ring.cpp -o tests/test_spsc_ring.out
+ *   ./tests/test_spsc_ring.out [records]
+ *   echo $?   # 0 on pass, 1 on failure
+ *
+ * For the memory-ordering proof run it under ThreadSanitizer too:
+ *   g++ -std=c++17 -O1 -g -fsanitize=thread -pthread tests/test_spsc_ring.cpp -o tests/test_spsc_ring.tsan
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include "../src/libraries/Platform/src/platform_spsc_ring.h"
+
+// Mirrors OTGW-Core.h.
+#define MAX_BUFFER_READ      512
+#define OT_FRAME_QUEUE_DEPTH 16
+#define OT_FRAME_RING_BYTES  (2 * (MAX_BUFFER_READ + 2 * PLATFORM_SPSC_HDR) + OT_FRAME_QUEUE_DEPTH * 16)
+struct OTFrameMsgLegacy {            // the old queue item
+  char     line[MAX_BUFFER_READ];
+  uint16_t len;
+  bool     suppressOutput;
+  uint8_t  source;
+};
+
+static int failures = 0;
+
+static void check(const char *name, bool ok)
+{
+  std::printf("%-60s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failures++;
+}
+
+static uint64_t rngState = 0x9E3779B97F4A7C15ull;
+static uint64_t rnd()
+{
+  rngState ^= rngState >> 12;
+  rngState ^= rngState << 25;
+  rngState ^= rngState >> 27;
+  return rngState * 0x2545F4914F6CDD1Dull;
+}
+
+// Payload byte i of record seq: every byte depends on both, so a stale,
+// torn or misplaced record shows up.
+static inline uint8_t payloadByte(uint32_t seq, uint32_t i)
+{
+  return (uint8_t)((seq * 131u) ^ (i * 7u) ^ (i >> 8));
+}
+
+// Move an empty ring's indices to byte offset `at` with zero-length records.
+template <uint32_t B>
+static void advanceEmpty(PlatformSpscRing<B> &r, uint32_t at)
+{
+  uint16_t len, tag;
+  for (uint32_t i = 0; i < at / 4; i++) {
+    r.push(nullptr, 0, 0);
+    r.peek(len, tag);
+    r.release();
+  }
+}
+
+// ---------------------------------------------------------------------------
+// 1. Sizing
+// ---------------------------------------------------------------------------
+
+template <uint32_t B>
+static bool maxFitsEverywhere()
+{
+  for (uint32_t at = 0; at < B; at += 4) {
+    auto *r = new PlatformSpscRing<B>();
+    advanceEmpty(*r, at);
+    const bool ok = r->reserve(PlatformSpscRing<B>::kMaxPayload) != nullptr;
+    delete r;
+    if (!ok) {
+      std::printf("  kMaxPayload %u does not fit at offset %u\n",
+                  (unsigned)PlatformSpscRing<B>::kMaxPayload, (unsigned)at);
+      return false;
+    }
+  }
+  return true;
+}
+
+static void testSizing()
+{
+  std::printf("--- sizing ---\n");
+  check("kMaxPayload fits an empty ring at every offset (64 B)", maxFitsEverywhere<64>());
+  check("kMaxPayload fits an empty ring at every offset (1040 B)", maxFitsEverywhere<1040>());
+
+  typedef PlatformSpscRing<OT_FRAME_RING_BYTES> Ring;
+  check("firmware ring holds MAX_BUFFER_READ incl. NUL", Ring::kMaxPayload >= MAX_BUFFER_READ);
+
+  // 16 queued "B4000000A\0"-sized frames, then one full PIC line.
+  bool backlogOk = true;
+  for (uint32_t at = 0; at < OT_FRAME_RING_BYTES && backlogOk; at += 4) {
+    auto *r = new Ring();
+    advanceEmpty(*r, at);
+    for (int i = 0; i < OT_FRAME_QUEUE_DEPTH && backlogOk; i++) {
+      backlogOk = r->push("T80000200", 10, 0);
+    }
+    if (backlogOk) backlogOk = r->reserve(MAX_BUFFER_READ) != nullptr;
+    if (!backlogOk) std::printf("  backlog + full line failed at offset %u\n", (unsigned)at);
+    delete r;
+  }
+  check("16 frames + one full line fit at every offset", backlogOk);
+
+  const size_t legacy = OT_FRAME_QUEUE_DEPTH * sizeof(OTFrameMsgLegacy);
+  const size_t ring = sizeof(Ring);
+  std::printf("  queue storage: %zu B (16 x OTFrameMsg)  ring: %zu B  (-%.0f%%)\n",
+              legacy, ring, 100.0 * (1.0 - (double)ring / (double)legacy));
+  check("ring reserves at least 80% less than the 16-deep queue", ring * 5 <= legacy);
+}
+
+// ---------------------------------------------------------------------------
+// 2. Single-thread model check
+// ---------------------------------------------------------------------------
+
+struct ModelRec { uint32_t seq; uint16_t len; };
+
+template <uint32_t B>
+static bool modelCheck(uint32_t ops)
+{
+  auto *r = new PlatformSpscRing<B>();
+  std::deque<ModelRec> model;
+  uint32_t seq = 0, refusals = 0, occupied = 0;
+  bool ok = true;
+
+  for (uint32_t op = 0; op < ops && ok; op++) {
+    if (rnd() % 100 < 55) {
+      const uint16_t maxLen = (uint16_t)(rnd() % (PlatformSpscRing<B>::kMaxPayload + 1));
+      const uint16_t len = (uint16_t)(maxLen ? rnd() % (maxLen + 1u) : 0);
+      uint8_t *p = r->reserve(maxLen);
+      if (!p) {
+        // Only legal when the ring is not empty (kMaxPayload always fits empty).
+        if (model.empty()) { std::printf("  refused into an empty ring\n"); ok = false; }
+        refusals++;
+        continue;
+      }
+      for (uint32_t i = 0; i < len; i++) p[i] = payloadByte(seq, i);
+      r->commit(len, (uint16_t)seq);
+      model.push_back({seq, len});
+      occupied += PlatformSpscRing<B>::recordBytes(len);
+      seq++;
+    } else {
+      uint16_t len, tag;
+      const uint8_t *p = r->peek(len, tag);
+      if (model.empty()) {
+        if (p) { std::printf("  peek on empty ring returned a record\n"); ok = false; }
+        continue;
+      }
+      const ModelRec m = model.front();
+      if (!p || len != m.len || tag != (uint16_t)m.seq) {
+        std::printf("  record %u: got %s len=%u tag=%u\n", (unsigned)m.seq,
+                    p ? "record" : "nothing", p ? (unsigned)len : 0u, p ? (unsigned)tag : 0u);
+        ok = false;
+        continue;
+      }
+      for (uint32_t i = 0; i < len && ok; i++) ok = p[i] == payloadByte(m.seq, i);
+      r->release();
+      model.pop_front();
+      occupied -= PlatformSpscRing<B>::recordBytes(m.len);
+    }
+    if (occupied > B) { std::printf("  model occupancy %u > %u\n", (unsigned)occupied, (unsigned)B); ok = false; }
+    if (r->empty() != model.empty()) { std::printf("  empty() disagrees with model\n"); ok = false; }
+  }
+  std::printf("  ring %5u B: %u records, %u full refusals, high water %u B\n",
+              (unsigned)B, (unsigned)seq, (unsigned)refusals, (unsigned)r->highWater());
+  ok = ok && refusals > 0 && r->highWater() <= B;
+  delete r;
+  return ok;
+}
+
+static void testModel(uint32_t ops)
+{
+  std::printf("--- single-thread model ---\n");
+  check("model check, 64 B ring", modelCheck<64>(ops));
+  check("model check, 256 B ring", modelCheck<256>(ops));
+  check("model check, firmware ring", modelCheck<OT_FRAME_RING_BYTES>(ops));
+}
+
+// ---------------------------------------------------------------------------
+// 3. Producer/consumer threads
+// ---------------------------------------------------------------------------
+
+template <uint32_t B>
+static bool stress(uint32_t records, uint16_t maxLen)
+{
+  auto *r = new PlatformSpscRing<B>();
+  std::atomic<bool> bad{false};
+  std::atomic<uint32_t> fullSpins{0};
+
+  std::thread producer([&]() {
+    uint64_t s = 0x1234567ull + B;
+    auto prnd = [&]() { s ^= s >> 12; s ^= s << 25; s ^= s >> 27; return s * 0x2545F4914F6CDD1Dull; };
+    uint32_t spins = 0;
+    for (uint32_t seq = 0; seq < records && !bad.load(std::memory_order_relaxed); ) {
+      const uint16_t want = (uint16_t)(1 + prnd() % maxLen);
+      uint8_t *p = r->reserve(want);
+      if (!p) { spins++; std::this_thread::yield(); continue; }
+      const uint16_t len = (prnd() & 3) ? want : (uint16_t)(1 + prnd() % want);  // commit short sometimes
+      for (uint32_t i = 0; i < len; i++) p[i] = payloadByte(seq, i);
+      r->commit(len, (uint16_t)seq);
+      seq++;
+      if ((prnd() & 63) == 0) std::this_thread::yield();
+    }
+    fullSpins = spins;
+  });
+
+  std::thread consumer([&]() {
+    uint64_t s = 0x7654321ull + B;
+    auto crnd = [&]() { s ^= s >> 12; s ^= s << 25; s ^= s >> 27; return s * 0x2545F4914F6CDD1Dull; };
+    uint16_t len, tag;
+    for (uint32_t seq = 0; seq < records && !bad.load(std::memory_order_relaxed); ) {
+      const uint8_t *p = r->peek(len, tag);
+      if (!p) { std::this_thread::yield(); continue; }
+      bool ok = tag == (uint16_t)seq && len >= 1 && len <= maxLen;
+      for (uint32_t i = 0; i < len && ok; i++) ok = p[i] == payloadByte(seq, i);
+      if (!ok) {
+        std::printf("  record %u corrupt (tag=%u len=%u)\n", (unsigned)seq, (unsigned)tag, (unsigned)len);
+        bad = true;
+        break;
+      }
+      r->release();
+      seq++;
+      if ((crnd() & 63) == 0) std::this_thread::yield();
+    }
+  });
+
+  producer.join();
+  consumer.join();
+  const bool ok = !bad && r->empty();
+  std::printf("  ring %5u B, len 1..%u: %u records, %u full-ring retries, high water %u B\n",
+              (unsigned)B, (unsigned)maxLen, (unsigned)records, (unsigned)fullSpins.load(),
+              (unsigned)r->highWater());
+  delete r;
+  return ok;
+}
+
+static void testThreads(uint32_t records)
+{
+  std::printf("--- producer/consumer threads ---\n");
+  check("stress, 64 B ring", stress<64>(records, PlatformSpscRing<64>::kMaxPayload));
+  check("stress, 256 B ring", stress<256>(records, PlatformSpscRing<256>::kMaxPayload));
+  check("stress, firmware ring, OT-frame sized", stress<OT_FRAME_RING_BYTES>(records, 10));
+  check("stress, firmware ring, full PIC lines",
+        stress<OT_FRAME_RING_BYTES>(records / 4, MAX_BUFFER_READ));
+}
+
+int main(int argc, char **argv)
+{
+  const uint32_t records = (argc > 1) ? (uint32_t)std::strtoul(argv[1], nullptr, 10) : 2000000u;
+  std::printf("=== PlatformSpscRing test ===\n");
+  testSizing();
+  testModel(records / 4);
+  testThreads(records);
+  std::printf("\n%s (%d failure%s)\n", failures ? "FAILED" : "ALL PASSED", failures, failures == 1 ? "" : "s");
+  return failures ? 1 : 0;
+}
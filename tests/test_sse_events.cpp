@@ -0,0 +1,206 @@
+/**
+ * Host test for the Server-Sent Events bookkeeping (SseEvents.h).
+ *
+ * GET /api/v2/events (sseStuff.ino) keeps one long-lived connection per
+ * dashboard and pushes the otmonitor, SAT status and health documents when
+ * they change, at most once per topic interval. This file checks:
+ *
+ *   1. sseParseTopics(): missing or empty query is every topic, single and
+ *      combined names, repeats, and rejection of unknown names, stray commas,
+ *      prefixes and case variants (mask untouched on failure).
+ *   2. Topic combination -> event source mapping: one distinct source per
+ *      mask, each carrying exactly the topics of its mask, for parsed queries
+ *      too (a client that asked for ot only never gets sat).
+ *   3. The per-topic gate: first event always due, interval respected across
+ *      a millis() wrap, unchanged content suppressed, a reconnect forcing a
+ *      full send of unchanged content.
+ *   4. A simulated topic with bursts of state changes against the 100 ms
+ *      loop tick: never more than one event per interval, every burst's last
+ *      state delivered within one interval after it settles, and no event
+ *      for a state the client already has.
+ *
+ * Build & run (from repo root):
+ *   g++ -std=c++17 -O2 -Wall -Wextra tests/test_sse_events.cpp -o tests/test_sse_events.out
+ *   ./tests/test_sse_events.out
+ *   echo $?   # 0 on pass, 1 on failure
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "../src/OTGW-firmware/SseEvents.h"
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond, ...)                                  \
+  do {                                                    \
+    checks++;                                             \
+    if (!(cond)) {                                        \
+      failures++;                                         \
+      if (failures <= 20) {                               \
+        std::printf("FAIL %s:%d: ", __FILE__, __LINE__);  \
+        std::printf(__VA_ARGS__);                         \
+        std::printf("\n");                                \
+      }                                                   \
+    }                                                     \
+  } while (0)
+
+#define BIT(t) ((uint8_t)(1u << (t)))
+
+static void testParse()
+{
+  uint8_t m = 0;
+  CHECK(sseParseTopics(nullptr, m) && m == SSE_TOPIC_ALL, "nullptr -> 0x%02x", m);
+  m = 0;
+  CHECK(sseParseTopics("", m) && m == SSE_TOPIC_ALL, "\"\" -> 0x%02x", m);
+  CHECK(SSE_TOPIC_ALL == 0x07, "SSE_TOPIC_ALL 0x%02x", SSE_TOPIC_ALL);
+
+  struct { const char *s; uint8_t mask; } good[] = {
+    { "ot",            BIT(SSE_TOPIC_OT) },
+    { "sat",           BIT(SSE_TOPIC_SAT) },
+    { "health",        BIT(SSE_TOPIC_HEALTH) },
+    { "ot,sat",        BIT(SSE_TOPIC_OT) | BIT(SSE_TOPIC_SAT) },
+    { "health,ot",     BIT(SSE_TOPIC_OT) | BIT(SSE_TOPIC_HEALTH) },
+    { "ot,sat,health", SSE_TOPIC_ALL },
+    { "ot,ot",         BIT(SSE_TOPIC_OT) },
+  };
+  for (auto &g : good) {
+    m = 0;
+    CHECK(sseParseTopics(g.s, m) && m == g.mask, "\"%s\" -> 0x%02x, want 0x%02x", g.s, m, g.mask);
+  }
+
+  const char *bad[] = { "o", "ots", "OT", "sat,", ",sat", "ot,,sat", ",", "heal", "healthy",
+                        "ot sat", " ot", "all", "ot;sat" };
+  for (const char *s : bad) {
+    m = 0x5a;
+    CHECK(!sseParseTopics(s, m), "\"%s\" accepted", s);
+    CHECK(m == 0x5a, "\"%s\" changed the mask to 0x%02x", s, m);
+  }
+
+  for (uint8_t t = 0; t < SSE_TOPIC_COUNT; t++) {
+    for (uint8_t u = t + 1; u < SSE_TOPIC_COUNT; u++) {
+      CHECK(strcmp(kSseTopicNames[t], kSseTopicNames[u]) != 0, "topic names %u and %u equal", t, u);
+    }
+  }
+}
+
+static void testSources()
+{
+  CHECK(SSE_SOURCE_COUNT == 7, "SSE_SOURCE_COUNT %u", SSE_SOURCE_COUNT);
+  bool used[SSE_SOURCE_COUNT] = {};
+  for (uint8_t mask = 1; mask <= SSE_TOPIC_ALL; mask++) {
+    const uint8_t src = sseSourceIndex(mask);
+    CHECK(src < SSE_SOURCE_COUNT, "mask 0x%02x -> source %u out of range", mask, src);
+    if (src >= SSE_SOURCE_COUNT) continue;
+    CHECK(!used[src], "source %u used twice", src);
+    used[src] = true;
+    for (uint8_t t = 0; t < SSE_TOPIC_COUNT; t++) {
+      CHECK(sseSourceHasTopic(src, t) == ((mask & BIT(t)) != 0),
+            "source %u (mask 0x%02x) topic %u", src, mask, t);
+    }
+  }
+
+  // Every parsed query lands on a source carrying exactly its topics, so
+  // "ot" alone never receives sat.
+  const char *queries[] = { "ot", "sat", "health", "ot,health", "health,sat,ot", "" };
+  for (const char *q : queries) {
+    uint8_t m = 0;
+    CHECK(sseParseTopics(q, m), "\"%s\" rejected", q);
+    const uint8_t src = sseSourceIndex(m);
+    for (uint8_t t = 0; t < SSE_TOPIC_COUNT; t++) {
+      const bool asked = (*q == '\0') || strstr(q, kSseTopicNames[t]) != nullptr;
+      CHECK(sseSourceHasTopic(src, t) == asked, "\"%s\" topic %s", q, kSseTopicNames[t]);
+    }
+  }
+}
+
+static void testGate()
+{
+  SseGate g;
+  CHECK(sseGateDue(g, 0, 1000), "fresh gate not due");
+  CHECK(sseGateChanged(g, 0), "fresh gate suppressed hash 0");
+  sseGateCommit(g, 100, 42);
+  CHECK(!g.wantFull, "commit left wantFull set");
+  CHECK(!sseGateDue(g, 100, 1000) && !sseGateDue(g, 1099, 1000), "due inside the interval");
+  CHECK(sseGateDue(g, 1100, 1000), "not due after the interval");
+  CHECK(!sseGateChanged(g, 42), "same hash reported as changed");
+  CHECK(sseGateChanged(g, 43), "other hash not reported");
+
+  sseGateRequestFull(g);
+  CHECK(sseGateChanged(g, 42), "wantFull did not force unchanged content");
+  CHECK(!sseGateDue(g, 200, 1000), "wantFull bypassed the interval");
+  sseGateCommit(g, 1100, 42);
+  CHECK(!sseGateChanged(g, 42), "wantFull survived a commit");
+
+  // millis() wrap.
+  SseGate w;
+  sseGateCommit(w, 0xFFFFFF00UL, 1);
+  CHECK(!sseGateDue(w, 0xFFFFFFF0UL, 500), "due 240 ms after commit");
+  CHECK(!sseGateDue(w, 0x000000F0UL, 500), "due 496 ms after commit across the wrap");
+  CHECK(sseGateDue(w, 0x00000100UL, 500), "not due 512 ms after commit across the wrap");
+}
+
+// One topic whose state changes in bursts, ticked like handleEventStream().
+static void testCoalescing()
+{
+  const uint32_t tickMs = 100, intervalMs = 500;
+  std::mt19937 rng(7);
+  SseGate g;
+  uint32_t state = 1, clientState = 0;
+  uint32_t lastEventMs = 0;
+  bool anyEvent = false;
+  long events = 0, changes = 0, tooSoon = 0, redundant = 0, stale = 0;
+  uint32_t settledAt = 0;
+  bool settling = false;
+
+  for (uint32_t now = 0; now < 3600u * 1000u; now += tickMs) {
+    // Bursts: a few seconds of changes every tick, then a quiet spell.
+    const bool burst = (now / 7000u) % 3 == 0;
+    if (burst && rng() % 4 != 0) {
+      state = (uint32_t)rng() | 1u;
+      changes++;
+      settling = true;
+      settledAt = now;
+    }
+    if (now == 1800u * 1000u) sseGateRequestFull(g);   // a second client connects
+
+    if (sseGateDue(g, now, intervalMs)) {
+      const uint32_t hash = state;
+      if (sseGateChanged(g, hash)) {
+        if (anyEvent && now - lastEventMs < intervalMs) tooSoon++;
+        if (clientState == state && !g.wantFull) redundant++;
+        clientState = state;
+        lastEventMs = now;
+        anyEvent = true;
+        events++;
+        sseGateCommit(g, now, hash);
+      } else {
+        g.lastMs = now;                           // as the firmware does: rendered, unchanged
+      }
+    }
+    if (settling && clientState == state) settling = false;
+    if (settling && now - settledAt > intervalMs + tickMs) stale++;
+  }
+
+  CHECK(tooSoon == 0, "%ld events inside the interval", tooSoon);
+  CHECK(redundant == 0, "%ld events for a state the client had", redundant);
+  CHECK(stale == 0, "%ld ticks with a settled state not delivered in time", stale);
+  CHECK(events * 3 < changes, "%ld events for %ld changes", events, changes);
+  CHECK(events <= (long)(3600u * 1000u / intervalMs) + 1, "%ld events over the rate", events);
+  std::printf("  coalescing: %ld changes -> %ld events\n", changes, events);
+}
+
+int main()
+{
+  testParse();
+  testSources();
+  testGate();
+  testCoalescing();
+
+  std::printf("%d checks, %d failures\n", checks, failures);
+  std::printf(failures ? "FAILED\n" : "ALL PASSED\n");
+  return failures ? 1 : 0;
+}
@@ -31,7 +31,7 @@ from typing import Any, Dict, Iterable, List, Optional, Tuple
 
 
 DEFAULT_SPEC = Path("docs/opentherm specification/OpenTherm-Protocol-Specification-v4.2-message-id-reference.md")
-DEFAULT_HEADER = Path("src/OTGW-firmware/OTGW-Core.h")
+DEFAULT_HEADER = Path("src/OTGW-firmware/OTmap.h")
 DEFAULT_SOURCE = Path("src/OTGW-firmware/OTGW-Core.ino")
 DEFAULT_MQTTHA = Path("src/OTGW-firmware/data/mqttha.cfg")
 DEFAULT_MATRIX_OUT = Path(".tmp/ot_v42_matrix_spec_audit.csv")
@@ -598,7 +598,7 @@ def parse_args() -> argparse.Namespace:
     parser = argparse.ArgumentParser(description="Spec-driven OpenTherm v4.2 audit for firmware + mqttha.cfg")
     parser.add_argument("--root", type=Path, default=Path("."), help="Repository root (default: current directory)")
     parser.add_argument("--spec", type=Path, default=DEFAULT_SPEC, help="Path to v4.2 Markdown spec")
-    parser.add_argument("--header", type=Path, default=DEFAULT_HEADER, help="Path to OTGW-Core.h")
+    parser.add_argument("--header", type=Path, default=DEFAULT_HEADER, help="Path to OTmap.h")
     parser.add_argument("--source", type=Path, default=DEFAULT_SOURCE, help="Path to OTGW-Core.ino")
     parser.add_argument("--mqttha", type=Path, default=DEFAULT_MQTTHA, help="Path to mqttha.cfg")
     parser.add_argument("--matrix-out", type=Path, default=DEFAULT_MATRIX_OUT, help="CSV matrix output path")